@@ -323,6 +323,3663 @@ static const ONX_ErrorCounter Internal_TestModelRead(
   return error_counter;
 }
 
+static const ONX_ErrorCounter Internal_TestConcurrentRead(
+  ON_TextLog& text_log,
+  const ON_String fullpath
+  )
+{
+  // Reading the object table on more than one thread, deferring
+  // geometry reading and reading from a memory mapped file must create
+  // the same model as reading an ON_BinaryFile on the calling thread.
+  const unsigned int thread_counts[] = { 1, 4, 4, 1, 4 };
+  const bool bDeferGeometryReading[] = { false, false, true, false, true };
+  const bool bMappedFile[] = { false, false, false, true, true };
+  const unsigned int test_count = (unsigned int)(sizeof(thread_counts) / sizeof(thread_counts[0]));
+
+  ONX_ErrorCounter error_counter;
+  ON_SHA1_Hash serial_hash = ON_SHA1_Hash::ZeroDigest;
+  for (unsigned int i = 0; i < test_count; i++)
+  {
+    FILE* fp = ON_FileStream::Open3dmToRead(fullpath);
+    if (nullptr == fp)
+    {
+      error_counter.IncrementFailureCount();
+      break;
+    }
+
+    // Deferred geometry is read from the archive when ContentHash()
+    // gets the geometry, so the model is hashed before the archive
+    // is destroyed.
+    auto ReadModelHash = [&](ON_BinaryArchive& archive) -> ON_SHA1_Hash
+    {
+      archive.SetThreadCount(thread_counts[i]);
+      archive.SetDeferGeometryReading(bDeferGeometryReading[i]);
+      ONX_Model model;
+      return model.Read(archive, nullptr) ? model.ContentHash() : ON_SHA1_Hash::ZeroDigest;
+    };
+
+    ON_SHA1_Hash hash = ON_SHA1_Hash::ZeroDigest;
+    if (bMappedFile[i])
+    {
+      ON_BinaryMappedFile archive(ON::archive_mode::read3dm, fp);
+      if (archive.FileIsMapped())
+        hash = ReadModelHash(archive);
+      else
+        text_log.Print("Concurrent read test: ON_BinaryMappedFile did not map the file.\n");
+    }
+    else
+    {
+      ON_BinaryFile archive(ON::archive_mode::read3dm, fp);
+      hash = ReadModelHash(archive);
+    }
+    ON_FileStream::Close(fp);
+
+    if (0 == i)
+    {
+      serial_hash = hash;
+      continue;
+    }
+    if (hash != serial_hash)
+    {
+      text_log.Print(
+        "Concurrent read test: %s ThreadCount() = %u, DeferGeometryReading() = %s model is different.\n",
+        bMappedFile[i] ? "ON_BinaryMappedFile" : "ON_BinaryFile",
+        thread_counts[i],
+        bDeferGeometryReading[i] ? "true" : "false"
+      );
+      error_counter.IncrementFailureCount();
+    }
+  }
+
+  return error_counter;
+}
+
+static bool Internal_SameBits(const double* a, const double* b, size_t count)
+{
+  return 0 == memcmp(a, b, count * sizeof(a[0]));
+}
+
+// Runs task(thread_index) on thread_count threads at the same time.
+template <class TASK>
+static void Internal_RunOnThreads(unsigned int thread_count, const TASK& task)
+{
+  ON_SimpleArray<std::thread*> threads(thread_count);
+  for (unsigned int i = 0; i < thread_count; i++)
+    threads.Append(new std::thread([&task, i]() { task(i); }));
+  for (unsigned int i = 0; i < threads.UnsignedCount(); i++)
+  {
+    threads[i]->join();
+    delete threads[i];
+  }
+}
+
+static unsigned int Internal_TestConcurrentCurveEvaluation(
+  const ON_Curve& curve,
+  unsigned int thread_count
+  )
+{
+  // Every thread evaluates the shared curve with its own context. 
+  // The results must be the same bits as the ordinary evaluator.
+  const unsigned int t_count = 257;
+  const ON_Interval domain = curve.Domain();
+  ON_SimpleArray<ON_3dVector> expected(3 * t_count);
+  for (unsigned int i = 0; i < t_count; i++)
+  {
+    ON_3dPoint P;
+    ON_3dVector D1, D2;
+    curve.Ev2Der(domain.ParameterAt(i / (t_count - 1.0)), P, D1, D2);
+    expected.Append(ON_3dVector(P));
+    expected.Append(D1);
+    expected.Append(D2);
+  }
+
+  std::atomic<unsigned int> failure_count(0);
+  Internal_RunOnThreads(thread_count, [&](unsigned int thread_index)
+    {
+      ON_EvaluationContext context;
+      for (unsigned int pass = 0; pass < 8; pass++)
+      {
+        for (unsigned int j = 0; j < t_count; j++)
+        {
+          // threads walk the parameters in different orders
+          const unsigned int i = (j * (2 * thread_index + 1) + pass) % t_count;
+          ON_3dPoint P;
+          ON_3dVector D[3];
+          curve.Ev2Der(domain.ParameterAt(i / (t_count - 1.0)), P, D[1], D[2], 0, context);
+          D[0] = P;
+          if (false == Internal_SameBits(&D[0].x, &expected[3 * i].x, 9))
+            failure_count++;
+        }
+      }
+    }
+  );
+  return failure_count;
+}
+
+static unsigned int Internal_TestConcurrentSurfaceEvaluation(
+  const ON_Surface& surface,
+  unsigned int thread_count
+  )
+{
+  const unsigned int n = 33;
+  const ON_Interval sdomain = surface.Domain(0);
+  const ON_Interval tdomain = surface.Domain(1);
+  ON_SimpleArray<ON_3dVector> expected(6 * n * n);
+  for (unsigned int i = 0; i < n * n; i++)
+  {
+    ON_3dPoint P;
+    ON_3dVector D[5];
+    surface.Ev2Der(sdomain.ParameterAt((i % n) / (n - 1.0)), tdomain.ParameterAt((i / n) / (n - 1.0)), P, D[0], D[1], D[2], D[3], D[4]);
+    expected.Append(ON_3dVector(P));
+    expected.Append(5, D);
+  }
+
+  std::atomic<unsigned int> failure_count(0);
+  Internal_RunOnThreads(thread_count, [&](unsigned int thread_index)
+    {
+      ON_EvaluationContext context;
+      for (unsigned int pass = 0; pass < 4; pass++)
+      {
+        for (unsigned int j = 0; j < n * n; j++)
+        {
+          const unsigned int i = (j * (2 * thread_index + 1) + pass) % (n * n);
+          ON_3dPoint P;
+          ON_3dVector D[6];
+          surface.Ev2Der(sdomain.ParameterAt((i % n) / (n - 1.0)), tdomain.ParameterAt((i / n) / (n - 1.0)), P, D[1], D[2], D[3], D[4], D[5], 0, context);
+          D[0] = P;
+          if (false == Internal_SameBits(&D[0].x, &expected[6 * i].x, 18))
+            failure_count++;
+        }
+      }
+    }
+  );
+  return failure_count;
+}
+
+static unsigned int Internal_TestConcurrentSubDEvaluation(
+  const ON_SubD& subd,
+  unsigned int thread_count
+  )
+{
+  // The context evaluators must not save points on the shared SubD
+  // and must get the same bits as the evaluators that save points.
+  subd.ClearEvaluationCache();
+
+  ON_SimpleArray<const ON_SubDVertex*> vertices;
+  ON_SimpleArray<const ON_SubDEdge*> edges;
+  ON_SimpleArray<const ON_SubDFace*> faces;
+  for (const ON_SubDVertex* v = subd.FirstVertex(); nullptr != v; v = v->m_next_vertex)
+    vertices.Append(v);
+  for (const ON_SubDEdge* e = subd.FirstEdge(); nullptr != e; e = e->m_next_edge)
+    edges.Append(e);
+  for (const ON_SubDFace* f = subd.FirstFace(); nullptr != f; f = f->m_next_face)
+    faces.Append(f);
+
+  const unsigned int vcount = vertices.UnsignedCount();
+  const unsigned int ecount = edges.UnsignedCount();
+  const unsigned int fcount = faces.UnsignedCount();
+  const unsigned int point_count = 2 * vcount + ecount + fcount;
+
+  // points[thread_index*point_count + ...] = vertex surface points,
+  // then vertex, edge and face subdivision points.
+  ON_SimpleArray<ON_3dPoint> points(thread_count * point_count);
+  points.SetCount(thread_count * point_count);
+  std::atomic<unsigned int> failure_count(0);
+  Internal_RunOnThreads(thread_count, [&](unsigned int thread_index)
+    {
+      ON_EvaluationContext context;
+      context.SetSubD(subd);
+      ON_3dPoint* P = points.Array() + thread_index * point_count;
+      for (unsigned int i = 0; i < vcount; i++)
+      {
+        if (false == vertices[i]->GetSurfacePoint(&P[i].x, context))
+          failure_count++;
+      }
+      P += vcount;
+      for (unsigned int i = 0; i < vcount; i++)
+      {
+        if (false == vertices[i]->GetSubdivisionPoint(&P[i].x, context))
+          failure_count++;
+      }
+      P += vcount;
+      for (unsigned int i = 0; i < ecount; i++)
+      {
+        if (false == edges[i]->GetSubdivisionPoint(&P[i].x, context))
+          failure_count++;
+      }
+      P += ecount;
+      for (unsigned int i = 0; i < fcount; i++)
+      {
+        if (false == faces[i]->GetSubdivisionPoint(&P[i].x, context))
+          failure_count++;
+      }
+    }
+  );
+
+  for (unsigned int i = 0; i < vcount; i++)
+  {
+    if (vertices[i]->SavedSubdivisionPointIsSet() || vertices[i]->SurfacePointIsSet())
+      failure_count++;
+  }
+  for (unsigned int i = 0; i < ecount; i++)
+  {
+    if (edges[i]->SavedSubdivisionPointIsSet())
+      failure_count++;
+  }
+  for (unsigned int i = 0; i < fcount; i++)
+  {
+    if (faces[i]->SavedSubdivisionPointIsSet())
+      failure_count++;
+  }
+
+  ON_SimpleArray<ON_3dPoint> expected(point_count);
+  for (unsigned int i = 0; i < vcount; i++)
+    expected.Append(vertices[i]->SurfacePoint());
+  for (unsigned int i = 0; i < vcount; i++)
+    expected.Append(vertices[i]->SubdivisionPoint());
+  for (unsigned int i = 0; i < ecount; i++)
+    expected.Append(edges[i]->SubdivisionPoint());
+  for (unsigned int i = 0; i < fcount; i++)
+    expected.Append(faces[i]->SubdivisionPoint());
+  for (unsigned int thread_index = 0; thread_index < thread_count; thread_index++)
+  {
+    if (false == Internal_SameBits(&points[thread_index * point_count].x, &expected[0].x, 3 * point_count))
+      failure_count++;
+  }
+
+  subd.ClearEvaluationCache();
+  return failure_count;
+}
+
+static unsigned int Internal_TestSubDContextPoints(
+  ON_SubD& subd
+  )
+{
+  // Subdivision points kept in a context must not be used after the SubD changes.
+  unsigned int failure_count = 0;
+  subd.ClearEvaluationCache();
+  const ON_SubDFace* f = subd.FirstFace();
+  ON_SubDVertex* v = (nullptr != f) ? const_cast<ON_SubDVertex*>(f->Vertex(0)) : nullptr;
+  if (nullptr == v)
+    return 1;
+  const ON_SubDComponentPtr cptr = ON_SubDComponentPtr::Create(f);
+  ON_EvaluationContext context;
+  ON_3dPoint P0, P1, Q;
+
+  // Nothing is kept until SetSubD() is called.
+  if (!f->GetSubdivisionPoint(&P0.x, context) || context.GetSubDSubdivisionPoint(cptr, &Q.x))
+    failure_count++;
+  context.SetSubD(subd);
+  if (!f->GetSubdivisionPoint(&P0.x, context) || !context.GetSubDSubdivisionPoint(cptr, &Q.x) || !(P0 == Q))
+    failure_count++;
+
+  v->SetControlNetPoint(v->ControlNetPoint() + ON_3dVector(0.5, 0.25, 1.0), true);
+  subd.ChangeGeometryContentSerialNumberForExperts(false);
+  context.SetSubD(subd);
+  if (context.GetSubDSubdivisionPoint(cptr, &Q.x))
+    failure_count++;
+  if (!f->GetSubdivisionPoint(&P1.x, context) || P0 == P1 || !(P1 == f->SubdivisionPoint()))
+    failure_count++;
+
+  // A different SubD with the same component ids.
+  ON_SubD other(subd);
+  context.SetSubD(other);
+  if (context.GetSubDSubdivisionPoint(cptr, &Q.x))
+    failure_count++;
+
+  context.SetSubD(subd);
+  context.ClearSubDSubdivisionPoints();
+  if (!f->GetSubdivisionPoint(&P1.x, context) || context.GetSubDSubdivisionPoint(cptr, &Q.x))
+    failure_count++;
+
+  subd.ClearEvaluationCache();
+  return failure_count;
+}
+
+static const ONX_ErrorCounter Internal_TestConcurrentEvaluation(
+  ON_TextLog& text_log
+  )
+{
+  // Many threads evaluate the same const curve, surface and SubD.
+  // ON_EvaluationContext describes when this is race-free.
+  const unsigned int thread_count = 4;
+  ONX_ErrorCounter error_counter;
+  unsigned int failure_count = 0;
+
+  // rational curve and surface
+  ON_NurbsCurve circle;
+  ON_Circle(ON_Plane::World_xy, 2.0).GetNurbForm(circle);
+  ON_NurbsSurface sphere;
+  ON_Sphere(ON_3dPoint(1.0, 2.0, 3.0), 4.0).GetNurbForm(sphere);
+
+  // high degree curve and surface use the general span evaluators
+  ON_NurbsCurve high_degree_curve(3, true, 9, 12);
+  high_degree_curve.MakeClampedUniformKnotVector(1.0);
+  for (int i = 0; i < high_degree_curve.CVCount(); i++)
+    high_degree_curve.SetCV(i, ON_4dPoint(i, sin(i), cos(0.5 * i), 1.0 + 0.125 * (i % 3)));
+  ON_NurbsSurface high_degree_surface(3, false, 8, 9, 10, 11);
+  high_degree_surface.MakeClampedUniformKnotVector(0, 1.0);
+  high_degree_surface.MakeClampedUniformKnotVector(1, 1.0);
+  for (int i = 0; i < high_degree_surface.CVCount(0); i++)
+  {
+    for (int j = 0; j < high_degree_surface.CVCount(1); j++)
+      high_degree_surface.SetCV(i, j, ON_3dPoint(i, j, sin(i + 2.0 * j)));
+  }
+
+  const ON_3dPoint corners[8] = {
+    ON_3dPoint(0, 0, 0), ON_3dPoint(4, 0, 0), ON_3dPoint(4, 3, 0), ON_3dPoint(0, 3, 0),
+    ON_3dPoint(0, 0, 2), ON_3dPoint(4, 0, 2), ON_3dPoint(4, 3, 2), ON_3dPoint(0, 3, 2)
+  };
+  ON_SubD smooth_box, crease_box;
+  ON_SubD::CreateSubDBox(corners, ON_SubDEdgeTag::Smooth, 2, 2, 2, &smooth_box);
+  ON_SubD::CreateSubDBox(corners, ON_SubDEdgeTag::Crease, 3, 2, 1, &crease_box);
+
+  failure_count += Internal_TestConcurrentCurveEvaluation(circle, thread_count);
+  failure_count += Internal_TestConcurrentCurveEvaluation(high_degree_curve, thread_count);
+  failure_count += Internal_TestConcurrentSurfaceEvaluation(sphere, thread_count);
+  failure_count += Internal_TestConcurrentSurfaceEvaluation(high_degree_surface, thread_count);
+  failure_count += Internal_TestConcurrentSubDEvaluation(smooth_box, thread_count);
+  failure_count += Internal_TestConcurrentSubDEvaluation(crease_box, thread_count);
+  failure_count += Internal_TestSubDContextPoints(smooth_box);
+
+  if (failure_count > 0)
+    text_log.Print("Concurrent evaluation test: %u evaluations are different.\n", failure_count);
+  for (unsigned int i = 0; i < failure_count; i++)
+    error_counter.IncrementFailureCount();
+
+  return error_counter;
+}
+
+static const ONX_ErrorCounter Internal_TestCurveArcLength(
+  ON_TextLog& text_log
+  )
+{
+  ONX_ErrorCounter error_counter;
+  unsigned int failure_count = 0;
+
+  // The parameter of an ON_ArcCurve is the arc length. The rational
+  // NURBS form has a different parameterization but the same lengths.
+  const double radius = 2.0;
+  const ON_ArcCurve arc_curve(ON_Circle(ON_Plane::World_xy, radius));
+  ON_NurbsCurve circle;
+  arc_curve.GetNurbForm(circle);
+  const double length_tolerance = 1.0e-8 * 2.0 * ON_PI * radius;
+
+  ON_CurveArcLength arc_length;
+  if (!arc_length.Create(arc_curve) || !arc_length.IsCurrent())
+    failure_count++;
+  else
+  {
+    const ON_Interval domain = arc_curve.Domain();
+    for (int i = 0; i <= 16; i++)
+    {
+      const double t = domain.ParameterAt(i / 16.0);
+      double length = ON_UNSET_VALUE;
+      if (!arc_length.LengthAt(t, &length) || !(fabs(length - (t - domain[0])) <= length_tolerance))
+        failure_count++;
+      double s = ON_UNSET_VALUE;
+      if (!arc_length.ParameterAt(t - domain[0], &s) || !(fabs(s - t) <= length_tolerance))
+        failure_count++;
+    }
+  }
+
+  ON_CurveArcLength circle_length;
+  if (!circle_length.Create(circle) || !(fabs(circle_length.Length() - 2.0 * ON_PI * radius) <= length_tolerance))
+    failure_count++;
+  else
+  {
+    // Points at the same arc length must be the same point.
+    for (int i = 0; i <= 16; i++)
+    {
+      const double length = (i / 16.0) * circle_length.Length();
+      double t = ON_UNSET_VALUE;
+      if (!circle_length.ParameterAt(length, &t))
+      {
+        failure_count++;
+        continue;
+      }
+      const ON_3dPoint P = circle.PointAt(t);
+      const ON_3dPoint Q = arc_curve.PointAt(arc_curve.Domain()[0] + length);
+      if (!(P.DistanceTo(Q) <= 1.0e-7))
+        failure_count++;
+      double s = ON_UNSET_VALUE;
+      if (!circle_length.LengthAt(t, &s) || !(fabs(s - length) <= length_tolerance))
+        failure_count++;
+    }
+  }
+
+  // A line with length 10 divided into pieces with length 3.
+  const ON_LineCurve line_curve(ON_3dPoint::Origin, ON_3dPoint(10.0, 0.0, 0.0));
+  ON_CurveArcLength line_length;
+  ON_SimpleArray<double> t;
+  if (!line_length.Create(line_curve) || 4 != line_length.DivideByLength(3.0, t) || 4 != t.Count())
+    failure_count++;
+  else
+  {
+    for (int i = 0; i < 4; i++)
+    {
+      if (!(fabs(line_curve.PointAt(t[i]).x - 3.0 * i) <= 1.0e-8))
+        failure_count++;
+    }
+  }
+  if (0 != line_length.DivideByLength(0.0, t) || 0 != line_length.DivideByLength(-1.0, t))
+    failure_count++;
+
+  // Changing a segment of a polycurve or the curve referenced by a proxy
+  // makes the table stale.
+  ON_NurbsCurve* segment = new ON_NurbsCurve(circle);
+  ON_PolyCurve polycurve;
+  polycurve.Append(segment);
+  ON_CurveArcLength polycurve_length;
+  if (!polycurve_length.Create(polycurve) || !polycurve_length.IsCurrent())
+    failure_count++;
+  segment->Translate(ON_3dVector(1.0, 0.0, 0.0));
+  if (polycurve_length.IsCurrent())
+    failure_count++;
+
+  ON_NurbsCurve real_curve(circle);
+  const ON_CurveProxy proxy(&real_curve);
+  ON_CurveArcLength proxy_length;
+  if (!proxy_length.Create(proxy) || !proxy_length.IsCurrent())
+    failure_count++;
+  real_curve.SetCV(0, ON_3dPoint(3.0, 0.0, 0.0));
+  if (proxy_length.IsCurrent())
+    failure_count++;
+
+  // Every curve gets its own nonzero serial number, and assignment
+  // changes it.
+  ON_NurbsCurve copy(circle);
+  if (0 == circle.GeometryContentSerialNumber() || 0 == copy.GeometryContentSerialNumber())
+    failure_count++;
+  if (circle.GeometryContentSerialNumber() == copy.GeometryContentSerialNumber())
+    failure_count++;
+  ON_CurveArcLength copy_length;
+  if (!copy_length.Create(copy) || !copy_length.IsCurrent())
+    failure_count++;
+  copy = circle;
+  if (copy_length.IsCurrent())
+    failure_count++;
+
+  // A curve created at the address of a destroyed curve does not make
+  // the old table current.
+  {
+    alignas(ON_LineCurve) unsigned char buffer[sizeof(ON_LineCurve)];
+    ON_LineCurve* line = new (buffer) ON_LineCurve(ON_3dPoint::Origin, ON_3dPoint(1.0, 0.0, 0.0));
+    ON_CurveArcLength stale_length;
+    if (!stale_length.Create(*line))
+      failure_count++;
+    line->~ON_LineCurve();
+    line = new (buffer) ON_LineCurve(ON_3dPoint::Origin, ON_3dPoint(2.0, 0.0, 0.0));
+    if (stale_length.IsCurrent())
+      failure_count++;
+    line->~ON_LineCurve();
+  }
+
+  // GetLength() and GetNormalizedArcLengthPoints() reuse a table that is
+  // current for the same tolerance and sub-domain. Writes through m_cv[]
+  // do not change the serial number, so a reused table still has the 
+  // old length.
+  {
+    ON_NurbsCurve nurbs_line;
+    ON_LineCurve(ON_3dPoint::Origin, ON_3dPoint(10.0, 0.0, 0.0)).GetNurbForm(nurbs_line);
+    ON_CurveArcLength table;
+    double length = ON_UNSET_VALUE;
+    if (!nurbs_line.GetLength(table, &length) || !(fabs(length - 10.0) <= 1.0e-7) || !table.IsCurrent(nurbs_line))
+      failure_count++;
+    nurbs_line.m_cv[nurbs_line.m_cv_stride] = 20.0;
+    length = ON_UNSET_VALUE;
+    if (!nurbs_line.GetLength(table, &length) || !(fabs(length - 10.0) <= 1.0e-7))
+      failure_count++;
+    const double s[2] = { 0.0, 0.5 };
+    double t[2] = { ON_UNSET_VALUE, ON_UNSET_VALUE };
+    if (!nurbs_line.GetNormalizedArcLengthPoints(table, 2, s, t) || table.Length() != length)
+      failure_count++;
+
+    // A different tolerance or sub-domain creates the table again.
+    if (!nurbs_line.GetLength(table, &length, 1.0e-6) || !(fabs(length - 20.0) <= 1.0e-5))
+      failure_count++;
+    const ON_Interval half(nurbs_line.Domain()[0], nurbs_line.Domain().ParameterAt(0.5));
+    if (table.IsCurrent(nurbs_line, 1.0e-6, &half))
+      failure_count++;
+    if (!nurbs_line.GetLength(table, &length, 1.0e-6, &half) || !(fabs(length - 10.0) <= 1.0e-5) || table.Domain() != half)
+      failure_count++;
+    if (!table.IsCurrent(nurbs_line, 1.0e-6, &half) || table.IsCurrent(nurbs_line, 1.0e-8, &half))
+      failure_count++;
+
+    // A changed curve creates the table again.
+    nurbs_line.m_cv[nurbs_line.m_cv_stride] = 30.0;
+    nurbs_line.DestroyCurveTree();
+    if (!nurbs_line.GetLength(table, &length, 1.0e-6, &half) || !(fabs(length - 15.0) <= 1.0e-5))
+      failure_count++;
+  }
+
+  if (failure_count > 0)
+    text_log.Print("Curve arc length test: %u failures.\n", failure_count);
+  for (unsigned int i = 0; i < failure_count; i++)
+    error_counter.IncrementFailureCount();
+
+  return error_counter;
+}
+
+static bool Internal_SameCVs(const double* a, const double* b, int count)
+{
+  for (int i = 0; i < count; i++)
+  {
+    if (!(fabs(a[i] - b[i]) <= 1.0e-12 * (1.0 + fabs(a[i]))))
+      return false;
+  }
+  return true;
+}
+
+static unsigned int Internal_TestBezierCurveSpans(const ON_NurbsCurve& curve)
+{
+  // ON_BezierCurveSpans must match ON_NurbsCurve::ConvertSpanToBezier()
+  // on every non-empty span.
+  unsigned int failure_count = 0;
+  ON_BezierCurveSpans spans;
+  if (!spans.Create(curve) || spans.SpanCount() != curve.SpanCount())
+    return 1;
+  const int cv_size = curve.CVSize();
+  int span_index = 0;
+  for (int k = 0; k <= curve.m_cv_count - curve.m_order; k++)
+  {
+    if (!(curve.m_knot[k + curve.m_order - 2] < curve.m_knot[k + curve.m_order - 1]))
+      continue;
+    ON_BezierCurve expected, bezier;
+    if (!curve.ConvertSpanToBezier(k, expected) || !spans.GetSpan(span_index, bezier))
+      failure_count++;
+    else if (
+      bezier.m_order != expected.m_order
+      || bezier.m_is_rat != expected.m_is_rat
+      || spans.SpanDomain(span_index) != ON_Interval(curve.m_knot[k + curve.m_order - 2], curve.m_knot[k + curve.m_order - 1])
+      )
+      failure_count++;
+    else
+    {
+      for (int a = 0; a < expected.m_order; a++)
+      {
+        if (!Internal_SameCVs(bezier.CV(a), expected.CV(a), cv_size))
+          failure_count++;
+      }
+    }
+    span_index++;
+  }
+  if (span_index != spans.SpanCount())
+    failure_count++;
+  return failure_count;
+}
+
+static unsigned int Internal_TestBezierSurfacePatches(const ON_NurbsSurface& surface)
+{
+  // ON_BezierSurfacePatches must match ON_NurbsSurface::ConvertSpanToBezier()
+  // on every non-empty patch.
+  unsigned int failure_count = 0;
+  ON_BezierSurfacePatches patches;
+  if (!patches.Create(surface) || patches.SpanCount(0) != surface.SpanCount(0) || patches.SpanCount(1) != surface.SpanCount(1))
+    return 1;
+  const int cv_size = surface.CVSize();
+  int i = 0;
+  for (int k0 = 0; k0 <= surface.m_cv_count[0] - surface.m_order[0]; k0++)
+  {
+    if (!(surface.m_knot[0][k0 + surface.m_order[0] - 2] < surface.m_knot[0][k0 + surface.m_order[0] - 1]))
+      continue;
+    int j = 0;
+    for (int k1 = 0; k1 <= surface.m_cv_count[1] - surface.m_order[1]; k1++)
+    {
+      if (!(surface.m_knot[1][k1 + surface.m_order[1] - 2] < surface.m_knot[1][k1 + surface.m_order[1] - 1]))
+        continue;
+      ON_BezierSurface expected, bezier;
+      if (!surface.ConvertSpanToBezier(k0, k1, expected) || !patches.GetPatch(i, j, bezier))
+        failure_count++;
+      else if (bezier.m_order[0] != expected.m_order[0] || bezier.m_order[1] != expected.m_order[1] || bezier.m_is_rat != expected.m_is_rat)
+        failure_count++;
+      else
+      {
+        for (int a = 0; a < expected.m_order[0]; a++)
+        {
+          for (int b = 0; b < expected.m_order[1]; b++)
+          {
+            if (!Internal_SameCVs(bezier.CV(a, b), expected.CV(a, b), cv_size))
+              failure_count++;
+          }
+        }
+      }
+      j++;
+    }
+    i++;
+  }
+  if (i != patches.SpanCount(0))
+    failure_count++;
+  return failure_count;
+}
+
+static const ONX_ErrorCounter Internal_TestBezierExtraction(
+  ON_TextLog& text_log
+  )
+{
+  ONX_ErrorCounter error_counter;
+  unsigned int failure_count = 0;
+
+  // clamped rational curve and surface
+  ON_NurbsCurve circle;
+  ON_Circle(ON_Plane::World_xy, 2.0).GetNurbForm(circle);
+  ON_NurbsSurface sphere;
+  ON_Sphere(ON_3dPoint(1.0, 2.0, 3.0), 4.0).GetNurbForm(sphere);
+  failure_count += Internal_TestBezierCurveSpans(circle);
+  failure_count += Internal_TestBezierSurfacePatches(sphere);
+
+  // Unclamped knot vector with a double knot and a triple knot.
+  const double knot[13] = { 0.0, 1.0, 2.0, 3.0, 3.0, 4.0, 5.0, 5.0, 5.0, 6.0, 7.0, 8.0, 9.0 };
+  ON_NurbsCurve curve(3, false, 4, 11);
+  for (int k = 0; k < 13; k++)
+    curve.m_knot[k] = knot[k];
+  for (int i = 0; i < curve.m_cv_count; i++)
+    curve.SetCV(i, ON_3dPoint(i, sin(i), cos(0.5 * i)));
+  failure_count += Internal_TestBezierCurveSpans(curve);
+
+  ON_NurbsSurface surface(3, true, 4, 3, 11, 6);
+  for (int k = 0; k < 13; k++)
+    surface.m_knot[0][k] = knot[k];
+  surface.MakeClampedUniformKnotVector(1, 1.0);
+  for (int i = 0; i < surface.m_cv_count[0]; i++)
+  {
+    for (int j = 0; j < surface.m_cv_count[1]; j++)
+      surface.SetCV(i, j, ON_4dPoint(i, j, sin(i + 2.0 * j), 1.0 + 0.25 * ((i + j) % 3)));
+  }
+  failure_count += Internal_TestBezierSurfacePatches(surface);
+
+  // Transpose() swaps the CV strides, so the rows are not contiguous.
+  surface.Transpose();
+  failure_count += Internal_TestBezierSurfacePatches(surface);
+
+  if (failure_count > 0)
+    text_log.Print("Bezier extraction test: %u failures.\n", failure_count);
+  for (unsigned int i = 0; i < failure_count; i++)
+    error_counter.IncrementFailureCount();
+
+  return error_counter;
+}
+
+static bool Internal_SameVector(const ON_3dVector& a, const ON_3dVector& b, double tolerance)
+{
+  return (a - b).MaximumCoordinate() <= tolerance * (1.0 + a.MaximumCoordinate());
+}
+
+static unsigned int Internal_TestSurfaceGrid(
+  const ON_Surface& surface,
+  int s_count,
+  const double* s,
+  int t_count,
+  const double* t
+  )
+{
+  // EvaluateGrid() must agree with Ev1Der() and EvNormal() at every grid point.
+  unsigned int failure_count = 0;
+  const int count = s_count * t_count;
+  ON_SimpleArray<ON_3dPoint> points(count), grid_points(count);
+  ON_SimpleArray<ON_3dVector> ds(count), dt(count), normals(count);
+  points.SetCount(count);
+  grid_points.SetCount(count);
+  ds.SetCount(count);
+  dt.SetCount(count);
+  normals.SetCount(count);
+  if (!surface.EvaluateGrid(s_count, s, t_count, t, points.Array(), ds.Array(), dt.Array(), normals.Array()))
+    failure_count++;
+  // points only
+  if (!surface.EvaluateGrid(s_count, s, t_count, t, grid_points.Array(), nullptr, nullptr, nullptr))
+    failure_count++;
+  for (int i = 0; i < s_count; i++)
+  {
+    for (int j = 0; j < t_count; j++)
+    {
+      const int k = i * t_count + j;
+      ON_3dPoint P, Q;
+      ON_3dVector Ds, Dt, N;
+      if (!surface.Ev1Der(s[i], t[j], P, Ds, Dt))
+        failure_count++;
+      else if (
+        !Internal_SameVector(points[k] - ON_3dPoint::Origin, P - ON_3dPoint::Origin, 1.0e-12)
+        || !Internal_SameVector(grid_points[k] - ON_3dPoint::Origin, P - ON_3dPoint::Origin, 1.0e-12)
+        )
+        failure_count++;
+      // At singular points EvNormal() returns the derivatives it used.
+      if (!surface.EvNormal(s[i], t[j], Q, Ds, Dt, N))
+        failure_count++;
+      else if (
+        !Internal_SameVector(ds[k], Ds, 1.0e-10)
+        || !Internal_SameVector(dt[k], Dt, 1.0e-10)
+        || !(fabs(normals[k].Length() - 1.0) <= 1.0e-12)
+        || !(normals[k] * N >= 1.0 - 1.0e-10)
+        )
+        failure_count++;
+    }
+  }
+  return failure_count;
+}
+
+static const ONX_ErrorCounter Internal_TestEvaluateGrid(
+  ON_TextLog& text_log
+  )
+{
+  ONX_ErrorCounter error_counter;
+  unsigned int failure_count = 0;
+
+  // rational surface with a pole at each end of the first parameter
+  ON_NurbsSurface sphere;
+  ON_Sphere(ON_3dPoint(1.0, 2.0, 3.0), 4.0).GetNurbForm(sphere);
+  {
+    const ON_Interval d0 = sphere.Domain(0);
+    const ON_Interval d1 = sphere.Domain(1);
+    double s[9], t[11];
+    for (int i = 0; i < 9; i++)
+      s[i] = d0.ParameterAt(i / 8.0);
+    for (int j = 0; j < 11; j++)
+      t[j] = d1.ParameterAt(j / 10.0);
+    failure_count += Internal_TestSurfaceGrid(sphere, 9, s, 11, t);
+  }
+
+  // Cone with the apex at a collapsed edge.
+  ON_NurbsSurface cone;
+  if (0 == ON_Cone(ON_Plane::World_xy, 3.0, 1.5).GetNurbForm(cone))
+    failure_count++;
+  else
+  {
+    const ON_Interval d0 = cone.Domain(0);
+    const ON_Interval d1 = cone.Domain(1);
+    double s[7], t[6];
+    for (int i = 0; i < 7; i++)
+      s[i] = d0.ParameterAt(i / 6.0);
+    for (int j = 0; j < 6; j++)
+      t[j] = d1.ParameterAt(j / 5.0);
+    failure_count += Internal_TestSurfaceGrid(cone, 7, s, 6, t);
+  }
+
+  // Rational surface with an unclamped knot vector, a double knot and a
+  // triple knot, a collapsed edge and unsorted parameters.
+  const double knot[13] = { 0.0, 1.0, 2.0, 3.0, 3.0, 4.0, 5.0, 5.0, 5.0, 6.0, 7.0, 8.0, 9.0 };
+  ON_NurbsSurface surface(3, true, 4, 3, 11, 6);
+  for (int k = 0; k < 13; k++)
+    surface.m_knot[0][k] = knot[k];
+  surface.MakeClampedUniformKnotVector(1, 1.0);
+  for (int i = 0; i < surface.m_cv_count[0]; i++)
+  {
+    for (int j = 0; j < surface.m_cv_count[1]; j++)
+    {
+      const double w = 1.0 + 0.25 * ((i + j) % 3);
+      const ON_3dPoint P = (0 == j) ? ON_3dPoint(2.0, 1.0, 0.5) : ON_3dPoint(i, j, sin(i + 2.0 * j));
+      surface.SetCV(i, j, ON_4dPoint(w * P.x, w * P.y, w * P.z, w));
+    }
+  }
+  {
+    const double s[10] = { 2.0, 7.0, 3.0, 2.5, 5.0, 4.0, 6.5, 3.0, 5.5, 7.0 };
+    const double t[8] = { 0.0, 4.0, 1.0, 0.25, 2.0, 3.5, 1.0, 0.0 };
+    failure_count += Internal_TestSurfaceGrid(surface, 10, s, 8, t);
+    // Transpose() swaps the CV strides, so the rows are not contiguous.
+    ON_NurbsSurface transposed(surface);
+    transposed.Transpose();
+    failure_count += Internal_TestSurfaceGrid(transposed, 8, t, 10, s);
+  }
+
+  // ON_Surface::EvaluateGrid()
+  ON_PlaneSurface plane(ON_Plane(ON_3dPoint(1.0, 2.0, 3.0), ON_3dVector(1.0, 1.0, 2.0)));
+  {
+    const double s[3] = { -1.0, 0.0, 0.5 };
+    const double t[2] = { 0.25, 1.0 };
+    failure_count += Internal_TestSurfaceGrid(plane, 3, s, 2, t);
+  }
+
+  if (failure_count > 0)
+    text_log.Print("Surface grid evaluation test: %u failures.\n", failure_count);
+  for (unsigned int i = 0; i < failure_count; i++)
+    error_counter.IncrementFailureCount();
+
+  return error_counter;
+}
+
+static double Internal_SampleDistance(const ON_SimpleArray<ON_3dPoint>& samples, const ON_3dPoint& P)
+{
+  double d = ON_DBL_MAX;
+  for (int i = 0; i < samples.Count(); i++)
+  {
+    const double x = P.DistanceTo(samples[i]);
+    if (x < d)
+      d = x;
+  }
+  return d;
+}
+
+static unsigned int Internal_TestCurveClosestPoint(
+  const ON_Curve& curve,
+  ON_RandomNumberGenerator& rng
+  )
+{
+  // The closest point can not be farther than the closest of many samples.
+  unsigned int failure_count = 0;
+  const ON_Interval domain = curve.Domain();
+  const int sample_count = 20000;
+  ON_SimpleArray<ON_3dPoint> samples(sample_count + 1);
+  for (int i = 0; i <= sample_count; i++)
+    samples.Append(curve.PointAt(domain.ParameterAt(((double)i) / ((double)sample_count))));
+
+  const int point_count = 60;
+  ON_SimpleArray<ON_3dPoint> points(point_count);
+  for (int i = 0; i < point_count; i++)
+  {
+    const ON_3dVector V(rng.RandomDouble(-2.0, 2.0), rng.RandomDouble(-2.0, 2.0), rng.RandomDouble(-2.0, 2.0));
+    points.Append(curve.PointAt(domain.ParameterAt(rng.RandomDouble(0.0, 1.0))) + ((0 == i % 10) ? 5.0 : 1.0) * V);
+  }
+
+  ON_SimpleArray<double> t(point_count);
+  t.SetCount(point_count);
+  if (point_count != (int)curve.GetClosestPoints(point_count, points.Array(), t.Array(), 0.0, nullptr, 4))
+    failure_count++;
+  for (int i = 0; i < point_count; i++)
+  {
+    const ON_3dPoint& P = points[i];
+    double t0 = ON_UNSET_VALUE, t1 = ON_UNSET_VALUE;
+    if (!curve.GetClosestPoint(P, &t0) || !domain.Includes(t0) || !(t0 == t[i]))
+    {
+      failure_count++;
+      continue;
+    }
+    const double d = P.DistanceTo(curve.PointAt(t0));
+    if (!(d <= Internal_SampleDistance(samples, P) + 1.0e-8))
+      failure_count++;
+    // No point is closer than d.
+    if (curve.GetClosestPoint(P, &t1, 0.5 * d))
+      failure_count++;
+    if (!curve.GetClosestPoint(P, &t1, 2.0 * d + 1.0e-6) || !(fabs(P.DistanceTo(curve.PointAt(t1)) - d) <= 1.0e-10))
+      failure_count++;
+  }
+  return failure_count;
+}
+
+static unsigned int Internal_TestSurfaceClosestPoint(
+  const ON_Surface& surface,
+  const ON_Circle* hole,
+  ON_SimpleArray<ON_3dPoint>& points,
+  ON_RandomNumberGenerator& rng
+  )
+{
+  // hole is the circular inner trim of a face in parameter space.
+  unsigned int failure_count = 0;
+  const ON_Interval domain[2] = { surface.Domain(0), surface.Domain(1) };
+  const int n = 300;
+  ON_SimpleArray<ON_3dPoint> samples((n + 1) * (n + 1) + 4 * n);
+  for (int i = 0; i <= n; i++)
+  {
+    for (int j = 0; j <= n; j++)
+    {
+      const double s = domain[0].ParameterAt(((double)i) / ((double)n));
+      const double t = domain[1].ParameterAt(((double)j) / ((double)n));
+      if (nullptr == hole || hole->Center().DistanceTo(ON_3dPoint(s, t, 0.0)) >= hole->Radius())
+        samples.Append(surface.PointAt(s, t));
+    }
+  }
+  if (nullptr != hole)
+  {
+    for (int i = 0; i < 4 * n; i++)
+    {
+      const ON_3dPoint uv = hole->PointAt(2.0 * ON_PI * i / (4.0 * n));
+      samples.Append(surface.PointAt(uv.x, uv.y));
+    }
+  }
+
+  for (int i = 0; i < 40; i++)
+  {
+    const double s = domain[0].ParameterAt(rng.RandomDouble(0.0, 1.0));
+    const double t = domain[1].ParameterAt(rng.RandomDouble(0.0, 1.0));
+    const ON_3dVector N = surface.NormalAt(s, t);
+    const ON_3dVector V(rng.RandomDouble(-0.1, 0.1), rng.RandomDouble(-0.1, 0.1), rng.RandomDouble(-0.1, 0.1));
+    points.Append(surface.PointAt(s, t) + rng.RandomDouble(-1.5, 1.5) * N + V);
+  }
+
+  const int point_count = points.Count();
+  ON_SimpleArray<double> s(point_count), t(point_count);
+  s.SetCount(point_count);
+  t.SetCount(point_count);
+  if (point_count != (int)surface.GetClosestPoints(point_count, points.Array(), s.Array(), t.Array(), 0.0, nullptr, nullptr, 4))
+    failure_count++;
+  for (int i = 0; i < point_count; i++)
+  {
+    const ON_3dPoint& P = points[i];
+    double s0 = ON_UNSET_VALUE, t0 = ON_UNSET_VALUE, s1 = ON_UNSET_VALUE, t1 = ON_UNSET_VALUE;
+    if (
+      !surface.GetClosestPoint(P, &s0, &t0) 
+      || !domain[0].Includes(s0) || !domain[1].Includes(t0) 
+      || !(s0 == s[i]) || !(t0 == t[i])
+      )
+    {
+      failure_count++;
+      continue;
+    }
+    // The closest point is not trimmed away and is not farther than any sample.
+    if (nullptr != hole && !(hole->Center().DistanceTo(ON_3dPoint(s0, t0, 0.0)) >= hole->Radius() - 1.0e-8))
+      failure_count++;
+    const double d = P.DistanceTo(surface.PointAt(s0, t0));
+    if (!(d <= Internal_SampleDistance(samples, P) + 1.0e-8))
+      failure_count++;
+    if (d > 1.0e-3 && surface.GetClosestPoint(P, &s1, &t1, 0.5 * d))
+      failure_count++;
+  }
+  return failure_count;
+}
+
+static const ON_BrepFace* Internal_FaceWithHole(
+  const ON_NurbsSurface& surface,
+  const ON_Circle& hole,
+  ON_Brep& brep
+  )
+{
+  // hole is a circle in the surface parameter space.
+  if (nullptr == brep.NewFace(surface))
+    return nullptr;
+
+  // The inner loop is clockwise.
+  ON_NurbsCurve* c2 = new ON_NurbsCurve();
+  hole.GetNurbForm(*c2);
+  c2->Reverse();
+  c2->ChangeDimension(2);
+  const int c2i = brep.AddTrimCurve(c2);
+  ON_Polyline pline(401);
+  for (int i = 0; i <= 400; i++)
+  {
+    const ON_3dPoint uv = c2->PointAt(c2->Domain().ParameterAt(i / 400.0));
+    pline.Append(surface.PointAt(uv.x, uv.y));
+  }
+  pline[400] = pline[0];
+  ON_PolylineCurve* c3 = new ON_PolylineCurve(pline);
+  c3->SetDomain(c2->Domain().Min(), c2->Domain().Max());
+  const int c3i = brep.AddEdgeCurve(c3);
+  ON_BrepVertex& vertex = brep.NewVertex(c3->PointAtStart(), 0.0);
+  ON_BrepEdge& edge = brep.NewEdge(vertex, vertex, c3i, nullptr, 0.01);
+  ON_BrepLoop& loop = brep.NewLoop(ON_BrepLoop::inner, brep.m_F[0]);
+  ON_BrepTrim& trim = brep.NewTrim(edge, false, loop, c2i);
+  trim.m_type = ON_BrepTrim::boundary;
+  trim.m_tolerance[0] = trim.m_tolerance[1] = 0.0;
+  return &brep.m_F[0];
+}
+
+static const ONX_ErrorCounter Internal_TestClosestPoint(
+  ON_TextLog& text_log
+  )
+{
+  ONX_ErrorCounter error_counter;
+  unsigned int failure_count = 0;
+  ON_RandomNumberGenerator rng;
+  rng.Seed(17);
+
+  // rational curve
+  ON_NurbsCurve circle;
+  ON_Circle(ON_Plane::World_xy, 2.0).GetNurbForm(circle);
+  failure_count += Internal_TestCurveClosestPoint(circle, rng);
+
+  // NURBS curve with kinks at full multiplicity knots
+  const double knot[12] = { 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 2.0, 2.0, 2.0, 3.0, 3.0, 3.0 };
+  ON_NurbsCurve kinked(3, false, 4, 10);
+  for (int k = 0; k < 12; k++)
+    kinked.m_knot[k] = knot[k];
+  for (int i = 0; i < kinked.m_cv_count; i++)
+    kinked.SetCV(i, ON_3dPoint(i, (i % 2) ? 1.5 : -1.0, 0.25 * i * i));
+  failure_count += Internal_TestCurveClosestPoint(kinked, rng);
+
+  // polycurve
+  ON_PolyCurve polycurve;
+  polycurve.Append(new ON_LineCurve(ON_3dPoint(-3.0, 0.0, 0.0), ON_3dPoint(0.0, 0.0, 0.0)));
+  polycurve.Append(new ON_ArcCurve(ON_Arc(ON_3dPoint(0.0, 0.0, 0.0), ON_3dPoint(1.0, 1.0, 0.0), ON_3dPoint(2.0, 0.0, 0.0))));
+  ON_NurbsCurve* tail = kinked.Duplicate();
+  tail->Translate(ON_3dPoint(2.0, 0.0, 0.0) - tail->PointAtStart());
+  polycurve.Append(tail);
+  failure_count += Internal_TestCurveClosestPoint(polycurve, rng);
+
+  // Poles: points on the axis and near the axis
+  const ON_Sphere sphere(ON_3dPoint(1.0, 2.0, 3.0), 4.0);
+  ON_NurbsSurface nurbs_sphere;
+  sphere.GetNurbForm(nurbs_sphere);
+  ON_SimpleArray<ON_3dPoint> points;
+  points.Append(sphere.Center() + ON_3dVector(0.0, 0.0, 6.0));
+  points.Append(sphere.Center() + ON_3dVector(0.0, 0.0, -1.0));
+  points.Append(sphere.Center() + ON_3dVector(1.0e-6, 0.0, 4.5));
+  points.Append(sphere.Center() + ON_3dVector(0.0, -1.0e-3, -7.0));
+  failure_count += Internal_TestSurfaceClosestPoint(nurbs_sphere, nullptr, points, rng);
+
+  // The faces of ON_BrepSphere() are revolutions with singular trims at the poles.
+  ON_Brep sphere_brep;
+  if (nullptr == ON_BrepSphere(sphere, &sphere_brep) || 1 != sphere_brep.m_F.Count())
+    failure_count++;
+  else
+  {
+    points.SetCount(4);
+    failure_count += Internal_TestSurfaceClosestPoint(sphere_brep.m_F[0], nullptr, points, rng);
+  }
+
+  // Collapsed edge at the apex of a cone
+  const ON_Cone cone(ON_Plane::World_xy, 3.0, 1.5);
+  ON_NurbsSurface nurbs_cone;
+  if (0 == cone.GetNurbForm(nurbs_cone))
+    failure_count++;
+  else
+  {
+    points.SetCount(0);
+    points.Append(cone.ApexPoint() + ON_3dVector(0.0, 0.0, 1.0));
+    points.Append(cone.ApexPoint() + ON_3dVector(0.25, 0.0, 0.5));
+    failure_count += Internal_TestSurfaceClosestPoint(nurbs_cone, nullptr, points, rng);
+  }
+
+  // A bumpy surface and a face with a circular hole. The closest points on the
+  // untrimmed surface to points above the hole are trimmed away.
+  ON_NurbsSurface bumpy(3, false, 4, 4, 7, 6);
+  bumpy.MakeClampedUniformKnotVector(0, 1.0);
+  bumpy.MakeClampedUniformKnotVector(1, 1.0);
+  for (int i = 0; i < bumpy.m_cv_count[0]; i++)
+  {
+    for (int j = 0; j < bumpy.m_cv_count[1]; j++)
+      bumpy.SetCV(i, j, ON_3dPoint(i, j, sin(i + 2.0 * j)));
+  }
+  points.SetCount(0);
+  failure_count += Internal_TestSurfaceClosestPoint(bumpy, nullptr, points, rng);
+
+  const ON_Circle hole(ON_3dPoint(2.0, 1.5, 0.0), 0.75);
+  ON_Brep brep;
+  const ON_BrepFace* face = Internal_FaceWithHole(bumpy, hole, brep);
+  if (nullptr == face)
+    failure_count++;
+  else
+  {
+    points.SetCount(0);
+    for (int i = 0; i < 20; i++)
+    {
+      const ON_3dPoint uv = hole.PointAt(rng.RandomDouble(0.0, 2.0 * ON_PI));
+      const double r = rng.RandomDouble(0.0, 0.9);
+      const ON_3dPoint st = hole.Center() + r * (uv - hole.Center());
+      points.Append(bumpy.PointAt(st.x, st.y) + rng.RandomDouble(-1.0, 1.0) * bumpy.NormalAt(st.x, st.y));
+    }
+    failure_count += Internal_TestSurfaceClosestPoint(*face, &hole, points, rng);
+  }
+
+  // Two valleys. The hole removes the closest point in the first valley and
+  // the closest point on the face is in the second valley, not on the hole.
+  ON_NurbsSurface valleys(3, false, 3, 2, 9, 2);
+  valleys.MakeClampedUniformKnotVector(0, 1.0);
+  valleys.MakeClampedUniformKnotVector(1, 1.0);
+  for (int i = 0; i < valleys.m_cv_count[0]; i++)
+  {
+    for (int j = 0; j < valleys.m_cv_count[1]; j++)
+      valleys.SetCV(i, j, ON_3dPoint(0.5 * i, 3.0 * j, (0 == i % 2) ? ((0 == i % 4) ? 1.0 : -1.0) : 0.0));
+  }
+  const ON_3dPoint below(1.95, 1.5, -10.0);
+  double s0 = ON_UNSET_VALUE, t0 = ON_UNSET_VALUE;
+  ON_Brep valleys_brep;
+  const ON_BrepFace* valleys_face = nullptr;
+  if (valleys.GetClosestPoint(below, &s0, &t0))
+    valleys_face = Internal_FaceWithHole(valleys, ON_Circle(ON_3dPoint(s0, t0, 0.0), 0.25), valleys_brep);
+  if (nullptr == valleys_face)
+    failure_count++;
+  else
+  {
+    const ON_Circle valleys_hole(ON_3dPoint(s0, t0, 0.0), 0.25);
+    points.SetCount(0);
+    points.Append(below);
+    failure_count += Internal_TestSurfaceClosestPoint(*valleys_face, &valleys_hole, points, rng);
+  }
+
+  if (failure_count > 0)
+    text_log.Print("Closest point test: %u failures.\n", failure_count);
+  for (unsigned int i = 0; i < failure_count; i++)
+    error_counter.IncrementFailureCount();
+
+  return error_counter;
+}
+
+static bool Internal_SamePolyline(const ON_PolylineCurve* a, const ON_PolylineCurve* b)
+{
+  return nullptr != a && nullptr != b
+    && a->m_pline.Count() == b->m_pline.Count() && a->m_t.Count() == b->m_t.Count()
+    && Internal_SameBits(&a->m_pline[0].x, &b->m_pline[0].x, 3 * (size_t)a->m_pline.Count())
+    && Internal_SameBits(a->m_t.Array(), b->m_t.Array(), (size_t)a->m_t.Count());
+}
+
+static unsigned int Internal_TestMeshCurve(
+  const ON_Curve& curve,
+  const ON_MeshCurveParameters& mp,
+  const ON_SimpleArray<double>& kinks
+  )
+{
+  // Every chord must meet the tolerances in mp and kinks must be vertices.
+  unsigned int failure_count = 0;
+  ON_PolylineCurve* polyline = curve.MeshCurve(mp, nullptr, false, nullptr);
+  if (nullptr == polyline)
+    return 1;
+  const ON_Interval domain = curve.Domain();
+  const int count = polyline->m_pline.Count();
+  if (count < 2 || count != polyline->m_t.Count() || !(polyline->m_t[0] == domain[0]) || !(polyline->m_t[count - 1] == domain[1]))
+    failure_count++;
+  for (int i = 0; i < count && 0 == failure_count; i++)
+  {
+    if (i > 0 && !(polyline->m_t[i - 1] < polyline->m_t[i]))
+      failure_count++;
+    if (!(polyline->m_pline[i].DistanceTo(curve.PointAt(polyline->m_t[i])) <= 1.0e-10))
+      failure_count++;
+  }
+  for (int k = 0; k < kinks.Count(); k++)
+  {
+    if (polyline->m_t.Search(kinks[k]) < 0)
+      failure_count++;
+  }
+
+  for (int i = 0; i + 1 < count && 0 == failure_count; i++)
+  {
+    const ON_Line chord(polyline->m_pline[i], polyline->m_pline[i + 1]);
+    const double length = chord.Length();
+    if (mp.m_max_edge_length > 0.0 && !(length <= mp.m_max_edge_length * (1.0 + 1.0e-12)))
+      failure_count++;
+
+    // Tangents at the ends of the chord, evaluated from the chord side.
+    ON_3dPoint P;
+    ON_3dVector Da, Db;
+    if (!curve.Ev1Der(polyline->m_t[i], P, Da, 1) || !curve.Ev1Der(polyline->m_t[i + 1], P, Db, -1))
+      failure_count++;
+    else if (mp.m_max_ang_radians > 0.0 && !(ON_3dVector::Angle(Da, Db) <= mp.m_max_ang_radians + 1.0e-10))
+      failure_count++;
+
+    // The tolerances are tested at the middle of the chord parameters. The
+    // distance from the rest of the curve to the chord is close to that.
+    const ON_Interval chord_domain(polyline->m_t[i], polyline->m_t[i + 1]);
+    double h_mid = 0.0, h_max = 0.0;
+    for (int j = 1; j < 16; j++)
+    {
+      const ON_3dPoint Q = curve.PointAt(chord_domain.ParameterAt(j / 16.0));
+      double s = ON_UNSET_VALUE;
+      chord.ClosestPointTo(Q, &s);
+      const double h = Q.DistanceTo(chord.PointAt((s < 0.0) ? 0.0 : ((s > 1.0) ? 1.0 : s)));
+      if (8 == j)
+        h_mid = h;
+      if (h > h_max)
+        h_max = h;
+    }
+    if (mp.m_tolerance > 0.0 && !(h_mid <= mp.m_tolerance + 1.0e-12 && h_max <= 1.25 * mp.m_tolerance))
+      failure_count++;
+    if (mp.m_max_chr > 0.0 && !(h_mid <= mp.m_max_chr * length + 1.0e-12 && h_max <= 1.25 * mp.m_max_chr * length))
+      failure_count++;
+  }
+  delete polyline;
+  return failure_count;
+}
+
+static const ONX_ErrorCounter Internal_TestCurveMeshing(
+  ON_TextLog& text_log
+  )
+{
+  ONX_ErrorCounter error_counter;
+  unsigned int failure_count = 0;
+
+  ON_ArcCurve arc(ON_Arc(ON_Circle(ON_Plane::World_xy, 3.0), ON_Interval(0.25, 4.0)));
+  ON_NurbsCurve nurbs_arc;
+  arc.GetNurbForm(nurbs_arc);
+
+  // NURBS curve with kinks at full multiplicity knots
+  const double knot[12] = { 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 2.0, 2.0, 2.0, 3.0, 3.0, 3.0 };
+  ON_NurbsCurve kinked(3, false, 4, 10);
+  for (int k = 0; k < 12; k++)
+    kinked.m_knot[k] = knot[k];
+  for (int i = 0; i < kinked.m_cv_count; i++)
+    kinked.SetCV(i, ON_3dPoint(i, (i % 2) ? 1.5 : -1.0, 0.25 * i * i));
+
+  ON_PolyCurve polycurve;
+  polycurve.Append(new ON_LineCurve(ON_3dPoint(-3.0, 0.0, 0.0), ON_3dPoint(0.0, 0.0, 0.0)));
+  polycurve.Append(new ON_ArcCurve(ON_Arc(ON_3dPoint(0.0, 0.0, 0.0), ON_3dPoint(1.0, 1.0, 0.0), ON_3dPoint(2.0, 0.0, 0.0))));
+  ON_NurbsCurve* tail = kinked.Duplicate();
+  tail->Translate(ON_3dPoint(2.0, 0.0, 0.0) - tail->PointAtStart());
+  polycurve.Append(tail);
+
+  const ON_Curve* curves[4] = { &arc, &nurbs_arc, &kinked, &polycurve };
+  ON_SimpleArray<double> kinks[4];
+  kinks[2].Append(1.0);
+  kinks[2].Append(2.0);
+  for (int i = 1; i < polycurve.Count(); i++)
+    kinks[3].Append(polycurve.SegmentDomain(i)[0]);
+  kinks[3].Append(polycurve.SegmentDomain(2).ParameterAt(1.0 / 3.0));
+  kinks[3].Append(polycurve.SegmentDomain(2).ParameterAt(2.0 / 3.0));
+
+  ON_MeshCurveParameters mp[5];
+  mp[0].m_tolerance = 0.01;
+  mp[1].m_tolerance = 1.0e-4;
+  mp[2].m_max_ang_radians = 5.0 * ON_DEGREES_TO_RADIANS;
+  mp[3].m_max_chr = 0.01;
+  mp[4].m_tolerance = 0.001;
+  mp[4].m_max_ang_radians = 10.0 * ON_DEGREES_TO_RADIANS;
+  mp[4].m_max_edge_length = 0.5;
+  for (int i = 0; i < 5; i++)
+  {
+    for (int j = 0; j < 4; j++)
+      failure_count += Internal_TestMeshCurve(*curves[j], mp[i], kinks[j]);
+  }
+
+  // MeshCurves() and ONX_Model::GetCurvePolylines() get the same bits as MeshCurve().
+  ONX_Model model;
+  ON_UUID ids[4];
+  for (int j = 0; j < 4; j++)
+    ids[j] = model.AddModelGeometryComponent(curves[j], nullptr).ModelComponentId();
+  for (int i = 0; i < 5; i++)
+  {
+    ON_SimpleArray<ON_PolylineCurve*> expected, polylines, model_polylines;
+    ON_SimpleArray<ON_UUID> model_ids;
+    for (int j = 0; j < 4; j++)
+      expected.Append(curves[j]->MeshCurve(mp[i], nullptr, false, nullptr));
+    if (4 != ON_Curve::MeshCurves(4, curves, mp[i], polylines, 4) || 4 != polylines.Count())
+      failure_count++;
+    else
+    {
+      for (int j = 0; j < 4; j++)
+      {
+        if (!Internal_SamePolyline(expected[j], polylines[j]))
+          failure_count++;
+      }
+    }
+    if (4 != model.GetCurvePolylines(mp[i], 4, model_ids, model_polylines) || 4 != model_ids.Count() || 4 != model_polylines.Count())
+      failure_count++;
+    else
+    {
+      for (int k = 0; k < 4; k++)
+      {
+        int j = 0;
+        while (j < 4 && !(ids[j] == model_ids[k]))
+          j++;
+        if (j >= 4 || !Internal_SamePolyline(expected[j], model_polylines[k]))
+          failure_count++;
+      }
+    }
+    for (int j = 0; j < expected.Count(); j++)
+      delete expected[j];
+    for (int j = 0; j < polylines.Count(); j++)
+      delete polylines[j];
+    for (int j = 0; j < model_polylines.Count(); j++)
+      delete model_polylines[j];
+  }
+
+  if (failure_count > 0)
+    text_log.Print("Curve meshing test: %u failures.\n", failure_count);
+  for (unsigned int i = 0; i < failure_count; i++)
+    error_counter.IncrementFailureCount();
+
+  return error_counter;
+}
+
+// The tight box must contain every sample and be at most slack larger
+// than the box of the samples.
+static unsigned int Internal_TestTightBox(
+  const ON_BoundingBox& tight_bbox,
+  const ON_BoundingBox& sample_bbox,
+  double slack
+  )
+{
+  if (!tight_bbox.IsValid() || !sample_bbox.IsValid())
+    return 1;
+  const double tolerance = 1.0e-12 * (sample_bbox.m_max - sample_bbox.m_min).MaximumCoordinate() + 1.0e-14;
+  unsigned int failure_count = 0;
+  for (int j = 0; j < 3; j++)
+  {
+    if (!(tight_bbox.m_min[j] <= sample_bbox.m_min[j] + tolerance) || !(tight_bbox.m_max[j] >= sample_bbox.m_max[j] - tolerance))
+      failure_count++;
+    if (!(tight_bbox.m_min[j] >= sample_bbox.m_min[j] - slack) || !(tight_bbox.m_max[j] <= sample_bbox.m_max[j] + slack))
+      failure_count++;
+  }
+  return failure_count;
+}
+
+static ON_BoundingBox Internal_CurveSampleBox(const ON_Curve& curve, const ON_Xform* xform)
+{
+  ON_BoundingBox bbox;
+  const ON_Interval domain = curve.Domain();
+  const int n = 4000;
+  for (int i = 0; i <= n; i++)
+  {
+    ON_3dPoint P = curve.PointAt(domain.ParameterAt(i / ((double)n)));
+    if (nullptr != xform)
+      P = (*xform) * P;
+    bbox.Set(P, 0 != i);
+  }
+  return bbox;
+}
+
+static ON_BoundingBox Internal_SurfaceSampleBox(const ON_Surface& surface, const ON_Xform* xform)
+{
+  ON_BoundingBox bbox;
+  const ON_Interval udomain = surface.Domain(0);
+  const ON_Interval vdomain = surface.Domain(1);
+  const int n = 300;
+  for (int i = 0; i <= n; i++)
+  {
+    for (int j = 0; j <= n; j++)
+    {
+      ON_3dPoint P = surface.PointAt(udomain.ParameterAt(i / ((double)n)), vdomain.ParameterAt(j / ((double)n)));
+      if (nullptr != xform)
+        P = (*xform) * P;
+      bbox.Set(P, 0 != i || 0 != j);
+    }
+  }
+  return bbox;
+}
+
+static unsigned int Internal_TestCurveTightBox(const ON_Curve& curve, const ON_Xform* xform, double slack)
+{
+  ON_BoundingBox tight_bbox;
+  if (!curve.GetTightBoundingBox(tight_bbox, false, xform))
+    return 1;
+  return Internal_TestTightBox(tight_bbox, Internal_CurveSampleBox(curve, xform), slack);
+}
+
+static unsigned int Internal_TestSurfaceTightBox(const ON_Surface& surface, const ON_Xform* xform, double slack)
+{
+  ON_BoundingBox tight_bbox;
+  if (!surface.GetTightBoundingBox(tight_bbox, false, xform))
+    return 1;
+  return Internal_TestTightBox(tight_bbox, Internal_SurfaceSampleBox(surface, xform), slack);
+}
+
+static const ONX_ErrorCounter Internal_TestTightBoundingBox(
+  ON_TextLog& text_log
+  )
+{
+  ONX_ErrorCounter error_counter;
+  unsigned int failure_count = 0;
+
+  ON_RandomNumberGenerator rng;
+  rng.Seed(20);
+  ON_Xform xform;
+  xform.Rotation(0.7, ON_3dVector(1.0, 2.0, 3.0), ON_3dPoint(1.0, -1.0, 0.5));
+  xform = ON_Xform::ScaleTransformation(ON_3dPoint::Origin, 2.0, 0.5, 1.5) * xform;
+  const ON_Xform* xforms[2] = { nullptr, &xform };
+
+  // Circles and spheres have exact boxes.
+  const double radius = 3.0;
+  ON_NurbsCurve circle;
+  ON_ArcCurve(ON_Circle(ON_Plane::World_xy, radius)).GetNurbForm(circle);
+  ON_BoundingBox circle_bbox;
+  if (!circle.GetTightBoundingBox(circle_bbox) || !(circle_bbox.m_min.DistanceTo(ON_3dPoint(-radius, -radius, 0.0)) <= 1.0e-12) || !(circle_bbox.m_max.DistanceTo(ON_3dPoint(radius, radius, 0.0)) <= 1.0e-12))
+    failure_count++;
+  ON_NurbsSurface sphere;
+  ON_Sphere(ON_3dPoint::Origin, radius).GetNurbForm(sphere);
+  ON_BoundingBox sphere_bbox;
+  if (!sphere.GetTightBoundingBox(sphere_bbox) || !(sphere_bbox.m_min.DistanceTo(ON_3dPoint(-radius, -radius, -radius)) <= 1.0e-9) || !(sphere_bbox.m_max.DistanceTo(ON_3dPoint(radius, radius, radius)) <= 1.0e-9))
+    failure_count++;
+
+  // Random rational cubic curves and bicubic surfaces. Interior control 
+  // points are outside the surface, so the boxes are much smaller than
+  // the control point hulls.
+  for (int test_index = 0; test_index < 4; test_index++)
+  {
+    const bool bIsRational = (test_index % 2) ? true : false;
+    ON_NurbsCurve curve(3, bIsRational, 4, 7);
+    curve.MakeClampedUniformKnotVector(1.0);
+    for (int i = 0; i < curve.m_cv_count; i++)
+    {
+      const double w = bIsRational ? rng.RandomDouble(0.5, 2.0) : 1.0;
+      curve.SetCV(i, ON_4dPoint(w * rng.RandomDouble(-10.0, 10.0), w * rng.RandomDouble(-10.0, 10.0), w * rng.RandomDouble(-10.0, 10.0), w));
+    }
+    ON_NurbsSurface surface(3, bIsRational, 4, 4, 6, 5);
+    surface.MakeClampedUniformKnotVector(0, 1.0);
+    surface.MakeClampedUniformKnotVector(1, 1.0);
+    for (int i = 0; i < surface.m_cv_count[0]; i++)
+    {
+      for (int j = 0; j < surface.m_cv_count[1]; j++)
+      {
+        const double w = bIsRational ? rng.RandomDouble(0.5, 2.0) : 1.0;
+        surface.SetCV(i, j, ON_4dPoint(w * rng.RandomDouble(-10.0, 10.0), w * rng.RandomDouble(-10.0, 10.0), w * rng.RandomDouble(-10.0, 10.0), w));
+      }
+    }
+    for (int k = 0; k < 2; k++)
+    {
+      failure_count += Internal_TestCurveTightBox(curve, xforms[k], 1.0e-4);
+      failure_count += Internal_TestSurfaceTightBox(surface, xforms[k], 1.0e-2);
+    }
+  }
+
+  // f(u,v) = -(u^2 - u + v^2 - v + 0.4)^2 has its maximum 0 along a 
+  // circle in the interior and its minimum -0.16 at the corners. a[p][q]
+  // is the coefficient of u^p v^q. The bezier has degree 4 in u and v.
+  double a[5][5] = {};
+  a[0][0] = -0.16;
+  a[1][0] = a[0][1] = 0.8;
+  a[2][0] = a[0][2] = -1.8;
+  a[3][0] = a[0][3] = 2.0;
+  a[4][0] = a[0][4] = -1.0;
+  a[1][1] = -2.0;
+  a[2][1] = a[1][2] = 2.0;
+  a[2][2] = -2.0;
+  const double binomial[5][5] = { {1}, {1,1}, {1,2,1}, {1,3,3,1}, {1,4,6,4,1} };
+  ON_BezierSurface ridge(3, false, 5, 5);
+  for (int k = 0; k <= 4; k++)
+  {
+    for (int l = 0; l <= 4; l++)
+    {
+      double z = 0.0;
+      for (int p = 0; p <= k; p++)
+      {
+        for (int q = 0; q <= l; q++)
+          z += binomial[k][p] / binomial[4][p] * binomial[l][q] / binomial[4][q] * a[p][q];
+      }
+      ridge.SetCV(k, l, ON_3dPoint(0.25 * k, 0.25 * l, z));
+    }
+  }
+  const ON_3dPoint ridge_point = ridge.PointAt(0.5 + sqrt(0.1), 0.5);
+  if (!(fabs(ridge_point.z) <= 1.0e-14))
+    failure_count++;
+  ON_NurbsSurface nurbs_ridge;
+  ridge.GetNurbForm(nurbs_ridge);
+  ON_BoundingBox ridge_bbox;
+  if (!ridge.GetTightBoundingBox(ridge_bbox) || !(ridge_bbox.m_max.z >= 0.0 && ridge_bbox.m_max.z <= 1.0e-6) || !(fabs(ridge_bbox.m_min.z + 0.16) <= 1.0e-14))
+    failure_count++;
+  for (int k = 0; k < 2; k++)
+    failure_count += Internal_TestSurfaceTightBox(nurbs_ridge, xforms[k], 1.0e-4);
+
+  // Cached boxes are used until the geometry changes.
+  ON_TightBoundingBoxCache cache;
+  ON_NurbsCurve cached_curve(circle);
+  ON_NurbsSurface cached_surface(sphere);
+  const ON_SurfaceProxy proxy(&cached_surface);
+  ON_Mesh mesh;
+  mesh.SetVertex(mesh.m_V.Count(), ON_3fPoint(0.0f, 0.0f, 0.0f));
+  mesh.SetVertex(mesh.m_V.Count(), ON_3fPoint(1.0f, 0.0f, 0.0f));
+  mesh.SetVertex(mesh.m_V.Count(), ON_3fPoint(0.0f, 1.0f, 0.0f));
+  mesh.SetTriangle(0, 0, 1, 2);
+  ON_BoundingBox bbox;
+  if (!cache.GetTightBoundingBox(cached_curve, bbox) || bbox.m_min != circle_bbox.m_min || bbox.m_max != circle_bbox.m_max)
+    failure_count++;
+  if (!cache.GetTightBoundingBox(proxy, bbox) || !cache.GetTightBoundingBox(mesh, bbox) || 2 != cache.Count())
+    failure_count++;
+  if (!cache.Find(cached_curve, bbox) || !cache.Find(proxy, bbox) || cache.Find(mesh, bbox) || cache.Find(cached_surface, bbox))
+    failure_count++;
+  cached_curve.Translate(ON_3dVector(1.0, 0.0, 0.0));
+  cached_surface.Translate(ON_3dVector(0.0, 0.0, 1.0));
+  if (cache.Find(cached_curve, bbox) || cache.Find(proxy, bbox))
+    failure_count++;
+  if (!cache.GetTightBoundingBox(cached_curve, bbox) || !(fabs(bbox.m_min.x - (1.0 - radius)) <= 1.0e-12))
+    failure_count++;
+  if (!cache.GetTightBoundingBox(proxy, bbox) || !(fabs(bbox.m_max.z - (1.0 + radius)) <= 1.0e-9) || 2 != cache.Count())
+    failure_count++;
+  cached_curve = circle;
+  if (cache.Find(cached_curve, bbox))
+    failure_count++;
+
+  // ONX_Model::GetTightBoundingBoxes() gets the same boxes with and 
+  // without a cache, and keeps the boxes of the curves and surfaces.
+  ONX_Model model;
+  model.AddModelGeometryComponent(&circle, nullptr);
+  model.AddModelGeometryComponent(&sphere, nullptr);
+  model.AddModelGeometryComponent(&nurbs_ridge, nullptr);
+  model.AddModelGeometryComponent(&mesh, nullptr);
+  ON_TightBoundingBoxCache model_cache;
+  for (int pass = 0; pass < 2; pass++)
+  {
+    ON_SimpleArray<ON_UUID> ids, cached_ids;
+    ON_SimpleArray<ON_BoundingBox> boxes, cached_boxes;
+    if (4 != model.GetTightBoundingBoxes(4, ids, boxes) || 4 != model.GetTightBoundingBoxes(4, cached_ids, cached_boxes, &model_cache))
+      failure_count++;
+    else
+    {
+      for (int i = 0; i < 4; i++)
+      {
+        if (!(ids[i] == cached_ids[i]) || boxes[i].m_min != cached_boxes[i].m_min || boxes[i].m_max != cached_boxes[i].m_max)
+          failure_count++;
+      }
+    }
+    if (3 != model_cache.Count())
+      failure_count++;
+  }
+
+  if (failure_count > 0)
+    text_log.Print("Tight bounding box test: %u failures.\n", failure_count);
+  for (unsigned int i = 0; i < failure_count; i++)
+    error_counter.IncrementFailureCount();
+
+  return error_counter;
+}
+
+static const ONX_ErrorCounter Internal_TestEvaluation(
+  ON_TextLog& text_log
+  )
+{
+  ONX_ErrorCounter error_counter;
+
+  // The fixed order and SSE2 / AVX2 span evaluators must get the same
+  // bits as the general code.
+  const unsigned int span_failure_count = ON_TestNurbsSpanEvaluation(&text_log);
+  for (unsigned int i = 0; i < span_failure_count; i++)
+    error_counter.IncrementFailureCount();
+
+  // The SSE2 / AVX2 point list kernels must get the same bits as the
+  // portable code.
+  const unsigned int point_list_failure_count = ON_TestPointListKernels(&text_log);
+  for (unsigned int i = 0; i < point_list_failure_count; i++)
+    error_counter.IncrementFailureCount();
+
+  error_counter += Internal_TestConcurrentEvaluation(text_log);
+  error_counter += Internal_TestCurveArcLength(text_log);
+  error_counter += Internal_TestBezierExtraction(text_log);
+  error_counter += Internal_TestEvaluateGrid(text_log);
+  error_counter += Internal_TestClosestPoint(text_log);
+  error_counter += Internal_TestCurveMeshing(text_log);
+  error_counter += Internal_TestTightBoundingBox(text_log);
+
+  return error_counter;
+}
+
+static bool Internal_CompressedBufferRoundTrip(
+  size_t sizeof_buffer,
+  const void* buffer,
+  unsigned int thread_count,
+  ON_CompressionCodec codec
+  )
+{
+  ON_Write3dmBufferArchive write_archive(0, 0, 70, ON::Version());
+  write_archive.SetThreadCount(thread_count);
+  write_archive.SetCompressionCodec(codec);
+  if (!write_archive.WriteCompressedBuffer(sizeof_buffer, buffer))
+    return false;
+
+  ON_Read3dmBufferArchive read_archive(write_archive.SizeOfArchive(), write_archive.Buffer(), false, 70, ON::Version());
+  size_t sizeof_read_buffer = 0;
+  if (!read_archive.ReadCompressedBufferSize(&sizeof_read_buffer) || sizeof_read_buffer != sizeof_buffer)
+    return false;
+  ON_SimpleArray<unsigned char> read_buffer((int)sizeof_buffer);
+  read_buffer.SetCount((int)sizeof_buffer);
+  bool bFailedCRC = true;
+  if (!read_archive.ReadCompressedBuffer(sizeof_read_buffer, read_buffer.Array(), &bFailedCRC) || bFailedCRC)
+    return false;
+  return (0 == sizeof_buffer || 0 == memcmp(read_buffer.Array(), buffer, sizeof_buffer));
+}
+
+static const ONX_ErrorCounter Internal_TestCompressedBuffers(
+  ON_TextLog& text_log
+  )
+{
+  ONX_ErrorCounter error_counter;
+  unsigned int failure_count = 0;
+
+  // Large enough that WriteCompressedBuffer() deflates blocks concurrently
+  // when ThreadCount() > 1. The buffer is compressible but not trivially.
+  const size_t sizeof_buffer = 3000001;
+  ON_SimpleArray<unsigned char> buffer((int)sizeof_buffer);
+  buffer.SetCount((int)sizeof_buffer);
+  ON_RandomNumberGenerator rng;
+  rng.Seed(5);
+  for (size_t i = 0; i < sizeof_buffer; i++)
+    buffer[(int)i] = (unsigned char)((0 == (i % 5)) ? (rng.RandomNumber() & 0x0F) : ((i * 7) ^ (i >> 9)));
+
+  // Deflate on one thread and deflate concurrently
+  if (!Internal_CompressedBufferRoundTrip(sizeof_buffer, buffer.Array(), 1, ON_CompressionCodec::Zlib))
+    failure_count++;
+  if (!Internal_CompressedBufferRoundTrip(sizeof_buffer, buffer.Array(), 4, ON_CompressionCodec::Zlib))
+    failure_count++;
+
+  // LZ4 blocks of every small size, long literal and match runs and 
+  // matches that overlap their output.
+  for (size_t sizeof_lz4_test = 0; sizeof_lz4_test <= 300; sizeof_lz4_test++)
+  {
+    if (!Internal_CompressedBufferRoundTrip(sizeof_lz4_test, buffer.Array(), 1, ON_CompressionCodec::LZ4))
+      failure_count++;
+  }
+  if (!Internal_CompressedBufferRoundTrip(sizeof_buffer, buffer.Array(), 1, ON_CompressionCodec::LZ4))
+    failure_count++;
+  ON_SimpleArray<unsigned char> runs(70000);
+  for (int i = 0; i < 70000; i++)
+    runs.Append((unsigned char)((i < 30000) ? 'a' : ((i < 30400) ? (rng.RandomNumber() & 0xFF) : 'a' + (i % 3))));
+  if (!Internal_CompressedBufferRoundTrip(runs.UnsignedCount(), runs.Array(), 1, ON_CompressionCodec::LZ4))
+    failure_count++;
+
+  ON_CompressedBuffer compressed_buffer;
+  ON_SimpleArray<unsigned char> uncompressed_buffer((int)sizeof_buffer);
+  uncompressed_buffer.SetCount((int)sizeof_buffer);
+  int bFailedCRC = true;
+  if (
+    !compressed_buffer.Compress(sizeof_buffer, buffer.Array(), 1, ON_CompressionCodec::LZ4)
+    || !compressed_buffer.Uncompress(uncompressed_buffer.Array(), &bFailedCRC)
+    || bFailedCRC
+    || 0 != memcmp(uncompressed_buffer.Array(), buffer.Array(), sizeof_buffer)
+    )
+    failure_count++;
+
+  // Incompressible buffers are saved uncompressed.
+  const size_t sizeof_random_buffer = 100000;
+  ON_SimpleArray<unsigned char> random_buffer((int)sizeof_random_buffer);
+  for (size_t i = 0; i < sizeof_random_buffer; i++)
+    random_buffer.Append((unsigned char)(rng.RandomNumber() >> 7));
+  if (!Internal_CompressedBufferRoundTrip(sizeof_random_buffer, random_buffer.Array(), 1, ON_CompressionCodec::LZ4))
+    failure_count++;
+  {
+    ON_Write3dmBufferArchive write_archive(0, 0, 70, ON::Version());
+    write_archive.SetCompressionCodec(ON_CompressionCodec::LZ4);
+    if (!write_archive.WriteCompressedBuffer(sizeof_random_buffer, random_buffer.Array()) || write_archive.SizeOfArchive() > sizeof_random_buffer + 64)
+      failure_count++;
+  }
+
+  // Decompressing a corrupt LZ4 block must fail or report a CRC failure
+  // and must never write past the end of the output buffer. Reading a
+  // truncated archive must fail.
+  {
+    // random words from a small vocabulary make many short sequences
+    const char* words[8] = { "curve ", "surface ", "mesh ", "knot ", "point ", "brep ", "edge ", "trim " };
+    ON_SimpleArray<unsigned char> words_buffer(200000);
+    while (words_buffer.UnsignedCount() + 16 < 200000)
+    {
+      const char* word = words[rng.RandomNumber() % 8];
+      words_buffer.Append((int)strlen(word), (const unsigned char*)word);
+    }
+    const size_t sizeof_lz4_buffer = words_buffer.UnsignedCount();
+    ON_SimpleArray<unsigned char> read_buffer((int)sizeof_lz4_buffer + 1);
+    read_buffer.SetCount((int)sizeof_lz4_buffer + 1);
+
+    // ON_CompressedBuffer::Uncompress() decompresses a buffer with a bad CRC.
+    ON_CompressedBuffer lz4_buffer;
+    ON_Write3dmBufferArchive write_archive(0, 0, 70, ON::Version());
+    if (
+      !lz4_buffer.Compress(sizeof_lz4_buffer, words_buffer.Array(), 1, ON_CompressionCodec::LZ4)
+      || !lz4_buffer.Write(write_archive)
+      || write_archive.SizeOfArchive() >= sizeof_lz4_buffer / 2
+      )
+      failure_count++;
+    else
+    {
+      const size_t sizeof_archive = write_archive.SizeOfArchive();
+      ON_SimpleArray<unsigned char> damaged((int)sizeof_archive);
+      for (unsigned int test_index = 0; test_index < 64; test_index++)
+      {
+        // change 1 to 4 bytes in the LZ4 block
+        damaged.SetCount(0);
+        damaged.Append((int)sizeof_archive, (const unsigned char*)write_archive.Buffer());
+        for (unsigned int k = 0; k <= (test_index % 4); k++)
+          damaged[(int)rng.RandomUnsignedInteger(64, (unsigned int)sizeof_archive - 8)] ^= (unsigned char)rng.RandomUnsignedInteger(1, 255);
+        ON_Read3dmBufferArchive read_archive(sizeof_archive, damaged.Array(), false, 70, ON::Version());
+        ON_CompressedBuffer damaged_buffer;
+        if (!damaged_buffer.Read(read_archive))
+          continue;
+        read_buffer[(int)sizeof_lz4_buffer] = 0xA5;
+        int bReadFailedCRC = false;
+        const bool bUncompressed = damaged_buffer.Uncompress(read_buffer.Array(), &bReadFailedCRC);
+        if (0xA5 != read_buffer[(int)sizeof_lz4_buffer])
+          failure_count++;
+        else if (bUncompressed && false == bReadFailedCRC && 0 != memcmp(read_buffer.Array(), words_buffer.Array(), sizeof_lz4_buffer))
+          failure_count++;
+      }
+    }
+
+    ON_Write3dmBufferArchive lz4_archive(0, 0, 70, ON::Version());
+    lz4_archive.SetCompressionCodec(ON_CompressionCodec::LZ4);
+    if (!lz4_archive.WriteCompressedBuffer(sizeof_lz4_buffer, words_buffer.Array()) || lz4_archive.SizeOfArchive() >= sizeof_lz4_buffer / 2)
+      failure_count++;
+    else
+    {
+      for (unsigned int test_index = 0; test_index < 32; test_index++)
+      {
+        const size_t sizeof_truncated = rng.RandomUnsignedInteger(1, (unsigned int)lz4_archive.SizeOfArchive() - 1);
+        ON_Read3dmBufferArchive read_archive(sizeof_truncated, lz4_archive.Buffer(), false, 70, ON::Version());
+        size_t sizeof_read_buffer = 0;
+        if (!read_archive.ReadCompressedBufferSize(&sizeof_read_buffer) || sizeof_read_buffer != sizeof_lz4_buffer)
+          continue;
+        read_buffer[(int)sizeof_lz4_buffer] = 0xA5;
+        bool bReadFailedCRC = false;
+        if (read_archive.ReadCompressedBuffer(sizeof_read_buffer, read_buffer.Array(), &bReadFailedCRC) && false == bReadFailedCRC)
+          failure_count++;
+        if (0xA5 != read_buffer[(int)sizeof_lz4_buffer])
+          failure_count++;
+      }
+    }
+  }
+
+  if (failure_count > 0)
+    text_log.Print("Compressed buffer test: %u failures.\n", failure_count);
+  for (unsigned int i = 0; i < failure_count; i++)
+    error_counter.IncrementFailureCount();
+
+  return error_counter;
+}
+
+static void Internal_RandomBoxes(
+  unsigned int count,
+  ON__UINT32 seed,
+  ON_SimpleArray<ON_BoundingBox>& boxes
+  )
+{
+  // Random boxes in a 100x100x100 cube with sizes from 0 (points) to 5.
+  ON_RandomNumberGenerator rng;
+  rng.Seed(seed);
+  boxes.SetCount(0);
+  boxes.Reserve(count);
+  for (unsigned int i = 0; i < count; i++)
+  {
+    const ON_3dPoint P(rng.RandomDouble(0.0, 100.0), rng.RandomDouble(0.0, 100.0), rng.RandomDouble(0.0, 100.0));
+    const double size = (0 == (i % 7)) ? 0.0 : rng.RandomDouble(0.0, 5.0);
+    const ON_3dVector V(size * rng.RandomDouble(), size * rng.RandomDouble(), size * rng.RandomDouble());
+    boxes.Append(ON_BoundingBox(P, P + V));
+  }
+}
+
+// True if the distance between the boxes is <= tolerance.
+static bool Internal_BoxesOverlap(const ON_BoundingBox& a, const ON_BoundingBox& b, double tolerance)
+{
+  double dd = 0.0;
+  for (int j = 0; j < 3; j++)
+  {
+    const double d = (a.m_min[j] > b.m_max[j]) ? (a.m_min[j] - b.m_max[j]) : ((b.m_min[j] > a.m_max[j]) ? (b.m_min[j] - a.m_max[j]) : 0.0);
+    if (d > tolerance)
+      return false;
+    dd += d * d;
+  }
+  return (dd <= tolerance * tolerance);
+}
+
+// Sorted indices of the boxes[] that overlap box.
+static void Internal_BruteForceSearch(
+  const ON_SimpleArray<ON_BoundingBox>& boxes,
+  const ON_BoundingBox& box,
+  ON_SimpleArray<int>& result
+  )
+{
+  result.SetCount(0);
+  for (int i = 0; i < boxes.Count(); i++)
+  {
+    if (Internal_BoxesOverlap(boxes[i], box, 0.0))
+      result.Append(i);
+  }
+}
+
+static bool Internal_SameSortedIds(ON_SimpleArray<int>& ids, const ON_SimpleArray<int>& sorted_ids)
+{
+  ids.QuickSortAndRemoveDuplicates(ON_CompareIncreasing<int>);
+  return ids.Count() == sorted_ids.Count() && (0 == ids.Count() || 0 == memcmp(ids.Array(), sorted_ids.Array(), ids.UnsignedCount() * sizeof(int)));
+}
+
+// Sorted pairs (i,j) of boxesA[i] and boxesB[j] that are within tolerance.
+// When bSelf is true, boxesB is boxesA and only pairs with i < j are listed.
+static void Internal_BruteForcePairs(
+  const ON_SimpleArray<ON_BoundingBox>& boxesA,
+  const ON_SimpleArray<ON_BoundingBox>& boxesB,
+  bool bSelf,
+  double tolerance,
+  ON_SimpleArray<ON_2dex>& pairs
+  )
+{
+  pairs.SetCount(0);
+  for (int i = 0; i < boxesA.Count(); i++)
+  {
+    for (int j = bSelf ? (i + 1) : 0; j < boxesB.Count(); j++)
+    {
+      if (Internal_BoxesOverlap(boxesA[i], boxesB[j], tolerance))
+        pairs.Append(ON_2dex(i, j));
+    }
+  }
+}
+
+static int Internal_Compare2dex(const ON_2dex* a, const ON_2dex* b)
+{
+  if (a->i != b->i)
+    return (a->i < b->i) ? -1 : 1;
+  if (a->j != b->j)
+    return (a->j < b->j) ? -1 : 1;
+  return 0;
+}
+
+static bool Internal_SamePairs(ON_SimpleArray<ON_2dex>& pairs, bool bSelf, const ON_SimpleArray<ON_2dex>& sorted_pairs)
+{
+  if (bSelf)
+  {
+    for (int k = 0; k < pairs.Count(); k++)
+    {
+      if (pairs[k].i > pairs[k].j)
+        pairs[k] = ON_2dex(pairs[k].j, pairs[k].i);
+    }
+  }
+  // Duplicate pairs are a failure.
+  pairs.QuickSort(Internal_Compare2dex);
+  return pairs.Count() == sorted_pairs.Count() && (0 == pairs.Count() || 0 == memcmp(pairs.Array(), sorted_pairs.Array(), pairs.UnsignedCount() * sizeof(ON_2dex)));
+}
+
+static unsigned int Internal_TestRTreeBulkLoad(
+  const ON_SimpleArray<ON_BoundingBox>& boxes,
+  const ON_SimpleArray<ON_BoundingBox>& queries
+  )
+{
+  // Bulk loaded trees must find the same elements as a brute force search
+  // and must still work with Insert() and Remove().
+  unsigned int failure_count = 0;
+  ON_SimpleArray<int> expected, found;
+
+  ON_RTree tree;
+  if (!tree.CreateFromBoxes(boxes.UnsignedCount(), boxes.Array(), nullptr) || boxes.Count() != tree.ElementCount())
+    return 1;
+  for (int q = 0; q < queries.Count(); q++)
+  {
+    Internal_BruteForceSearch(boxes, queries[q], expected);
+    found.SetCount(0);
+    if (!tree.Search(&queries[q].m_min.x, &queries[q].m_max.x, found) || !Internal_SameSortedIds(found, expected))
+      failure_count++;
+  }
+
+  // Ids from an array and from leaves
+  ON_SimpleArray<ON__INT_PTR> ids(boxes.Count());
+  ON_SimpleArray<ON_RTreeLeaf> leaves(boxes.Count());
+  for (int i = 0; i < boxes.Count(); i++)
+  {
+    ids.Append(1000 + i);
+    ON_RTreeLeaf& leaf = leaves.AppendNew();
+    memcpy(leaf.m_rect.m_min, &boxes[i].m_min.x, sizeof(leaf.m_rect.m_min));
+    memcpy(leaf.m_rect.m_max, &boxes[i].m_max.x, sizeof(leaf.m_rect.m_max));
+    leaf.m_id = 2000 + i;
+  }
+  ON_RTree id_tree, leaf_tree;
+  if (!id_tree.CreateFromBoxes(boxes.UnsignedCount(), boxes.Array(), ids.Array()) || !leaf_tree.CreateFromLeaves(leaves.UnsignedCount(), leaves.Array()))
+    failure_count++;
+  else
+  {
+    for (int q = 0; q < queries.Count(); q++)
+    {
+      Internal_BruteForceSearch(boxes, queries[q], expected);
+      for (int i = 0; i < expected.Count(); i++)
+        expected[i] += 1000;
+      found.SetCount(0);
+      if (!id_tree.Search(&queries[q].m_min.x, &queries[q].m_max.x, found) || !Internal_SameSortedIds(found, expected))
+        failure_count++;
+      for (int i = 0; i < expected.Count(); i++)
+        expected[i] += 1000;
+      found.SetCount(0);
+      if (!leaf_tree.Search(&queries[q].m_min.x, &queries[q].m_max.x, found) || !Internal_SameSortedIds(found, expected))
+        failure_count++;
+    }
+  }
+
+  // Remove every third element and insert it again with a new box.
+  ON_SimpleArray<ON_BoundingBox> changed_boxes(boxes);
+  for (int i = 0; i < changed_boxes.Count(); i += 3)
+  {
+    if (!tree.Remove(&changed_boxes[i].m_min.x, &changed_boxes[i].m_max.x, i))
+      failure_count++;
+    changed_boxes[i].m_min.x = 100.0 - changed_boxes[i].m_max.x;
+    changed_boxes[i].m_max.x = changed_boxes[i].m_min.x + 1.0;
+  }
+  for (int i = 0; i < changed_boxes.Count(); i += 3)
+  {
+    if (!tree.Insert(&changed_boxes[i].m_min.x, &changed_boxes[i].m_max.x, i))
+      failure_count++;
+  }
+  if (changed_boxes.Count() != tree.ElementCount())
+    failure_count++;
+  for (int q = 0; q < queries.Count(); q++)
+  {
+    Internal_BruteForceSearch(changed_boxes, queries[q], expected);
+    found.SetCount(0);
+    if (!tree.Search(&queries[q].m_min.x, &queries[q].m_max.x, found) || !Internal_SameSortedIds(found, expected))
+      failure_count++;
+  }
+
+  // Small trees and invalid input
+  for (unsigned int count = 1; count <= 40; count++)
+  {
+    ON_RTree small_tree;
+    if (!small_tree.CreateFromBoxes(count, boxes.Array(), nullptr) || (int)count != small_tree.ElementCount())
+      failure_count++;
+  }
+  ON_BoundingBox invalid_boxes[2] = { boxes[0], ON_BoundingBox::EmptyBoundingBox };
+  ON_RTree invalid_tree;
+  if (invalid_tree.CreateFromBoxes(2, invalid_boxes, nullptr) || 0 != invalid_tree.ElementCount())
+    failure_count++;
+
+  return failure_count;
+}
+
+struct Internal_RTreeSearchContext
+{
+  ON_SimpleArray<int>* m_ids;
+  const ON_SimpleArray<ON_BoundingBox>* m_boxes;
+  ON_RTreeSphere* m_sphere;
+  int m_closest_id;
+};
+
+static bool ON_CALLBACK_CDECL Internal_AppendId(void* a_context, ON__INT_PTR a_id)
+{
+  ((Internal_RTreeSearchContext*)a_context)->m_ids->Append((int)a_id);
+  return true;
+}
+
+static bool ON_CALLBACK_CDECL Internal_ShrinkSphere(void* a_context, ON__INT_PTR a_id)
+{
+  // Closest point search: shrink the sphere to the closest box found so far.
+  Internal_RTreeSearchContext* context = (Internal_RTreeSearchContext*)a_context;
+  const double d = (*context->m_boxes)[(int)a_id].MinimumDistanceTo(ON_3dPoint(context->m_sphere->m_point));
+  if (d < context->m_sphere->m_radius)
+  {
+    context->m_sphere->m_radius = d;
+    context->m_closest_id = (int)a_id;
+  }
+  return true;
+}
+
+static unsigned int Internal_TestFrozenRTree(
+  const ON_SimpleArray<ON_BoundingBox>& boxes,
+  const ON_SimpleArray<ON_BoundingBox>& queries
+  )
+{
+  // Frozen trees must find the same elements as a brute force search.
+  unsigned int failure_count = 0;
+  ON_SimpleArray<int> expected, found;
+
+  ON_RTree rtree;
+  for (int i = 0; i < boxes.Count(); i++)
+    rtree.Insert(&boxes[i].m_min.x, &boxes[i].m_max.x, i);
+  ON_SimpleArray<ON_RTreeLeaf> leaves(boxes.Count());
+  ON_BoundingBox bbox;
+  for (int i = 0; i < boxes.Count(); i++)
+  {
+    ON_RTreeLeaf& leaf = leaves.AppendNew();
+    memcpy(leaf.m_rect.m_min, &boxes[i].m_min.x, sizeof(leaf.m_rect.m_min));
+    memcpy(leaf.m_rect.m_max, &boxes[i].m_max.x, sizeof(leaf.m_rect.m_max));
+    leaf.m_id = i;
+    bbox.Union(boxes[i]);
+  }
+
+  ON_FrozenRTree frozen[3];
+  if (
+    !frozen[0].Create(rtree)
+    || !frozen[1].Create(boxes.UnsignedCount(), boxes.Array(), nullptr)
+    || !frozen[2].Create(leaves.UnsignedCount(), leaves.Array())
+    )
+    return 1;
+
+  // The frozen tree does not reference the ON_RTree it was made from.
+  rtree.RemoveAll();
+
+  Internal_RTreeSearchContext context = {};
+  context.m_ids = &found;
+  context.m_boxes = &boxes;
+  for (int t = 0; t < 3; t++)
+  {
+    const ON_FrozenRTree& tree = frozen[t];
+    if (boxes.UnsignedCount() != tree.ElementCount() || tree.NodeCount() < 1 || !(tree.BoundingBox().m_min == bbox.m_min && tree.BoundingBox().m_max == bbox.m_max))
+      failure_count++;
+    for (int q = 0; q < queries.Count(); q++)
+    {
+      Internal_BruteForceSearch(boxes, queries[q], expected);
+      found.SetCount(0);
+      if (!tree.Search(&queries[q].m_min.x, &queries[q].m_max.x, found) || !Internal_SameSortedIds(found, expected))
+        failure_count++;
+      found.SetCount(0);
+      if (!tree.Search(&queries[q].m_min.x, &queries[q].m_max.x, Internal_AppendId, &context) || !Internal_SameSortedIds(found, expected))
+        failure_count++;
+      ON_SimpleArray<void*> pointers;
+      if (!tree.Search(&queries[q].m_min.x, &queries[q].m_max.x, pointers) || pointers.Count() != expected.Count())
+        failure_count++;
+
+      // elements within a sphere
+      const ON_3dPoint center = queries[q].Center();
+      ON_RTreeSphere sphere = { { center.x, center.y, center.z }, 8.0 };
+      expected.SetCount(0);
+      for (int i = 0; i < boxes.Count(); i++)
+      {
+        if (boxes[i].MinimumDistanceTo(center) <= sphere.m_radius)
+          expected.Append(i);
+      }
+      found.SetCount(0);
+      if (!tree.Search(&sphere, Internal_AppendId, &context) || !Internal_SameSortedIds(found, expected))
+        failure_count++;
+
+      // closest element when the callback shrinks the sphere
+      int closest_id = 0;
+      for (int i = 1; i < boxes.Count(); i++)
+      {
+        if (boxes[i].MinimumDistanceTo(center) < boxes[closest_id].MinimumDistanceTo(center))
+          closest_id = i;
+      }
+      sphere.m_radius = 1.0e300;
+      context.m_sphere = &sphere;
+      context.m_closest_id = -1;
+      if (!tree.Search(&sphere, Internal_ShrinkSphere, &context) || !(boxes[context.m_closest_id].MinimumDistanceTo(center) == boxes[closest_id].MinimumDistanceTo(center)))
+        failure_count++;
+    }
+  }
+
+  // pairs in two trees and in one tree
+  const int countA = boxes.Count() / 2;
+  ON_SimpleArray<ON_BoundingBox> boxesA, boxesB;
+  boxesA.Append(countA, boxes.Array());
+  boxesB.Append(boxes.Count() - countA, boxes.Array() + countA);
+  ON_FrozenRTree treeA, treeB;
+  treeA.Create(boxesA.UnsignedCount(), boxesA.Array(), nullptr);
+  treeB.Create(boxesB.UnsignedCount(), boxesB.Array(), nullptr);
+  const double tolerances[2] = { 0.0, 0.5 };
+  ON_SimpleArray<ON_2dex> expected_pairs, pairs;
+  for (int k = 0; k < 2; k++)
+  {
+    Internal_BruteForcePairs(boxesA, boxesB, false, tolerances[k], expected_pairs);
+    pairs.SetCount(0);
+    if (!ON_FrozenRTree::Search(treeA, treeB, tolerances[k], pairs) || !Internal_SamePairs(pairs, false, expected_pairs))
+      failure_count++;
+    Internal_BruteForcePairs(boxesA, boxesA, true, tolerances[k], expected_pairs);
+    pairs.SetCount(0);
+    if (!treeA.Search(tolerances[k], pairs) || !Internal_SamePairs(pairs, true, expected_pairs))
+      failure_count++;
+  }
+
+  frozen[0].RemoveAll();
+  found.SetCount(0);
+  if (0 != frozen[0].ElementCount() || frozen[0].Search(&bbox.m_min.x, &bbox.m_max.x, found) || 0 != found.Count())
+    failure_count++;
+
+  return failure_count;
+}
+
+struct Internal_RTreeRayHit
+{
+  int m_id;
+  double m_t;
+};
+
+struct Internal_RTreeRayContext
+{
+  ON_SimpleArray<Internal_RTreeRayHit> m_hits;
+  // 0: find every hit, 1: stop at the first hit, 2: only hits at the first parameter
+  int m_mode;
+};
+
+static bool ON_CALLBACK_CDECL Internal_RayHit(void* a_context, ON__INT_PTR a_id, double t, double* maximum_parameter)
+{
+  Internal_RTreeRayContext* context = (Internal_RTreeRayContext*)a_context;
+  Internal_RTreeRayHit& hit = context->m_hits.AppendNew();
+  hit.m_id = (int)a_id;
+  hit.m_t = t;
+  if (2 == context->m_mode)
+    *maximum_parameter = t;
+  return (1 != context->m_mode);
+}
+
+// Parameter where the ray enters the box, 0 when from is inside.
+static bool Internal_RayEntersBox(const ON_3dPoint& from, const ON_3dVector& direction, double maximum_parameter, const ON_BoundingBox& box, double* t)
+{
+  double t0 = 0.0, t1 = maximum_parameter;
+  for (int j = 0; j < 3; j++)
+  {
+    if (0.0 == direction[j])
+    {
+      if (from[j] < box.m_min[j] || from[j] > box.m_max[j])
+        return false;
+      continue;
+    }
+    const double s0 = (box.m_min[j] - from[j]) / direction[j];
+    const double s1 = (box.m_max[j] - from[j]) / direction[j];
+    t0 = std::max(t0, std::min(s0, s1));
+    t1 = std::min(t1, std::max(s0, s1));
+    if (t0 > t1)
+      return false;
+  }
+  *t = t0;
+  return true;
+}
+
+static double ON_CALLBACK_CDECL Internal_CenterDistance(void* a_context, ON__INT_PTR a_id)
+{
+  // The distance to the box center is >= the distance to the box.
+  // Elements with odd ids are ignored.
+  const ON_SimpleArray<ON_BoundingBox>* boxes = (const ON_SimpleArray<ON_BoundingBox>*)((void**)a_context)[0];
+  const ON_3dPoint* P = (const ON_3dPoint*)((void**)a_context)[1];
+  return (0 != (a_id % 2)) ? -1.0 : (*boxes)[(int)a_id].Center().DistanceTo(*P);
+}
+
+static unsigned int Internal_TestRTreeNearestAndRay(
+  const ON_SimpleArray<ON_BoundingBox>& boxes,
+  const ON_SimpleArray<ON_BoundingBox>& queries
+  )
+{
+  // SearchNearest() and SearchRay() must find the same elements, in the 
+  // same order, as brute force searches.
+  unsigned int failure_count = 0;
+  ON_RTree tree;
+  for (int i = 0; i < boxes.Count(); i++)
+    tree.Insert(&boxes[i].m_min.x, &boxes[i].m_max.x, i);
+
+  ON_SimpleArray<double> distances(boxes.Count());
+  ON_SimpleArray<ON_RTreeDistanceResult> nearest;
+  ON_RandomNumberGenerator rng;
+  rng.Seed(17);
+  for (int q = 0; q < queries.Count(); q++)
+  {
+    const ON_3dPoint P = queries[q].Center();
+
+    // k nearest bounding boxes, with and without a maximum distance
+    distances.SetCount(0);
+    for (int i = 0; i < boxes.Count(); i++)
+      distances.Append(boxes[i].MinimumDistanceTo(P));
+    distances.QuickSort(ON_CompareIncreasing<double>);
+    const unsigned int k = 1 + (q % 20);
+    nearest.SetCount(0);
+    if (!tree.SearchNearest(&P.x, k, ON_UNSET_VALUE, nullptr, nullptr, nearest) || k != nearest.UnsignedCount())
+      failure_count++;
+    for (int r = 0; r < nearest.Count(); r++)
+    {
+      const double d = boxes[(int)nearest[r].m_id].MinimumDistanceTo(P);
+      if (!(fabs(nearest[r].m_distance - d) <= 1.0e-12 && fabs(d - distances[r]) <= 1.0e-12))
+        failure_count++;
+    }
+    const double maximum_distance = 1.5;
+    int within_count = 0;
+    while (within_count < distances.Count() && distances[within_count] <= maximum_distance)
+      within_count++;
+    nearest.SetCount(0);
+    if (!tree.SearchNearest(&P.x, 1000, maximum_distance, nullptr, nullptr, nearest) || std::min(1000, within_count) != nearest.Count())
+      failure_count++;
+
+    // k nearest with exact distances from a callback
+    distances.SetCount(0);
+    for (int i = 0; i < boxes.Count(); i += 2)
+      distances.Append(boxes[i].Center().DistanceTo(P));
+    distances.QuickSort(ON_CompareIncreasing<double>);
+    const void* context[2] = { &boxes, &P };
+    nearest.SetCount(0);
+    if (!tree.SearchNearest(&P.x, k, ON_UNSET_VALUE, Internal_CenterDistance, (void*)context, nearest) || k != nearest.UnsignedCount())
+      failure_count++;
+    for (int r = 0; r < nearest.Count(); r++)
+    {
+      // A callback distance that rounds below the box distance is increased.
+      if (0 != (nearest[r].m_id % 2) || !(fabs(nearest[r].m_distance - distances[r]) <= 1.0e-12))
+        failure_count++;
+    }
+
+    // rays from inside and outside the elements, segments and infinite rays
+    const ON_3dVector D(rng.RandomDouble(-1.0, 1.0), rng.RandomDouble(-1.0, 1.0), (0 == (q % 5)) ? 0.0 : rng.RandomDouble(-1.0, 1.0));
+    const double maximum_parameter = (0 == (q % 2)) ? 40.0 : ON_DBL_MAX;
+    ON_SimpleArray<Internal_RTreeRayHit> expected_hits;
+    for (int i = 0; i < boxes.Count(); i++)
+    {
+      double t;
+      if (Internal_RayEntersBox(P, D, maximum_parameter, boxes[i], &t))
+      {
+        Internal_RTreeRayHit& hit = expected_hits.AppendNew();
+        hit.m_id = i;
+        hit.m_t = t;
+      }
+    }
+    Internal_RTreeRayContext ray_context;
+    ray_context.m_mode = 0;
+    if (!tree.SearchRay(&P.x, &D.x, maximum_parameter, Internal_RayHit, &ray_context) || ray_context.m_hits.Count() != expected_hits.Count())
+    {
+      failure_count++;
+      continue;
+    }
+    double tmin = ON_DBL_MAX;
+    for (int r = 0; r < expected_hits.Count(); r++)
+      tmin = std::min(tmin, expected_hits[r].m_t);
+    ON_SimpleArray<int> found, expected;
+    for (int r = 0; r < expected_hits.Count(); r++)
+    {
+      const Internal_RTreeRayHit& hit = ray_context.m_hits[r];
+      if (r > 0 && hit.m_t < ray_context.m_hits[r - 1].m_t)
+        failure_count++;
+      double t = ON_UNSET_VALUE;
+      if (!Internal_RayEntersBox(P, D, maximum_parameter, boxes[hit.m_id], &t) || t != hit.m_t)
+        failure_count++;
+      found.Append(hit.m_id);
+      expected.Append(expected_hits[r].m_id);
+    }
+    if (!Internal_SameSortedIds(found, expected))
+      failure_count++;
+
+    // The callback ends the search or reduces the maximum parameter.
+    if (expected_hits.Count() > 0)
+    {
+      ray_context.m_hits.SetCount(0);
+      ray_context.m_mode = 1;
+      if (tree.SearchRay(&P.x, &D.x, maximum_parameter, Internal_RayHit, &ray_context) || 1 != ray_context.m_hits.Count() || tmin != ray_context.m_hits[0].m_t)
+        failure_count++;
+      ray_context.m_hits.SetCount(0);
+      ray_context.m_mode = 2;
+      if (!tree.SearchRay(&P.x, &D.x, maximum_parameter, Internal_RayHit, &ray_context) || ray_context.m_hits.Count() < 1)
+        failure_count++;
+      for (int r = 0; r < ray_context.m_hits.Count(); r++)
+      {
+        if (tmin != ray_context.m_hits[r].m_t)
+          failure_count++;
+      }
+    }
+  }
+
+  return failure_count;
+}
+
+static bool Internal_SamePairList(const ON_SimpleArray<ON_2dex>& a, const ON_SimpleArray<ON_2dex>& b)
+{
+  return a.Count() == b.Count() && (0 == a.Count() || 0 == memcmp(a.Array(), b.Array(), a.UnsignedCount() * sizeof(ON_2dex)));
+}
+
+static unsigned int Internal_TestRTreeConcurrentPairSearch()
+{
+  // The multithreaded pair searches must return the same list, in the
+  // same order, as the single threaded searches.
+  unsigned int failure_count = 0;
+  ON_SimpleArray<ON_BoundingBox> boxes;
+  Internal_RandomBoxes(20000, 13, boxes);
+  ON_RTree treeA, treeB, bulk_tree;
+  for (int i = 0; i < boxes.Count(); i++)
+  {
+    if (0 == (i % 2))
+      treeA.Insert(&boxes[i].m_min.x, &boxes[i].m_max.x, i);
+    else
+      treeB.Insert(&boxes[i].m_min.x, &boxes[i].m_max.x, i);
+  }
+  bulk_tree.CreateFromBoxes(boxes.UnsignedCount(), boxes.Array(), nullptr);
+
+  const double tolerances[2] = { 0.0, 0.5 };
+  const unsigned int thread_counts[3] = { 2, 4, 0 };
+  ON_SimpleArray<ON_2dex> serial_pairs, serial_self_pairs, serial_bulk_pairs, pairs;
+  for (int k = 0; k < 2; k++)
+  {
+    serial_pairs.SetCount(0);
+    serial_self_pairs.SetCount(0);
+    serial_bulk_pairs.SetCount(0);
+    if (
+      !ON_RTree::Search(treeA, treeB, tolerances[k], serial_pairs)
+      || !treeA.Search(tolerances[k], serial_self_pairs)
+      || !bulk_tree.Search(tolerances[k], serial_bulk_pairs)
+      || 0 == serial_pairs.Count()
+      || 0 == serial_self_pairs.Count()
+      )
+    {
+      failure_count++;
+      continue;
+    }
+    for (int t = 0; t < 3; t++)
+    {
+      pairs.SetCount(0);
+      if (!ON_RTree::Search(treeA, treeB, tolerances[k], thread_counts[t], pairs) || !Internal_SamePairList(pairs, serial_pairs))
+        failure_count++;
+      pairs.SetCount(0);
+      if (!treeA.Search(tolerances[k], thread_counts[t], pairs) || !Internal_SamePairList(pairs, serial_self_pairs))
+        failure_count++;
+      pairs.SetCount(0);
+      if (!bulk_tree.Search(tolerances[k], thread_counts[t], pairs) || !Internal_SamePairList(pairs, serial_bulk_pairs))
+        failure_count++;
+    }
+  }
+  return failure_count;
+}
+
+static const ONX_ErrorCounter Internal_TestRTree(
+  ON_TextLog& text_log
+  )
+{
+  ONX_ErrorCounter error_counter;
+  unsigned int failure_count = 0;
+
+  ON_SimpleArray<ON_BoundingBox> boxes, queries;
+  Internal_RandomBoxes(5000, 7, boxes);
+  Internal_RandomBoxes(200, 11, queries);
+  for (int q = 0; q < queries.Count(); q++)
+    queries[q].m_max += ON_3dVector(5.0, 5.0, 5.0);
+
+  failure_count += Internal_TestRTreeBulkLoad(boxes, queries);
+  failure_count += Internal_TestFrozenRTree(boxes, queries);
+  failure_count += Internal_TestRTreeConcurrentPairSearch();
+  failure_count += Internal_TestRTreeNearestAndRay(boxes, queries);
+
+  if (failure_count > 0)
+    text_log.Print("R-tree test: %u failures.\n", failure_count);
+  for (unsigned int i = 0; i < failure_count; i++)
+    error_counter.IncrementFailureCount();
+
+  return error_counter;
+}
+
+class Internal_WeldPoints
+{
+public:
+  const char* m_p0 = nullptr;
+  const ON_3fPoint* m_V = nullptr;
+  const ON_3fVector* m_N = nullptr;
+  const ON_2fPoint* m_T = nullptr;
+  const ON_Color* m_C = nullptr;
+};
+
+// A copy of the CompareMeshPoint() that ON_Mesh::CombineIdenticalVertices()
+// used with ON_Sort().
+static int Internal_CompareWeldPoint(const void* a, const void* b, void* ptr)
+{
+  const Internal_WeldPoints* mp = (const Internal_WeldPoints*)ptr;
+  const int i = (int)(((const char*)a) - mp->m_p0);
+  const int j = (int)(((const char*)b) - mp->m_p0);
+  float d = mp->m_V[j].x - mp->m_V[i].x;
+  if (d == 0.0f)
+    d = mp->m_V[j].y - mp->m_V[i].y;
+  if (d == 0.0f)
+    d = mp->m_V[j].z - mp->m_V[i].z;
+  if (d == 0.0f && nullptr != mp->m_N)
+  {
+    d = mp->m_N[j].x - mp->m_N[i].x;
+    if (d == 0.0f)
+      d = mp->m_N[j].y - mp->m_N[i].y;
+    if (d == 0.0f)
+      d = mp->m_N[j].z - mp->m_N[i].z;
+  }
+  if (d == 0.0f && nullptr != mp->m_T)
+  {
+    d = mp->m_T[j].x - mp->m_T[i].x;
+    if (d == 0.0f)
+      d = mp->m_T[j].y - mp->m_T[i].y;
+  }
+  if (d == 0.0f && nullptr != mp->m_C)
+  {
+    const int u = ((int)mp->m_C[j]) - ((int)mp->m_C[i]);
+    if (u < 0)
+      d = -1.0f;
+    else if (u > 0)
+      d = 1.0f;
+  }
+  if (d < 0.0f)
+    return -1;
+  if (d > 0.0f)
+    return 1;
+  return 0;
+}
+
+/*
+Returns:
+  A mesh whose vertices come from a few points, normals, texture 
+  coordinates and colors, so many vertices are identical. Zeros have
+  random signs.
+*/
+static void Internal_WeldTestMesh(int vertex_count, ON__UINT32 seed, ON_Mesh& mesh)
+{
+  ON_RandomNumberGenerator rng;
+  rng.Seed(seed);
+  const float point_coordinates[4] = { 0.0f, 1.0f, 0.5f, -2.0f };
+  const ON_3fVector normals[3] = { ON_3fVector(0.0f, 0.0f, 1.0f), ON_3fVector(0.0f, 1.0f, 0.0f), ON_3fVector(0.6f, 0.0f, 0.8f) };
+  const ON_2fPoint texture_points[3] = { ON_2fPoint(0.0f, 0.0f), ON_2fPoint(0.25f, 0.0f), ON_2fPoint(0.0f, 0.75f) };
+  const ON_Color colors[2] = { ON_Color(255, 0, 0), ON_Color(0, 0, 255) };
+
+  auto random_sign = [&rng](float x)
+  {
+    return (0.0f == x && 0 != (rng.RandomNumber() & 1)) ? -x : x;
+  };
+
+  mesh.Destroy();
+  mesh.m_V.Reserve(vertex_count);
+  mesh.m_N.Reserve(vertex_count);
+  mesh.m_T.Reserve(vertex_count);
+  mesh.m_C.Reserve(vertex_count);
+  for (int i = 0; i < vertex_count; i++)
+  {
+    ON_3fPoint P;
+    for (int j = 0; j < 3; j++)
+      P[j] = random_sign(point_coordinates[rng.RandomNumber() % 4]);
+    ON_3fVector N = normals[rng.RandomNumber() % 3];
+    for (int j = 0; j < 3; j++)
+      N[j] = random_sign(N[j]);
+    ON_2fPoint T = texture_points[rng.RandomNumber() % 3];
+    T.x = random_sign(T.x);
+    T.y = random_sign(T.y);
+    mesh.m_V.Append(P);
+    mesh.m_N.Append(N);
+    mesh.m_T.Append(T);
+    mesh.m_C.Append(colors[rng.RandomNumber() % 2]);
+  }
+  for (int fi = 0; fi + 3 <= vertex_count; fi += 3)
+  {
+    if (0 == fi % 2)
+      mesh.SetTriangle(mesh.m_F.Count(), fi, fi + 1, fi + 2);
+    else
+      mesh.SetQuad(mesh.m_F.Count(), fi, fi + 1, fi + 2, (fi + 3) % vertex_count);
+  }
+}
+
+/*
+Description:
+  Weld mesh the way ON_Mesh::CombineIdenticalVertices() used to, with
+  ON_Sort() and a copy of CompareMeshPoint().
+*/
+static bool Internal_OldCombineIdenticalVertices(ON_Mesh& mesh, bool bIgnoreVertexNormals, bool bIgnoreTextureCoordinates)
+{
+  const int vertex_count = mesh.m_V.Count();
+  Internal_WeldPoints mp;
+  mp.m_p0 = (const char*)&mp;
+  mp.m_V = mesh.m_V.Array();
+  mp.m_N = bIgnoreVertexNormals ? nullptr : mesh.m_N.Array();
+  mp.m_T = bIgnoreTextureCoordinates ? nullptr : mesh.m_T.Array();
+  mp.m_C = bIgnoreTextureCoordinates ? nullptr : mesh.m_C.Array();
+
+  ON_SimpleArray<int> index(vertex_count);
+  index.SetCount(vertex_count);
+  ON_Sort(ON::sort_algorithm::quick_sort, index.Array(), mp.m_p0, vertex_count, sizeof(*mp.m_p0), Internal_CompareWeldPoint, &mp);
+  ON_SimpleArray<int> remap(vertex_count);
+  remap.SetCount(vertex_count);
+  int remap_vertex_count = 0;
+  for (int i0 = 0, i1 = 0; i0 < vertex_count; i0 = i1)
+  {
+    for (i1 = i0 + 1; i1 < vertex_count; i1++)
+    {
+      if (0 != Internal_CompareWeldPoint(mp.m_p0 + index[i0], mp.m_p0 + index[i1], &mp))
+        break;
+    }
+    for (/*empty*/; i0 < i1; i0++)
+      remap[index[i0]] = remap_vertex_count;
+    remap_vertex_count++;
+  }
+  if (remap_vertex_count >= vertex_count)
+    return false;
+
+  // The last vertex in a group supplies the attributes. Normals of
+  // combined vertices are averaged when they are ignored.
+  ON_3fPointArray V(remap_vertex_count);
+  ON_3fVectorArray N(remap_vertex_count);
+  ON_2fPointArray T(remap_vertex_count);
+  ON_SimpleArray<ON_Color> C(remap_vertex_count);
+  V.SetCount(remap_vertex_count);
+  N.SetCount(remap_vertex_count);
+  N.Zero();
+  T.SetCount(remap_vertex_count);
+  C.SetCount(remap_vertex_count);
+  for (int k = 0; k < vertex_count; k++)
+  {
+    V[remap[k]] = mesh.m_V[k];
+    if (bIgnoreVertexNormals)
+      N[remap[k]] += mesh.m_N[k];
+    else
+      N[remap[k]] = mesh.m_N[k];
+    T[remap[k]] = mesh.m_T[k];
+    C[remap[k]] = mesh.m_C[k];
+  }
+  if (bIgnoreVertexNormals)
+  {
+    for (int k = 0; k < remap_vertex_count; k++)
+      N[k].Unitize();
+  }
+  mesh.m_V = V;
+  mesh.m_N = N;
+  if (bIgnoreTextureCoordinates)
+  {
+    mesh.m_T.Destroy();
+    mesh.m_C.Destroy();
+  }
+  else
+  {
+    mesh.m_T = T;
+    mesh.m_C = C;
+  }
+  for (int fi = 0; fi < mesh.m_F.Count(); fi++)
+  {
+    for (int j = 0; j < 4; j++)
+      mesh.m_F[fi].vi[j] = remap[mesh.m_F[fi].vi[j]];
+  }
+  return true;
+}
+
+template <class T> static bool Internal_SameArrayBits(const ON_SimpleArray<T>& a, const ON_SimpleArray<T>& b)
+{
+  return a.Count() == b.Count() && (0 == a.Count() || 0 == memcmp(a.Array(), b.Array(), a.Count()*sizeof(T)));
+}
+
+static unsigned int Internal_TestMeshWeld()
+{
+  unsigned int failure_count = 0;
+  const int vertex_counts[2] = { 300, 150000 };
+  const unsigned int thread_counts[3] = { 1, 4, 0 };
+  for (int v = 0; v < 2; v++)
+  {
+    ON_Mesh mesh;
+    Internal_WeldTestMesh(vertex_counts[v], 21 + v, mesh);
+    for (int option = 0; option < 4; option++)
+    {
+      const bool bIgnoreVertexNormals = (0 != (option & 1));
+      const bool bIgnoreTextureCoordinates = (0 != (option & 2));
+      ON_Mesh old_mesh(mesh);
+      const bool old_rc = Internal_OldCombineIdenticalVertices(old_mesh, bIgnoreVertexNormals, bIgnoreTextureCoordinates);
+      for (int t = 0; t < 3; t++)
+      {
+        ON_Mesh new_mesh(mesh);
+        const bool rc = new_mesh.CombineIdenticalVertices(bIgnoreVertexNormals, bIgnoreTextureCoordinates, thread_counts[t]);
+        if (rc != old_rc || !old_rc)
+          failure_count++;
+        if (!Internal_SameArrayBits(new_mesh.m_V, old_mesh.m_V) || !Internal_SameArrayBits(new_mesh.m_F, old_mesh.m_F))
+          failure_count++;
+        if (!Internal_SameArrayBits(new_mesh.m_N, old_mesh.m_N) || !Internal_SameArrayBits(new_mesh.m_T, old_mesh.m_T) || !Internal_SameArrayBits(new_mesh.m_C, old_mesh.m_C))
+          failure_count++;
+      }
+    }
+  }
+  return failure_count;
+}
+
+class Internal_ReferenceTopology
+{
+public:
+  ON_SimpleArray<int> m_topv_map;
+  ON_ClassArray< ON_SimpleArray<int> > m_topv_vi;
+  ON_ClassArray< ON_SimpleArray<int> > m_topv_topei;
+  ON_SimpleArray<int> m_tope_topvi; // 2 per edge
+  ON_ClassArray< ON_SimpleArray<int> > m_tope_topfi;
+  ON_SimpleArray<ON_MeshTopologyFace> m_topf;
+};
+
+static int Internal_CompareTopologyPoint(const void* a, const void* b, void*)
+{
+  const ON_3fPoint& A = *((const ON_3fPoint*)a);
+  const ON_3fPoint& B = *((const ON_3fPoint*)b);
+  for (int j = 0; j < 3; j++)
+  {
+    if (A[j] < B[j])
+      return -1;
+    if (A[j] > B[j])
+      return 1;
+  }
+  return 0;
+}
+
+/*
+Description:
+  Get the topology the way ON_MeshTopology::Create() did before the
+  face sides were radix sorted. Vertex ids are numbered in order of 
+  the lowest vertex index at each location and the face sides are 
+  sorted with ON_MeshFaceSide::SortByVertexIndex().
+*/
+static void Internal_GetReferenceTopology(const ON_Mesh& mesh, Internal_ReferenceTopology& ref)
+{
+  const int vertex_count = mesh.m_V.Count();
+  const int face_count = mesh.m_F.Count();
+  const ON_3fPoint* V = mesh.m_V.Array();
+
+  // location[i] = lowest index of a vertex at V[i]
+  ON_SimpleArray<int> index(vertex_count);
+  index.SetCount(vertex_count);
+  ON_Sort(ON::sort_algorithm::quick_sort, index.Array(), V, vertex_count, sizeof(V[0]), Internal_CompareTopologyPoint, nullptr);
+  ON_SimpleArray<int> location(vertex_count);
+  location.SetCount(vertex_count);
+  for (int s0 = 0, s1 = 0; s0 < vertex_count; s0 = s1)
+  {
+    int lowest = index[s0];
+    for (s1 = s0 + 1; s1 < vertex_count && 0 == Internal_CompareTopologyPoint(&V[index[s0]], &V[index[s1]], nullptr); s1++)
+    {
+      if (index[s1] < lowest)
+        lowest = index[s1];
+    }
+    for (int s = s0; s < s1; s++)
+      location[index[s]] = lowest;
+  }
+
+  ref.m_topv_map.SetCount(0);
+  ref.m_topv_map.Reserve(vertex_count);
+  ref.m_topv_map.SetCount(vertex_count);
+  ref.m_topv_vi.SetCount(0);
+  for (int i = 0; i < vertex_count; i++)
+  {
+    if (location[i] == i)
+    {
+      ref.m_topv_map[i] = ref.m_topv_vi.Count();
+      ref.m_topv_vi.AppendNew().Append(i);
+    }
+    else
+    {
+      ref.m_topv_map[i] = ref.m_topv_map[location[i]];
+      ref.m_topv_vi[ref.m_topv_map[i]].Append(i);
+    }
+  }
+  const int topv_count = ref.m_topv_vi.Count();
+  ref.m_topv_topei.SetCount(0);
+  for (int topvi = 0; topvi < topv_count; topvi++)
+    ref.m_topv_topei.AppendNew();
+
+  ON_MeshFaceSide* sides = nullptr;
+  const int side_count = (int)mesh.GetMeshFaceSideList((const unsigned int*)ref.m_topv_map.Array(), sides);
+  ON_MeshFaceSide::SortByVertexIndex(sides, side_count);
+  ref.m_tope_topvi.SetCount(0);
+  ref.m_tope_topfi.SetCount(0);
+  for (int s0 = 0, s1 = 0; s0 < side_count; s0 = s1)
+  {
+    const int ei = ref.m_tope_topfi.Count();
+    ref.m_tope_topvi.Append((int)sides[s0].m_vi[0]);
+    ref.m_tope_topvi.Append((int)sides[s0].m_vi[1]);
+    ON_SimpleArray<int>& topfi = ref.m_tope_topfi.AppendNew();
+    for (s1 = s0; s1 < side_count && sides[s1].m_vi[0] == sides[s0].m_vi[0] && sides[s1].m_vi[1] == sides[s0].m_vi[1]; s1++)
+      topfi.Append((int)sides[s1].m_fi);
+    ref.m_topv_topei[sides[s0].m_vi[0]].Append(ei);
+    ref.m_topv_topei[sides[s0].m_vi[1]].Append(ei);
+  }
+  onfree(sides);
+
+  ref.m_topf.SetCount(0);
+  if (side_count <= 0)
+    return;
+  ref.m_topf.Reserve(face_count);
+  ref.m_topf.SetCount(face_count);
+  memset(ref.m_topf.Array(), 0, face_count*sizeof(ON_MeshTopologyFace));
+  for (int fi = 0; fi < face_count; fi++)
+  {
+    for (int j = 0; j < 4; j++)
+      ref.m_topf[fi].m_topei[j] = -1;
+  }
+  for (int ei = 0; ei < ref.m_tope_topfi.Count(); ei++)
+  {
+    const int vi0 = ref.m_tope_topvi[2 * ei];
+    const int vi1 = ref.m_tope_topvi[2 * ei + 1];
+    for (int efi = 0; efi < ref.m_tope_topfi[ei].Count(); efi++)
+    {
+      // side j of a face begins at vi[(j+3)%4] and ends at vi[j]
+      const int fi = ref.m_tope_topfi[ei][efi];
+      ON_MeshTopologyFace& topf = ref.m_topf[fi];
+      int topfvi[4];
+      for (int j = 0; j < 4; j++)
+        topfvi[j] = ref.m_topv_map[mesh.m_F[fi].vi[j]];
+      for (int k = 0; k < 8; k++)
+      {
+        const int j = k % 4;
+        const bool bReversed = (k >= 4);
+        if (topfvi[(j + 3) % 4] == (bReversed ? vi1 : vi0) && topfvi[j] == (bReversed ? vi0 : vi1))
+        {
+          topf.m_topei[j] = ei;
+          topf.m_reve[j] = bReversed ? 1 : 0;
+          break;
+        }
+      }
+    }
+  }
+  for (int fi = 0; fi < face_count; fi++)
+  {
+    ON_MeshTopologyFace& topf = ref.m_topf[fi];
+    const int* e = topf.m_topei;
+    bool bIsGood = (e[0] >= 0 && e[1] >= 0 && e[2] >= 0 && e[0] != e[1] && e[1] != e[2] && e[2] != e[0]);
+    if (bIsGood)
+    {
+      if (mesh.m_F[fi].IsTriangle())
+        topf.m_topei[3] = topf.m_topei[2];
+      else
+        bIsGood = (e[3] >= 0 && e[0] != e[3] && e[1] != e[3] && e[2] != e[3]);
+    }
+    if (!bIsGood)
+      memset(&topf, 0, sizeof(topf));
+  }
+}
+
+static bool Internal_SameIntList(int count, const int* a, const ON_SimpleArray<int>& b)
+{
+  if (count != b.Count())
+    return false;
+  return 0 == count || (nullptr != a && 0 == memcmp(a, b.Array(), count*sizeof(int)));
+}
+
+static bool Internal_SameTopology(const ON_MeshTopology& top, const Internal_ReferenceTopology& ref)
+{
+  if (nullptr == top.m_mesh || !top.m_mesh->HasMeshTopology())
+    return false;
+  if (!Internal_SameIntList(top.m_topv_map.Count(), top.m_topv_map.Array(), ref.m_topv_map))
+    return false;
+  if (top.m_topv.Count() != ref.m_topv_vi.Count())
+    return false;
+  for (int topvi = 0; topvi < top.m_topv.Count(); topvi++)
+  {
+    const ON_MeshTopologyVertex& topv = top.m_topv[topvi];
+    if (!Internal_SameIntList(topv.m_v_count, topv.m_vi, ref.m_topv_vi[topvi]) || !Internal_SameIntList(topv.m_tope_count, topv.m_topei, ref.m_topv_topei[topvi]))
+      return false;
+  }
+  if (top.m_tope.Count() != ref.m_tope_topfi.Count())
+    return false;
+  for (int topei = 0; topei < top.m_tope.Count(); topei++)
+  {
+    const ON_MeshTopologyEdge& tope = top.m_tope[topei];
+    if (tope.m_topvi[0] != ref.m_tope_topvi[2 * topei] || tope.m_topvi[1] != ref.m_tope_topvi[2 * topei + 1])
+      return false;
+    if (!Internal_SameIntList(tope.m_topf_count, tope.m_topfi, ref.m_tope_topfi[topei]))
+      return false;
+  }
+  if (top.m_topf.Count() != ref.m_topf.Count())
+    return false;
+  for (int topfi = 0; topfi < top.m_topf.Count(); topfi++)
+  {
+    const ON_MeshTopologyFace& a = top.m_topf[topfi];
+    const ON_MeshTopologyFace& b = ref.m_topf[topfi];
+    for (int j = 0; j < 4; j++)
+    {
+      if (a.m_topei[j] != b.m_topei[j] || a.m_reve[j] != b.m_reve[j])
+        return false;
+    }
+  }
+  return true;
+}
+
+/*
+Returns:
+  A grid of quads and triangles on n x n points. Some points have 
+  several vertices that faces pick at random. Some faces are repeated,
+  so their edges have 4 faces, and some quads have a repeated corner.
+*/
+static void Internal_TopologyTestMesh(int n, ON__UINT32 seed, ON_Mesh& mesh)
+{
+  ON_RandomNumberGenerator rng;
+  rng.Seed(seed);
+  mesh.Destroy();
+  ON_SimpleArray<int> copies; // copies[3*p+k] = vertex index of copy k of point p
+  copies.Reserve(3 * n*n);
+  for (int p = 0; p < n*n; p++)
+  {
+    mesh.m_V.Append(ON_3fPoint((float)(p % n), (float)(p / n), 0.0f));
+    copies.Append(p);
+    copies.Append(p);
+    copies.Append(p);
+  }
+  for (int p = 0; p < n*n; p++)
+  {
+    for (int k = 1; k < 3; k++)
+    {
+      if (0 == rng.RandomNumber() % 3)
+      {
+        copies[3 * p + k] = mesh.m_V.Count();
+        mesh.m_V.Append(mesh.m_V[p]);
+      }
+    }
+  }
+  auto vertex = [&](int x, int y) { return copies[3 * (y*n + x) + rng.RandomNumber() % 3]; };
+  for (int y = 0; y + 1 < n; y++)
+  {
+    for (int x = 0; x + 1 < n; x++)
+    {
+      const int a = vertex(x, y), b = vertex(x + 1, y), c = vertex(x + 1, y + 1), d = vertex(x, y + 1);
+      const ON__UINT32 r = rng.RandomNumber() % 100;
+      if (r < 40)
+        mesh.SetQuad(mesh.m_F.Count(), a, b, c, d);
+      else if (r < 95)
+      {
+        mesh.SetTriangle(mesh.m_F.Count(), a, b, c);
+        mesh.SetTriangle(mesh.m_F.Count(), a, c, d);
+      }
+      else if (r < 98)
+      {
+        mesh.SetQuad(mesh.m_F.Count(), a, b, c, d);
+        mesh.SetQuad(mesh.m_F.Count(), a, b, c, d);
+      }
+      else
+        mesh.SetQuad(mesh.m_F.Count(), a, b, b, c);
+    }
+  }
+}
+
+static unsigned int Internal_TestMeshTopology()
+{
+  unsigned int failure_count = 0;
+
+  ON_Mesh mesh;
+  Internal_TopologyTestMesh(260, 22, mesh);
+  Internal_ReferenceTopology ref;
+  Internal_GetReferenceTopology(mesh, ref);
+  if (!Internal_SameTopology(mesh.Topology(), ref))
+    failure_count++;
+
+  // Background calculations on 1, 4 and all threads.
+  const unsigned int thread_counts[3] = { 1, 4, 0 };
+  for (int t = 0; t < 3; t++)
+  {
+    ON_Mesh copy(mesh);
+    if (!copy.CreateTopologyInBackground(thread_counts[t]))
+      failure_count++;
+    if (!Internal_SameTopology(copy.Topology(), ref) || !copy.HasMeshTopology() || !copy.CreateTopologyInBackground(thread_counts[t]))
+      failure_count++;
+  }
+
+  // Threads that call Topology() while a background calculation is
+  // in progress wait for it.
+  {
+    ON_Mesh copy(mesh);
+    copy.CreateTopologyInBackground(2);
+    int same[4] = {};
+    Internal_RunOnThreads(4, [&](unsigned int thread_index)
+      {
+        same[thread_index] = Internal_SameTopology(copy.Topology(), ref) ? 1 : 0;
+      });
+    for (int i = 0; i < 4; i++)
+    {
+      if (1 != same[i])
+        failure_count++;
+    }
+  }
+
+  // DestroyTopology(), DestroyRuntimeCache(false) and ~ON_Mesh() wait
+  // for a calculation in progress.
+  for (int pass = 0; pass < 2; pass++)
+  {
+    ON_Mesh copy(mesh);
+    copy.CreateTopologyInBackground(2);
+    if (0 == pass)
+      copy.DestroyTopology();
+    else
+      copy.DestroyRuntimeCache(false);
+    if (copy.HasMeshTopology() || !Internal_SameTopology(copy.Topology(), ref))
+      failure_count++;
+  }
+  {
+    ON_Mesh copy(mesh);
+    copy.CreateTopologyInBackground(2);
+  }
+
+  ON_Mesh empty_mesh;
+  if (empty_mesh.CreateTopologyInBackground(0))
+    failure_count++;
+
+  // ON_ObjectArray<ON_Mesh> moves meshes with memcpy() when it grows.
+  ON_Mesh small_mesh;
+  Internal_TopologyTestMesh(6, 23, small_mesh);
+  Internal_ReferenceTopology small_ref;
+  Internal_GetReferenceTopology(small_mesh, small_ref);
+  ON_ObjectArray<ON_Mesh> meshes(1);
+  for (int i = 0; i < 16; i++)
+  {
+    meshes.AppendNew() = small_mesh;
+    meshes[i].Topology();
+  }
+  for (int i = 0; i < meshes.Count(); i++)
+  {
+    if (!meshes[i].HasMeshTopology() || &meshes[i] != meshes[i].Topology().m_mesh || !Internal_SameTopology(meshes[i].Topology(), small_ref))
+      failure_count++;
+    meshes[i].DestroyTopology();
+    if (!meshes[i].CreateTopologyInBackground(2) || !Internal_SameTopology(meshes[i].Topology(), small_ref))
+      failure_count++;
+  }
+
+  return failure_count;
+}
+
+static bool Internal_SameNgonBoundary(
+  const ON_SimpleArray<unsigned int>& ngon_vi,
+  const unsigned int* expected_vi,
+  unsigned int expected_count
+)
+{
+  // Boundaries are compared as cycles in the same direction.
+  if (ngon_vi.UnsignedCount() != expected_count || 0 == expected_count)
+    return false;
+  for (unsigned int shift = 0; shift < expected_count; shift++)
+  {
+    unsigned int i = 0;
+    while (i < expected_count && ngon_vi[i] == expected_vi[(i + shift) % expected_count])
+      i++;
+    if (i == expected_count)
+      return true;
+  }
+  return false;
+}
+
+static unsigned int Internal_TestNgonRepeatedCorner()
+{
+  unsigned int failure_count = 0;
+
+  // 3x3 grid of vertices, vi = 3*row + column.
+  ON_Mesh mesh;
+  for (int row = 0; row < 3; row++)
+  {
+    for (int column = 0; column < 3; column++)
+      mesh.m_V.Append(ON_3fPoint((float)column, (float)row, 0.0f));
+  }
+
+  // Faces 1 and 2 are quads with a repeated corner. Face 1 repeats
+  // adjacent corners and face 2 repeats its first and last corner.
+  mesh.SetQuad(0, 0, 1, 4, 3);
+  mesh.SetQuad(1, 1, 2, 2, 4);
+  mesh.SetQuad(2, 4, 2, 5, 4);
+  mesh.SetQuad(3, 3, 4, 7, 6);
+  mesh.SetQuad(4, 4, 5, 8, 7);
+
+  const ON_3dPointListRef vertex_list(&mesh);
+  const ON_MeshFaceList face_list(&mesh);
+  const unsigned int expected_vi[] = { 0, 1, 2, 5, 4, 3 };
+  const unsigned int expected_count = (unsigned int)(sizeof(expected_vi) / sizeof(expected_vi[0]));
+  const unsigned int ngon_fi[][3] = { { 0, 1, 2 }, { 2, 0, 1 }, { 1, 2, 0 } };
+
+  for (unsigned int k = 0; k < sizeof(ngon_fi) / sizeof(ngon_fi[0]); k++)
+  {
+    ON_SimpleArray<unsigned int> csr_vi;
+    if (!ON_MeshNgon::FindNgonBoundary(vertex_list, face_list, (const unsigned int *const*)nullptr, 3, ngon_fi[k], csr_vi)
+      || !Internal_SameNgonBoundary(csr_vi, expected_vi, expected_count))
+      failure_count++;
+
+    ON_SimpleArray<unsigned int> outer_vi;
+    if (!ON_MeshNgon::FindNgonOuterBoundary(vertex_list, face_list, (const unsigned int *const*)nullptr, 3, ngon_fi[k], outer_vi)
+      || !Internal_SameArrayBits(outer_vi, csr_vi))
+      failure_count++;
+
+    for (int map_invalid = 0; map_invalid < 2; map_invalid++)
+    {
+      // An empty map is filled by FindNgonBoundary(), a set map is used as is.
+      ON_MeshVertexFaceMap empty_map;
+      ON_SimpleArray<unsigned int> map_vi;
+      if (!ON_MeshNgon::FindNgonBoundary(vertex_list, face_list, &empty_map, 3, ngon_fi[k], map_vi)
+        || !Internal_SameArrayBits(map_vi, csr_vi))
+        failure_count++;
+
+      ON_MeshVertexFaceMap vf_map;
+      if (!vf_map.SetFromFaceList(mesh.m_V.UnsignedCount(), face_list, 0 != map_invalid))
+      {
+        failure_count++;
+        continue;
+      }
+      map_vi.SetCount(0);
+      if (!ON_MeshNgon::FindNgonBoundary(vertex_list, face_list, &vf_map, 3, ngon_fi[k], map_vi)
+        || !Internal_SameArrayBits(map_vi, csr_vi))
+        failure_count++;
+      map_vi.SetCount(0);
+      if (!ON_MeshNgon::FindNgonOuterBoundary(vertex_list, face_list, vf_map.VertexFaceMap(), 3, ngon_fi[k], map_vi)
+        || !Internal_SameArrayBits(map_vi, csr_vi))
+        failure_count++;
+    }
+
+    ON_MeshNgon ngon;
+    ngon.m_Fcount = 3;
+    ngon.m_fi = const_cast<unsigned int*>(ngon_fi[k]);
+    ON_SimpleArray<unsigned int> sides;
+    if (expected_count != ngon.GetBoundarySides(face_list, sides))
+      failure_count++;
+  }
+
+  return failure_count;
+}
+
+// Brute force reference for ON_MeshBVH queries.
+// Quads in the BVH test meshes are planar, so either diagonal splits
+// them into triangles that cover the same region.
+static unsigned int Internal_BVHFaceTriangles(const ON_Mesh& mesh, unsigned int fi, ON_Triangle T[2])
+{
+  const ON_MeshFace& f = mesh.m_F[fi];
+  T[0] = ON_Triangle(mesh.Vertex(f.vi[0]), mesh.Vertex(f.vi[1]), mesh.Vertex(f.vi[2]));
+  if (!f.IsQuad())
+    return 1;
+  T[1] = ON_Triangle(mesh.Vertex(f.vi[0]), mesh.Vertex(f.vi[2]), mesh.Vertex(f.vi[3]));
+  return 2;
+}
+
+// Returns true if the segment P + s*D, 0 <= s <= 1, crosses triangle T.
+// Sets bAmbiguous when the crossing is too close to an edge of the face,
+// an end of the segment or parallel to call. skip_corner is the corner
+// opposite a quad diagonal, whose barycentric coordinate does not 
+// correspond to an edge of the face.
+static bool Internal_BVHSegmentHitsTriangle(
+  const ON_3dPoint& P,
+  const ON_3dVector& D,
+  const ON_Triangle& T,
+  int skip_corner,
+  double* s,
+  bool& bAmbiguous
+)
+{
+  const double tol = 1.0e-7;
+  const ON_3dVector N = ON_CrossProduct(T[1] - T[0], T[2] - T[0]);
+  const double NN = N * N;
+  const double ND = N * D;
+  if (!(fabs(ND) > tol * sqrt(NN * (D * D))))
+  {
+    // Parallel; the test meshes are in general position.
+    if (fabs(N * (P - T[0])) <= tol * sqrt(NN))
+      bAmbiguous = true;
+    return false;
+  }
+  const double t = (N * (T[0] - P)) / ND;
+  if (t < -tol || t > 1.0 + tol)
+    return false;
+  const ON_3dPoint X = P + t * D;
+  double b[3];
+  for (int i = 0; i < 3; i++)
+    b[i] = ON_CrossProduct(T[(i + 1) % 3] - X, T[(i + 2) % 3] - X) * N / NN;
+  bool bInside = true;
+  for (int i = 0; i < 3; i++)
+  {
+    if (i == skip_corner)
+      continue;
+    if (fabs(b[i]) <= tol)
+      bAmbiguous = true;
+    if (b[i] < 0.0)
+      bInside = false;
+  }
+  if (skip_corner >= 0 && b[skip_corner] < -tol)
+    bInside = false;
+  if (!bInside)
+    return false;
+  if (t <= tol || t >= 1.0 - tol)
+    bAmbiguous = true;
+  *s = t;
+  return true;
+}
+
+// Returns true if the segment P + s*D, 0 <= s <= 1, crosses face fi
+// and sets *s to the smallest crossing parameter.
+static bool Internal_BVHSegmentHitsFace(
+  const ON_Mesh& mesh,
+  unsigned int fi,
+  const ON_3dPoint& P,
+  const ON_3dVector& D,
+  double* s,
+  bool& bAmbiguous
+)
+{
+  ON_Triangle T[2];
+  const unsigned int triangle_count = Internal_BVHFaceTriangles(mesh, fi, T);
+  bool rc = false;
+  for (unsigned int i = 0; i < triangle_count; i++)
+  {
+    const int skip_corner = (1 == triangle_count) ? -1 : (0 == i ? 1 : 2);
+    double t;
+    if (Internal_BVHSegmentHitsTriangle(P, D, T[i], skip_corner, &t, bAmbiguous))
+    {
+      if (!rc || t < *s)
+        *s = t;
+      rc = true;
+    }
+  }
+  return rc;
+}
+
+// Distance from P to triangle T. (ON_Triangle::DistanceTo() is not
+// always exact when the closest point is on an edge.)
+static double Internal_BVHTriangleDistance(const ON_Triangle& T, const ON_3dPoint& P)
+{
+  const ON_3dVector N = ON_CrossProduct(T[1] - T[0], T[2] - T[0]);
+  const double NN = N * N;
+  const ON_3dPoint X = P - ((P - T[0]) * N / NN) * N;
+  bool bInside = true;
+  for (int i = 0; i < 3; i++)
+  {
+    if (ON_CrossProduct(T[(i + 1) % 3] - X, T[(i + 2) % 3] - X) * N < 0.0)
+      bInside = false;
+  }
+  if (bInside)
+    return P.DistanceTo(X);
+  double d = ON_DBL_MAX;
+  for (int i = 0; i < 3; i++)
+  {
+    const ON_3dPoint A = T[i];
+    const ON_3dVector AB = T[(i + 1) % 3] - A;
+    double s = ((P - A) * AB) / (AB * AB);
+    s = (s < 0.0) ? 0.0 : ((s > 1.0) ? 1.0 : s);
+    const double e = P.DistanceTo(A + s * AB);
+    if (e < d)
+      d = e;
+  }
+  return d;
+}
+
+// Faces in general position clash when an edge of one crosses the other.
+static bool Internal_BVHFacesClash(const ON_Mesh& meshA, unsigned int fa, const ON_Mesh& meshB, unsigned int fb, bool& bAmbiguous)
+{
+  bool rc = false;
+  for (int pass = 0; pass < 2; pass++)
+  {
+    const ON_Mesh& mesh0 = (0 == pass) ? meshA : meshB;
+    const ON_Mesh& mesh1 = (0 == pass) ? meshB : meshA;
+    const unsigned int f0 = (0 == pass) ? fa : fb;
+    const unsigned int f1 = (0 == pass) ? fb : fa;
+    const ON_MeshFace& f = mesh0.m_F[f0];
+    const int corner_count = f.IsQuad() ? 4 : 3;
+    for (int i = 0; i < corner_count; i++)
+    {
+      const ON_3dPoint P = mesh0.Vertex(f.vi[i]);
+      const ON_3dVector D = mesh0.Vertex(f.vi[(i + 1) % corner_count]) - P;
+      double s;
+      if (Internal_BVHSegmentHitsFace(mesh1, f1, P, D, &s, bAmbiguous))
+        rc = true;
+    }
+  }
+  return rc;
+}
+
+static void Internal_BVHTestMesh(ON__UINT32 seed, int triangle_count, int quad_count, double size, ON_Mesh& mesh)
+{
+  ON_RandomNumberGenerator rng;
+  rng.Seed(seed);
+  mesh.Destroy();
+  for (int i = 0; i < triangle_count + quad_count; i++)
+  {
+    const ON_3dPoint C(rng.RandomDouble(0.0, 10.0), rng.RandomDouble(0.0, 10.0), rng.RandomDouble(0.0, 10.0));
+    const int vi = mesh.m_V.Count();
+    if (i < triangle_count)
+    {
+      for (int k = 0; k < 3; k++)
+        mesh.m_V.Append(ON_3fPoint(C + ON_3dVector(rng.RandomDouble(-size, size), rng.RandomDouble(-size, size), rng.RandomDouble(-size, size))));
+      mesh.SetTriangle(mesh.m_F.Count(), vi, vi + 1, vi + 2);
+    }
+    else
+    {
+      // A parallelogram with float coordinates that lie exactly in a plane
+      // perpendicular to a coordinate axis.
+      const int axis = (int)(rng.RandomNumber() % 3);
+      ON_3dVector X = ON_3dVector::ZeroVector, Y = ON_3dVector::ZeroVector;
+      X[(axis + 1) % 3] = (float)rng.RandomDouble(0.5, size);
+      X[(axis + 2) % 3] = (float)rng.RandomDouble(-0.5, 0.5);
+      Y[(axis + 1) % 3] = (float)rng.RandomDouble(-0.5, 0.5);
+      Y[(axis + 2) % 3] = (float)rng.RandomDouble(0.5, size);
+      const ON_3fPoint Q(C);
+      mesh.m_V.Append(Q);
+      mesh.m_V.Append(Q + ON_3fVector(X));
+      mesh.m_V.Append(Q + ON_3fVector(X + Y));
+      mesh.m_V.Append(Q + ON_3fVector(Y));
+      mesh.SetQuad(mesh.m_F.Count(), vi, vi + 1, vi + 2, vi + 3);
+    }
+  }
+}
+
+static int Internal_CompareRayParameter(const ON_MeshFacePoint* a, const ON_MeshFacePoint* b)
+{
+  if (a->m_ray_t < b->m_ray_t)
+    return -1;
+  return (a->m_ray_t > b->m_ray_t) ? 1 : 0;
+}
+
+static unsigned int Internal_TestMeshBVH()
+{
+  unsigned int failure_count = 0;
+
+  ON_Mesh mesh;
+  Internal_BVHTestMesh(24, 300, 80, 1.5, mesh);
+  const unsigned int face_count = mesh.m_F.UnsignedCount();
+  ON_MeshBVH bvh;
+  if (!bvh.Create(&mesh) || bvh.TriangleCount() != 300 + 2 * 80)
+    failure_count++;
+
+  ON_RandomNumberGenerator rng;
+  rng.Seed(2400);
+
+  // Ray first hit and all hits. Rays through the centers of quads pass
+  // through their diagonals and must report the quad once.
+  const double ray_length = 40.0;
+  ON_SimpleArray<ON_3dRay> rays;
+  unsigned int compared_ray_count = 0;
+  for (int i = 0; i < 800; i++)
+  {
+    ON_3dRay ray;
+    if (i < 80)
+    {
+      const ON_MeshFace& f = mesh.m_F[300 + i];
+      const ON_3dPoint C = 0.5 * (mesh.Vertex(f.vi[0]) + mesh.Vertex(f.vi[2]));
+      const ON_3dVector N = ON_CrossProduct(mesh.Vertex(f.vi[1]) - mesh.Vertex(f.vi[0]), mesh.Vertex(f.vi[3]) - mesh.Vertex(f.vi[0])).UnitVector();
+      const ON_3dVector tilt(rng.RandomDouble(-0.2, 0.2), rng.RandomDouble(-0.2, 0.2), rng.RandomDouble(-0.2, 0.2));
+      ray.m_V = N + tilt;
+      ray.m_P = C - 20.0 * ray.m_V / ray.m_V.Length();
+    }
+    else
+    {
+      ray.m_P = ON_3dPoint(rng.RandomDouble(-5.0, 15.0), rng.RandomDouble(-5.0, 15.0), rng.RandomDouble(-5.0, 15.0));
+      ray.m_V = ON_3dVector(rng.RandomDouble(-1.0, 1.0), rng.RandomDouble(-1.0, 1.0), rng.RandomDouble(-1.0, 1.0));
+    }
+    ray.m_V.Unitize();
+    rays.Append(ray);
+
+    // Reference: every face the ray crosses, sorted by ray parameter.
+    bool bAmbiguous = false;
+    ON_SimpleArray<ON_MeshFacePoint> ref_hits;
+    for (unsigned int fi = 0; fi < face_count; fi++)
+    {
+      double s;
+      if (Internal_BVHSegmentHitsFace(mesh, fi, ray.m_P, ray_length * ray.m_V, &s, bAmbiguous))
+      {
+        ON_MeshFacePoint& ref_hit = ref_hits.AppendNew();
+        ref_hit.m_face_index = fi;
+        ref_hit.m_ray_t = s * ray_length;
+      }
+    }
+    if (bAmbiguous)
+      continue;
+    ref_hits.QuickSort(Internal_CompareRayParameter);
+    compared_ray_count++;
+
+    ON_SimpleArray<ON_MeshFacePoint> hits;
+    if (bvh.RayAllHits(ray, ray_length, hits) != ref_hits.UnsignedCount())
+    {
+      failure_count++;
+      continue;
+    }
+    for (int k = 0; k < hits.Count(); k++)
+    {
+      const double t = ref_hits[k].m_ray_t;
+      if ((int)hits[k].m_face_index != (int)ref_hits[k].m_face_index || !(fabs(hits[k].m_ray_t - t) <= 1.0e-9 * (1.0 + t)))
+        failure_count++;
+      // The face weights evaluate to the hit point.
+      const ON_MeshFace& f = mesh.m_F[hits[k].m_face_index];
+      ON_3dPoint Q = ON_3dPoint::Origin;
+      for (int c = 0; c < 4; c++)
+        Q += hits[k].m_t[c] * mesh.Vertex(f.vi[c]);
+      if (!(Q.DistanceTo(hits[k].m_P) <= 1.0e-9) || !(hits[k].m_P.DistanceTo(ray.m_P + hits[k].m_ray_t * ray.m_V) <= 1.0e-9))
+        failure_count++;
+    }
+
+    ON_MeshFacePoint first_hit;
+    const bool bHit = bvh.RayFirstHit(ray, ray_length, first_hit);
+    if (bHit != (ref_hits.Count() > 0))
+      failure_count++;
+    else if (bHit && ((int)first_hit.m_face_index != (int)ref_hits[0].m_face_index || !(fabs(first_hit.m_ray_t - hits[0].m_ray_t) <= 1.0e-9 * (1.0 + hits[0].m_ray_t))))
+      failure_count++;
+
+    // maximum_t between the first and second hit keeps only the first hit.
+    if (ref_hits.Count() >= 2)
+    {
+      const double maximum_t = 0.5 * (ref_hits[0].m_ray_t + ref_hits[1].m_ray_t);
+      hits.SetCount(0);
+      if (1 != bvh.RayAllHits(ray, maximum_t, hits) || (int)hits[0].m_face_index != (int)ref_hits[0].m_face_index)
+        failure_count++;
+      if (!bvh.RayFirstHit(ray, maximum_t, first_hit) || (int)first_hit.m_face_index != (int)ref_hits[0].m_face_index)
+        failure_count++;
+    }
+  }
+  if (compared_ray_count < 700)
+    failure_count++;
+
+  // The multithreaded version gives the same hits.
+  for (unsigned int thread_count = 1; thread_count <= 4; thread_count += 3)
+  {
+    ON_SimpleArray<ON_MeshFacePoint> first_hits(rays.Count());
+    first_hits.SetCount(rays.Count());
+    bvh.RayFirstHits(thread_count, rays.UnsignedCount(), rays.Array(), ray_length, first_hits.Array());
+    for (int i = 0; i < rays.Count(); i++)
+    {
+      ON_MeshFacePoint hit;
+      bvh.RayFirstHit(rays[i], ray_length, hit);
+      if (hit.m_face_index != first_hits[i].m_face_index || (hit.IsSet() && hit.m_ray_t != first_hits[i].m_ray_t))
+        failure_count++;
+    }
+  }
+
+  // Closest point.
+  ON_SimpleArray<ON_3dPoint> points;
+  for (int i = 0; i < 500; i++)
+  {
+    const ON_3dPoint P(rng.RandomDouble(-3.0, 13.0), rng.RandomDouble(-3.0, 13.0), rng.RandomDouble(-3.0, 13.0));
+    points.Append(P);
+    double ref_d = ON_DBL_MAX;
+    ON_SimpleArray<double> face_d(face_count);
+    for (unsigned int fi = 0; fi < face_count; fi++)
+    {
+      ON_Triangle T[2];
+      const unsigned int triangle_count = Internal_BVHFaceTriangles(mesh, fi, T);
+      double d = Internal_BVHTriangleDistance(T[0], P);
+      if (2 == triangle_count && Internal_BVHTriangleDistance(T[1], P) < d)
+        d = Internal_BVHTriangleDistance(T[1], P);
+      face_d.Append(d);
+      if (d < ref_d)
+        ref_d = d;
+    }
+    ON_MeshFacePoint cp;
+    if (!bvh.GetClosestPoint(P, 0.0, cp) || cp.m_face_index >= face_count)
+    {
+      failure_count++;
+      continue;
+    }
+    if (!(fabs(cp.m_distance - ref_d) <= 1.0e-9 * (1.0 + ref_d))
+      || !(fabs(face_d[cp.m_face_index] - ref_d) <= 1.0e-9 * (1.0 + ref_d))
+      || !(fabs(P.DistanceTo(cp.m_P) - cp.m_distance) <= 1.0e-12 * (1.0 + ref_d)))
+      failure_count++;
+    if (bvh.GetClosestPoint(P, 0.5 * ref_d, cp) || !bvh.GetClosestPoint(P, 2.0 * ref_d + 1.0e-6, cp))
+      failure_count++;
+  }
+  for (unsigned int thread_count = 1; thread_count <= 4; thread_count += 3)
+  {
+    ON_SimpleArray<ON_MeshFacePoint> closest_points(points.Count());
+    closest_points.SetCount(points.Count());
+    if (points.UnsignedCount() != bvh.GetClosestPoints(thread_count, points.UnsignedCount(), points.Array(), 0.0, closest_points.Array()))
+      failure_count++;
+    for (int i = 0; i < points.Count(); i++)
+    {
+      ON_MeshFacePoint cp;
+      bvh.GetClosestPoint(points[i], 0.0, cp);
+      if (cp.m_face_index != closest_points[i].m_face_index || cp.m_distance != closest_points[i].m_distance)
+        failure_count++;
+    }
+  }
+
+  // Self clash and mutual clash.
+  ON_Mesh other;
+  Internal_BVHTestMesh(25, 200, 60, 1.5, other);
+  ON_MeshBVH other_bvh;
+  if (!other_bvh.Create(&other))
+    failure_count++;
+  for (int pass = 0; pass < 2; pass++)
+  {
+    const ON_Mesh& meshB = (0 == pass) ? mesh : other;
+    const ON_MeshBVH& bvhB = (0 == pass) ? bvh : other_bvh;
+    ON_SimpleArray<ON_2dex> pairs;
+    bvh.GetClashingFacePairs(bvhB, 0, pairs);
+    for (int i = 1; i < pairs.Count(); i++)
+    {
+      if (pairs[i - 1].i > pairs[i].i || (pairs[i - 1].i == pairs[i].i && pairs[i - 1].j >= pairs[i].j))
+        failure_count++;
+    }
+    unsigned int compared_pair_count = 0;
+    unsigned int clash_count = 0;
+    int k = 0;
+    for (unsigned int fa = 0; fa < face_count; fa++)
+    {
+      for (unsigned int fb = (0 == pass) ? fa + 1 : 0; fb < meshB.m_F.UnsignedCount(); fb++)
+      {
+        bool bAmbiguous = false;
+        const bool bClash = Internal_BVHFacesClash(mesh, fa, meshB, fb, bAmbiguous);
+        while (k < pairs.Count() && (pairs[k].i < (int)fa || (pairs[k].i == (int)fa && pairs[k].j < (int)fb)))
+        {
+          // every reported pair is a brute force pair
+          failure_count++;
+          k++;
+        }
+        const bool bReported = (k < pairs.Count() && pairs[k].i == (int)fa && pairs[k].j == (int)fb);
+        if (bReported)
+          k++;
+        if (bAmbiguous)
+          continue;
+        compared_pair_count++;
+        if (bClash)
+          clash_count++;
+        if (bClash != bReported)
+          failure_count++;
+      }
+    }
+    if (k != pairs.Count() || clash_count < 20 || compared_pair_count < 30000)
+      failure_count++;
+
+    if (bvh.Clashes(bvhB) != (pairs.Count() > 0))
+      failure_count++;
+    ON_SimpleArray<ON_2dex> first_pairs;
+    if (5 != bvh.GetClashingFacePairs(bvhB, 5, first_pairs))
+      failure_count++;
+    for (int i = 0; i < first_pairs.Count(); i++)
+    {
+      int j = 0;
+      while (j < pairs.Count() && (pairs[j].i != first_pairs[i].i || pairs[j].j != first_pairs[i].j))
+        j++;
+      if (j == pairs.Count())
+        failure_count++;
+    }
+  }
+
+  // Faces that share a vertex location do not clash with themselves.
+  ON_Mesh grid;
+  Internal_TopologyTestMesh(20, 26, grid);
+  ON_MeshBVH grid_bvh;
+  ON_SimpleArray<ON_2dex> grid_pairs;
+  if (!grid_bvh.Create(&grid) || 0 != grid_bvh.GetClashingFacePairs(grid_bvh, 0, grid_pairs))
+    failure_count++;
+
+  // A large quad pierced by three small triangles.
+  for (int what_to_cull = 0; what_to_cull <= 4; what_to_cull++)
+  {
+    ON_Mesh cull_mesh;
+    cull_mesh.m_V.Append(ON_3fPoint(0.0f, 0.0f, 0.0f));
+    cull_mesh.m_V.Append(ON_3fPoint(10.0f, 0.0f, 0.0f));
+    cull_mesh.m_V.Append(ON_3fPoint(10.0f, 10.0f, 0.0f));
+    cull_mesh.m_V.Append(ON_3fPoint(0.0f, 10.0f, 0.0f));
+    cull_mesh.SetQuad(0, 0, 1, 2, 3);
+    for (int i = 0; i < 3; i++)
+    {
+      const float x = 2.0f + 3.0f * i;
+      const int vi = cull_mesh.m_V.Count();
+      cull_mesh.m_V.Append(ON_3fPoint(x, 5.0f, -1.0f));
+      cull_mesh.m_V.Append(ON_3fPoint(x + 1.0f, 5.0f, -1.0f));
+      cull_mesh.m_V.Append(ON_3fPoint(x + 0.5f, 5.0f, 1.0f));
+      cull_mesh.SetTriangle(cull_mesh.m_F.Count(), vi, vi + 1, vi + 2);
+    }
+    const int expected_cull_count[5] = { 2, 3, 1, 3, 1 };
+    if (expected_cull_count[what_to_cull] != cull_mesh.CullClashingFaces(what_to_cull)
+      || cull_mesh.m_F.Count() != 4 - expected_cull_count[what_to_cull])
+      failure_count++;
+    else if ((2 == what_to_cull || 4 == what_to_cull) && cull_mesh.m_F[0].IsQuad())
+      failure_count++;
+  }
+
+  // Clashing mesh pairs in a list.
+  ON_ObjectArray<ON_Mesh> meshes(12);
+  ON_ClassArray<ON_MeshBVH> bvhs(12);
+  for (int i = 0; i < 12; i++)
+  {
+    Internal_BVHTestMesh(100 + i, 40, 10, 2.0, meshes.AppendNew());
+    meshes[i].Translate(ON_3dVector(12.0 * (i % 4), 0.0, 0.0));
+    bvhs.AppendNew().Create(&meshes[i]);
+  }
+  ON_SimpleArray<const ON_MeshBVH*> bvh_list;
+  for (int i = 0; i < 12; i++)
+    bvh_list.Append(&bvhs[i]);
+  bvh_list.Append(nullptr);
+  ON_SimpleArray<ON_2dex> ref_mesh_pairs;
+  for (int i = 0; i < 12; i++)
+  {
+    for (int j = i + 1; j < 12; j++)
+    {
+      if (bvhs[i].Clashes(bvhs[j]))
+        ref_mesh_pairs.Append(ON_2dex(i, j));
+    }
+  }
+  for (unsigned int thread_count = 0; thread_count <= 4; thread_count += 4)
+  {
+    ON_SimpleArray<ON_2dex> mesh_pairs;
+    ON_MeshBVH::GetClashingMeshPairs(thread_count, bvh_list.UnsignedCount(), bvh_list.Array(), mesh_pairs);
+    if (mesh_pairs.Count() != ref_mesh_pairs.Count() || 0 == ref_mesh_pairs.Count())
+      failure_count++;
+    else
+    {
+      for (int i = 0; i < mesh_pairs.Count(); i++)
+      {
+        if (mesh_pairs[i].i != ref_mesh_pairs[i].i || mesh_pairs[i].j != ref_mesh_pairs[i].j)
+          failure_count++;
+      }
+    }
+  }
+
+  return failure_count;
+}
+
+// The serial ON_Mesh::ComputeFaceNormals() and ComputeVertexNormals()
+// used before they were threaded.
+static void Internal_OldComputeNormals(const ON_Mesh& mesh, ON_3fVectorArray& FN, ON_3fVectorArray& N)
+{
+  const int fcount = mesh.FaceCount();
+  const int vcount = mesh.VertexCount();
+  FN.SetCount(0);
+  N.SetCount(0);
+  const bool bDoublePrecision = mesh.HasSynchronizedDoubleAndSinglePrecisionVertices();
+  for (int fi = 0; fi < fcount; fi++)
+  {
+    const int* vi = mesh.m_F[fi].vi;
+    ON_3dVector a, b;
+    if (bDoublePrecision)
+    {
+      a = mesh.m_dV[vi[2]] - mesh.m_dV[vi[0]];
+      b = mesh.m_dV[vi[3]] - mesh.m_dV[vi[1]];
+    }
+    else
+    {
+      a = mesh.m_V[vi[2]] - mesh.m_V[vi[0]];
+      b = mesh.m_V[vi[3]] - mesh.m_V[vi[1]];
+    }
+    ON_3dVector n = ON_CrossProduct(a, b);
+    n.Unitize();
+    FN.Append(ON_3fVector(n));
+  }
+
+  // vfi[vfoffset[vi],...] = the vfcount[vi] valid faces that use vertex vi
+  ON_SimpleArray<int> vfcount(vcount);
+  vfcount.SetCount(vcount);
+  vfcount.Zero();
+  for (int fi = 0; fi < fcount; fi++)
+  {
+    const ON_MeshFace& f = mesh.m_F[fi];
+    if (f.IsValid(vcount))
+    {
+      for (int c = 0; c < (f.IsQuad() ? 4 : 3); c++)
+        vfcount[f.vi[c]]++;
+    }
+  }
+  ON_SimpleArray<int> vfoffset(vcount);
+  int vfi_count = 0;
+  for (int vi = 0; vi < vcount; vi++)
+  {
+    vfoffset.Append(vfi_count);
+    vfi_count += vfcount[vi];
+    vfcount[vi] = 0;
+  }
+  ON_SimpleArray<int> vfi(vfi_count);
+  vfi.SetCount(vfi_count);
+  for (int fi = 0; fi < fcount; fi++)
+  {
+    const ON_MeshFace& f = mesh.m_F[fi];
+    if (f.IsValid(vcount))
+    {
+      for (int c = 0; c < (f.IsQuad() ? 4 : 3); c++)
+        vfi[vfoffset[f.vi[c]] + vfcount[f.vi[c]]++] = fi;
+    }
+  }
+  for (int vi = 0; vi < vcount; vi++)
+  {
+    ON_3fVector n = ON_3fVector::ZeroVector;
+    for (int j = vfcount[vi] - 1; j >= 0; j--)
+      n += FN[vfi[vfoffset[vi] + j]];
+    if (!n.Unitize())
+      n.Set(0, 0, 1);
+    N.Append(n);
+  }
+}
+
+// Area or angle weighted vertex normal calculated from the definition.
+static ON_3dVector Internal_WeightedVertexNormal(const ON_Mesh& mesh, int vi, bool bAngleWeight)
+{
+  ON_3dVector n = ON_3dVector::ZeroVector;
+  for (int fi = 0; fi < mesh.m_F.Count(); fi++)
+  {
+    const ON_MeshFace& f = mesh.m_F[fi];
+    if (!f.IsValid(mesh.m_V.Count()))
+      continue;
+    const int corner_count = f.IsQuad() ? 4 : 3;
+    const ON_3dVector FN(mesh.m_FN[fi]);
+    for (int c = 0; c < corner_count; c++)
+    {
+      if (vi != f.vi[c])
+        continue;
+      double w;
+      if (bAngleWeight)
+      {
+        const ON_3dPoint P = mesh.Vertex(vi);
+        const ON_3dVector A = mesh.Vertex(f.vi[(c + corner_count - 1) % corner_count]) - P;
+        const ON_3dVector B = mesh.Vertex(f.vi[(c + 1) % corner_count]) - P;
+        w = ON_3dVector::Angle(A, B);
+      }
+      else
+      {
+        // The area of a nonplanar quad is the length of its vector area.
+        w = 0.5 * ON_CrossProduct(mesh.Vertex(f.vi[2]) - mesh.Vertex(f.vi[0]), mesh.Vertex(f.vi[3]) - mesh.Vertex(f.vi[1])).Length();
+      }
+      n += w * FN;
+    }
+  }
+  if (!n.Unitize())
+    n = ON_3dVector::ZAxis;
+  return n;
+}
+
+static unsigned int Internal_TestVertexNormals()
+{
+  unsigned int failure_count = 0;
+
+  // A curved grid with duplicate vertices, repeated faces and degenerate
+  // quads that spans several vertex blocks. Pass 1 uses double precision
+  // vertices.
+  for (int pass = 0; pass < 2; pass++)
+  {
+    ON_Mesh mesh;
+    Internal_TopologyTestMesh(400, 250 + pass, mesh);
+    mesh.m_V.Append(ON_3fPoint(0.0f, 0.0f, 5.0f)); // not used by a face
+    if (0 == pass)
+    {
+      for (int vi = 0; vi + 1 < mesh.m_V.Count(); vi++)
+        mesh.m_V[vi].z = (float)(3.0 * sin(0.1 * mesh.m_V[vi].x) * cos(0.13 * mesh.m_V[vi].y));
+    }
+    else
+    {
+      mesh.m_dV.Reserve(mesh.m_V.Count());
+      for (int vi = 0; vi < mesh.m_V.Count(); vi++)
+      {
+        ON_3dPoint P(mesh.m_V[vi]);
+        if (vi + 1 < mesh.m_V.Count())
+          P.z = 3.0 * sin(0.1 * P.x) * cos(0.13 * P.y);
+        mesh.m_dV.Append(P);
+      }
+      mesh.UpdateSinglePrecisionVertices();
+      if (!mesh.HasSynchronizedDoubleAndSinglePrecisionVertices())
+        failure_count++;
+    }
+
+    ON_3fVectorArray old_FN, old_N;
+    Internal_OldComputeNormals(mesh, old_FN, old_N);
+
+    // ComputeFaceNormals() and ComputeVertexNormals() match the serial
+    // loops bit for bit.
+    mesh.m_FN.Destroy();
+    mesh.m_N.Destroy();
+    if (!mesh.ComputeVertexNormals() || !Internal_SameArrayBits(mesh.m_FN, old_FN) || !Internal_SameArrayBits(mesh.m_N, old_N))
+      failure_count++;
+    if (!(mesh.m_N[mesh.m_V.Count() - 1] == ON_3fVector::ZAxis))
+      failure_count++;
+
+    const unsigned int thread_counts[3] = { 1, 4, 0 };
+    for (int t = 0; t < 3; t++)
+    {
+      mesh.m_FN.Destroy();
+      mesh.m_N.Destroy();
+      if (!mesh.ComputeVertexNormals(ON_Mesh::VertexNormalWeight::Face, thread_counts[t])
+        || !Internal_SameArrayBits(mesh.m_FN, old_FN) || !Internal_SameArrayBits(mesh.m_N, old_N))
+        failure_count++;
+    }
+
+    // Area and Angle weights give the same normals for every thread count.
+    for (int w = 0; w < 2; w++)
+    {
+      const ON_Mesh::VertexNormalWeight weight = (0 == w) ? ON_Mesh::VertexNormalWeight::Area : ON_Mesh::VertexNormalWeight::Angle;
+      ON_3fVectorArray serial_N;
+      if (!mesh.ComputeVertexNormals(weight, 1))
+        failure_count++;
+      serial_N = mesh.m_N;
+      for (int t = 1; t < 3; t++)
+      {
+        mesh.m_N.Destroy();
+        if (!mesh.ComputeVertexNormals(weight, thread_counts[t]) || !Internal_SameArrayBits(mesh.m_N, serial_N))
+          failure_count++;
+      }
+      if (Internal_SameArrayBits(serial_N, old_N))
+        failure_count++; // the weights change the normals on a curved mesh
+    }
+  }
+
+  // Area and Angle weights on a small mesh compared with the definition.
+  ON_Mesh small_mesh;
+  Internal_TopologyTestMesh(12, 252, small_mesh);
+  for (int vi = 0; vi < small_mesh.m_V.Count(); vi++)
+    small_mesh.m_V[vi].z = (float)(0.3 * small_mesh.m_V[vi].x * small_mesh.m_V[vi].x - 0.2 * small_mesh.m_V[vi].x * small_mesh.m_V[vi].y);
+  small_mesh.ComputeFaceNormals();
+  for (int w = 0; w < 2; w++)
+  {
+    const bool bAngleWeight = (1 == w);
+    small_mesh.ComputeVertexNormals(bAngleWeight ? ON_Mesh::VertexNormalWeight::Angle : ON_Mesh::VertexNormalWeight::Area, 0);
+    for (int vi = 0; vi < small_mesh.m_V.Count(); vi++)
+    {
+      const ON_3dVector n = Internal_WeightedVertexNormal(small_mesh, vi, bAngleWeight);
+      if (!((ON_3dVector(small_mesh.m_N[vi]) - n).Length() <= 1.0e-6))
+        failure_count++;
+    }
+  }
+
+  return failure_count;
+}
+
+static const ONX_ErrorCounter Internal_TestMeshes(
+  ON_TextLog& text_log
+  )
+{
+  ONX_ErrorCounter error_counter;
+  unsigned int failure_count = 0;
+
+  failure_count += Internal_TestMeshWeld();
+  failure_count += Internal_TestMeshTopology();
+  failure_count += Internal_TestNgonRepeatedCorner();
+  failure_count += Internal_TestMeshBVH();
+  failure_count += Internal_TestVertexNormals();
+
+  if (failure_count > 0)
+    text_log.Print("Mesh test: %u failures.\n", failure_count);
+  for (unsigned int i = 0; i < failure_count; i++)
+    error_counter.IncrementFailureCount();
+
+  return error_counter;
+}
+
 static const ONX_ErrorCounter Internal_TestFileRead(
   ON_TextLog& text_log,
   const ON_String fullpath,
@@ -364,6 +4021,7 @@ static const ONX_ErrorCounter Internal_TestFileRead(
     source_archive.SetArchiveFullPath(static_cast<const wchar_t*>(wide_full_path));
 
     error_counter += Internal_TestModelRead(text_log, path_to_print, source_archive, bVerbose);
+    error_counter += Internal_TestConcurrentRead(text_log, fullpath);
     break;
   }
 
@@ -1023,6 +4681,11 @@ int main( int argc, const char *argv[] )
     Internal_PrintIntroduction(example_test_exe_path, *text_log);
   }
 
+  err += Internal_TestEvaluation(*text_log);
+  err += Internal_TestCompressedBuffers(*text_log);
+  err += Internal_TestRTree(*text_log);
+  err += Internal_TestMeshes(*text_log);
+
   if (folder_count > 0)
   {
     text_log->Print(
@@ -28,6 +28,14 @@
 #include "opennurbs_internal_V2_annotation.h"
 #include "opennurbs_internal_V5_annotation.h"
 
+// ON_Internal_ParallelFor()
+#include "opennurbs_internal_defines.h"
+
+#if !defined(ON_RUNTIME_WIN)
+// mmap() and munmap() used by ON_BinaryMappedFile
+#include <sys/mman.h>
+#endif
+
 const ON_String Internal_RuntimeEnvironmentToString(
   ON::RuntimeEnvironment runtime_environment
 )
@@ -7263,6 +7271,52 @@ bool ON_BinaryArchive::UseBufferCompression() const
 {
   return m_bUseBufferCompression;
 }
+
+void ON_BinaryArchive::SetCompressionCodec(
+  ON_CompressionCodec codec
+)
+{
+  switch (codec)
+  {
+  case ON_CompressionCodec::None:
+  case ON_CompressionCodec::Zlib:
+  case ON_CompressionCodec::LZ4:
+    m_compression_codec = codec;
+    break;
+  default:
+    ON_ERROR("Invalid codec parameter.");
+    break;
+  }
+}
+
+ON_CompressionCodec ON_BinaryArchive::CompressionCodec() const
+{
+  return m_compression_codec;
+}
+
+void ON_BinaryArchive::SetThreadCount(
+  unsigned int thread_count
+)
+{
+  m_thread_count = thread_count;
+}
+
+unsigned int ON_BinaryArchive::ThreadCount() const
+{
+  return ON_Internal_ParallelThreadCount(m_thread_count);
+}
+
+void ON_BinaryArchive::SetDeferGeometryReading(
+  bool bDeferGeometryReading
+)
+{
+  m_bDeferGeometryReading = bDeferGeometryReading ? true : false;
+}
+
+bool ON_BinaryArchive::DeferGeometryReading() const
+{
+  return m_bDeferGeometryReading;
+}
   
 void ON_BinaryArchive::SetSave3dmPreviewImage(
   bool bSave3dmPreviewImage
@@ -15730,6 +15784,325 @@ int ON_BinaryArchive::Read3dmModelGeometryForExperts(
   return rc;
 }
 
+class ON_3dmObjectRecordReader
+{
+public:
+  // The object types in this list are read concurrently. Their geometry
+  // and attributes reference other tables only through the manifest map,
+  // see ON_BinaryArchive::Internal_SetSourceManifestMap().
+  static bool ConcurrentReadIsSafe(ON__INT64 object_type)
+  {
+    switch (object_type)
+    {
+    case ON::point_object:
+    case ON::pointset_object:
+    case ON::curve_object:
+    case ON::surface_object:
+    case ON::brep_object:
+    case ON::mesh_object:
+    case ON::extrusion_object:
+    case ON::subd_object:
+      return true;
+    default:
+      break;
+    }
+    return false;
+  }
+
+  // little endian integer stored in the chunk header
+  static ON__UINT64 ChunkHeaderValue(const unsigned char* p, size_t sizeof_value)
+  {
+    ON__UINT64 v = 0;
+    for (size_t i = 0; i < sizeof_value; i++)
+      v |= ((ON__UINT64)p[i]) << (8 * i);
+    return v;
+  }
+
+  // Record bytes. m_record points into a memory resident archive or to m_buffer.
+  const void* m_record;
+  size_t m_sizeof_record;
+  void* m_buffer;
+
+  // When m_bConcurrentRead is true, the record is read by a worker thread.
+  bool m_bConcurrentRead;
+  int m_rc;
+
+  // When reading geometry is deferred, the TCODE_OPENNURBS_CLASS chunk
+  // is m_sizeof_object bytes at m_record + m_object_offset.
+  ON__UINT64 m_archive_offset;
+  ON__UINT64 m_object_offset;
+  ON__UINT64 m_sizeof_object;
+  ON_Object* m_object;
+  ON_3dmObjectAttributes* m_attributes;
+};
+
+bool ON_BinaryArchive::Read3dmModelGeometryTableForExperts(
+  bool bManageGeometry,
+  bool bManageAttributes,
+  unsigned int object_filter,
+  ON_SimpleArray<class ON_ModelGeometryComponent*>& model_geometry_list
+)
+{
+  const unsigned int thread_count = ThreadCount();
+  const bool bDeferGeometryReading = DeferGeometryReading() && m_3dm_version > 1 && ShouldSerializeAllUserData();
+  if ((thread_count <= 1 && false == bDeferGeometryReading) || m_3dm_version <= 1 || false == ShouldSerializeAllUserData())
+  {
+    for (;;)
+    {
+      ON_ModelGeometryComponent* model_geometry = nullptr;
+      const int rc = Read3dmModelGeometryForExperts(bManageGeometry, bManageAttributes, &model_geometry, object_filter);
+      if (rc <= 0)
+        return (0 == rc);
+      if (nullptr != model_geometry)
+        model_geometry_list.Append(model_geometry);
+    }
+  }
+
+  {
+    ON_Object* ptr = nullptr;
+    if (false == Read3dmTableRecord(ON_3dmArchiveTableType::object_table, (void**)&ptr))
+      return false;
+  }
+
+  if ( 0 == object_filter ) // default filter (0) reads every object
+    object_filter = 0xFFFFFFFF;
+
+  const size_t sizeof_chunk_length = SizeofChunkLength();
+  const size_t sizeof_chunk_header = 4 + sizeof_chunk_length;
+  bool rc = true;
+
+  // Pass 1: Walk the TCODE_OBJECT_RECORD chunks. Records that can be read
+  // concurrently are collected and the remaining records are read here.
+  ON_SimpleArray<ON_3dmObjectRecordReader> records(1024);
+  unsigned int concurrent_count = 0;
+  for (;;)
+  {
+    ON__UINT32 tcode = 0;
+    ON__INT64 big_value = 0;
+    if (false == PeekAt3dmBigChunkType(&tcode, &big_value))
+    {
+      rc = false;
+      break;
+    }
+    if (TCODE_OBJECT_RECORD != tcode)
+      break; // end of table - Read3dmObject() handles the TCODE_ENDOFTABLE chunk.
+    if (big_value < (ON__INT64)sizeof_chunk_header)
+    {
+      ON_ERROR("Corrupt TCODE_OBJECT_RECORD chunk.");
+      rc = false;
+      break;
+    }
+
+    // The record begins with the TCODE_OBJECT_RECORD_TYPE chunk.
+    unsigned char headers[24];
+    const bool bDoChunkCRC = m_bDoChunkCRC;
+    m_bDoChunkCRC = false;
+    bool bHaveHeaders = ReadByte(2 * sizeof_chunk_header, headers);
+    if (bHaveHeaders && false == SeekBackward(2 * sizeof_chunk_header))
+    {
+      rc = false;
+      bHaveHeaders = false;
+    }
+    m_bDoChunkCRC = bDoChunkCRC;
+    if (false == bHaveHeaders
+      || TCODE_OBJECT_RECORD_TYPE != (ON__UINT32)ON_3dmObjectRecordReader::ChunkHeaderValue(headers + sizeof_chunk_header, 4)
+      )
+    {
+      ON_ERROR("ON_BinaryArchive::Read3dmModelGeometryTableForExperts() - missing TCODE_OBJECT_RECORD_TYPE chunk.");
+      rc = false;
+      break;
+    }
+    const ON__INT64 object_type = (ON__INT64)ON_3dmObjectRecordReader::ChunkHeaderValue(headers + sizeof_chunk_header + 4, sizeof_chunk_length);
+
+    ON_3dmObjectRecordReader& record = records.AppendNew(); // AppendNew() zeros the record
+    record.m_rc = -1;
+    record.m_sizeof_record = (size_t)(sizeof_chunk_header + big_value);
+
+    if (0 != object_type && 0 == (object_type & object_filter))
+    {
+      // skip reading this object
+      Internal_Increment3dmTableItemCount();
+      record.m_rc = 2;
+      if (false == SeekForward(record.m_sizeof_record))
+      {
+        rc = false;
+        break;
+      }
+    }
+    else if (ON_3dmObjectRecordReader::ConcurrentReadIsSafe(object_type))
+    {
+      Internal_Increment3dmTableItemCount();
+      record.m_archive_offset = CurrentPosition();
+      record.m_record = ReadInPlace(record.m_sizeof_record);
+      if (nullptr == record.m_record)
+      {
+        record.m_buffer = onmalloc(record.m_sizeof_record);
+        if (nullptr == record.m_buffer || false == ReadByte(record.m_sizeof_record, record.m_buffer))
+        {
+          rc = false;
+          break;
+        }
+        record.m_record = record.m_buffer;
+      }
+      record.m_bConcurrentRead = true;
+      concurrent_count++;
+    }
+    else
+    {
+      record.m_attributes = new ON_3dmObjectAttributes();
+      record.m_rc = Internal_Read3dmObjectRecord(&record.m_object, record.m_attributes, object_filter, true, nullptr, nullptr);
+      if (record.m_rc < 0)
+      {
+        rc = false;
+        break;
+      }
+    }
+  }
+
+  // Pass 2: Decode the collected records. Each record is a complete
+  // TCODE_OBJECT_RECORD chunk and is read from its own archive. The
+  // record archives map layer, material, group, ... references with 
+  // this archive's manifest map, which is not modified until pass 3.
+  if (rc && concurrent_count > 0)
+  {
+    const int archive_3dm_version = Archive3dmVersion();
+    const unsigned int archive_opennurbs_version = ArchiveOpenNURBSVersion();
+    const ON_ManifestMap* source_manifest_map = ReferencedComponentIndexMapping() ? &m_manifest_map : nullptr;
+    const unsigned int record_count = records.UnsignedCount();
+
+    auto read_record = [&](unsigned int i)
+    {
+      ON_3dmObjectRecordReader& record = records[i];
+      if (false == record.m_bConcurrentRead)
+        return;
+      ON_Read3dmBufferArchive record_archive(record.m_sizeof_record, record.m_record, false, archive_3dm_version, archive_opennurbs_version);
+      record.m_attributes = new ON_3dmObjectAttributes();
+      ON_BinaryArchive& a = record_archive;
+      a.Internal_SetSourceManifestMap(source_manifest_map);
+      if (bDeferGeometryReading)
+      {
+        // Read the attributes. The record bytes are kept until the
+        // encoded geometry is saved in pass 3.
+        record.m_rc = a.Internal_Read3dmObjectRecord(&record.m_object, record.m_attributes, object_filter, false, &record.m_object_offset, &record.m_sizeof_object);
+        return;
+      }
+      record.m_rc = a.Internal_Read3dmObjectRecord(&record.m_object, record.m_attributes, object_filter, false, nullptr, nullptr);
+      if (nullptr != record.m_buffer)
+      {
+        onfree(record.m_buffer);
+        record.m_buffer = nullptr;
+      }
+      record.m_record = nullptr;
+    };
+
+    ON_Internal_ParallelFor((concurrent_count < thread_count) ? concurrent_count : thread_count, record_count, read_record);
+  }
+
+  // Deferred geometry is usually read after this archive is closed. The
+  // manifest map is copied once and shared by the deferred components.
+  std::shared_ptr<const ON_ManifestMap> deferred_manifest_map;
+  if (bDeferGeometryReading && concurrent_count > 0 && ReferencedComponentIndexMapping())
+    deferred_manifest_map = std::make_shared<const ON_ManifestMap>(m_manifest_map);
+
+  // Pass 3: Update the manifest in archive order.
+  for (unsigned int i = 0; i < records.UnsignedCount(); i++)
+  {
+    ON_3dmObjectRecordReader& record = records[i];
+    ON_Object* object = record.m_object;
+    ON_3dmObjectAttributes* attributes = record.m_attributes;
+    record.m_object = nullptr;
+    record.m_attributes = nullptr;
+    if (record.m_rc < 0)
+      rc = false;
+    if (rc && 1 == record.m_rc && record.m_sizeof_object > 0 && nullptr != record.m_record)
+    {
+      Internal_Read3dmObjectFinish(nullptr, attributes);
+      ON_ModelGeometryComponent* model_geometry = ON_ModelGeometryComponent::CreateDeferredForExperts(
+        Archive3dmVersion(),
+        ArchiveOpenNURBSVersion(),
+        record.m_archive_offset + record.m_object_offset,
+        deferred_manifest_map,
+        (size_t)record.m_sizeof_object,
+        ((const unsigned char*)record.m_record) + record.m_object_offset,
+        bManageAttributes,
+        attributes,
+        nullptr
+      );
+      attributes = nullptr;
+      if (nullptr != model_geometry)
+        model_geometry_list.Append(model_geometry);
+    }
+    record.m_record = nullptr;
+    if (nullptr != record.m_buffer)
+    {
+      onfree(record.m_buffer);
+      record.m_buffer = nullptr;
+    }
+    if (rc && 1 == record.m_rc && nullptr != object)
+    {
+      Internal_Read3dmObjectFinish(&object, attributes);
+      ON_Geometry* geometry = ON_Geometry::Cast(object);
+      if (nullptr != geometry)
+      {
+        ON_ModelGeometryComponent* model_geometry = ON_ModelGeometryComponent::CreateForExperts(bManageGeometry, geometry, bManageAttributes, attributes, nullptr);
+        if (nullptr != model_geometry)
+        {
+          model_geometry_list.Append(model_geometry);
+          continue;
+        }
+      }
+    }
+    delete object;
+    delete attributes;
+  }
+
+  if (rc)
+  {
+    // read the TCODE_ENDOFTABLE chunk
+    ON_Object* object = nullptr;
+    const int end_rc = Read3dmObject(&object, nullptr, object_filter);
+    if (0 != end_rc)
+    {
+      ON_ERROR("ON_BinaryArchive::Read3dmModelGeometryTableForExperts() - corrupt object table");
+      delete object;
+      rc = false;
+    }
+  }
+
+  return rc;
+}
+
+ON_Object* ON_BinaryArchive::Read3dmDeferredObjectForExperts(
+  int archive_3dm_version,
+  unsigned int archive_opennurbs_version,
+  const ON_ManifestMap* manifest_map,
+  size_t sizeof_buffer,
+  const void* buffer
+)
+{
+  if (0 == sizeof_buffer || nullptr == buffer)
+    return nullptr;
+
+  ON_Read3dmBufferArchive object_archive(sizeof_buffer, buffer, false, archive_3dm_version, archive_opennurbs_version);
+  ON_BinaryArchive& a = object_archive;
+  a.Internal_SetSourceManifestMap(manifest_map);
+  ON_Object* object = nullptr;
+  if (1 != a.ReadObject(&object))
+  {
+    delete object;
+    return nullptr;
+  }
+
+  ON_Object* updated_object = a.Internal_ConvertObject(object, nullptr);
+  if (nullptr != updated_object && updated_object != object)
+  {
+    delete object;
+    object = updated_object;
+  }
+
+  return object;
+}
+
 int ON_BinaryArchive::Read3dmObject( 
   ON_Object** ppObject,                // object is returned here
   ON_3dmObjectAttributes* pAttributes, // optional - object attributes 
@@ -15756,6 +16129,31 @@ int ON_BinaryArchive::Read3dmObject(
     rc = Read3dmV1Object(ppObject,pAttributes,object_filter);
   }
   else 
+  {
+    rc = Internal_Read3dmObjectRecord(ppObject, pAttributes, object_filter, true, nullptr, nullptr);
+  }
+
+  if ( 1 == rc )
+    Internal_Read3dmObjectFinish(ppObject, pAttributes);
+
+  return rc;
+}
+
+int ON_BinaryArchive::Internal_Read3dmObjectRecord(
+  ON_Object** ppObject,
+  ON_3dmObjectAttributes* pAttributes,
+  unsigned int object_filter,
+  bool bIncrementTableItemCount,
+  ON__UINT64* deferred_object_offset,
+  ON__UINT64* sizeof_deferred_object
+  )
+{
+  // Reads a version 2 or later TCODE_OBJECT_RECORD chunk.
+  // The archive manifest is not modified so this can be called on a
+  // temporary archive that contains only the record. The temporary 
+  // archive needs the source archive's manifest map to map referenced 
+  // components. See Internal_SetSourceManifestMap().
+  int rc = -1;
   {
     ON__UINT32 tcode = 0;
     ON__INT64 length_TCODE_OBJECT_RECORD = 0;
@@ -15765,7 +16163,8 @@ int ON_BinaryArchive::Read3dmObject(
     {
       if ( tcode == TCODE_OBJECT_RECORD ) 
       {
-        Internal_Increment3dmTableItemCount();
+        if ( bIncrementTableItemCount )
+          Internal_Increment3dmTableItemCount();
         if (BeginRead3dmBigChunk( &tcode, &value_TCODE_OBJECT_RECORD_TYPE )) 
         {
           if ( tcode != TCODE_OBJECT_RECORD_TYPE ) {
@@ -15780,7 +16179,29 @@ int ON_BinaryArchive::Read3dmObject(
           if ( !EndRead3dmChunk() )
             rc = -1;
 
-          if ( 1 == rc )
+          if ( 1 == rc && nullptr != deferred_object_offset && nullptr != sizeof_deferred_object )
+          {
+            // Skip the TCODE_OPENNURBS_CLASS chunk and return its location.
+            *deferred_object_offset = CurrentPosition();
+            *sizeof_deferred_object = 0;
+            tcode = 0;
+            ON__INT64 length_TCODE_OPENNURBS_CLASS = 0;
+            if ( PeekAt3dmBigChunkType( &tcode, &length_TCODE_OPENNURBS_CLASS ) 
+              && TCODE_OPENNURBS_CLASS == tcode 
+              && length_TCODE_OPENNURBS_CLASS > 0
+              )
+            {
+              *sizeof_deferred_object = 4 + SizeofChunkLength() + (ON__UINT64)length_TCODE_OPENNURBS_CLASS;
+              if ( !SeekForward( *sizeof_deferred_object ) )
+                rc = -1;
+            }
+            else
+            {
+              ON_ERROR("ON_BinaryArchive::Read3dmObject() - missing TCODE_OPENNURBS_CLASS chunk.");
+              rc = -1;
+            }
+          }
+          else if ( 1 == rc )
           {
             switch(ReadObject(ppObject))
             {
@@ -15865,9 +16286,15 @@ int ON_BinaryArchive::Read3dmObject(
     }
   }
 
-  if ( 1 == rc 
-    && nullptr != ppObject
-    && nullptr != *ppObject
+  return rc;
+}
+
+void ON_BinaryArchive::Internal_Read3dmObjectFinish(
+  ON_Object** ppObject,
+  ON_3dmObjectAttributes* pAttributes
+  )
+{
+  if ( (nullptr == ppObject || nullptr != *ppObject)
     && nullptr != pAttributes
     )
   {
@@ -15888,7 +16315,7 @@ int ON_BinaryArchive::Read3dmObject(
     // Examples include reading obsolete objects and converting them into their 
     // current counterpart, converting WIP objects into a proxy for a commercial build, 
     // and converting a proxy object into a WIP object for a WIP build.
-    ON_Object* updated_object = Internal_ConvertObject(*ppObject, pAttributes);
+    ON_Object* updated_object = (nullptr != ppObject) ? Internal_ConvertObject(*ppObject, pAttributes) : nullptr;
 
     if (nullptr != updated_object && updated_object != *ppObject)
     {
@@ -15903,8 +16330,6 @@ int ON_BinaryArchive::Read3dmObject(
       pAttributes->m_name
       );
   }
-
-  return rc;
 }
 
 bool ON_BinaryArchive::EndRead3dmObjectTable()
@@ -16727,6 +17152,54 @@ bool ON_BinaryArchive::ReadByte(size_t count, void* p)
   return (count == Read(count, p));
 }
 
+const void* ON_BinaryArchive::ReadInPlace( size_t count )
+{
+  if ( !ReadMode() )
+  {
+    Internal_ReportCriticalError();
+    ON_ERROR("ReadMode() is false.");
+    return nullptr;
+  }
+
+  if ( 0 == count )
+    return nullptr;
+
+  if (m_bChunkBoundaryCheck)
+  {
+    const ON_3DM_BIG_CHUNK* c = m_chunk.Last();
+    if (nullptr != c)
+    {
+      const ON__UINT64 current_pos = CurrentPosition();
+      const ON__UINT64 new_pos = current_pos + ((ON__UINT64)count);
+      if (current_pos < c->m_start_offset)
+      {
+        ON_ERROR("Attempt to read before the start of current chunk.");
+        return nullptr;
+      }
+      if ( new_pos > c->m_end_offset )
+      {
+        ON_ERROR("Attempt to read beyond end of current chunk.");
+        return nullptr;
+      }
+    }
+  }
+
+  const void* p = Internal_ReadInPlaceOverride(count);
+  if (nullptr != p)
+  {
+    UpdateCRC(count, p);
+    Internal_IncrementCurrentPosition((ON__UINT64)count);
+  }
+
+  return p;
+}
+
+const void* ON_BinaryArchive::Internal_ReadInPlaceOverride( size_t )
+{
+  // Only memory resident archives support reading in place.
+  return nullptr;
+}
+
 size_t ON_BinaryArchive::Write( size_t count, const void* p )
 {
   size_t writecount = 0;
@@ -17078,6 +17551,219 @@ bool ON_BinaryFile::Internal_SeekToStartOverride()
   return rc;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// ON_BinaryMappedFile
+//
+
+ON_BinaryMappedFile::ON_BinaryMappedFile( ON::archive_mode archive_mode, FILE* fp )
+  : ON_BinaryArchive( archive_mode )
+{
+  if ( ReadMode() && nullptr != fp )
+    Internal_MapFile(fp);
+  else
+  {
+    ON_ERROR("Invalid parameters");
+  }
+}
+
+ON_BinaryMappedFile::ON_BinaryMappedFile( ON::archive_mode archive_mode, const char* file_system_path )
+  : ON_BinaryArchive( archive_mode )
+{
+  FILE* fp = ReadMode() ? ON::OpenFile(file_system_path,"rb") : nullptr;
+  if ( nullptr != fp )
+  {
+    Internal_MapFile(fp);
+    ON::CloseFile(fp);
+  }
+  else
+  {
+    ON_ERROR("Invalid parameters");
+  }
+}
+
+ON_BinaryMappedFile::ON_BinaryMappedFile( ON::archive_mode archive_mode, const wchar_t* file_system_path )
+  : ON_BinaryArchive( archive_mode )
+{
+  FILE* fp = ReadMode() ? ON::OpenFile(file_system_path,L"rb") : nullptr;
+  if ( nullptr != fp )
+  {
+    Internal_MapFile(fp);
+    ON::CloseFile(fp);
+  }
+  else
+  {
+    ON_ERROR("Invalid parameters");
+  }
+}
+
+ON_BinaryMappedFile::~ON_BinaryMappedFile()
+{
+  UnmapFile();
+}
+
+bool ON_BinaryMappedFile::Internal_MapFile( FILE* fp )
+{
+  UnmapFile();
+
+  ON__UINT64 file_size = 0;
+  if ( false == ON_FileStream::GetFileInformation(fp, &file_size, nullptr, nullptr) )
+  {
+    ON_ERROR("ON_FileStream::GetFileInformation() failed.");
+    return false;
+  }
+
+  if ( 0 == file_size )
+  {
+    // Nothing to map. Reading will fail with the usual end of file errors.
+    return true;
+  }
+
+  if ( file_size != (ON__UINT64)((size_t)file_size) )
+  {
+    ON_ERROR("File is too large to map into the address space of this process.");
+    return false;
+  }
+
+  const void* view = nullptr;
+
+#if defined(ON_RUNTIME_WIN)
+  HANDLE hFile = (HANDLE)_get_osfhandle(_fileno(fp));
+  if ( INVALID_HANDLE_VALUE != hFile )
+  {
+    HANDLE hMapping = ::CreateFileMapping(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if ( nullptr != hMapping )
+    {
+      view = ::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, (size_t)file_size);
+      // The view keeps a reference to the mapping object.
+      ::CloseHandle(hMapping);
+    }
+  }
+#else
+  void* p = mmap(nullptr, (size_t)file_size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+  if ( MAP_FAILED != p )
+  {
+    // Archives are read front to back.
+    madvise(p, (size_t)file_size, MADV_SEQUENTIAL);
+    view = p;
+  }
+#endif
+
+  if ( nullptr == view )
+  {
+    ON_ERROR("Unable to map file.");
+    return false;
+  }
+
+  m_view = (const unsigned char*)view;
+  m_sizeof_view = file_size;
+  m_view_position = 0;
+  return true;
+}
+
+bool ON_BinaryMappedFile::FileIsMapped() const
+{
+  return (nullptr != m_view);
+}
+
+ON__UINT64 ON_BinaryMappedFile::SizeOfFile() const
+{
+  return m_sizeof_view;
+}
+
+void ON_BinaryMappedFile::UnmapFile()
+{
+  const void* view = m_view;
+  const ON__UINT64 sizeof_view = m_sizeof_view;
+  m_view = nullptr;
+  m_sizeof_view = 0;
+  m_view_position = 0;
+  if ( nullptr != view )
+  {
+#if defined(ON_RUNTIME_WIN)
+    ::UnmapViewOfFile(view);
+#else
+    munmap(const_cast<void*>(view), (size_t)sizeof_view);
+#endif
+  }
+}
+
+ON__UINT64 ON_BinaryMappedFile::Internal_CurrentPositionOverride() const
+{
+  return m_view_position;
+}
+
+bool ON_BinaryMappedFile::Internal_SeekFromCurrentPositionOverride( int offset )
+{
+  bool rc = false;
+  if ( nullptr != m_view )
+  {
+    if ( offset >= 0 )
+    {
+      m_view_position += (ON__UINT64)offset;
+      rc = true;
+    }
+    else if ( (ON__UINT64)(-((ON__INT64)offset)) <= m_view_position )
+    {
+      m_view_position -= (ON__UINT64)(-((ON__INT64)offset));
+      rc = true;
+    }
+  }
+  return rc;
+}
+
+bool ON_BinaryMappedFile::Internal_SeekToStartOverride()
+{
+  if ( nullptr == m_view )
+    return false;
+  m_view_position = 0;
+  return true;
+}
+
+bool ON_BinaryMappedFile::AtEnd() const
+{
+  return (m_view_position >= m_sizeof_view);
+}
+
+size_t ON_BinaryMappedFile::Internal_ReadOverride( size_t count, void* p )
+{
+  if ( 0 == count || nullptr == p )
+    return 0;
+
+  const ON__UINT64 maxcount = (m_sizeof_view > m_view_position) ? (m_sizeof_view - m_view_position) : 0;
+  if ( (ON__UINT64)count > maxcount )
+    count = (size_t)maxcount;
+
+  if ( count > 0 )
+  {
+    memcpy(p, m_view + m_view_position, count);
+    m_view_position += count;
+  }
+
+  return count;
+}
+
+const void* ON_BinaryMappedFile::Internal_ReadInPlaceOverride( size_t count )
+{
+  if ( nullptr == m_view || m_view_position > m_sizeof_view || (ON__UINT64)count > m_sizeof_view - m_view_position )
+    return nullptr;
+  const void* p = m_view + m_view_position;
+  m_view_position += count;
+  return p;
+}
+
+size_t ON_BinaryMappedFile::Internal_WriteOverride( size_t, const void* )
+{
+  // ON_BinaryMappedFile does not support Write() and Flush()
+  return 0;
+}
+
+bool ON_BinaryMappedFile::Flush()
+{
+  // ON_BinaryMappedFile does not support Write() and Flush()
+  return false;
+}
+
 ON_3dmGoo::ON_3dmGoo()
         : m_typecode(0),
           m_value(0),
@@ -18388,6 +19074,15 @@ size_t ON_Read3dmBufferArchive::Internal_ReadOverride( size_t count, void* buffe
   return count;
 }
 
+const void* ON_Read3dmBufferArchive::Internal_ReadInPlaceOverride( size_t count )
+{
+  if ( nullptr == m_buffer || m_buffer_position > m_sizeof_buffer || count > m_sizeof_buffer - m_buffer_position )
+    return nullptr;
+  const void* p = m_buffer + m_buffer_position;
+  m_buffer_position += count;
+  return p;
+}
+
 size_t ON_Read3dmBufferArchive::Internal_WriteOverride( size_t, const void* )
 {
   // ON_Read3dmBufferArchive does not support Write() and Flush()
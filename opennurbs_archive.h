@@ -2022,6 +2022,24 @@ public:
   */
   ON__UINT64 ReadBuffer( ON__UINT64 sizeof_buffer, void* buffer );
 
+  /*
+  Description:
+    Expert user function to access the next count bytes of a memory resident
+    archive without copying them.
+  Parameters:
+    count - [in] number of bytes to read.
+  Returns:
+    If the archive is memory resident (ON_BinaryMappedFile, ON_Read3dmBufferArchive),
+    a pointer to the bytes at the current position is returned, the current position
+    is advanced by count and the bytes are included in the chunk CRC calculation.
+    Otherwise nullptr is returned and the current position is not changed.
+    Callers should fall back to ReadByte() when nullptr is returned.
+  Remarks:
+    The returned pointer is valid until the archive is destroyed.
+    3dm files are always saved with little endian byte order.
+  */
+  const void* ReadInPlace( size_t count );
+
   /*
   Description:
     Expert user function to control CRC calculation while reading and writing.
@@ -2104,6 +2122,9 @@ public:
   Remarks:
     Write your archive write/read code as if compression is always enabled.
     Do not vary what get written or read based on the value of UseBufferCompression().
+    When ThreadCount() > 1, large buffers are split into blocks that are
+    deflated concurrently. The blocks are written as a single zlib stream,
+    so the information is read by ReadCompressedBuffer() as usual.
   */
   bool WriteCompressedBuffer(
     size_t sizeof__inbuffer,
@@ -2944,6 +2965,87 @@ public:
   */
   bool UseBufferCompression() const;
 
+  /*
+  Description:
+    Specify the codec used to compress buffers when UseBufferCompression()
+    is true.
+  Parameters:
+    codec - [in]
+      ON_CompressionCodec::Zlib: (default) 
+        Buffers are compressed with zlib and can be read by every version
+        of opennurbs.
+      ON_CompressionCodec::LZ4: 
+        Buffers are compressed with the LZ4 block format. Reading is much
+        faster and the archive is larger. Earlier versions of opennurbs
+        cannot read these buffers.
+      ON_CompressionCodec::None:
+        Same as SetUseBufferCompression(false).
+  Remarks:
+    The codec is saved with each compressed buffer and detected by
+    ReadCompressedBuffer().
+  */
+  void SetCompressionCodec(
+    ON_CompressionCodec codec
+  );
+
+  /*
+  Returns:
+    Codec used to compress buffers when UseBufferCompression() is true.
+  */
+  ON_CompressionCodec CompressionCodec() const;
+
+  /*
+  Description:
+    Specify the maximum number of threads the archive may use for
+    work that can be done concurrently, like decoding the object table
+    in Read3dmModelGeometryTableForExperts() and compressing large
+    buffers in WriteCompressedBuffer().
+  Parameters:
+    thread_count - [in]
+      0: use one thread for each processor core.
+      1: (default) everything is done on the calling thread.
+      >1: at most thread_count threads are used.
+  */
+  void SetThreadCount(
+    unsigned int thread_count
+  );
+
+  /*
+  Returns:
+    Maximum number of threads the archive may use. 
+    A value of 0 is converted to the number of processor cores.
+  */
+  unsigned int ThreadCount() const;
+
+  /*
+  Description:
+    Specify if reading model geometry is deferred until the geometry
+    is needed.
+  Parameters:
+    bDeferGeometryReading - [in]
+      false: (default) 
+        Geometry is read when the object table is read.
+      true:
+        Read3dmModelGeometryTableForExperts() reads the attributes of 
+        curves, surfaces, breps, extrusions, meshes, point clouds and SubDs,
+        but not their geometry. The encoded geometry is saved on the
+        ON_ModelGeometryComponent and read the first time
+        ON_ModelGeometryComponent::Geometry() is called.
+  See Also:
+    ON_ModelGeometryComponent::GeometryIsDeferred()
+  */
+  void SetDeferGeometryReading(
+    bool bDeferGeometryReading
+  );
+
+  /*
+  Returns:
+    True if reading model geometry is deferred.
+  See Also:
+    ON_BinaryArchive::SetDeferGeometryReading()
+  */
+  bool DeferGeometryReading() const;
+
 
   /*
   Description:
@@ -3720,7 +3822,115 @@ public:
     unsigned int object_filter = 0
     );
 
+  /*
+  Description:
+    Read the remaining objects in the object table. When ThreadCount() > 1,
+    curves, surfaces, breps, extrusions, meshes, point clouds and SubDs are
+    decoded concurrently. Objects whose reading depends on the state of
+    the archive (annotation, instance references, ...) are read on the 
+    calling thread.
+    Call after BeginRead3dmObjectTable() and before EndRead3dmObjectTable().
+  Parameters:
+    bManageGeometry - [in]
+    bManageAttributes - [in]
+      Same as Read3dmModelGeometryForExperts().
+    object_filter - [in]
+      optional filter made by setting ON::object_type bits
+      0 = no filter.
+    model_geometry_list - [out]
+      The ON_ModelGeometryComponent for each object that was read is appended
+      in the order it appears in the archive. The archive manifest is updated
+      in the same order. The caller is responsible for deleting the 
+      ON_ModelGeometryComponent pointers.
+  Returns:
+    True if the end of the object table was reached and no object was corrupt.
+  Remarks:
+    When ThreadCount() <= 1, when reading version 1 archives, or when 
+    some user data is filtered, every object is read on the calling thread.
+    When DeferGeometryReading() is true, the geometry of the objects that
+    can be decoded concurrently is not read. See SetDeferGeometryReading().
+  */
+  bool Read3dmModelGeometryTableForExperts(
+    bool bManageGeometry,
+    bool bManageAttributes,
+    unsigned int object_filter,
+    ON_SimpleArray<class ON_ModelGeometryComponent*>& model_geometry_list
+    );
+
+  /*
+  Description:
+    Expert user function used by ON_ModelGeometryComponent to read
+    geometry whose reading was deferred.
+  Parameters:
+    archive_3dm_version - [in]
+    archive_opennurbs_version - [in]
+      Version of the archive the object was saved in.
+    manifest_map - [in]
+      A copy of the archive's ManifestMap() made when the object table 
+      was read, or nullptr if the archive did not map referenced components.
+      Component indices and ids the object references are mapped with it.
+    sizeof_buffer - [in]
+    buffer - [in]
+      The TCODE_OPENNURBS_CLASS chunk that contains the object.
+  Returns:
+    The object read from the buffer, or nullptr if the buffer is corrupt.
+    The caller must delete the returned object.
+  */
+  static ON_Object* Read3dmDeferredObjectForExperts(
+    int archive_3dm_version,
+    unsigned int archive_opennurbs_version,
+    const class ON_ManifestMap* manifest_map,
+    size_t sizeof_buffer,
+    const void* buffer
+    );
+
 private:
+  /*
+  Description:
+    Read a version 2 or later TCODE_OBJECT_RECORD chunk without 
+    updating the manifest.
+  Parameters:
+    deferred_object_offset - [out]
+    sizeof_deferred_object - [out]
+      If both are not nullptr, the TCODE_OPENNURBS_CLASS chunk is skipped,
+      *model_object is not set and the offset and size of the chunk
+      are returned.
+  */
+  int Internal_Read3dmObjectRecord(
+    ON_Object** model_object,
+    ON_3dmObjectAttributes* attributes,
+    unsigned int object_filter,
+    bool bIncrementTableItemCount,
+    ON__UINT64* deferred_object_offset,
+    ON__UINT64* sizeof_deferred_object
+  );
+
+  /*
+  Description:
+    Prepare a temporary archive that contains a record copied from 
+    the object table of another archive.
+  Parameters:
+    source_manifest_map - [in]
+      The ManifestMap() of the archive the record was copied from, or
+      nullptr if that archive does not map referenced components.
+      Referenced component indices and ids are mapped with this map. 
+      The map must not be modified while this archive is reading.
+  */
+  void Internal_SetSourceManifestMap(
+    const class ON_ManifestMap* source_manifest_map
+  );
+
+  /*
+  Description:
+    Fix missing and duplicate object ids, convert obsolete objects
+    and update the manifest after an object record is read.
+    model_object is nullptr when reading the object was deferred.
+  */
+  void Internal_Read3dmObjectFinish(
+    ON_Object** model_object,
+    ON_3dmObjectAttributes* attributes
+  );
+
   /*
   Description:
     In rare cases one object must be converted into another.
@@ -4393,7 +4603,18 @@ protected:
     Call MaskReadError( ON__UINT64 sizeof_request, ON__UINT64 sizeof_read )
     before calling ON_ERROR().
   */
-  virtual size_t Internal_ReadOverride( size_t, void* ) = 0; 
+  virtual size_t Internal_ReadOverride( size_t, void* ) = 0;
+
+  /*
+  Description:
+    Archives that keep their entire contents in memory override this
+    function to support ReadInPlace().
+  Returns:
+    A pointer to the next count bytes and the archive's internal position
+    is advanced by count, or nullptr if in place reading is not supported.
+    The default implementation returns nullptr.
+  */
+  virtual const void* Internal_ReadInPlaceOverride( size_t count );
 
 private:
   /*
@@ -4834,12 +5055,22 @@ private:
         size_t,         // sizeof uncompressed input data
         const void*  // uncompressed input data
         );
+  // returns number of bytes written
+  // Deflates blocks of the input concurrently and writes a single zlib stream.
+  size_t WriteDeflateConcurrent(
+        size_t,         // sizeof uncompressed input data
+        const void*  // uncompressed input data
+        );
   bool ReadInflate(
         size_t,  // sizeof uncompressed input data
         void* // buffer to hold uncompressed data
         );
   bool CompressionInit();
   void CompressionEnd();
+  bool ReadLZ4(
+        size_t,  // sizeof uncompressed data
+        void* // buffer to hold uncompressed data
+        );
 
 private:
   // endian-ness of the cpu reading this file.
@@ -4877,6 +5108,15 @@ private:
 
   bool m_bUseBufferCompression = true;
 
+  // 3dm write option - see SetCompressionCodec()
+  ON_CompressionCodec m_compression_codec = ON_CompressionCodec::Zlib;
+
+  // 3dm read/write option - see SetThreadCount()
+  unsigned int m_thread_count = 1;
+
+  // 3dm read option - see SetDeferGeometryReading()
+  bool m_bDeferGeometryReading = false;
+
   bool m_bReservedA = false;
   bool m_bReservedB = false;
   bool m_bReservedC = false;
@@ -5193,6 +5433,13 @@ private:
   ON_ComponentManifest m_manifest;
   ON_ManifestMap m_manifest_map;
 
+  // Reading:
+  //   When m_source_manifest_map is not nullptr, this archive is a temporary
+  //   archive that contains a record copied from an object table and 
+  //   ManifestMap() returns the map of the archive the record was copied from.
+  //   See Internal_SetSourceManifestMap().
+  const ON_ManifestMap* m_source_manifest_map = nullptr;
+
   // True: (default state)
   //  Read3dmReferencedComponentIndex() and Write3dmReferencedComponentIndex() will automatically
   //  adjust component index references so they are valid.
@@ -5502,6 +5749,118 @@ private:
   ON_BinaryFile& operator=(const ON_BinaryFile&) = delete;
 };
 
+/*
+Description:
+  ON_BinaryMappedFile reads an ordinary file by mapping the entire file
+  into the address space of the process.
+Remarks:
+  Reading from a mapped file avoids the stdio buffering and the per call 
+  overhead of fread(). Reads are a single memcpy() from the mapped pages,
+  seeking (and skipping chunks) is pointer arithmetic, and ReadInPlace()
+  and ReadCompressedBuffer() use the mapped bytes directly.
+  ON_BinaryMappedFile only supports ON::archive_mode::read and 
+  ON::archive_mode::read3dm.
+*/
+class ON_CLASS ON_BinaryMappedFile : public ON_BinaryArchive
+{
+public:
+  /*
+  Description:
+    Create an ON_BinaryArchive that reads from a memory mapped file.
+  Parameters:
+    archive_mode - [in]
+      ON::archive_mode::read or ON::archive_mode::read3dm.
+    fp - [in]
+      pointer returned from ON_FileStream::Open(...,"rb").
+      The caller is responsible for closing fp. The file is mapped
+      when the ON_BinaryMappedFile is constructed and fp may be 
+      closed any time after that.
+  */
+  ON_BinaryMappedFile(
+    ON::archive_mode archive_mode,
+    FILE* fp
+    );
+
+  /*
+  Description:
+    Create an ON_BinaryArchive that reads from a memory mapped file.
+  Parameters:
+    archive_mode - [in]
+      ON::archive_mode::read or ON::archive_mode::read3dm.
+    file_system_path - [in]
+      path to file being read.
+  */
+  ON_BinaryMappedFile(
+    ON::archive_mode archive_mode,
+    const wchar_t* file_system_path
+    );
+
+  /*
+  Description:
+    Create an ON_BinaryArchive that reads from a memory mapped file.
+  Parameters:
+    archive_mode - [in]
+      ON::archive_mode::read or ON::archive_mode::read3dm.
+    file_system_path - [in]
+      path to file being read.
+  */
+  ON_BinaryMappedFile(
+    ON::archive_mode archive_mode,
+    const char* file_system_path
+    );
+
+  ~ON_BinaryMappedFile();
+
+  /*
+  Returns:
+    True if the file is mapped.
+  */
+  bool FileIsMapped() const;
+
+  /*
+  Returns:
+    Size of the mapped file in bytes.
+  */
+  ON__UINT64 SizeOfFile() const;
+
+  /*
+  Description:
+    Unmap the file. Any pointers returned by ReadInPlace() are invalid
+    after this call.
+  */
+  void UnmapFile();
+
+protected:
+  // ON_BinaryArchive overrides
+  ON__UINT64 Internal_CurrentPositionOverride() const override;
+  bool Internal_SeekFromCurrentPositionOverride(int byte_offset) override;
+  bool Internal_SeekToStartOverride() override;
+
+public:
+  // ON_BinaryArchive overrides
+  bool AtEnd() const override;
+
+protected:
+  // ON_BinaryArchive overrides
+  size_t Internal_ReadOverride( size_t, void* ) override; // return actual number of bytes read (like fread())
+  const void* Internal_ReadInPlaceOverride( size_t ) override;
+  size_t Internal_WriteOverride( size_t, const void* ) override;
+  bool Flush() override;
+
+private:
+  bool Internal_MapFile(FILE* fp);
+
+  const unsigned char* m_view = nullptr;
+  ON__UINT64 m_sizeof_view = 0;
+  ON__UINT64 m_view_position = 0;
+
+private:
+  // prohibit default construction, copy construction, and operator=
+  ON_BinaryMappedFile() = delete;
+  ON_BinaryMappedFile(const ON_BinaryMappedFile&) = delete;
+  ON_BinaryMappedFile& operator=(const ON_BinaryMappedFile&) = delete;
+};
+
 class ON_CLASS ON_BinaryArchiveBuffer : public ON_BinaryArchive
 {
 public:
@@ -5623,6 +5982,7 @@ public:
 protected:
   // ON_BinaryArchive overrides
   size_t Internal_ReadOverride( size_t, void* ) override; // return actual number of bytes read (like fread())
+  const void* Internal_ReadInPlaceOverride( size_t ) override;
   size_t Internal_WriteOverride( size_t, const void* ) override;
   bool Flush() override;
 
@@ -23,11 +23,499 @@
 
 #pragma ON_PRAGMA_WARNING_PUSH
 #include <vector>
+#include <algorithm>
 #pragma ON_PRAGMA_WARNING_POP
 
 
 
 
+////////////////////////////////////////////////////////////////////////
+//
+// Tight bounding boxes of bezier curves and surfaces.
+//
+// The control points are converted to homogeneous (x,y,z,w) and
+// transformed. For each coordinate, the extremes of a bezier curve are
+// at the ends or at parameters where the numerator of the derivative,
+// x'(t)w(t) - x(t)w'(t), changes sign. The numerator is a polynomial in
+// Bernstein form and its sign changes are isolated by subdivision. The
+// interior extremes of a bezier surface are found by branch and bound on
+// sub-patches. When a coordinate's control point hull is already inside
+// the box, no work is done for it.
+//
+
+// Largest bezier order handled by the tight box code. Higher orders use
+// the control point hull.
+#define ON_TIGHT_BBOX_MAX_ORDER 24
+#define ON_TIGHT_BBOX_MAX_DEGREE (2*ON_TIGHT_BBOX_MAX_ORDER-2)
+
+static bool ON_Internal_GetHomogeneousCVs(
+  int dim, bool is_rat,
+  int order0, int order1,
+  int cv_stride0, int cv_stride1,
+  const double* cv,
+  const ON_Xform* xform,
+  double* H // order0*order1*4 doubles, H[(i*order1+j)*4]
+  )
+{
+  // Returns true if every weight is positive.
+  bool rc = true;
+  for ( int i = 0; i < order0; i++ )
+  {
+    for ( int j = 0; j < order1; j++, H += 4 )
+    {
+      const double* p = cv + i*cv_stride0 + j*cv_stride1;
+      const double x = (dim > 0) ? p[0] : 0.0;
+      const double y = (dim > 1) ? p[1] : 0.0;
+      const double z = (dim > 2) ? p[2] : 0.0;
+      const double w = is_rat ? p[dim] : 1.0;
+      if ( nullptr != xform )
+      {
+        const double (*m)[4] = xform->m_xform;
+        H[0] = m[0][0]*x + m[0][1]*y + m[0][2]*z + m[0][3]*w;
+        H[1] = m[1][0]*x + m[1][1]*y + m[1][2]*z + m[1][3]*w;
+        H[2] = m[2][0]*x + m[2][1]*y + m[2][2]*z + m[2][3]*w;
+        H[3] = m[3][0]*x + m[3][1]*y + m[3][2]*z + m[3][3]*w;
+      }
+      else
+      {
+        H[0] = x; H[1] = y; H[2] = z; H[3] = w;
+      }
+      if ( !(H[3] > 0.0) )
+        rc = false;
+    }
+  }
+  return rc;
+}
+
+static void ON_Internal_GrowTightBox(const double* H, double box[6])
+{
+  const double w = 1.0/H[3];
+  for ( int j = 0; j < 3; j++ )
+  {
+    const double x = w*H[j];
+    if ( x < box[j] )
+      box[j] = x;
+    if ( x > box[3+j] )
+      box[3+j] = x;
+  }
+}
+
+static int ON_Internal_BernsteinSignChanges(int degree, const double* b)
+{
+  // Coefficients that are tiny compared to the largest one are
+  // treated as zero so round off does not create sign changes.
+  double m = 0.0;
+  for ( int i = 0; i <= degree; i++ )
+  {
+    if ( fabs(b[i]) > m )
+      m = fabs(b[i]);
+  }
+  const double z = 1.0e-14*m;
+  int changes = 0;
+  int s0 = 0;
+  for ( int i = 0; i <= degree; i++ )
+  {
+    const int s = (b[i] > z) ? 1 : ((b[i] < -z) ? -1 : 0);
+    if ( 0 != s )
+    {
+      if ( 0 != s0 && s != s0 )
+        changes++;
+      s0 = s;
+    }
+  }
+  return changes;
+}
+
+static double ON_Internal_BernsteinValue(int degree, const double* b, double t)
+{
+  double tmp[ON_TIGHT_BBOX_MAX_DEGREE+1];
+  const double s = 1.0 - t;
+  memcpy(tmp, b, (degree+1)*sizeof(tmp[0]));
+  for ( int k = 1; k <= degree; k++ )
+  {
+    for ( int i = 0; i <= degree-k; i++ )
+      tmp[i] = s*tmp[i] + t*tmp[i+1];
+  }
+  return tmp[0];
+}
+
+// Split a Bernstein polynomial at t = 1/2. The coefficients are read
+// from and written to strided arrays. left and right can be the same
+// array as b.
+static void ON_Internal_BernsteinSplit(
+  int degree,
+  const double* b, int b_stride,
+  double* left, double* right, int lr_stride
+  )
+{
+  if ( degree < 0 || degree > ON_TIGHT_BBOX_MAX_DEGREE )
+    return;
+  double tmp[ON_TIGHT_BBOX_MAX_DEGREE+1];
+  for ( int i = 0; i <= degree; i++ )
+    tmp[i] = b[i*b_stride];
+  left[0] = b[0];
+  right[degree*lr_stride] = b[degree*b_stride];
+  for ( int k = 1; k <= degree; k++ )
+  {
+    for ( int i = 0; i <= degree-k; i++ )
+      tmp[i] = 0.5*(tmp[i] + tmp[i+1]);
+    left[k*lr_stride] = tmp[0];
+    right[(degree-k)*lr_stride] = tmp[degree-k];
+  }
+}
+
+// Find the parameters in (t0,t1) where the polynomial changes sign.
+static void ON_Internal_BernsteinRoots(
+  int degree, const double* b,
+  double t0, double t1,
+  int depth,
+  double* roots, int& root_count, int root_capacity
+  )
+{
+  if ( root_count >= root_capacity )
+    return;
+
+  const int changes = ON_Internal_BernsteinSignChanges(degree, b);
+  if ( 0 == changes )
+    return;
+
+  if ( 1 == changes && ((b[0] < 0.0 && b[degree] > 0.0) || (b[0] > 0.0 && b[degree] < 0.0)) )
+  {
+    // Exactly one root. Use regula falsi with the Illinois modification.
+    double u0 = 0.0, u1 = 1.0, f0 = b[0], f1 = b[degree];
+    int side = 0;
+    for ( int i = 0; i < 100 && u1 - u0 > 1.0e-15; i++ )
+    {
+      double u = (f0*u1 - f1*u0)/(f0 - f1);
+      if ( !(u > u0 && u < u1) )
+        u = 0.5*(u0 + u1);
+      const double f = ON_Internal_BernsteinValue(degree, b, u);
+      if ( 0.0 == f )
+      {
+        u0 = u1 = u;
+        break;
+      }
+      if ( (f < 0.0) == (f0 < 0.0) )
+      {
+        u0 = u; f0 = f;
+        if ( -1 == side )
+          f1 *= 0.5;
+        side = -1;
+      }
+      else
+      {
+        u1 = u; f1 = f;
+        if ( 1 == side )
+          f0 *= 0.5;
+        side = 1;
+      }
+    }
+    roots[root_count++] = t0 + 0.5*(u0 + u1)*(t1 - t0);
+    return;
+  }
+
+  const double tm = 0.5*(t0 + t1);
+  if ( depth >= 40 || !(t0 < tm && tm < t1) )
+  {
+    // Roots are too close to separate. The parameter is a point on the
+    // curve, so it is always safe to add it.
+    roots[root_count++] = tm;
+    return;
+  }
+
+  double left[ON_TIGHT_BBOX_MAX_DEGREE+1];
+  double right[ON_TIGHT_BBOX_MAX_DEGREE+1];
+  ON_Internal_BernsteinSplit(degree, b, 1, left, right, 1);
+  ON_Internal_BernsteinRoots(degree, left, t0, tm, depth+1, roots, root_count, root_capacity);
+  ON_Internal_BernsteinRoots(degree, right, tm, t1, depth+1, roots, root_count, root_capacity);
+}
+
+/*
+Description:
+  Grow box[] to include a bezier curve.
+Parameters:
+  order - [in] 2 <= order <= ON_TIGHT_BBOX_MAX_ORDER
+  H - [in] homogeneous control points with positive weights
+  H_stride - [in] doubles between control points
+  box - [in/out] (xmin,ymin,zmin,xmax,ymax,zmax)
+*/
+static void ON_Internal_BezierCurveTightBox(int order, const double* H, int H_stride, double box[6])
+{
+  const int degree = order - 1;
+  bool bRational = false;
+  for ( int i = 0; i < order; i++ )
+  {
+    if ( 1.0 != H[i*H_stride+3] )
+    {
+      bRational = true;
+      break;
+    }
+  }
+
+  ON_Internal_GrowTightBox(H, box);
+  ON_Internal_GrowTightBox(H + degree*H_stride, box);
+  if ( degree < 2 && !bRational )
+    return; // lines
+
+  double binomial[3][ON_TIGHT_BBOX_MAX_DEGREE+1];
+  bool bHaveBinomial = false;
+
+  for ( int j = 0; j < 3; j++ )
+  {
+    // When the hull of the control points is in the box, the curve is too.
+    bool bInside = true;
+    for ( int i = 1; i < degree && bInside; i++ )
+    {
+      const double x = H[i*H_stride+j]/H[i*H_stride+3];
+      if ( x < box[j] || x > box[3+j] )
+        bInside = false;
+    }
+    if ( bInside )
+      continue;
+
+    // Bernstein coefficients of the numerator of the derivative
+    double N[ON_TIGHT_BBOX_MAX_DEGREE+1];
+    int N_degree;
+    if ( bRational )
+    {
+      // x'w - xw' has degree 2*degree-1 when the product is written in
+      // Bernstein form without reducing the degree.
+      if ( !bHaveBinomial )
+      {
+        const int n[3] = { degree-1, degree, 2*degree-1 };
+        for ( int r = 0; r < 3; r++ )
+        {
+          binomial[r][0] = 1.0;
+          for ( int k = 1; k <= n[r]; k++ )
+            binomial[r][k] = binomial[r][k-1]*(n[r]-k+1)/k;
+        }
+        bHaveBinomial = true;
+      }
+      N_degree = 2*degree-1;
+      for ( int k = 0; k <= N_degree; k++ )
+      {
+        double s = 0.0;
+        const int i0 = (k > degree) ? (k - degree) : 0;
+        const int i1 = (k < degree-1) ? k : (degree-1);
+        for ( int i = i0; i <= i1; i++ )
+        {
+          const double* P0 = H + i*H_stride;
+          const double* P1 = P0 + H_stride;
+          const double* Q = H + (k-i)*H_stride;
+          s += binomial[0][i]*binomial[1][k-i]*((P1[j]-P0[j])*Q[3] - (P1[3]-P0[3])*Q[j]);
+        }
+        N[k] = s/binomial[2][k];
+      }
+    }
+    else
+    {
+      N_degree = degree-1;
+      for ( int i = 0; i < degree; i++ )
+        N[i] = H[(i+1)*H_stride+j] - H[i*H_stride+j];
+    }
+
+    double roots[ON_TIGHT_BBOX_MAX_DEGREE+1];
+    int root_count = 0;
+    ON_Internal_BernsteinRoots(N_degree, N, 0.0, 1.0, 0, roots, root_count, ON_TIGHT_BBOX_MAX_DEGREE);
+
+    for ( int r = 0; r < root_count; r++ )
+    {
+      // evaluate coordinate j at the root
+      double X[ON_TIGHT_BBOX_MAX_ORDER], W[ON_TIGHT_BBOX_MAX_ORDER];
+      for ( int i = 0; i < order; i++ )
+      {
+        X[i] = H[i*H_stride+j];
+        W[i] = H[i*H_stride+3];
+      }
+      const double t = roots[r];
+      const double x = ON_Internal_BernsteinValue(degree, X, t)/ON_Internal_BernsteinValue(degree, W, t);
+      if ( x < box[j] )
+        box[j] = x;
+      if ( x > box[3+j] )
+        box[3+j] = x;
+    }
+  }
+}
+
+class ON_Internal_TightBoxPatch
+{
+public:
+  double m_hull; // largest control point coordinate
+  int m_offset;  // offset of the (x,w) control points in the patch buffer
+  int m_depth;
+};
+
+static bool ON_Internal_TightBoxPatchLess(const ON_Internal_TightBoxPatch& a, const ON_Internal_TightBoxPatch& b)
+{
+  return a.m_hull < b.m_hull;
+}
+
+/*
+Description:
+  Grow box[] to include a bezier surface. The box must already include
+  the boundary of the surface. The result contains the surface. It is
+  usually larger than the exact box by at most 1e-10 times the size of
+  the control point hull.
+Parameters:
+  order0, order1 - [in] 2 <= order <= ON_TIGHT_BBOX_MAX_ORDER
+  H - [in] homogeneous control points with positive weights
+  box - [in/out] (xmin,ymin,zmin,xmax,ymax,zmax)
+Remarks:
+  The sub-patch with the largest hull is split first. When an extreme
+  is reached along a curve in the interior, like the ridge of 
+  -(u^2 - u + v^2 - v + 0.4)^2, every sub-patch along the curve must be
+  split. After 4096 splits for one side of one coordinate, the largest 
+  hull of the sub-patches that are left is used and the box is looser.
+*/
+static void ON_Internal_BezierSurfaceInteriorTightBox(int order0, int order1, const double* H, double box[6])
+{
+  const int cv_count = order0*order1;
+  const int patch_size = 2*cv_count; // (x,w) pairs
+  const int corner[4] = { 0, order1-1, (order0-1)*order1, cv_count-1 };
+  ON_SimpleArray<double> patch_buffer;
+  ON_SimpleArray<int> free_offsets;
+  ON_SimpleArray<ON_Internal_TightBoxPatch> queue;
+
+  double hull[6] = { ON_DBL_MAX, ON_DBL_MAX, ON_DBL_MAX, -ON_DBL_MAX, -ON_DBL_MAX, -ON_DBL_MAX };
+  for ( int i = 0; i < cv_count; i++ )
+    ON_Internal_GrowTightBox(H + 4*i, hull);
+
+  const int max_split_count = 4096;
+
+  for ( int j = 0; j < 3; j++ )
+  {
+    // Branch and bound stops when the unexplored sub-patches cannot
+    // improve the box by more than a tiny fraction of the patch size.
+    const double tol = 1.0e-10*(fabs(hull[j]) + fabs(hull[3+j]) + (hull[3+j] - hull[j]));
+
+    // The control points of the sub-patches have round off, so the 
+    // bound is moved out by a few ulps of the coordinate size.
+    const double margin = 64.0*ON_EPSILON*(fabs(hull[j]) + fabs(hull[3+j]));
+
+    for ( int side = 0; side < 2; side++ )
+    {
+      // s*x is maximized
+      const double s = (0 == side) ? -1.0 : 1.0;
+      double best = s*box[3*side+j];
+      if ( s*hull[3*side+j] <= best + tol )
+      {
+        if ( s*hull[3*side+j] > best )
+          box[3*side+j] = hull[3*side+j];
+        continue;
+      }
+
+      // bound = largest hull of a sub-patch that was not split.
+      double bound = -ON_DBL_MAX;
+      int split_count = 0;
+      patch_buffer.SetCount(0);
+      free_offsets.SetCount(0);
+      queue.SetCount(0);
+      patch_buffer.Reserve(16*patch_size);
+      patch_buffer.SetCount(patch_size);
+      double* P = patch_buffer.Array();
+      for ( int i = 0; i < cv_count; i++ )
+      {
+        P[2*i] = s*H[4*i+j];
+        P[2*i+1] = H[4*i+3];
+      }
+      ON_Internal_TightBoxPatch& root = queue.AppendNew();
+      root.m_hull = s*hull[3*side+j];
+      root.m_offset = 0;
+      root.m_depth = 0;
+
+      while ( queue.Count() > 0 )
+      {
+        std::pop_heap(queue.Array(), queue.Array() + queue.Count(), ON_Internal_TightBoxPatchLess);
+        const ON_Internal_TightBoxPatch patch = *queue.Last();
+        queue.Remove();
+        if ( patch.m_hull <= best + tol || patch.m_depth >= 30 || split_count >= max_split_count )
+        {
+          // No sub-patch that is left has a larger hull.
+          if ( patch.m_hull > bound )
+            bound = patch.m_hull;
+          break;
+        }
+
+        // Split into 4 sub-patches. The first goes where P is.
+        split_count++;
+        int offsets[4] = { patch.m_offset, 0, 0, 0 };
+        for ( int q = 1; q < 4; q++ )
+        {
+          if ( free_offsets.Count() > 0 )
+          {
+            offsets[q] = *free_offsets.Last();
+            free_offsets.Remove();
+          }
+          else
+          {
+            offsets[q] = patch_buffer.Count();
+            patch_buffer.Reserve(offsets[q] + patch_size);
+            patch_buffer.SetCount(offsets[q] + patch_size);
+          }
+        }
+        P = patch_buffer.Array() + patch.m_offset;
+        double* Q[4];
+        for ( int q = 0; q < 4; q++ )
+          Q[q] = patch_buffer.Array() + offsets[q];
+        for ( int b = 0; b < order1; b++ )
+        {
+          for ( int c = 0; c < 2; c++ )
+          {
+            // split direction 0 of P into Q[0] and Q[2]
+            ON_Internal_BernsteinSplit(order0-1, P + 2*b + c, 2*order1, Q[0] + 2*b + c, Q[2] + 2*b + c, 2*order1);
+          }
+        }
+        for ( int h = 0; h < 4; h += 2 )
+        {
+          for ( int a = 0; a < order0; a++ )
+          {
+            for ( int c = 0; c < 2; c++ )
+            {
+              // split direction 1 of Q[h] into Q[h] and Q[h+1]
+              double* row = Q[h] + 2*a*order1 + c;
+              ON_Internal_BernsteinSplit(order1-1, row, 2, row, Q[h+1] + 2*a*order1 + c, 2);
+            }
+          }
+        }
+
+        for ( int q = 0; q < 4; q++ )
+        {
+          // Corner control points are on the surface.
+          for ( int c = 0; c < 4; c++ )
+          {
+            const double x = Q[q][2*corner[c]]/Q[q][2*corner[c]+1];
+            if ( x > best )
+              best = x;
+          }
+          double patch_hull = -ON_DBL_MAX;
+          for ( int i = 0; i < cv_count; i++ )
+          {
+            const double x = Q[q][2*i]/Q[q][2*i+1];
+            if ( x > patch_hull )
+              patch_hull = x;
+          }
+          if ( patch_hull <= best + tol )
+          {
+            if ( patch_hull > bound )
+              bound = patch_hull;
+            free_offsets.Append(offsets[q]);
+            continue;
+          }
+          ON_Internal_TightBoxPatch& sub_patch = queue.AppendNew();
+          sub_patch.m_hull = patch_hull;
+          sub_patch.m_offset = offsets[q];
+          sub_patch.m_depth = patch.m_depth+1;
+          std::push_heap(queue.Array(), queue.Array() + queue.Count(), ON_Internal_TightBoxPatchLess);
+        }
+      }
+
+      if ( bound > best )
+        best = bound;
+      box[3*side+j] = s*(best + margin);
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////
 
 bool ON_BezierCurve::GetTightBoundingBox( 
@@ -36,19 +524,42 @@ bool ON_BezierCurve::GetTightBoundingBox(
 		const ON_Xform* xform
     ) const
 {
+  if ( bGrowBox && !tight_bbox.IsValid() )
+    bGrowBox = false;
+  if ( nullptr != xform && xform->IsIdentity() )
+    xform = nullptr;
+
+  double H[4*ON_TIGHT_BBOX_MAX_ORDER];
+  if (    m_order < 2 
+       || m_order > ON_TIGHT_BBOX_MAX_ORDER
+       || m_dim < 1
+       || nullptr == m_cv
+       || !ON_Internal_GetHomogeneousCVs(m_dim, m_is_rat?true:false, m_order, 1, m_cv_stride, 0, m_cv, xform, H)
+     )
+  {
+    // Use the control point hull.
+    return ON_GetPointListBoundingBox(
+      m_dim,
+      m_is_rat, 
+      m_order, 
+      m_cv_stride,
+      m_cv,
+      tight_bbox,
+      bGrowBox,
+      xform 
+      );
+  }
 
-  // The result from ON_GetPointListBoundingBox() is good enough
-  // for file IO needs in the public souce code version.
-  return ON_GetPointListBoundingBox(
-    m_dim,
-    m_is_rat, 
-    m_order, 
-    m_cv_stride,
-    m_cv,
-    tight_bbox,
-    bGrowBox,
-    xform 
-    );
+  double box[6] = { ON_DBL_MAX, ON_DBL_MAX, ON_DBL_MAX, -ON_DBL_MAX, -ON_DBL_MAX, -ON_DBL_MAX };
+  if ( bGrowBox )
+  {
+    box[0] = tight_bbox.m_min.x; box[1] = tight_bbox.m_min.y; box[2] = tight_bbox.m_min.z;
+    box[3] = tight_bbox.m_max.x; box[4] = tight_bbox.m_max.y; box[5] = tight_bbox.m_max.z;
+  }
+  ON_Internal_BezierCurveTightBox(m_order, H, 4, box);
+  tight_bbox.m_min.Set(box[0], box[1], box[2]);
+  tight_bbox.m_max.Set(box[3], box[4], box[5]);
+  return tight_bbox.IsValid();
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -2367,6 +2878,67 @@ bool ON_BezierSurface::GetBoundingBox( // returns true if successful
   return rc;
 }
 
+bool ON_BezierSurface::GetTightBoundingBox( 
+  ON_BoundingBox& tight_bbox, 
+  bool bGrowBox,
+  const ON_Xform* xform
+  ) const
+{
+  if ( bGrowBox && !tight_bbox.IsValid() )
+    bGrowBox = false;
+  if ( nullptr != xform && xform->IsIdentity() )
+    xform = nullptr;
+
+  ON_SimpleArray<double> buffer;
+  double* H = nullptr;
+  if (    m_order[0] >= 2 && m_order[0] <= ON_TIGHT_BBOX_MAX_ORDER
+       && m_order[1] >= 2 && m_order[1] <= ON_TIGHT_BBOX_MAX_ORDER
+       && m_dim >= 1
+       && nullptr != m_cv
+     )
+  {
+    H = buffer.Reserve(4*m_order[0]*m_order[1]);
+    if ( !ON_Internal_GetHomogeneousCVs(m_dim, m_is_rat?true:false, m_order[0], m_order[1], m_cv_stride[0], m_cv_stride[1], m_cv, xform, H) )
+      H = nullptr;
+  }
+
+  if ( nullptr == H )
+  {
+    // Use the control point hull.
+    if ( m_order[0] < 1 || m_order[1] < 1 )
+      return false;
+    for ( int i = 0; i < m_order[0]; i++ )
+    {
+      if ( !ON_GetPointListBoundingBox(m_dim, m_is_rat, m_order[1], m_cv_stride[1], CV(i,0), tight_bbox, bGrowBox, xform) )
+        return false;
+      bGrowBox = true;
+    }
+    return true;
+  }
+
+  double box[6] = { ON_DBL_MAX, ON_DBL_MAX, ON_DBL_MAX, -ON_DBL_MAX, -ON_DBL_MAX, -ON_DBL_MAX };
+  if ( bGrowBox )
+  {
+    box[0] = tight_bbox.m_min.x; box[1] = tight_bbox.m_min.y; box[2] = tight_bbox.m_min.z;
+    box[3] = tight_bbox.m_max.x; box[4] = tight_bbox.m_max.y; box[5] = tight_bbox.m_max.z;
+  }
+
+  // boundary curves
+  const int order0 = m_order[0];
+  const int order1 = m_order[1];
+  ON_Internal_BezierCurveTightBox(order1, H, 4, box);
+  ON_Internal_BezierCurveTightBox(order1, H + 4*(order0-1)*order1, 4, box);
+  ON_Internal_BezierCurveTightBox(order0, H, 4*order1, box);
+  ON_Internal_BezierCurveTightBox(order0, H + 4*(order1-1), 4*order1, box);
+
+  // interior
+  ON_Internal_BezierSurfaceInteriorTightBox(order0, order1, H, box);
+
+  tight_bbox.m_min.Set(box[0], box[1], box[2]);
+  tight_bbox.m_max.Set(box[3], box[4], box[5]);
+  return tight_bbox.IsValid();
+}
+
 ON_BoundingBox ON_BezierSurface::BoundingBox() const
 {
   ON_BoundingBox bbox;
@@ -3969,3 +4541,468 @@ ON_BezierSurface* ON_BezierSurface::InterpolateGrid(
 
 
 
+
+/*
+Converts the non-empty spans of a NURBS curve to Bezier form in one
+left to right pass (Piegl and Tiller, The NURBS Book, A5.6). The right
+end knot of each span is raised to full multiplicity and the inserted
+control points that belong to the next span are written directly into
+that span's slot, so each knot is inserted once.
+Control point a of Bezier span k is written to
+bezier_cv[k*span_stride + a*bezier_cv_stride]. If span_parameters is not
+nullptr, the span_count+1 span parameters are written to it.
+Returns the number of Bezier spans.
+*/
+static int ON_Internal_ConvertSpansToBezier(
+  int cvdim,
+  int order,
+  int cv_count,
+  size_t cv_stride,
+  const double* cv,
+  const double* knot,
+  double* bezier_cv,
+  size_t span_stride,
+  int bezier_cv_stride,
+  double* span_parameters
+  )
+{
+  if (cvdim < 1 || order < 2 || cv_count < order || nullptr == cv || nullptr == knot || nullptr == bezier_cv || bezier_cv_stride < cvdim)
+    return 0;
+
+  const int degree = order - 1;
+  const int knot_count = ON_KnotCount(order, cv_count);
+  const size_t sizeof_cv = cvdim * sizeof(double);
+
+  double stack_alpha[32];
+  ON_SimpleArray<double> heap_alpha;
+  double* alpha = stack_alpha;
+  if (degree > 32)
+  {
+    heap_alpha.Reserve(degree);
+    alpha = heap_alpha.Array();
+  }
+
+  // s = index of the first non-empty span
+  int s = 0;
+  while (s <= cv_count - order && !(knot[s + degree - 1] < knot[s + degree]))
+    s++;
+  if (s > cv_count - order)
+    return 0;
+
+  double* Q = bezier_cv;
+  for (int a = 0; a < order; a++)
+    memcpy(Q + a * bezier_cv_stride, cv + (s + a) * cv_stride, sizeof_cv);
+  if (knot[s] != knot[s + degree - 1])
+  {
+    // clamp the start of an unclamped knot vector
+    if (!ON_EvaluateNurbsDeBoor(cvdim, order, bezier_cv_stride, Q, knot + s, 1, 0.0, knot[s + degree - 1]))
+      return 0;
+  }
+
+  int span_count = 0;
+  for (;;)
+  {
+    // Q = control points of span s with the left end knot at full 
+    // multiplicity.
+    const double t0 = knot[s + degree - 1];
+    const double t1 = knot[s + degree];
+    if (nullptr != span_parameters)
+      span_parameters[span_count] = t0;
+
+    int mult = 1;
+    while (s + degree + mult < knot_count && knot[s + degree + mult] == t1)
+      mult++;
+    const int next_s = s + mult;
+    double* next_Q = (next_s <= cv_count - order) ? (Q + span_stride) : nullptr;
+
+    if (mult < degree)
+    {
+      const int r = degree - mult;
+      for (int j = 0; j < r; j++)
+        alpha[j] = (t1 - t0) / (knot[s + degree + mult + j] - t0);
+      for (int j = 1; j <= r; j++)
+      {
+        const int k0 = mult + j;
+        for (int k = degree; k >= k0; k--)
+        {
+          const double a = alpha[k - k0];
+          const double b = 1.0 - a;
+          double* Qk = Q + k * bezier_cv_stride;
+          const double* Qk1 = Qk - bezier_cv_stride;
+          for (int d = 0; d < cvdim; d++)
+            Qk[d] = a * Qk[d] + b * Qk1[d];
+        }
+        if (nullptr != next_Q)
+          memcpy(next_Q + (r - j) * bezier_cv_stride, Q + degree * bezier_cv_stride, sizeof_cv);
+      }
+    }
+    span_count++;
+
+    if (nullptr == next_Q)
+    {
+      if (nullptr != span_parameters)
+        span_parameters[span_count] = t1;
+      break;
+    }
+
+    // The rest of the next span's control points are unchanged.
+    for (int a = (mult < degree) ? (degree - mult) : 0; a < order; a++)
+      memcpy(next_Q + a * bezier_cv_stride, cv + (next_s + a) * cv_stride, sizeof_cv);
+    s = next_s;
+    Q = next_Q;
+  }
+
+  return span_count;
+}
+
+bool ON_BezierCurveSpans::Create(
+  const ON_NurbsCurve& nurbs_curve
+  )
+{
+  Destroy();
+  const int order = nurbs_curve.m_order;
+  const int cv_count = nurbs_curve.m_cv_count;
+  if (order < 2 || cv_count < order || nullptr == nurbs_curve.m_cv || nullptr == nurbs_curve.m_knot)
+    return false;
+
+  const int span_count = ON_KnotVectorSpanCount(order, cv_count, nurbs_curve.m_knot);
+  if (span_count < 1)
+    return false;
+  const int cv_size = nurbs_curve.CVSize();
+  const size_t span_size = ((size_t)order) * cv_size;
+  const size_t buffer_count = (span_count + 1) + span_count * span_size;
+  if (buffer_count > 0x7FFFFFFFU)
+    return false;
+  m_buffer.Reserve(buffer_count);
+  m_buffer.SetCount((int)buffer_count);
+
+  double* span_parameters = m_buffer.Array();
+  const int bezier_count = ON_Internal_ConvertSpansToBezier(
+    cv_size, order, cv_count, nurbs_curve.m_cv_stride, nurbs_curve.m_cv, nurbs_curve.m_knot,
+    span_parameters + (span_count + 1), span_size, cv_size,
+    span_parameters
+    );
+  if (bezier_count != span_count)
+  {
+    Destroy();
+    return false;
+  }
+
+  m_dim = nurbs_curve.m_dim;
+  m_is_rat = nurbs_curve.m_is_rat ? 1 : 0;
+  m_order = order;
+  m_span_count = span_count;
+  return true;
+}
+
+void ON_BezierCurveSpans::Destroy()
+{
+  m_dim = 0;
+  m_is_rat = 0;
+  m_order = 0;
+  m_span_count = 0;
+  m_buffer.SetCount(0);
+}
+
+int ON_BezierCurveSpans::SpanCount() const
+{
+  return m_span_count;
+}
+
+int ON_BezierCurveSpans::Dimension() const
+{
+  return m_dim;
+}
+
+bool ON_BezierCurveSpans::IsRational() const
+{
+  return 0 != m_is_rat;
+}
+
+int ON_BezierCurveSpans::Order() const
+{
+  return m_order;
+}
+
+int ON_BezierCurveSpans::CVSize() const
+{
+  return (0 != m_dim) ? (m_is_rat ? (m_dim + 1) : m_dim) : 0;
+}
+
+ON_Interval ON_BezierCurveSpans::SpanDomain(
+  int span_index
+  ) const
+{
+  if (span_index < 0 || span_index >= m_span_count)
+    return ON_Interval::EmptyInterval;
+  const double* t = m_buffer.Array() + span_index;
+  return ON_Interval(t[0], t[1]);
+}
+
+const double* ON_BezierCurveSpans::SpanParameters() const
+{
+  return (m_span_count > 0) ? m_buffer.Array() : nullptr;
+}
+
+const double* ON_BezierCurveSpans::CV(
+  int span_index
+  ) const
+{
+  if (span_index < 0 || span_index >= m_span_count)
+    return nullptr;
+  return m_buffer.Array() + (m_span_count + 1) + ((size_t)span_index) * m_order * CVSize();
+}
+
+bool ON_BezierCurveSpans::GetSpan(
+  int span_index,
+  ON_BezierCurve& bezier
+  ) const
+{
+  const double* cv = CV(span_index);
+  if (nullptr == cv)
+    return false;
+  const int cv_size = CVSize();
+  if (bezier.m_cv_capacity <= 0 && nullptr != bezier.m_cv)
+    bezier.Destroy(); // do not write into borrowed memory
+  if (!bezier.ReserveCVCapacity(m_order * cv_size))
+    return false;
+  bezier.m_dim = m_dim;
+  bezier.m_is_rat = m_is_rat;
+  bezier.m_order = m_order;
+  bezier.m_cv_stride = cv_size;
+  memcpy(bezier.m_cv, cv, m_order * cv_size * sizeof(bezier.m_cv[0]));
+  return true;
+}
+
+bool ON_BezierCurveSpans::GetSpanForExperts(
+  int span_index,
+  ON_BezierCurve& bezier
+  ) const
+{
+  const double* cv = CV(span_index);
+  if (nullptr == cv)
+    return false;
+  bezier.Destroy();
+  bezier.m_dim = m_dim;
+  bezier.m_is_rat = m_is_rat;
+  bezier.m_order = m_order;
+  bezier.m_cv_stride = CVSize();
+  bezier.m_cv = const_cast<double*>(cv);
+  bezier.m_cv_capacity = 0;
+  return true;
+}
+
+bool ON_BezierSurfacePatches::Create(
+  const ON_NurbsSurface& nurbs_surface
+  )
+{
+  Destroy();
+  const int order0 = nurbs_surface.m_order[0];
+  const int order1 = nurbs_surface.m_order[1];
+  const int cv_count0 = nurbs_surface.m_cv_count[0];
+  const int cv_count1 = nurbs_surface.m_cv_count[1];
+  if (order0 < 2 || order1 < 2 || cv_count0 < order0 || cv_count1 < order1)
+    return false;
+  if (nullptr == nurbs_surface.m_cv || nullptr == nurbs_surface.m_knot[0] || nullptr == nurbs_surface.m_knot[1])
+    return false;
+
+  const int span_count0 = ON_KnotVectorSpanCount(order0, cv_count0, nurbs_surface.m_knot[0]);
+  const int span_count1 = ON_KnotVectorSpanCount(order1, cv_count1, nurbs_surface.m_knot[1]);
+  if (span_count0 < 1 || span_count1 < 1)
+    return false;
+  const int cv_size = nurbs_surface.CVSize();
+  const size_t patch_size = ((size_t)order0) * order1 * cv_size;
+  const size_t parameter_count = (span_count0 + 1) + (span_count1 + 1);
+  const size_t buffer_count = parameter_count + ((size_t)span_count0) * span_count1 * patch_size;
+  if (buffer_count > 0x7FFFFFFFU)
+    return false;
+
+  // The first pass treats each row of control points, CV(i,0), ...,
+  // CV(i,cv_count1-1), as a single control point of a curve in the 
+  // first direction. That requires the rows to be contiguous. Rows that
+  // are not contiguous are copied to the start of the scratch memory.
+  // The rest holds strips[i] = Bezier in the first direction and 
+  // B-spline in the second.
+  const size_t row_size = ((size_t)cv_count1) * cv_size;
+  const size_t strip_size = order0 * row_size;
+  const bool bCopyRows = (nurbs_surface.m_cv_stride[1] != cv_size);
+  const size_t row_copy_count = bCopyRows ? (cv_count0 * row_size) : 0;
+  const size_t scratch_count = row_copy_count + span_count0 * strip_size;
+  if (row_size > 0x7FFFFFFFU || scratch_count > 0x7FFFFFFFU)
+    return false;
+
+  ON_SimpleArray<double> scratch;
+  scratch.Reserve(scratch_count);
+  scratch.SetCount((int)scratch_count);
+  const double* rows = nurbs_surface.m_cv;
+  size_t row_stride = nurbs_surface.m_cv_stride[0];
+  if (bCopyRows)
+  {
+    for (int i = 0; i < cv_count0; i++)
+    {
+      for (int j = 0; j < cv_count1; j++)
+        memcpy(scratch.Array() + i * row_size + j * cv_size, nurbs_surface.CV(i, j), cv_size * sizeof(double));
+    }
+    rows = scratch.Array();
+    row_stride = row_size;
+  }
+  double* strips = scratch.Array() + row_copy_count;
+
+  m_buffer.Reserve(buffer_count);
+  m_buffer.SetCount((int)buffer_count);
+  double* parameters0 = m_buffer.Array();
+  double* parameters1 = parameters0 + (span_count0 + 1);
+  double* patches = m_buffer.Array() + parameter_count;
+
+  bool rc = (span_count0 == ON_Internal_ConvertSpansToBezier(
+    (int)row_size, order0, cv_count0, row_stride, rows, nurbs_surface.m_knot[0],
+    strips, strip_size, (int)row_size,
+    parameters0
+    ));
+
+  for (int i = 0; i < span_count0 && rc; i++)
+  {
+    for (int a = 0; a < order0 && rc; a++)
+    {
+      rc = (span_count1 == ON_Internal_ConvertSpansToBezier(
+        cv_size, order1, cv_count1, cv_size, strips + i * strip_size + a * row_size, nurbs_surface.m_knot[1],
+        patches + (i * span_count1 * patch_size) + a * order1 * cv_size, patch_size, cv_size,
+        (0 == i && 0 == a) ? parameters1 : nullptr
+        ));
+    }
+  }
+
+  if (!rc)
+  {
+    Destroy();
+    return false;
+  }
+
+  m_dim = nurbs_surface.m_dim;
+  m_is_rat = nurbs_surface.m_is_rat ? 1 : 0;
+  m_order[0] = order0;
+  m_order[1] = order1;
+  m_span_count[0] = span_count0;
+  m_span_count[1] = span_count1;
+  return true;
+}
+
+void ON_BezierSurfacePatches::Destroy()
+{
+  m_dim = 0;
+  m_is_rat = 0;
+  m_order[0] = m_order[1] = 0;
+  m_span_count[0] = m_span_count[1] = 0;
+  m_buffer.SetCount(0);
+}
+
+int ON_BezierSurfacePatches::SpanCount(
+  int dir
+  ) const
+{
+  return (0 == dir || 1 == dir) ? m_span_count[dir] : 0;
+}
+
+int ON_BezierSurfacePatches::PatchCount() const
+{
+  return m_span_count[0] * m_span_count[1];
+}
+
+int ON_BezierSurfacePatches::Dimension() const
+{
+  return m_dim;
+}
+
+bool ON_BezierSurfacePatches::IsRational() const
+{
+  return 0 != m_is_rat;
+}
+
+int ON_BezierSurfacePatches::Order(
+  int dir
+  ) const
+{
+  return (0 == dir || 1 == dir) ? m_order[dir] : 0;
+}
+
+int ON_BezierSurfacePatches::CVSize() const
+{
+  return (0 != m_dim) ? (m_is_rat ? (m_dim + 1) : m_dim) : 0;
+}
+
+ON_Interval ON_BezierSurfacePatches::SpanDomain(
+  int dir,
+  int span_index
+  ) const
+{
+  const double* t = SpanParameters(dir);
+  if (nullptr == t || span_index < 0 || span_index >= m_span_count[dir])
+    return ON_Interval::EmptyInterval;
+  return ON_Interval(t[span_index], t[span_index + 1]);
+}
+
+const double* ON_BezierSurfacePatches::SpanParameters(
+  int dir
+  ) const
+{
+  if (m_span_count[0] < 1 || !(0 == dir || 1 == dir))
+    return nullptr;
+  return m_buffer.Array() + ((0 == dir) ? 0 : (m_span_count[0] + 1));
+}
+
+const double* ON_BezierSurfacePatches::CV(
+  int i,
+  int j
+  ) const
+{
+  if (i < 0 || i >= m_span_count[0] || j < 0 || j >= m_span_count[1])
+    return nullptr;
+  const size_t patch_size = ((size_t)m_order[0]) * m_order[1] * CVSize();
+  return m_buffer.Array() + (m_span_count[0] + 1) + (m_span_count[1] + 1) + (((size_t)i) * m_span_count[1] + j) * patch_size;
+}
+
+bool ON_BezierSurfacePatches::GetPatch(
+  int i,
+  int j,
+  ON_BezierSurface& bezier
+  ) const
+{
+  const double* cv = CV(i, j);
+  if (nullptr == cv)
+    return false;
+  const int cv_size = CVSize();
+  const int patch_size = m_order[0] * m_order[1] * cv_size;
+  if (bezier.m_cv_capacity <= 0 && nullptr != bezier.m_cv)
+    bezier.Destroy(); // do not write into borrowed memory
+  if (!bezier.ReserveCVCapacity(patch_size))
+    return false;
+  bezier.m_dim = m_dim;
+  bezier.m_is_rat = m_is_rat;
+  bezier.m_order[0] = m_order[0];
+  bezier.m_order[1] = m_order[1];
+  bezier.m_cv_stride[0] = m_order[1] * cv_size;
+  bezier.m_cv_stride[1] = cv_size;
+  memcpy(bezier.m_cv, cv, patch_size * sizeof(bezier.m_cv[0]));
+  return true;
+}
+
+bool ON_BezierSurfacePatches::GetPatchForExperts(
+  int i,
+  int j,
+  ON_BezierSurface& bezier
+  ) const
+{
+  const double* cv = CV(i, j);
+  if (nullptr == cv)
+    return false;
+  bezier.Destroy();
+  bezier.m_dim = m_dim;
+  bezier.m_is_rat = m_is_rat;
+  bezier.m_order[0] = m_order[0];
+  bezier.m_order[1] = m_order[1];
+  bezier.m_cv_stride[0] = m_order[1] * CVSize();
+  bezier.m_cv_stride[1] = CVSize();
+  bezier.m_cv = const_cast<double*>(cv);
+  bezier.m_cv_capacity = 0;
+  return true;
+}
@@ -1077,6 +1077,36 @@ public:
 
   ON_BoundingBox BoundingBox() const;
 
+  /*
+	Description:
+    Get tight bounding box of the bezier surface.
+	Parameters:
+		tight_bbox - [in/out] tight bounding box
+		bGrowBox -[in]	(default=false)			
+      If true and the input tight_bbox is valid, then returned
+      tight_bbox is the union of the input tight_bbox and the 
+      tight bounding box of the bezier surface.
+		xform -[in] (default=nullptr)
+      If not nullptr, the tight bounding box of the transformed
+      bezier is calculated.  The bezier surface is not modified.
+	Returns:
+    True if the returned tight_bbox is set to a valid 
+    bounding box.
+  Remarks:
+    The boundary extremes are exact. Interior extremes are found by
+    subdividing the surface. The box always contains the surface and
+    is usually larger than the exact box by at most 1e-10 times the
+    size of the control points. When an interior extreme is reached
+    along a curve, the number of subdivisions is limited and the box
+    can be looser. When a weight is not positive or an order is
+    larger than 24, the control point hull is returned.
+  */
+	bool GetTightBoundingBox( 
+			ON_BoundingBox& tight_bbox, 
+      bool bGrowBox = false,
+			const ON_Xform* xform = nullptr
+      ) const;
+
   bool Transform( 
          const ON_Xform&
          );
@@ -1392,6 +1422,262 @@ public:
 #endif
 };
 
+/*
+Description:
+  ON_BezierCurveSpans holds every Bezier span of a NURBS curve in one
+  contiguous array of control points. Create() converts all the spans
+  in a single left to right pass. Each interior knot is raised to
+  full multiplicity once (Boehm knot insertion) and the inserted
+  control points are shared by the spans on both sides of the knot.
+
+  The control points of span i are the Order() consecutive points
+  that begin at CV(i). Each point is CVSize() doubles and rational
+  control points are homogeneous. The layout is suitable for code that
+  processes large numbers of spans with simple loops.
+See Also:
+  ON_NurbsCurve::ConvertSpanToBezier
+  ON_BezierSurfacePatches
+*/
+class ON_CLASS ON_BezierCurveSpans
+{
+public:
+  ON_BezierCurveSpans() = default;
+  ~ON_BezierCurveSpans() = default;
+  ON_BezierCurveSpans(const ON_BezierCurveSpans&) = default;
+  ON_BezierCurveSpans& operator=(const ON_BezierCurveSpans&) = default;
+
+  /*
+  Description:
+    Convert every non-empty span of a NURBS curve to a Bezier.
+  Parameters:
+    nurbs_curve - [in]
+  Returns:
+    True if successful.
+  Remarks:
+    Memory is allocated once. When a ON_BezierCurveSpans is reused,
+    memory is only allocated if the new curve needs more.
+  */
+  bool Create(
+    const ON_NurbsCurve& nurbs_curve
+    );
+
+  void Destroy();
+
+  int SpanCount() const;
+  int Dimension() const;
+  bool IsRational() const;
+  int Order() const;
+
+  /*
+  Returns:
+    Number of doubles per control point.
+  */
+  int CVSize() const;
+
+  /*
+  Parameters:
+    span_index - [in]
+      0 <= span_index < SpanCount().
+  Returns:
+    The NURBS curve parameters of the span.
+  */
+  ON_Interval SpanDomain(
+    int span_index
+    ) const;
+
+  /*
+  Returns:
+    The SpanCount()+1 span parameters from the NURBS curve.
+  */
+  const double* SpanParameters() const;
+
+  /*
+  Parameters:
+    span_index - [in]
+      0 <= span_index < SpanCount().
+  Returns:
+    The first of the span's Order()*CVSize() control point doubles.
+  */
+  const double* CV(
+    int span_index
+    ) const;
+
+  /*
+  Description:
+    Copy a span into an ON_BezierCurve.
+  Parameters:
+    span_index - [in]
+    bezier - [out]
+      Existing CV memory is reused when it is large enough.
+  Returns:
+    True if successful.
+  */
+  bool GetSpan(
+    int span_index,
+    ON_BezierCurve& bezier
+    ) const;
+
+  /*
+  Description:
+    Set an ON_BezierCurve to use the control points stored in this
+    ON_BezierCurveSpans. Nothing is copied.
+  Parameters:
+    span_index - [in]
+    bezier - [out]
+      Any CV memory owned by bezier is freed. On return
+      bezier.m_cv_capacity is zero, so bezier does not free the
+      points.
+  Returns:
+    True if successful.
+  Remarks:
+    The bezier must not be modified and must not be used after this
+    ON_BezierCurveSpans is destroyed or changed.
+  */
+  bool GetSpanForExperts(
+    int span_index,
+    ON_BezierCurve& bezier
+    ) const;
+
+private:
+  int m_dim = 0;
+  int m_is_rat = 0;
+  int m_order = 0;
+  int m_span_count = 0;
+  // m_span_count+1 span parameters followed by the control points
+  ON_SimpleArray<double> m_buffer;
+};
+
+/*
+Description:
+  ON_BezierSurfacePatches holds every Bezier patch of a NURBS surface
+  in one contiguous array of control points. Create() converts the
+  surface in one pass in each direction with the same shared knot
+  insertion that ON_BezierCurveSpans uses.
+
+  The control points of patch (i,j) begin at CV(i,j). Control point 
+  (a,b) of the patch is at CV(i,j) + (a*Order(1) + b)*CVSize().
+See Also:
+  ON_NurbsSurface::ConvertSpanToBezier
+  ON_BezierCurveSpans
+*/
+class ON_CLASS ON_BezierSurfacePatches
+{
+public:
+  ON_BezierSurfacePatches() = default;
+  ~ON_BezierSurfacePatches() = default;
+  ON_BezierSurfacePatches(const ON_BezierSurfacePatches&) = default;
+  ON_BezierSurfacePatches& operator=(const ON_BezierSurfacePatches&) = default;
+
+  /*
+  Description:
+    Convert every non-empty span of a NURBS surface to a Bezier patch.
+  Parameters:
+    nurbs_surface - [in]
+  Returns:
+    True if successful.
+  Remarks:
+    The patches are stored in one allocation that is reused when it 
+    is large enough. The conversion uses one temporary allocation for
+    the strips created by the first direction.
+  */
+  bool Create(
+    const ON_NurbsSurface& nurbs_surface
+    );
+
+  void Destroy();
+
+  /*
+  Parameters:
+    dir - [in] 0 or 1
+  Returns:
+    Number of non-empty spans in the direction.
+  */
+  int SpanCount(
+    int dir
+    ) const;
+
+  /*
+  Returns:
+    SpanCount(0)*SpanCount(1).
+  */
+  int PatchCount() const;
+
+  int Dimension() const;
+  bool IsRational() const;
+  int Order(
+    int dir
+    ) const;
+  int CVSize() const;
+
+  ON_Interval SpanDomain(
+    int dir,
+    int span_index
+    ) const;
+
+  /*
+  Returns:
+    The SpanCount(dir)+1 span parameters from the NURBS surface.
+  */
+  const double* SpanParameters(
+    int dir
+    ) const;
+
+  /*
+  Parameters:
+    i - [in]
+      0 <= i < SpanCount(0)
+    j - [in]
+      0 <= j < SpanCount(1)
+  Returns:
+    The first of the patch's Order(0)*Order(1)*CVSize() control
+    point doubles.
+  */
+  const double* CV(
+    int i,
+    int j
+    ) const;
+
+  /*
+  Description:
+    Copy a patch into an ON_BezierSurface.
+  Parameters:
+    i - [in]
+    j - [in]
+    bezier - [out]
+      Existing CV memory is reused when it is large enough.
+  Returns:
+    True if successful.
+  */
+  bool GetPatch(
+    int i,
+    int j,
+    ON_BezierSurface& bezier
+    ) const;
+
+  /*
+  Description:
+    Set an ON_BezierSurface to use the control points stored in this
+    ON_BezierSurfacePatches. Nothing is copied.
+  Remarks:
+    The bezier must not be modified and must not be used after this
+    ON_BezierSurfacePatches is destroyed or changed.
+  */
+  bool GetPatchForExperts(
+    int i,
+    int j,
+    ON_BezierSurface& bezier
+    ) const;
+
+private:
+  int m_dim = 0;
+  int m_is_rat = 0;
+  int m_order[2] = {};
+  int m_span_count[2] = {};
+  // SpanCount(0)+1 and SpanCount(1)+1 span parameters followed by the
+  // control points
+  ON_SimpleArray<double> m_buffer;
+};
+
 
 
 
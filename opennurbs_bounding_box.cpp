@@ -21,6 +21,9 @@
 #error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+// ON_Internal_GetPointListBoundingBox3()
+#include "opennurbs_internal_defines.h"
+
 ON_BoundingBox::ON_BoundingBox() ON_NOEXCEPT
   : m_min(1.0,0.0,0.0)
   , m_max(-1.0,0.0,0.0)
@@ -2378,6 +2381,13 @@ bool ON_GetPointListBoundingBox(
     {
       xform = 0;
     }
+
+    if ( 3 == dim && !is_rat && 0 == xform && ON_Internal_GetPointListBoundingBox3(ON_Internal_SIMDLevel(), count, stride, points, bbox) )
+    {
+      // SSE2 / AVX2 kernel
+      tight_bbox.Union(bbox);
+      return true;
+    }
     wi = dim;
     if ( dim > 3 )
     {
@@ -2540,6 +2550,13 @@ bool ON_GetPointListBoundingBox(
     {
       xform = 0;
     }
+
+    if ( 3 == dim && !is_rat && 0 == xform && ON_Internal_GetPointListBoundingBox3(ON_Internal_SIMDLevel(), count, stride, points, bbox) )
+    {
+      // SSE2 / AVX2 kernel
+      tight_bbox.Union(bbox);
+      return true;
+    }
     wi = dim;
     if ( dim > 3 )
     {
@@ -16,6 +16,28 @@
 
 typedef bool (*ON_StreamCallbackFunction)( void* context, ON__UINT32 size, const void* buffer );
 
+/*
+Description:
+  Methods used to compress buffers saved by ON_BinaryArchive::WriteCompressedBuffer()
+  and ON_CompressedBuffer. The value is saved with the compressed buffer, so 
+  readers detect the codec automatically.
+*/
+enum class ON_CompressionCodec : unsigned char
+{
+  ///<summary>Uncompressed.</summary>
+  None = 0,
+
+  ///<summary>zlib deflate. This is the default and can be read by all versions of opennurbs.</summary>
+  Zlib = 1,
+
+  ///<summary>
+  /// LZ4 block format. Decompression is several times faster than zlib and
+  /// the result is larger. Archives that use this codec cannot be read by 
+  /// versions of opennurbs that predate the codec.
+  ///</summary>
+  LZ4 = 2
+};
+
 class ON_CLASS ON_CompressStream
 {
 public:
@@ -421,6 +443,26 @@ public:
     int sizeof_element
     );
 
+  /*
+  Description:
+  Compress inbuffer using the specified codec.
+  Parameters:
+  sizeof__inbuffer - [in]
+  inbuffer - [in]
+  sizeof_element - [in]
+  Same as Compress() above.
+  codec - [in]
+  The method used to compress the buffer. Uncompress() detects the codec.
+  Returns:
+  True if inbuffer is successfully compressed.
+  */
+  bool Compress(
+    size_t sizeof__inbuffer,  // sizeof uncompressed input data
+    const void* inbuffer,     // uncompressed input data
+    int sizeof_element,
+    ON_CompressionCodec codec
+    );
+
   /*
   Returns:
   Number of bytes in the uncompressed information.
@@ -481,7 +523,7 @@ public:
   size_t     m_sizeof_compressed;
   ON__UINT32 m_crc_uncompressed;
   ON__UINT32 m_crc_compressed;
-  int        m_method; // 0 = copied, 1 = compressed
+  int        m_method; // 0 = copied, 1 = zlib, 2 = LZ4 (ON_CompressionCodec values)
   int        m_sizeof_element;
   size_t     m_buffer_compressed_capacity;
   void*      m_buffer_compressed;
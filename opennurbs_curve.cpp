@@ -13,6 +13,8 @@
 
 #include "opennurbs.h"
 
+#include <algorithm>
+
 #if !defined(ON_COMPILING_OPENNURBS)
 // This check is included in all opennurbs source .c and .cpp files to insure
 // ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
@@ -21,14 +23,19 @@
 #error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+// ON_Internal_ParallelFor()
+#include "opennurbs_internal_defines.h"
+
 ON_VIRTUAL_OBJECT_IMPLEMENT(ON_Curve,ON_Geometry,"4ED7D4D7-E947-11d3-BFE5-0010830122F0");
 
 ON_Curve::ON_Curve() ON_NOEXCEPT
   : ON_Geometry()
+  , m_geometry_content_serial_number(ON_NextContentSerialNumber())
 {}
 
 ON_Curve::ON_Curve(const ON_Curve& src)
   : ON_Geometry(src)
+  , m_geometry_content_serial_number(ON_NextContentSerialNumber())
 {}
 
 ON_Curve& ON_Curve::operator=(const ON_Curve& src)
@@ -37,6 +44,7 @@ ON_Curve& ON_Curve::operator=(const ON_Curve& src)
   {
     this->DestroyCurveTree();
     ON_Geometry::operator=(src);
+    m_geometry_content_serial_number = ON_NextContentSerialNumber();
   }
   return *this;
 }
@@ -45,6 +53,7 @@ ON_Curve& ON_Curve::operator=(const ON_Curve& src)
 #if defined(ON_HAS_RVALUEREF)
 ON_Curve::ON_Curve( ON_Curve&& src ) ON_NOEXCEPT
   : ON_Geometry(std::move(src))
+  , m_geometry_content_serial_number(ON_NextContentSerialNumber())
 {
 }
 
@@ -54,6 +63,7 @@ ON_Curve& ON_Curve::operator=( ON_Curve&& src )
   {
     this->DestroyCurveTree();
     ON_Geometry::operator=(std::move(src));
+    m_geometry_content_serial_number = ON_NextContentSerialNumber();
   }
   return *this;
 }
@@ -1207,6 +1217,1280 @@ bool ON_Curve::EvPoint( // returns false if unable to evaluate
   return rc;
 }
 
+bool ON_Curve::BatchEvaluate(
+       size_t t_count,
+       const double* t,
+       int der_count,
+       size_t v_stride,
+       double* v,
+       int side
+       ) const
+{
+  const int dim = Dimension();
+  if ( dim < 1 || der_count < 0 || nullptr == t || nullptr == v || v_stride < t_count )
+    return false;
+
+  const size_t ws_count = (der_count+1)*dim;
+  double stack_buffer[128];
+  double* ws = (ws_count <= sizeof(stack_buffer)/sizeof(stack_buffer[0])) 
+             ? stack_buffer 
+             : (double*)onmalloc(ws_count*sizeof(ws[0]));
+
+  bool rc = true;
+  int hint = 0;
+  for ( size_t ti = 0; ti < t_count; ti++ )
+  {
+    if ( !Evaluate( t[ti], der_count, dim, ws, side, &hint ) )
+    {
+      rc = false;
+      for ( size_t i = 0; i < ws_count; i++ )
+        ws[i] = ON_UNSET_VALUE;
+    }
+    for ( size_t i = 0; i < ws_count; i++ )
+      v[i*v_stride + ti] = ws[i];
+  }
+
+  if ( ws != stack_buffer )
+    onfree(ws);
+
+  return rc;
+}
+
+// Closest point tools shared by ON_Curve::GetClosestPoint() and
+// ON_Curve::GetClosestPoints(). The NURBS form is split into Bezier spans
+// and the span bounding boxes are put in an R-tree. The R-tree is searched
+// best first and the exact distance to a span is computed only when its
+// bounding box is closer than the best point found so far.
+class ON_Internal_CurveClosestPoint
+{
+public:
+  ON_Internal_CurveClosestPoint() = default;
+  ~ON_Internal_CurveClosestPoint() = default;
+  ON_Internal_CurveClosestPoint(const ON_Internal_CurveClosestPoint&) = delete;
+  ON_Internal_CurveClosestPoint& operator=(const ON_Internal_CurveClosestPoint&) = delete;
+
+  bool Create(const ON_Curve& curve, const ON_Interval* sub_domain);
+
+  // Thread safe.
+  bool GetClosestPoint(const ON_3dPoint& P, double maximum_distance, double* t) const;
+
+private:
+  static double ON_CALLBACK_CDECL SpanDistance(void* context, ON__INT_PTR span_index);
+  bool GetSpanClosestPoint(int span_index, const ON_3dPoint& P, double* u, double* d) const;
+
+  const ON_Curve* m_curve = nullptr;
+  ON_Interval m_domain; // curve parameters
+  bool m_bNurbFormParameters = false;
+  ON_NurbsCurve m_nurbs_form;
+  ON_ClassArray<ON_BezierCurve> m_span;
+  ON_SimpleArray<ON_Interval> m_span_domain; // NURBS form parameters
+  ON_RTree m_rtree;
+};
+
+class ON_Internal_CurveSpanDistance
+{
+public:
+  const ON_BezierCurve* m_span;
+  double m_P[3];
+};
+
+static int ON_Internal_CurveSpanDistanceFunction(void* context, double u, double* f, double* df)
+{
+  const ON_Internal_CurveSpanDistance* sd = (const ON_Internal_CurveSpanDistance*)context;
+  const ON_BezierCurve& span = *sd->m_span;
+  const int dim = span.m_dim;
+  double v[6];
+  if (!span.Evaluate(u, 1, dim, v))
+    return -1;
+  double d2 = 0.0, dd2 = 0.0;
+  for (int i = 0; i < 3; i++)
+  {
+    const double x = ((i < dim) ? v[i] : 0.0) - sd->m_P[i];
+    d2 += x * x;
+    if (i < dim)
+      dd2 += x * v[dim + i];
+  }
+  *f = d2;
+  if (nullptr != df)
+    *df = 2.0 * dd2;
+  // The test point is on the curve
+  return (0.0 == d2) ? 1 : 0;
+}
+
+bool ON_Internal_CurveClosestPoint::Create(const ON_Curve& curve, const ON_Interval* sub_domain)
+{
+  m_curve = &curve;
+  m_domain = curve.Domain();
+  if (nullptr != sub_domain)
+  {
+    ON_Interval d = *sub_domain;
+    d.MakeIncreasing();
+    if (!m_domain.Intersection(d))
+      return false;
+  }
+
+  const ON_NurbsCurve* nurbs_curve = ON_NurbsCurve::Cast(&curve);
+  if (nullptr == nurbs_curve)
+  {
+    const int rc = curve.GetNurbForm(m_nurbs_form);
+    if (rc < 1)
+      return false;
+    m_bNurbFormParameters = (2 == rc);
+    nurbs_curve = &m_nurbs_form;
+  }
+
+  const int dim = nurbs_curve->Dimension();
+  if (dim < 1 || dim > 3 || nurbs_curve->m_order < 2 || nurbs_curve->m_cv_count < nurbs_curve->m_order)
+    return false;
+
+  ON_Interval domain = nurbs_curve->Domain();
+  if (nullptr != sub_domain)
+  {
+    ON_Interval d = *sub_domain;
+    if (m_bNurbFormParameters)
+    {
+      if (!curve.GetNurbFormParameterFromCurveParameter(sub_domain->m_t[0], &d.m_t[0]))
+        return false;
+      if (!curve.GetNurbFormParameterFromCurveParameter(sub_domain->m_t[1], &d.m_t[1]))
+        return false;
+    }
+    d.MakeIncreasing();
+    if (!domain.Intersection(d) || !domain.IsIncreasing())
+      return false;
+  }
+
+  const int order = nurbs_curve->m_order;
+  const int span_count = nurbs_curve->m_cv_count - order + 1;
+  m_span.Reserve(span_count);
+  m_span_domain.Reserve(span_count);
+  ON_SimpleArray<ON_BoundingBox> bbox(span_count);
+  for (int i = 0; i < span_count; i++)
+  {
+    const double a = nurbs_curve->m_knot[i + order - 2];
+    const double b = nurbs_curve->m_knot[i + order - 1];
+    if (!(a < b) || b <= domain.m_t[0] || a >= domain.m_t[1])
+      continue;
+    ON_BezierCurve& span = m_span.AppendNew();
+    if (!nurbs_curve->ConvertSpanToBezier(i, span))
+    {
+      m_span.Remove();
+      continue;
+    }
+    ON_Interval span_domain(a, b);
+    if (a < domain.m_t[0] || b > domain.m_t[1])
+    {
+      span_domain.Intersection(domain);
+      span.Trim(ON_Interval((span_domain.m_t[0] - a) / (b - a), (span_domain.m_t[1] - a) / (b - a)));
+    }
+    m_span_domain.Append(span_domain);
+    bbox.Append(span.BoundingBox());
+  }
+
+  if (m_span.Count() <= 0)
+    return false;
+
+  return m_rtree.CreateFromBoxes(bbox.UnsignedCount(), bbox.Array(), nullptr);
+}
+
+bool ON_Internal_CurveClosestPoint::GetSpanClosestPoint(int span_index, const ON_3dPoint& P, double* u, double* d) const
+{
+  ON_Internal_CurveSpanDistance sd;
+  sd.m_span = &m_span[span_index];
+  sd.m_P[0] = P.x;
+  sd.m_P[1] = P.y;
+  sd.m_P[2] = P.z;
+
+  // Sample the span to find the discrete local minima of the squared
+  // distance. A degree n span has at most 2n-1 local extrema.
+  double su[129], sf[129];
+  const int sample_count = (sd.m_span->m_order < 32) ? 4 * sd.m_span->m_order : 128;
+  for (int i = 0; i <= sample_count; i++)
+  {
+    su[i] = ((double)i) / ((double)sample_count);
+    if (ON_Internal_CurveSpanDistanceFunction(&sd, su[i], &sf[i], nullptr) < 0)
+      return false;
+  }
+
+  double best_u = ON_UNSET_VALUE;
+  double best_f = ON_DBL_MAX;
+  for (int i = 0; i <= sample_count; i++)
+  {
+    if ((i > 0 && sf[i - 1] < sf[i]) || (i < sample_count && sf[i + 1] < sf[i]))
+      continue;
+
+    double t = su[i];
+    double f = sf[i];
+    double ax = 0.0, bx = 0.0, cx = 0.0;
+    bool bBracketed = false;
+    if (i > 0 && i < sample_count)
+    {
+      ax = su[i - 1];
+      bx = su[i];
+      cx = su[i + 1];
+      bBracketed = (sf[i] < sf[i - 1] && sf[i] < sf[i + 1]);
+    }
+    else if (f > 0.0)
+    {
+      // The sample at the end of the span is a discrete minimum. If the
+      // distance decreases into the span, look for a point between the end
+      // and its neighbor that is closer than the end.
+      const double e = su[i];
+      const double n = (0 == i) ? su[1] : su[sample_count - 1];
+      double df = 0.0;
+      if (ON_Internal_CurveSpanDistanceFunction(&sd, e, &f, &df) >= 0 && (n - e) * df < 0.0)
+      {
+        for (int j = 1; j <= 40 && !bBracketed; j++)
+        {
+          double fx = 0.0;
+          bx = e + ldexp(n - e, -j);
+          if (ON_Internal_CurveSpanDistanceFunction(&sd, bx, &fx, nullptr) < 0)
+            break;
+          bBracketed = (fx < f);
+        }
+        ax = e;
+        cx = n;
+      }
+    }
+
+    if (bBracketed)
+    {
+      if (0 == ON_FindLocalMinimum(ON_Internal_CurveSpanDistanceFunction, &sd, ax, bx, cx, ON_EPSILON, 0.5 * ON_ZERO_TOLERANCE, 100, &t))
+        t = su[i];
+      if (t < 0.0)
+        t = 0.0;
+      else if (t > 1.0)
+        t = 1.0;
+      if (ON_Internal_CurveSpanDistanceFunction(&sd, t, &f, nullptr) < 0 || f > sf[i])
+      {
+        t = su[i];
+        f = sf[i];
+      }
+    }
+
+    if (f < best_f)
+    {
+      best_f = f;
+      best_u = t;
+    }
+  }
+
+  if (!(best_f < ON_DBL_MAX))
+    return false;
+  *u = best_u;
+  *d = sqrt(best_f);
+  return true;
+}
+
+class ON_Internal_CurveClosestPointSearch
+{
+public:
+  const ON_Internal_CurveClosestPoint* m_cp;
+  ON_3dPoint m_P;
+  int m_best_span;
+  double m_best_u;
+  double m_best_d;
+};
+
+double ON_CALLBACK_CDECL ON_Internal_CurveClosestPoint::SpanDistance(void* context, ON__INT_PTR span_index)
+{
+  ON_Internal_CurveClosestPointSearch* search = (ON_Internal_CurveClosestPointSearch*)context;
+  double u = ON_UNSET_VALUE, d = ON_UNSET_VALUE;
+  if (!search->m_cp->GetSpanClosestPoint((int)span_index, search->m_P, &u, &d))
+    return ON_UNSET_VALUE;
+  if (d < search->m_best_d)
+  {
+    search->m_best_span = (int)span_index;
+    search->m_best_u = u;
+    search->m_best_d = d;
+  }
+  return d;
+}
+
+bool ON_Internal_CurveClosestPoint::GetClosestPoint(const ON_3dPoint& P, double maximum_distance, double* t) const
+{
+  if (!P.IsValid() || m_span.Count() <= 0)
+    return false;
+
+  ON_Internal_CurveClosestPointSearch search;
+  search.m_cp = this;
+  search.m_P = P;
+  search.m_best_span = -1;
+  search.m_best_u = ON_UNSET_VALUE;
+  search.m_best_d = ON_DBL_MAX;
+
+  ON_SimpleArray<ON_RTreeDistanceResult> result(1);
+  const double max_d = (maximum_distance > 0.0) ? maximum_distance : ON_UNSET_VALUE;
+  if (!m_rtree.SearchNearest(&P.x, 1, max_d, SpanDistance, &search, result))
+    return false;
+  if (1 != result.Count() || search.m_best_span < 0)
+    return false;
+  if (maximum_distance > 0.0 && search.m_best_d > maximum_distance)
+    return false;
+
+  double s = m_span_domain[search.m_best_span].ParameterAt(search.m_best_u);
+  if (m_bNurbFormParameters)
+  {
+    double curve_t = s;
+    if (!m_curve->GetCurveParameterFromNurbFormParameter(s, &curve_t))
+      return false;
+    s = curve_t;
+  }
+  // Parameter conversions can put s a few bits outside of the domain.
+  *t = (s < m_domain.m_t[0]) ? m_domain.m_t[0] : ((s > m_domain.m_t[1]) ? m_domain.m_t[1] : s);
+  return true;
+}
+
+bool ON_Curve::GetClosestPoint(
+       const ON_3dPoint& test_point,
+       double* t,
+       double maximum_distance,
+       const ON_Interval* sub_domain
+       ) const
+{
+  if (nullptr == t)
+    return false;
+  ON_Internal_CurveClosestPoint cp;
+  if (!cp.Create(*this, sub_domain))
+    return false;
+  return cp.GetClosestPoint(test_point, maximum_distance, t);
+}
+
+size_t ON_Curve::GetClosestPoints(
+       size_t point_count,
+       const ON_3dPoint* points,
+       double* t,
+       double maximum_distance,
+       const ON_Interval* sub_domain,
+       unsigned int thread_count
+       ) const
+{
+  if (0 == point_count || nullptr == points || nullptr == t)
+    return 0;
+  for (size_t i = 0; i < point_count; i++)
+    t[i] = ON_UNSET_VALUE;
+
+  ON_Internal_CurveClosestPoint cp;
+  if (!cp.Create(*this, sub_domain))
+    return 0;
+
+  // Points are handed out in blocks so threads do not share cache lines of t[].
+  const size_t block_size = (point_count > ((size_t)0xFFFFFFFFU) * 64) ? (point_count / 0xFFFFFFFFU + 1) : 64;
+  const unsigned int block_count = (unsigned int)((point_count + block_size - 1) / block_size);
+  std::atomic<size_t> found_count(0);
+  ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
+    {
+      size_t count = 0;
+      const size_t i1 = (block + 1 < block_count) ? (block + 1) * block_size : point_count;
+      for (size_t i = block * block_size; i < i1; i++)
+      {
+        if (cp.GetClosestPoint(points[i], maximum_distance, &t[i]))
+          count++;
+        else
+          t[i] = ON_UNSET_VALUE;
+      }
+      found_count += count;
+    }
+  );
+
+  return found_count;
+}
+
+// A vertex of a curve tessellation. m_D is the first derivative evaluated
+// from the side of the chord being tested.
+struct ON_Internal_CurveMeshVertex
+{
+  double m_t;
+  ON_3dPoint m_P;
+  ON_3dVector m_D;
+};
+
+class ON_Internal_CurveMesher
+{
+public:
+  ON_Internal_CurveMesher(const ON_Curve& curve, const ON_MeshCurveParameters& mp);
+
+  // Appends the tessellation of [t0,t1] to polyline. The interval is
+  // divided into count equal chords and each chord is bisected at most
+  // max_depth times. The point at t0 is not appended.
+  bool AddInterval(double t0, double t1, int count, int max_depth, ON_PolylineCurve& polyline);
+
+  // Splits chords whose length exceeds the aspect limit in m_max_aspect.
+  bool LimitAspect(int i0, ON_PolylineCurve& polyline);
+
+private:
+  bool Evaluate(double t, int side, ON_Internal_CurveMeshVertex& v);
+  bool SplitChord(const ON_Internal_CurveMeshVertex& a, const ON_Internal_CurveMeshVertex& b, ON_Internal_CurveMeshVertex& m, bool& bSplit);
+
+  const ON_Curve& m_curve;
+  const ON_MeshCurveParameters& m_mp;
+  double m_cos_max_angle = -2.0;
+  int m_hint = 0;
+};
+
+ON_Internal_CurveMesher::ON_Internal_CurveMesher(const ON_Curve& curve, const ON_MeshCurveParameters& mp)
+  : m_curve(curve)
+  , m_mp(mp)
+{
+  if (mp.m_max_ang_radians > 0.0 && mp.m_max_ang_radians < ON_PI)
+    m_cos_max_angle = cos(mp.m_max_ang_radians);
+}
+
+bool ON_Internal_CurveMesher::Evaluate(double t, int side, ON_Internal_CurveMeshVertex& v)
+{
+  v.m_t = t;
+  return m_curve.Ev1Der(t, v.m_P, v.m_D, side, &m_hint);
+}
+
+bool ON_Internal_CurveMesher::SplitChord(
+  const ON_Internal_CurveMeshVertex& a,
+  const ON_Internal_CurveMeshVertex& b,
+  ON_Internal_CurveMeshVertex& m,
+  bool& bSplit
+  )
+{
+  bSplit = false;
+  const double tm = 0.5 * (a.m_t + b.m_t);
+  if (!(a.m_t < tm && tm < b.m_t))
+    return true; // parameter resolution reached
+
+  const ON_3dVector chord = b.m_P - a.m_P;
+  const double length = chord.Length();
+  if (m_mp.m_min_edge_length > 0.0 && length < 2.0 * m_mp.m_min_edge_length)
+    return true;
+
+  bSplit = (m_mp.m_max_edge_length > 0.0 && length > m_mp.m_max_edge_length);
+
+  if (!bSplit && m_cos_max_angle > -2.0)
+  {
+    const double la = a.m_D.Length();
+    const double lb = b.m_D.Length();
+    if (la > 0.0 && lb > 0.0)
+      bSplit = (a.m_D * b.m_D < m_cos_max_angle * la * lb);
+  }
+
+  bool bHaveMidpoint = false;
+  if (!bSplit && (m_mp.m_tolerance > 0.0 || m_mp.m_max_chr > 0.0))
+  {
+    if (!Evaluate(tm, 0, m))
+      return false;
+    bHaveMidpoint = true;
+    // distance from the curve midpoint to the chord
+    const ON_3dVector V = m.m_P - a.m_P;
+    const double s = (length > 0.0) ? ((V * chord) / (length * length)) : 0.0;
+    const double h = (s <= 0.0) ? V.Length() : ((s >= 1.0) ? (m.m_P - b.m_P).Length() : (V - s * chord).Length());
+    bSplit = (m_mp.m_tolerance > 0.0 && h > m_mp.m_tolerance) || (m_mp.m_max_chr > 0.0 && h > m_mp.m_max_chr * length);
+  }
+
+  if (bSplit && !bHaveMidpoint)
+    return Evaluate(tm, 0, m);
+  return true;
+}
+
+bool ON_Internal_CurveMesher::AddInterval(double t0, double t1, int count, int max_depth, ON_PolylineCurve& polyline)
+{
+  if (!(t0 < t1) || count < 1)
+    return false;
+  if (max_depth > 30)
+    max_depth = 30;
+
+  struct Chord
+  {
+    ON_Internal_CurveMeshVertex m_a;
+    ON_Internal_CurveMeshVertex m_b;
+    int m_depth;
+  } stack[32];
+
+  const ON_Interval interval(t0, t1);
+  ON_Internal_CurveMeshVertex a;
+  if (!Evaluate(t0, 1, a))
+    return false;
+  for (int i = 1; i <= count; i++)
+  {
+    ON_Internal_CurveMeshVertex b;
+    if (!Evaluate((i < count) ? interval.ParameterAt(((double)i) / ((double)count)) : t1, (i < count) ? 0 : -1, b))
+      return false;
+
+    // Depth first bisection so the vertices are appended in order.
+    int stack_count = 1;
+    stack[0].m_a = a;
+    stack[0].m_b = b;
+    stack[0].m_depth = 0;
+    while (stack_count > 0)
+    {
+      const Chord c = stack[--stack_count];
+      bool bSplit = false;
+      ON_Internal_CurveMeshVertex m;
+      if (c.m_depth < max_depth && !SplitChord(c.m_a, c.m_b, m, bSplit))
+        return false;
+      if (bSplit)
+      {
+        stack[stack_count].m_a = m;
+        stack[stack_count].m_b = c.m_b;
+        stack[stack_count].m_depth = c.m_depth + 1;
+        stack_count++;
+        stack[stack_count].m_a = c.m_a;
+        stack[stack_count].m_b = m;
+        stack[stack_count].m_depth = c.m_depth + 1;
+        stack_count++;
+      }
+      else
+      {
+        polyline.m_pline.Append(c.m_b.m_P);
+        polyline.m_t.Append(c.m_b.m_t);
+      }
+    }
+    a = b;
+  }
+  return true;
+}
+
+bool ON_Internal_CurveMesher::LimitAspect(int i0, ON_PolylineCurve& polyline)
+{
+  if (!(m_mp.m_max_aspect >= 1.0))
+    return true;
+  const double max_aspect = (m_mp.m_max_aspect < ON_SQRT2) ? ON_SQRT2 : m_mp.m_max_aspect;
+  const int point_count = polyline.m_pline.Count();
+  if (i0 < 0 || point_count - i0 < 3)
+    return true;
+
+  double min_length = ON_DBL_MAX;
+  for (int i = i0 + 1; i < point_count; i++)
+  {
+    const double length = polyline.m_pline[i - 1].DistanceTo(polyline.m_pline[i]);
+    if (length > 0.0 && length < min_length)
+      min_length = length;
+  }
+  if (!(min_length < ON_DBL_MAX))
+    return true;
+  const double max_length = max_aspect * min_length;
+
+  ON_3dPointArray P(point_count);
+  ON_SimpleArray<double> T(point_count);
+  P.Append(point_count - i0 - 1, polyline.m_pline.Array() + i0 + 1);
+  T.Append(point_count - i0 - 1, polyline.m_t.Array() + i0 + 1);
+  polyline.m_pline.SetCount(i0 + 1);
+  polyline.m_t.SetCount(i0 + 1);
+  for (int i = 0; i < P.Count(); i++)
+  {
+    const double t0 = *polyline.m_t.Last();
+    const double length = polyline.m_pline.Last()->DistanceTo(P[i]);
+    if (length > max_length && t0 < T[i])
+    {
+      // A tiny min_length can make length/max_length overflow an int.
+      // Use the same limit as ON_Internal_ArcChordCount().
+      const double chord_count = ceil(length / max_length);
+      const int n = (chord_count < 1.0e6) ? (int)chord_count : 1000000;
+      const ON_Interval interval(t0, T[i]);
+      for (int j = 1; j < n; j++)
+      {
+        const double t = interval.ParameterAt(((double)j) / ((double)n));
+        ON_3dPoint Q;
+        if (!m_curve.EvPoint(t, Q, 0, &m_hint))
+          return false;
+        polyline.m_pline.Append(Q);
+        polyline.m_t.Append(t);
+      }
+    }
+    polyline.m_pline.Append(P[i]);
+    polyline.m_t.Append(T[i]);
+  }
+  return true;
+}
+
+// Number of equal chords needed for an arc with the given radius and angle.
+static int ON_Internal_ArcChordCount(const ON_MeshCurveParameters& mp, double radius, double angle)
+{
+  // Without constraints, use 45 degree chords like the NURBS form does.
+  double max_chord_angle = 0.25 * ON_PI;
+  double min_chord_angle = 0.0;
+  if (mp.m_tolerance > 0.0 && mp.m_tolerance < radius)
+  {
+    // radius*(1 - cos(a/2)) <= tolerance
+    const double a = 2.0 * acos(1.0 - mp.m_tolerance / radius);
+    if (a < max_chord_angle)
+      max_chord_angle = a;
+  }
+  if (mp.m_max_chr > 0.0)
+  {
+    // (1 - cos(a/2))/(2 sin(a/2)) = tan(a/4)/2 <= max_chr
+    const double a = 4.0 * atan(2.0 * mp.m_max_chr);
+    if (a < max_chord_angle)
+      max_chord_angle = a;
+  }
+  if (mp.m_max_ang_radians > 0.0 && mp.m_max_ang_radians < max_chord_angle)
+    max_chord_angle = mp.m_max_ang_radians;
+  if (mp.m_max_edge_length > 0.0 && mp.m_max_edge_length < 2.0 * radius)
+  {
+    // 2*radius*sin(a/2) <= max_edge_length
+    const double a = 2.0 * asin(0.5 * mp.m_max_edge_length / radius);
+    if (a < max_chord_angle)
+      max_chord_angle = a;
+  }
+  if (mp.m_min_edge_length > 0.0)
+  {
+    min_chord_angle = (mp.m_min_edge_length < 2.0 * radius) ? 2.0 * asin(0.5 * mp.m_min_edge_length / radius) : ON_PI;
+    if (max_chord_angle < min_chord_angle)
+      max_chord_angle = min_chord_angle;
+  }
+  if (!(max_chord_angle > 0.0))
+    return 1;
+  const double n = ceil(fabs(angle) / max_chord_angle - ON_SQRT_EPSILON);
+  return (n < 1.0) ? 1 : ((n > 1.0e6) ? 1000000 : (int)n);
+}
+
+ON_PolylineCurve* ON_Curve::MeshCurve(
+  const ON_MeshCurveParameters& mp,
+  ON_PolylineCurve* polyline,
+  bool bSkipFirstPoint,
+  const ON_Interval* domain
+  ) const
+{
+  ON_Interval curve_domain = Domain();
+  if (nullptr != domain)
+  {
+    ON_Interval d = *domain;
+    d.MakeIncreasing();
+    if (!curve_domain.Intersection(d))
+      return nullptr;
+  }
+  if (!curve_domain.IsIncreasing())
+    return nullptr;
+
+  ON_PolylineCurve* rc = (nullptr != polyline) ? polyline : new ON_PolylineCurve();
+  const int point_count0 = rc->m_pline.Count();
+  if (0 == point_count0)
+    rc->m_dim = (2 == Dimension()) ? 2 : 3;
+
+  bool bOK = true;
+  const ON_PolyCurve* polycurve = (mp.m_main_seg_count <= 0) ? ON_PolyCurve::Cast(this) : nullptr;
+  if (nullptr != polycurve)
+  {
+    // Tessellate the segments individually so lines and arcs in the
+    // polycurve use the fast paths.
+    bool bSkip = bSkipFirstPoint;
+    for (int i = 0; i < polycurve->Count() && bOK; i++)
+    {
+      const ON_Curve* segment = polycurve->SegmentCurve(i);
+      const ON_Interval segment_domain = polycurve->SegmentDomain(i);
+      ON_Interval d = segment_domain;
+      if (nullptr == segment || !d.Intersection(curve_domain) || !d.IsIncreasing())
+        continue;
+      const ON_Interval sd = segment->Domain();
+      const ON_Interval sub_domain(
+        sd.ParameterAt(segment_domain.NormalizedParameterAt(d.m_t[0])),
+        sd.ParameterAt(segment_domain.NormalizedParameterAt(d.m_t[1]))
+        );
+      const int i0 = rc->m_t.Count();
+      bOK = (nullptr != segment->MeshCurve(mp, rc, bSkip, &sub_domain));
+      for (int j = i0; j < rc->m_t.Count() && bOK; j++)
+        rc->m_t[j] = segment_domain.ParameterAt(sd.NormalizedParameterAt(rc->m_t[j]));
+      bSkip = true;
+    }
+  }
+  else
+  {
+    ON_Internal_CurveMesher mesher(*this, mp);
+    if (!bSkipFirstPoint || 0 == point_count0)
+    {
+      ON_3dPoint P;
+      bOK = EvPoint(curve_domain.m_t[0], P, 1);
+      rc->m_pline.Append(P);
+      rc->m_t.Append(curve_domain.m_t[0]);
+    }
+
+    ON_SimpleArray<double> breaks;
+    int count = 1;
+    int max_depth = 30;
+    const ON_ArcCurve* arc_curve = ON_ArcCurve::Cast(this);
+    if (mp.m_main_seg_count > 0)
+    {
+      breaks.Append(curve_domain.m_t[0]);
+      breaks.Append(curve_domain.m_t[1]);
+      count = mp.m_main_seg_count;
+      max_depth = 0;
+      for (int n = mp.m_sub_seg_count; n > 1; n /= 2)
+        max_depth++;
+    }
+    else if (nullptr != arc_curve)
+    {
+      // Equal chords. Arc curve parameters are proportional to the angle.
+      const double angle = arc_curve->m_arc.AngleRadians() * curve_domain.Length() / Domain().Length();
+      breaks.Append(curve_domain.m_t[0]);
+      breaks.Append(curve_domain.m_t[1]);
+      count = ON_Internal_ArcChordCount(mp, arc_curve->m_arc.Radius(), angle);
+      max_depth = 0;
+    }
+    else if (IsPolyline(nullptr, &breaks) >= 2)
+    {
+      // Chords are only split to satisfy the edge length limits.
+    }
+    else if (IsLinear())
+    {
+      breaks.SetCount(0);
+    }
+    else
+    {
+      breaks.SetCount(0);
+      const int span_count = SpanCount();
+      if (span_count >= 1)
+      {
+        breaks.SetCount(span_count + 1);
+        if (!GetSpanVector(breaks.Array()))
+          breaks.SetCount(0);
+      }
+      count = Degree();
+      if (count < 1)
+        count = 1;
+    }
+
+    // Trim the break points to the domain.
+    ON_SimpleArray<double> t(breaks.Count() + 2);
+    t.Append(curve_domain.m_t[0]);
+    for (int i = 0; i < breaks.Count(); i++)
+    {
+      if (breaks[i] > *t.Last() && breaks[i] < curve_domain.m_t[1])
+        t.Append(breaks[i]);
+    }
+    t.Append(curve_domain.m_t[1]);
+
+    const int i0 = rc->m_pline.Count() - 1;
+    for (int i = 1; i < t.Count() && bOK; i++)
+      bOK = mesher.AddInterval(t[i - 1], t[i], count, max_depth, *rc);
+    if (bOK)
+      bOK = mesher.LimitAspect(i0, *rc);
+  }
+
+  if (!bOK)
+  {
+    if (rc != polyline)
+      delete rc;
+    else
+    {
+      rc->m_pline.SetCount(point_count0);
+      rc->m_t.SetCount(point_count0);
+    }
+    return nullptr;
+  }
+
+  return rc;
+}
+
+unsigned int ON_Curve::MeshCurves(
+  size_t curve_count,
+  const ON_Curve* const* curves,
+  const ON_MeshCurveParameters& mp,
+  ON_SimpleArray<ON_PolylineCurve*>& polylines,
+  unsigned int thread_count
+  )
+{
+  if (0 == curve_count || nullptr == curves)
+    return 0;
+
+  const unsigned int i0 = polylines.UnsignedCount();
+  polylines.Reserve(i0 + curve_count);
+  for (size_t i = 0; i < curve_count; i++)
+    polylines.Append(nullptr);
+  ON_PolylineCurve** results = polylines.Array() + i0;
+
+  const size_t block_size = (curve_count > ((size_t)0xFFFFFFFFU) * 16) ? (curve_count / 0xFFFFFFFFU + 1) : 16;
+  const unsigned int block_count = (unsigned int)((curve_count + block_size - 1) / block_size);
+  std::atomic<unsigned int> meshed_count(0);
+  ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
+    {
+      unsigned int count = 0;
+      const size_t i1 = (block + 1 < block_count) ? (block + 1) * block_size : curve_count;
+      for (size_t i = block * block_size; i < i1; i++)
+      {
+        if (nullptr == curves[i])
+          continue;
+        results[i] = curves[i]->MeshCurve(mp, nullptr, false, nullptr);
+        if (nullptr != results[i])
+          count++;
+      }
+      meshed_count += count;
+    }
+  );
+
+  return meshed_count;
+}
+
+ON__UINT64 ON_Curve::GeometryContentSerialNumber() const
+{
+  return m_geometry_content_serial_number;
+}
+
+ON__UINT64 ON_Curve::ChangeGeometryContentSerialNumberForExperts()
+{
+  m_geometry_content_serial_number = ON_NextContentSerialNumber();
+  return m_geometry_content_serial_number;
+}
+
+bool ON_Curve::GetLength(
+  double* length,
+  double fractional_tolerance,
+  const ON_Interval* sub_domain
+  ) const
+{
+  ON_CurveArcLength arc_length;
+  return GetLength(arc_length, length, fractional_tolerance, sub_domain);
+}
+
+bool ON_Curve::GetLength(
+  ON_CurveArcLength& arc_length,
+  double* length,
+  double fractional_tolerance,
+  const ON_Interval* sub_domain
+  ) const
+{
+  if (nullptr == length)
+    return false;
+  if (!arc_length.Update(*this, fractional_tolerance, sub_domain))
+    return false;
+  *length = arc_length.Length();
+  return true;
+}
+
+bool ON_Curve::GetNormalizedArcLengthPoint(
+  double s,
+  double* t,
+  double fractional_tolerance,
+  const ON_Interval* sub_domain
+  ) const
+{
+  return GetNormalizedArcLengthPoints(1, &s, t, 0.0, fractional_tolerance, sub_domain);
+}
+
+bool ON_Curve::GetNormalizedArcLengthPoints(
+  int count,
+  const double* s,
+  double* t,
+  double absolute_tolerance,
+  double fractional_tolerance,
+  const ON_Interval* sub_domain
+  ) const
+{
+  ON_CurveArcLength arc_length;
+  return GetNormalizedArcLengthPoints(arc_length, count, s, t, absolute_tolerance, fractional_tolerance, sub_domain);
+}
+
+bool ON_Curve::GetNormalizedArcLengthPoints(
+  ON_CurveArcLength& arc_length,
+  int count,
+  const double* s,
+  double* t,
+  double absolute_tolerance,
+  double fractional_tolerance,
+  const ON_Interval* sub_domain
+  ) const
+{
+  if (count < 1 || nullptr == s || nullptr == t)
+    return false;
+  if (!arc_length.Update(*this, fractional_tolerance, sub_domain))
+    return false;
+  for (int i = 0; i < count; i++)
+  {
+    if (!arc_length.NormalizedParameterAt(s[i], &t[i], absolute_tolerance))
+      return false;
+  }
+  return true;
+}
+
+// Length of curve(t) for a <= t <= b using 8 point Gauss-Legendre quadrature.
+static bool ON_Internal_ArcLengthQuadrature(const ON_Curve& curve, double a, double b, int* hint, double* length)
+{
+  static const double x[4] = { 0.1834346424956498, 0.5255324099163290, 0.7966664774136267, 0.9602898564975363 };
+  static const double w[4] = { 0.3626837833783620, 0.3137066458778873, 0.2223810344533745, 0.1012285362903763 };
+  const double c = 0.5 * (a + b);
+  const double h = 0.5 * (b - a);
+  double sum = 0.0;
+  ON_3dPoint P;
+  ON_3dVector D;
+  for (int i = 0; i < 4; i++)
+  {
+    if (!curve.Ev1Der(c - h * x[i], P, D, 0, hint))
+      return false;
+    double speed = D.Length();
+    if (!curve.Ev1Der(c + h * x[i], P, D, 0, hint))
+      return false;
+    speed += D.Length();
+    sum += w[i] * speed;
+  }
+  *length = h * sum;
+  return true;
+}
+
+// The domain and fractional tolerance ON_CurveArcLength::Create() uses.
+static bool ON_Internal_ArcLengthInput(
+  const ON_Curve& curve,
+  const ON_Interval* sub_domain,
+  ON_Interval& domain,
+  double& fractional_tolerance
+  )
+{
+  domain = curve.Domain();
+  if (nullptr != sub_domain)
+  {
+    ON_Interval d = *sub_domain;
+    d.MakeIncreasing();
+    if (!domain.Intersection(d))
+      return false;
+  }
+  if (!domain.IsIncreasing())
+    return false;
+
+  if (!(fractional_tolerance > 0.0))
+    fractional_tolerance = 1.0e-8;
+  else if (fractional_tolerance < 1.0e-13)
+    fractional_tolerance = 1.0e-13;
+  return true;
+}
+
+bool ON_CurveArcLength::Create(
+  const ON_Curve& curve,
+  double fractional_tolerance,
+  const ON_Interval* sub_domain
+  )
+{
+  Destroy();
+
+  ON_Interval domain;
+  if (!ON_Internal_ArcLengthInput(curve, sub_domain, domain, fractional_tolerance))
+    return false;
+
+  // Span boundaries in the domain. Curves are smooth inside spans.
+  ON_SimpleArray<double> breaks;
+  const int span_count = curve.SpanCount();
+  if (span_count >= 1)
+  {
+    ON_SimpleArray<double> span_vector(span_count + 1);
+    span_vector.SetCount(span_count + 1);
+    if (curve.GetSpanVector(span_vector.Array()))
+    {
+      breaks.Reserve(span_count + 1);
+      breaks.Append(domain.m_t[0]);
+      for (int i = 0; i <= span_count; i++)
+      {
+        if (span_vector[i] > *breaks.Last() && span_vector[i] < domain.m_t[1])
+          breaks.Append(span_vector[i]);
+      }
+    }
+  }
+  if (0 == breaks.Count())
+    breaks.Append(domain.m_t[0]);
+  breaks.Append(domain.m_t[1]);
+
+  // The first estimate of the length sets the absolute tolerance.
+  int hint = 0;
+  ON_SimpleArray<double> span_length(breaks.Count() - 1);
+  double length = 0.0;
+  for (int i = 1; i < breaks.Count(); i++)
+  {
+    double l = 0.0;
+    if (!ON_Internal_ArcLengthQuadrature(curve, breaks[i - 1], breaks[i], &hint, &l))
+      return false;
+    span_length.Append(l);
+    length += l;
+  }
+  if (!ON_IsValid(length))
+    return false;
+  const double tolerance = fractional_tolerance * length;
+  const double domain_length = domain.Length();
+
+  // Adaptively bisect each span until halving an interval no longer
+  // changes its length.
+  struct Interval
+  {
+    double m_a;
+    double m_b;
+    double m_length;
+    int m_depth;
+  } stack[64];
+
+  m_t.Reserve(2 * breaks.Count());
+  m_s.Reserve(2 * breaks.Count());
+  m_t.Append(domain.m_t[0]);
+  m_s.Append(0.0);
+  for (int i = 1; i < breaks.Count(); i++)
+  {
+    int stack_count = 1;
+    stack[0].m_a = breaks[i - 1];
+    stack[0].m_b = breaks[i];
+    stack[0].m_length = span_length[i - 1];
+    stack[0].m_depth = 0;
+    while (stack_count > 0)
+    {
+      const Interval I = stack[--stack_count];
+      const double m = 0.5 * (I.m_a + I.m_b);
+      double la = 0.0, lb = 0.0;
+      if (I.m_a < m && m < I.m_b)
+      {
+        if (!ON_Internal_ArcLengthQuadrature(curve, I.m_a, m, &hint, &la))
+          return false;
+        if (!ON_Internal_ArcLengthQuadrature(curve, m, I.m_b, &hint, &lb))
+          return false;
+      }
+      else
+      {
+        m_t.Append(I.m_b);
+        m_s.Append(*m_s.Last() + I.m_length);
+        continue;
+      }
+
+      if (I.m_depth >= 30 || fabs(la + lb - I.m_length) <= tolerance * (I.m_b - I.m_a) / domain_length)
+      {
+        m_t.Append(m);
+        m_s.Append(*m_s.Last() + la);
+        m_t.Append(I.m_b);
+        m_s.Append(*m_s.Last() + lb);
+        continue;
+      }
+
+      // push the right half first so the left half is finished first
+      stack[stack_count].m_a = m;
+      stack[stack_count].m_b = I.m_b;
+      stack[stack_count].m_length = lb;
+      stack[stack_count].m_depth = I.m_depth + 1;
+      stack_count++;
+      stack[stack_count].m_a = I.m_a;
+      stack[stack_count].m_b = m;
+      stack[stack_count].m_length = la;
+      stack[stack_count].m_depth = I.m_depth + 1;
+      stack_count++;
+    }
+  }
+
+  m_curve = &curve;
+  m_curve_serial_number = curve.GeometryContentSerialNumber();
+  m_fractional_tolerance = fractional_tolerance;
+  m_tolerance = fractional_tolerance * (*m_s.Last());
+  return true;
+}
+
+bool ON_CurveArcLength::Update(
+  const ON_Curve& curve,
+  double fractional_tolerance,
+  const ON_Interval* sub_domain
+  )
+{
+  return IsCurrent(curve, fractional_tolerance, sub_domain)
+    ? true
+    : Create(curve, fractional_tolerance, sub_domain);
+}
+
+void ON_CurveArcLength::Destroy()
+{
+  m_curve = nullptr;
+  m_curve_serial_number = 0;
+  m_fractional_tolerance = 0.0;
+  m_tolerance = 0.0;
+  m_t.SetCount(0);
+  m_s.SetCount(0);
+}
+
+bool ON_CurveArcLength::IsCurrent() const
+{
+  return nullptr != m_curve && m_t.Count() >= 2 && m_curve_serial_number == m_curve->GeometryContentSerialNumber();
+}
+
+bool ON_CurveArcLength::IsCurrent(
+  const ON_Curve& curve,
+  double fractional_tolerance,
+  const ON_Interval* sub_domain
+  ) const
+{
+  if (&curve != m_curve || !IsCurrent())
+    return false;
+  ON_Interval domain;
+  if (!ON_Internal_ArcLengthInput(curve, sub_domain, domain, fractional_tolerance))
+    return false;
+  return fractional_tolerance == m_fractional_tolerance
+    && domain.m_t[0] == m_t[0]
+    && domain.m_t[1] == *m_t.Last();
+}
+
+const ON_Curve* ON_CurveArcLength::Curve() const
+{
+  return m_curve;
+}
+
+ON_Interval ON_CurveArcLength::Domain() const
+{
+  return (m_t.Count() >= 2) ? ON_Interval(m_t[0], *m_t.Last()) : ON_Interval::EmptyInterval;
+}
+
+double ON_CurveArcLength::Length() const
+{
+  return (m_s.Count() >= 2) ? *m_s.Last() : ON_UNSET_VALUE;
+}
+
+double ON_CurveArcLength::Tolerance() const
+{
+  return m_tolerance;
+}
+
+unsigned int ON_CurveArcLength::IntervalCount() const
+{
+  return (m_t.UnsignedCount() >= 2) ? (m_t.UnsignedCount() - 1) : 0;
+}
+
+bool ON_CurveArcLength::LengthAt(
+  double t,
+  double* length
+  ) const
+{
+  if (nullptr == length || !IsCurrent())
+    return false;
+  const int n = m_t.Count() - 1;
+  if (!(t >= m_t[0] && t <= m_t[n]))
+    return false;
+
+  // i = index of the last table parameter <= t
+  const int i = (int)(std::upper_bound(m_t.Array(), m_t.Array() + n + 1, t) - m_t.Array()) - 1;
+  double l = 0.0;
+  if (i < n && t > m_t[i])
+  {
+    int hint = 0;
+    if (!ON_Internal_ArcLengthQuadrature(*m_curve, m_t[i], t, &hint, &l))
+      return false;
+  }
+  *length = m_s[i] + l;
+  return true;
+}
+
+bool ON_CurveArcLength::Internal_ParameterAt(double length, double tolerance, double* t, int* hint) const
+{
+  const int n = m_t.Count() - 1;
+  if (length <= 0.0)
+  {
+    *t = m_t[0];
+    return true;
+  }
+  if (length >= m_s[n])
+  {
+    *t = m_t[n];
+    return true;
+  }
+
+  // m_s[i] <= length < m_s[i+1]
+  const int i = (int)(std::upper_bound(m_s.Array(), m_s.Array() + n + 1, length) - m_s.Array()) - 1;
+  const double r = length - m_s[i];
+  double t0 = m_t[i];
+  double t1 = m_t[i + 1];
+  double x = t0 + (t1 - t0) * r / (m_s[i + 1] - m_s[i]);
+
+  // Newton's method on length(x) - r, safeguarded by bisection.
+  for (int iteration = 0; iteration < 64; iteration++)
+  {
+    double l = 0.0;
+    if (x > m_t[i] && !ON_Internal_ArcLengthQuadrature(*m_curve, m_t[i], x, hint, &l))
+      return false;
+    const double f = l - r;
+    if (fabs(f) <= tolerance)
+      break;
+    if (f > 0.0)
+      t1 = x;
+    else
+      t0 = x;
+    ON_3dPoint P;
+    ON_3dVector D;
+    if (!m_curve->Ev1Der(x, P, D, 0, hint))
+      return false;
+    const double speed = D.Length();
+    double y = (speed > 0.0) ? (x - f / speed) : ON_UNSET_VALUE;
+    if (!(t0 < y && y < t1))
+      y = 0.5 * (t0 + t1);
+    if (y == x)
+      break;
+    x = y;
+  }
+  *t = x;
+  return true;
+}
+
+bool ON_CurveArcLength::ParameterAt(
+  double length,
+  double* t,
+  double absolute_tolerance
+  ) const
+{
+  if (nullptr == t || !IsCurrent())
+    return false;
+  const double l = Length();
+  if (!(length >= -m_tolerance && length <= l + m_tolerance))
+    return false;
+  const double tolerance = (absolute_tolerance > 0.0 && absolute_tolerance < m_tolerance) ? absolute_tolerance : m_tolerance;
+  int hint = 0;
+  return Internal_ParameterAt(length, tolerance, t, &hint);
+}
+
+bool ON_CurveArcLength::NormalizedParameterAt(
+  double s,
+  double* t,
+  double absolute_tolerance
+  ) const
+{
+  if (!(s >= -ON_SQRT_EPSILON && s <= 1.0 + ON_SQRT_EPSILON))
+    return false;
+  return ParameterAt(((s < 0.0) ? 0.0 : ((s > 1.0) ? 1.0 : s)) * Length(), t, absolute_tolerance);
+}
+
+unsigned int ON_CurveArcLength::DivideByCount(
+  unsigned int segment_count,
+  ON_SimpleArray<double>& t
+  ) const
+{
+  if (segment_count < 1 || !IsCurrent())
+    return 0;
+  const unsigned int count0 = t.UnsignedCount();
+  const double length = Length();
+  int hint = 0;
+  t.Reserve(count0 + segment_count + 1);
+  t.Append(m_t[0]);
+  for (unsigned int i = 1; i < segment_count; i++)
+  {
+    double x = ON_UNSET_VALUE;
+    if (!Internal_ParameterAt(length * ((double)i) / ((double)segment_count), m_tolerance, &x, &hint))
+    {
+      t.SetCount(count0);
+      return 0;
+    }
+    t.Append(x);
+  }
+  t.Append(*m_t.Last());
+  return segment_count + 1;
+}
+
+unsigned int ON_CurveArcLength::DivideByLength(
+  double segment_length,
+  ON_SimpleArray<double>& t
+  ) const
+{
+  if (!(segment_length > 0.0) || !IsCurrent())
+    return 0;
+  const double length = Length();
+  const double segment_count = floor((length + m_tolerance) / segment_length);
+  if (!(segment_count < 1.0e8))
+  {
+    ON_ERROR("segment_length is too small.");
+    return 0;
+  }
+  const unsigned int point_count = (unsigned int)segment_count + 1;
+  const unsigned int count0 = t.UnsignedCount();
+  int hint = 0;
+  t.Reserve(count0 + point_count);
+  for (unsigned int i = 0; i < point_count; i++)
+  {
+    double x = ON_UNSET_VALUE;
+    if (!Internal_ParameterAt(i * segment_length, m_tolerance, &x, &hint))
+    {
+      t.SetCount(count0);
+      return 0;
+    }
+    t.Append(x);
+  }
+  return point_count;
+}
+
 bool ON_Brep::EvaluatePoint( const class ON_ObjRef& objref, ON_3dPoint& P ) const
 {
   // TODO
@@ -1443,6 +2727,84 @@ bool ON_Curve::Ev2Der( // returns false if unable to evaluate
 }
 
 
+static bool ON_Internal_CurveEvDer(
+  const ON_Curve& curve,
+  double t,
+  int der_count,
+  ON_3dVector* D, // D[der_count+1]
+  int side,
+  ON_EvaluationContext& context
+  )
+{
+  int i, j;
+  for ( i = 0; i <= der_count; i++ )
+    D[i] = ON_3dVector::ZeroVector;
+
+  const int dim = curve.Dimension();
+  double* v = (dim > 0) ? context.Workspace((der_count+1)*dim) : nullptr;
+  if ( nullptr == v )
+    return false;
+
+  // ON_NurbsCurve gets its scratch memory from the context too.
+  const ON_NurbsCurve* nurbs_curve = ON_NurbsCurve::Cast(&curve);
+  const bool rc = (nullptr != nurbs_curve)
+    ? nurbs_curve->Evaluate( t, der_count, dim, v, side, context )
+    : curve.Evaluate( t, der_count, dim, v, side, context.CurveHint() );
+  const int n = (dim < 3) ? dim : 3;
+  for ( i = 0; i <= der_count; i++ )
+  {
+    for ( j = 0; j < n; j++ )
+      D[i][j] = v[i*dim + j];
+  }
+  return rc;
+}
+
+bool ON_Curve::EvPoint(
+       double t,
+       ON_3dPoint& point,
+       int side,
+       ON_EvaluationContext& context
+       ) const
+{
+  ON_3dVector D[1];
+  const bool rc = ON_Internal_CurveEvDer( *this, t, 0, D, side, context );
+  point = D[0];
+  return rc;
+}
+
+bool ON_Curve::Ev1Der(
+       double t,
+       ON_3dPoint& point,
+       ON_3dVector& first_derivative,
+       int side,
+       ON_EvaluationContext& context
+       ) const
+{
+  ON_3dVector D[2];
+  const bool rc = ON_Internal_CurveEvDer( *this, t, 1, D, side, context );
+  point = D[0];
+  first_derivative = D[1];
+  return rc;
+}
+
+bool ON_Curve::Ev2Der(
+       double t,
+       ON_3dPoint& point,
+       ON_3dVector& first_derivative,
+       ON_3dVector& second_derivative,
+       int side,
+       ON_EvaluationContext& context
+       ) const
+{
+  ON_3dVector D[3];
+  const bool rc = ON_Internal_CurveEvDer( *this, t, 2, D, side, context );
+  point = D[0];
+  first_derivative = D[1];
+  second_derivative = D[2];
+  return rc;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////////////
 //
 // ON_Curve::IsShort() 
@@ -74,6 +74,8 @@ public:
   double m_reserved4;
 };
 
+class ON_CurveArcLength;
+
 /*
 Description:
   ON_Curve is a pure virtual class for curve objects
@@ -812,6 +814,50 @@ public:
          int* hint = 0
          ) const;
 
+  // Description:
+  //   Versions of EvPoint(), Ev1Der() and Ev2Der() that use the hint
+  //   and scratch memory in an evaluation context.  When each thread
+  //   uses its own context, these may be called from many threads on
+  //   the same curve. See ON_EvaluationContext for details.
+  // Parameters:
+  //   t - [in] evaluation parameter
+  //   point - [out] value of curve at t
+  //   first_derivative - [out] value of first derivative at t
+  //   second_derivative - [out] value of second derivative at t
+  //   side - [in] determines which side to evaluate from
+  //               =0   default
+  //               <0   to evaluate from below, 
+  //               >0   to evaluate from above
+  //   context - [in/out] evaluation context
+  // Returns:
+  //   false if unable to evaluate.
+  // Remarks:
+  //   Call Evaluate(...,context.CurveHint()) to get the full 
+  //   Dimension() coordinates or higher derivatives.
+  bool EvPoint(
+         double t,
+         ON_3dPoint& point, 
+         int side,
+         class ON_EvaluationContext& context
+         ) const;
+
+  bool Ev1Der(
+         double t,
+         ON_3dPoint& point,
+         ON_3dVector& first_derivative,
+         int side,
+         class ON_EvaluationContext& context
+         ) const;
+
+  bool Ev2Der(
+         double t,
+         ON_3dPoint& point,
+         ON_3dVector& first_derivative,
+         ON_3dVector& second_derivative,
+         int side,
+         class ON_EvaluationContext& context
+         ) const;
+
   /*
   Description:
     Evaluate unit tangent at a parameter with error checking.
@@ -941,6 +987,346 @@ public:
          int* hint = 0
          ) const = 0;
 
+  /*
+  Description:
+    Evaluate the curve at many parameters.
+  Parameters:
+    t_count - [in] number of parameters.
+    t - [in] array of t_count evaluation parameters.
+      Evaluation is fastest when the parameters are sorted.
+    der_count - [in] (>=0) number of derivatives to evaluate
+    v_stride - [in] (>=t_count) stride between the coordinate arrays in v[]
+    v - [out] array of length (der_count+1)*Dimension()*v_stride.
+        The results are returned in coordinate arrays. Coordinate j of
+        the k-th derivative at t[i] is returned in
+
+          v[(k*Dimension() + j)*v_stride + i].
+
+        For example, when der_count = 1 and the curve is 3 dimensional, the
+        x, y and z coordinates of the points are returned in v[0],
+        v[v_stride] and v[2*v_stride], and the x, y and z coordinates of the
+        first derivatives are returned in v[3*v_stride], v[4*v_stride] and
+        v[5*v_stride].
+    side - [in] optional - determines which side to evaluate from
+                =0   default
+                <0   to evaluate from below, 
+                >0   to evaluate from above
+  Returns:
+    false if unable to evaluate one or more parameters.
+  Remarks:
+    The default implementation calls Evaluate() for each parameter.
+    ON_NurbsCurve evaluates consecutive parameters that are in the same
+    span together.
+  See Also:
+    ON_Curve::Evaluate
+  */
+  virtual
+  bool BatchEvaluate(
+         size_t t_count,
+         const double* t,
+         int der_count,
+         size_t v_stride,
+         double* v,
+         int side = 0
+         ) const;
+
+  /*
+  Description:
+    Find the point on the curve that is closest to test_point.
+  Parameters:
+    test_point - [in]
+    t - [out] parameter of the closest point is returned here.
+    maximum_distance - [in]
+      If maximum_distance > 0, then only points whose distance to
+      test_point is <= maximum_distance are considered. Using a positive
+      value of maximum_distance can substantially speed the search.
+    sub_domain - [in]
+      If sub_domain is not nullptr, the search is restricted to the
+      part of the curve with parameters in sub_domain.
+  Returns:
+    true if a point was found.
+  Remarks:
+    The NURBS form of the curve is split into Bezier spans. The spans whose
+    bounding boxes may contain a closer point are searched in order of
+    distance and the closest point on each span is found with
+    ON_FindLocalMinimum(). Only 1, 2 and 3 dimensional curves are
+    supported. Use GetClosestPoints() to project many points onto the
+    same curve.
+  See Also:
+    ON_Curve::GetClosestPoints
+  */
+  bool GetClosestPoint(
+         const ON_3dPoint& test_point,
+         double* t,
+         double maximum_distance = 0.0,
+         const ON_Interval* sub_domain = nullptr
+         ) const;
+
+  /*
+  Description:
+    Find the points on the curve that are closest to a list of test points.
+  Parameters:
+    point_count - [in] number of test points.
+    points - [in] array of point_count test points.
+    t - [out]
+      array of point_count parameters. t[i] is the parameter of the point
+      closest to points[i] or ON_UNSET_VALUE if no point was found.
+    maximum_distance - [in]
+    sub_domain - [in]
+      See GetClosestPoint().
+    thread_count - [in]
+      Maximum number of threads to use. 0 uses one thread per core
+      and 1 does all the work on the calling thread.
+  Returns:
+    Number of test points whose closest point was found.
+  Remarks:
+    The Bezier spans and their bounding box tree are created once and
+    shared by all the threads.
+  See Also:
+    ON_Curve::GetClosestPoint
+  */
+  size_t GetClosestPoints(
+         size_t point_count,
+         const ON_3dPoint* points,
+         double* t,
+         double maximum_distance = 0.0,
+         const ON_Interval* sub_domain = nullptr,
+         unsigned int thread_count = 0
+         ) const;
+
+  /*
+  Description:
+    Get a polyline approximation of the curve.
+  Parameters:
+    mp - [in]
+      Tessellation parameters. Parameters that are zero are ignored.
+      m_tolerance limits the distance from a chord midpoint to the curve,
+      m_max_chr limits that distance divided by the chord length,
+      m_max_ang_radians limits the angle between the tangents at the ends
+      of a chord and m_max_edge_length and m_min_edge_length limit the
+      chord length. When every parameter is zero, each span is divided
+      into Degree() chords.
+    polyline - [in]
+      If polyline is not nullptr, the points and parameters are appended
+      to polyline. Otherwise a polyline is allocated with operator new.
+    bSkipFirstPoint - [in]
+      If true, the point at the start of the domain is not appended. Use
+      this to tessellate a chain of curves into a single polyline.
+    domain - [in]
+      If domain is not nullptr, only the part of the curve with
+      parameters in domain is tessellated.
+  Returns:
+    A pointer to the polyline or nullptr if the input was not valid.
+  Remarks:
+    The chords of polylines and line segments are used directly and the
+    chords of arcs are equal. Other curves are split at the span
+    boundaries reported by GetSpanVector(), so kinks are vertices, and
+    the chords are bisected until the parameters are met. ON_PolyCurve
+    segments are tessellated individually when m_main_seg_count is zero.
+    Curves that are not modified may be tessellated concurrently.
+  See Also:
+    ON_Curve::MeshCurves
+  */
+  class ON_PolylineCurve* MeshCurve(
+    const ON_MeshCurveParameters& mp,
+    class ON_PolylineCurve* polyline,
+    bool bSkipFirstPoint,
+    const ON_Interval* domain
+    ) const;
+
+  /*
+  Description:
+    Tessellate a list of curves.
+  Parameters:
+    curve_count - [in]
+    curves - [in] array of curve_count curves. Null pointers are permitted.
+    mp - [in] Tessellation parameters. See MeshCurve().
+    polylines - [out]
+      curve_count polylines are appended. polylines[i] is the tessellation
+      of curves[i] or nullptr if curves[i] could not be tessellated. The
+      caller must delete the polylines.
+    thread_count - [in]
+      Maximum number of threads to use. 0 uses one thread per core
+      and 1 does all the work on the calling thread.
+  Returns:
+    Number of curves that were tessellated.
+  See Also:
+    ON_Curve::MeshCurve
+    ONX_Model::GetCurvePolylines
+  */
+  static unsigned int MeshCurves(
+    size_t curve_count,
+    const ON_Curve* const* curves,
+    const ON_MeshCurveParameters& mp,
+    ON_SimpleArray<class ON_PolylineCurve*>& polylines,
+    unsigned int thread_count
+    );
+
+  /*
+  Returns:
+    A runtime serial number that changes every time the curve's
+    runtime cache is destroyed. The functions that modify the
+    geometry of a curve call DestroyCurveTree(), so a change in this
+    value means the shape or parameterization may have changed.
+    Every curve gets a new value when it is constructed or assigned,
+    so a table made for a curve that was destroyed is never current
+    for a different curve created at the same address.
+    ON_PolyCurve and ON_CurveProxy return the largest of their own
+    value and the values of the curves they reference. New serial
+    numbers are always larger, so changing a segment or the curve
+    referenced by a proxy changes the value.
+  Remarks:
+    Writes through pointers and public data members, like 
+    ON_NurbsCurve::CV(i)[0] = x or ON_NurbsCurve::m_cv[], do not
+    change the value. Code that changes a curve this way must call
+    DestroyCurveTree() on the curve that was changed.
+  See Also:
+    ON_CurveArcLength
+  */
+  virtual ON__UINT64 GeometryContentSerialNumber() const;
+
+  /*
+  Description:
+    Change the value of GeometryContentSerialNumber().
+  Returns:
+    The new value of GeometryContentSerialNumber().
+  */
+  ON__UINT64 ChangeGeometryContentSerialNumberForExperts();
+
+  /*
+  Description:
+    Get the length of the curve.
+  Parameters:
+    length - [out]
+    fractional_tolerance - [in]
+      desired fractional precision. fabs(("exact" length from
+      start to t) - arc_length)/arc_length <= fractional_tolerance.
+    sub_domain - [in]
+      If not nullptr, the calculation is performed on the portion
+      of the curve with parameters in sub_domain.
+  Returns:
+    True if the length calculation was successful.
+  Remarks:
+    The length is integrated with adaptive Gauss-Legendre quadrature
+    over the spans reported by GetSpanVector(). Use ON_CurveArcLength
+    when several lengths or arc length parameters are needed.
+  See Also:
+    ON_CurveArcLength
+  */
+  bool GetLength(
+    double* length,
+    double fractional_tolerance = 1.0e-8,
+    const ON_Interval* sub_domain = nullptr
+    ) const;
+
+  /*
+  Description:
+    Same as GetLength(length,fractional_tolerance,sub_domain), 
+    but the arc length table is kept in arc_length. 
+  Parameters:
+    arc_length - [in/out]
+      If arc_length is current for this curve, fractional_tolerance
+      and sub_domain, it is used as is. Otherwise it is created 
+      again. Pass the same table to later calls to skip the 
+      integration.
+  See Also:
+    ON_CurveArcLength::Update
+  */
+  bool GetLength(
+    ON_CurveArcLength& arc_length,
+    double* length,
+    double fractional_tolerance = 1.0e-8,
+    const ON_Interval* sub_domain = nullptr
+    ) const;
+
+  /*
+  Description:
+    Get the parameter of the point on the curve that is a prescribed
+    arc length from the start of the curve.
+  Parameters:
+    s - [in]
+      normalized arc length parameter. 0 <= s <= 1.
+    t - [out]
+      parameter such that the length of the curve from its start to
+      t is s*(length of the curve).
+    fractional_tolerance - [in]
+      desired fractional precision.
+    sub_domain - [in]
+      If not nullptr, the calculation is performed on the portion
+      of the curve with parameters in sub_domain.
+  Returns:
+    True if successful.
+  See Also:
+    ON_Curve::GetNormalizedArcLengthPoints
+    ON_CurveArcLength::NormalizedParameterAt
+  */
+  bool GetNormalizedArcLengthPoint(
+    double s,
+    double* t,
+    double fractional_tolerance = 1.0e-8,
+    const ON_Interval* sub_domain = nullptr
+    ) const;
+
+  /*
+  Description:
+    Get the parameters of points on the curve that are prescribed
+    arc lengths from the start of the curve.
+  Parameters:
+    count - [in]
+      number of parameters in s[] and t[].
+    s - [in]
+      array of normalized arc length parameters. 0 <= s[i] <= 1.
+    t - [out]
+      t[i] is the parameter of the point s[i]*(length of the curve)
+      from the start of the curve.
+    absolute_tolerance - [in]
+      If absolute_tolerance > 0, then the length of the curve from
+      its start to t[i] differs from s[i]*(length of the curve) by
+      at most absolute_tolerance.
+    fractional_tolerance - [in]
+      desired fractional precision of the length.
+    sub_domain - [in]
+      If not nullptr, the calculation is performed on the portion
+      of the curve with parameters in sub_domain.
+  Returns:
+    True if successful.
+  Remarks:
+    The arc length table is built once and shared by all count
+    points.
+  See Also:
+    ON_CurveArcLength
+  */
+  bool GetNormalizedArcLengthPoints(
+    int count,
+    const double* s,
+    double* t,
+    double absolute_tolerance = 0.0,
+    double fractional_tolerance = 1.0e-8,
+    const ON_Interval* sub_domain = nullptr
+    ) const;
+
+  /*
+  Description:
+    Same as GetNormalizedArcLengthPoints(count,s,t,...), but the arc
+    length table is kept in arc_length.
+  Parameters:
+    arc_length - [in/out]
+      If arc_length is current for this curve, fractional_tolerance
+      and sub_domain, it is used as is. Otherwise it is created 
+      again.
+  See Also:
+    ON_CurveArcLength::Update
+  */
+  bool GetNormalizedArcLengthPoints(
+    ON_CurveArcLength& arc_length,
+    int count,
+    const double* s,
+    double* t,
+    double absolute_tolerance = 0.0,
+    double fractional_tolerance = 1.0e-8,
+    const ON_Interval* sub_domain = nullptr
+    ) const;
+
   
 
   /*
@@ -1212,6 +1598,7 @@ protected:
 															double RelTol=ON_SQRT_EPSILON) const;
 
 private:
+  ON__UINT64 m_geometry_content_serial_number = 0;
 };
 
 #if defined(ON_DLL_TEMPLATE)
@@ -1256,6 +1643,214 @@ public:
       ) const;
 };
 
+/*
+Description:
+  ON_CurveArcLength is a table that converts between curve parameters
+  and arc lengths. Create() integrates |curve'(t)| once, using 
+  adaptive Gauss-Legendre quadrature on each span reported by
+  ON_Curve::GetSpanVector(). After that, LengthAt() and ParameterAt()
+  take O(log n) time, where n is the number of table intervals.
+  ParameterAt() finishes with Newton iterations on the curve.
+
+  The table keeps a pointer to the curve and the curve's
+  GeometryContentSerialNumber(). When the curve is changed, the
+  table is stale. IsCurrent() returns false and the queries fail
+  until Create() is called again.
+
+Thread safety:
+  The queries are const and do not modify the table or the curve.
+  Many threads may query the same table at the same time.
+Remarks:
+  The curve must exist as long as the table is used.
+See Also:
+  ON_Curve::GetLength
+  ON_Curve::GetNormalizedArcLengthPoints
+*/
+class ON_CLASS ON_CurveArcLength
+{
+public:
+  ON_CurveArcLength() = default;
+  ~ON_CurveArcLength() = default;
+  ON_CurveArcLength(const ON_CurveArcLength&) = default;
+  ON_CurveArcLength& operator=(const ON_CurveArcLength&) = default;
+
+  /*
+  Description:
+    Build the arc length table.
+  Parameters:
+    curve - [in]
+    fractional_tolerance - [in]
+      desired fractional precision of the lengths.
+    sub_domain - [in]
+      If not nullptr, the table covers the portion of the curve with
+      parameters in sub_domain. Otherwise it covers the whole curve.
+  Returns:
+    True if successful.
+  */
+  bool Create(
+    const ON_Curve& curve,
+    double fractional_tolerance = 1.0e-8,
+    const ON_Interval* sub_domain = nullptr
+    );
+
+  /*
+  Description:
+    Call Create() unless the table is already current for the 
+    same curve, fractional_tolerance and sub_domain.
+  Returns:
+    True if the table is current.
+  */
+  bool Update(
+    const ON_Curve& curve,
+    double fractional_tolerance = 1.0e-8,
+    const ON_Interval* sub_domain = nullptr
+    );
+
+  void Destroy();
+
+  /*
+  Returns:
+    True if the table was created and the curve has not changed 
+    since then.
+  */
+  bool IsCurrent() const;
+
+  /*
+  Returns:
+    True if IsCurrent() is true and the table was created from 
+    curve with the same fractional_tolerance and sub_domain.
+  */
+  bool IsCurrent(
+    const ON_Curve& curve,
+    double fractional_tolerance = 1.0e-8,
+    const ON_Interval* sub_domain = nullptr
+    ) const;
+
+  /*
+  Returns:
+    The curve the table was created from.
+  */
+  const ON_Curve* Curve() const;
+
+  /*
+  Returns:
+    The parameter interval covered by the table.
+  */
+  ON_Interval Domain() const;
+
+  /*
+  Returns:
+    The length of the curve over Domain(), or ON_UNSET_VALUE if the
+    table was not created.
+  */
+  double Length() const;
+
+  /*
+  Returns:
+    The absolute tolerance of the lengths in the table.
+  */
+  double Tolerance() const;
+
+  /*
+  Returns:
+    The number of intervals in the table.
+  */
+  unsigned int IntervalCount() const;
+
+  /*
+  Description:
+    Get the length of the curve from Domain()[0] to t.
+  Parameters:
+    t - [in]
+      parameter in Domain().
+    length - [out]
+  Returns:
+    True if successful.
+  */
+  bool LengthAt(
+    double t,
+    double* length
+    ) const;
+
+  /*
+  Description:
+    Get the parameter of the point that is a given arc length from
+    the start of Domain().
+  Parameters:
+    length - [in]
+      0 <= length <= Length().
+    t - [out]
+    absolute_tolerance - [in]
+      If > 0 and smaller than Tolerance(), the Newton iteration
+      continues until the length error is at most absolute_tolerance.
+  Returns:
+    True if successful.
+  */
+  bool ParameterAt(
+    double length,
+    double* t,
+    double absolute_tolerance = 0.0
+    ) const;
+
+  /*
+  Description:
+    Same as ParameterAt(s*Length(),t,absolute_tolerance).
+  */
+  bool NormalizedParameterAt(
+    double s,
+    double* t,
+    double absolute_tolerance = 0.0
+    ) const;
+
+  /*
+  Description:
+    Divide Domain() into segments of equal length.
+  Parameters:
+    segment_count - [in]
+      number of segments. 
+    t - [out]
+      segment_count+1 parameters are appended, starting with 
+      Domain()[0] and ending with Domain()[1].
+  Returns:
+    Number of parameters appended. 0 if the input is not valid or
+    the table is not current.
+  */
+  unsigned int DivideByCount(
+    unsigned int segment_count,
+    ON_SimpleArray<double>& t
+    ) const;
+
+  /*
+  Description:
+    Divide Domain() into segments with a given length.
+  Parameters:
+    segment_length - [in]
+      > 0
+    t - [out]
+      The parameters of the points at lengths 0, segment_length, 
+      2*segment_length, ... <= Length() are appended.
+  Returns:
+    Number of parameters appended. 0 if the input is not valid or
+    the table is not current.
+  */
+  unsigned int DivideByLength(
+    double segment_length,
+    ON_SimpleArray<double>& t
+    ) const;
+
+private:
+  bool Internal_ParameterAt(double length, double tolerance, double* t, int* hint) const;
+
+  const ON_Curve* m_curve = nullptr;
+  ON__UINT64 m_curve_serial_number = 0;
+  double m_fractional_tolerance = 0.0;
+  double m_tolerance = 0.0;
+  // The table has m_t.Count()-1 intervals. m_s[i] is the length
+  // of the curve from m_t[0] to m_t[i].
+  ON_SimpleArray<double> m_t;
+  ON_SimpleArray<double> m_s;
+};
+
 /*
 Description:
   Trim a curve.
@@ -97,6 +97,20 @@ ON_CurveProxy::ON_CurveProxy( const ON_Curve* c, ON_Interval domain )
 {
 }
 
+ON__UINT64 ON_CurveProxy::GeometryContentSerialNumber() const
+{
+  // DestroyRuntimeCache() only goes from the proxy to the real curve,
+  // so a real curve that is changed by itself has a larger serial number.
+  ON__UINT64 sn = ON_Curve::GeometryContentSerialNumber();
+  if (nullptr != m_real_curve && this != m_real_curve)
+  {
+    const ON__UINT64 real_curve_sn = m_real_curve->GeometryContentSerialNumber();
+    if (real_curve_sn > sn)
+      sn = real_curve_sn;
+  }
+  return sn;
+}
+
 unsigned int ON_CurveProxy::SizeOf() const
 {
   unsigned int sz = ON_Curve::SizeOf();
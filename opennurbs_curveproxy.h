@@ -56,6 +56,9 @@ public:
   // virtual ON_Object::DestroyRuntimeCache override
   void DestroyRuntimeCache( bool bDelete = true ) override;
 
+  // virtual ON_Curve::GeometryContentSerialNumber override
+  ON__UINT64 GeometryContentSerialNumber() const override;
+
 
 
   ON_CurveProxy( const ON_Curve* );
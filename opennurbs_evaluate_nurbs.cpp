@@ -21,6 +21,15 @@
 #error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+// ON_INTERNAL_SIMD_X64, ON_Internal_SIMDLevel()
+#include "opennurbs_internal_defines.h"
+
+#if defined(ON_INTERNAL_SIMD_X64)
+#pragma ON_PRAGMA_WARNING_BEFORE_DIRTY_INCLUDE
+#include <immintrin.h>
+#pragma ON_PRAGMA_WARNING_AFTER_DIRTY_INCLUDE
+#endif
+
 double ON_EvaluateBernsteinBasis(int degree, int i, double t)
 /*****************************************************************************
 Evaluate Bernstein basis polynomial
@@ -447,7 +456,7 @@ bool ON_RemoveBezierSingAt1(
 }
 
 
-bool ON_EvaluateBezier(
+static bool ON_Internal_EvaluateBezier(
                 int dim,              // dimension
                 bool is_rat,          // true if NURBS is rational
                 int order,            // order
@@ -457,7 +466,8 @@ bool ON_EvaluateBezier(
                 int der_count,        // number of derivatives to compute
                 double t,             // evaluation parameter
                 int v_stride,         // v_stride (>=dimension)
-                double* v             // v[(der_count+1)*v_stride] array
+                double* v,            // v[(der_count+1)*v_stride] array
+                double* work          // nullptr or ON_Internal_EvaluateBezierWorkCount() doubles
                 )
 /*****************************************************************************
 Evaluate a Bezier
@@ -555,7 +565,9 @@ RELATED FUNCTIONS:
 
   size_t sizeofCV = (i+j)*sizeof(*CV);
 
-  CV = (double*)( (sizeofCV <= sizeof(stack_buffer)) ? stack_buffer : (free_me=onmalloc(sizeofCV)) );
+  CV = (nullptr != work)
+     ? work
+     : (double*)( (sizeofCV <= sizeof(stack_buffer)) ? stack_buffer : (free_me=onmalloc(sizeofCV)) );
   if (j) {
     memset( CV+i, 0, j*sizeof(*CV) );
   }
@@ -669,7 +681,120 @@ RELATED FUNCTIONS:
   return true;
 }
 
-bool ON_EvaluateNurbsBasis(
+bool ON_EvaluateBezier(
+                int dim,              // dimension
+                bool is_rat,          // true if NURBS is rational
+                int order,            // order
+                int cv_stride,        // cv_stride >= (is_rat)?dim+1:dim
+                const double* cv,     // cv[order*cv_stride] array
+                double t0, double t1, // domain
+                int der_count,        // number of derivatives to compute
+                double t,             // evaluation parameter
+                int v_stride,         // v_stride (>=dimension)
+                double* v             // v[(der_count+1)*v_stride] array
+                )
+{
+  return ON_Internal_EvaluateBezier(dim, is_rat, order, cv_stride, cv, t0, t1, der_count, t, v_stride, v, nullptr);
+}
+
+static void ON_Internal_NurbsBasisEndKnotFix(
+  const int d,
+  double* N
+  )
+{
+  // 16 September 2003 Dale Lear (at Chuck's request)
+  //   When t is at an end knot, do a check to
+  //   get exact values of basis functions.
+  //   The problem being that a0*y above can
+  //   fail to be one by a bit or two when knot
+  //   values are large.
+  int j, r;
+  const double x = 1.0-ON_SQRT_EPSILON;
+  if ( N[0] >= x )
+  {
+    if ( N[0] != 1.0 && N[0] <= 1.0 + ON_SQRT_EPSILON )
+    {
+      r = 1;
+      for ( j = 1; j <= d; j++ )
+      {
+        if (N[j] != 0.0)
+        {
+          r = 0;
+          break;
+        }
+      }
+      if (r)
+        N[0] = 1.0;
+    }
+  }
+  else if ( N[d] >= x )
+  {
+    if ( N[d] != 1.0 && N[d] <= 1.0 + ON_SQRT_EPSILON )
+    {
+      r = 1;
+      for ( j = 0; j < d; j++ )
+      {
+        if ( N[j] != 0.0 )
+        {
+          r = 0;
+          break;
+        }
+      }
+      if (r)
+        N[d] = 1.0;
+    }
+  }
+}
+
+template <int order>
+static void ON_Internal_EvaluateNurbsBasisFixedOrder(
+  const double* knot,
+  double t,
+  double* N 
+  )
+{
+  // Same calculation as the general case in ON_EvaluateNurbsBasis(). 
+  // Because the order is a compile time constant, the loops are 
+  // unrolled and the work space is on the stack.
+  const int d = order-1;
+  double t_k[d], k_t[d];
+  double a0, a1, x, y;
+  double *N0;
+  int j, r;
+
+  if (knot[d-1] == knot[d]) {
+		/* value is defined to be zero on empty spans */
+    memset( N, 0, order*order*sizeof(*N) );
+    return;
+  }
+
+  N  += order*order-1;
+	N[0] = 1.0;
+  knot += d;
+  const double* k0 = knot - 1;
+
+  for (j = 0; j < d; j++ ) {
+		N0 = N;
+    N -= order+1;
+    t_k[j] = t - *k0--;
+    k_t[j] = *knot++ - t;
+		
+    x = 0.0;
+    for (r = 0; r <= j; r++) {
+      a0 = t_k[j-r];
+      a1 = k_t[r];
+      y = N0[r]/(a0 + a1);
+      N[r] = x + a1*y;
+      x = a0*y;
+    }
+
+    N[r] = x;
+  }
+
+  ON_Internal_NurbsBasisEndKnotFix( d, N );
+}
+
+static bool ON_Internal_EvaluateNurbsBasisGeneral(
   int order, 
   const double* knot,
   double t,
@@ -717,47 +842,7 @@ bool ON_EvaluateNurbsBasis(
     N[r] = x;
   }
 
-  // 16 September 2003 Dale Lear (at Chuck's request)
-  //   When t is at an end knot, do a check to
-  //   get exact values of basis functions.
-  //   The problem being that a0*y above can
-  //   fail to be one by a bit or two when knot
-  //   values are large.
-  x = 1.0-ON_SQRT_EPSILON;
-  if ( N[0] >= x )
-  {
-    if ( N[0] != 1.0 && N[0] <= 1.0 + ON_SQRT_EPSILON )
-    {
-      r = 1;
-      for ( j = 1; j <= d; j++ )
-      {
-        if (N[j] != 0.0)
-        {
-          r = 0;
-          break;
-        }
-      }
-      if (r)
-        N[0] = 1.0;
-    }
-  }
-  else if ( N[d] >= x )
-  {
-    if ( N[d] != 1.0 && N[d] <= 1.0 + ON_SQRT_EPSILON )
-    {
-      r = 1;
-      for ( j = 0; j < d; j++ )
-      {
-        if ( N[j] != 0.0 )
-        {
-          r = 0;
-          break;
-        }
-      }
-      if (r)
-        N[d] = 1.0;
-    }
-  }
+  ON_Internal_NurbsBasisEndKnotFix( d, N );
 
   if ( heap_buffer )
     onfree(heap_buffer);
@@ -765,56 +850,77 @@ bool ON_EvaluateNurbsBasis(
   return true;
 }
 
+bool ON_EvaluateNurbsBasis(
+  int order, 
+  const double* knot,
+  double t,
+  double* N 
+  )
+{
+  switch (order)
+  {
+  // Almost all NURBS geometry has degree 1, 2, 3, 4 or 5.
+  case 2: ON_Internal_EvaluateNurbsBasisFixedOrder<2>(knot, t, N); return true;
+  case 3: ON_Internal_EvaluateNurbsBasisFixedOrder<3>(knot, t, N); return true;
+  case 4: ON_Internal_EvaluateNurbsBasisFixedOrder<4>(knot, t, N); return true;
+  case 5: ON_Internal_EvaluateNurbsBasisFixedOrder<5>(knot, t, N); return true;
+  case 6: ON_Internal_EvaluateNurbsBasisFixedOrder<6>(knot, t, N); return true;
+  default: break;
+  }
+  return ON_Internal_EvaluateNurbsBasisGeneral(order, knot, t, N);
+}
 
-bool ON_EvaluateNurbsBasisDerivatives(
+
+static void ON_Internal_NurbsBasisDerivativeKnotReciprocals(
+  int order,
+  const double* knot,
+  int der_count,
+  double* dk
+  )
+{
+  // dk[] has d + (d-1) + ... + (d-der_count+1) doubles, where d = order-1.
+  // The first d are the reciprocals of the knot differences needed for
+  // the 1rst derivative, the next d-1 are the ones needed for the
+  // 2nd derivative, and so on.
+	const double *k0, *k1;
+	int i, j, k;
+	const int d = order-1;
+	for (k = 0; k < der_count; k++) {
+		j = d-k;
+		k0 = knot++;
+		k1 = k0 + j;
+		for (i = 0; i < j; i++) 
+			*dk++ = 1.0/(*k1++ - *k0++);
+	}
+}
+
+static void ON_Internal_EvaluateNurbsBasisDerivatives(
   int order,
-  const double* knot, 
   int der_count,
+  const double* dk_buffer, // from ON_Internal_NurbsBasisDerivativeKnotReciprocals()
+  double* a0,              // workspace for 2*order doubles
+  const double** dk,       // workspace for der_count+1 pointers
   double* N 
-)
+  )
 {
 	double dN, c;
-	const double *k0, *k1;
-	double *a0, *a1, *ptr, **dk;
+	double *a1, *ptr;
 	int i, j, k, jmax;
 
 	const int d = order-1;
 	const int Nstride = -der_count*order;
 
-	/* workspaces for knot differences and coefficients 
-	 *
-	 * a0[] and a1[] have order doubles
-	 *
-	 * dk[0] = array of d knot differences
+	a1 = a0 + order;
+
+	/* dk[0] = array of d knot differences
 	 * dk[1] = array of (d-1) knot differences
 	 *
 	 * dk[der_count-1] = 1.0/(knot[d] - knot[d-1])
 	 * dk[der_count] = dummy pointer to make loop efficient
 	 */
-
-	//dk = (double**)alloca( (der_count+1) << 3 ); /* << 3 in case pointers are 8 bytes long */
-	//a0 = (double*)alloca( (order*(2 + ((d+1)>>1))) << 3 ); /* d for a0, d for a1, d*order/2 for dk[]'s and slop to avoid /2 */
-	//a1 = a0 + order;
-
-  double stack_buffer[80];
-  void* heap_buffer = 0;
-  const size_t dbl_count = (order*(2 + ((d+1)>>1)));
-  const size_t sz = ( dbl_count*sizeof(*a0) + (der_count+1)*sizeof(*dk) );
-
-  a0 = (sz <= sizeof(stack_buffer)) ? stack_buffer : (double*)(heap_buffer = onmalloc(sz));
-	a1 = a0 + order;
-  dk = (double**)(a0 + dbl_count);
-
-	/* initialize reciprocal of knot differences */
-	dk[0] = a1 + order;
-	for (k = 0; k < der_count; k++) {
-		j = d-k;
-		k0 = knot++;
-		k1 = k0 + j;
-		for (i = 0; i < j; i++) 
-			dk[k][i] = 1.0/(*k1++ - *k0++);
-		dk[k+1] = dk[k] + j;
-	}
+	dk[0] = dk_buffer;
+	for (k = 0; k < der_count; k++)
+		dk[k+1] = dk[k] + (d-k);
 	dk--;
 	/* dk[1] = 1/{t[d]-t[0], t[d+1]-t[1], ..., t[2d-2] - t[d-2], t[2d-1] - t[d-1]}
 	 *       = diffs needed for 1rst derivative
@@ -878,6 +984,34 @@ bool ON_EvaluateNurbsBasisDerivatives(
 		dN -= 1.0;
 		c *= dN;
 	}
+}
+
+bool ON_EvaluateNurbsBasisDerivatives(
+  int order,
+  const double* knot, 
+  int der_count,
+  double* N 
+)
+{
+	/* workspaces for knot differences and coefficients 
+	 *
+	 * a0[] and a1[] have order doubles
+	 *
+	 * dk_buffer[] = d + (d-1) + ... knot differences
+	 */
+  const int d = order-1;
+  double stack_buffer[80];
+  void* heap_buffer = 0;
+  const size_t dbl_count = (order*(2 + ((d+1)>>1)));
+  const size_t sz = ( dbl_count*sizeof(double) + (der_count+1)*sizeof(double*) );
+
+  double* a0 = (sz <= sizeof(stack_buffer)) ? stack_buffer : (double*)(heap_buffer = onmalloc(sz));
+  double* dk_buffer = a0 + 2*order;
+  const double** dk = (const double**)(a0 + dbl_count);
+
+	/* initialize reciprocal of knot differences */
+  ON_Internal_NurbsBasisDerivativeKnotReciprocals(order, knot, der_count, dk_buffer);
+  ON_Internal_EvaluateNurbsBasisDerivatives(order, der_count, dk_buffer, a0, dk, N);
 
   if ( 0 != heap_buffer )
     onfree(heap_buffer);
@@ -885,8 +1019,252 @@ bool ON_EvaluateNurbsBasisDerivatives(
   return true;
 }
 
+// v[i*v_stride+k] = N[i*order]*cv[k] + ... + N[i*order+order-1]*cv[(order-1)*cv_stride+k]
+// for 0 <= i < row_count and 0 <= k < dim. The products are added in the
+// same order as the general case in ON_EvaluateNurbsNonRationalSpan().
+template <int order, int dim>
+static void ON_Internal_NurbsSpanSums(
+  int row_count,
+  const double* N,
+  int cv_stride,
+  const double* cv,
+  int v_stride,
+  double* v
+  )
+{
+  double P[dim];
+  int i, j, k;
+  for ( i = 0; i < row_count; i++, N += order, v += v_stride )
+  {
+    for ( k = 0; k < dim; k++ )
+      P[k] = 0.0;
+    for ( j = 0; j < order; j++ )
+    {
+      const double a = N[j];
+      const double* c = cv + j*cv_stride;
+      for ( k = 0; k < dim; k++ )
+        P[k] += a*c[k];
+    }
+    for ( k = 0; k < dim; k++ )
+      v[k] = P[k];
+  }
+}
+
+#if defined(ON_INTERNAL_SIMD_X64)
+
+// The SSE2 and AVX2 versions do the same multiplications and additions
+// in the same order as ON_Internal_NurbsSpanSums() (no fused multiply-add),
+// so the results are identical. 1 <= dim <= 4.
+
+template <int order, int dim>
+static void ON_Internal_SSE2_NurbsSpanSums(
+  int row_count,
+  const double* N,
+  int cv_stride,
+  const double* cv,
+  int v_stride,
+  double* v
+  )
+{
+  for ( int i = 0; i < row_count; i++, N += order, v += v_stride )
+  {
+    __m128d P01 = _mm_setzero_pd();
+    __m128d P23 = _mm_setzero_pd();
+    const double* c = cv;
+    for ( int j = 0; j < order; j++, c += cv_stride )
+    {
+      const __m128d a = _mm_set1_pd(N[j]);
+      if ( 1 == dim )
+        P01 = _mm_add_sd(P01, _mm_mul_sd(a, _mm_load_sd(c)));
+      else
+        P01 = _mm_add_pd(P01, _mm_mul_pd(a, _mm_loadu_pd(c)));
+      if ( 3 == dim )
+        P23 = _mm_add_sd(P23, _mm_mul_sd(a, _mm_load_sd(c+2)));
+      else if ( 4 == dim )
+        P23 = _mm_add_pd(P23, _mm_mul_pd(a, _mm_loadu_pd(c+2)));
+    }
+    if ( 1 == dim )
+      _mm_store_sd(v, P01);
+    else
+      _mm_storeu_pd(v, P01);
+    if ( 3 == dim )
+      _mm_store_sd(v+2, P23);
+    else if ( 4 == dim )
+      _mm_storeu_pd(v+2, P23);
+  }
+}
+
+template <int order, int dim>
+ON_INTERNAL_AVX2_FUNCTION
+static void ON_Internal_AVX2_NurbsSpanSums(
+  int row_count,
+  const double* N,
+  int cv_stride,
+  const double* cv,
+  int v_stride,
+  double* v
+  )
+{
+  // The mask keeps the loads and stores inside the dim coordinates.
+  const __m256i mask = _mm256_set_epi64x(
+    (dim > 3) ? -1 : 0,
+    (dim > 2) ? -1 : 0,
+    (dim > 1) ? -1 : 0,
+    -1
+  );
+  for ( int i = 0; i < row_count; i++, N += order, v += v_stride )
+  {
+    __m256d P = _mm256_setzero_pd();
+    const double* c = cv;
+    for ( int j = 0; j < order; j++, c += cv_stride )
+      P = _mm256_add_pd(P, _mm256_mul_pd(_mm256_set1_pd(N[j]), _mm256_maskload_pd(c, mask)));
+    _mm256_maskstore_pd(v, mask, P);
+  }
+}
+
+#endif
+
+/*
+Parameters:
+  simd_level - [in]
+    0: portable code, 1: SSE2, 2: AVX2. See ON_Internal_SIMDLevel().
+*/
+template <int order, int dim, int simd_level>
+static void ON_Internal_EvaluateNurbsNonRationalSpanFixed(
+                  const double* knot,  // knot[] array of (2*order-2) doubles
+                  int cv_stride,       // cv_stride >= dim
+                  const double* cv,    // cv[order*cv_stride] array
+                  int der_count,       // number of derivatives to compute
+                  double t,            // evaluation parameter
+                  int v_stride,        // v_stride (>=dimension)
+                  double* v            // v[(der_count+1)*v_stride] array
+                  )
+{
+  // Same calculation as the general case in ON_EvaluateNurbsNonRationalSpan().
+  // Because the order and dimension are compile time constants, the 
+  // contraction loops are unrolled and the work space is on the stack.
+  // The order of the additions is not changed, so the results are 
+  // identical to the general case. ON_TestNurbsSpanEvaluation() checks this.
+  double N[order*order];
+  int i, k;
+
+  const int N_der_count = (der_count >= order) ? order-1 : der_count;
+
+  ON_Internal_EvaluateNurbsBasisFixedOrder<order>( knot, t, N );
+  if ( N_der_count )
+    ON_EvaluateNurbsBasisDerivatives( order, knot, N_der_count, N );
+
+#if defined(ON_INTERNAL_SIMD_X64)
+  if ( 2 == simd_level )
+    ON_Internal_AVX2_NurbsSpanSums<order,dim>( N_der_count+1, N, cv_stride, cv, v_stride, v );
+  else if ( 1 == simd_level )
+    ON_Internal_SSE2_NurbsSpanSums<order,dim>( N_der_count+1, N, cv_stride, cv, v_stride, v );
+  else
+#endif
+  ON_Internal_NurbsSpanSums<order,dim>( N_der_count+1, N, cv_stride, cv, v_stride, v );
+
+  for ( i = 0; i <= der_count; i++, v += v_stride )
+  {
+    if ( i > N_der_count )
+    {
+      // derivatives of order >= order are zero
+      for ( k = 0; k < dim; k++ )
+        v[k] = 0.0;
+    }
+    if ( cv_stride == dim )
+    {
+      // The general case sets all of v[] when the cvs are packed.
+      for ( k = dim; k < v_stride; k++ )
+        v[k] = 0.0;
+    }
+  }
+
+  if ( 2 == order )
+  {
+    // See the 7 January 2004 comment in ON_EvaluateNurbsNonRationalSpan().
+    v -= (der_count+1)*v_stride;
+    for ( k = 0; k < dim; k++ )
+    {
+      if ( cv[k] == cv[cv_stride+k] )
+        v[k] = cv[k];
+    }
+  }
+}
+
+template <int order, int simd_level>
+static bool ON_Internal_EvaluateNurbsNonRationalSpanFixedOrder(
+                  int dim,
+                  const double* knot,
+                  int cv_stride,
+                  const double* cv,
+                  int der_count,
+                  double t,
+                  int v_stride,
+                  double* v
+                  )
+{
+  // dim = 1 sums are scalar and dim = 2 sums fit in one SSE2 register.
+  switch (dim)
+  {
+  case 1: ON_Internal_EvaluateNurbsNonRationalSpanFixed<order,1,0>(knot, cv_stride, cv, der_count, t, v_stride, v); return true;
+  case 2: ON_Internal_EvaluateNurbsNonRationalSpanFixed<order,2,(simd_level > 0) ? 1 : 0>(knot, cv_stride, cv, der_count, t, v_stride, v); return true;
+  case 3: ON_Internal_EvaluateNurbsNonRationalSpanFixed<order,3,simd_level>(knot, cv_stride, cv, der_count, t, v_stride, v); return true;
+  case 4: ON_Internal_EvaluateNurbsNonRationalSpanFixed<order,4,simd_level>(knot, cv_stride, cv, der_count, t, v_stride, v); return true;
+  default: break;
+  }
+  return false;
+}
+
+template <int order>
+static bool ON_Internal_EvaluateNurbsNonRationalSpanFixedOrder(
+                  int simd_level,
+                  int dim,
+                  const double* knot,
+                  int cv_stride,
+                  const double* cv,
+                  int der_count,
+                  double t,
+                  int v_stride,
+                  double* v
+                  )
+{
+  switch (simd_level)
+  {
+  case 2: return ON_Internal_EvaluateNurbsNonRationalSpanFixedOrder<order,2>(dim, knot, cv_stride, cv, der_count, t, v_stride, v);
+  case 1: return ON_Internal_EvaluateNurbsNonRationalSpanFixedOrder<order,1>(dim, knot, cv_stride, cv, der_count, t, v_stride, v);
+  default: break;
+  }
+  return ON_Internal_EvaluateNurbsNonRationalSpanFixedOrder<order,0>(dim, knot, cv_stride, cv, der_count, t, v_stride, v);
+}
+
+static bool ON_Internal_EvaluateNurbsNonRationalSpanFixedOrder(
+                  int simd_level,
+                  int dim,
+                  int order,
+                  const double* knot,
+                  int cv_stride,
+                  const double* cv,
+                  int der_count,
+                  double t,
+                  int v_stride,
+                  double* v
+                  )
+{
+  // Rational curves in 3d space use dim = 4 here.
+  switch (order)
+  {
+  case 2: return ON_Internal_EvaluateNurbsNonRationalSpanFixedOrder<2>(simd_level, dim, knot, cv_stride, cv, der_count, t, v_stride, v);
+  case 3: return ON_Internal_EvaluateNurbsNonRationalSpanFixedOrder<3>(simd_level, dim, knot, cv_stride, cv, der_count, t, v_stride, v);
+  case 4: return ON_Internal_EvaluateNurbsNonRationalSpanFixedOrder<4>(simd_level, dim, knot, cv_stride, cv, der_count, t, v_stride, v);
+  case 5: return ON_Internal_EvaluateNurbsNonRationalSpanFixedOrder<5>(simd_level, dim, knot, cv_stride, cv, der_count, t, v_stride, v);
+  case 6: return ON_Internal_EvaluateNurbsNonRationalSpanFixedOrder<6>(simd_level, dim, knot, cv_stride, cv, der_count, t, v_stride, v);
+  default: break;
+  }
+  return false;
+}
+
 static
-bool ON_EvaluateNurbsNonRationalSpan( 
+bool ON_Internal_EvaluateNurbsNonRationalSpanGeneral( 
                   int dim,             // dimension
                   int order,           // order
                   const double* knot,  // knot[] array of (2*order-2) doubles
@@ -895,7 +1273,8 @@ bool ON_EvaluateNurbsNonRationalSpan(
                   int der_count,       // number of derivatives to compute
                   double t,            // evaluation parameter
                   int v_stride,        // v_stride (>=dimension)
-                  double* v            // v[(der_count+1)*v_stride] array
+                  double* v,           // v[(der_count+1)*v_stride] array
+                  double* work         // nullptr or order*order doubles
                   )
 {
   const int stride_minus_dim = cv_stride - dim;
@@ -908,7 +1287,9 @@ bool ON_EvaluateNurbsNonRationalSpan(
   void* heap_buffer = 0;
   const size_t sizeof_buffer = (order*order)*sizeof(*N);
 
-	N = (sizeof_buffer <= sizeof(stack_buffer)) ? stack_buffer : (double*)(heap_buffer=onmalloc(sizeof_buffer));
+  N = (nullptr != work)
+    ? work
+    : ((sizeof_buffer <= sizeof(stack_buffer)) ? stack_buffer : (double*)(heap_buffer=onmalloc(sizeof_buffer)));
 
   if ( stride_minus_dim > 0)
   {
@@ -966,6 +1347,112 @@ bool ON_EvaluateNurbsNonRationalSpan(
 	return true;
 }
 
+static
+bool ON_EvaluateNurbsNonRationalSpan( 
+                  int dim,             // dimension
+                  int order,           // order
+                  const double* knot,  // knot[] array of (2*order-2) doubles
+                  int cv_stride,       // cv_stride >= (is_rat)?dim+1:dim
+                  const double* cv,    // cv[order*cv_stride] array
+                  int der_count,       // number of derivatives to compute
+                  double t,            // evaluation parameter
+                  int v_stride,        // v_stride (>=dimension)
+                  double* v,           // v[(der_count+1)*v_stride] array
+                  double* work         // nullptr or order*order doubles
+                  )
+{
+  static const int simd_level = ON_Internal_SIMDLevel();
+  if ( ON_Internal_EvaluateNurbsNonRationalSpanFixedOrder(simd_level, dim, order, knot, cv_stride, cv, der_count, t, v_stride, v) )
+    return true;
+  return ON_Internal_EvaluateNurbsNonRationalSpanGeneral(dim, order, knot, cv_stride, cv, der_count, t, v_stride, v, work);
+}
+
+unsigned int ON_TestNurbsSpanEvaluation( ON_TextLog* text_log )
+{
+  // Random spans of every order and dimension that has a fixed order 
+  // kernel. Some knots are repeated so empty spans and end knot fixes 
+  // are tested too. The results must be bit-identical.
+  ON_RandomNumberGenerator rng;
+  rng.Seed(13);
+  const int simd_level = ON_Internal_SIMDLevel();
+  unsigned int failure_count = 0;
+
+  const int max_order = 6;
+  const int max_dim = 4;
+  const int v_capacity = (max_order+1)*(max_dim+2);
+  double knot[2*max_order-2];
+  double cv[max_order*(max_dim+1)];
+  double N0[max_order*max_order];
+  double N1[max_order*max_order];
+  double v0[v_capacity];
+  double v1[v_capacity];
+
+  for ( int test_index = 0; test_index < 64; test_index++ )
+  {
+    for ( int order = 2; order <= max_order; order++ )
+    {
+      const int d = order-1;
+      for ( int i = 0; i < 2*d; i++ )
+        knot[i] = (test_index%2) ? rng.RandomDouble(-2.0,2.0) : floor(rng.RandomDouble(0.0,4.0));
+      ON_SortDoubleArray( ON::sort_algorithm::quick_sort, knot, 2*d );
+      const double t = (test_index%4 < 2) 
+                     ? rng.RandomDouble(knot[d-1],knot[d]) 
+                     : knot[(test_index%8 < 4) ? d-1 : d];
+
+      // ON_EvaluateNurbsBasisDerivatives() uses the lower degree values
+      // in N[], so all of N[] is compared. Some of N[] is not set.
+      for ( int i = 0; i < order*order; i++ )
+        N0[i] = N1[i] = -1.0;
+      ON_Internal_EvaluateNurbsBasisGeneral( order, knot, t, N0 );
+      ON_EvaluateNurbsBasis( order, knot, t, N1 );
+      if ( 0 != memcmp(N0, N1, order*order*sizeof(N0[0])) )
+      {
+        failure_count++;
+        if ( text_log )
+          text_log->Print("ON_EvaluateNurbsBasis(order=%d) fixed order basis is different.\n", order);
+      }
+
+      for ( int dim = 1; dim <= max_dim; dim++ )
+      {
+        const int cv_stride = dim + (test_index%3 ? 0 : 1);
+        const int v_stride = dim + (test_index%5 ? 0 : 2);
+        for ( int i = 0; i < order*cv_stride; i++ )
+          cv[i] = rng.RandomDouble(-10.0,10.0);
+        if ( test_index%7 == 0 )
+        {
+          // equal coordinates for the order 2 fix
+          for ( int i = 0; i < dim; i++ )
+            cv[cv_stride+i] = cv[i];
+        }
+        for ( int der_count = 0; der_count <= order; der_count++ )
+        {
+          const int v_count = (der_count+1)*v_stride;
+          for ( int i = 0; i < v_count; i++ )
+            v0[i] = v1[i] = -1.0;
+          ON_Internal_EvaluateNurbsNonRationalSpanGeneral(dim, order, knot, cv_stride, cv, der_count, t, v_stride, v0, nullptr);
+          for ( int level = 0; level <= simd_level; level++ )
+          {
+            for ( int i = 0; i < v_count; i++ )
+              v1[i] = -1.0;
+            ON_Internal_EvaluateNurbsNonRationalSpanFixedOrder(level, dim, order, knot, cv_stride, cv, der_count, t, v_stride, v1);
+            if ( 0 != memcmp(v0, v1, v_count*sizeof(v0[0])) )
+            {
+              failure_count++;
+              if ( text_log )
+                text_log->Print(
+                  "ON_EvaluateNurbsNonRationalSpan(dim=%d,order=%d,der_count=%d) simd level %d is different.\n",
+                  dim, order, der_count, level
+                );
+            }
+          }
+        }
+      }
+    }
+  }
+
+  return failure_count;
+}
+
 static
 bool ON_EvaluateNurbsRationalSpan( 
                   int dim,             // dimension
@@ -976,7 +1463,8 @@ bool ON_EvaluateNurbsRationalSpan(
                   int der_count,       // number of derivatives to compute
                   double t,            // evaluation parameter
                   int v_stride,        // v_stride (>=dimension)
-                  double* v            // v[(der_count+1)*v_stride] array
+                  double* v,           // v[(der_count+1)*v_stride] array
+                  double* work         // nullptr or (der_count+1)*(dim+1) + order*order doubles
                   )
 {
   const int hv_stride = dim+1;
@@ -988,12 +1476,15 @@ bool ON_EvaluateNurbsRationalSpan(
   void* heap_buffer = 0;
   const size_t sizeof_buffer = (der_count+1)*hv_stride*sizeof(*hv);
 
-  hv = (sizeof_buffer <= sizeof(stack_buffer)) 
-     ? stack_buffer 
-     : (double*)(heap_buffer=onmalloc(sizeof_buffer));
+  hv = (nullptr != work)
+     ? work
+     : ((sizeof_buffer <= sizeof(stack_buffer)) 
+       ? stack_buffer 
+       : (double*)(heap_buffer=onmalloc(sizeof_buffer)));
   
   rc = ON_EvaluateNurbsNonRationalSpan( dim+1, order, knot, 
-          cv_stride, cv, der_count, t, hv_stride, hv );
+          cv_stride, cv, der_count, t, hv_stride, hv, 
+          (nullptr != work) ? (work + (der_count+1)*hv_stride) : nullptr );
   if (rc) 
   {
     rc = ON_EvaluateQuotientRule(dim, der_count, hv_stride, hv);
@@ -1015,7 +1506,7 @@ bool ON_EvaluateNurbsRationalSpan(
 }
 
 
-bool ON_EvaluateNurbsSpan( 
+static bool ON_Internal_EvaluateNurbsSpan( 
                   int dim,             // dimension
                   bool is_rat,         // true if NURBS is rational
                   int order,           // order
@@ -1025,31 +1516,197 @@ bool ON_EvaluateNurbsSpan(
                   int der_count,       // number of derivatives to compute
                   double t,            // evaluation parameter
                   int v_stride,        // v_stride (>=dimension)
-                  double* v            // v[(der_count+1)*v_stride] array
+                  double* v,           // v[(der_count+1)*v_stride] array
+                  double* work         // nullptr or ON_Internal_NurbsSpanWorkCount() doubles
                   )
 {
   bool rc = false;
   if ( knot[0] == knot[order-2] && knot[order-1] == knot[2*order-3] ) {
     // Bezier span - use faster Bezier evaluator
-    rc = ON_EvaluateBezier(dim, is_rat, order, cv_stride, cv,
+    rc = ON_Internal_EvaluateBezier(dim, is_rat, order, cv_stride, cv,
                             knot[order-2], knot[order-1],
-                            der_count, t, v_stride, v);
+                            der_count, t, v_stride, v, work);
   }
   else {
     // generic NURBS span evaluation
     rc = (is_rat)
          ? ON_EvaluateNurbsRationalSpan( 
               dim, order, knot, cv_stride, cv,
-              der_count, t, v_stride, v )
+              der_count, t, v_stride, v, work )
          : ON_EvaluateNurbsNonRationalSpan( 
               dim, order, knot, cv_stride, cv,
-              der_count, t, v_stride, v );
+              der_count, t, v_stride, v, work );
   }
   return rc;
 }
 
+static size_t ON_Internal_NurbsSpanWorkCount(
+  int dim,
+  bool is_rat,
+  int order,
+  int der_count
+  )
+{
+  // Enough for ON_Internal_EvaluateBezier(), ON_EvaluateNurbsRationalSpan()
+  // and ON_EvaluateNurbsNonRationalSpan().
+  const size_t cvdim = (size_t)(is_rat ? (dim+1) : dim);
+  return cvdim*(size_t)(order + der_count + 1) + (size_t)order*(size_t)order;
+}
 
-bool ON_EvaluateNurbsSurfaceSpan(
+bool ON_EvaluateNurbsSpan( 
+                  int dim,             // dimension
+                  bool is_rat,         // true if NURBS is rational
+                  int order,           // order
+                  const double* knot,  // knot[] array of (2*order-2) doubles
+                  int cv_stride,       // cv_stride >= (is_rat)?dim+1:dim
+                  const double* cv,    // cv[order*cv_stride] array
+                  int der_count,       // number of derivatives to compute
+                  double t,            // evaluation parameter
+                  int v_stride,        // v_stride (>=dimension)
+                  double* v            // v[(der_count+1)*v_stride] array
+                  )
+{
+  return ON_Internal_EvaluateNurbsSpan(dim, is_rat, order, knot, cv_stride, cv, der_count, t, v_stride, v, nullptr);
+}
+
+bool ON_EvaluateNurbsSpan( 
+                  int dim,
+                  bool is_rat,
+                  int order,
+                  const double* knot,
+                  int cv_stride,
+                  const double* cv,
+                  int der_count,
+                  double t,
+                  int v_stride,
+                  double* v,
+                  ON_EvaluationContext& context
+                  )
+{
+  if ( dim < 1 || order < 2 || der_count < 0 )
+    return false;
+  double* work = context.EvaluatorWorkspace(ON_Internal_NurbsSpanWorkCount(dim, is_rat, order, der_count));
+  if ( nullptr == work )
+    return false;
+  return ON_Internal_EvaluateNurbsSpan(dim, is_rat, order, knot, cv_stride, cv, der_count, t, v_stride, v, work);
+}
+
+
+bool ON_EvaluateNurbsSpanBatch( 
+                  int dim,
+                  bool is_rat,
+                  int order,
+                  const double* knot,
+                  int cv_stride,
+                  const double* cv,
+                  int der_count,
+                  size_t t_count,
+                  const double* t,
+                  size_t v_stride,
+                  double* v
+                  )
+{
+  if ( dim < 1 || order < 2 || der_count < 0 || nullptr == knot || nullptr == cv || nullptr == t || nullptr == v || v_stride < t_count )
+    return false;
+  if ( 0 == t_count )
+    return true;
+
+  const int cvdim = (is_rat) ? dim+1 : dim;
+  const int d = order-1;
+  const bool bBezier = ( knot[0] == knot[order-2] && knot[order-1] == knot[2*order-3] );
+
+  // Everything that depends only on the span is computed once. The values
+  // are the same as the ones computed by ON_EvaluateNurbsSpan(), so the
+  // results are identical to calling ON_EvaluateNurbsSpan() for each t.
+  const int nder_count = (der_count >= order) ? order-1 : der_count; // nonzero homogeneous derivatives
+  const size_t hv_count = (der_count+1)*cvdim;
+  const size_t N_count = order*order;
+  const size_t dk_count = (d*(d+1))/2;
+  const size_t a_count = 2*order;
+  const size_t dbl_count = hv_count + N_count + dk_count + a_count;
+  const size_t sz = dbl_count*sizeof(double) + (der_count+1)*sizeof(double*);
+  double stack_buffer[256];
+  void* heap_buffer = 0;
+  double* hv = (sz <= sizeof(stack_buffer)) ? stack_buffer : (double*)(heap_buffer = onmalloc(sz));
+  double* N = hv + hv_count;
+  double* dk_buffer = N + N_count;
+  double* a0 = dk_buffer + dk_count;
+  const double** dk = (const double**)(hv + dbl_count);
+
+  if ( !bBezier && nder_count > 0 )
+    ON_Internal_NurbsBasisDerivativeKnotReciprocals(order, knot, nder_count, dk_buffer);
+
+  bool rc = true;
+  for ( size_t ti = 0; ti < t_count; ti++ )
+  {
+    if ( bBezier )
+    {
+      // same as ON_EvaluateNurbsSpan()
+      if ( !ON_EvaluateBezier(dim, is_rat, order, cv_stride, cv, knot[order-2], knot[order-1], der_count, t[ti], cvdim, hv) )
+        rc = false;
+    }
+    else
+    {
+      // same as ON_EvaluateNurbsNonRationalSpan() with dimension cvdim
+      memset(hv, 0, hv_count*sizeof(hv[0]));
+      ON_EvaluateNurbsBasis( order, knot, t[ti], N );
+      if ( nder_count > 0 )
+        ON_Internal_EvaluateNurbsBasisDerivatives(order, nder_count, dk_buffer, a0, dk, N);
+
+      double* hvk = hv;
+      const double* Nk = N;
+      for ( int k = 0; k <= nder_count; k++, hvk += cvdim, Nk += order )
+      {
+        const double* cvj = cv;
+        for ( int j = 0; j < order; j++, cvj += cv_stride )
+        {
+          const double a = Nk[j];
+          for ( int i = 0; i < cvdim; i++ )
+            hvk[i] += a*cvj[i];
+        }
+      }
+
+      if ( 2 == order )
+      {
+        for ( int i = 0; i < cvdim; i++ )
+        {
+          if ( cv[i] == cv[cv_stride+i] )
+            hv[i] = cv[i];
+        }
+      }
+
+      if ( is_rat && !ON_EvaluateQuotientRule(dim, der_count, cvdim, hv) )
+        rc = false;
+    }
+
+    // scatter the results into the coordinate arrays
+    for ( int k = 0; k <= der_count; k++ )
+    {
+      for ( int i = 0; i < dim; i++ )
+        v[(k*dim + i)*v_stride + ti] = hv[k*cvdim + i];
+    }
+  }
+
+  if ( 0 != heap_buffer )
+    onfree(heap_buffer);
+
+  return rc;
+}
+
+
+static size_t ON_Internal_NurbsSurfaceSpanWorkCount(
+  int dim,
+  bool is_rat,
+  int order0, int order1,
+  int der_count
+  )
+{
+  const size_t cvdim = (size_t)(is_rat ? (dim+1) : dim);
+  const size_t Pcount = (size_t)(((der_count+1)*(der_count+2))>>1);
+  return (size_t)(order0*order0 + order1*order1) + Pcount*cvdim;
+}
+
+static bool ON_Internal_EvaluateNurbsSurfaceSpan(
         int dim,
         bool is_rat,
         int order0, int order1,
@@ -1060,7 +1717,8 @@ bool ON_EvaluateNurbsSurfaceSpan(
         int der_count,
         double t0, double t1,
         int v_stride, 
-        double* v      // returns values
+        double* v,     // returns values
+        double* work   // nullptr or ON_Internal_NurbsSurfaceSpanWorkCount() doubles
         )
 {
 	const int der_count0 = (der_count >= order0) ? order0-1 : der_count;
@@ -1086,7 +1744,9 @@ bool ON_EvaluateNurbsSurfaceSpan(
 
   sizeof_buffer = ((i + j) << 3) + Pcount*Psize;
 
-  N_0 = (sizeof_buffer <= sizeof(stack_buffer)) ? stack_buffer : (double*)(heap_buffer=onmalloc(sizeof_buffer));
+  N_0 = (nullptr != work)
+      ? work
+      : ((sizeof_buffer <= sizeof(stack_buffer)) ? stack_buffer : (double*)(heap_buffer=onmalloc(sizeof_buffer)));
 	N_1 = N_0 + i;
 	P0  = N_1 + j;
 	memset( P0, 0, Pcount*Psize );
@@ -1242,6 +1902,52 @@ bool ON_EvaluateNurbsSurfaceSpan(
 	return true;
 }
 
+bool ON_EvaluateNurbsSurfaceSpan(
+        int dim,
+        bool is_rat,
+        int order0, int order1,
+        const double* knot0,
+        const double* knot1,
+        int cv_stride0, int cv_stride1,
+        const double* cv0, // cv at "lower left" of bispan
+        int der_count,
+        double t0, double t1,
+        int v_stride, 
+        double* v      // returns values
+        )
+{
+  return ON_Internal_EvaluateNurbsSurfaceSpan(
+    dim, is_rat, order0, order1, knot0, knot1, cv_stride0, cv_stride1, cv0,
+    der_count, t0, t1, v_stride, v, nullptr
+  );
+}
+
+bool ON_EvaluateNurbsSurfaceSpan(
+        int dim,
+        bool is_rat,
+        int order0, int order1,
+        const double* knot0,
+        const double* knot1,
+        int cv_stride0, int cv_stride1,
+        const double* cv0,
+        int der_count,
+        double t0, double t1,
+        int v_stride, 
+        double* v,
+        ON_EvaluationContext& context
+        )
+{
+  if ( dim < 1 || order0 < 2 || order1 < 2 || der_count < 0 )
+    return false;
+  double* work = context.EvaluatorWorkspace(ON_Internal_NurbsSurfaceSpanWorkCount(dim, is_rat, order0, order1, der_count));
+  if ( nullptr == work )
+    return false;
+  return ON_Internal_EvaluateNurbsSurfaceSpan(
+    dim, is_rat, order0, order1, knot0, knot1, cv_stride0, cv_stride1, cv0,
+    der_count, t0, t1, v_stride, v, work
+  );
+}
+
 
 bool ON_EvaluateNurbsDeBoor(
                            int cv_dim,
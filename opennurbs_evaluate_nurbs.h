@@ -255,6 +255,70 @@ bool ON_EvaluateNurbsSpan(
         double* v
         );
 
+/*
+Description:
+  Same as ON_EvaluateNurbsSpan() except the scratch memory comes from
+  context.EvaluatorWorkspace(). Once the context's memory is large 
+  enough, evaluation does not allocate memory.
+*/
+ON_DECL
+bool ON_EvaluateNurbsSpan( 
+        int dim,
+        bool is_rat,
+        int order,
+        const double* knot,
+        int cv_stride,
+        const double* cv,
+        int der_count,
+        double t,
+        int v_stride,
+        double* v,
+        class ON_EvaluationContext& context
+        );
+
+/*
+Description:
+  Evaluate a NURBS curve span at many parameters.
+Parameters:
+  dim, is_rat, order, knot, cv_stride, cv, der_count - [in]
+    Same as ON_EvaluateNurbsSpan().
+  t_count - [in]
+    number of evaluation parameters
+  t - [in]
+    array of t_count evaluation parameters
+  v_stride - [in] (>= t_count)
+    stride between the coordinate arrays in v[].
+  v - [out]
+    An array of length v_stride*dim*(der_count+1). The evaluation
+    results are returned in coordinate arrays. Coordinate j of the
+    k-th derivative at t[i] is returned in
+
+              v[(k*dim + j)*v_stride + i].
+
+Returns:
+  True if successful.
+Remarks:
+  The values are identical to the ones returned by ON_EvaluateNurbsSpan(),
+  but the work that depends only on the span is done once.
+See Also:
+  ON_EvaluateNurbsSpan
+  ON_Curve::BatchEvaluate
+*/
+ON_DECL
+bool ON_EvaluateNurbsSpanBatch( 
+        int dim,
+        bool is_rat,
+        int order,
+        const double* knot,
+        int cv_stride,
+        const double* cv,
+        int der_count,
+        size_t t_count,
+        const double* t,
+        size_t v_stride,
+        double* v
+        );
+
 /*
 Description:
   Evaluate a NURBS surface bispan.
@@ -319,6 +383,31 @@ bool ON_EvaluateNurbsSurfaceSpan(
         int v_stride,
         double* v
         );
+
+/*
+Description:
+  Same as ON_EvaluateNurbsSurfaceSpan() except the scratch memory comes
+  from context.EvaluatorWorkspace(). Once the context's memory is large 
+  enough, evaluation does not allocate memory.
+*/
+ON_DECL
+bool ON_EvaluateNurbsSurfaceSpan(
+        int dim,
+        bool is_rat,
+        int order0, 
+        int order1,
+        const double* knot0,
+        const double* knot1,
+        int cv_stride0,
+        int cv_stride1,
+        const double* cv,
+        int der_count,
+        double s,
+        double t,
+        int v_stride,
+        double* v,
+        class ON_EvaluationContext& context
+        );
             
 
 
@@ -445,6 +534,22 @@ bool ON_EvaluateNurbsBlossom(int, // cvdim,
                             );
 
 
+/*
+Description:
+  Test tool. Evaluates random NURBS spans with the fixed order kernels 
+  used for orders 2 to 6 and dimensions 1 to 4, with every SSE2 / AVX2 
+  kernel the cpu supports, and with the general code. 
+Parameters:
+  text_log - [in]
+    If not nullptr, the evaluations that are different are printed here.
+Returns:
+  Number of evaluations where the results are not bit-identical.
+*/
+ON_DECL
+unsigned int ON_TestNurbsSpanEvaluation( 
+  class ON_TextLog* text_log 
+  );
+
 ON_DECL
 void ON_ConvertNurbSpanToBezier(
         int,       // cvdim (dim+1 for rational curves)
@@ -557,6 +557,139 @@ ON_BoundingBox ONX_Model::RenderLightBoundingBox() const
   return m_render_light_bbox;
 }
 
+unsigned int ONX_Model::GetCurvePolylines(
+  const ON_MeshCurveParameters& mp,
+  unsigned int thread_count,
+  ON_SimpleArray<ON_UUID>& ids,
+  ON_SimpleArray<ON_PolylineCurve*>& polylines
+  ) const
+{
+  ON_SimpleArray<const ON_ModelGeometryComponent*> components(Internal_ComponentListConst(ON_ModelComponent::Type::ModelGeometry).m_count);
+  for (
+    const ONX_ModelComponentReferenceLink* link = Internal_ComponentListConst(ON_ModelComponent::Type::ModelGeometry).m_first_mcr_link;
+    nullptr != link;
+    link = link->m_next
+    )
+  {
+    const ON_ModelGeometryComponent* model_geometry = ON_ModelGeometryComponent::Cast(link->m_mcr.ModelComponent());
+    if (nullptr != model_geometry)
+      components.Append(model_geometry);
+  }
+
+  const unsigned int component_count = components.UnsignedCount();
+  if (0 == component_count)
+    return 0;
+
+  // Geometry(nullptr) decodes deferred geometry and is safe to call
+  // from several threads.
+  ON_SimpleArray<const ON_Curve*> curves(component_count);
+  curves.SetCount(component_count);
+  const unsigned int block_size = 16;
+  const unsigned int block_count = (component_count + block_size - 1) / block_size;
+  ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
+    {
+      const unsigned int i1 = (block + 1)*block_size < component_count ? (block + 1)*block_size : component_count;
+      for (unsigned int i = block * block_size; i < i1; i++)
+        curves[i] = ON_Curve::Cast(components[i]->Geometry(nullptr));
+    }
+  );
+
+  ON_SimpleArray<ON_PolylineCurve*> results(component_count);
+  ON_Curve::MeshCurves(component_count, curves.Array(), mp, results, thread_count);
+
+  unsigned int polyline_count = 0;
+  for (unsigned int i = 0; i < component_count; i++)
+  {
+    if (nullptr == results[i])
+      continue;
+    ids.Append(components[i]->Id());
+    polylines.Append(results[i]);
+    polyline_count++;
+  }
+  return polyline_count;
+}
+
+unsigned int ONX_Model::GetTightBoundingBoxes(
+  unsigned int thread_count,
+  ON_SimpleArray<ON_UUID>& ids,
+  ON_SimpleArray<ON_BoundingBox>& boxes,
+  ON_TightBoundingBoxCache* cache
+  ) const
+{
+  ON_SimpleArray<const ON_ModelGeometryComponent*> components(Internal_ComponentListConst(ON_ModelComponent::Type::ModelGeometry).m_count);
+  for (
+    const ONX_ModelComponentReferenceLink* link = Internal_ComponentListConst(ON_ModelComponent::Type::ModelGeometry).m_first_mcr_link;
+    nullptr != link;
+    link = link->m_next
+    )
+  {
+    const ON_ModelGeometryComponent* model_geometry = ON_ModelGeometryComponent::Cast(link->m_mcr.ModelComponent());
+    if (nullptr != model_geometry)
+      components.Append(model_geometry);
+  }
+
+  const unsigned int component_count = components.UnsignedCount();
+  if (0 == component_count)
+    return 0;
+
+  // Geometry(nullptr) decodes deferred geometry and is safe to call
+  // from several threads.
+  ON_SimpleArray<const ON_Geometry*> geometry(component_count);
+  geometry.SetCount(component_count);
+  const unsigned int block_size = 16;
+  const unsigned int block_count = (component_count + block_size - 1) / block_size;
+  ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
+    {
+      const unsigned int i1 = (block + 1)*block_size < component_count ? (block + 1)*block_size : component_count;
+      for (unsigned int i = block * block_size; i < i1; i++)
+        geometry[i] = components[i]->Geometry(nullptr);
+    }
+  );
+
+  // Boxes found in the cache are not calculated again. The worker 
+  // threads do not use the cache.
+  ON_SimpleArray<ON_BoundingBox> results(component_count);
+  results.SetCount(component_count);
+  ON_SimpleArray<bool> cached(component_count);
+  cached.SetCount(component_count);
+  for (unsigned int i = 0; i < component_count; i++)
+  {
+    results[i] = ON_BoundingBox::UnsetBoundingBox;
+    cached[i] = (nullptr != cache && nullptr != geometry[i] && cache->Find(*geometry[i], results[i]));
+  }
+
+  ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
+    {
+      const unsigned int i1 = (block + 1)*block_size < component_count ? (block + 1)*block_size : component_count;
+      for (unsigned int i = block * block_size; i < i1; i++)
+      {
+        if (!cached[i] && nullptr != geometry[i])
+          geometry[i]->GetTightBoundingBox(results[i], false, nullptr);
+      }
+    }
+  );
+
+  if (nullptr != cache)
+  {
+    for (unsigned int i = 0; i < component_count; i++)
+    {
+      if (!cached[i] && nullptr != geometry[i])
+        cache->Set(*geometry[i], results[i]);
+    }
+  }
+
+  unsigned int box_count = 0;
+  for (unsigned int i = 0; i < component_count; i++)
+  {
+    if (!results[i].IsValid())
+      continue;
+    ids.Append(components[i]->Id());
+    boxes.Append(results[i]);
+    box_count++;
+  }
+  return box_count;
+}
+
 const ON_ComponentManifest& ONX_Model::Manifest() const
 {
   return m_manifest;
@@ -1854,7 +1987,8 @@ ON_ModelComponentReference ONX_Model::Internal_AddModelComponent(
     if (bUpdateComponentIdentification)
     {
       ON_ModelGeometryComponent* geometry_component = ON_ModelGeometryComponent::Cast(model_component);
-      if (nullptr != geometry_component)
+      // Deferred geometry is never a light and is not read here.
+      if (nullptr != geometry_component && false == geometry_component->GeometryIsDeferred())
       {
         const ON_Light* light = ON_Light::Cast(geometry_component->Geometry(nullptr));
         if (nullptr != light)
@@ -3004,6 +3138,9 @@ bool ONX_Model::Read(
 bool ONX_Model::Read(ON_BinaryArchive& archive, unsigned int table_filter,
                      unsigned int model_object_type_filter, ON_TextLog* error_log)
 {
+  if ( 0 == table_filter )
+    table_filter = 0xFFFFFFFF; // read everything
+
   // STEPS 1 to 14: REQUIRED.
   const bool bManageComponents = true;
   IncrementalReadBegin(archive, bManageComponents, table_filter, error_log);
@@ -3011,28 +3148,57 @@ bool ONX_Model::Read(ON_BinaryArchive& archive, unsigned int table_filter,
     return false;
 
   // STEP 15: REQUIRED - Read object (geometry and annotation) table.
-  if (0 == (static_cast<unsigned int>(ON_3dmArchiveTableType::object_table) & table_filter))
+  if (0 != (static_cast<unsigned int>(ON_3dmArchiveTableType::object_table) & table_filter))
   {
     const bool bManageGeometry = true;
     const bool bManageAttributes = true;
-    for (;;)
+    if ((archive.ThreadCount() > 1 || archive.DeferGeometryReading()) && ON_3dmArchiveTableType::Unset == archive.Active3dmTable())
     {
-      ON_ModelComponentReference model_geometry_reference;
-
-      if (!IncrementalReadModelGeometry(archive, bManageComponents, bManageGeometry, bManageAttributes,
-        model_object_type_filter, model_geometry_reference))
+      // Objects are decoded concurrently and added to the model in archive order.
+      if (archive.BeginRead3dmObjectTable())
       {
-        // Catastrophic error.
-        break; 
+        ON_SimpleArray<ON_ModelGeometryComponent*> model_geometry_list;
+        archive.Read3dmModelGeometryTableForExperts(bManageGeometry, bManageAttributes, model_object_type_filter, model_geometry_list);
+        for (unsigned int i = 0; i < model_geometry_list.UnsignedCount(); i++)
+        {
+          ON_ModelGeometryComponent* model_geometry = model_geometry_list[i];
+          if (AddModelComponentForExperts(model_geometry, bManageComponents, true, true).IsEmpty())
+            delete model_geometry;
+        }
+        // If BeginRead3dmObjectTable() returns true, 
+        // then you MUST call EndRead3dmObjectTable().
+        archive.EndRead3dmObjectTable();
       }
+    }
+    else
+    {
+      for (;;)
+      {
+        ON_ModelComponentReference model_geometry_reference;
+
+        if (!IncrementalReadModelGeometry(archive, bManageComponents, bManageGeometry, bManageAttributes,
+          model_object_type_filter, model_geometry_reference))
+        {
+          // Catastrophic error.
+          break; 
+        }
 
-      if (model_geometry_reference.IsEmpty())
-        break; // No more geometry.
+        if (model_geometry_reference.IsEmpty())
+          break; // No more geometry.
+      }
     }
 
     if (0 != archive.CriticalErrorCount())
       return false;
   }
+  else if (archive.BeginRead3dmObjectTable())
+  {
+    // Skip the object table. EndRead3dmObjectTable() seeks past the
+    // table chunk without reading, decompressing or CRC checking the
+    // objects and the history record table is found at the current position.
+    if (!archive.EndRead3dmObjectTable())
+      return false;
+  }
 
   IncrementalReadFinish(archive, bManageComponents, table_filter, error_log);
   if (0 != archive.CriticalErrorCount())
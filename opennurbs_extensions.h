@@ -235,7 +235,7 @@ public:
       If table_filter is zero, then everything in the archive is read.
       Otherwise the bits in table_filter identify what tables should 
       be read.  The bits are defined by the 
-      ON_BInaryArchive::table_type enum.
+      ON_3dmArchiveTableType enum.
     model_object_type_filter - [in]
       If model_object_type_filter is not zero, then it is a bitfield filter 
       made by bitwise oring ON::object_type values to select which types of 
@@ -247,6 +247,19 @@ public:
     Error details are logged in error_log.  If crc errors are in
     the archive, then ONX_Model::m_crc_error_count is set to the 
     number of crc errors.
+  Remarks:
+    The start section, properties and settings are always read.
+    Tables that are not in table_filter and objects that are not in
+    model_object_type_filter are skipped by seeking past their chunks.
+    Skipped content is not decompressed, CRC checked or parsed.
+    For example, a table_filter made from the properties_table,
+    settings_table and layer_table bits reads the model properties,
+    settings and layers without reading any geometry.
+    When archive.ThreadCount() > 1, the object table is decoded
+    concurrently. See ON_BinaryArchive::Read3dmModelGeometryTableForExperts().
+    When archive.DeferGeometryReading() is true, object attributes are read
+    and geometry is read the first time ON_ModelGeometryComponent::Geometry()
+    is called. See ON_BinaryArchive::SetDeferGeometryReading().
   Example:
 
             // for ASCII file names
@@ -1453,6 +1466,73 @@ public:
   */
   ON_BoundingBox RenderLightBoundingBox() const;
 
+  /*
+  Description:
+    Tessellate every curve in the model's geometry table into a polyline.
+  Parameters:
+    mp - [in]
+      tolerances passed to ON_Curve::MeshCurve().
+    thread_count - [in]
+      maximum number of threads to use. 0 uses
+      std::thread::hardware_concurrency() and 1 does all the work on the
+      calling thread.
+    ids - [out]
+    polylines - [out]
+      For each curve that was tessellated, the id of its model component
+      is appended to ids[] and the polyline is appended to polylines[].
+      The caller must delete the polylines.
+  Returns:
+    Number of polylines appended.
+  Remarks:
+    Instance definition geometry is included. Curve geometry that was
+    deferred when the model was read is decoded on the worker threads.
+  See Also:
+    ON_Curve::MeshCurve
+  */
+  unsigned int GetCurvePolylines(
+    const ON_MeshCurveParameters& mp,
+    unsigned int thread_count,
+    ON_SimpleArray<ON_UUID>& ids,
+    ON_SimpleArray<ON_PolylineCurve*>& polylines
+    ) const;
+
+  /*
+  Description:
+    Calculate the tight bounding box of every object in the model's
+    geometry table.
+  Parameters:
+    thread_count - [in]
+      maximum number of threads to use. 0 uses
+      std::thread::hardware_concurrency() and 1 does all the work on the
+      calling thread.
+    ids - [out]
+    boxes - [out]
+      For each object with a valid tight bounding box, the id of its
+      model component is appended to ids[] and the box is appended to
+      boxes[].
+    cache - [in/out]
+      If not nullptr, current boxes of curves and surfaces are taken 
+      from the cache and the boxes that are calculated are saved in it.
+      Pass the same cache to later calls so that only geometry that 
+      changed is bounded again.
+  Returns:
+    Number of boxes appended.
+  Remarks:
+    The cache is read before the worker threads start and updated after
+    they finish. ON_Mesh caches its tight bounding box, so each geometry
+    object must be referenced by only one model component while this
+    function runs.
+  See Also:
+    ON_Geometry::GetTightBoundingBox
+    ON_TightBoundingBoxCache
+  */
+  unsigned int GetTightBoundingBoxes(
+    unsigned int thread_count,
+    ON_SimpleArray<ON_UUID>& ids,
+    ON_SimpleArray<ON_BoundingBox>& boxes,
+    ON_TightBoundingBoxCache* cache = nullptr
+    ) const;
+
 private:
   void Internal_ComponentTypeBoundingBox(
     const ON_ModelComponent::Type component_type,
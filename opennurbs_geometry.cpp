@@ -21,6 +21,9 @@
 #error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+// std::unordered_map
+#include "opennurbs_internal_defines.h"
+
 ON_OBJECT_IMPLEMENT(ON_Geometry,ON_Object,"4ED7D4DA-E947-11d3-BFE5-0010830122F0");
 
 #if defined(ON_HAS_RVALUEREF)
@@ -287,3 +290,232 @@ bool ON_Geometry::EvaluatePoint( const class ON_ObjRef& objref, ON_3dPoint& P )
   return false;
 }
 
+
+class ON_EvaluationContextSubDPoints
+{
+public:
+  // Identifies the ON_SubD set by ON_EvaluationContext::SetSubD().
+  ON__UINT64 m_subd_runtime_serial_number = 0;
+  ON__UINT64 m_subd_geometry_content_serial_number = 0;
+
+  // Component ids are unique for each component type on every level of an ON_SubD.
+  // The key is (component type << 32) | component id.
+  std::unordered_map<ON__UINT64, ON_3dPoint> m_points;
+
+  static ON__UINT64 Key(const ON_SubDComponentPtr& component)
+  {
+    const ON_SubDComponentBase* c = component.ComponentBase();
+    return (nullptr == c) ? 0 : ((((ON__UINT64)component.ComponentType()) << 32) | ((ON__UINT64)c->m_id));
+  }
+};
+
+ON_EvaluationContext::~ON_EvaluationContext()
+{
+  delete m_subd_points;
+}
+
+void ON_EvaluationContext::ClearHints()
+{
+  m_curve_hint = 0;
+  m_surface_hint[0] = 0;
+  m_surface_hint[1] = 0;
+}
+
+int* ON_EvaluationContext::CurveHint()
+{
+  return &m_curve_hint;
+}
+
+int* ON_EvaluationContext::SurfaceHint()
+{
+  return m_surface_hint;
+}
+
+static double* ON_Internal_ContextWorkspace(
+  ON_SimpleArray<double>& a,
+  size_t count
+  )
+{
+  if ( count > (size_t)a.Capacity() )
+  {
+    if ( count > 0x7FFFFFFF )
+    {
+      ON_ERROR("count is too large.");
+      return nullptr;
+    }
+    a.Reserve(count);
+  }
+  return a.Array();
+}
+
+double* ON_EvaluationContext::Workspace(
+  size_t count
+  )
+{
+  return ON_Internal_ContextWorkspace(m_workspace, count);
+}
+
+double* ON_EvaluationContext::EvaluatorWorkspace(
+  size_t count
+  )
+{
+  return ON_Internal_ContextWorkspace(m_evaluator_workspace, count);
+}
+
+void ON_EvaluationContext::SetSubD(
+  const ON_SubD& subd
+  )
+{
+  if ( nullptr == m_subd_points )
+    m_subd_points = new ON_EvaluationContextSubDPoints();
+  const ON__UINT64 runtime_serial_number = subd.RuntimeSerialNumber();
+  const ON__UINT64 geometry_content_serial_number = subd.GeometryContentSerialNumber();
+  if (    runtime_serial_number != m_subd_points->m_subd_runtime_serial_number 
+       || geometry_content_serial_number != m_subd_points->m_subd_geometry_content_serial_number )
+  {
+    m_subd_points->m_points.clear();
+    m_subd_points->m_subd_runtime_serial_number = runtime_serial_number;
+    m_subd_points->m_subd_geometry_content_serial_number = geometry_content_serial_number;
+  }
+}
+
+bool ON_EvaluationContext::GetSubDSubdivisionPoint(
+  const ON_SubDComponentPtr& component,
+  double subdivision_point[3]
+  ) const
+{
+  if ( nullptr == m_subd_points || nullptr == subdivision_point )
+    return false;
+  const ON__UINT64 key = ON_EvaluationContextSubDPoints::Key(component);
+  if ( 0 == key )
+    return false;
+  const auto it = m_subd_points->m_points.find(key);
+  if ( it == m_subd_points->m_points.end() )
+    return false;
+  subdivision_point[0] = it->second.x;
+  subdivision_point[1] = it->second.y;
+  subdivision_point[2] = it->second.z;
+  return true;
+}
+
+void ON_EvaluationContext::SetSubDSubdivisionPoint(
+  const ON_SubDComponentPtr& component,
+  const double subdivision_point[3]
+  )
+{
+  // Points are kept only for the ON_SubD set by SetSubD().
+  if ( nullptr == m_subd_points || 0 == m_subd_points->m_subd_runtime_serial_number || nullptr == subdivision_point )
+    return;
+  const ON__UINT64 key = ON_EvaluationContextSubDPoints::Key(component);
+  if ( 0 != key )
+    m_subd_points->m_points[key] = ON_3dPoint(subdivision_point);
+}
+
+void ON_EvaluationContext::ClearSubDSubdivisionPoints()
+{
+  if ( nullptr != m_subd_points )
+  {
+    m_subd_points->m_points.clear();
+    m_subd_points->m_subd_runtime_serial_number = 0;
+    m_subd_points->m_subd_geometry_content_serial_number = 0;
+  }
+}
+
+void ON_EvaluationContext::Destroy()
+{
+  m_workspace.Destroy();
+  m_evaluator_workspace.Destroy();
+  delete m_subd_points;
+  m_subd_points = nullptr;
+  ClearHints();
+}
+
+class ON_TightBoundingBoxCacheBox
+{
+public:
+  ON__UINT64 m_serial_number = 0;
+  ON_BoundingBox m_bbox = ON_BoundingBox::UnsetBoundingBox;
+};
+
+class ON_TightBoundingBoxCacheBoxes
+{
+public:
+  // The key is the address of the geometry. The serial number tells
+  // if the box is current.
+  std::unordered_map<const ON_Geometry*, ON_TightBoundingBoxCacheBox> m_boxes;
+};
+
+ON_TightBoundingBoxCache::~ON_TightBoundingBoxCache()
+{
+  Destroy();
+}
+
+ON__UINT64 ON_TightBoundingBoxCache::GeometryContentSerialNumber(
+  const ON_Geometry& geometry
+  )
+{
+  const ON_Curve* curve = ON_Curve::Cast(&geometry);
+  if ( nullptr != curve )
+    return curve->GeometryContentSerialNumber();
+  const ON_Surface* surface = ON_Surface::Cast(&geometry);
+  if ( nullptr != surface )
+    return surface->GeometryContentSerialNumber();
+  return 0;
+}
+
+bool ON_TightBoundingBoxCache::GetTightBoundingBox(
+  const ON_Geometry& geometry,
+  ON_BoundingBox& tight_bbox
+  )
+{
+  if ( Find(geometry, tight_bbox) )
+    return true;
+  tight_bbox = ON_BoundingBox::UnsetBoundingBox;
+  if ( !geometry.GetTightBoundingBox(tight_bbox, false, nullptr) || !tight_bbox.IsValid() )
+    return false;
+  Set(geometry, tight_bbox);
+  return true;
+}
+
+bool ON_TightBoundingBoxCache::Find(
+  const ON_Geometry& geometry,
+  ON_BoundingBox& tight_bbox
+  ) const
+{
+  if ( nullptr == m_boxes )
+    return false;
+  const auto it = m_boxes->m_boxes.find(&geometry);
+  if ( it == m_boxes->m_boxes.end() )
+    return false;
+  const ON__UINT64 sn = GeometryContentSerialNumber(geometry);
+  if ( 0 == sn || sn != it->second.m_serial_number )
+    return false;
+  tight_bbox = it->second.m_bbox;
+  return true;
+}
+
+void ON_TightBoundingBoxCache::Set(
+  const ON_Geometry& geometry,
+  const ON_BoundingBox& tight_bbox
+  )
+{
+  const ON__UINT64 sn = GeometryContentSerialNumber(geometry);
+  if ( 0 == sn || !tight_bbox.IsValid() )
+    return;
+  if ( nullptr == m_boxes )
+    m_boxes = new ON_TightBoundingBoxCacheBoxes();
+  ON_TightBoundingBoxCacheBox& box = m_boxes->m_boxes[&geometry];
+  box.m_serial_number = sn;
+  box.m_bbox = tight_bbox;
+}
+
+unsigned int ON_TightBoundingBoxCache::Count() const
+{
+  return (nullptr != m_boxes) ? ((unsigned int)m_boxes->m_boxes.size()) : 0U;
+}
+
+void ON_TightBoundingBoxCache::Destroy()
+{
+  delete m_boxes;
+  m_boxes = nullptr;
+}
@@ -393,5 +393,286 @@ public:
     ) const;
 };
 
+/*
+Description:
+  ON_EvaluationContext holds the state that is carried from one
+  evaluation to the next: the span hints used by ON_Curve and 
+  ON_Surface evaluators, scratch memory that is reused instead
+  of allocating memory on every call, and ON_SubD subdivision points.
+
+  Each thread that evaluates geometry should use its own context.
+  A context may be used with any number of curves and surfaces. The 
+  hints are only starting guesses, so using a context with a different
+  object is safe. Call ClearHints() when switching objects to avoid a 
+  poor first guess.
+
+Thread safety:
+  The const ON_Curve and ON_Surface evaluators do not modify the
+  object being evaluated. The only state they share between calls 
+  is the hint, and the hint is owned by the caller. When every 
+  thread uses its own ON_EvaluationContext (or its own hint), many
+  threads may evaluate the same const curve or surface at the same
+  time.
+
+  The exception is ON_OffsetSurface. The first evaluation after the
+  offset points change solves for the offset function and saves the 
+  solution. Call ON_OffsetSurfaceFunction::Initialize() before 
+  evaluating an ON_OffsetSurface on more than one thread.
+
+  ON_SubD components save subdivision and surface points the first
+  time they are calculated, so the ordinary ON_SubD evaluators modify
+  the components. The ON_SubD evaluators that take an
+  ON_EvaluationContext read the points saved on the components but
+  never save. After SetSubD() is called, subdivision points they 
+  calculate are kept in the context instead. While no thread modifies
+  the ON_SubD or calls an evaluator that saves points, many threads 
+  may evaluate the same ON_SubD with the context versions.
+See Also:
+  ON_Curve::Evaluate
+  ON_Surface::Evaluate
+  ON_SubDVertex::GetSurfacePoint
+*/
+class ON_CLASS ON_EvaluationContext
+{
+public:
+  ON_EvaluationContext() = default;
+  ~ON_EvaluationContext();
+
+  // A context owns scratch memory and is not copied.
+  ON_EvaluationContext(const ON_EvaluationContext&) = delete;
+  ON_EvaluationContext& operator=(const ON_EvaluationContext&) = delete;
+
+  /*
+  Description:
+    Set the curve and surface hints to zero.
+  */
+  void ClearHints();
+
+  /*
+  Returns:
+    The int hint passed to ON_Curve::Evaluate().
+  */
+  int* CurveHint();
+
+  /*
+  Returns:
+    The int[2] hint passed to ON_Surface::Evaluate().
+  */
+  int* SurfaceHint();
+
+  /*
+  Description:
+    Get scratch memory.
+  Parameters:
+    count - [in] number of doubles needed.
+  Returns:
+    An array of at least count doubles. The contents are undefined.
+    The memory is owned by the context and is valid until the next
+    call to Workspace() or until the context is destroyed.
+  */
+  double* Workspace(
+    size_t count
+    );
+
+  /*
+  Description:
+    Get scratch memory for the NURBS span evaluators. 
+    It is different from the Workspace() memory, so the evaluators can
+    use it while they write their results in Workspace() memory.
+  Parameters:
+    count - [in] number of doubles needed.
+  Returns:
+    An array of at least count doubles. The contents are undefined.
+    The memory is valid until the next call to EvaluatorWorkspace() or 
+    until the context is destroyed.
+  See Also:
+    ON_EvaluateNurbsSpan
+    ON_EvaluateNurbsSurfaceSpan
+  */
+  double* EvaluatorWorkspace(
+    size_t count
+    );
+
+  /*
+  Description:
+    Set the ON_SubD whose components are evaluated with this context.
+    Subdivision points are kept in the context only after SetSubD() is
+    called. 
+  Parameters:
+    subd - [in]
+  Remarks:
+    The kept points are identified by component type and id. They are 
+    removed when subd.RuntimeSerialNumber() or 
+    subd.GeometryContentSerialNumber() is different from the values
+    saved by the previous call to SetSubD(). Call SetSubD() again after
+    the ON_SubD is modified.
+  */
+  void SetSubD(
+    const class ON_SubD& subd
+    );
+
+  /*
+  Description:
+    Get a subdivision point that was calculated by an ON_SubD 
+    evaluator that takes a context.
+  Parameters:
+    component - [in]
+    subdivision_point - [out]
+  Returns:
+    True if the point was kept in this context.
+  */
+  bool GetSubDSubdivisionPoint(
+    const class ON_SubDComponentPtr& component,
+    double subdivision_point[3]
+    ) const;
+
+  /*
+  Description:
+    Keep a subdivision point calculated by an ON_SubD evaluator
+    that takes a context. Nothing is kept until SetSubD() is called.
+  Parameters:
+    component - [in]
+    subdivision_point - [in]
+  */
+  void SetSubDSubdivisionPoint(
+    const class ON_SubDComponentPtr& component,
+    const double subdivision_point[3]
+    );
+
+  /*
+  Description:
+    Remove the subdivision points kept in this context and forget the
+    ON_SubD set by SetSubD().
+  */
+  void ClearSubDSubdivisionPoints();
+
+  /*
+  Description:
+    Free the scratch memory, remove the subdivision points and clear 
+    the hints.
+  */
+  void Destroy();
+
+private:
+  int m_curve_hint = 0;
+  int m_surface_hint[2] = {};
+  ON_SimpleArray<double> m_workspace;
+  ON_SimpleArray<double> m_evaluator_workspace;
+  class ON_EvaluationContextSubDPoints* m_subd_points = nullptr;
+};
+
+/*
+Description:
+  ON_TightBoundingBoxCache keeps the tight bounding boxes of curves and
+  surfaces so they are calculated again only when the geometry changes.
+  A box is identified by the geometry's address and its 
+  GeometryContentSerialNumber(). Every curve and surface gets a new 
+  serial number when it is constructed, assigned or changed by a
+  function that calls DestroyCurveTree() or DestroySurfaceTree(), so a
+  box is never used for geometry it was not calculated from.
+
+  The boxes of other geometry, like ON_Brep, ON_SubD and ON_Mesh, are
+  calculated on every call and are not kept.
+
+Thread safety:
+  The cache is owned by the caller and the geometry keeps no state, so
+  const geometry is still free of shared mutable state. A cache may be
+  read by many threads at the same time, but Set() and 
+  GetTightBoundingBox() modify it and must not be called while another
+  thread uses the same cache. ONX_Model::GetTightBoundingBoxes() reads
+  the cache before the worker threads start and saves new boxes after
+  they finish.
+Remarks:
+  Writes through pointers and public data members, like 
+  ON_NurbsCurve::CV(i)[0] = x or ON_NurbsSurface::m_cv[], do not change
+  the serial number. Code that changes geometry this way must call
+  DestroyCurveTree() or DestroySurfaceTree() before using the cache.
+See Also:
+  ON_Geometry::GetTightBoundingBox
+  ONX_Model::GetTightBoundingBoxes
+*/
+class ON_CLASS ON_TightBoundingBoxCache
+{
+public:
+  ON_TightBoundingBoxCache() = default;
+  ~ON_TightBoundingBoxCache();
+
+  // The boxes are kept on the heap and the cache is not copied.
+  ON_TightBoundingBoxCache(const ON_TightBoundingBoxCache&) = delete;
+  ON_TightBoundingBoxCache& operator=(const ON_TightBoundingBoxCache&) = delete;
+
+  /*
+  Parameters:
+    geometry - [in]
+  Returns:
+    The GeometryContentSerialNumber() of a curve or surface, or 0 when
+    the tight bounding box of geometry is not kept.
+  */
+  static ON__UINT64 GeometryContentSerialNumber(
+    const ON_Geometry& geometry
+    );
+
+  /*
+  Description:
+    Get the tight bounding box of geometry. The kept box is used when it
+    is current. Otherwise geometry.GetTightBoundingBox() is called and
+    the result is kept.
+  Parameters:
+    geometry - [in]
+    tight_bbox - [out]
+  Returns:
+    True if tight_bbox is valid.
+  */
+  bool GetTightBoundingBox(
+    const ON_Geometry& geometry,
+    ON_BoundingBox& tight_bbox
+    );
+
+  /*
+  Description:
+    Find a kept box.
+  Parameters:
+    geometry - [in]
+    tight_bbox - [out]
+  Returns:
+    True if a box for geometry with its current 
+    GeometryContentSerialNumber() was found.
+  */
+  bool Find(
+    const ON_Geometry& geometry,
+    ON_BoundingBox& tight_bbox
+    ) const;
+
+  /*
+  Description:
+    Keep the tight bounding box of geometry. Any box kept for the same
+    address is replaced. Nothing is kept when 
+    GeometryContentSerialNumber(geometry) is 0 or tight_bbox is not valid.
+  Parameters:
+    geometry - [in]
+    tight_bbox - [in]
+      tight bounding box of geometry, not transformed.
+  */
+  void Set(
+    const ON_Geometry& geometry,
+    const ON_BoundingBox& tight_bbox
+    );
+
+  /*
+  Returns:
+    Number of kept boxes.
+  */
+  unsigned int Count() const;
+
+  /*
+  Description:
+    Remove all kept boxes.
+  */
+  void Destroy();
+
+private:
+  class ON_TightBoundingBoxCacheBoxes* m_boxes = nullptr;
+};
+
 #endif
 
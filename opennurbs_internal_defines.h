@@ -19,6 +19,8 @@
 #if defined(ON_COMPILING_OPENNURBS)
 
 #include <unordered_map>
+#include <exception>
+#include <mutex>
 
 #ifdef min
 #undef min
@@ -65,6 +67,161 @@ bool IsRDKDocumentInformation(const ONX_Model_UserData& docud);
 template <class T> inline T Lerp(float  t, const T& l, const T& h) { return l + T(t) * (h - l); }
 template <class T> inline T Lerp(double t, const T& l, const T& h) { return l + T(t) * (h - l); }
 
+/*
+Returns:
+  thread_count when it is not zero, otherwise the number of processor cores.
+*/
+inline unsigned int ON_Internal_ParallelThreadCount(unsigned int thread_count)
+{
+  if (0 == thread_count)
+  {
+    const unsigned int core_count = std::thread::hardware_concurrency();
+    thread_count = (core_count > 0) ? core_count : 1;
+  }
+  return thread_count;
+}
+
+/*
+Description:
+  Call task(i) for 0 <= i < task_count on up to thread_count threads.
+  The calling thread runs tasks too.
+Parameters:
+  thread_count - [in]
+    0: use one thread for each processor core.
+    1: every task runs on the calling thread.
+  task_count - [in]
+  task - [in]
+    Called once for each task index. Tasks run in no particular order.
+Remarks:
+  If a worker thread cannot be created, the threads that are running do 
+  the remaining tasks. If a task throws, the tasks that have not started
+  are skipped, every worker thread is joined, and the first exception is 
+  rethrown on the calling thread.
+*/
+template <class TASK>
+void ON_Internal_ParallelFor(
+  unsigned int thread_count,
+  unsigned int task_count,
+  const TASK& task
+  )
+{
+  thread_count = ON_Internal_ParallelThreadCount(thread_count);
+  if (thread_count > task_count)
+    thread_count = task_count;
+  if (thread_count <= 1)
+  {
+    for (unsigned int i = 0; i < task_count; i++)
+      task(i);
+    return;
+  }
+
+  std::atomic<unsigned int> next_task(0);
+  std::atomic<bool> bCanceled(false);
+  std::exception_ptr task_exception;
+  std::mutex task_exception_lock;
+  auto run_tasks = [&]()
+  {
+    try
+    {
+      for (unsigned int i = next_task++; i < task_count && false == bCanceled.load(std::memory_order_relaxed); i = next_task++)
+        task(i);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(task_exception_lock);
+      if (nullptr == task_exception)
+        task_exception = std::current_exception();
+      bCanceled = true;
+    }
+  };
+
+  ON_SimpleArray<std::thread*> workers(thread_count - 1);
+  for (unsigned int i = 1; i < thread_count; i++)
+  {
+    std::thread* worker = nullptr;
+    try
+    {
+      worker = new std::thread(run_tasks);
+    }
+    catch (...)
+    {
+      break;
+    }
+    workers.Append(worker);
+  }
+  run_tasks();
+  for (unsigned int i = 0; i < workers.UnsignedCount(); i++)
+  {
+    workers[i]->join();
+    delete workers[i];
+  }
+
+  if (nullptr != task_exception)
+    std::rethrow_exception(task_exception);
+}
+
+// The SSE2 / AVX2 kernels are compiled on x86-64. Define OPENNURBS_NO_SIMD 
+// to compile only the portable code. Files that use the kernels include 
+// <immintrin.h> when ON_INTERNAL_SIMD_X64 is defined.
+#if !defined(OPENNURBS_NO_SIMD) && (defined(__x86_64__) || defined(_M_X64))
+#define ON_INTERNAL_SIMD_X64
+#if defined(__GNUC__) || defined(__clang__)
+#define ON_INTERNAL_AVX2_FUNCTION __attribute__((target("avx2")))
+#else
+#define ON_INTERNAL_AVX2_FUNCTION
+#endif
+#endif
+
+/*
+Returns:
+  0: portable code
+  1: SSE2
+  2: AVX2
+Remarks:
+  The cpu is queried once. Defined in opennurbs_math.cpp.
+*/
+int ON_Internal_SIMDLevel();
+
+/*
+Description:
+  Get the bounding box of a list of dim = 3, non-rational points
+  with the SSE2 / AVX2 kernels. Used by ON_GetPointListBoundingBox().
+Parameters:
+  simd_level - [in]
+    ON_Internal_SIMDLevel() or a smaller value.
+Returns:
+  True if the SIMD code was used and bbox is set.
+  False if the caller must use the portable code.
+Remarks:
+  Defined in opennurbs_math.cpp.
+*/
+bool ON_Internal_GetPointListBoundingBox3(int simd_level, int count, int stride, const double* points, ON_BoundingBox& bbox);
+bool ON_Internal_GetPointListBoundingBox3(int simd_level, int count, int stride, const float* points, ON_BoundingBox& bbox);
+
+/*
+Description:
+  Transform a list of dim = 3, non-rational points with the 
+  SSE2 / AVX2 kernels. Used by ON_TransformPointListAndGetBoundingBox()
+  and ON_Mesh::Transform().
+Parameters:
+  simd_level - [in]
+    ON_Internal_SIMDLevel() or a smaller value.
+  float_points - [out]
+    If not nullptr, the transformed points are also saved here as
+    floats with a stride of 3.
+  bbox - [out]
+    If not nullptr, the bounding box of the transformed points.
+  rc - [out]
+    false if a point had w = 0.
+Returns:
+  True if the SIMD code was used.
+  False if the caller must use the portable code.
+Remarks:
+  Defined in opennurbs_math.cpp.
+*/
+bool ON_Internal_TransformPointList3(int simd_level, int count, int stride, double* points, const ON_Xform& xform, float* float_points, ON_BoundingBox* bbox, bool& rc);
+bool ON_Internal_TransformPointList3(int simd_level, int count, int stride, float* points, const ON_Xform& xform, ON_BoundingBox* bbox, bool& rc);
+
 class ON_InternalXMLImpl
 {
 public:
@@ -21,6 +21,9 @@
 #error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+// ON_INTERNAL_SIMD_X64, ON_Internal_SIMDLevel()
+#include "opennurbs_internal_defines.h"
+
 /*
 Description:
   Test math library functions.
@@ -1474,7 +1477,761 @@ ON_SwapPointGridCoordinates(
 }
 
 
-bool ON_TransformPointList(
+////////////////////////////////////////////////////////////////
+//
+// SSE2 / AVX2 kernels for contiguous lists of 3d points.
+//
+// ON_TransformPointList(), ON_TransformVectorList(), 
+// ON_GetPointListBoundingBox() and ON_Mesh::Transform() use these
+// when dim = 3. The instruction set is picked at runtime. The kernels
+// do the same arithmetic in the same order as the scalar code (no fused
+// multiply-add) so the results are identical to the portable code.
+// Define OPENNURBS_NO_SIMD to compile only the portable code.
+//
+
+#if defined(ON_INTERNAL_SIMD_X64)
+#pragma ON_PRAGMA_WARNING_BEFORE_DIRTY_INCLUDE
+#include <immintrin.h>
+#if defined(ON_COMPILER_MSC)
+#include <intrin.h>
+#endif
+#pragma ON_PRAGMA_WARNING_AFTER_DIRTY_INCLUDE
+#endif
+
+int ON_Internal_SIMDLevel()
+{
+#if defined(ON_INTERNAL_SIMD_X64)
+  static const int simd_level = []()
+  {
+#if defined(ON_COMPILER_MSC) && !defined(__clang__)
+    int info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] >= 7)
+    {
+      __cpuid(info, 1);
+      const bool bOSXSAVE = 0 != (info[2] & (1 << 27));
+      const bool bAVX = 0 != (info[2] & (1 << 28));
+      __cpuidex(info, 7, 0);
+      const bool bAVX2 = 0 != (info[1] & (1 << 5));
+      if (bOSXSAVE && bAVX && bAVX2 && 6 == (_xgetbv(0) & 6))
+        return 2;
+    }
+    return 1;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? 2 : 1;
+#endif
+  }();
+  return simd_level;
+#else
+  return 0;
+#endif
+}
+
+// Scalar transformation of a single dim = 3 point. The arithmetic
+// matches ON_TransformPointList() exactly. The stored coordinates
+// are returned in v[].
+template <class T>
+static bool ON_Internal_TransformPoint3(const ON_Xform& xform, T* point, float* fpoint, double v[3])
+{
+  bool rc = true;
+  double w = xform.m_xform[3][0]*point[0] + xform.m_xform[3][1]*point[1] + xform.m_xform[3][2]*point[2] + xform.m_xform[3][3];
+  if (w==0.0)  {
+    rc = false;
+    w = 1.0;
+  }
+  else
+    w = 1.0/w;
+  const double x = xform.m_xform[0][0]*point[0] + xform.m_xform[0][1]*point[1] + xform.m_xform[0][2]*point[2] + xform.m_xform[0][3];
+  const double y = xform.m_xform[1][0]*point[0] + xform.m_xform[1][1]*point[1] + xform.m_xform[1][2]*point[2] + xform.m_xform[1][3];
+  const double z = xform.m_xform[2][0]*point[0] + xform.m_xform[2][1]*point[1] + xform.m_xform[2][2]*point[2] + xform.m_xform[2][3];
+  point[0] = (T)(w*x); point[1] = (T)(w*y); point[2] = (T)(w*z);
+  if (nullptr != fpoint)
+  {
+    fpoint[0] = (float)point[0]; fpoint[1] = (float)point[1]; fpoint[2] = (float)point[2];
+  }
+  v[0] = point[0]; v[1] = point[1]; v[2] = point[2];
+  return rc;
+}
+
+static void ON_Internal_GrowBox3(const double v[3], double box[6])
+{
+  if ( box[0] > v[0] ) box[0] = v[0]; else if ( box[3] < v[0] ) box[3] = v[0];
+  if ( box[1] > v[1] ) box[1] = v[1]; else if ( box[4] < v[1] ) box[4] = v[1];
+  if ( box[2] > v[2] ) box[2] = v[2]; else if ( box[5] < v[2] ) box[5] = v[2];
+}
+
+#if defined(ON_INTERNAL_SIMD_X64)
+
+static void ON_Internal_ReduceBox3(int value_count, const double* vmin, const double* vmax, double box[6])
+{
+  // vmin[i] and vmax[i] are bounds of coordinate i%3
+  for (int i = 0; i < value_count; i++)
+  {
+    const int j = i % 3;
+    if (box[j] > vmin[i])
+      box[j] = vmin[i];
+    if (box[3+j] < vmax[i])
+      box[3+j] = vmax[i];
+  }
+}
+
+////////////////////////////////////////////////////////////////
+//
+// SSE2 (every x86-64 cpu)
+//
+
+static inline void ON_Internal_SSE2_Store3(double* p, __m128d lo, __m128d hi, __m128d& vlo, __m128d& vhi)
+{
+  _mm_storeu_pd(p, lo);
+  _mm_store_sd(p+2, hi);
+  vlo = lo;
+  vhi = hi;
+}
+
+static inline void ON_Internal_SSE2_Store3(float* p, __m128d lo, __m128d hi, __m128d& vlo, __m128d& vhi)
+{
+  const __m128 f = _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+  _mm_storel_pi((__m64*)p, f);
+  _mm_store_ss(p+2, _mm_movehl_ps(f, f));
+  vlo = _mm_cvtps_pd(f);
+  vhi = _mm_cvtps_pd(_mm_movehl_ps(f, f));
+}
+
+static inline void ON_Internal_SSE2_StoreFloat3(float* p, __m128d lo, __m128d hi)
+{
+  const __m128 f = _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+  _mm_storel_pi((__m64*)p, f);
+  _mm_store_ss(p+2, _mm_movehl_ps(f, f));
+}
+
+// point_count must be even. box[] is the current bounding box or nullptr.
+template <class T>
+static bool ON_Internal_SSE2_TransformPoints3(int point_count, int stride, T* point, const ON_Xform& xform, float* fpoint, double* box)
+{
+  const double (*m)[4] = xform.m_xform;
+  const __m128d c0lo = _mm_setr_pd(m[0][0], m[1][0]), c0hi = _mm_setr_pd(m[2][0], m[3][0]);
+  const __m128d c1lo = _mm_setr_pd(m[0][1], m[1][1]), c1hi = _mm_setr_pd(m[2][1], m[3][1]);
+  const __m128d c2lo = _mm_setr_pd(m[0][2], m[1][2]), c2hi = _mm_setr_pd(m[2][2], m[3][2]);
+  const __m128d c3lo = _mm_setr_pd(m[0][3], m[1][3]), c3hi = _mm_setr_pd(m[2][3], m[3][3]);
+  const __m128d one = _mm_set1_pd(1.0);
+  const __m128d zero = _mm_setzero_pd();
+  __m128d minlo = zero, minhi = zero, maxlo = zero, maxhi = zero;
+  if (nullptr != box)
+  {
+    minlo = _mm_setr_pd(box[0], box[1]); minhi = _mm_set_sd(box[2]);
+    maxlo = _mm_setr_pd(box[3], box[4]); maxhi = _mm_set_sd(box[5]);
+  }
+  bool rc = true;
+  for (int i = 0; i < point_count; i += 2)
+  {
+    T* p0 = point + i*stride;
+    T* p1 = p0 + stride;
+    __m128d x = _mm_set1_pd((double)p0[0]), y = _mm_set1_pd((double)p0[1]), z = _mm_set1_pd((double)p0[2]);
+    __m128d lo0 = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(c0lo, x), _mm_mul_pd(c1lo, y)), _mm_mul_pd(c2lo, z)), c3lo);
+    __m128d hi0 = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(c0hi, x), _mm_mul_pd(c1hi, y)), _mm_mul_pd(c2hi, z)), c3hi);
+    x = _mm_set1_pd((double)p1[0]); y = _mm_set1_pd((double)p1[1]); z = _mm_set1_pd((double)p1[2]);
+    __m128d lo1 = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(c0lo, x), _mm_mul_pd(c1lo, y)), _mm_mul_pd(c2lo, z)), c3lo);
+    __m128d hi1 = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(c0hi, x), _mm_mul_pd(c1hi, y)), _mm_mul_pd(c2hi, z)), c3hi);
+
+    // w = 0 is replaced with 1 the same way the scalar code does it
+    __m128d w = _mm_unpackhi_pd(hi0, hi1);
+    const __m128d bad_w = _mm_cmpeq_pd(w, zero);
+    if (0 != _mm_movemask_pd(bad_w))
+    {
+      rc = false;
+      w = _mm_or_pd(_mm_and_pd(bad_w, one), _mm_andnot_pd(bad_w, w));
+    }
+    w = _mm_div_pd(one, w);
+    const __m128d w0 = _mm_unpacklo_pd(w, w);
+    const __m128d w1 = _mm_unpackhi_pd(w, w);
+    lo0 = _mm_mul_pd(w0, lo0); hi0 = _mm_mul_pd(w0, hi0);
+    lo1 = _mm_mul_pd(w1, lo1); hi1 = _mm_mul_pd(w1, hi1);
+
+    __m128d vlo0, vhi0, vlo1, vhi1;
+    ON_Internal_SSE2_Store3(p0, lo0, hi0, vlo0, vhi0);
+    ON_Internal_SSE2_Store3(p1, lo1, hi1, vlo1, vhi1);
+    if (nullptr != fpoint)
+    {
+      ON_Internal_SSE2_StoreFloat3(fpoint + 3*i, lo0, hi0);
+      ON_Internal_SSE2_StoreFloat3(fpoint + 3*i + 3, lo1, hi1);
+    }
+    if (nullptr != box)
+    {
+      minlo = _mm_min_pd(vlo0, minlo); minhi = _mm_min_pd(vhi0, minhi);
+      maxlo = _mm_max_pd(vlo0, maxlo); maxhi = _mm_max_pd(vhi0, maxhi);
+      minlo = _mm_min_pd(vlo1, minlo); minhi = _mm_min_pd(vhi1, minhi);
+      maxlo = _mm_max_pd(vlo1, maxlo); maxhi = _mm_max_pd(vhi1, maxhi);
+    }
+  }
+  if (nullptr != box)
+  {
+    _mm_storeu_pd(box, minlo); _mm_store_sd(box+2, minhi);
+    _mm_storeu_pd(box+3, maxlo); _mm_store_sd(box+5, maxhi);
+  }
+  return rc;
+}
+
+template <class T>
+static void ON_Internal_SSE2_TransformRationalPoints3(int point_count, int stride, T* point, const ON_Xform& xform)
+{
+  const double (*m)[4] = xform.m_xform;
+  const __m128d c0lo = _mm_setr_pd(m[0][0], m[1][0]), c0hi = _mm_setr_pd(m[2][0], m[3][0]);
+  const __m128d c1lo = _mm_setr_pd(m[0][1], m[1][1]), c1hi = _mm_setr_pd(m[2][1], m[3][1]);
+  const __m128d c2lo = _mm_setr_pd(m[0][2], m[1][2]), c2hi = _mm_setr_pd(m[2][2], m[3][2]);
+  const __m128d c3lo = _mm_setr_pd(m[0][3], m[1][3]), c3hi = _mm_setr_pd(m[2][3], m[3][3]);
+  for (int i = 0; i < point_count; i++, point += stride)
+  {
+    const __m128d x = _mm_set1_pd((double)point[0]), y = _mm_set1_pd((double)point[1]);
+    const __m128d z = _mm_set1_pd((double)point[2]), w = _mm_set1_pd((double)point[3]);
+    const __m128d lo = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(c0lo, x), _mm_mul_pd(c1lo, y)), _mm_mul_pd(c2lo, z)), _mm_mul_pd(c3lo, w));
+    const __m128d hi = _mm_add_pd(_mm_add_pd(_mm_add_pd(_mm_mul_pd(c0hi, x), _mm_mul_pd(c1hi, y)), _mm_mul_pd(c2hi, z)), _mm_mul_pd(c3hi, w));
+    point[0] = (T)_mm_cvtsd_f64(lo);
+    point[1] = (T)_mm_cvtsd_f64(_mm_unpackhi_pd(lo, lo));
+    point[2] = (T)_mm_cvtsd_f64(hi);
+    point[3] = (T)_mm_cvtsd_f64(_mm_unpackhi_pd(hi, hi));
+  }
+}
+
+template <class T>
+static void ON_Internal_SSE2_TransformVectors3(int vector_count, int stride, T* vector, const ON_Xform& xform)
+{
+  const double (*m)[4] = xform.m_xform;
+  const __m128d c0lo = _mm_setr_pd(m[0][0], m[1][0]), c0hi = _mm_set_sd(m[2][0]);
+  const __m128d c1lo = _mm_setr_pd(m[0][1], m[1][1]), c1hi = _mm_set_sd(m[2][1]);
+  const __m128d c2lo = _mm_setr_pd(m[0][2], m[1][2]), c2hi = _mm_set_sd(m[2][2]);
+  for (int i = 0; i < vector_count; i++, vector += stride)
+  {
+    const __m128d x = _mm_set1_pd((double)vector[0]), y = _mm_set1_pd((double)vector[1]), z = _mm_set1_pd((double)vector[2]);
+    const __m128d lo = _mm_add_pd(_mm_add_pd(_mm_mul_pd(c0lo, x), _mm_mul_pd(c1lo, y)), _mm_mul_pd(c2lo, z));
+    const __m128d hi = _mm_add_pd(_mm_add_pd(_mm_mul_pd(c0hi, x), _mm_mul_pd(c1hi, y)), _mm_mul_pd(c2hi, z));
+    __m128d vlo, vhi;
+    ON_Internal_SSE2_Store3(vector, lo, hi, vlo, vhi);
+  }
+}
+
+// box[] is initialized from a point before the call
+static void ON_Internal_SSE2_PointBox3(int point_count, int stride, const double* point, double box[6])
+{
+  if (3 == stride)
+  {
+    // 2 points = 3 registers. Lane i of register k holds coordinate (2*k+i)%3.
+    const int value_count = 6;
+    double init[value_count];
+    for (int i = 0; i < value_count; i++)
+      init[i] = box[i%3];
+    __m128d mn0 = _mm_loadu_pd(init), mn1 = _mm_loadu_pd(init+2), mn2 = _mm_loadu_pd(init+4);
+    __m128d mx0 = mn0, mx1 = mn1, mx2 = mn2;
+    const double* end = point + 3*(point_count - point_count%2);
+    for (/*empty*/; point < end; point += value_count)
+    {
+      const __m128d v0 = _mm_loadu_pd(point), v1 = _mm_loadu_pd(point+2), v2 = _mm_loadu_pd(point+4);
+      mn0 = _mm_min_pd(v0, mn0); mx0 = _mm_max_pd(v0, mx0);
+      mn1 = _mm_min_pd(v1, mn1); mx1 = _mm_max_pd(v1, mx1);
+      mn2 = _mm_min_pd(v2, mn2); mx2 = _mm_max_pd(v2, mx2);
+    }
+    double vmin[value_count], vmax[value_count];
+    _mm_storeu_pd(vmin, mn0); _mm_storeu_pd(vmin+2, mn1); _mm_storeu_pd(vmin+4, mn2);
+    _mm_storeu_pd(vmax, mx0); _mm_storeu_pd(vmax+2, mx1); _mm_storeu_pd(vmax+4, mx2);
+    ON_Internal_ReduceBox3(value_count, vmin, vmax, box);
+    if (0 != point_count%2)
+      ON_Internal_GrowBox3(point, box);
+  }
+  else
+  {
+    __m128d mnlo = _mm_setr_pd(box[0], box[1]), mnhi = _mm_set_sd(box[2]);
+    __m128d mxlo = _mm_setr_pd(box[3], box[4]), mxhi = _mm_set_sd(box[5]);
+    for (int i = 0; i < point_count; i++, point += stride)
+    {
+      const __m128d lo = _mm_loadu_pd(point), hi = _mm_load_sd(point+2);
+      mnlo = _mm_min_pd(lo, mnlo); mnhi = _mm_min_pd(hi, mnhi);
+      mxlo = _mm_max_pd(lo, mxlo); mxhi = _mm_max_pd(hi, mxhi);
+    }
+    _mm_storeu_pd(box, mnlo); _mm_store_sd(box+2, mnhi);
+    _mm_storeu_pd(box+3, mxlo); _mm_store_sd(box+5, mxhi);
+  }
+}
+
+static void ON_Internal_SSE2_PointBox3(int point_count, int stride, const float* point, double box[6])
+{
+  // float min/max is exact so the bounds are accumulated in single precision
+  if (3 == stride)
+  {
+    // 4 points = 3 registers. Lane i of register k holds coordinate (4*k+i)%3.
+    const int value_count = 12;
+    float init[value_count];
+    for (int i = 0; i < value_count; i++)
+      init[i] = (float)box[i%3];
+    __m128 mn0 = _mm_loadu_ps(init), mn1 = _mm_loadu_ps(init+4), mn2 = _mm_loadu_ps(init+8);
+    __m128 mx0 = mn0, mx1 = mn1, mx2 = mn2;
+    const float* end = point + 3*(point_count - point_count%4);
+    for (/*empty*/; point < end; point += value_count)
+    {
+      const __m128 v0 = _mm_loadu_ps(point), v1 = _mm_loadu_ps(point+4), v2 = _mm_loadu_ps(point+8);
+      mn0 = _mm_min_ps(v0, mn0); mx0 = _mm_max_ps(v0, mx0);
+      mn1 = _mm_min_ps(v1, mn1); mx1 = _mm_max_ps(v1, mx1);
+      mn2 = _mm_min_ps(v2, mn2); mx2 = _mm_max_ps(v2, mx2);
+    }
+    float fmin[value_count], fmax[value_count];
+    _mm_storeu_ps(fmin, mn0); _mm_storeu_ps(fmin+4, mn1); _mm_storeu_ps(fmin+8, mn2);
+    _mm_storeu_ps(fmax, mx0); _mm_storeu_ps(fmax+4, mx1); _mm_storeu_ps(fmax+8, mx2);
+    double vmin[value_count], vmax[value_count];
+    for (int i = 0; i < value_count; i++)
+    {
+      vmin[i] = fmin[i];
+      vmax[i] = fmax[i];
+    }
+    ON_Internal_ReduceBox3(value_count, vmin, vmax, box);
+    for (point_count %= 4; point_count > 0; point_count--, point += 3)
+    {
+      const double v[3] = { point[0], point[1], point[2] };
+      ON_Internal_GrowBox3(v, box);
+    }
+  }
+  else
+  {
+    const float fbox[6] = { (float)box[0], (float)box[1], (float)box[2], (float)box[3], (float)box[4], (float)box[5] };
+    __m128 mn = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)fbox), _mm_load_ss(fbox+2));
+    __m128 mx = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(fbox+3)), _mm_load_ss(fbox+5));
+    for (int i = 0; i < point_count; i++, point += stride)
+    {
+      const __m128 v = _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)point), _mm_load_ss(point+2));
+      mn = _mm_min_ps(v, mn);
+      mx = _mm_max_ps(v, mx);
+    }
+    float fmin[4], fmax[4];
+    _mm_storeu_ps(fmin, mn);
+    _mm_storeu_ps(fmax, mx);
+    for (int j = 0; j < 3; j++)
+    {
+      box[j] = fmin[j];
+      box[3+j] = fmax[j];
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////
+//
+// AVX2
+//
+
+ON_INTERNAL_AVX2_FUNCTION
+static inline void ON_Internal_AVX2_Store3(double* p, __m256d v, __m256d& stored_v)
+{
+  _mm_storeu_pd(p, _mm256_castpd256_pd128(v));
+  _mm_store_sd(p+2, _mm256_extractf128_pd(v, 1));
+  stored_v = v;
+}
+
+ON_INTERNAL_AVX2_FUNCTION
+static inline void ON_Internal_AVX2_StoreFloat3(float* p, __m128 f)
+{
+  _mm_storel_pi((__m64*)p, f);
+  _mm_store_ss(p+2, _mm_movehl_ps(f, f));
+}
+
+ON_INTERNAL_AVX2_FUNCTION
+static inline void ON_Internal_AVX2_Store3(float* p, __m256d v, __m256d& stored_v)
+{
+  const __m128 f = _mm256_cvtpd_ps(v);
+  ON_Internal_AVX2_StoreFloat3(p, f);
+  stored_v = _mm256_cvtps_pd(f);
+}
+
+ON_INTERNAL_AVX2_FUNCTION
+static inline __m256d ON_Internal_AVX2_XformPoint3(const __m256d c[4], double x, double y, double z)
+{
+  return _mm256_add_pd(
+    _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(c[0], _mm256_set1_pd(x)), _mm256_mul_pd(c[1], _mm256_set1_pd(y))), _mm256_mul_pd(c[2], _mm256_set1_pd(z))),
+    c[3]);
+}
+
+// point_count must be a multiple of 4. box[] is the current bounding box or nullptr.
+template <class T>
+ON_INTERNAL_AVX2_FUNCTION
+static bool ON_Internal_AVX2_TransformPoints3(int point_count, int stride, T* point, const ON_Xform& xform, float* fpoint, double* box)
+{
+  const double (*m)[4] = xform.m_xform;
+  const __m256d c[4] = {
+    _mm256_setr_pd(m[0][0], m[1][0], m[2][0], m[3][0]),
+    _mm256_setr_pd(m[0][1], m[1][1], m[2][1], m[3][1]),
+    _mm256_setr_pd(m[0][2], m[1][2], m[2][2], m[3][2]),
+    _mm256_setr_pd(m[0][3], m[1][3], m[2][3], m[3][3])
+  };
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d zero = _mm256_setzero_pd();
+  __m256d bmin = zero, bmax = zero;
+  if (nullptr != box)
+  {
+    bmin = _mm256_setr_pd(box[0], box[1], box[2], 0.0);
+    bmax = _mm256_setr_pd(box[3], box[4], box[5], 0.0);
+  }
+  bool rc = true;
+  for (int i = 0; i < point_count; i += 4)
+  {
+    T* p0 = point + i*stride;
+    T* p1 = p0 + stride;
+    T* p2 = p1 + stride;
+    T* p3 = p2 + stride;
+    __m256d r0 = ON_Internal_AVX2_XformPoint3(c, (double)p0[0], (double)p0[1], (double)p0[2]);
+    __m256d r1 = ON_Internal_AVX2_XformPoint3(c, (double)p1[0], (double)p1[1], (double)p1[2]);
+    __m256d r2 = ON_Internal_AVX2_XformPoint3(c, (double)p2[0], (double)p2[1], (double)p2[2]);
+    __m256d r3 = ON_Internal_AVX2_XformPoint3(c, (double)p3[0], (double)p3[1], (double)p3[2]);
+
+    // gather the 4 w coordinates, replace w = 0 with 1 the same way
+    // the scalar code does, and use a single division
+    __m256d w = _mm256_permute2f128_pd(_mm256_unpackhi_pd(r0, r1), _mm256_unpackhi_pd(r2, r3), 0x31);
+    const __m256d bad_w = _mm256_cmp_pd(w, zero, _CMP_EQ_OQ);
+    if (0 != _mm256_movemask_pd(bad_w))
+    {
+      rc = false;
+      w = _mm256_blendv_pd(w, one, bad_w);
+    }
+    w = _mm256_div_pd(one, w);
+    r0 = _mm256_mul_pd(_mm256_permute4x64_pd(w, 0x00), r0);
+    r1 = _mm256_mul_pd(_mm256_permute4x64_pd(w, 0x55), r1);
+    r2 = _mm256_mul_pd(_mm256_permute4x64_pd(w, 0xAA), r2);
+    r3 = _mm256_mul_pd(_mm256_permute4x64_pd(w, 0xFF), r3);
+
+    __m256d v0, v1, v2, v3;
+    ON_Internal_AVX2_Store3(p0, r0, v0);
+    ON_Internal_AVX2_Store3(p1, r1, v1);
+    ON_Internal_AVX2_Store3(p2, r2, v2);
+    ON_Internal_AVX2_Store3(p3, r3, v3);
+    if (nullptr != fpoint)
+    {
+      float* f = fpoint + 3*i;
+      ON_Internal_AVX2_StoreFloat3(f, _mm256_cvtpd_ps(r0));
+      ON_Internal_AVX2_StoreFloat3(f+3, _mm256_cvtpd_ps(r1));
+      ON_Internal_AVX2_StoreFloat3(f+6, _mm256_cvtpd_ps(r2));
+      ON_Internal_AVX2_StoreFloat3(f+9, _mm256_cvtpd_ps(r3));
+    }
+    if (nullptr != box)
+    {
+      bmin = _mm256_min_pd(v0, bmin); bmax = _mm256_max_pd(v0, bmax);
+      bmin = _mm256_min_pd(v1, bmin); bmax = _mm256_max_pd(v1, bmax);
+      bmin = _mm256_min_pd(v2, bmin); bmax = _mm256_max_pd(v2, bmax);
+      bmin = _mm256_min_pd(v3, bmin); bmax = _mm256_max_pd(v3, bmax);
+    }
+  }
+  if (nullptr != box)
+  {
+    double b[8];
+    _mm256_storeu_pd(b, bmin);
+    _mm256_storeu_pd(b+4, bmax);
+    box[0] = b[0]; box[1] = b[1]; box[2] = b[2];
+    box[3] = b[4]; box[4] = b[5]; box[5] = b[6];
+  }
+  return rc;
+}
+
+template <class T>
+ON_INTERNAL_AVX2_FUNCTION
+static void ON_Internal_AVX2_TransformRationalPoints3(int point_count, int stride, T* point, const ON_Xform& xform)
+{
+  const double (*m)[4] = xform.m_xform;
+  const __m256d c0 = _mm256_setr_pd(m[0][0], m[1][0], m[2][0], m[3][0]);
+  const __m256d c1 = _mm256_setr_pd(m[0][1], m[1][1], m[2][1], m[3][1]);
+  const __m256d c2 = _mm256_setr_pd(m[0][2], m[1][2], m[2][2], m[3][2]);
+  const __m256d c3 = _mm256_setr_pd(m[0][3], m[1][3], m[2][3], m[3][3]);
+  for (int i = 0; i < point_count; i++, point += stride)
+  {
+    const __m256d r = _mm256_add_pd(
+      _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(c0, _mm256_set1_pd((double)point[0])), _mm256_mul_pd(c1, _mm256_set1_pd((double)point[1]))), _mm256_mul_pd(c2, _mm256_set1_pd((double)point[2]))),
+      _mm256_mul_pd(c3, _mm256_set1_pd((double)point[3])));
+    double v[4];
+    _mm256_storeu_pd(v, r);
+    point[0] = (T)v[0]; point[1] = (T)v[1]; point[2] = (T)v[2]; point[3] = (T)v[3];
+  }
+}
+
+template <class T>
+ON_INTERNAL_AVX2_FUNCTION
+static void ON_Internal_AVX2_TransformVectors3(int vector_count, int stride, T* vector, const ON_Xform& xform)
+{
+  const double (*m)[4] = xform.m_xform;
+  const __m256d c0 = _mm256_setr_pd(m[0][0], m[1][0], m[2][0], 0.0);
+  const __m256d c1 = _mm256_setr_pd(m[0][1], m[1][1], m[2][1], 0.0);
+  const __m256d c2 = _mm256_setr_pd(m[0][2], m[1][2], m[2][2], 0.0);
+  for (int i = 0; i < vector_count; i++, vector += stride)
+  {
+    const __m256d r = _mm256_add_pd(
+      _mm256_add_pd(_mm256_mul_pd(c0, _mm256_set1_pd((double)vector[0])), _mm256_mul_pd(c1, _mm256_set1_pd((double)vector[1]))),
+      _mm256_mul_pd(c2, _mm256_set1_pd((double)vector[2])));
+    __m256d v;
+    ON_Internal_AVX2_Store3(vector, r, v);
+  }
+}
+
+// box[] is initialized from a point before the call
+ON_INTERNAL_AVX2_FUNCTION
+static void ON_Internal_AVX2_PointBox3(int point_count, int stride, const double* point, double box[6])
+{
+  if (3 == stride)
+  {
+    // 4 points = 3 registers. Lane i of register k holds coordinate (4*k+i)%3.
+    const int value_count = 12;
+    double init[value_count];
+    for (int i = 0; i < value_count; i++)
+      init[i] = box[i%3];
+    __m256d mn0 = _mm256_loadu_pd(init), mn1 = _mm256_loadu_pd(init+4), mn2 = _mm256_loadu_pd(init+8);
+    __m256d mx0 = mn0, mx1 = mn1, mx2 = mn2;
+    const double* end = point + 3*(point_count - point_count%4);
+    for (/*empty*/; point < end; point += value_count)
+    {
+      const __m256d v0 = _mm256_loadu_pd(point), v1 = _mm256_loadu_pd(point+4), v2 = _mm256_loadu_pd(point+8);
+      mn0 = _mm256_min_pd(v0, mn0); mx0 = _mm256_max_pd(v0, mx0);
+      mn1 = _mm256_min_pd(v1, mn1); mx1 = _mm256_max_pd(v1, mx1);
+      mn2 = _mm256_min_pd(v2, mn2); mx2 = _mm256_max_pd(v2, mx2);
+    }
+    double vmin[value_count], vmax[value_count];
+    _mm256_storeu_pd(vmin, mn0); _mm256_storeu_pd(vmin+4, mn1); _mm256_storeu_pd(vmin+8, mn2);
+    _mm256_storeu_pd(vmax, mx0); _mm256_storeu_pd(vmax+4, mx1); _mm256_storeu_pd(vmax+8, mx2);
+    ON_Internal_ReduceBox3(value_count, vmin, vmax, box);
+    for (point_count %= 4; point_count > 0; point_count--, point += 3)
+      ON_Internal_GrowBox3(point, box);
+  }
+  else
+  {
+    // the masked load never reads past the 3rd coordinate of a point
+    const __m256i mask = _mm256_setr_epi64x(-1, -1, -1, 0);
+    __m256d mn = _mm256_setr_pd(box[0], box[1], box[2], 0.0);
+    __m256d mx = _mm256_setr_pd(box[3], box[4], box[5], 0.0);
+    for (int i = 0; i < point_count; i++, point += stride)
+    {
+      const __m256d v = _mm256_maskload_pd(point, mask);
+      mn = _mm256_min_pd(v, mn);
+      mx = _mm256_max_pd(v, mx);
+    }
+    double b[8];
+    _mm256_storeu_pd(b, mn);
+    _mm256_storeu_pd(b+4, mx);
+    box[0] = b[0]; box[1] = b[1]; box[2] = b[2];
+    box[3] = b[4]; box[4] = b[5]; box[5] = b[6];
+  }
+}
+
+ON_INTERNAL_AVX2_FUNCTION
+static void ON_Internal_AVX2_PointBox3(int point_count, int stride, const float* point, double box[6])
+{
+  // float min/max is exact so the bounds are accumulated in single precision
+  if (3 == stride)
+  {
+    // 8 points = 3 registers. Lane i of register k holds coordinate (8*k+i)%3.
+    const int value_count = 24;
+    float init[value_count];
+    for (int i = 0; i < value_count; i++)
+      init[i] = (float)box[i%3];
+    __m256 mn0 = _mm256_loadu_ps(init), mn1 = _mm256_loadu_ps(init+8), mn2 = _mm256_loadu_ps(init+16);
+    __m256 mx0 = mn0, mx1 = mn1, mx2 = mn2;
+    const float* end = point + 3*(point_count - point_count%8);
+    for (/*empty*/; point < end; point += value_count)
+    {
+      const __m256 v0 = _mm256_loadu_ps(point), v1 = _mm256_loadu_ps(point+8), v2 = _mm256_loadu_ps(point+16);
+      mn0 = _mm256_min_ps(v0, mn0); mx0 = _mm256_max_ps(v0, mx0);
+      mn1 = _mm256_min_ps(v1, mn1); mx1 = _mm256_max_ps(v1, mx1);
+      mn2 = _mm256_min_ps(v2, mn2); mx2 = _mm256_max_ps(v2, mx2);
+    }
+    float fmin[value_count], fmax[value_count];
+    _mm256_storeu_ps(fmin, mn0); _mm256_storeu_ps(fmin+8, mn1); _mm256_storeu_ps(fmin+16, mn2);
+    _mm256_storeu_ps(fmax, mx0); _mm256_storeu_ps(fmax+8, mx1); _mm256_storeu_ps(fmax+16, mx2);
+    double vmin[value_count], vmax[value_count];
+    for (int i = 0; i < value_count; i++)
+    {
+      vmin[i] = fmin[i];
+      vmax[i] = fmax[i];
+    }
+    ON_Internal_ReduceBox3(value_count, vmin, vmax, box);
+    for (point_count %= 8; point_count > 0; point_count--, point += 3)
+    {
+      const double v[3] = { point[0], point[1], point[2] };
+      ON_Internal_GrowBox3(v, box);
+    }
+  }
+  else
+  {
+    // the masked load never reads past the 3rd coordinate of a point
+    const __m128i mask = _mm_setr_epi32(-1, -1, -1, 0);
+    const float fbox[8] = { (float)box[0], (float)box[1], (float)box[2], 0.0f, (float)box[3], (float)box[4], (float)box[5], 0.0f };
+    __m128 mn = _mm_loadu_ps(fbox);
+    __m128 mx = _mm_loadu_ps(fbox+4);
+    for (int i = 0; i < point_count; i++, point += stride)
+    {
+      const __m128 v = _mm_maskload_ps(point, mask);
+      mn = _mm_min_ps(v, mn);
+      mx = _mm_max_ps(v, mx);
+    }
+    float fmin[4], fmax[4];
+    _mm_storeu_ps(fmin, mn);
+    _mm_storeu_ps(fmax, mx);
+    for (int j = 0; j < 3; j++)
+    {
+      box[j] = fmin[j];
+      box[3+j] = fmax[j];
+    }
+  }
+}
+
+#endif
+
+/*
+Description:
+  Transform a list of dim = 3, non-rational points with the SIMD kernels.
+Parameters:
+  simd_level - [in]
+    ON_Internal_SIMDLevel() or a smaller value. 
+    ON_TestPointListKernels() passes every level.
+  fpoint - [out] 
+    If not nullptr, the transformed points are also saved here as
+    floats with a stride of 3.
+  box - [out]
+    If not nullptr, the bounding box of the transformed points is
+    saved here as (xmin,ymin,zmin,xmax,ymax,zmax).
+  rc - [out]
+    false if a point had w = 0.
+Returns:
+  True if the SIMD code was used.
+  False if the caller must use the portable code.
+*/
+template <class T>
+static bool ON_Internal_SIMD_TransformPoints3(int simd_level, int count, int stride, T* point, const ON_Xform& xform, float* fpoint, double* box, bool& rc)
+{
+#if defined(ON_INTERNAL_SIMD_X64)
+  if (simd_level <= 0 || count <= 0 || stride < 3 || nullptr == point)
+    return false;
+
+  rc = true;
+  double v[3];
+  int i = 0;
+  if (nullptr != box)
+  {
+    // the first point initializes the box
+    if (!ON_Internal_TransformPoint3(xform, point, fpoint, v))
+      rc = false;
+    box[0] = box[3] = v[0]; box[1] = box[4] = v[1]; box[2] = box[5] = v[2];
+    i = 1;
+  }
+  const int block_size = (simd_level >= 2) ? 4 : 2;
+  const int n = (count - i) - (count - i)%block_size;
+  if (n > 0)
+  {
+    T* p = point + i*stride;
+    float* f = (nullptr != fpoint) ? (fpoint + 3*i) : nullptr;
+    const bool bNonZeroW
+      = (simd_level >= 2)
+      ? ON_Internal_AVX2_TransformPoints3(n, stride, p, xform, f, box)
+      : ON_Internal_SSE2_TransformPoints3(n, stride, p, xform, f, box);
+    if (!bNonZeroW)
+      rc = false;
+    i += n;
+  }
+  for (/*empty*/; i < count; i++)
+  {
+    if (!ON_Internal_TransformPoint3(xform, point + i*stride, (nullptr != fpoint) ? (fpoint + 3*i) : nullptr, v))
+      rc = false;
+    if (nullptr != box)
+      ON_Internal_GrowBox3(v, box);
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+template <class T>
+static bool ON_Internal_SIMD_TransformRationalPoints3(int simd_level, int count, int stride, T* point, const ON_Xform& xform)
+{
+#if defined(ON_INTERNAL_SIMD_X64)
+  if (simd_level <= 0 || count <= 0 || stride < 4 || nullptr == point)
+    return false;
+  if (simd_level >= 2)
+    ON_Internal_AVX2_TransformRationalPoints3(count, stride, point, xform);
+  else
+    ON_Internal_SSE2_TransformRationalPoints3(count, stride, point, xform);
+  return true;
+#else
+  return false;
+#endif
+}
+
+template <class T>
+static bool ON_Internal_SIMD_TransformVectors3(int simd_level, int count, int stride, T* vector, const ON_Xform& xform)
+{
+#if defined(ON_INTERNAL_SIMD_X64)
+  if (simd_level <= 0 || count <= 0 || stride < 3 || nullptr == vector)
+    return false;
+  if (simd_level >= 2)
+    ON_Internal_AVX2_TransformVectors3(count, stride, vector, xform);
+  else
+    ON_Internal_SSE2_TransformVectors3(count, stride, vector, xform);
+  return true;
+#else
+  return false;
+#endif
+}
+
+template <class T>
+static bool ON_Internal_SIMD_GetPointListBoundingBox3(int simd_level, int count, int stride, const T* point, ON_BoundingBox& bbox)
+{
+#if defined(ON_INTERNAL_SIMD_X64)
+  if (simd_level <= 0 || count <= 0 || stride < 3 || nullptr == point)
+    return false;
+  // the first point initializes the box
+  double box[6] = { (double)point[0], (double)point[1], (double)point[2], (double)point[0], (double)point[1], (double)point[2] };
+  if (count > 1)
+  {
+    if (simd_level >= 2)
+      ON_Internal_AVX2_PointBox3(count - 1, stride, point + stride, box);
+    else
+      ON_Internal_SSE2_PointBox3(count - 1, stride, point + stride, box);
+  }
+  bbox.m_min.Set(box[0], box[1], box[2]);
+  bbox.m_max.Set(box[3], box[4], box[5]);
+  return true;
+#else
+  return false;
+#endif
+}
+
+bool ON_Internal_GetPointListBoundingBox3(int simd_level, int count, int stride, const double* points, ON_BoundingBox& bbox)
+{
+  return ON_Internal_SIMD_GetPointListBoundingBox3(simd_level, count, stride, points, bbox);
+}
+
+bool ON_Internal_GetPointListBoundingBox3(int simd_level, int count, int stride, const float* points, ON_BoundingBox& bbox)
+{
+  return ON_Internal_SIMD_GetPointListBoundingBox3(simd_level, count, stride, points, bbox);
+}
+
+bool ON_Internal_TransformPointList3(int simd_level, int count, int stride, double* points, const ON_Xform& xform, float* float_points, ON_BoundingBox* bbox, bool& rc)
+{
+  double box[6];
+  if (!ON_Internal_SIMD_TransformPoints3(simd_level, count, stride, points, xform, float_points, (nullptr != bbox) ? box : nullptr, rc))
+    return false;
+  if (nullptr != bbox)
+  {
+    bbox->m_min.Set(box[0], box[1], box[2]);
+    bbox->m_max.Set(box[3], box[4], box[5]);
+  }
+  return true;
+}
+
+bool ON_Internal_TransformPointList3(int simd_level, int count, int stride, float* points, const ON_Xform& xform, ON_BoundingBox* bbox, bool& rc)
+{
+  double box[6];
+  if (!ON_Internal_SIMD_TransformPoints3(simd_level, count, stride, points, xform, nullptr, (nullptr != bbox) ? box : nullptr, rc))
+    return false;
+  if (nullptr != bbox)
+  {
+    bbox->m_min.Set(box[0], box[1], box[2]);
+    bbox->m_max.Set(box[3], box[4], box[5]);
+  }
+  return true;
+}
+
+
+static bool ON_Internal_TransformPointList(
+                  int simd_level,
                   int dim, bool is_rat, int count, 
                   int stride, float* point,
                   const ON_Xform& xform
@@ -1489,6 +2246,16 @@ bool ON_TransformPointList(
   if (count == 0)
     return true;
 
+  if ( 3 == dim )
+  {
+    // SSE2 / AVX2 kernels
+    if ( is_rat 
+         ? ON_Internal_SIMD_TransformRationalPoints3(simd_level, count, stride, point, xform)
+         : ON_Internal_SIMD_TransformPoints3(simd_level, count, stride, point, xform, nullptr, nullptr, rc)
+       )
+      return rc;
+  }
+
   if (is_rat) {
     switch(dim) {
     case 1:
@@ -1572,8 +2339,18 @@ bool ON_TransformPointList(
   return rc;
 }
 
-
 bool ON_TransformPointList(
+                  int dim, bool is_rat, int count, 
+                  int stride, float* point,
+                  const ON_Xform& xform
+                  )
+{
+  return ON_Internal_TransformPointList(ON_Internal_SIMDLevel(), dim, is_rat, count, stride, point, xform);
+}
+
+
+static bool ON_Internal_TransformPointList(
+                  int simd_level,
                   int dim, bool is_rat, int count, 
                   int stride, double* point,
                   const ON_Xform& xform
@@ -1588,6 +2365,16 @@ bool ON_TransformPointList(
   if (count == 0)
     return true;
 
+  if ( 3 == dim )
+  {
+    // SSE2 / AVX2 kernels
+    if ( is_rat 
+         ? ON_Internal_SIMD_TransformRationalPoints3(simd_level, count, stride, point, xform)
+         : ON_Internal_SIMD_TransformPoints3(simd_level, count, stride, point, xform, nullptr, nullptr, rc)
+       )
+      return rc;
+  }
+
   if (is_rat) {
     switch(dim) {
     case 1:
@@ -1671,6 +2458,15 @@ bool ON_TransformPointList(
   return rc;
 }
 
+bool ON_TransformPointList(
+                  int dim, bool is_rat, int count, 
+                  int stride, double* point,
+                  const ON_Xform& xform
+                  )
+{
+  return ON_Internal_TransformPointList(ON_Internal_SIMDLevel(), dim, is_rat, count, stride, point, xform);
+}
+
 
 bool 
 ON_TransformPointGrid(
@@ -1697,8 +2493,8 @@ ON_TransformPointGrid(
 }
 
 
-bool 
-ON_TransformVectorList(
+static bool ON_Internal_TransformVectorList(
+                  int simd_level,
                   int dim, int count, 
                   int stride, float* vector,
                   const ON_Xform& xform
@@ -1713,6 +2509,9 @@ ON_TransformVectorList(
   if (count == 0)
     return true;
 
+  if ( 3 == dim && ON_Internal_SIMD_TransformVectors3(simd_level, count, stride, vector, xform) )
+    return rc; // SSE2 / AVX2 kernel
+
   switch(dim) {
   case 1:
     while(count--) {
@@ -1743,10 +2542,20 @@ ON_TransformVectorList(
   return rc;
 }
 
-
-
 bool 
 ON_TransformVectorList(
+                  int dim, int count, 
+                  int stride, float* vector,
+                  const ON_Xform& xform
+                  )
+{
+  return ON_Internal_TransformVectorList(ON_Internal_SIMDLevel(), dim, count, stride, vector, xform);
+}
+
+
+
+static bool ON_Internal_TransformVectorList(
+                  int simd_level,
                   int dim, int count, 
                   int stride, double* vector,
                   const ON_Xform& xform
@@ -1761,6 +2570,9 @@ ON_TransformVectorList(
   if (count == 0)
     return true;
 
+  if ( 3 == dim && ON_Internal_SIMD_TransformVectors3(simd_level, count, stride, vector, xform) )
+    return rc; // SSE2 / AVX2 kernel
+
   switch(dim) {
   case 1:
     while(count--) {
@@ -1791,6 +2603,264 @@ ON_TransformVectorList(
   return rc;
 }
 
+bool 
+ON_TransformVectorList(
+                  int dim, int count, 
+                  int stride, double* vector,
+                  const ON_Xform& xform
+                  )
+{
+  return ON_Internal_TransformVectorList(ON_Internal_SIMDLevel(), dim, count, stride, vector, xform);
+}
+
+bool ON_TransformPointListAndGetBoundingBox(
+  int dim, 
+  bool is_rat, 
+  int count, 
+  int stride, 
+  double* points,
+  const ON_Xform& xform,
+  ON_BoundingBox& bbox
+  )
+{
+  if ( 3 == dim && !is_rat && ON_IsValidPointList( dim, is_rat, count, stride, points ) )
+  {
+    // transform and bound in a single pass
+    bool rc = true;
+    if ( ON_Internal_TransformPointList3(ON_Internal_SIMDLevel(), count, stride, points, xform, nullptr, &bbox, rc) )
+      return rc;
+  }
+  bool rc = ON_TransformPointList(dim, is_rat, count, stride, points, xform);
+  if ( !ON_GetPointListBoundingBox(dim, is_rat, count, stride, points, bbox, false, nullptr) )
+    rc = false;
+  return rc;
+}
+
+bool ON_TransformPointListAndGetBoundingBox(
+  int dim, 
+  bool is_rat, 
+  int count, 
+  int stride, 
+  float* points,
+  const ON_Xform& xform,
+  ON_BoundingBox& bbox
+  )
+{
+  if ( 3 == dim && !is_rat && ON_IsValidPointList( dim, is_rat, count, stride, points ) )
+  {
+    // transform and bound in a single pass
+    bool rc = true;
+    if ( ON_Internal_TransformPointList3(ON_Internal_SIMDLevel(), count, stride, points, xform, &bbox, rc) )
+      return rc;
+  }
+  bool rc = ON_TransformPointList(dim, is_rat, count, stride, points, xform);
+  if ( !ON_GetPointListBoundingBox(dim, is_rat, count, stride, points, bbox, false, nullptr) )
+    rc = false;
+  return rc;
+}
+
+// Portable bounding box of a dim = 3 point list. Used to check the kernels.
+template <class T>
+static ON_BoundingBox ON_Internal_PointListBoundingBox3(int count, int stride, const T* point)
+{
+  ON_BoundingBox bbox;
+  for (int i = 0; i < count; i++)
+    bbox.Set(ON_3dPoint(point[i*stride], point[i*stride+1], point[i*stride+2]), 0 != i);
+  return bbox;
+}
+
+template <class T>
+static unsigned int ON_Internal_TestPointListKernels(
+  int simd_level,
+  int count,
+  int stride,
+  const T* src,
+  const ON_Xform& xform,
+  const char* type_name,
+  ON_TextLog* text_log
+  )
+{
+  const int max_count = 16;
+  const int max_stride = 5;
+  T p0[max_count*max_stride];
+  T p1[max_count*max_stride];
+  const size_t sizeof_points = count*stride*sizeof(p0[0]);
+  unsigned int failure_count = 0;
+
+  const char* test_name[3] = { "ON_TransformPointList", "ON_TransformPointList(is_rat=true)", "ON_TransformVectorList" };
+  for (int test = 0; test < 3; test++)
+  {
+    const bool is_rat = (1 == test);
+    if (is_rat && stride < 4)
+      continue;
+    memcpy(p0, src, sizeof_points);
+    const bool rc0 = (2 == test)
+      ? ON_Internal_TransformVectorList(0, 3, count, stride, p0, xform)
+      : ON_Internal_TransformPointList(0, 3, is_rat, count, stride, p0, xform);
+    for (int level = 1; level <= simd_level; level++)
+    {
+      memcpy(p1, src, sizeof_points);
+      const bool rc1 = (2 == test)
+        ? ON_Internal_TransformVectorList(level, 3, count, stride, p1, xform)
+        : ON_Internal_TransformPointList(level, 3, is_rat, count, stride, p1, xform);
+      if (rc0 != rc1 || 0 != memcmp(p0, p1, sizeof_points))
+      {
+        failure_count++;
+        if (text_log)
+          text_log->Print("%s(%s,count=%d,stride=%d) simd level %d is different.\n", test_name[test], type_name, count, stride, level);
+      }
+    }
+  }
+
+  if (count > 0)
+  {
+    // ON_GetPointListBoundingBox() kernels
+    const ON_BoundingBox bbox0 = ON_Internal_PointListBoundingBox3(count, stride, src);
+    for (int level = 1; level <= simd_level; level++)
+    {
+      ON_BoundingBox bbox1 = ON_BoundingBox::UnsetBoundingBox;
+      if (!ON_Internal_GetPointListBoundingBox3(level, count, stride, src, bbox1) || 0 != memcmp(&bbox0, &bbox1, sizeof(bbox0)))
+      {
+        failure_count++;
+        if (text_log)
+          text_log->Print("ON_GetPointListBoundingBox(%s,count=%d,stride=%d) simd level %d is different.\n", type_name, count, stride, level);
+      }
+    }
+  }
+
+  return failure_count;
+}
+
+// ON_Internal_TransformPointList3() with the same arguments for float and
+// double lists. Double lists also save the transformed points as floats.
+static bool ON_Internal_TestTransformAndBound3(int simd_level, int count, int stride, double* points, const ON_Xform& xform, float* float_points, ON_BoundingBox* bbox, bool& rc)
+{
+  return ON_Internal_TransformPointList3(simd_level, count, stride, points, xform, float_points, bbox, rc);
+}
+
+static bool ON_Internal_TestTransformAndBound3(int simd_level, int count, int stride, float* points, const ON_Xform& xform, float*, ON_BoundingBox* bbox, bool& rc)
+{
+  return ON_Internal_TransformPointList3(simd_level, count, stride, points, xform, bbox, rc);
+}
+
+template <class T>
+static unsigned int ON_Internal_TestTransformAndBoundKernels(
+  int simd_level,
+  int count,
+  int stride,
+  const T* src,
+  const ON_Xform& xform,
+  const char* type_name,
+  ON_TextLog* text_log
+  )
+{
+  if (count <= 0)
+    return 0;
+
+  const int max_count = 16;
+  const int max_stride = 5;
+  T p0[max_count*max_stride];
+  T p1[max_count*max_stride];
+  float f0[3*max_count];
+  float f1[3*max_count];
+  const size_t sizeof_points = count*stride*sizeof(p0[0]);
+  const bool bFloats = (sizeof(T) == sizeof(double));
+  unsigned int failure_count = 0;
+
+  memcpy(p0, src, sizeof_points);
+  const bool rc0 = ON_Internal_TransformPointList(0, 3, false, count, stride, p0, xform);
+  for (int i = 0; i < count; i++)
+  {
+    f0[3*i] = (float)p0[i*stride];
+    f0[3*i+1] = (float)p0[i*stride+1];
+    f0[3*i+2] = (float)p0[i*stride+2];
+  }
+  const ON_BoundingBox bbox0 = ON_Internal_PointListBoundingBox3(count, stride, p0);
+
+  for (int level = 1; level <= simd_level; level++)
+  {
+    memcpy(p1, src, sizeof_points);
+    memset(f1, 0, sizeof(f1));
+    ON_BoundingBox bbox1 = ON_BoundingBox::UnsetBoundingBox;
+    bool rc1 = true;
+    if (!ON_Internal_TestTransformAndBound3(level, count, stride, p1, xform, bFloats ? f1 : nullptr, &bbox1, rc1)
+      || rc0 != rc1
+      || 0 != memcmp(p0, p1, sizeof_points)
+      || (bFloats && 0 != memcmp(f0, f1, 3*count*sizeof(f0[0])))
+      || 0 != memcmp(&bbox0, &bbox1, sizeof(bbox0))
+      )
+    {
+      failure_count++;
+      if (text_log)
+        text_log->Print("ON_TransformPointListAndGetBoundingBox(%s,count=%d,stride=%d) simd level %d is different.\n", type_name, count, stride, level);
+    }
+  }
+
+  return failure_count;
+}
+
+unsigned int ON_TestPointListKernels( ON_TextLog* text_log )
+{
+  // Random point lists with every count below 16, so every remainder 
+  // after the 2 point SSE2 blocks and the 4 point AVX2 blocks is tested.
+  // Some transformations have w = 0 at a point. The results of every
+  // SIMD level the cpu supports must be bit-identical to the portable code.
+  ON_RandomNumberGenerator rng;
+  rng.Seed(19);
+  const int simd_level = ON_Internal_SIMDLevel();
+  unsigned int failure_count = 0;
+
+  const int max_count = 16;
+  const int max_stride = 5;
+  double dsrc[max_count*max_stride];
+  float fsrc[max_count*max_stride];
+
+  for ( int test_index = 0; test_index < 24; test_index++ )
+  {
+    const int stride = 3 + test_index%3;
+    for ( int count = 0; count < max_count; count++ )
+    {
+      for ( int i = 0; i < count*stride; i++ )
+      {
+        dsrc[i] = rng.RandomDouble(-10.0,10.0);
+        if ( 3 == i%stride )
+          dsrc[i] = rng.RandomDouble(0.5,2.0); // weight
+        fsrc[i] = (float)dsrc[i];
+      }
+
+      ON_Xform xform;
+      for ( int i = 0; i < 3; i++ )
+      {
+        for ( int j = 0; j < 4; j++ )
+          xform.m_xform[i][j] = rng.RandomDouble(-2.0,2.0);
+      }
+      xform.m_xform[3][0] = xform.m_xform[3][1] = xform.m_xform[3][2] = 0.0;
+      xform.m_xform[3][3] = 1.0;
+      if ( 1 == (test_index/3)%4 )
+      {
+        // projective
+        for ( int j = 0; j < 3; j++ )
+          xform.m_xform[3][j] = rng.RandomDouble(-0.05,0.05);
+      }
+      else if ( 2 == (test_index/3)%4 && count > 0 )
+      {
+        // w = 0 at the last point of the double and float lists
+        const int k = (count-1)*stride;
+        dsrc[k] = fsrc[k];
+        xform.m_xform[3][0] = 1.0;
+        xform.m_xform[3][3] = -dsrc[k];
+      }
+
+      failure_count += ON_Internal_TestPointListKernels(simd_level, count, stride, dsrc, xform, "double", text_log);
+      failure_count += ON_Internal_TestPointListKernels(simd_level, count, stride, fsrc, xform, "float", text_log);
+      failure_count += ON_Internal_TestTransformAndBoundKernels(simd_level, count, stride, dsrc, xform, "double", text_log);
+      failure_count += ON_Internal_TestTransformAndBoundKernels(simd_level, count, stride, fsrc, xform, "float", text_log);
+    }
+  }
+
+  return failure_count;
+}
+
 bool ON_PointsAreCoincident(
     int dim,
     bool is_rat,
@@ -797,6 +797,75 @@ bool ON_TransformVectorList(
        const ON_Xform&
        );
 
+/*
+Description:
+  Transform a list of points and get the bounding box of the
+  transformed points.
+Parameters:
+  dim - [in]
+    >= 1
+  is_rat - [in]
+    true if the points are rational and points[dim] is the "weight"
+  count - [in]
+    number of points
+  stride - [in]
+    >= (is_rat) ? (dim+1) : dim
+  points - [in/out]
+    points to transform
+  xform - [in]
+    transformation
+  bbox - [out]
+    bounding box of the transformed points
+Returns:
+  True if the points were transformed and bbox is set.
+Remarks:
+  The result is the same as calling ON_TransformPointList() and then
+  ON_GetPointListBoundingBox(). When dim = 3 and is_rat is false,
+  the points are transformed and bounded in a single pass.
+See Also:
+  ON_TransformPointList
+  ON_GetPointListBoundingBox
+*/
+ON_DECL
+bool ON_TransformPointListAndGetBoundingBox(
+  int dim, 
+  bool is_rat, 
+  int count, 
+  int stride, 
+  double* points,
+  const ON_Xform& xform,
+  ON_BoundingBox& bbox
+  );
+
+ON_DECL
+bool ON_TransformPointListAndGetBoundingBox(
+  int dim, 
+  bool is_rat, 
+  int count, 
+  int stride, 
+  float* points,
+  const ON_Xform& xform,
+  ON_BoundingBox& bbox
+  );
+
+/*
+Description:
+  Test tool. Transforms and bounds random dim = 3 point lists with 
+  every SSE2 / AVX2 kernel the cpu supports and with the portable code.
+  ON_TransformPointList(), ON_TransformVectorList(), 
+  ON_GetPointListBoundingBox() and ON_TransformPointListAndGetBoundingBox()
+  are tested for float and double lists.
+Parameters:
+  text_log - [in]
+    If not nullptr, the lists that are different are printed here.
+Returns:
+  Number of lists where the results are not bit-identical.
+*/
+ON_DECL
+unsigned int ON_TestPointListKernels( 
+  class ON_TextLog* text_log 
+  );
+
 /*
 Parameters:
   dim - [in]
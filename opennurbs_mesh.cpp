@@ -13,6 +13,9 @@
 
 #include "opennurbs.h"
 
+#include <algorithm>
+#include <condition_variable>
+
 #if !defined(ON_COMPILING_OPENNURBS)
 // This check is included in all opennurbs source .c and .cpp files to insure
 // ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
@@ -21,7 +24,8 @@
 #error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
-
+// ON_Internal_ParallelFor()
+#include "opennurbs_internal_defines.h"
 
 
 // NEVER COPY OR MOVE THE NEXT 2 LINES
@@ -2935,8 +2939,18 @@ bool ON_Mesh::Transform(
 
   const bool bSyncheddV = bIsValid_fV && bIsValid_dV && HasSynchronizedDoubleAndSinglePrecisionVertices();
 
+  // When the SIMD kernels are available, the vertices are transformed,
+  // converted to floats and bounded in a single pass.
+  ON_BoundingBox vertex_bbox = ON_BoundingBox::UnsetBoundingBox;
+  bool bUpdatedfV = false;
   if (bIsValid_dV)
-    ON_TransformPointList(3, false, vertex_count, 3, &m_dV[0][0], xform);
+  {
+    bool bNonZeroW = true;
+    if (ON_Internal_TransformPointList3(ON_Internal_SIMDLevel(), vertex_count, 3, &m_dV[0][0], xform, bSyncheddV ? &m_V[0][0] : nullptr, &vertex_bbox, bNonZeroW))
+      bUpdatedfV = bSyncheddV;
+    else
+      ON_TransformPointList(3, false, vertex_count, 3, &m_dV[0][0], xform);
+  }
   
   double d = xform.Determinant();
   bool rc = false;
@@ -2944,12 +2958,15 @@ bool ON_Mesh::Transform(
   {
     // transforming the double precision vertices is the 
     // best way to set the floats.
-    UpdateSinglePrecisionVertices();
+    if (false == bUpdatedfV)
+      UpdateSinglePrecisionVertices();
     rc = true;
   }
   else if ( bIsValid_fV )
   {
-    rc = ON_TransformPointList( 3, false, vertex_count, 3, &m_V[0][0], xform );
+    // When m_dV[] is valid, GetBBox() uses the double precision box.
+    if ( false == ON_Internal_TransformPointList3(ON_Internal_SIMDLevel(), vertex_count, 3, &m_V[0][0], xform, bIsValid_dV ? nullptr : &vertex_bbox, rc) )
+      rc = ON_TransformPointList( 3, false, vertex_count, 3, &m_V[0][0], xform );
   }
 
   if ( rc )
@@ -3048,6 +3065,8 @@ bool ON_Mesh::Transform(
   }
 
   InvalidateVertexBoundingBox();
+  if ( bIsValid_fV && vertex_bbox.IsValid() )
+    m_vertex_bbox = vertex_bbox;
   InvalidateVertexNormalBoundingBox();
   if ( fabs(d) <= ON_ZERO_TOLERANCE )
     DestroyTopology(); // transform may not be one-to-one on vertices
@@ -4547,11 +4566,37 @@ bool ON_Mesh::GetCurvatureStats( // returns true if successful
   return rc;
 }
 
-int ON_MeshTopology::WaitUntilReady(int sleep_value) const
+class ON_MeshTopologyCalculation
 {
+public:
+  std::mutex m_mutex;
+  // notified when a calculation started by ON_Mesh::Topology() or
+  // ON_Mesh::CreateTopologyInBackground() finishes.
+  std::condition_variable m_ready;
+  std::thread* m_background_thread = nullptr;
+};
 
+int ON_MeshTopology::Internal_WaitUntilReady(std::unique_lock<std::mutex>& lock) const
+{
+  // lock holds m_calculation->m_mutex.
+  m_calculation->m_ready.wait(lock, [this]() { return -1 != m_b32IsValid; });
+  if ( nullptr != m_calculation->m_background_thread )
+  {
+    // The background thread has set m_b32IsValid and is about to exit.
+    m_calculation->m_background_thread->join();
+    delete m_calculation->m_background_thread;
+    m_calculation->m_background_thread = nullptr;
+  }
   return m_b32IsValid;
+}
 
+int ON_MeshTopology::WaitUntilReady(int sleep_value) const
+{
+  std::unique_lock<std::mutex> lock(m_calculation->m_mutex);
+  // When sleep_value is 0, do not wait for a calculation that is in progress.
+  if ( 0 == sleep_value && -1 == m_b32IsValid )
+    return -1;
+  return Internal_WaitUntilReady(lock);
 }
 
 
@@ -4567,19 +4612,76 @@ bool ON_Mesh::HasMeshTopology() const
 
 const ON_MeshTopology& ON_Mesh::Topology() const
 {
-  int top_b32IsValid =  m_top.WaitUntilReady(-1);
-
-  if ( 0 == top_b32IsValid ) 
+  ON_MeshTopology& top = const_cast<ON_MeshTopology&>(m_top);
+  std::unique_lock<std::mutex> lock(top.m_calculation->m_mutex);
+  if ( 0 == top.Internal_WaitUntilReady(lock) )
   {
-    ON_MeshTopology& top = const_cast<ON_MeshTopology&>(m_top);
+    // Other threads that call Topology() wait on m_ready until the
+    // calculation is finished. m_mutex is not held during Create().
     top.m_mesh = this;
-    top_b32IsValid = top.Create() ? 1 : 0;
-    top.m_b32IsValid = top_b32IsValid;
+    // Create() does not change m_b32IsValid when it is -1.
+    top.m_b32IsValid = -1;
+    lock.unlock();
+    int b32IsValid = 0;
+    try
+    {
+      b32IsValid = top.Create(0) ? 1 : 0;
+    }
+    catch (...)
+    {
+      lock.lock();
+      top.m_b32IsValid = 0;
+      top.m_calculation->m_ready.notify_all();
+      throw;
+    }
+    lock.lock();
+    top.m_b32IsValid = b32IsValid;
+    top.m_calculation->m_ready.notify_all();
   }
 
   return m_top;
 }
 
+bool ON_Mesh::CreateTopologyInBackground(unsigned int thread_count) const
+{
+  ON_MeshTopology& top = const_cast<ON_MeshTopology&>(m_top);
+  ON_MeshTopologyCalculation* calculation = top.m_calculation;
+  std::unique_lock<std::mutex> lock(calculation->m_mutex);
+  if ( nullptr != calculation->m_background_thread || 1 == top.m_b32IsValid )
+    return true;
+  if ( 0 != top.m_b32IsValid || m_V.UnsignedCount() < 1 )
+    return false;
+
+  top.m_mesh = this;
+  // Create() does not change m_b32IsValid when it is -1.
+  top.m_b32IsValid = -1;
+  try
+  {
+    calculation->m_background_thread = new std::thread([&top, calculation, thread_count]()
+    {
+      int b32IsValid = 0;
+      try
+      {
+        b32IsValid = top.Create(thread_count) ? 1 : 0;
+      }
+      catch (...)
+      {
+      }
+      std::lock_guard<std::mutex> thread_lock(calculation->m_mutex);
+      top.m_b32IsValid = b32IsValid;
+      calculation->m_ready.notify_all();
+    });
+  }
+  catch (...)
+  {
+    // The thread could not be started.
+    calculation->m_background_thread = nullptr;
+    top.m_b32IsValid = 0;
+    return false;
+  }
+  return true;
+}
+
 static ON_MeshTriangle ON_UnsetMeshTriangleInitalizer()
 {
   ON_MeshTriangle unset_mesh_triangle;
@@ -4720,6 +4822,7 @@ const ON_MeshFace ON_MeshFace::UnsetMeshFace(ON_UnsetMeshFaceInitalizer());
 
 void ON_Mesh::DestroyTopology()
 {
+  // Destroy() waits for a background calculation to finish.
   m_top.Destroy();
 }
 
@@ -5002,86 +5105,7 @@ bool ON_Mesh::ComputeFaceNormal( int fi )
 
 bool ON_Mesh::ComputeFaceNormals()
 {
-  bool rc = false;
-  //const unsigned int vcount = VertexUnsignedCount();
-  const int fcount = FaceCount();
-  if ( fcount > 0 )
-  {
-    ON_3dVector a, b, n;
-    int fi;
-    const int* vi;
-    if ( m_FN.Capacity() < fcount )
-      m_FN.SetCapacity(fcount);
-    m_FN.SetCount(0);
-    rc = true;
-    if ( HasSynchronizedDoubleAndSinglePrecisionVertices() )
-    {      
-      const ON_3dPointArray& dV = DoublePrecisionVertices();
-      for ( fi = 0; fi < fcount; fi++ ) {
-        vi = m_F[fi].vi;
-        a = dV[vi[2]] - dV[vi[0]];
-        b = dV[vi[3]] - dV[vi[1]];
-        n = ON_CrossProduct( a, b ); // works for triangles, quads, and nonplanar quads
-        n.Unitize();
-        m_FN.AppendNew() = ON_3fVector(n);
-      }
-    }
-    else
-    {
-      for ( fi = 0; fi < fcount; fi++ ) {
-        vi = m_F[fi].vi;
-        a = m_V[vi[2]] - m_V[vi[0]];
-        b = m_V[vi[3]] - m_V[vi[1]];
-        n = ON_CrossProduct( a, b ); // works for triangles, quads, and nonplanar quads
-        n.Unitize();
-        m_FN.AppendNew() = ON_3fVector(n);
-      }
-    }
-  }
-  else 
-  {
-    m_FN.Destroy();
-  }
-  return rc;
-}
-
-
-//static int compareRadial3fPoint( const ON_3fPoint* a, const ON_3fPoint* b )
-//{
-//  double ar = a->x+a->y+a->z;
-//  double br = b->x+b->y+b->z;
-//  if ( ar < br )
-//    return -1;
-//  if ( ar > br )
-//    return 1;
-//  return 0;
-//}
-
-bool ON_Mesh::CombineCoincidentVertices( 
-        const ON_3fVector tolerance,
-        double cos_normal_angle // = -1.0  // cosine(break angle) -1.0 will merge all coincident vertices
-        )
-{
-  // TODO - If you need this function, please ask Dale Lear to finish it.
-  //bool rc = false;
-  //const int vcount = VertexCount();
-  //if ( vcount > 0 && rc ) {
-  //  ON_Workspace ws;
-  //  int* index = ws.GetIntMemory(vcount);
-  //  rc = m_V.Sort( ON::sort_algorithm::quick_sort, index, compareRadial3fPoint );
-  //  int i, j;
-  //  ON_3fPoint p0, p1, pmin, pmax;
-  //  for ( i = 0; i < vcount; i++ ) {
-  //    p0 = m_V[i];
-  //    pmin = p0 - tolerance;
-  //    pmax = p0 + tolerance;
-  //    for ( j = i+1; j < vcount; j++ ) {
-  //      p1 = m_V[j];
-  //      // TODO        
-  //    }
-  //  }
-  //}
-  return false;
+  return ComputeFaceNormals(0);
 }
 
 
@@ -5174,6 +5198,436 @@ static int CompareMeshPoint(const void* a,const void* b,void* ptr)
   return 0;
 }
 
+// Vertex loops are split into blocks of this size. Meshes with fewer
+// vertices are processed on the calling thread.
+#define ON_MESH_PARALLEL_BLOCK_SIZE 0x10000U
+
+static unsigned int ON_Internal_MeshThreadCount(
+  unsigned int thread_count,
+  unsigned int item_count
+  )
+{
+  thread_count = ON_Internal_ParallelThreadCount(thread_count);
+  const unsigned int block_count = (item_count + ON_MESH_PARALLEL_BLOCK_SIZE - 1) / ON_MESH_PARALLEL_BLOCK_SIZE;
+  if (thread_count > block_count)
+    thread_count = (block_count > 0) ? block_count : 1;
+  return thread_count;
+}
+
+static ON__UINT64 ON_Internal_MeshWeldMix(ON__UINT64 h, ON__UINT64 x)
+{
+  h ^= x + 0x9E3779B97F4A7C15ULL + (h << 6) + (h >> 2);
+  return h;
+}
+
+static ON__UINT64 ON_Internal_MeshWeldFloatBits(float x)
+{
+  // -0.0f and 0.0f compare equal and must hash the same.
+  ON__UINT32 u = 0;
+  if (0.0f != x)
+    memcpy(&u, &x, sizeof(u));
+  return u;
+}
+
+static ON__UINT64 ON_Internal_MeshWeldDoubleBits(double x)
+{
+  ON__UINT64 u = 0;
+  if (0.0 != x)
+    memcpy(&u, &x, sizeof(u));
+  return u;
+}
+
+/*
+Returns:
+  A hash of the vertex attributes CompareMeshPoint() uses. Vertices
+  that CompareMeshPoint() says are equal have the same hash.
+*/
+static ON__UINT32 ON_Internal_MeshWeldHash(const struct tagMESHPOINTS& mp, int k)
+{
+  ON__UINT64 h = 0;
+  h = ON_Internal_MeshWeldMix(h, ON_Internal_MeshWeldFloatBits(mp.V[k].x));
+  h = ON_Internal_MeshWeldMix(h, ON_Internal_MeshWeldFloatBits(mp.V[k].y));
+  h = ON_Internal_MeshWeldMix(h, ON_Internal_MeshWeldFloatBits(mp.V[k].z));
+  if (nullptr != mp.N)
+  {
+    h = ON_Internal_MeshWeldMix(h, ON_Internal_MeshWeldFloatBits(mp.N[k].x));
+    h = ON_Internal_MeshWeldMix(h, ON_Internal_MeshWeldFloatBits(mp.N[k].y));
+    h = ON_Internal_MeshWeldMix(h, ON_Internal_MeshWeldFloatBits(mp.N[k].z));
+  }
+  if (nullptr != mp.T)
+  {
+    h = ON_Internal_MeshWeldMix(h, ON_Internal_MeshWeldFloatBits(mp.T[k].x));
+    h = ON_Internal_MeshWeldMix(h, ON_Internal_MeshWeldFloatBits(mp.T[k].y));
+  }
+  if (nullptr != mp.C)
+    h = ON_Internal_MeshWeldMix(h, (unsigned int)mp.C[k]);
+  if (nullptr != mp.K)
+  {
+    h = ON_Internal_MeshWeldMix(h, ON_Internal_MeshWeldDoubleBits(mp.K[k].k1));
+    h = ON_Internal_MeshWeldMix(h, ON_Internal_MeshWeldDoubleBits(mp.K[k].k2));
+  }
+  // finalize so the high and low bits are both well mixed
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ULL;
+  h ^= h >> 33;
+  return (ON__UINT32)h;
+}
+
+/*
+Description:
+  Find identical vertices with a hash table and number them in the
+  order the ON_Sort() of CompareMeshPoint() used to produce.
+Parameters:
+  mp - [in]
+  vertex_count - [in]
+  thread_count - [in]
+  remap - [out]
+    remap[k] = index of vertex k in the combined vertex list.
+Returns:
+  Number of distinct vertices.
+*/
+static int ON_Internal_MeshWeldIdenticalVertices(
+  const struct tagMESHPOINTS& mp,
+  int vertex_count,
+  unsigned int thread_count,
+  int* remap
+  )
+{
+  void* mp_ptr = const_cast<struct tagMESHPOINTS*>(&mp);
+  const char* p0 = mp.p0;
+  thread_count = ON_Internal_MeshThreadCount(thread_count, (unsigned int)vertex_count);
+
+  const unsigned int block_size = ON_MESH_PARALLEL_BLOCK_SIZE;
+  const unsigned int block_count = ((unsigned int)vertex_count + block_size - 1) / block_size;
+
+  // The top 8 bits of a hash select a partition and each partition
+  // is welded independently.
+  const unsigned int partition_count = 256;
+
+  ON_SimpleArray<ON__UINT32> hash_array(vertex_count);
+  hash_array.SetCount(vertex_count);
+  ON__UINT32* hash = hash_array.Array();
+
+  ON_SimpleArray<unsigned int> offset_array(block_count*partition_count);
+  offset_array.SetCount(block_count*partition_count);
+  offset_array.Zero();
+  unsigned int* offset = offset_array.Array();
+
+  ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
+  {
+    const unsigned int i1 = (block + 1)*block_size < (unsigned int)vertex_count ? (block + 1)*block_size : (unsigned int)vertex_count;
+    unsigned int* counts = offset + block*partition_count;
+    for (unsigned int i = block*block_size; i < i1; i++)
+    {
+      hash[i] = ON_Internal_MeshWeldHash(mp, (int)i);
+      counts[hash[i] >> 24]++;
+    }
+  });
+
+  // Sort vertex indices by partition. Within a partition, the indices
+  // increase, so the first vertex found in a group has the smallest
+  // index.
+  unsigned int partition_start[257];
+  unsigned int n = 0;
+  for (unsigned int p = 0; p < partition_count; p++)
+  {
+    partition_start[p] = n;
+    for (unsigned int block = 0; block < block_count; block++)
+    {
+      const unsigned int c = offset[block*partition_count + p];
+      offset[block*partition_count + p] = n;
+      n += c;
+    }
+  }
+  partition_start[partition_count] = n;
+
+  ON_SimpleArray<int> order_array(vertex_count);
+  order_array.SetCount(vertex_count);
+  int* order = order_array.Array();
+  ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
+  {
+    const unsigned int i1 = (block + 1)*block_size < (unsigned int)vertex_count ? (block + 1)*block_size : (unsigned int)vertex_count;
+    unsigned int* next = offset + block*partition_count;
+    for (unsigned int i = block*block_size; i < i1; i++)
+      order[next[hash[i] >> 24]++] = (int)i;
+  });
+  offset_array.Destroy();
+
+  // rep[i] = smallest index of a vertex identical to vertex i
+  ON_SimpleArray<int> rep_array(vertex_count);
+  rep_array.SetCount(vertex_count);
+  int* rep = rep_array.Array();
+  std::atomic<int> distinct_count(0);
+  ON_Internal_ParallelFor(thread_count, partition_count, [&](unsigned int p)
+  {
+    const unsigned int count = partition_start[p + 1] - partition_start[p];
+    if (0 == count)
+      return;
+    unsigned int capacity = 16;
+    while (capacity < 2 * count)
+      capacity *= 2;
+    const unsigned int mask = capacity - 1;
+    ON_SimpleArray<int> table(capacity);
+    table.SetCount(capacity);
+    memset(table.Array(), 0xFF, capacity*sizeof(int));
+
+    int local_count = 0;
+    for (unsigned int s = partition_start[p]; s < partition_start[p + 1]; s++)
+    {
+      const int i = order[s];
+      for (unsigned int slot = hash[i] & mask; /*empty*/; slot = (slot + 1) & mask)
+      {
+        const int j = table[slot];
+        if (j < 0)
+        {
+          table[slot] = i;
+          rep[i] = i;
+          local_count++;
+          break;
+        }
+        if (hash[j] == hash[i] && 0 == CompareMeshPoint(p0 + j, p0 + i, mp_ptr))
+        {
+          rep[i] = j;
+          break;
+        }
+      }
+    }
+    distinct_count += local_count;
+  });
+  order_array.Destroy();
+  hash_array.Destroy();
+
+  // Number the groups in CompareMeshPoint() order.
+  const int remap_vertex_count = distinct_count;
+  ON_SimpleArray<int> sorted_array(remap_vertex_count);
+  for (int k = 0; k < vertex_count; k++)
+  {
+    if (rep[k] == k)
+      sorted_array.Append(k);
+  }
+  int* sorted = sorted_array.Array();
+  auto precedes = [p0, mp_ptr](int a, int b)
+  {
+    return CompareMeshPoint(p0 + a, p0 + b, mp_ptr) < 0;
+  };
+
+  const unsigned int sort_thread_count = ON_Internal_MeshThreadCount(thread_count, (unsigned int)remap_vertex_count);
+  ON_SimpleArray<unsigned int> chunk_start(sort_thread_count + 1);
+  for (unsigned int c = 0; c <= sort_thread_count; c++)
+    chunk_start.Append((unsigned int)(((ON__UINT64)remap_vertex_count * c) / sort_thread_count));
+  ON_Internal_ParallelFor(sort_thread_count, sort_thread_count, [&](unsigned int c)
+  {
+    std::sort(sorted + chunk_start[c], sorted + chunk_start[c + 1], precedes);
+  });
+  for (unsigned int width = 1; width < sort_thread_count; width *= 2)
+  {
+    const unsigned int merge_count = (sort_thread_count + 2 * width - 1) / (2 * width);
+    ON_Internal_ParallelFor(thread_count, merge_count, [&](unsigned int m)
+    {
+      const unsigned int c0 = 2 * width*m;
+      const unsigned int c1 = (c0 + width < sort_thread_count) ? (c0 + width) : sort_thread_count;
+      const unsigned int c2 = (c0 + 2 * width < sort_thread_count) ? (c0 + 2 * width) : sort_thread_count;
+      if (c1 < c2)
+        std::inplace_merge(sorted + chunk_start[c0], sorted + chunk_start[c1], sorted + chunk_start[c2], precedes);
+    });
+  }
+
+  for (int g = 0; g < remap_vertex_count; g++)
+    remap[sorted[g]] = g;
+  ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
+  {
+    const unsigned int i1 = (block + 1)*block_size < (unsigned int)vertex_count ? (block + 1)*block_size : (unsigned int)vertex_count;
+    for (unsigned int i = block*block_size; i < i1; i++)
+    {
+      if (rep[i] != (int)i)
+        remap[i] = remap[rep[i]];
+    }
+  });
+
+  return remap_vertex_count;
+}
+
+/*
+Description:
+  Replace the mesh vertices with remap_vertex_count combined vertices
+  and update the face and ngon vertex indices.
+Parameters:
+  remap - [in]
+    remap[k] = index of the combined vertex that replaces vertex k.
+  bAverageNormals - [in]
+    If true, the vertex normals of combined vertices are averaged.
+  bKeepTextureCoordinates - [in]
+    If false, texture coordinates, colors and principal curvatures
+    are removed.
+*/
+static void ON_Internal_CombineMeshVertices(
+  ON_Mesh& mesh,
+  const int* remap,
+  int remap_vertex_count,
+  bool bAverageNormals,
+  bool bKeepTextureCoordinates,
+  unsigned int thread_count
+  )
+{
+  int k;
+  const int vertex_count = mesh.m_V.Count();
+
+  struct tagMESHPOINTS mp;
+  memset(&mp,0,sizeof(mp));
+  mp.V = mesh.m_V.Array();
+  mp.N = mesh.HasVertexNormals()       ? mesh.m_N.Array() : 0;
+  mp.T = mesh.HasTextureCoordinates()  ? mesh.m_T.Array() : 0;
+  mp.C = mesh.HasVertexColors()        ? mesh.m_C.Array() : 0;
+  mp.K = mesh.HasPrincipalCurvatures() ? mesh.m_K.Array() : 0;
+
+  ON_SimpleArray<ON_3fPoint> p_array(remap_vertex_count);
+  p_array.SetCount(remap_vertex_count);
+  ON_3fPoint* p = p_array.Array();
+  ON_3fVector* v = (ON_3fVector*)p;
+
+  for ( k = 0; k < vertex_count; k++ )
+  {
+    p[remap[k]] = mp.V[k];
+  }
+  for ( k = 0; k < remap_vertex_count; k++ )
+    mp.V[k] = p[k];
+  mesh.m_V.SetCount(remap_vertex_count);
+
+  if (vertex_count == mesh.m_dV.Count())
+  {
+    ON_SimpleArray<ON_3dPoint> dp_array;
+    ON_3dPoint* dp = dp_array.Reserve(remap_vertex_count);
+    ON_3dPoint* D = mesh.m_dV.Array();
+    for (k = 0; k < vertex_count; k++)
+    {
+      dp[remap[k]] = D[k];
+    }
+    for (k = 0; k < remap_vertex_count; k++)
+      D[k] = dp[k];
+    mesh.m_dV.SetCount(remap_vertex_count);
+  }
+  else
+    mesh.m_dV.Destroy();
+
+  if ( 0 != mp.N )
+  {
+    if ( bAverageNormals )
+    {
+      // average vertex normals of combined vertices
+      p_array.Zero();
+      for ( k = 0; k < vertex_count; k++ )
+      {
+        v[remap[k]] += mp.N[k];
+      }
+      for ( k = 0; k < remap_vertex_count; k++ )
+      {
+        v[k].Unitize();
+      }
+    }
+    else
+    {
+      for ( k = 0; k < vertex_count; k++ )
+      {
+        v[remap[k]] = mp.N[k];
+      }
+    }
+    for ( k = 0; k < remap_vertex_count; k++ )
+      mp.N[k] = v[k];
+    mesh.m_N.SetCount(remap_vertex_count);
+  }
+  else
+    mesh.m_N.SetCount(0);
+
+  if ( 0 != mp.T && bKeepTextureCoordinates )
+  {
+    for ( k = 0; k < vertex_count; k++ )
+    {
+      p[remap[k]] = mp.T[k];
+    }
+    for ( k = 0; k < remap_vertex_count; k++ )
+      mp.T[k] = p[k];
+    mesh.m_T.SetCount(remap_vertex_count);
+  }
+  else
+    mesh.m_T.SetCount(0);
+
+  if ( 0 != mp.C && bKeepTextureCoordinates )
+  {
+    ON_SimpleArray<ON_Color> c_array(remap_vertex_count);
+    c_array.SetCount(remap_vertex_count);
+    ON_Color* c = c_array.Array();
+    for ( k = 0; k < vertex_count; k++ )
+    {
+      c[remap[k]] = mp.C[k];
+    }
+    for ( k = 0; k < remap_vertex_count; k++ )
+      mp.C[k] = c[k];
+    mesh.m_C.SetCount(remap_vertex_count);
+  }
+  else
+    mesh.m_C.SetCount(0);
+
+  if ( 0 != mp.K && bKeepTextureCoordinates )
+  {
+    ON_SimpleArray<ON_SurfaceCurvature> s_array(remap_vertex_count);
+    s_array.SetCount(remap_vertex_count);
+    ON_SurfaceCurvature* s = s_array.Array();
+    for ( k = 0; k < vertex_count; k++ )
+    {
+      s[remap[k]] = mp.K[k];
+    }
+    for ( k = 0; k < remap_vertex_count; k++ )
+      mp.K[k] = s[k];
+    mesh.m_K.SetCount(remap_vertex_count);
+  }
+  else
+    mesh.m_K.SetCount(0);
+
+  const unsigned int face_count = mesh.m_F.UnsignedCount();
+  ON_MeshFace* f = mesh.m_F.Array();
+  const unsigned int block_size = ON_MESH_PARALLEL_BLOCK_SIZE;
+  ON_Internal_ParallelFor(
+    ON_Internal_MeshThreadCount(thread_count, face_count),
+    (face_count + block_size - 1) / block_size,
+    [&](unsigned int block)
+  {
+    const unsigned int fi1 = (block + 1)*block_size < face_count ? (block + 1)*block_size : face_count;
+    for ( unsigned int fi = block*block_size; fi < fi1; fi++ )
+    {
+      int* fvi = f[fi].vi;
+      fvi[0] = remap[fvi[0]];
+      fvi[1] = remap[fvi[1]];
+      fvi[2] = remap[fvi[2]];
+      fvi[3] = remap[fvi[3]];
+    }
+  });
+
+  if ( mesh.HasNgons() )
+  {
+    for ( int ngon_index = 0; ngon_index < mesh.m_Ngon.Count(); ngon_index++ )
+    {
+      ON_MeshNgon* ngon = mesh.m_Ngon[ngon_index];
+      if ( 0 == ngon )
+        continue;
+      for ( unsigned int ngon_vertex_index = 0; ngon_vertex_index < ngon->m_Vcount; ngon_vertex_index++ )
+        ngon->m_vi[ngon_vertex_index] = remap[ngon->m_vi[ngon_vertex_index]];
+    }
+  }
+
+  mesh.DestroyPartition();
+  mesh.DestroyTopology();
+  mesh.m_S.Destroy();
+
+  if ( mesh.m_V.Capacity() > 4*mesh.m_V.Count() && mesh.m_V.Capacity() > 50 )
+  {
+    // There is lots of unused memory in the dynamic arrays.
+    // Release what we can.
+    mesh.Compact();
+  }
+}
+
 unsigned int ON_Mesh::RemoveAllCreases()
 {
   unsigned int vertex_count0 = this->VertexUnsignedCount();
@@ -5189,21 +5643,27 @@ bool ON_Mesh::CombineIdenticalVertices(
                                 bool bIgnoreVertexNormals,
                                 bool bIgnoreTextureCoordinates
                                 )
+{
+  return CombineIdenticalVertices(bIgnoreVertexNormals, bIgnoreTextureCoordinates, 0);
+}
+
+bool ON_Mesh::CombineIdenticalVertices(
+                                bool bIgnoreVertexNormals,
+                                bool bIgnoreTextureCoordinates,
+                                unsigned int thread_count
+                                )
 {
   // 11 June 2003 - added and tested.
+  // The vertices used to be sorted with ON_Sort() and CompareMeshPoint().
+  // They are now found with a hash table and numbered in the same order.
   bool rc = false;
   ON_Mesh& mesh = *this;
 
   int vertex_count = mesh.m_V.Count();
   if ( vertex_count > 0 )
   {
-    ON_SimpleArray<int> index_array(vertex_count);
     ON_SimpleArray<int> remap_array(vertex_count);
 
-    int remap_vertex_count = 0;
-    int merge_count = 0;
-    int i0, i1, k;
-
     struct tagMESHPOINTS mp;
     memset(&mp,0,sizeof(mp));
     mp.p0 = (const char*)&mp; // bogus pointer - never dereferenced
@@ -5225,213 +5685,193 @@ bool ON_Mesh::CombineIdenticalVertices(
       mp.K = 0;
     }
 
-    index_array.SetCount(vertex_count);
-    index_array.Zero();
-    int* index = index_array.Array();
-
     remap_array.SetCount(vertex_count);
     int* remap = remap_array.Array();
-    for ( k = 0; k < vertex_count; k++ )
-      remap[k] = -1;
-
-    ON_Sort( 
-          ON::sort_algorithm::quick_sort,
-          index,
-          mp.p0,                 // data buffer
-          vertex_count,
-          sizeof(*mp.p0),
-          CompareMeshPoint,
-          &mp
-         );
 
-    for ( i0 = 0; i0 < vertex_count; i0 = i1 )
+    const int remap_vertex_count = ON_Internal_MeshWeldIdenticalVertices(mp, vertex_count, thread_count, remap);
+
+    if ( remap_vertex_count > 0 && remap_vertex_count < vertex_count )
     {
-      for ( i1 = i0+1; i1 < vertex_count; i1++ )
+      ON_Internal_CombineMeshVertices(
+        mesh,
+        remap,
+        remap_vertex_count,
+        bIgnoreVertexNormals,
+        !bIgnoreTextureCoordinates,
+        thread_count
+        );
+      rc = true;
+    }
+  }
+  return rc;
+}
+
+bool ON_Mesh::CombineCoincidentVertices( 
+        const ON_3fVector tolerance,
+        double cos_normal_angle
+        )
+{
+  const int vertex_count = m_V.Count();
+  if ( vertex_count <= 0 )
+    return false;
+  if ( !(tolerance.x >= 0.0f && tolerance.y >= 0.0f && tolerance.z >= 0.0f) || !tolerance.IsValid() )
+  {
+    ON_ERROR("Invalid tolerance parameter.");
+    return false;
+  }
+
+  const ON_3fPoint* V = m_V.Array();
+  const ON_3fVector* N = (HasVertexNormals() && cos_normal_angle > -1.0) ? m_N.Array() : nullptr;
+  const ON_2fPoint* T = HasTextureCoordinates() ? m_T.Array() : nullptr;
+  const ON_Color* C = HasVertexColors() ? m_C.Array() : nullptr;
+  const ON_SurfaceCurvature* K = HasPrincipalCurvatures() ? m_K.Array() : nullptr;
+
+  ON_BoundingBox bbox;
+  if ( !ON_GetPointListBoundingBox(3, false, vertex_count, 3, &V[0].x, bbox, false, nullptr) )
+    return false;
+
+  // Grid cells are at least as large as the tolerance, so coincident
+  // vertices are in the same or adjacent cells. Axes with zero
+  // tolerance use the largest tolerance, or the average vertex spacing
+  // when every tolerance is zero.
+  double h = tolerance.x;
+  if ( tolerance.y > h )
+    h = tolerance.y;
+  if ( tolerance.z > h )
+    h = tolerance.z;
+  if ( !(h > 0.0) )
+    h = bbox.Diagonal().Length()/(1.0 + cbrt((double)vertex_count));
+  if ( !(h > 0.0) )
+    h = 1.0;
+  double cell_size[3];
+  for ( int j = 0; j < 3; j++ )
+  {
+    cell_size[j] = (tolerance[j] > 0.0f) ? tolerance[j] : h;
+    const double extent = bbox.m_max[j] - bbox.m_min[j];
+    if ( extent > cell_size[j]*1.0e9 )
+      cell_size[j] = extent*1.0e-9; // keep cell indices small
+  }
+
+  // Hash each vertex's cell.
+  const unsigned int thread_count = ON_Internal_MeshThreadCount(0, (unsigned int)vertex_count);
+  const unsigned int block_size = ON_MESH_PARALLEL_BLOCK_SIZE;
+  const unsigned int block_count = ((unsigned int)vertex_count + block_size - 1) / block_size;
+  ON_SimpleArray<int> cell_array(3*vertex_count);
+  cell_array.SetCount(3*vertex_count);
+  int* cell = cell_array.Array();
+  ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
+  {
+    const unsigned int i1 = (block + 1)*block_size < (unsigned int)vertex_count ? (block + 1)*block_size : (unsigned int)vertex_count;
+    for ( unsigned int i = block*block_size; i < i1; i++ )
+    {
+      for ( int j = 0; j < 3; j++ )
+        cell[3*i+j] = (int)floor((V[i][j] - bbox.m_min[j])/cell_size[j]);
+    }
+  });
+
+  auto cell_hash = [](int x, int y, int z)
+  {
+    ON__UINT64 h = ((ON__UINT64)(ON__UINT32)x)*0x9E3779B97F4A7C15ULL;
+    h ^= ((ON__UINT64)(ON__UINT32)y)*0xC2B2AE3D27D4EB4FULL;
+    h ^= ((ON__UINT64)(ON__UINT32)z)*0x165667B19E3779F9ULL;
+    return (ON__UINT32)(h ^ (h >> 29));
+  };
+
+  // Each vertex is combined with the lowest index earlier
+  // representative vertex that is within tolerance, has the same
+  // texture coordinate, color and curvature, and a normal within the
+  // angle tolerance. table[] holds the first representative in each
+  // occupied cell and next_rep[] links the others.
+  //
+  // This search is serial. Whether a vertex is a representative
+  // depends on the representatives chosen before it in all 27
+  // neighbouring cells, so cell partitions cannot be searched
+  // independently without changing which vertices are combined.
+  unsigned int capacity = 16;
+  while ( capacity < 2*(unsigned int)vertex_count )
+    capacity *= 2;
+  const unsigned int mask = capacity - 1;
+  ON_SimpleArray<int> table(capacity);
+  table.SetCount(capacity);
+  memset(table.Array(), 0xFF, capacity*sizeof(int));
+  ON_SimpleArray<int> next_rep(vertex_count);
+  next_rep.SetCount(vertex_count);
+  ON_SimpleArray<int> remap_array(vertex_count);
+  remap_array.SetCount(vertex_count);
+  int* remap = remap_array.Array();
+
+  int remap_vertex_count = 0;
+  for ( int i = 0; i < vertex_count; i++ )
+  {
+    const int* c = cell + 3*i;
+    int rep = -1;
+    for ( int n = 0; n < 27; n++ )
+    {
+      const int x = c[0] + (n % 3) - 1;
+      const int y = c[1] + ((n / 3) % 3) - 1;
+      const int z = c[2] + (n / 9) - 1;
+      for ( unsigned int slot = cell_hash(x, y, z) & mask; /*empty*/; slot = (slot + 1) & mask )
       {
-        if ( CompareMeshPoint( mp.p0+index[i0], mp.p0+index[i1], &mp ) )
+        int r = table[slot];
+        if ( r < 0 )
           break;
-        else
-          merge_count++;
-      }
-      for ( /*empty*/; i0 < i1; i0++ )
-      {
-        remap[index[i0]] = remap_vertex_count;
+        const int* rcell = cell + 3*r;
+        if ( rcell[0] != x || rcell[1] != y || rcell[2] != z )
+          continue;
+        for ( /*empty*/; r >= 0; r = next_rep[r] )
+        {
+          if ( rep >= 0 && r > rep )
+            continue;
+          if (    fabs(V[r].x - V[i].x) > tolerance.x
+               || fabs(V[r].y - V[i].y) > tolerance.y
+               || fabs(V[r].z - V[i].z) > tolerance.z )
+            continue;
+          if ( nullptr != N && ((double)N[r].x*N[i].x + (double)N[r].y*N[i].y + (double)N[r].z*N[i].z) < cos_normal_angle )
+            continue;
+          if ( nullptr != T && (T[r].x != T[i].x || T[r].y != T[i].y) )
+            continue;
+          if ( nullptr != C && (unsigned int)C[r] != (unsigned int)C[i] )
+            continue;
+          if ( nullptr != K && (K[r].k1 != K[i].k1 || K[r].k2 != K[i].k2) )
+            continue;
+          rep = r;
+        }
+        break;
       }
-      remap_vertex_count++;
     }
 
-    if ( bIgnoreVertexNormals )
+    if ( rep >= 0 )
     {
-      mp.N = mesh.HasVertexNormals() ? mesh.m_N.Array() : 0;
+      remap[i] = remap[rep];
+      continue;
     }
 
-    if ( bIgnoreTextureCoordinates )
+    // vertex i is a new representative
+    remap[i] = remap_vertex_count++;
+    for ( unsigned int slot = cell_hash(c[0], c[1], c[2]) & mask; /*empty*/; slot = (slot + 1) & mask )
     {
-      mp.T = mesh.HasTextureCoordinates()  ? mesh.m_T.Array() : 0;
-      mp.C = mesh.HasVertexColors()        ? mesh.m_C.Array() : 0;
-      mp.K = mesh.HasPrincipalCurvatures() ? mesh.m_K.Array() : 0;
-    }
-
-    if ( remap_vertex_count > 0 && remap_vertex_count < vertex_count )
-    {
-      ON_SimpleArray<ON_3fPoint> p_array(remap_vertex_count);
-      p_array.SetCount(remap_vertex_count);
-      ON_3fPoint* p = p_array.Array();
-      ON_3fVector* v = (ON_3fVector*)p;
-
-      for ( k = 0; k < vertex_count; k++ )
-      {
-        p[remap[k]] = mp.V[k];
-      }
-      for ( k = 0; k < remap_vertex_count; k++ )
-        mp.V[k] = p[k];
-      mesh.m_V.SetCount(remap_vertex_count);
-
-      if (vertex_count == m_dV.Count())
-      {
-        ON_SimpleArray<ON_3dPoint> dp_array;
-        ON_3dPoint* dp = dp_array.Reserve(remap_vertex_count);
-        ON_3dPoint* D = m_dV.Array();
-        for (k = 0; k < vertex_count; k++)
-        {
-          dp[remap[k]] = D[k];
-        }
-        for (k = 0; k < remap_vertex_count; k++)
-          D[k] = dp[k];
-        m_dV.SetCount(remap_vertex_count);
-      }
-      else
-        m_dV.Destroy();
-
-      if ( 0 != mp.N )
-      {
-        if ( bIgnoreVertexNormals )
-        {
-          // average vertex normals of combined vertices
-          p_array.Zero();
-          for ( k = 0; k < vertex_count; k++ )
-          {
-            v[remap[k]] += mp.N[k];
-          }
-          for ( k = 0; k < remap_vertex_count; k++ )
-          {
-            v[k].Unitize();
-          }
-        }
-        else
-        {
-          for ( k = 0; k < vertex_count; k++ )
-          {
-            v[remap[k]] = mp.N[k];
-          }
-        }
-        for ( k = 0; k < remap_vertex_count; k++ )
-          mp.N[k] = v[k];
-        mesh.m_N.SetCount(remap_vertex_count);
-      }
-      else
-        mesh.m_N.SetCount(0);
-
-      if ( 0 != mp.T && !bIgnoreTextureCoordinates )
-      {
-        for ( k = 0; k < vertex_count; k++ )
-        {
-          p[remap[k]] = mp.T[k];
-        }
-        for ( k = 0; k < remap_vertex_count; k++ )
-          mp.T[k] = p[k];
-        mesh.m_T.SetCount(remap_vertex_count);
-      }
-      else
-        mesh.m_T.SetCount(0);
-
-      if ( 0 != mp.C && !bIgnoreTextureCoordinates )
-      {
-        ON_SimpleArray<ON_Color> c_array(remap_vertex_count);
-        c_array.SetCount(remap_vertex_count);
-        ON_Color* c = c_array.Array();
-        for ( k = 0; k < vertex_count; k++ )
-        {
-          c[remap[k]] = mp.C[k];
-        }
-        for ( k = 0; k < remap_vertex_count; k++ )
-          mp.C[k] = c[k];
-        mesh.m_C.SetCount(remap_vertex_count);
-      }
-      else
-        mesh.m_C.SetCount(0);
-
-      if ( 0 != mp.K && !bIgnoreTextureCoordinates )
-      {
-        ON_SimpleArray<ON_SurfaceCurvature> s_array(remap_vertex_count);
-        s_array.SetCount(remap_vertex_count);
-        ON_SurfaceCurvature* s = s_array.Array();
-        for ( k = 0; k < vertex_count; k++ )
-        {
-          s[remap[k]] = mp.K[k];
-        }
-        for ( k = 0; k < remap_vertex_count; k++ )
-          mp.K[k] = s[k];
-        mesh.m_K.SetCount(remap_vertex_count);
-      }
-      else
-        mesh.m_K.SetCount(0);
-
-      const int face_count = mesh.m_F.Count();
-      ON_MeshFace* f = mesh.m_F.Array();
-      int* fvi;
-      for ( k = 0; k < face_count; k++ )
-      {
-        fvi = f[k].vi;
-        fvi[0] = remap[fvi[0]];
-        fvi[1] = remap[fvi[1]];
-        fvi[2] = remap[fvi[2]];
-        fvi[3] = remap[fvi[3]];
-      }
-
-      if ( HasNgons() )
+      const int r = table[slot];
+      if ( r < 0 )
       {
-        for ( int ngon_index = 0; ngon_index < m_Ngon.Count(); ngon_index++ )
-        {
-          ON_MeshNgon* ngon = m_Ngon[ngon_index];
-          if ( 0 == ngon )
-            continue;
-          for ( unsigned int ngon_vertex_index = 0; ngon_vertex_index < ngon->m_Vcount; ngon_vertex_index++ )
-            ngon->m_vi[ngon_vertex_index] = remap[ngon->m_vi[ngon_vertex_index]];
-        }
+        table[slot] = i;
+        next_rep[i] = -1;
+        break;
       }
-
-      //if (0 != V4V5_NgonList())
-      //{
-      //  //This mesh has an ngon list.
-      //  //Modify the vertex indexes in the ngons as 
-      //  //we did the faces above
-      //  ON_V4V5_MeshNgonList* ngonlist = V4V5_ModifyNgonList();
-      //  int kk, kkct = ngonlist->V4V5_NgonCount();
-      //  for (kk = 0; kk < kkct; kk++)
-      //  {
-      //    ON_MeshNgon* ngon = ngonlist->V4V5_Ngon(kk);
-      //    if (0 == ngon)
-      //      continue;
-      //    for ( k = 0; k < ngon->m_N; k++ )
-      //      ngon->m_vi[k] = remap[ngon->m_vi[k]];
-      //  }
-      //}
-
-      mesh.DestroyPartition();
-      mesh.DestroyTopology();
-      mesh.m_S.Destroy();
-
-      if ( mesh.m_V.Capacity() > 4*mesh.m_V.Count() && mesh.m_V.Capacity() > 50 )
+      const int* rcell = cell + 3*r;
+      if ( rcell[0] == c[0] && rcell[1] == c[1] && rcell[2] == c[2] )
       {
-        // There is lots of unused memory in the dynamic arrays.
-        // Release what we can.
-        mesh.Compact();
+        next_rep[i] = r;
+        table[slot] = i;
+        break;
       }
-      rc = true;
     }
   }
-  return rc;
+
+  if ( remap_vertex_count <= 0 || remap_vertex_count >= vertex_count )
+    return false;
+
+  ON_Internal_CombineMeshVertices(*this, remap, remap_vertex_count, true, true, thread_count);
+  return true;
 }
 
 void ON_Mesh::Append( std::vector<std::shared_ptr<const ON_Mesh>> meshes )
@@ -8632,85 +9072,219 @@ bool ON_Mesh::CountQuads()
   return true;
 }
 
-bool ON_Mesh::ComputeVertexNormals()
+// Calculates FN[fi0,...,fi1-1]. The cross products of the diagonals are
+// calculated for a batch of faces into coordinate arrays so the loop has 
+// no calls and can be vectorized, then the batch is unitized.
+// The results are identical to ON_CrossProduct() followed by Unitize().
+template <class POINT>
+static void ON_Internal_MeshFaceNormalBlock(
+  const POINT* V,
+  const ON_MeshFace* F,
+  unsigned int fi0,
+  unsigned int fi1,
+  ON_3fVector* FN
+  )
 {
-  bool rc = false;
-  const int fcount = FaceCount();
-  const int vcount = VertexCount();
-  int vi, fi, j;
-  ON_3fVector n;
+  const unsigned int batch_size = 256;
+  double nx[batch_size], ny[batch_size], nz[batch_size];
+  for (unsigned int b0 = fi0; b0 < fi1; b0 += batch_size)
+  {
+    const unsigned int n = (fi1 - b0 < batch_size) ? (fi1 - b0) : batch_size;
+    const ON_MeshFace* f = F + b0;
+    for (unsigned int i = 0; i < n; i++)
+    {
+      // works for triangles, quads, and nonplanar quads
+      const int* vi = f[i].vi;
+      const double ax = V[vi[2]].x - V[vi[0]].x;
+      const double ay = V[vi[2]].y - V[vi[0]].y;
+      const double az = V[vi[2]].z - V[vi[0]].z;
+      const double bx = V[vi[3]].x - V[vi[1]].x;
+      const double by = V[vi[3]].y - V[vi[1]].y;
+      const double bz = V[vi[3]].z - V[vi[1]].z;
+      nx[i] = ay*bz - by*az;
+      ny[i] = az*bx - bz*ax;
+      nz[i] = ax*by - bx*ay;
+    }
+    for (unsigned int i = 0; i < n; i++)
+    {
+      ON_3dVector N(nx[i], ny[i], nz[i]);
+      N.Unitize();
+      FN[b0 + i] = ON_3fVector(N);
+    }
+  }
+}
 
-  if ( fcount > 0 && vcount > 0 ) {
-    rc = HasFaceNormals();
-    if ( !rc )
-      rc = ComputeFaceNormals();
-    if ( rc ) {
-      ON_Workspace ws;
-      //double* face_area = ws.GetDoubleMemory(fcount);
-      int* vfcount = ws.GetIntMemory( vcount );
-      memset ( vfcount, 0, vcount*sizeof(*vfcount) );
-
-      // count number of faces that use each vertex
-      for ( fi = 0; fi < fcount; fi++ ) {
-        ON_MeshFace& f = m_F[fi];
-        if ( f.IsValid(vcount) ) {
-          vfcount[f.vi[0]]++;
-          vfcount[f.vi[1]]++;
-          vfcount[f.vi[2]]++;
-          if ( f.IsQuad() )
-            vfcount[f.vi[3]]++;
-        }
-      }
+bool ON_Mesh::ComputeFaceNormals(
+  unsigned int thread_count
+  )
+{
+  const unsigned int face_count = m_F.UnsignedCount();
+  if (0 == face_count)
+  {
+    m_FN.Destroy();
+    return false;
+  }
+
+  m_FN.Reserve(face_count);
+  m_FN.SetCount(face_count);
+
+  const ON_MeshFace* F = m_F.Array();
+  ON_3fVector* FN = m_FN.Array();
+  const ON_3dPoint* dV 
+    = HasSynchronizedDoubleAndSinglePrecisionVertices() 
+    ? DoublePrecisionVertices().Array() 
+    : nullptr;
+  const ON_3fPoint* fV = m_V.Array();
 
-      // set vfi[vi][] = array of face indices that use vertex vi
-      int** vfi = (int**)ws.GetMemory( vcount*sizeof(vfi[0] ) );
+  const unsigned int block_size = ON_MESH_PARALLEL_BLOCK_SIZE;
+  ON_Internal_ParallelFor(
+    ON_Internal_MeshThreadCount(thread_count, face_count),
+    (face_count + block_size - 1) / block_size,
+    [&](unsigned int block)
+  {
+    const unsigned int fi0 = block*block_size;
+    const unsigned int fi1 = (block + 1)*block_size < face_count ? (block + 1)*block_size : face_count;
+    if (nullptr != dV)
+      ON_Internal_MeshFaceNormalBlock(dV, F, fi0, fi1, FN);
+    else
+      ON_Internal_MeshFaceNormalBlock(fV, F, fi0, fi1, FN);
+  });
+
+  return true;
+}
+
+// Area or corner angle weighted sum of the normals of the faces
+// in fi_list[] that use vertex vi.
+template <class POINT>
+static ON_3dVector ON_Internal_MeshWeightedVertexNormal(
+  const POINT* V,
+  const ON_MeshFace* F,
+  const ON_3fVector* FN,
+  unsigned int vi,
+  const unsigned int* fi_list,
+  unsigned int fi_count,
+  bool bAngleWeight
+  )
+{
+  double n[3] = { 0.0, 0.0, 0.0 };
+  for (unsigned int j = 0; j < fi_count; j++)
+  {
+    const unsigned int fi = fi_list[j];
+    const int* fvi = F[fi].vi;
+    double w = 0.0;
+    if (bAngleWeight)
+    {
+      const unsigned int corner_count = (fvi[2] == fvi[3]) ? 3 : 4;
+      for (unsigned int c = 0; c < corner_count; c++)
       {
-        int scratch_sz = 0;
-        for ( vi = 0; vi < vcount; vi++ ) {
-          scratch_sz += vfcount[vi];
-        }
-        int* scratch = ws.GetIntMemory(scratch_sz);
-        for ( vi = 0; vi < vcount; vi++ ) {
-          if ( vfcount[vi] ) {
-            vfi[vi] = scratch;
-            scratch += vfcount[vi];
-          }
-          vfcount[vi] = 0;
-        }
-      }
-      for ( fi = 0; fi < fcount; fi++ ) {
-        ON_MeshFace& f = m_F[fi];
-        if ( f.IsValid(vcount) ) {
-          vi = f.vi[0]; vfi[vi][vfcount[vi]++] = fi;
-          vi = f.vi[1]; vfi[vi][vfcount[vi]++] = fi;
-          vi = f.vi[2]; vfi[vi][vfcount[vi]++] = fi;
-          if ( f.IsQuad() ) {
-            vi = f.vi[3]; vfi[vi][vfcount[vi]++] = fi;
-          }
-        }
+        if (vi != (unsigned int)fvi[c])
+          continue;
+        const POINT& P = V[vi];
+        const POINT& A = V[fvi[(c + corner_count - 1) % corner_count]];
+        const POINT& B = V[fvi[(c + 1) % corner_count]];
+        const double ax = A.x - P.x, ay = A.y - P.y, az = A.z - P.z;
+        const double bx = B.x - P.x, by = B.y - P.y, bz = B.z - P.z;
+        const double cx = ay*bz - by*az, cy = az*bx - bz*ax, cz = ax*by - bx*ay;
+        w += atan2(sqrt(cx*cx + cy*cy + cz*cz), ax*bx + ay*by + az*bz);
       }
+    }
+    else
+    {
+      // Half the length of the cross product of the diagonals is the area
+      // of a triangle or planar quad.
+      const double ax = V[fvi[2]].x - V[fvi[0]].x, ay = V[fvi[2]].y - V[fvi[0]].y, az = V[fvi[2]].z - V[fvi[0]].z;
+      const double bx = V[fvi[3]].x - V[fvi[1]].x, by = V[fvi[3]].y - V[fvi[1]].y, bz = V[fvi[3]].z - V[fvi[1]].z;
+      const double cx = ay*bz - by*az, cy = az*bx - bz*ax, cz = ax*by - bx*ay;
+      w = 0.5*sqrt(cx*cx + cy*cy + cz*cz);
+    }
+    n[0] += w*FN[fi].x;
+    n[1] += w*FN[fi].y;
+    n[2] += w*FN[fi].z;
+  }
+  return ON_3dVector(n[0], n[1], n[2]);
+}
+
+bool ON_Mesh::ComputeVertexNormals()
+{
+  return ComputeVertexNormals(ON_Mesh::VertexNormalWeight::Face, 0);
+}
+
+bool ON_Mesh::ComputeVertexNormals(
+  ON_Mesh::VertexNormalWeight weight,
+  unsigned int thread_count
+  )
+{
+  const unsigned int face_count = m_F.UnsignedCount();
+  const unsigned int vertex_count = m_V.UnsignedCount();
+  if (0 == face_count || 0 == vertex_count)
+    return false;
+
+  if (!HasFaceNormals() && !ComputeFaceNormals(thread_count))
+    return false;
+
+  // vfi[vfoffset[vi]...vfoffset[vi+1]-1] = indices of the valid faces that use vertex vi
+  ON_MeshAdjacency vf_map;
+  const bool bMapDegenerateFaces = false;
+  const bool bNeighbors = false;
+  if (!vf_map.SetFromMesh(this, bMapDegenerateFaces, bNeighbors))
+    return false;
+  const unsigned int* vfoffset = vf_map.VertexFaceOffsets();
+  const unsigned int* vfi = vf_map.VertexFaceIndices();
+
+  m_N.Reserve(vertex_count);
+  m_N.SetCount(vertex_count);
 
-      // average face normals to get an estimate for a vertex normal
-      m_N.SetCapacity(vcount);
-      m_N.SetCount(0);
-      for ( vi = 0; vi < vcount; vi++ )
+  const ON_MeshFace* F = m_F.Array();
+  const ON_3fVector* FN = m_FN.Array();
+  ON_3fVector* N = m_N.Array();
+  const ON_3dPoint* dV
+    = (ON_Mesh::VertexNormalWeight::Face != weight && HasSynchronizedDoubleAndSinglePrecisionVertices())
+    ? DoublePrecisionVertices().Array()
+    : nullptr;
+  const ON_3fPoint* fV = m_V.Array();
+  const bool bAngleWeight = (ON_Mesh::VertexNormalWeight::Angle == weight);
+
+  // Each vertex normal is gathered from its face list,
+  // so the vertex blocks are independent.
+  const unsigned int block_size = ON_MESH_PARALLEL_BLOCK_SIZE;
+  ON_Internal_ParallelFor(
+    ON_Internal_MeshThreadCount(thread_count, vertex_count),
+    (vertex_count + block_size - 1) / block_size,
+    [&](unsigned int block)
+  {
+    const unsigned int vi1 = (block + 1)*block_size < vertex_count ? (block + 1)*block_size : vertex_count;
+    for (unsigned int vi = block*block_size; vi < vi1; vi++)
+    {
+      if (ON_Mesh::VertexNormalWeight::Face == weight)
       {
-        n = ON_3fVector::ZeroVector;
-        for ( j = vfcount[vi]-1; j >= 0; j-- ) 
-        {
-          n += m_FN[vfi[vi][j]];
-        }
-        if ( !n.Unitize() )
+        // average face normals to get an estimate for a vertex normal
+        ON_3fVector n = ON_3fVector::ZeroVector;
+        for (int j = (int)vfoffset[vi + 1] - 1; j >= (int)vfoffset[vi]; j--)
+          n += FN[vfi[j]];
+        if (!n.Unitize())
         {
           // this vertex is not used by a face or the face normals cancel out.
           // set a unit z normal and press on.
-          n.Set(0,0,1);
+          n.Set(0, 0, 1);
         }
-        m_N.Append(n);
+        N[vi] = n;
+      }
+      else
+      {
+        const unsigned int* fi_list = vfi + vfoffset[vi];
+        const unsigned int fi_count = vfoffset[vi + 1] - vfoffset[vi];
+        ON_3dVector n
+          = (nullptr != dV)
+          ? ON_Internal_MeshWeightedVertexNormal(dV, F, FN, vi, fi_list, fi_count, bAngleWeight)
+          : ON_Internal_MeshWeightedVertexNormal(fV, F, FN, vi, fi_list, fi_count, bAngleWeight);
+        if (!n.Unitize())
+          n = ON_3dVector::ZAxis;
+        N[vi] = ON_3fVector(n);
       }
     }
-  }
-  return rc;
+  });
+
+  return true;
 }
 
 bool ON_Mesh::NormalizeTextureCoordinates()
@@ -9579,15 +10153,24 @@ ON_MeshTopology::ON_MeshTopology()
 : m_mesh(0)
 , m_memchunk(0)
 , m_b32IsValid(0)
+, m_calculation(new ON_MeshTopologyCalculation())
 {
 }
 
 ON_MeshTopology::~ON_MeshTopology()
 {
   Destroy();
+  delete m_calculation;
+  m_calculation = nullptr;
 }
 
 void ON_MeshTopology::Destroy()
+{
+  WaitUntilReady(-1);
+  Internal_Destroy();
+}
+
+void ON_MeshTopology::Internal_Destroy()
 {
   m_topv_map.Destroy();
   m_topv.Destroy();
@@ -9608,6 +10191,9 @@ void ON_MeshTopology::Destroy()
 
 void ON_MeshTopology::EmergencyDestroy()
 {
+  // A background calculation writes to the arrays, so it must finish
+  // and its thread must be joined before they are abandoned.
+  WaitUntilReady(-1);
   m_mesh = 0;
   m_topv_map.EmergencyDestroy();
   m_topv.EmergencyDestroy();
@@ -10138,10 +10724,8 @@ bool ON_MeshTopology::IsValid() const
   int topvi, topei, topfi, vi, fi, j, jmax, k, tfvi[4];
   ON_3fPoint p;
 
-  WaitUntilReady(0);
-
   // simple checks
-  if ( 1 != m_b32IsValid )
+  if ( 1 != WaitUntilReady(0) )
     return false;
   if ( !m_mesh )
     return false;
@@ -10414,280 +10998,553 @@ void ON_MeshTopology::Dump( ON_TextLog& dump ) const
 }
 
 
-bool ON_MeshTopology::Create()
+/*
+Description:
+  Exclusive prefix sum of a[0], ..., a[count-1]. Blocks of
+  ON_MESH_PARALLEL_BLOCK_SIZE values are summed in parallel.
+Returns:
+  Sum of all the values.
+*/
+static unsigned int ON_Internal_MeshParallelPrefixSum(
+  unsigned int thread_count,
+  unsigned int count,
+  unsigned int* a
+  )
 {
-  // When -1 == m_b32IsValid, this ON_MeshTopology
-  // is the m_top field on an ON_Mesh and is being
-  // created in an ON_Mesh::Topology() call and a
-  // sleep lock is used to keep ON_Mesh::Topology()
-  // thread safe.
-  //
-  // When 0 == m_b32IsValid, this ON_MeshTopology
-  // is being created stand alone.
-  //
-  // When 1 == m_b32IsValid, this ON_MeshTopology
-  // is already created and valid.
-
-  if ( 1 == m_b32IsValid )
-    return true;
+  const unsigned int block_size = ON_MESH_PARALLEL_BLOCK_SIZE;
+  const unsigned int block_count = (count + block_size - 1) / block_size;
+  if (block_count <= 1)
+  {
+    unsigned int sum = 0;
+    for (unsigned int i = 0; i < count; i++)
+    {
+      const unsigned int x = a[i];
+      a[i] = sum;
+      sum += x;
+    }
+    return sum;
+  }
 
-  const int b32IsValid0 = m_b32IsValid;
+  ON_SimpleArray<unsigned int> block_sum(block_count);
+  block_sum.SetCount(block_count);
+  ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
+  {
+    const unsigned int i1 = (block + 1 < block_count) ? (block + 1)*block_size : count;
+    unsigned int sum = 0;
+    for (unsigned int i = block*block_size; i < i1; i++)
+      sum += a[i];
+    block_sum[block] = sum;
+  });
 
-  if ( 0 == b32IsValid0 )
+  unsigned int sum = 0;
+  for (unsigned int block = 0; block < block_count; block++)
   {
-    // no sleep lock is being used
-    m_b32IsValid = -1;
+    const unsigned int x = block_sum[block];
+    block_sum[block] = sum;
+    sum += x;
   }
-  int b32IsValid = b32IsValid0;
 
-  while ( 0 == b32IsValid || -1 == b32IsValid ) 
+  ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
   {
-    // while() is for flow control - this is a while() {... break;} statment.
-    Destroy();
-    b32IsValid = 0;
+    const unsigned int i1 = (block + 1 < block_count) ? (block + 1)*block_size : count;
+    unsigned int s = block_sum[block];
+    for (unsigned int i = block*block_size; i < i1; i++)
+    {
+      const unsigned int x = a[i];
+      a[i] = s;
+      s += x;
+    }
+  });
 
-    // build vertex topology information
-    const int fcount = m_mesh->FaceCount();
-    const int vcount = m_mesh->VertexCount();
-    if ( 0 == vcount )
-      break;
+  return sum;
+}
 
-    unsigned int* vindex = (unsigned int*)GetIntArray(vcount);
-    m_topv_map.SetCapacity( vcount );
-    m_topv_map.SetCount( vcount );
-    if (  0 == m_mesh->GetVertexLocationIds( 
-      0, // first id
-      (unsigned int*)m_topv_map.Array(), // vertex ids returned here
-      vindex
-      ) )
+/*
+Description:
+  Stable least significant digit radix sort of key[] and the
+  parallel value[] array. The keys must be < 2^key_bit_count.
+  key_buffer[] and value_buffer[] are work arrays with the same
+  length as key[] and value[].
+Returns:
+  True if the sorted values are in key_buffer[] and value_buffer[].
+  False if the sorted values are in key[] and value[].
+*/
+static bool ON_Internal_MeshRadixSort(
+  unsigned int thread_count,
+  unsigned int count,
+  unsigned int key_bit_count,
+  ON__UINT64* key,
+  unsigned int* value,
+  ON__UINT64* key_buffer,
+  unsigned int* value_buffer
+  )
+{
+  const unsigned int radix_bits = 11;
+  const unsigned int radix = 1U << radix_bits;
+  const unsigned int block_size = ON_MESH_PARALLEL_BLOCK_SIZE;
+  const unsigned int block_count = (count + block_size - 1) / block_size;
+  if (block_count < 1)
+    return false;
+
+  ON_SimpleArray<unsigned int> histogram(block_count*radix);
+  histogram.SetCount(block_count*radix);
+  unsigned int* h = histogram.Array();
+
+  bool bSwapped = false;
+  for (unsigned int shift = 0; shift < key_bit_count; shift += radix_bits)
+  {
+    // histogram[block*radix + digit] = number of keys in the block with that digit
+    ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
     {
-      Destroy();
-      break;
-    }
+      unsigned int* block_h = h + block*radix;
+      memset(block_h, 0, radix*sizeof(block_h[0]));
+      const unsigned int i1 = (block + 1 < block_count) ? (block + 1)*block_size : count;
+      for (unsigned int i = block*block_size; i < i1; i++)
+        block_h[(unsigned int)(key[i] >> shift) & (radix - 1)]++;
+    });
 
+    // Scatter offsets in (digit, block) order keep the sort stable.
+    // When every key has the same digit the pass is skipped.
+    bool bSkipPass = false;
+    unsigned int offset = 0;
+    for (unsigned int digit = 0; digit < radix && !bSkipPass; digit++)
     {
-      int topv_count = m_topv_map[vindex[vcount-1]]+1;
-      m_topv_map.SetCapacity( vcount );
-      m_topv_map.SetCount( vcount );
-      m_topv.SetCapacity( topv_count );
-      int vt0, vt1, topvi;
-      for (vt0 = 0; vt0 < vcount; vt0 = vt1)
+      const unsigned int offset0 = offset;
+      for (unsigned int block = 0; block < block_count; block++)
       {
-        topvi = m_topv.Count();
-#if defined(ON_DEBUG)
-        if ( topvi != m_topv_map[vindex[vt0]] )
-        {
-          // 20 April 2010 Dale Lear:
-          //  If you get this error, save the mesh and tell Dale Lear.
-          ON_ERROR("ON_MeshTopology::Create() - topvi != vertex id from GetVertexLocationIds()");
-        }
-#endif
-        ON_MeshTopologyVertex& topv = m_topv.AppendNew();
-        topv.m_vi = (const int*)(vindex+vt0);
-        for ( vt1=vt0+1; vt1<vcount && topvi == m_topv_map[vindex[vt1]]; vt1++ ) {
-          // empty
-        }
-        topv.m_v_count = vt1-vt0;
+        const unsigned int n = h[block*radix + digit];
+        h[block*radix + digit] = offset;
+        offset += n;
       }
+      bSkipPass = (offset - offset0 == count);
     }
+    if (bSkipPass)
+      continue;
 
-    // build edge topology information
-    const int topv_count = m_topv.Count();
-    if ( topv_count >= 2 ) 
+    ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
     {
-      bool rc = false;
-      int ei, ecnt, vi0, vi1, fi, efi, topfvi[4];
-      ON_MeshFace f;
-
-      if ( fcount > 0 && vcount > 0 ) 
+      unsigned int* block_h = h + block*radix;
+      const unsigned int i1 = (block + 1 < block_count) ? (block + 1)*block_size : count;
+      for (unsigned int i = block*block_size; i < i1; i++)
       {
-        // When working on this code be sure to test bug# 9271 and 9254 and file fsv_r4.3dm
-        ON_Workspace ws;
-        ON_MeshFaceSide* e = (ON_MeshFaceSide*)ws.GetMemory( 4*fcount*sizeof(*e) );
-        ecnt = m_mesh->GetMeshFaceSideList( (const unsigned int*)m_topv_map.Array(), e );
-        
-        if ( ecnt > 0 ) 
-        {
-          rc = true;
-          ON_MeshFaceSide::SortByVertexIndex( e, ecnt );
+        const unsigned int j = block_h[(unsigned int)(key[i] >> shift) & (radix - 1)]++;
+        key_buffer[j] = key[i];
+        value_buffer[j] = value[i];
+      }
+    });
 
-          // count number of topological edges and allocate storage
-          int etop_count = 0;
-          ei = 0;
-          while( ei < ecnt ) 
-          {
-            vi0 = e[ei].m_vi[0];
-            vi1 = e[ei].m_vi[1];
-            ei++;
-            while (ei < ecnt && e[ei].m_vi[0] == (unsigned int)vi0 && e[ei].m_vi[1] == (unsigned int)vi1 )
-              ei++;
-            etop_count++;
-          }
-          m_tope.SetCapacity(etop_count);
+    std::swap(key, key_buffer);
+    std::swap(value, value_buffer);
+    bSwapped = !bSwapped;
+  }
 
-          // fill in the m_tope[] array information
-          int* efindex = GetIntArray(ecnt);
-          for ( ei = 0; ei < ecnt; /*empty*/ )
-          {
-            ON_MeshTopologyEdge& tope = m_tope.AppendNew();
-            tope.m_topvi[0] = (int)(vi0 = e[ei].m_vi[0]);
-            tope.m_topvi[1] = (int)(vi1 = e[ei].m_vi[1]);
-            tope.m_topfi = efindex;
-            tope.m_topf_count = 0;
-            *efindex++ = (int)e[ei].m_fi;
-            tope.m_topf_count++;
-            ei++;
-            while( ei < ecnt && e[ei].m_vi[0] == (unsigned int)vi0 && e[ei].m_vi[1] == (unsigned int)vi1 ) 
-            {
-              *efindex++ = (int)e[ei].m_fi;
-              tope.m_topf_count++;
-              ei++;
-            }
-          }
-          efindex = 0; // memory deallocated by ~ON_MeshTopology()
-
-          // connect vertices to edges;
-          ecnt = m_tope.Count();
-          int* ve_count = (int*)onmalloc(topv_count*sizeof(*ve_count));
-          // set ve_count[topvi] = number of edges that begin or end at m_topv[topvi]
-          memset( ve_count, 0, topv_count*sizeof(*ve_count));
-          for ( ei = 0; ei < ecnt; ei++ ) {
-            const ON_MeshTopologyEdge& tope = m_tope[ei];
-            ve_count[tope.m_topvi[0]]++;
-            ve_count[tope.m_topvi[1]]++;
-          }
-          // allocate and distribute storage for the mopv.m_topei[] array
-          int* vei = GetIntArray(2*ecnt);
-          for ( vi0 = 0; vi0 < topv_count; vi0++ ) {
-            ON_MeshTopologyVertex& topv = m_topv[vi0];
-            if ( ve_count[vi0] > 0 ) {
-              topv.m_topei = vei;
-              vei += ve_count[vi0];
-            }
-          }
-          onfree(ve_count); ve_count = 0;
-          vei = 0; // memory deallocated by ~ON_MeshTopology()
-
-          // fill in the m_topv[].m_topei[] values
-          for ( ei = 0; ei < ecnt; ei++ ) {
-            ON_MeshTopologyEdge& tope = m_tope[ei];
-            ON_MeshTopologyVertex& topv0 = m_topv[tope.m_topvi[0]];
-            ON_MeshTopologyVertex& topv1 = m_topv[tope.m_topvi[1]];
-            vei = const_cast<int*>(topv0.m_topei);
-            vei[topv0.m_tope_count++] = ei;
-            vei = const_cast<int*>(topv1.m_topei);
-            vei[topv1.m_tope_count++] = ei;
-          }
+  return bSwapped;
+}
 
-          // build face topology information
-          m_topf.SetCapacity(fcount);
-          m_topf.SetCount(fcount);
-          memset( m_topf.Array(), 0, fcount*sizeof(ON_MeshTopologyFace) );
-          for ( fi = 0; fi < fcount; fi++ ) {
-            ON_MeshTopologyFace& f_local = m_topf[fi];
-            f_local.m_topei[0] = -1;
-            f_local.m_topei[1] = -1;
-            f_local.m_topei[2] = -1;
-            f_local.m_topei[3] = -1;
-          }
-          for ( ei = 0; ei < ecnt; ei++ ) {
-            ON_MeshTopologyEdge& tope = m_tope[ei];
-            for (efi = 0; efi < tope.m_topf_count; efi++ ) {
-              // Because ON_MeshFace.vi[2] == ON_MeshFace.vi[3] for triangles,
-              // we have topf.m_topei[j] BEGIN at ON_MeshFace.vi[(j+3)%4] and END at ON_MeshFace.vi[j]
-              fi = tope.m_topfi[efi];
-              f = m_mesh->m_F[fi];
-              topfvi[0] = m_topv_map[f.vi[0]];
-              topfvi[1] = m_topv_map[f.vi[1]];
-              topfvi[2] = m_topv_map[f.vi[2]];
-              topfvi[3] = m_topv_map[f.vi[3]];
-              ON_MeshTopologyFace& topf = m_topf[fi];
-              vi0 = tope.m_topvi[0];
-              vi1 = tope.m_topvi[1];
-              // unroll loop for speed
-              if      ( vi0 == topfvi[3] && vi1 == topfvi[0] ) {
-                topf.m_topei[0] = ei;
-                topf.m_reve[0] = 0;
-              }
-              else if ( vi0 == topfvi[0] && vi1 == topfvi[1] ) {
-                topf.m_topei[1] = ei;
-                topf.m_reve[1] = 0;
-              }
-              else if ( vi0 == topfvi[1] && vi1 == topfvi[2] ) {
-                topf.m_topei[2] = ei;
-                topf.m_reve[2] = 0;
-              }
-              else if ( vi0 == topfvi[2] && vi1 == topfvi[3] ) {
-                topf.m_topei[3] = ei;
-                topf.m_reve[3] = 0;
-              }
-              else if ( vi1 == topfvi[3] && vi0 == topfvi[0] ) {
-                topf.m_topei[0] = ei;
-                topf.m_reve[0] = 1;
-              }
-              else if ( vi1 == topfvi[0] && vi0 == topfvi[1] ) {
-                topf.m_topei[1] = ei;
-                topf.m_reve[1] = 1;
-              }
-              else if ( vi1 == topfvi[1] && vi0 == topfvi[2] ) {
-                topf.m_topei[2] = ei;
-                topf.m_reve[2] = 1;
-              }
-              else if ( vi1 == topfvi[2] && vi0 == topfvi[3] ) {
-                topf.m_topei[3] = ei;
-                topf.m_reve[3] = 1;
-              }
-            }
-          }
-          for ( fi = 0; fi < fcount; fi++ ) 
+/*
+Description:
+  Builds top.m_tope[], top.m_topv[].m_topei[] and top.m_topf[] after
+  top.m_topv[] and top.m_topv_map[] are set.
+Parameters:
+  top - [in/out]
+  thread_count - [in]
+    0 uses std::thread::hardware_concurrency().
+Returns:
+  Number of mesh face sides. When 0 is returned, no edges or
+  faces were added.
+Remarks:
+  Each face side is a packed 64-bit (topvi0,topvi1) key with
+  topvi0 < topvi1 and a (face index,side) value. The keys are
+  created in (face index,side) order and radix sorted, so the
+  results are identical to sorting the ON_Mesh::GetMeshFaceSideList()
+  list with ON_MeshFaceSide::SortByVertexIndex().
+*/
+static unsigned int ON_Internal_CreateMeshTopologyEdgesAndFaces(
+  ON_MeshTopology& top,
+  unsigned int thread_count
+  )
+{
+  const ON_Mesh* mesh = top.m_mesh;
+  const unsigned int Vcount = mesh->m_V.UnsignedCount();
+  const unsigned int fcount = mesh->m_F.UnsignedCount();
+  const unsigned int topv_count = top.m_topv.UnsignedCount();
+  if (Vcount < 2 || fcount < 1 || topv_count < 2 || top.m_topv_map.UnsignedCount() < Vcount)
+    return 0;
+  if (fcount > 0x3FFFFFFFU)
+  {
+    // (face index,side) values are packed into 32 bits
+    ON_ERROR("Too many faces.");
+    return 0;
+  }
+
+  const unsigned int* Vid = (const unsigned int*)top.m_topv_map.Array();
+  const ON_MeshFace* F = mesh->m_F.Array();
+
+  thread_count = ON_Internal_MeshThreadCount(thread_count, fcount);
+  const unsigned int block_size = ON_MESH_PARALLEL_BLOCK_SIZE;
+  const unsigned int face_block_count = (fcount + block_size - 1) / block_size;
+
+  // Get the topology vertex ids at the corners of a face.
+  // Returns false if the face references vertices that do not exist.
+  auto GetFaceTopvi = [Vcount, Vid, F](unsigned int fi, unsigned int topvi[4]) -> bool
+  {
+    const unsigned int* fvi = (const unsigned int*)F[fi].vi;
+    if (fvi[0] >= Vcount || fvi[1] >= Vcount || fvi[2] >= Vcount || fvi[3] >= Vcount)
+      return false;
+    topvi[0] = Vid[fvi[0]];
+    topvi[1] = Vid[fvi[1]];
+    topvi[2] = Vid[fvi[2]];
+    topvi[3] = Vid[fvi[3]];
+    return true;
+  };
+
+  // count the face sides in each block of faces
+  ON_SimpleArray<unsigned int> block_side_offset(face_block_count);
+  block_side_offset.SetCount(face_block_count);
+  ON_Internal_ParallelFor(thread_count, face_block_count, [&](unsigned int block)
+  {
+    const unsigned int fi1 = (block + 1 < face_block_count) ? (block + 1)*block_size : fcount;
+    unsigned int side_count = 0;
+    unsigned int topvi[4];
+    for (unsigned int fi = block*block_size; fi < fi1; fi++)
+    {
+      if (GetFaceTopvi(fi, topvi))
+      {
+        for (unsigned int s = 0; s < 4; s++)
+        {
+          if (topvi[s] != topvi[(s + 1) % 4])
+            side_count++;
+        }
+      }
+    }
+    block_side_offset[block] = side_count;
+  });
+  const unsigned int side_count = ON_Internal_MeshParallelPrefixSum(thread_count, face_block_count, block_side_offset.Array());
+  if (side_count < 1)
+    return 0;
+
+  unsigned int key_bit_count = 1;
+  while (key_bit_count < 32 && (topv_count - 1) >> key_bit_count)
+    key_bit_count++;
+  const unsigned int vi1_bit_count = key_bit_count;
+  key_bit_count *= 2;
+
+  ON_SimpleArray<ON__UINT64> keys(2*side_count);
+  ON_SimpleArray<unsigned int> values(2*side_count);
+  keys.SetCount(2*side_count);
+  values.SetCount(2*side_count);
+  ON__UINT64* key = keys.Array();
+  unsigned int* value = values.Array();
+
+  ON_Internal_ParallelFor(thread_count, face_block_count, [&](unsigned int block)
+  {
+    const unsigned int fi1 = (block + 1 < face_block_count) ? (block + 1)*block_size : fcount;
+    unsigned int i = block_side_offset[block];
+    unsigned int topvi[4];
+    for (unsigned int fi = block*block_size; fi < fi1; fi++)
+    {
+      if (!GetFaceTopvi(fi, topvi))
+        continue;
+      for (unsigned int s = 0; s < 4; s++)
+      {
+        const unsigned int vi0 = topvi[s];
+        const unsigned int vi1 = topvi[(s + 1) % 4];
+        if (vi0 == vi1)
+          continue;
+        key[i] = (vi0 < vi1)
+          ? ((((ON__UINT64)vi0) << vi1_bit_count) | vi1)
+          : ((((ON__UINT64)vi1) << vi1_bit_count) | vi0);
+        value[i] = (fi << 2) | s;
+        i++;
+      }
+    }
+  });
+
+  if (ON_Internal_MeshRadixSort(thread_count, side_count, key_bit_count, key, value, key + side_count, value + side_count))
+  {
+    key += side_count;
+    value += side_count;
+  }
+
+  // Number the topology edges. edge_index[i] = index of the
+  // edge for the sorted face side i.
+  const unsigned int side_block_count = (side_count + block_size - 1) / block_size;
+  ON_SimpleArray<unsigned int> block_edge_offset(side_block_count);
+  block_edge_offset.SetCount(side_block_count);
+  ON_Internal_ParallelFor(thread_count, side_block_count, [&](unsigned int block)
+  {
+    const unsigned int i1 = (block + 1 < side_block_count) ? (block + 1)*block_size : side_count;
+    unsigned int edge_count = 0;
+    for (unsigned int i = block*block_size; i < i1; i++)
+    {
+      if (0 == i || key[i] != key[i - 1])
+        edge_count++;
+    }
+    block_edge_offset[block] = edge_count;
+  });
+  const unsigned int tope_count = ON_Internal_MeshParallelPrefixSum(thread_count, side_block_count, block_edge_offset.Array());
+
+  top.m_tope.SetCapacity(tope_count);
+  top.m_tope.SetCount(tope_count);
+  ON_MeshTopologyEdge* tope = top.m_tope.Array();
+  int* efindex = top.GetIntArray(side_count); // memory deallocated by ~ON_MeshTopology()
+
+  // face_side_edge[fi*4 + s] = index of the edge on side s of face fi or -1
+  ON_SimpleArray<int> face_side_edge(4*fcount);
+  face_side_edge.SetCount(4*fcount);
+  int* fse = face_side_edge.Array();
+  ON_Internal_ParallelFor(thread_count, face_block_count, [&](unsigned int block)
+  {
+    const unsigned int fi1 = (block + 1 < face_block_count) ? (block + 1)*block_size : fcount;
+    const unsigned int fi0 = block*block_size;
+    memset(fse + 4*fi0, 0xFF, 4*(fi1 - fi0)*sizeof(fse[0]));
+  });
+
+  const ON__UINT64 vi1_mask = (((ON__UINT64)1) << vi1_bit_count) - 1;
+  ON_Internal_ParallelFor(thread_count, side_block_count, [&](unsigned int block)
+  {
+    const unsigned int i1 = (block + 1 < side_block_count) ? (block + 1)*block_size : side_count;
+    int ei = ((int)block_edge_offset[block]) - 1;
+    for (unsigned int i = block*block_size; i < i1; i++)
+    {
+      if (0 == i || key[i] != key[i - 1])
+      {
+        ei++;
+        ON_MeshTopologyEdge& e = tope[ei];
+        e.m_topvi[0] = (int)(key[i] >> vi1_bit_count);
+        e.m_topvi[1] = (int)(key[i] & vi1_mask);
+        e.m_topf_count = 0;
+        e.m_topfi = efindex + i;
+      }
+      efindex[i] = (int)(value[i] >> 2);
+      fse[value[i]] = ei;
+    }
+  });
+  ON_Internal_ParallelFor(thread_count, side_block_count, [&](unsigned int block)
+  {
+    const unsigned int ei1 = ((block + 1 < side_block_count) ? block_edge_offset[block + 1] : tope_count);
+    for (unsigned int ei = block_edge_offset[block]; ei < ei1; ei++)
+    {
+      const int* topfi1 = (ei + 1 < tope_count) ? tope[ei + 1].m_topfi : (efindex + side_count);
+      tope[ei].m_topf_count = (int)(topfi1 - tope[ei].m_topfi);
+    }
+  });
+
+  // connect vertices to edges
+  {
+    ON_MeshTopologyVertex* topv = top.m_topv.Array();
+    unsigned int* ve_count = (unsigned int*)onmalloc(topv_count*sizeof(*ve_count));
+    // set ve_count[topvi] = number of edges that begin or end at m_topv[topvi]
+    memset(ve_count, 0, topv_count*sizeof(*ve_count));
+    for (unsigned int ei = 0; ei < tope_count; ei++)
+    {
+      ve_count[tope[ei].m_topvi[0]]++;
+      ve_count[tope[ei].m_topvi[1]]++;
+    }
+    // allocate and distribute storage for the topv.m_topei[] array
+    int* vei = top.GetIntArray(2*tope_count); // memory deallocated by ~ON_MeshTopology()
+    for (unsigned int vi = 0; vi < topv_count; vi++)
+    {
+      if (ve_count[vi] > 0)
+      {
+        topv[vi].m_topei = vei;
+        vei += ve_count[vi];
+      }
+    }
+    onfree(ve_count);
+
+    // fill in the m_topv[].m_topei[] values in increasing edge order
+    for (unsigned int ei = 0; ei < tope_count; ei++)
+    {
+      ON_MeshTopologyVertex& topv0 = topv[tope[ei].m_topvi[0]];
+      ON_MeshTopologyVertex& topv1 = topv[tope[ei].m_topvi[1]];
+      const_cast<int*>(topv0.m_topei)[topv0.m_tope_count++] = (int)ei;
+      const_cast<int*>(topv1.m_topei)[topv1.m_tope_count++] = (int)ei;
+    }
+  }
+
+  // build face topology information
+  top.m_topf.SetCapacity(fcount);
+  top.m_topf.SetCount(fcount);
+  ON_MeshTopologyFace* topf = top.m_topf.Array();
+  ON_Internal_ParallelFor(thread_count, face_block_count, [&](unsigned int block)
+  {
+    const unsigned int fi1 = (block + 1 < face_block_count) ? (block + 1)*block_size : fcount;
+    unsigned int topfvi[4];
+    for (unsigned int fi = block*block_size; fi < fi1; fi++)
+    {
+      ON_MeshTopologyFace& f = topf[fi];
+      memset(&f, 0, sizeof(f));
+      f.m_topei[0] = -1;
+      f.m_topei[1] = -1;
+      f.m_topei[2] = -1;
+      f.m_topei[3] = -1;
+
+      // The face's edges are matched in increasing edge index order
+      // and a later edge replaces an earlier one.
+      int face_ei[4];
+      unsigned int face_ei_count = 0;
+      for (unsigned int s = 0; s < 4; s++)
+      {
+        const int ei = fse[4*fi + s];
+        if (ei < 0)
+          continue;
+        unsigned int k = face_ei_count++;
+        for (/*empty*/; k > 0 && face_ei[k - 1] > ei; k--)
+          face_ei[k] = face_ei[k - 1];
+        face_ei[k] = ei;
+      }
+
+      if (face_ei_count > 0 && GetFaceTopvi(fi, topfvi))
+      {
+        for (unsigned int k = 0; k < face_ei_count; k++)
+        {
+          // Because ON_MeshFace.vi[2] == ON_MeshFace.vi[3] for triangles,
+          // we have topf.m_topei[j] BEGIN at ON_MeshFace.vi[(j+3)%4] and END at ON_MeshFace.vi[j]
+          const int ei = face_ei[k];
+          const unsigned int vi0 = (unsigned int)tope[ei].m_topvi[0];
+          const unsigned int vi1 = (unsigned int)tope[ei].m_topvi[1];
+          unsigned int j;
+          char reve = 0;
+          if      (vi0 == topfvi[3] && vi1 == topfvi[0]) j = 0;
+          else if (vi0 == topfvi[0] && vi1 == topfvi[1]) j = 1;
+          else if (vi0 == topfvi[1] && vi1 == topfvi[2]) j = 2;
+          else if (vi0 == topfvi[2] && vi1 == topfvi[3]) j = 3;
+          else
           {
-            ON_MeshTopologyFace& f_local = m_topf[fi];
-            bool bIsGood = false;
-            if (    f_local.m_topei[0] >= 0 && f_local.m_topei[1] >= 0 && f_local.m_topei[2] >=0 
-                 && f_local.m_topei[0] != f_local.m_topei[1] 
-                 && f_local.m_topei[1] != f_local.m_topei[2] 
-                 && f_local.m_topei[2] != f_local.m_topei[0] 
-                 ) {
-              if ( m_mesh->m_F[fi].IsTriangle() ) {
-                bIsGood = true;
-                f_local.m_topei[3] = f_local.m_topei[2];
-              }
-              else if (   f_local.m_topei[3] >= 0 
-                       && f_local.m_topei[0] != f_local.m_topei[3] 
-                       && f_local.m_topei[1] != f_local.m_topei[3] 
-                       && f_local.m_topei[2] != f_local.m_topei[3] ) {
-                bIsGood = true;
-              }
-            }
-            if ( !bIsGood ) {
-              f_local.m_topei[0] = 0;
-              f_local.m_topei[1] = 0;
-              f_local.m_topei[2] = 0;
-              f_local.m_topei[3] = 0;
-              f_local.m_reve[0] = 0;
-              f_local.m_reve[1] = 0;
-              f_local.m_reve[2] = 0;
-              f_local.m_reve[3] = 0;
-            }
+            reve = 1;
+            if      (vi1 == topfvi[3] && vi0 == topfvi[0]) j = 0;
+            else if (vi1 == topfvi[0] && vi0 == topfvi[1]) j = 1;
+            else if (vi1 == topfvi[1] && vi0 == topfvi[2]) j = 2;
+            else if (vi1 == topfvi[2] && vi0 == topfvi[3]) j = 3;
+            else continue;
           }
+          f.m_topei[j] = ei;
+          f.m_reve[j] = reve;
+        }
+      }
+
+      bool bIsGood = false;
+      if (    f.m_topei[0] >= 0 && f.m_topei[1] >= 0 && f.m_topei[2] >= 0
+           && f.m_topei[0] != f.m_topei[1]
+           && f.m_topei[1] != f.m_topei[2]
+           && f.m_topei[2] != f.m_topei[0]
+         )
+      {
+        if (F[fi].IsTriangle())
+        {
+          bIsGood = true;
+          f.m_topei[3] = f.m_topei[2];
+        }
+        else if (   f.m_topei[3] >= 0
+                 && f.m_topei[0] != f.m_topei[3]
+                 && f.m_topei[1] != f.m_topei[3]
+                 && f.m_topei[2] != f.m_topei[3])
+        {
+          bIsGood = true;
+        }
+      }
+      if (!bIsGood)
+        memset(&f, 0, sizeof(f));
+    }
+  });
+
+  return side_count;
+}
+
+bool ON_MeshTopology::Create(unsigned int thread_count)
+{
+  // When -1 == m_b32IsValid, this ON_MeshTopology
+  // is the m_top field on an ON_Mesh and is being
+  // created in an ON_Mesh::Topology() or
+  // ON_Mesh::CreateTopologyInBackground() call. The
+  // caller sets m_b32IsValid while m_mutex is locked.
+  //
+  // When 0 == m_b32IsValid, this ON_MeshTopology
+  // is being created stand alone.
+  //
+  // When 1 == m_b32IsValid, this ON_MeshTopology
+  // is already created and valid.
+
+  if ( 1 == m_b32IsValid )
+    return true;
+
+  const int b32IsValid0 = m_b32IsValid;
+
+  if ( 0 == b32IsValid0 )
+  {
+    // not called from ON_Mesh::Topology()
+    m_b32IsValid = -1;
+  }
+  int b32IsValid = b32IsValid0;
+
+  while ( 0 == b32IsValid || -1 == b32IsValid ) 
+  {
+    // while() is for flow control - this is a while() {... break;} statment.
+    Internal_Destroy();
+    b32IsValid = 0;
+
+    // build vertex topology information
+    const int vcount = m_mesh->VertexCount();
+    if ( 0 == vcount )
+      break;
+
+    unsigned int* vindex = (unsigned int*)GetIntArray(vcount);
+    m_topv_map.SetCapacity( vcount );
+    m_topv_map.SetCount( vcount );
+    if (  0 == m_mesh->GetVertexLocationIds( 
+      0, // first id
+      (unsigned int*)m_topv_map.Array(), // vertex ids returned here
+      vindex
+      ) )
+    {
+      Internal_Destroy();
+      break;
+    }
 
+    {
+      int topv_count = m_topv_map[vindex[vcount-1]]+1;
+      m_topv_map.SetCapacity( vcount );
+      m_topv_map.SetCount( vcount );
+      m_topv.SetCapacity( topv_count );
+      int vt0, vt1, topvi;
+      for (vt0 = 0; vt0 < vcount; vt0 = vt1)
+      {
+        topvi = m_topv.Count();
+#if defined(ON_DEBUG)
+        if ( topvi != m_topv_map[vindex[vt0]] )
+        {
+          // 20 April 2010 Dale Lear:
+          //  If you get this error, save the mesh and tell Dale Lear.
+          ON_ERROR("ON_MeshTopology::Create() - topvi != vertex id from GetVertexLocationIds()");
+        }
+#endif
+        ON_MeshTopologyVertex& topv = m_topv.AppendNew();
+        topv.m_vi = (const int*)(vindex+vt0);
+        for ( vt1=vt0+1; vt1<vcount && topvi == m_topv_map[vindex[vt1]]; vt1++ ) {
+          // empty
         }
+        topv.m_v_count = vt1-vt0;
       }
     }
 
+    // build edge and face topology information
+    // When working on this code be sure to test bug# 9271 and 9254 and file fsv_r4.3dm
+    ON_Internal_CreateMeshTopologyEdgesAndFaces(*this, thread_count);
+
     b32IsValid = 1;
     break;
   }
 
   if ( -1 != b32IsValid0 )
   {
-    // no sleep lock is in use
+    // not called from ON_Mesh::Topology()
     m_b32IsValid = b32IsValid;
   }
 
   if ( 1 != b32IsValid )
   {
-    Destroy();
+    Internal_Destroy();
   }
 
   return (1 == b32IsValid);
@@ -13752,288 +14609,1588 @@ void ON_Mesh::DestroyTree( bool bDeleteTree )
 {
 }
 
+////////////////////////////////////////////////////////////////
+//
+// ON_MeshBVH
+//
+
+bool ON_MeshFacePoint::IsSet() const
+{
+  return (ON_UNSET_UINT_INDEX != m_face_index);
+}
 
+// Maximum number of triangles in a leaf and the number of SAH bins.
+#define ON_MESH_BVH_LEAF_SIZE 4U
+#define ON_MESH_BVH_BIN_COUNT 16U
+// Below this depth the builder switches to median splits so the 
+// traversal stacks can have a fixed size.
+#define ON_MESH_BVH_SAH_DEPTH 96U
+#define ON_MESH_BVH_STACK_CAPACITY 256U
 
+// Face corners used by the triangles of a face.
+// 0: (0,1,2) and 1: (0,2,3) split a quad along the 0-2 diagonal,
+// 2: (0,1,3) and 3: (1,2,3) split a quad along the 1-3 diagonal.
+static const unsigned char ON_Internal_MeshBVHCorners[4][3] = { {0,1,2}, {0,2,3}, {0,1,3}, {1,2,3} };
 
-static int compare2fPoint(const void* a, const void* b)
+static double ON_Internal_MeshBVHHalfArea(const double bbox[6])
 {
-  const float* af = (const float*)a;
-  const float* bf = (const float*)b;
-  if (af[0] < bf[0])
-    return -1;
-  if (af[0] > bf[0])
-    return 1;
-  if (af[1] < bf[1])
-    return -1;
-  if (af[1] > bf[1])
-    return 1;
-  return 0;
+  const double dx = bbox[3] - bbox[0];
+  const double dy = bbox[4] - bbox[1];
+  const double dz = bbox[5] - bbox[2];
+  return (dx >= 0.0) ? (dx*dy + dy*dz + dz*dx) : 0.0;
 }
 
-static int compare2dPoint(const void* a, const void* b)
+static void ON_Internal_MeshBVHEmptyBox(double bbox[6])
 {
-  const double* af = (const double*)a;
-  const double* bf = (const double*)b;
-  if (af[0] < bf[0])
-    return -1;
-  if (af[0] > bf[0])
-    return 1;
-  if (af[1] < bf[1])
-    return -1;
-  if (af[1] > bf[1])
-    return 1;
-  return 0;
+  bbox[0] = bbox[1] = bbox[2] = ON_DBL_MAX;
+  bbox[3] = bbox[4] = bbox[5] = -ON_DBL_MAX;
 }
 
-//static int compare3fPoint(const void* a, const void* b)
-//{
-//  const float* af = (const float*)a;
-//  const float* bf = (const float*)b;
-//  if (af[0] < bf[0])
-//    return -1;
-//  if (af[0] > bf[0])
-//    return 1;
-//  if (af[1] < bf[1])
-//    return -1;
-//  if (af[1] > bf[1])
-//    return 1;
-//  if (af[2] < bf[2])
-//    return -1;
-//  if (af[2] > bf[2])
-//    return 1;
-//  return 0;
-//}
-//
-//static int compare3dPoint(const void* a, const void* b)
-//{
-//  const double* af = (const double*)a;
-//  const double* bf = (const double*)b;
-//  if (af[0] < bf[0])
-//    return -1;
-//  if (af[0] > bf[0])
-//    return 1;
-//  if (af[1] < bf[1])
-//    return -1;
-//  if (af[1] > bf[1])
-//    return 1;
-//  if (af[2] < bf[2])
-//    return -1;
-//  if (af[2] > bf[2])
-//    return 1;
-//  return 0;
-//}
+static void ON_Internal_MeshBVHUnionBox(double bbox[6], const double b[6])
+{
+  bbox[0] = (b[0] < bbox[0]) ? b[0] : bbox[0];
+  bbox[1] = (b[1] < bbox[1]) ? b[1] : bbox[1];
+  bbox[2] = (b[2] < bbox[2]) ? b[2] : bbox[2];
+  bbox[3] = (b[3] > bbox[3]) ? b[3] : bbox[3];
+  bbox[4] = (b[4] > bbox[4]) ? b[4] : bbox[4];
+  bbox[5] = (b[5] > bbox[5]) ? b[5] : bbox[5];
+}
 
+static void ON_Internal_MeshBVHUnionPoint(double bbox[6], const double p[3])
+{
+  bbox[0] = (p[0] < bbox[0]) ? p[0] : bbox[0];
+  bbox[1] = (p[1] < bbox[1]) ? p[1] : bbox[1];
+  bbox[2] = (p[2] < bbox[2]) ? p[2] : bbox[2];
+  bbox[3] = (p[0] > bbox[3]) ? p[0] : bbox[3];
+  bbox[4] = (p[1] > bbox[4]) ? p[1] : bbox[4];
+  bbox[5] = (p[2] > bbox[5]) ? p[2] : bbox[5];
+}
 
-static int comparedUnsignedPair(const void* a, const void* b)
+static bool ON_Internal_MeshBVHBoxesOverlap(const double a[6], const double b[6])
 {
-  const unsigned int* au = ((const unsigned int*)a);
-  const unsigned int* bu = ((const unsigned int*)b);
-  if (au[0] < bu[0])
-    return -1;
-  if (au[0] > bu[0])
-    return 1;
-  if (au[1] < bu[1])
-    return -1;
-  if (au[1] > bu[1])
-    return 1;
-  return 0;
+  return (a[0] <= b[3] && b[0] <= a[3] && a[1] <= b[4] && b[1] <= a[4] && a[2] <= b[5] && b[2] <= a[5]);
 }
 
-static unsigned int* ON_GetPointLocationIdsHelper(
-  size_t point_dim,
-  size_t point_count,
-  size_t point_stride,
-  const float* fPoints, 
-  const double* dPoints, 
-  unsigned int first_vid, 
-  unsigned int* Vid, 
-  unsigned int* Vindex
+bool ON_MeshBVH::Create(
+  const ON_Mesh* mesh
   )
 {
-  // Used here and in opennurbs_plus_xmeshfast.cpp
-
-  if (point_count <= 0 || point_dim < 2 || point_dim > 3 || point_stride < point_dim)
-    return nullptr;
+  Destroy();
+  if (nullptr == mesh)
+    return false;
 
-  if (nullptr == fPoints && nullptr == dPoints)
-    return nullptr;
+  const unsigned int vertex_count = mesh->m_V.UnsignedCount();
+  const unsigned int face_count = mesh->m_F.UnsignedCount();
+  if (vertex_count < 3 || face_count < 1)
+    return false;
 
-  const unsigned int Vcount = (unsigned int)point_count;
-  if (0 == Vid)
-    Vid = (unsigned int*)onmalloc(Vcount*sizeof(*Vid));
+  m_V.Reserve(vertex_count);
+  for (unsigned int vi = 0; vi < vertex_count; vi++)
+    m_V.Append(mesh->Vertex((int)vi));
+  const ON_3dPoint* V = m_V.Array();
 
-  if (1 == point_count)
+  m_tri.Reserve(8 * (size_t)face_count);
+  for (unsigned int fi = 0; fi < face_count; fi++)
   {
-    Vid[0] = first_vid;
-    if (nullptr != Vindex)
-      Vindex[0] = 0;
-    return Vid;
+    const ON_MeshFace& f = mesh->m_F[fi];
+    if (!f.IsValid(vertex_count))
+      continue;
+    unsigned int split_count = 1;
+    unsigned int split = 0;
+    if (f.IsQuad())
+    {
+      split_count = 2;
+      if (V[f.vi[0]].DistanceToSquared(V[f.vi[2]]) > V[f.vi[1]].DistanceToSquared(V[f.vi[3]]))
+        split = 2;
+    }
+    for (unsigned int i = 0; i < split_count; i++, split++)
+    {
+      const unsigned char* c = ON_Internal_MeshBVHCorners[split];
+      m_tri.Append((unsigned int)f.vi[c[0]]);
+      m_tri.Append((unsigned int)f.vi[c[1]]);
+      m_tri.Append((unsigned int)f.vi[c[2]]);
+      m_tri.Append(4 * fi + split);
+    }
   }
 
-  if (2 == point_dim)
-  {
-    // Dictionary sort the 2d points (sort on x, then y).
-    if (nullptr != dPoints)
-      ON_Sort(ON::sort_algorithm::quick_sort, Vid, dPoints, Vcount, point_stride*sizeof(dPoints[0]), compare2dPoint);
-    else
-      ON_Sort(ON::sort_algorithm::quick_sort, Vid, fPoints, Vcount, point_stride*sizeof(fPoints[0]), compare2fPoint);
-  }
-  else
+  const unsigned int tri_count = m_tri.UnsignedCount() / 4;
+  if (0 == tri_count)
   {
-    // Dictionary sort the 3d points (sort on x, then y, then z).
-    if (nullptr != dPoints)
-      ON_Sort(ON::sort_algorithm::quick_sort, Vid, dPoints, Vcount, point_stride*sizeof(dPoints[0]), (ON_COMPAR_LPVOID_LPVOID)compare3dPoint);
-    else
-      ON_Sort(ON::sort_algorithm::quick_sort, Vid, fPoints, Vcount, point_stride*sizeof(fPoints[0]), (ON_COMPAR_LPVOID_LPVOID)compare3fPoint);
+    Destroy();
+    return false;
   }
-    
-  // Assign a unique temporary id to each group of coincident points.
-  // The id is temporary because the order of the above sort will change
-  // if the point set is rotated.
-  struct tagUnsignedPair
-  {
-    unsigned int m_temporary_id;
-    unsigned int m_vertex_index;
-  } *up = new tagUnsignedPair[Vcount];
 
-  unsigned int temporary_id = Vid[0];
-  unsigned int i0 = 0;
-  if (nullptr != dPoints)
+  // Triangle bounding boxes and centroids
+  ON_SimpleArray<double> tri_bbox_buffer(6 * (size_t)tri_count);
+  ON_SimpleArray<double> tri_center_buffer(3 * (size_t)tri_count);
+  ON_SimpleArray<unsigned int> order_buffer(tri_count);
+  tri_bbox_buffer.SetCount(6 * tri_count);
+  tri_center_buffer.SetCount(3 * tri_count);
+  order_buffer.SetCount(tri_count);
+  double* tri_bbox = tri_bbox_buffer.Array();
+  double* tri_center = tri_center_buffer.Array();
+  unsigned int* order = order_buffer.Array();
+  double root_bbox[6];
+  double root_center_bbox[6];
+  ON_Internal_MeshBVHEmptyBox(root_bbox);
+  ON_Internal_MeshBVHEmptyBox(root_center_bbox);
+  for (unsigned int t = 0; t < tri_count; t++)
+  {
+    const unsigned int* tri = m_tri.Array() + 4 * t;
+    double* b = tri_bbox + 6 * t;
+    ON_Internal_MeshBVHEmptyBox(b);
+    for (unsigned int i = 0; i < 3; i++)
+      ON_Internal_MeshBVHUnionPoint(b, &V[tri[i]].x);
+    double* c = tri_center + 3 * t;
+    c[0] = 0.5*(b[0] + b[3]);
+    c[1] = 0.5*(b[1] + b[4]);
+    c[2] = 0.5*(b[2] + b[5]);
+    ON_Internal_MeshBVHUnionBox(root_bbox, b);
+    ON_Internal_MeshBVHUnionPoint(root_center_bbox, c);
+    order[t] = t;
+  }
+
+  // Top down binned SAH build. Children of an interior node are 
+  // stored next to each other.
+  struct BuildTask
+  {
+    unsigned int node;
+    unsigned int first;
+    unsigned int count;
+    unsigned int depth;
+    double bbox[6];
+    double center_bbox[6];
+  };
+  auto set_task_boxes = [=](BuildTask& task, bool bSetBox)
   {
-    const double* dP0 = dPoints + point_stride*Vid[0];
-    if (3 == point_dim)
+    if (bSetBox)
+      ON_Internal_MeshBVHEmptyBox(task.bbox);
+    ON_Internal_MeshBVHEmptyBox(task.center_bbox);
+    for (unsigned int i = task.first; i < task.first + task.count; i++)
     {
-      for (unsigned int i = 1; i < Vcount; i++)
+      if (bSetBox)
+        ON_Internal_MeshBVHUnionBox(task.bbox, tri_bbox + 6 * order[i]);
+      ON_Internal_MeshBVHUnionPoint(task.center_bbox, tri_center + 3 * order[i]);
+    }
+  };
+
+  ON_SimpleArray<BuildTask> tasks(64);
+  m_node_bbox.Reserve(6 * (size_t)tri_count);
+  m_node_index.Reserve(2 * (size_t)tri_count);
+  m_node_bbox.SetCount(6);
+  m_node_index.SetCount(2);
+  BuildTask& root = tasks.AppendNew();
+  root.node = 0;
+  root.first = 0;
+  root.count = tri_count;
+  root.depth = 0;
+  memcpy(root.bbox, root_bbox, sizeof(root_bbox));
+  memcpy(root.center_bbox, root_center_bbox, sizeof(root_center_bbox));
+
+  unsigned int bin_count[3][ON_MESH_BVH_BIN_COUNT];
+  double bin_bbox[3][ON_MESH_BVH_BIN_COUNT][6];
+
+  while (tasks.Count() > 0)
+  {
+    const BuildTask task = *tasks.Last();
+    tasks.Remove();
+    memcpy(m_node_bbox.Array() + 6 * task.node, task.bbox, sizeof(task.bbox));
+
+    unsigned int left_count = 0;
+    double left_bbox[6];
+    double right_bbox[6];
+    bool bChildBoxes = false;
+
+    if (task.count > 2 && task.depth < ON_MESH_BVH_SAH_DEPTH)
+    {
+      // Bin the centroids on all three axes in one pass.
+      double scale[3];
+      for (int k = 0; k < 3; k++)
       {
-        const double* dP1 = dPoints + point_stride*Vid[i];
-        if (dP0[0] == dP1[0] && dP0[1] == dP1[1] && dP0[2] == dP1[2])
+        const double extent = task.center_bbox[k + 3] - task.center_bbox[k];
+        scale[k] = (extent > 0.0) ? (ON_MESH_BVH_BIN_COUNT / extent) : 0.0;
+        for (unsigned int b = 0; b < ON_MESH_BVH_BIN_COUNT; b++)
         {
-          if (Vid[i] < temporary_id)
-            temporary_id = Vid[i];
+          bin_count[k][b] = 0;
+          ON_Internal_MeshBVHEmptyBox(bin_bbox[k][b]);
         }
-        else
+      }
+      for (unsigned int i = task.first; i < task.first + task.count; i++)
+      {
+        const double* c = tri_center + 3 * order[i];
+        const double* tb = tri_bbox + 6 * order[i];
+        for (int k = 0; k < 3; k++)
         {
-          while (i0 < i)
-          {
-            up[i0].m_temporary_id = temporary_id;
-            up[i0].m_vertex_index = Vid[i0];
-            i0++;
-          }
-          temporary_id = Vid[i0];
-          dP0 = dP1;
+          unsigned int b = (unsigned int)((c[k] - task.center_bbox[k])*scale[k]);
+          if (b >= ON_MESH_BVH_BIN_COUNT)
+            b = ON_MESH_BVH_BIN_COUNT - 1;
+          bin_count[k][b]++;
+          ON_Internal_MeshBVHUnionBox(bin_bbox[k][b], tb);
         }
       }
-    }
-    else
-    {
-      for (unsigned int i = 1; i < Vcount; i++)
+
+      int best_axis = -1;
+      unsigned int best_bin = 0;
+      double best_cost = ON_DBL_MAX;
+      for (int k = 0; k < 3; k++)
       {
-        const double* dP1 = dPoints + point_stride*Vid[i];
-        if (dP0[0] == dP1[0] && dP0[1] == dP1[1])
+        if (!(scale[k] > 0.0))
+          continue;
+        // right_cost[b] = cost of the bins b+1,...,BIN_COUNT-1
+        double right_cost[ON_MESH_BVH_BIN_COUNT];
+        double bbox[6];
+        ON_Internal_MeshBVHEmptyBox(bbox);
+        unsigned int n = 0;
+        for (unsigned int b = ON_MESH_BVH_BIN_COUNT - 1; b > 0; b--)
         {
-          if (Vid[i] < temporary_id)
-            temporary_id = Vid[i];
+          ON_Internal_MeshBVHUnionBox(bbox, bin_bbox[k][b]);
+          n += bin_count[k][b];
+          right_cost[b - 1] = n * ON_Internal_MeshBVHHalfArea(bbox);
         }
-        else
+        ON_Internal_MeshBVHEmptyBox(bbox);
+        n = 0;
+        for (unsigned int b = 0; b + 1 < ON_MESH_BVH_BIN_COUNT; b++)
         {
-          while (i0 < i)
+          ON_Internal_MeshBVHUnionBox(bbox, bin_bbox[k][b]);
+          n += bin_count[k][b];
+          if (0 == n || task.count == n)
+            continue;
+          const double cost = n * ON_Internal_MeshBVHHalfArea(bbox) + right_cost[b];
+          if (cost < best_cost)
           {
-            up[i0].m_temporary_id = temporary_id;
-            up[i0].m_vertex_index = Vid[i0];
-            i0++;
+            best_cost = cost;
+            best_axis = k;
+            best_bin = b;
           }
-          temporary_id = Vid[i0];
-          dP0 = dP1;
         }
       }
+
+      // A split costs about one triangle test more than a leaf.
+      if (best_axis >= 0
+        && (task.count > ON_MESH_BVH_LEAF_SIZE || best_cost < (task.count - 1) * ON_Internal_MeshBVHHalfArea(task.bbox)))
+      {
+        const int k = best_axis;
+        const double s = scale[k];
+        const double c0 = task.center_bbox[k];
+        unsigned int* mid = std::partition(order + task.first, order + task.first + task.count,
+          [=](unsigned int t)
+          {
+            unsigned int b = (unsigned int)((tri_center[3 * t + k] - c0)*s);
+            return (b <= best_bin);
+          });
+        left_count = (unsigned int)(mid - (order + task.first));
+        ON_Internal_MeshBVHEmptyBox(left_bbox);
+        ON_Internal_MeshBVHEmptyBox(right_bbox);
+        for (unsigned int b = 0; b < ON_MESH_BVH_BIN_COUNT; b++)
+          ON_Internal_MeshBVHUnionBox((b <= best_bin) ? left_bbox : right_bbox, bin_bbox[k][b]);
+        bChildBoxes = true;
+      }
+    }
+
+    if ((0 == left_count || task.count == left_count) && task.count > ON_MESH_BVH_LEAF_SIZE)
+    {
+      // Coincident centroids or a deep tree: median split on the longest axis
+      int k = 0;
+      for (int j = 1; j < 3; j++)
+      {
+        if (task.bbox[j + 3] - task.bbox[j] > task.bbox[k + 3] - task.bbox[k])
+          k = j;
+      }
+      left_count = task.count / 2;
+      std::nth_element(order + task.first, order + task.first + left_count, order + task.first + task.count,
+        [=](unsigned int a, unsigned int b) { return tri_center[3 * a + k] < tri_center[3 * b + k]; });
+      bChildBoxes = false;
+    }
+
+    unsigned int* node_index = m_node_index.Array() + 2 * task.node;
+    if (left_count > 0 && left_count < task.count)
+    {
+      const unsigned int child = m_node_index.UnsignedCount() / 2;
+      node_index[0] = child;
+      node_index[1] = 0;
+      const double zero_bbox[12] = {};
+      const unsigned int zero_index[4] = {};
+      m_node_bbox.Append(12, zero_bbox);
+      m_node_index.Append(4, zero_index);
+
+      BuildTask& right = tasks.AppendNew();
+      right.node = child + 1;
+      right.first = task.first + left_count;
+      right.count = task.count - left_count;
+      right.depth = task.depth + 1;
+      if (bChildBoxes)
+        memcpy(right.bbox, right_bbox, sizeof(right_bbox));
+      set_task_boxes(right, !bChildBoxes);
+
+      BuildTask& left = tasks.AppendNew();
+      left.node = child;
+      left.first = task.first;
+      left.count = left_count;
+      left.depth = task.depth + 1;
+      if (bChildBoxes)
+        memcpy(left.bbox, left_bbox, sizeof(left_bbox));
+      set_task_boxes(left, !bChildBoxes);
+    }
+    else
+    {
+      node_index[0] = task.first;
+      node_index[1] = task.count;
     }
   }
-  else
+
+  // Store the triangles in leaf order.
+  ON_SimpleArray<unsigned int> tri(4 * (size_t)tri_count);
+  for (unsigned int i = 0; i < tri_count; i++)
+    tri.Append(4, m_tri.Array() + 4 * order[i]);
+  m_tri = tri;
+
+  return true;
+}
+
+void ON_MeshBVH::Destroy()
+{
+  m_node_bbox.Destroy();
+  m_node_index.Destroy();
+  m_tri.Destroy();
+  m_V.Destroy();
+}
+
+unsigned int ON_MeshBVH::TriangleCount() const
+{
+  return m_tri.UnsignedCount() / 4;
+}
+
+unsigned int ON_MeshBVH::NodeCount() const
+{
+  return m_node_index.UnsignedCount() / 2;
+}
+
+ON_BoundingBox ON_MeshBVH::BoundingBox() const
+{
+  if (m_node_bbox.UnsignedCount() < 6)
+    return ON_BoundingBox::EmptyBoundingBox;
+  const double* b = m_node_bbox.Array();
+  return ON_BoundingBox(ON_3dPoint(b[0], b[1], b[2]), ON_3dPoint(b[3], b[4], b[5]));
+}
+
+static void ON_Internal_MeshBVHSetFacePoint(
+  const unsigned int* tri,
+  const double P[3],
+  double b1,
+  double b2,
+  ON_MeshFacePoint& point
+  )
+{
+  const unsigned char* c = ON_Internal_MeshBVHCorners[tri[3] & 3];
+  point.m_face_index = tri[3] >> 2;
+  point.m_t[0] = point.m_t[1] = point.m_t[2] = point.m_t[3] = 0.0;
+  point.m_t[c[0]] = 1.0 - b1 - b2;
+  point.m_t[c[1]] = b1;
+  point.m_t[c[2]] = b2;
+  point.m_P = ON_3dPoint(P);
+}
+
+// The query kernels work on raw coordinates so the inner loops
+// do not call the out of line ON_3dPoint and ON_3dVector operators.
+static void ON_Internal_MeshBVHSub(const double* a, const double* b, double* d)
+{
+  d[0] = a[0] - b[0];
+  d[1] = a[1] - b[1];
+  d[2] = a[2] - b[2];
+}
+
+static void ON_Internal_MeshBVHCross(const double* a, const double* b, double* c)
+{
+  c[0] = a[1] * b[2] - a[2] * b[1];
+  c[1] = a[2] * b[0] - a[0] * b[2];
+  c[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static double ON_Internal_MeshBVHDot(const double* a, const double* b)
+{
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+class ON_Internal_MeshBVHRay
+{
+public:
+  ON_Internal_MeshBVHRay(const ON_3dRay& ray)
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      m_P[k] = ray.m_P[k];
+      m_V[k] = ray.m_V[k];
+      m_inv[k] = (0.0 != m_V[k]) ? 1.0 / m_V[k] : 0.0;
+      m_parallel[k] = (0.0 == m_V[k]);
+    }
+  }
+
+  // Returns true if the ray hits the box at a parameter <= maximum_t
+  // and sets *tmin to the entry parameter.
+  bool HitsBox(const double* b, double maximum_t, double* tmin) const
   {
-    const float* fP0 = fPoints + point_stride*Vid[0];
-    if (3 == point_dim)
+    double t0 = 0.0;
+    double t1 = maximum_t;
+    for (int k = 0; k < 3; k++)
     {
-      for (unsigned int i = 1; i < Vcount; i++)
+      const double p = m_P[k];
+      if (m_parallel[k])
       {
-        const float* fP1 = fPoints + point_stride*Vid[i];
-        if (fP0[0] == fP1[0] && fP0[1] == fP1[1] && fP0[2] == fP1[2])
-        {
-          if (Vid[i] < temporary_id)
-            temporary_id = Vid[i];
-        }
-        else
-        {
-          while (i0 < i)
-          {
-            up[i0].m_temporary_id = temporary_id;
-            up[i0].m_vertex_index = Vid[i0];
-            i0++;
-          }
-          temporary_id = Vid[i0];
-          fP0 = fP1;
-        }
+        if (p < b[k] || p > b[k + 3])
+          return false;
+        continue;
+      }
+      double s0 = (b[k] - p)*m_inv[k];
+      double s1 = (b[k + 3] - p)*m_inv[k];
+      if (s0 > s1)
+      {
+        const double s = s0; s0 = s1; s1 = s;
       }
+      if (s0 > t0)
+        t0 = s0;
+      if (s1 < t1)
+        t1 = s1;
+      if (t0 > t1)
+        return false;
     }
-    else
+    *tmin = t0;
+    return true;
+  }
+
+  // Moller-Trumbore ray triangle intersection without back face culling.
+  // The barycentric coordinates may be off by a few ulps, so a ray 
+  // through an edge shared by two triangles could miss both of them. 
+  // Hits within ON_ZERO_TOLERANCE of an edge are accepted and clamped
+  // to the triangle.
+  bool HitsTriangle(
+    const double* A,
+    const double* B,
+    const double* C,
+    double maximum_t,
+    double* t,
+    double* b1,
+    double* b2
+    ) const
+  {
+    double E1[3], E2[3], P[3], T[3], Q[3];
+    ON_Internal_MeshBVHSub(B, A, E1);
+    ON_Internal_MeshBVHSub(C, A, E2);
+    ON_Internal_MeshBVHCross(m_V, E2, P);
+    const double det = ON_Internal_MeshBVHDot(E1, P);
+    if (!(det != 0.0))
+      return false;
+    const double inv_det = 1.0 / det;
+    ON_Internal_MeshBVHSub(m_P, A, T);
+    const double tol = ON_ZERO_TOLERANCE;
+    double u = ON_Internal_MeshBVHDot(T, P)*inv_det;
+    if (!(u >= -tol && u <= 1.0 + tol))
+      return false;
+    ON_Internal_MeshBVHCross(T, E1, Q);
+    double v = ON_Internal_MeshBVHDot(m_V, Q)*inv_det;
+    if (!(v >= -tol && u + v <= 1.0 + tol))
+      return false;
+    const double s = ON_Internal_MeshBVHDot(E2, Q)*inv_det;
+    if (!(s >= 0.0 && s <= maximum_t))
+      return false;
+    if (u < 0.0)
+      u = 0.0;
+    if (v < 0.0)
+      v = 0.0;
+    if (u + v > 1.0)
+    {
+      const double uv = u + v;
+      u /= uv;
+      v /= uv;
+    }
+    *t = s;
+    *b1 = u;
+    *b2 = v;
+    return true;
+  }
+
+  void PointAt(double t, double P[3]) const
+  {
+    P[0] = m_P[0] + t*m_V[0];
+    P[1] = m_P[1] + t*m_V[1];
+    P[2] = m_P[2] + t*m_V[2];
+  }
+
+  double m_P[3];
+  double m_V[3];
+  double m_inv[3];
+  bool m_parallel[3];
+};
+
+bool ON_MeshBVH::RayFirstHit(
+  const ON_3dRay& ray,
+  double maximum_t,
+  ON_MeshFacePoint& hit
+  ) const
+{
+  hit = ON_MeshFacePoint();
+  if (m_node_index.UnsignedCount() < 2 || !ray.m_P.IsValid() || !ray.m_V.IsValid() || ray.m_V.IsZero())
+    return false;
+  if (!(maximum_t >= 0.0))
+    return false;
+
+  const ON_Internal_MeshBVHRay r(ray);
+  const double* node_bbox = m_node_bbox.Array();
+  const unsigned int* node_index = m_node_index.Array();
+  const unsigned int* tris = m_tri.Array();
+  const double* V = &m_V.Array()->x;
+
+  double best_t = maximum_t;
+  unsigned int best_tri = ON_UNSET_UINT_INDEX;
+  double best_b1 = 0.0, best_b2 = 0.0;
+
+  double tmin;
+  if (!r.HitsBox(node_bbox, best_t, &tmin))
+    return false;
+
+  unsigned int stack[ON_MESH_BVH_STACK_CAPACITY];
+  unsigned int stack_count = 0;
+  stack[stack_count++] = 0;
+  while (stack_count > 0)
+  {
+    const unsigned int n = stack[--stack_count];
+    const unsigned int* ni = node_index + 2 * n;
+    if (ni[1] > 0)
     {
-      for (unsigned int i = 1; i < Vcount; i++)
+      for (unsigned int t = ni[0]; t < ni[0] + ni[1]; t++)
       {
-        const float* fP1 = fPoints + point_stride*Vid[i];
-        if (fP0[0] == fP1[0] && fP0[1] == fP1[1])
-        {
-          if (Vid[i] < temporary_id)
-            temporary_id = Vid[i];
-        }
-        else
+        const unsigned int* tri = tris + 4 * t;
+        double s, b1, b2;
+        if (r.HitsTriangle(V + 3 * tri[0], V + 3 * tri[1], V + 3 * tri[2], best_t, &s, &b1, &b2))
         {
-          while (i0 < i)
+          if (s < best_t || ON_UNSET_UINT_INDEX == best_tri)
           {
-            up[i0].m_temporary_id = temporary_id;
-            up[i0].m_vertex_index = Vid[i0];
-            i0++;
+            best_t = s;
+            best_tri = t;
+            best_b1 = b1;
+            best_b2 = b2;
           }
-          temporary_id = Vid[i0];
-          fP0 = fP1;
         }
       }
+      continue;
+    }
+    // Visit the nearer child first.
+    double t0, t1;
+    const bool bHit0 = r.HitsBox(node_bbox + 6 * ni[0], best_t, &t0);
+    const bool bHit1 = r.HitsBox(node_bbox + 6 * (ni[0] + 1), best_t, &t1);
+    if (bHit0 && bHit1)
+    {
+      if (t0 <= t1)
+      {
+        stack[stack_count++] = ni[0] + 1;
+        stack[stack_count++] = ni[0];
+      }
+      else
+      {
+        stack[stack_count++] = ni[0];
+        stack[stack_count++] = ni[0] + 1;
+      }
+    }
+    else if (bHit0)
+      stack[stack_count++] = ni[0];
+    else if (bHit1)
+      stack[stack_count++] = ni[0] + 1;
+  }
+
+  if (ON_UNSET_UINT_INDEX == best_tri)
+    return false;
+
+  double P[3];
+  r.PointAt(best_t, P);
+  ON_Internal_MeshBVHSetFacePoint(tris + 4 * best_tri, P, best_b1, best_b2, hit);
+  hit.m_ray_t = best_t;
+  return true;
+}
+
+unsigned int ON_MeshBVH::RayAllHits(
+  const ON_3dRay& ray,
+  double maximum_t,
+  ON_SimpleArray<ON_MeshFacePoint>& hits
+  ) const
+{
+  if (m_node_index.UnsignedCount() < 2 || !ray.m_P.IsValid() || !ray.m_V.IsValid() || ray.m_V.IsZero())
+    return 0;
+  if (!(maximum_t >= 0.0))
+    return 0;
+
+  const ON_Internal_MeshBVHRay r(ray);
+  const double* node_bbox = m_node_bbox.Array();
+  const unsigned int* node_index = m_node_index.Array();
+  const unsigned int* tris = m_tri.Array();
+  const double* V = &m_V.Array()->x;
+
+  const unsigned int hit_count0 = hits.UnsignedCount();
+  unsigned int stack[ON_MESH_BVH_STACK_CAPACITY];
+  unsigned int stack_count = 0;
+  stack[stack_count++] = 0;
+  while (stack_count > 0)
+  {
+    const unsigned int n = stack[--stack_count];
+    double tmin;
+    if (!r.HitsBox(node_bbox + 6 * n, maximum_t, &tmin))
+      continue;
+    const unsigned int* ni = node_index + 2 * n;
+    if (0 == ni[1])
+    {
+      stack[stack_count++] = ni[0] + 1;
+      stack[stack_count++] = ni[0];
+      continue;
+    }
+    for (unsigned int t = ni[0]; t < ni[0] + ni[1]; t++)
+    {
+      const unsigned int* tri = tris + 4 * t;
+      double s, b1, b2;
+      if (r.HitsTriangle(V + 3 * tri[0], V + 3 * tri[1], V + 3 * tri[2], maximum_t, &s, &b1, &b2))
+      {
+        double P[3];
+        r.PointAt(s, P);
+        ON_MeshFacePoint hit;
+        ON_Internal_MeshBVHSetFacePoint(tri, P, b1, b2, hit);
+        hit.m_ray_t = s;
+        hits.Append(hit);
+      }
     }
   }
 
-  while (i0 < Vcount)
+  ON_MeshFacePoint* a = hits.Array() + hit_count0;
+  const unsigned int count = hits.UnsignedCount() - hit_count0;
+  std::sort(a, a + count,
+    [](const ON_MeshFacePoint& lhs, const ON_MeshFacePoint& rhs)
+    {
+      if (lhs.m_ray_t != rhs.m_ray_t)
+        return lhs.m_ray_t < rhs.m_ray_t;
+      return lhs.m_face_index < rhs.m_face_index;
+    });
+
+  // A ray through the diagonal of a quad hits both of its triangles.
+  unsigned int kept = 0;
+  for (unsigned int i = 0; i < count; i++)
   {
-    up[i0].m_temporary_id = temporary_id;
-    up[i0].m_vertex_index = Vid[i0];
-    i0++;
+    bool bDuplicate = false;
+    for (unsigned int j = kept; j > 0; j--)
+    {
+      const ON_MeshFacePoint& prev = a[j - 1];
+      if (a[i].m_ray_t - prev.m_ray_t > ON_SQRT_EPSILON*(1.0 + fabs(a[i].m_ray_t)))
+        break;
+      if (prev.m_face_index == a[i].m_face_index)
+      {
+        bDuplicate = true;
+        break;
+      }
+    }
+    if (!bDuplicate)
+      a[kept++] = a[i];
   }
+  hits.SetCount(hit_count0 + kept);
 
-  // This sort is necessary to insure the vertex id does not change when 
-  // the point set is transformed. It is important that the id be the
-  // same in these situations so that vertex id groups retain the same 
-  // id when meshes are rotated.
-  ON_qsort(up, Vcount, sizeof(up[0]), comparedUnsignedPair);
+  return kept;
+}
 
-  temporary_id = up[0].m_temporary_id;
-  unsigned int id = first_vid;
-  Vid[up[0].m_vertex_index] = id;
-  for (unsigned int i = 1; i < Vcount; i++)
+// Closest point Q on triangle ABC to P.
+// Returns the barycentric coordinates of B and C in *b1 and *b2.
+static void ON_Internal_MeshBVHClosestPointOnTriangle(
+  const double* P,
+  const double* A,
+  const double* B,
+  const double* C,
+  double* Q,
+  double* b1,
+  double* b2
+  )
+{
+  double AB[3], AC[3], AP[3], BP[3], CP[3];
+  ON_Internal_MeshBVHSub(B, A, AB);
+  ON_Internal_MeshBVHSub(C, A, AC);
+  ON_Internal_MeshBVHSub(P, A, AP);
+  const double d1 = ON_Internal_MeshBVHDot(AB, AP);
+  const double d2 = ON_Internal_MeshBVHDot(AC, AP);
+  double v = 0.0, w = 0.0;
+  for (;;)
   {
-    if (temporary_id != up[i].m_temporary_id)
+    if (d1 <= 0.0 && d2 <= 0.0)
+      break; // A
+
+    ON_Internal_MeshBVHSub(P, B, BP);
+    const double d3 = ON_Internal_MeshBVHDot(AB, BP);
+    const double d4 = ON_Internal_MeshBVHDot(AC, BP);
+    if (d3 >= 0.0 && d4 <= d3)
+    {
+      v = 1.0; // B
+      break;
+    }
+
+    const double vc = d1*d4 - d3*d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0)
+    {
+      v = (d1 - d3 > 0.0) ? d1 / (d1 - d3) : 0.0; // edge AB
+      break;
+    }
+
+    ON_Internal_MeshBVHSub(P, C, CP);
+    const double d5 = ON_Internal_MeshBVHDot(AB, CP);
+    const double d6 = ON_Internal_MeshBVHDot(AC, CP);
+    if (d6 >= 0.0 && d5 <= d6)
+    {
+      w = 1.0; // C
+      break;
+    }
+
+    const double vb = d5*d2 - d1*d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0)
+    {
+      w = (d2 - d6 > 0.0) ? d2 / (d2 - d6) : 0.0; // edge AC
+      break;
+    }
+
+    const double va = d3*d6 - d5*d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0)
+    {
+      const double d = (d4 - d3) + (d5 - d6);
+      w = (d > 0.0) ? (d4 - d3) / d : 0.0; // edge BC
+      v = 1.0 - w;
+      break;
+    }
+
+    const double d = va + vb + vc;
+    if (d > 0.0)
     {
-      temporary_id = up[i].m_temporary_id;
-      id++;
+      v = vb / d; // interior
+      w = vc / d;
     }
-    Vid[up[i].m_vertex_index] = id;
+    break;
   }
 
-  if (0 != Vindex)
+  Q[0] = A[0] + v*AB[0] + w*AC[0];
+  Q[1] = A[1] + v*AB[1] + w*AC[1];
+  Q[2] = A[2] + v*AB[2] + w*AC[2];
+  *b1 = v;
+  *b2 = w;
+}
+
+static double ON_Internal_MeshBVHBoxDistanceSquared(const double* b, const double* P)
+{
+  double d2 = 0.0;
+  for (int k = 0; k < 3; k++)
   {
-    for (unsigned int i = 0; i < Vcount; i++)
+    const double p = P[k];
+    const double d = (p < b[k]) ? (b[k] - p) : ((p > b[k + 3]) ? (p - b[k + 3]) : 0.0);
+    d2 += d*d;
+  }
+  return d2;
+}
+
+bool ON_MeshBVH::GetClosestPoint(
+  ON_3dPoint P,
+  double maximum_distance,
+  ON_MeshFacePoint& closest_point
+  ) const
+{
+  closest_point = ON_MeshFacePoint();
+  if (m_node_index.UnsignedCount() < 2 || !P.IsValid())
+    return false;
+
+  const double* node_bbox = m_node_bbox.Array();
+  const unsigned int* node_index = m_node_index.Array();
+  const unsigned int* tris = m_tri.Array();
+  const double* V = &m_V.Array()->x;
+  const double p[3] = { P.x, P.y, P.z };
+
+  double best_d2 = (maximum_distance > 0.0) ? maximum_distance*maximum_distance : ON_DBL_MAX;
+  unsigned int best_tri = ON_UNSET_UINT_INDEX;
+  double best_Q[3] = {};
+  double best_b1 = 0.0, best_b2 = 0.0;
+
+  unsigned int stack[ON_MESH_BVH_STACK_CAPACITY];
+  unsigned int stack_count = 0;
+  stack[stack_count++] = 0;
+  while (stack_count > 0)
+  {
+    const unsigned int n = stack[--stack_count];
+    if (ON_Internal_MeshBVHBoxDistanceSquared(node_bbox + 6 * n, p) > best_d2)
+      continue;
+    const unsigned int* ni = node_index + 2 * n;
+    if (ni[1] > 0)
+    {
+      for (unsigned int t = ni[0]; t < ni[0] + ni[1]; t++)
+      {
+        const unsigned int* tri = tris + 4 * t;
+        double Q[3], b1, b2, D[3];
+        ON_Internal_MeshBVHClosestPointOnTriangle(p, V + 3 * tri[0], V + 3 * tri[1], V + 3 * tri[2], Q, &b1, &b2);
+        ON_Internal_MeshBVHSub(Q, p, D);
+        const double d2 = ON_Internal_MeshBVHDot(D, D);
+        if (d2 < best_d2 || (d2 == best_d2 && ON_UNSET_UINT_INDEX == best_tri))
+        {
+          best_d2 = d2;
+          best_tri = t;
+          memcpy(best_Q, Q, sizeof(Q));
+          best_b1 = b1;
+          best_b2 = b2;
+        }
+      }
+      continue;
+    }
+    // Visit the nearer child first.
+    const double d0 = ON_Internal_MeshBVHBoxDistanceSquared(node_bbox + 6 * ni[0], p);
+    const double d1 = ON_Internal_MeshBVHBoxDistanceSquared(node_bbox + 6 * (ni[0] + 1), p);
+    if (d0 <= d1)
+    {
+      if (d1 <= best_d2)
+        stack[stack_count++] = ni[0] + 1;
+      if (d0 <= best_d2)
+        stack[stack_count++] = ni[0];
+    }
+    else
+    {
+      if (d0 <= best_d2)
+        stack[stack_count++] = ni[0];
+      if (d1 <= best_d2)
+        stack[stack_count++] = ni[0] + 1;
+    }
+  }
+
+  if (ON_UNSET_UINT_INDEX == best_tri)
+    return false;
+
+  ON_Internal_MeshBVHSetFacePoint(tris + 4 * best_tri, best_Q, best_b1, best_b2, closest_point);
+  closest_point.m_distance = sqrt(best_d2);
+  return true;
+}
+
+static bool ON_Internal_MeshBVHSegmentsIntersect2d(
+  const double* a0, const double* a1,
+  const double* b0, const double* b1
+  )
+{
+  // Inclusive test for 2d segments a0a1 and b0b1.
+  auto orient = [](const double* p, const double* q, const double* r)
+  {
+    const double d = (q[0] - p[0])*(r[1] - p[1]) - (q[1] - p[1])*(r[0] - p[0]);
+    return (d > 0.0) ? 1 : ((d < 0.0) ? -1 : 0);
+  };
+  auto on_segment = [](const double* p, const double* q, const double* r)
+  {
+    // r is collinear with pq
+    return (r[0] >= (p[0] < q[0] ? p[0] : q[0]) && r[0] <= (p[0] > q[0] ? p[0] : q[0])
+      && r[1] >= (p[1] < q[1] ? p[1] : q[1]) && r[1] <= (p[1] > q[1] ? p[1] : q[1]));
+  };
+  const int o1 = orient(a0, a1, b0);
+  const int o2 = orient(a0, a1, b1);
+  const int o3 = orient(b0, b1, a0);
+  const int o4 = orient(b0, b1, a1);
+  if (o1 != o2 && o3 != o4)
+    return true;
+  if (0 == o1 && on_segment(a0, a1, b0))
+    return true;
+  if (0 == o2 && on_segment(a0, a1, b1))
+    return true;
+  if (0 == o3 && on_segment(b0, b1, a0))
+    return true;
+  if (0 == o4 && on_segment(b0, b1, a1))
+    return true;
+  return false;
+}
+
+static bool ON_Internal_MeshBVHPointInTriangle2d(const double* p, const double* a, const double* b, const double* c)
+{
+  const double d0 = (b[0] - a[0])*(p[1] - a[1]) - (b[1] - a[1])*(p[0] - a[0]);
+  const double d1 = (c[0] - b[0])*(p[1] - b[1]) - (c[1] - b[1])*(p[0] - b[0]);
+  const double d2 = (a[0] - c[0])*(p[1] - c[1]) - (a[1] - c[1])*(p[0] - c[0]);
+  return (d0 >= 0.0 && d1 >= 0.0 && d2 >= 0.0) || (d0 <= 0.0 && d1 <= 0.0 && d2 <= 0.0);
+}
+
+static bool ON_Internal_MeshBVHCoplanarTrianglesIntersect(
+  const double* N,
+  const double* const A[3],
+  const double* const B[3]
+  )
+{
+  // Project onto the coordinate plane that is most parallel to the triangles.
+  int i0 = 1, i1 = 2;
+  const double nx = fabs(N[0]), ny = fabs(N[1]), nz = fabs(N[2]);
+  if (ny >= nx && ny >= nz)
+    i0 = 0;
+  else if (nz >= nx && nz >= ny)
+  {
+    i0 = 0;
+    i1 = 1;
+  }
+  double a[3][2], b[3][2];
+  for (int i = 0; i < 3; i++)
+  {
+    a[i][0] = A[i][i0]; a[i][1] = A[i][i1];
+    b[i][0] = B[i][i0]; b[i][1] = B[i][i1];
+  }
+  for (int i = 0; i < 3; i++)
+  {
+    for (int j = 0; j < 3; j++)
     {
-      Vindex[i] = up[i].m_vertex_index;
+      if (ON_Internal_MeshBVHSegmentsIntersect2d(a[i], a[(i + 1) % 3], b[j], b[(j + 1) % 3]))
+        return true;
     }
   }
+  return ON_Internal_MeshBVHPointInTriangle2d(a[0], b[0], b[1], b[2])
+    || ON_Internal_MeshBVHPointInTriangle2d(b[0], a[0], a[1], a[2]);
+}
+
+// Signed distances from the corners of T to the plane through P with normal N.
+// Distances that are zero relative to the size of the triangles are set to zero.
+// Returns false if all three corners are strictly on the same side.
+static bool ON_Internal_MeshBVHPlaneDistances(
+  const double* N,
+  const double* P,
+  const double* const T[3],
+  double tolerance,
+  double d[3]
+  )
+{
+  for (int i = 0; i < 3; i++)
+  {
+    double D[3];
+    ON_Internal_MeshBVHSub(T[i], P, D);
+    d[i] = ON_Internal_MeshBVHDot(N, D);
+    if (fabs(d[i]) <= tolerance)
+      d[i] = 0.0;
+  }
+  return !((d[0] > 0.0 && d[1] > 0.0 && d[2] > 0.0) || (d[0] < 0.0 && d[1] < 0.0 && d[2] < 0.0));
+}
 
-  delete[] up;
+// Interval where a triangle crosses the line of intersection of the two planes.
+static void ON_Internal_MeshBVHTriangleInterval(
+  const double p[3],
+  const double d[3],
+  double interval[2]
+  )
+{
+  // k is the corner that is alone on its side of the other plane.
+  int k;
+  if (d[0] * d[1] > 0.0)
+    k = 2;
+  else if (d[0] * d[2] > 0.0)
+    k = 1;
+  else if (d[1] * d[2] > 0.0 || 0.0 != d[0])
+    k = 0;
+  else if (0.0 != d[1])
+    k = 1;
+  else
+    k = 2;
+  const int i = (k + 1) % 3;
+  const int j = (k + 2) % 3;
+  const double ti = p[k] + (p[i] - p[k])*d[k] / (d[k] - d[i]);
+  const double tj = p[k] + (p[j] - p[k])*d[k] / (d[k] - d[j]);
+  interval[0] = (ti <= tj) ? ti : tj;
+  interval[1] = (ti <= tj) ? tj : ti;
+}
+
+// Moller's interval overlap triangle triangle intersection test.
+// Touching triangles intersect. Degenerate triangles do not intersect anything.
+static bool ON_Internal_MeshBVHTrianglesIntersect(
+  const double* const A[3],
+  const double* const B[3]
+  )
+{
+  double E1[3], E2[3], NA[3], NB[3];
+  ON_Internal_MeshBVHSub(B[1], B[0], E1);
+  ON_Internal_MeshBVHSub(B[2], B[0], E2);
+  ON_Internal_MeshBVHCross(E1, E2, NB);
+  const double lenB = sqrt(ON_Internal_MeshBVHDot(NB, NB));
+  if (!(lenB > 0.0))
+    return false;
+
+  double size = 0.0;
+  for (int i = 0; i < 3; i++)
+  {
+    for (int k = 0; k < 3; k++)
+    {
+      const double a = fabs(A[i][k]);
+      const double b = fabs(B[i][k]);
+      if (a > size)
+        size = a;
+      if (b > size)
+        size = b;
+    }
+  }
+  const double rel_tol = 64.0*ON_EPSILON*(1.0 + size);
+
+  double dA[3];
+  if (!ON_Internal_MeshBVHPlaneDistances(NB, B[0], A, rel_tol*lenB, dA))
+    return false;
+
+  ON_Internal_MeshBVHSub(A[1], A[0], E1);
+  ON_Internal_MeshBVHSub(A[2], A[0], E2);
+  ON_Internal_MeshBVHCross(E1, E2, NA);
+  const double lenA = sqrt(ON_Internal_MeshBVHDot(NA, NA));
+  if (!(lenA > 0.0))
+    return false;
+
+  double dB[3];
+  if (!ON_Internal_MeshBVHPlaneDistances(NA, A[0], B, rel_tol*lenA, dB))
+    return false;
+
+  if (0.0 == dA[0] && 0.0 == dA[1] && 0.0 == dA[2])
+    return ON_Internal_MeshBVHCoplanarTrianglesIntersect(NB, A, B);
+  if (0.0 == dB[0] && 0.0 == dB[1] && 0.0 == dB[2])
+    return ON_Internal_MeshBVHCoplanarTrianglesIntersect(NA, A, B);
+
+  // Project onto the largest coordinate of the intersection line direction.
+  double D[3];
+  ON_Internal_MeshBVHCross(NA, NB, D);
+  int k = 0;
+  if (fabs(D[1]) > fabs(D[k]))
+    k = 1;
+  if (fabs(D[2]) > fabs(D[k]))
+    k = 2;
+  const double pA[3] = { A[0][k], A[1][k], A[2][k] };
+  const double pB[3] = { B[0][k], B[1][k], B[2][k] };
+  double iA[2], iB[2];
+  ON_Internal_MeshBVHTriangleInterval(pA, dA, iA);
+  ON_Internal_MeshBVHTriangleInterval(pB, dB, iB);
+  return (iA[0] <= iB[1] && iB[0] <= iA[1]);
+}
+
+static bool ON_Internal_MeshBVHShareCorner(const double* const A[3], const double* const B[3])
+{
+  for (int i = 0; i < 3; i++)
+  {
+    for (int j = 0; j < 3; j++)
+    {
+      if (A[i][0] == B[j][0] && A[i][1] == B[j][1] && A[i][2] == B[j][2])
+        return true;
+    }
+  }
+  return false;
+}
+
+unsigned int ON_MeshBVH::GetClashingFacePairs(
+  const ON_MeshBVH& other,
+  unsigned int max_pair_count,
+  ON_SimpleArray<ON_2dex>& clashing_pairs
+  ) const
+{
+  if (m_node_index.UnsignedCount() < 2 || other.m_node_index.UnsignedCount() < 2)
+    return 0;
+
+  const bool bSelf = (this == &other);
+  const double* bboxA = m_node_bbox.Array();
+  const double* bboxB = other.m_node_bbox.Array();
+  const unsigned int* indexA = m_node_index.Array();
+  const unsigned int* indexB = other.m_node_index.Array();
+  const unsigned int* trisA = m_tri.Array();
+  const unsigned int* trisB = other.m_tri.Array();
+  const double* VA = &m_V.Array()->x;
+  const double* VB = &other.m_V.Array()->x;
+
+  // A face pair can be found by up to four triangle pairs.
+  const unsigned int max_raw_count = (max_pair_count > 0 && max_pair_count < 0x3FFFFFFFU) ? 4 * max_pair_count : 0xFFFFFFFFU;
+  ON_SimpleArray<ON_2dex> pairs;
+
+  auto test_triangles = [&](unsigned int ta, unsigned int tb)
+  {
+    const unsigned int* triA = trisA + 4 * ta;
+    const unsigned int* triB = trisB + 4 * tb;
+    const unsigned int fa = triA[3] >> 2;
+    const unsigned int fb = triB[3] >> 2;
+    if (bSelf && fa == fb)
+      return;
+    const double* const A[3] = { VA + 3 * triA[0], VA + 3 * triA[1], VA + 3 * triA[2] };
+    const double* const B[3] = { VB + 3 * triB[0], VB + 3 * triB[1], VB + 3 * triB[2] };
+    if (bSelf && ON_Internal_MeshBVHShareCorner(A, B))
+      return;
+    if (!ON_Internal_MeshBVHTrianglesIntersect(A, B))
+      return;
+    if (bSelf && fb < fa)
+      pairs.Append(ON_2dex((int)fb, (int)fa));
+    else
+      pairs.Append(ON_2dex((int)fa, (int)fb));
+  };
+
+  // Simultaneous descent. Self pairs (n,n) test a subtree against itself.
+  unsigned int stack[2 * ON_MESH_BVH_STACK_CAPACITY][2];
+  unsigned int stack_count = 0;
+  stack[stack_count][0] = 0;
+  stack[stack_count][1] = 0;
+  stack_count++;
+  while (stack_count > 0 && pairs.UnsignedCount() < max_raw_count)
+  {
+    stack_count--;
+    const unsigned int a = stack[stack_count][0];
+    const unsigned int b = stack[stack_count][1];
+    const unsigned int* na = indexA + 2 * a;
+    const unsigned int* nb = indexB + 2 * b;
+
+    if (bSelf && a == b)
+    {
+      if (na[1] > 0)
+      {
+        for (unsigned int i = na[0]; i < na[0] + na[1]; i++)
+        {
+          for (unsigned int j = i + 1; j < na[0] + na[1]; j++)
+            test_triangles(i, j);
+        }
+      }
+      else
+      {
+        const unsigned int c = na[0];
+        stack[stack_count][0] = c; stack[stack_count][1] = c; stack_count++;
+        stack[stack_count][0] = c + 1; stack[stack_count][1] = c + 1; stack_count++;
+        stack[stack_count][0] = c; stack[stack_count][1] = c + 1; stack_count++;
+      }
+      continue;
+    }
+
+    if (!ON_Internal_MeshBVHBoxesOverlap(bboxA + 6 * a, bboxB + 6 * b))
+      continue;
+
+    if (na[1] > 0 && nb[1] > 0)
+    {
+      for (unsigned int i = na[0]; i < na[0] + na[1]; i++)
+      {
+        for (unsigned int j = nb[0]; j < nb[0] + nb[1]; j++)
+          test_triangles(i, j);
+      }
+      continue;
+    }
+
+    // Descend into the larger interior node.
+    const bool bSplitA = (0 == nb[1]) 
+      ? (0 == na[1] && ON_Internal_MeshBVHHalfArea(bboxA + 6 * a) >= ON_Internal_MeshBVHHalfArea(bboxB + 6 * b))
+      : true;
+    if (bSplitA)
+    {
+      stack[stack_count][0] = na[0] + 1; stack[stack_count][1] = b; stack_count++;
+      stack[stack_count][0] = na[0]; stack[stack_count][1] = b; stack_count++;
+    }
+    else
+    {
+      stack[stack_count][0] = a; stack[stack_count][1] = nb[0] + 1; stack_count++;
+      stack[stack_count][0] = a; stack[stack_count][1] = nb[0]; stack_count++;
+    }
+  }
+
+  std::sort(pairs.Array(), pairs.Array() + pairs.Count(),
+    [](const ON_2dex& lhs, const ON_2dex& rhs)
+    {
+      return (lhs.i != rhs.i) ? (lhs.i < rhs.i) : (lhs.j < rhs.j);
+    });
+
+  const unsigned int pair_count0 = clashing_pairs.UnsignedCount();
+  for (int i = 0; i < pairs.Count(); i++)
+  {
+    if (i > 0 && pairs[i].i == pairs[i - 1].i && pairs[i].j == pairs[i - 1].j)
+      continue;
+    if (max_pair_count > 0 && clashing_pairs.UnsignedCount() - pair_count0 >= max_pair_count)
+      break;
+    clashing_pairs.Append(pairs[i]);
+  }
+
+  return clashing_pairs.UnsignedCount() - pair_count0;
+}
+
+bool ON_MeshBVH::Clashes(
+  const ON_MeshBVH& other
+  ) const
+{
+  ON_SimpleArray<ON_2dex> pairs;
+  return (GetClashingFacePairs(other, 1, pairs) > 0);
+}
+
+unsigned int ON_MeshBVH::RayFirstHits(
+  unsigned int thread_count,
+  unsigned int ray_count,
+  const ON_3dRay* rays,
+  double maximum_t,
+  ON_MeshFacePoint* hits
+  ) const
+{
+  if (0 == ray_count || nullptr == rays || nullptr == hits)
+    return 0;
+
+  const unsigned int block_size = 256;
+  const unsigned int task_count = (ray_count + block_size - 1) / block_size;
+  std::atomic<unsigned int> hit_count(0);
+  ON_Internal_ParallelFor(thread_count, task_count,
+    [&](unsigned int task_index)
+    {
+      const unsigned int i1 = (task_index + 1 < task_count) ? (task_index + 1)*block_size : ray_count;
+      unsigned int n = 0;
+      for (unsigned int i = task_index*block_size; i < i1; i++)
+      {
+        if (RayFirstHit(rays[i], maximum_t, hits[i]))
+          n++;
+      }
+      hit_count += n;
+    });
+
+  return hit_count;
+}
+
+unsigned int ON_MeshBVH::GetClosestPoints(
+  unsigned int thread_count,
+  unsigned int point_count,
+  const ON_3dPoint* points,
+  double maximum_distance,
+  ON_MeshFacePoint* closest_points
+  ) const
+{
+  if (0 == point_count || nullptr == points || nullptr == closest_points)
+    return 0;
+
+  const unsigned int block_size = 256;
+  const unsigned int task_count = (point_count + block_size - 1) / block_size;
+  std::atomic<unsigned int> found_count(0);
+  ON_Internal_ParallelFor(thread_count, task_count,
+    [&](unsigned int task_index)
+    {
+      const unsigned int i1 = (task_index + 1 < task_count) ? (task_index + 1)*block_size : point_count;
+      unsigned int n = 0;
+      for (unsigned int i = task_index*block_size; i < i1; i++)
+      {
+        if (GetClosestPoint(points[i], maximum_distance, closest_points[i]))
+          n++;
+      }
+      found_count += n;
+    });
+
+  return found_count;
+}
+
+unsigned int ON_MeshBVH::GetClashingMeshPairs(
+  unsigned int thread_count,
+  unsigned int bvh_count,
+  const ON_MeshBVH* const* bvh_list,
+  ON_SimpleArray<ON_2dex>& clashing_mesh_pairs
+  )
+{
+  if (bvh_count < 2 || nullptr == bvh_list)
+    return 0;
+
+  // Sweep the root boxes along x to find candidate pairs.
+  ON_SimpleArray<unsigned int> order(bvh_count);
+  for (unsigned int i = 0; i < bvh_count; i++)
+  {
+    if (nullptr != bvh_list[i] && bvh_list[i]->m_node_bbox.UnsignedCount() >= 6)
+      order.Append(i);
+  }
+  std::sort(order.Array(), order.Array() + order.Count(),
+    [=](unsigned int a, unsigned int b)
+    {
+      const double xa = bvh_list[a]->m_node_bbox[0];
+      const double xb = bvh_list[b]->m_node_bbox[0];
+      return (xa != xb) ? (xa < xb) : (a < b);
+    });
+
+  ON_SimpleArray<ON_2dex> candidates;
+  for (int i = 0; i < order.Count(); i++)
+  {
+    const double* bi = bvh_list[order[i]]->m_node_bbox.Array();
+    for (int j = i + 1; j < order.Count(); j++)
+    {
+      const double* bj = bvh_list[order[j]]->m_node_bbox.Array();
+      if (bj[0] > bi[3])
+        break;
+      if (ON_Internal_MeshBVHBoxesOverlap(bi, bj))
+      {
+        const int a = (int)order[i];
+        const int b = (int)order[j];
+        candidates.Append((a < b) ? ON_2dex(a, b) : ON_2dex(b, a));
+      }
+    }
+  }
+
+  const unsigned int candidate_count = candidates.UnsignedCount();
+  if (0 == candidate_count)
+    return 0;
+
+  ON_SimpleArray<unsigned char> clash(candidate_count);
+  clash.SetCount(candidate_count);
+  const unsigned int block_size = 16;
+  const unsigned int task_count = (candidate_count + block_size - 1) / block_size;
+  ON_Internal_ParallelFor(thread_count, task_count,
+    [&](unsigned int task_index)
+    {
+      const unsigned int i1 = (task_index + 1 < task_count) ? (task_index + 1)*block_size : candidate_count;
+      for (unsigned int i = task_index*block_size; i < i1; i++)
+        clash[i] = bvh_list[candidates[i].i]->Clashes(*bvh_list[candidates[i].j]) ? 1 : 0;
+    });
+
+  ON_SimpleArray<ON_2dex> pairs;
+  for (unsigned int i = 0; i < candidate_count; i++)
+  {
+    if (0 != clash[i])
+      pairs.Append(candidates[i]);
+  }
+  std::sort(pairs.Array(), pairs.Array() + pairs.Count(),
+    [](const ON_2dex& lhs, const ON_2dex& rhs)
+    {
+      return (lhs.i != rhs.i) ? (lhs.i < rhs.i) : (lhs.j < rhs.j);
+    });
+  clashing_mesh_pairs.Append(pairs.Count(), pairs.Array());
+
+  return pairs.UnsignedCount();
+}
+
+int ON_Mesh::GetClashingFacePairs(
+  int max_pair_count,
+  ON_SimpleArray<ON_2dex>& clashing_pairs
+  ) const
+{
+  ON_MeshBVH bvh;
+  if (!bvh.Create(this))
+    return 0;
+  return (int)bvh.GetClashingFacePairs(bvh, (max_pair_count > 0) ? ((unsigned int)max_pair_count) : 0U, clashing_pairs);
+}
+
+int ON_Mesh::CullClashingFaces(int what_to_cull)
+{
+  if (what_to_cull < 0 || what_to_cull > 4)
+  {
+    ON_ERROR("Invalid what_to_cull parameter.");
+    return 0;
+  }
+
+  const unsigned int vertex_count = m_V.UnsignedCount();
+  const unsigned int face_count = m_F.UnsignedCount();
+  if (0 == face_count)
+    return 0;
+
+  ON_SimpleArray<bool> cull(face_count);
+  cull.SetCount(face_count);
+  ON_SimpleArray<double> measure;
+  if (0 != what_to_cull)
+    measure.SetCapacity(face_count);
+  for (unsigned int fi = 0; fi < face_count; fi++)
+  {
+    const ON_MeshFace& f = m_F[fi];
+    cull[fi] = !f.IsValid(vertex_count);
+    if (cull[fi] && 0 == what_to_cull)
+      continue;
+    double area = 0.0;
+    double edge = 0.0;
+    if (!cull[fi])
+    {
+      const ON_3dPoint P[4] = { Vertex(f.vi[0]), Vertex(f.vi[1]), Vertex(f.vi[2]), Vertex(f.vi[3]) };
+      area = ON_TriangleArea3d(P[0], P[1], P[2]);
+      if (f.IsQuad())
+        area += ON_TriangleArea3d(P[0], P[2], P[3]);
+      for (int i = 0; i < 4; i++)
+      {
+        const double d = P[i].DistanceTo(P[(i + 1) % 4]);
+        if (d > edge)
+          edge = d;
+      }
+      if (!(area > 0.0))
+        cull[fi] = true;
+    }
+    if (0 != what_to_cull)
+      measure.Append((what_to_cull <= 2) ? edge : area);
+  }
+
+  ON_SimpleArray<ON_2dex> pairs;
+  GetClashingFacePairs(0, pairs);
+  for (int i = 0; i < pairs.Count(); i++)
+  {
+    const unsigned int fa = (unsigned int)pairs[i].i;
+    const unsigned int fb = (unsigned int)pairs[i].j;
+    if (cull[fa] || cull[fb])
+      continue;
+    if (0 == what_to_cull)
+    {
+      cull[fa] = true;
+      cull[fb] = true;
+      continue;
+    }
+    // odd: keep the larger face, even: cull the larger face
+    const bool bALarger = (measure[fa] >= measure[fb]);
+    const bool bCullA = (1 == (what_to_cull % 2)) ? !bALarger : bALarger;
+    cull[bCullA ? fa : fb] = true;
+  }
+
+  ON_SimpleArray<ON_COMPONENT_INDEX> ci_list;
+  for (unsigned int fi = 0; fi < face_count; fi++)
+  {
+    if (cull[fi])
+      ci_list.Append(ON_COMPONENT_INDEX(ON_COMPONENT_INDEX::TYPE::mesh_face, (int)fi));
+  }
+  if (0 == ci_list.Count())
+    return 0;
+
+  if (!DeleteComponents(ci_list.Array(), ci_list.UnsignedCount(), true, false, true, true))
+    return 0;
+
+  return ci_list.Count();
+}
+
+
+
+
+
+//static int compare3fPoint(const void* a, const void* b)
+//{
+//  const float* af = (const float*)a;
+//  const float* bf = (const float*)b;
+//  if (af[0] < bf[0])
+//    return -1;
+//  if (af[0] > bf[0])
+//    return 1;
+//  if (af[1] < bf[1])
+//    return -1;
+//  if (af[1] > bf[1])
+//    return 1;
+//  if (af[2] < bf[2])
+//    return -1;
+//  if (af[2] > bf[2])
+//    return 1;
+//  return 0;
+//}
+//
+//static int compare3dPoint(const void* a, const void* b)
+//{
+//  const double* af = (const double*)a;
+//  const double* bf = (const double*)b;
+//  if (af[0] < bf[0])
+//    return -1;
+//  if (af[0] > bf[0])
+//    return 1;
+//  if (af[1] < bf[1])
+//    return -1;
+//  if (af[1] > bf[1])
+//    return 1;
+//  if (af[2] < bf[2])
+//    return -1;
+//  if (af[2] > bf[2])
+//    return 1;
+//  return 0;
+//}
+
+
+static ON__UINT64 ON_Internal_PointCoordinateBits(float x)
+{
+  return ON_Internal_MeshWeldFloatBits(x);
+}
+
+static ON__UINT64 ON_Internal_PointCoordinateBits(double x)
+{
+  return ON_Internal_MeshWeldDoubleBits(x);
+}
+
+/*
+Description:
+  Sets Vid[i] = first_vid + (the number of distinct point locations
+  that first appear before points[i]). When Vindex is not null,
+  Vindex[] is set to the point indices sorted by (Vid[i],i).
+*/
+template <class T>
+static void ON_Internal_GetPointLocationIds(
+  size_t point_dim,
+  unsigned int Vcount,
+  size_t point_stride,
+  const T* points,
+  unsigned int first_vid,
+  unsigned int* Vid,
+  unsigned int* Vindex
+  )
+{
+  size_t hash_table_capacity = 16;
+  while (hash_table_capacity < 2*((size_t)Vcount))
+    hash_table_capacity *= 2;
+  const size_t hash_mask = hash_table_capacity - 1;
+  unsigned int* hash_table = (unsigned int*)onmalloc(hash_table_capacity*sizeof(hash_table[0]));
+  memset(hash_table, 0xFF, hash_table_capacity*sizeof(hash_table[0]));
+
+  unsigned int id_count = 0;
+  for (unsigned int i = 0; i < Vcount; i++)
+  {
+    const T* P = points + i*point_stride;
+    ON__UINT64 h = 0;
+    for (size_t k = 0; k < point_dim; k++)
+      h = ON_Internal_MeshWeldMix(h, ON_Internal_PointCoordinateBits(P[k]));
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    for (size_t slot = (size_t)(h & hash_mask); /*empty*/; slot = (slot + 1) & hash_mask)
+    {
+      const unsigned int j = hash_table[slot];
+      if (ON_UNSET_UINT_INDEX == j)
+      {
+        hash_table[slot] = i;
+        Vid[i] = first_vid + id_count++;
+        break;
+      }
+      const T* Q = points + j*point_stride;
+      size_t k = 0;
+      while (k < point_dim && P[k] == Q[k])
+        k++;
+      if (k == point_dim)
+      {
+        Vid[i] = Vid[j];
+        break;
+      }
+    }
+  }
+
+  if (nullptr != Vindex)
+  {
+    // counting sort the point indices by id
+    unsigned int* id_offset = hash_table;
+    memset(id_offset, 0, id_count*sizeof(id_offset[0]));
+    for (unsigned int i = 0; i < Vcount; i++)
+      id_offset[Vid[i] - first_vid]++;
+    unsigned int offset = 0;
+    for (unsigned int id = 0; id < id_count; id++)
+    {
+      const unsigned int n = id_offset[id];
+      id_offset[id] = offset;
+      offset += n;
+    }
+    for (unsigned int i = 0; i < Vcount; i++)
+      Vindex[id_offset[Vid[i] - first_vid]++] = i;
+  }
+
+  onfree(hash_table);
+}
+
+static unsigned int* ON_GetPointLocationIdsHelper(
+  size_t point_dim,
+  size_t point_count,
+  size_t point_stride,
+  const float* fPoints, 
+  const double* dPoints, 
+  unsigned int first_vid, 
+  unsigned int* Vid, 
+  unsigned int* Vindex
+  )
+{
+  // Used here and in opennurbs_plus_xmeshfast.cpp
+
+  if (point_count <= 0 || point_dim < 2 || point_dim > 3 || point_stride < point_dim)
+    return nullptr;
+
+  if (nullptr == fPoints && nullptr == dPoints)
+    return nullptr;
+
+  const unsigned int Vcount = (unsigned int)point_count;
+  if (0 == Vid)
+    Vid = (unsigned int*)onmalloc(Vcount*sizeof(*Vid));
+
+  if (1 == point_count)
+  {
+    Vid[0] = first_vid;
+    if (nullptr != Vindex)
+      Vindex[0] = 0;
+    return Vid;
+  }
+
+  // Coincident points get the same id and the ids are assigned in the
+  // order of the lowest point index in each group. This insures the 
+  // ids do not change when the point set is transformed. The groups
+  // are found with a hash table instead of sorting the points.
+  if (nullptr != dPoints)
+    ON_Internal_GetPointLocationIds(point_dim, Vcount, point_stride, dPoints, first_vid, Vid, Vindex);
+  else
+    ON_Internal_GetPointLocationIds(point_dim, Vcount, point_stride, fPoints, first_vid, Vid, Vindex);
 
   return Vid;
 }
@@ -1967,6 +1967,446 @@ private:
   void* m_alloc(size_t);
 };
 
+/*
+Description:
+  ON_MeshAdjacency is an immutable compressed sparse row (CSR) 
+  description of the vertex-face, vertex-vertex and face-face
+  adjacency of a mesh. Each relation is stored in two contiguous 
+  arrays, an offset array and an index array, and is built from 
+  the face list in a few linear passes.
+Remarks:
+  Face side s runs from face corner s to face corner (s+1)%4.
+  For a triangle, side 2 is degenerate and the third edge is side 3.
+  Faces are "mapped" when all of their corner indices are less than
+  VertexCount(). When bMapDegenerateFaces is false, faces with 
+  repeated corner indices are not mapped.
+*/
+class ON_CLASS ON_MeshAdjacency
+{
+public:
+  ON_MeshAdjacency() = default;
+  ~ON_MeshAdjacency() = default;
+  ON_MeshAdjacency(const ON_MeshAdjacency&) = default;
+  ON_MeshAdjacency& operator=(const ON_MeshAdjacency&) = default;
+
+  /*
+  Parameters:
+    mesh - [in]
+    bMapDegenerateFaces - [in]
+      If true, faces with repeated corner indices are mapped.
+    bNeighbors - [in]
+      If true, the vertex-vertex lists and face side neighbors are
+      calculated. If false, only the vertex-face lists are calculated.
+  Returns:
+    True if successful.
+  */
+  bool SetFromMesh(
+    const ON_Mesh* mesh,
+    bool bMapDegenerateFaces,
+    bool bNeighbors
+    );
+
+  /*
+  Parameters:
+    vertex_count - [in]
+      Number of vertices. If 0 or larger than 0xFFFF0000, the
+      vertex count is one more than the largest vertex index in
+      face_list.
+    face_list - [in]
+    bMapDegenerateFaces - [in]
+    bNeighbors - [in]
+      Same as SetFromMesh().
+  Returns:
+    True if successful.
+  */
+  bool SetFromFaceList(
+    unsigned int vertex_count,
+    const class ON_MeshFaceList& face_list,
+    bool bMapDegenerateFaces,
+    bool bNeighbors
+    );
+
+  void Destroy();
+
+  unsigned int VertexCount() const;
+  unsigned int FaceCount() const;
+
+  /*
+  Returns:
+    True if the vertex-vertex lists and face side neighbors are set.
+  */
+  bool HasNeighbors() const;
+
+  /*
+  Parameters:
+    vertex_index - [in]
+  Returns:
+    Number of mapped faces that reference the vertex.
+  */
+  unsigned int VertexFaceCount(
+    unsigned int vertex_index
+    ) const;
+
+  /*
+  Parameters:
+    vertex_index - [in]
+  Returns:
+    The increasing list of indices of the mapped faces that reference
+    the vertex. A face is listed once even if it references the
+    vertex more than once. The list has length VertexFaceCount(vertex_index)
+    and is null when that count is zero.
+  */
+  const unsigned int* VertexFaceList(
+    unsigned int vertex_index
+    ) const;
+
+  /*
+  Parameters:
+    vertex_index - [in]
+  Returns:
+    Number of vertices that are connected to the vertex by a side
+    of a mapped face.
+  */
+  unsigned int VertexVertexCount(
+    unsigned int vertex_index
+    ) const;
+
+  /*
+  Parameters:
+    vertex_index - [in]
+  Returns:
+    The increasing list of indices of the vertices connected to the 
+    vertex by a side of a mapped face. The list has length 
+    VertexVertexCount(vertex_index) and is null when that count is zero.
+  */
+  const unsigned int* VertexVertexList(
+    unsigned int vertex_index
+    ) const;
+
+  /*
+  Parameters:
+    face_index - [in]
+    face_side - [in]
+      0 to 3
+  Returns:
+    If the side is used by exactly one other mapped face side, 
+    4*(neighbor face index) + (neighbor face side) is returned.
+    Otherwise (boundary, nonmanifold or degenerate side, unmapped face)
+    ON_UNSET_UINT_INDEX is returned.
+  Remarks:
+    The neighbor side can have the same direction as the face side 
+    when the faces are not compatibly oriented.
+  */
+  unsigned int OppositeFaceSide(
+    unsigned int face_index,
+    unsigned int face_side
+    ) const;
+
+  /*
+  Returns:
+    Index of the face returned by OppositeFaceSide() or
+    ON_UNSET_UINT_INDEX.
+  */
+  unsigned int FaceNeighbor(
+    unsigned int face_index,
+    unsigned int face_side
+    ) const;
+
+  /*
+  Description:
+    Expert user functions for direct access to the CSR arrays.
+    The vertex-face list for vertex vi is 
+    VertexFaceIndices()[VertexFaceOffsets()[vi],...,VertexFaceOffsets()[vi+1]-1].
+    The offset arrays have VertexCount()+1 elements. 
+    OppositeFaceSides() has 4*FaceCount() elements.
+  */
+  const unsigned int* VertexFaceOffsets() const;
+  const unsigned int* VertexFaceIndices() const;
+  const unsigned int* VertexVertexOffsets() const;
+  const unsigned int* VertexVertexIndices() const;
+  const unsigned int* OppositeFaceSides() const;
+
+private:
+  unsigned int m_vertex_count = 0;
+  unsigned int m_face_count = 0;
+  ON_SimpleArray<unsigned int> m_vf_offset;
+  ON_SimpleArray<unsigned int> m_vf_index;
+  ON_SimpleArray<unsigned int> m_vv_offset;
+  ON_SimpleArray<unsigned int> m_vv_index;
+  ON_SimpleArray<unsigned int> m_opposite_face_side;
+};
+
+/*
+Description:
+  A point on a mesh face returned by ON_MeshBVH queries.
+  The point is 
+  m_t[0]*V[f.vi[0]] + m_t[1]*V[f.vi[1]] + m_t[2]*V[f.vi[2]] + m_t[3]*V[f.vi[3]],
+  where f = mesh.m_F[m_face_index] and V[] are the mesh vertex locations.
+  At most three of the m_t[] values are not zero.
+*/
+class ON_CLASS ON_MeshFacePoint
+{
+public:
+  ON_MeshFacePoint() = default;
+  ~ON_MeshFacePoint() = default;
+  ON_MeshFacePoint(const ON_MeshFacePoint&) = default;
+  ON_MeshFacePoint& operator=(const ON_MeshFacePoint&) = default;
+
+  /*
+  Returns:
+    True if m_face_index is set.
+  */
+  bool IsSet() const;
+
+  // Index of the face in the mesh m_F[] array or ON_UNSET_UINT_INDEX.
+  unsigned int m_face_index = ON_UNSET_UINT_INDEX;
+
+  // Face corner weights.
+  double m_t[4] = { 0.0, 0.0, 0.0, 0.0 };
+
+  // Location of the point.
+  ON_3dPoint m_P = ON_3dPoint::UnsetPoint;
+
+  // Ray hits: m_P = ray.m_P + m_ray_t*ray.m_V.
+  // Closest point queries: ON_UNSET_VALUE.
+  double m_ray_t = ON_UNSET_VALUE;
+
+  // Closest point queries: distance from the query point to m_P.
+  // Ray hits: ON_UNSET_VALUE.
+  double m_distance = ON_UNSET_VALUE;
+};
+
+/*
+Description:
+  ON_MeshBVH is a bounding volume hierarchy over the faces of a mesh
+  that is used for ray casting, clash detection and closest point 
+  queries. The hierarchy is built with the surface area heuristic and
+  is stored in a few flat arrays, so it is cheap to copy and its 
+  queries do not allocate memory on the heap.
+Remarks:
+  Quads are split into two triangles along the shorter diagonal.
+  The vertex locations are copied when the hierarchy is created.
+  If the mesh is modified, call Create() again.
+  The const query functions may be called from multiple threads.
+*/
+class ON_CLASS ON_MeshBVH
+{
+public:
+  ON_MeshBVH() = default;
+  ~ON_MeshBVH() = default;
+  ON_MeshBVH(const ON_MeshBVH&) = default;
+  ON_MeshBVH& operator=(const ON_MeshBVH&) = default;
+
+  /*
+  Parameters:
+    mesh - [in]
+      Double precision vertices are used when they are valid.
+      Faces that are not valid are ignored.
+  Returns:
+    True if the mesh has at least one valid face.
+  */
+  bool Create(
+    const ON_Mesh* mesh
+    );
+
+  void Destroy();
+
+  /*
+  Returns:
+    Number of triangles in the hierarchy.
+  */
+  unsigned int TriangleCount() const;
+
+  /*
+  Returns:
+    Number of nodes in the hierarchy.
+  */
+  unsigned int NodeCount() const;
+
+  /*
+  Returns:
+    Bounding box of the triangles in the hierarchy.
+  */
+  ON_BoundingBox BoundingBox() const;
+
+  /*
+  Description:
+    Find the first place a ray hits the mesh.
+  Parameters:
+    ray - [in]
+      The ray is ray.m_P + t*ray.m_V with t >= 0.
+    maximum_t - [in]
+      Hits with t > maximum_t are ignored.
+      Pass ON_DBL_MAX to consider every hit.
+    hit - [out]
+  Returns:
+    True if the ray hits the mesh.
+  */
+  bool RayFirstHit(
+    const ON_3dRay& ray,
+    double maximum_t,
+    ON_MeshFacePoint& hit
+    ) const;
+
+  /*
+  Description:
+    Find every place a ray hits the mesh.
+  Parameters:
+    ray - [in]
+    maximum_t - [in]
+    hits - [out]
+      Hits are appended in increasing m_ray_t order. When a ray 
+      passes through the shared diagonal of a quad, the face
+      is reported once.
+  Returns:
+    Number of hits appended to hits[].
+  */
+  unsigned int RayAllHits(
+    const ON_3dRay& ray,
+    double maximum_t,
+    ON_SimpleArray<ON_MeshFacePoint>& hits
+    ) const;
+
+  /*
+  Description:
+    Find the point on the mesh that is closest to P.
+  Parameters:
+    P - [in]
+    maximum_distance - [in]
+      If maximum_distance > 0, points farther than maximum_distance
+      from P are ignored.
+    closest_point - [out]
+  Returns:
+    True if a closest point was found.
+  */
+  bool GetClosestPoint(
+    ON_3dPoint P,
+    double maximum_distance,
+    ON_MeshFacePoint& closest_point
+    ) const;
+
+  /*
+  Description:
+    Get the pairs of faces that clash.
+  Parameters:
+    other - [in]
+      If other is this hierarchy, the mesh is tested for self 
+      intersection and faces that share a vertex location 
+      are not tested against each other.
+    max_pair_count - [in]
+      If max_pair_count > 0, at most this many pairs are appended.
+    clashing_pairs - [out]
+      Pairs (i,j) are appended in increasing order, where i is the 
+      index of a face in this mesh and j is the index of a face in 
+      the other mesh. Self intersection pairs have i < j.
+  Returns:
+    Number of pairs appended to clashing_pairs[].
+  Remarks:
+    Faces that touch clash.
+  */
+  unsigned int GetClashingFacePairs(
+    const ON_MeshBVH& other,
+    unsigned int max_pair_count,
+    ON_SimpleArray<ON_2dex>& clashing_pairs
+    ) const;
+
+  /*
+  Returns:
+    True if a face of this mesh clashes with a face of the other mesh.
+  */
+  bool Clashes(
+    const ON_MeshBVH& other
+    ) const;
+
+  /*
+  Description:
+    Multithreaded version of RayFirstHit().
+  Parameters:
+    thread_count - [in]
+      Maximum number of threads to use. 0 uses every available core.
+    ray_count - [in]
+    rays - [in]
+    maximum_t - [in]
+    hits - [out]
+      An array of ray_count elements. hits[i] is the first hit of 
+      rays[i]. When rays[i] misses, hits[i].m_face_index is 
+      ON_UNSET_UINT_INDEX.
+  Returns:
+    Number of rays that hit the mesh.
+  */
+  unsigned int RayFirstHits(
+    unsigned int thread_count,
+    unsigned int ray_count,
+    const ON_3dRay* rays,
+    double maximum_t,
+    ON_MeshFacePoint* hits
+    ) const;
+
+  /*
+  Description:
+    Multithreaded version of GetClosestPoint().
+  Parameters:
+    thread_count - [in]
+      Maximum number of threads to use. 0 uses every available core.
+    point_count - [in]
+    points - [in]
+    maximum_distance - [in]
+    closest_points - [out]
+      An array of point_count elements. When no closest point is
+      found, closest_points[i].m_face_index is ON_UNSET_UINT_INDEX.
+  Returns:
+    Number of closest points that were found.
+  */
+  unsigned int GetClosestPoints(
+    unsigned int thread_count,
+    unsigned int point_count,
+    const ON_3dPoint* points,
+    double maximum_distance,
+    ON_MeshFacePoint* closest_points
+    ) const;
+
+  /*
+  Description:
+    Find the pairs of meshes in a list that clash.
+  Parameters:
+    thread_count - [in]
+      Maximum number of threads to use. 0 uses every available core.
+    bvh_count - [in]
+    bvh_list - [in]
+      Null elements and empty hierarchies are ignored.
+    clashing_mesh_pairs - [out]
+      Pairs (i,j) of bvh_list[] indices with i < j are appended 
+      in increasing order.
+  Returns:
+    Number of pairs appended to clashing_mesh_pairs[].
+  Remarks:
+    Candidate pairs are found by sweeping the bounding boxes and
+    the candidates are tested in parallel.
+  */
+  static unsigned int GetClashingMeshPairs(
+    unsigned int thread_count,
+    unsigned int bvh_count,
+    const ON_MeshBVH* const* bvh_list,
+    ON_SimpleArray<ON_2dex>& clashing_mesh_pairs
+    );
+
+private:
+  // Node n has bounding box m_node_bbox[6*n,...,6*n+5] = (min,max).
+  // When m_node_index[2*n+1] = 0, the node is interior and its children
+  // are nodes m_node_index[2*n] and m_node_index[2*n]+1. Otherwise the 
+  // node is a leaf with triangles 
+  // m_node_index[2*n],...,m_node_index[2*n]+m_node_index[2*n+1]-1.
+  ON_SimpleArray<double> m_node_bbox;
+  ON_SimpleArray<unsigned int> m_node_index;
+
+  // Triangle t has vertex indices m_tri[4*t],...,m_tri[4*t+2] and 
+  // m_tri[4*t+3] = 4*(face index) + (split), where split identifies
+  // the face corners used by the triangle.
+  ON_SimpleArray<unsigned int> m_tri;
+
+  ON_SimpleArray<ON_3dPoint> m_V;
+};
+
 
 class ON_CLASS ON_MeshNgonBuffer
 {
@@ -3007,8 +3447,9 @@ public:
 private:
   friend class ON_Mesh;
 
-  bool Create();
+  bool Create(unsigned int thread_count);
   void Destroy();
+  void Internal_Destroy(); // Destroy() without waiting for a background calculation
   void EmergencyDestroy();
 
   // efficient workspaces for
@@ -3018,11 +3459,19 @@ private:
   } *m_memchunk;
 
   // NOTE: this field is a bool with valid values of 0 and 1.
-  volatile int m_b32IsValid; // sizeof(m_bIsValid) must be 4 - it is used in sleep locks.
+  volatile int m_b32IsValid; // sizeof(m_bIsValid) must be 4
                     //    0: Not Valid
                     //    1: Valid
-                    //   -1: Sleep locked - ON_Mesh::Topology() calculation is in progress
-  int WaitUntilReady(int sleep_value) const; // waits until m_b32IsValid >= 0
+                    //   -1: ON_Mesh::Topology() calculation is in progress
+  int WaitUntilReady(int sleep_value) const; // waits until m_b32IsValid >= 0 unless sleep_value is 0
+  int Internal_WaitUntilReady(std::unique_lock<std::mutex>& lock) const;
+
+  // m_b32IsValid is read and changed while m_calculation->m_mutex is
+  // locked. The mutex, condition variable and background thread are
+  // on the heap so ON_ObjectArray<ON_Mesh> can move a mesh with
+  // memcpy() when no calculation is in progress.
+  // ABI: this member changes sizeof(ON_MeshTopology) and sizeof(ON_Mesh).
+  class ON_MeshTopologyCalculation* m_calculation = nullptr;
 
 private:
   // no implementation
@@ -4162,6 +4611,24 @@ Returns:
   bool ComputeFaceNormals();   // compute face normals for all faces
   bool ComputeFaceNormal(int); // computes face normal of indexed face
 
+  /*
+  Description:
+    Compute face normals for all faces.
+  Parameters:
+    thread_count - [in]
+      maximum number of threads to use. 0 uses
+      std::thread::hardware_concurrency() and 1 does all the work on the
+      calling thread.
+  Returns:
+    True if successful.
+  Remarks:
+    ComputeFaceNormals() calls ComputeFaceNormals(0).
+    The face normals are the same for every thread_count.
+  */
+  bool ComputeFaceNormals(
+    unsigned int thread_count
+    );
+
   /*
   Description:
     Get a list of pairs of faces that clash.
@@ -4199,9 +4666,13 @@ Returns:
   Returns:
     Number of faces culled from the mesh.
   Remarks:
-    If a large face clashes with many small faces, the large
-    face and one small face will be removed.  When a degenerate
-    face is encountered, it is also culled.
+    Pairs are processed in increasing face index order and a pair
+    is skipped when one of its faces has already been culled.
+    If a large face clashes with many small faces, then 
+    what_to_cull = 0 removes the large face and the first small
+    face, 1 and 3 remove every small face, and 2 and 4 remove 
+    only the large face. When a degenerate face is encountered, 
+    it is also culled.
   */
   int CullClashingFaces( int what_to_cull );
 
@@ -4253,6 +4724,51 @@ Returns:
     );
 
   bool ComputeVertexNormals();    // uses face normals to cook up a vertex normal
+
+  /*
+  Description:
+    ON_Mesh::VertexNormalWeight selects how the normals of the faces
+    around a vertex are combined into a vertex normal.
+  */
+  enum class VertexNormalWeight : unsigned char
+  {
+    // Average of the unit face normals.
+    // This is what ComputeVertexNormals() calculates.
+    Face = 0,
+
+    // Face normals weighted by face area. The area of a nonplanar quad
+    // is half the length of the cross product of its diagonals.
+    Area = 1,
+
+    // Face normals weighted by the angle of the face corner at the vertex.
+    // This is the least sensitive to how the faces are subdivided.
+    Angle = 2
+  };
+
+  /*
+  Description:
+    Compute vertex normals from the face normals.
+  Parameters:
+    weight - [in]
+    thread_count - [in]
+      maximum number of threads to use. 0 uses
+      std::thread::hardware_concurrency() and 1 does all the work on the
+      calling thread.
+  Returns:
+    True if successful.
+  Remarks:
+    If the mesh does not have face normals, they are calculated.
+    Each vertex normal is calculated from the list of faces around the 
+    vertex, so threads never write to the same normal and the normals
+    are the same for every thread_count. Vertices that are not used by 
+    a face or where the weighted face normals cancel get (0,0,1).
+    ComputeVertexNormals() calls 
+    ComputeVertexNormals(ON_Mesh::VertexNormalWeight::Face,0).
+  */
+  bool ComputeVertexNormals(
+    ON_Mesh::VertexNormalWeight weight,
+    unsigned int thread_count
+    );
   
   //////////
   // Scales textures so the texture domains are [0,1] and
@@ -4367,13 +4883,33 @@ Returns:
   bool EvaluateMeshGeometry( const ON_Surface& ); // evaluate surface at tcoords
                                                   // to set mesh geometry
 
-  // finds all coincident vertices and merges them if break angle is small enough
+  /*
+  Description:
+    Combines coincident vertices.
+  Parameters:
+    tolerance - [in]
+      Vertices are coincident when the differences of their x, y and
+      z coordinates are no more than tolerance.x, tolerance.y and
+      tolerance.z.
+    cos_normal_angle - [in]
+      Coincident vertices with normals are combined when
+      NormalA o NormalB >= cos_normal_angle. -1.0 ignores the normals.
+  Returns:
+    True if the mesh is changed, in which case the returned
+    mesh will have fewer vertices than the input mesh.
+  Remarks:
+    Vertices with different texture coordinates, colors or principal
+    curvatures are not combined. Each vertex is combined with the
+    lowest index representative vertex it matches, where a 
+    representative is a vertex that did not match an earlier one.
+    The normals of combined vertices are averaged. Vertices are found
+    with a hash grid whose cells are the size of the tolerance. The
+    grid is filled on several threads, but the search for 
+    representatives is serial.
+  */
   bool CombineCoincidentVertices( 
-          ON_3fVector, // coordinate tols for considering vertices
-                       // to be coincident
-          double  // cosine normal angle tolerance in radians
-                  // if vertices are coincident, then they are combined
-                  // if NormalA o NormalB >= this value
+          ON_3fVector tolerance,
+          double cos_normal_angle
           );
 
   /*
@@ -4388,12 +4924,37 @@ Returns:
   Returns:
     True if the mesh is changed, in which case the returned
     mesh will have fewer vertices than the input mesh.
+  Remarks:
+    Identical vertices are found with a hash table. Large meshes are
+    hashed and remapped on std::thread::hardware_concurrency() threads.
   */
   bool CombineIdenticalVertices(
           bool bIgnoreVertexNormals = false,
           bool bIgnoreTextureCoordinates = false
           );
 
+  /*
+  Description:
+    Combines identical vertices.
+  Parameters:
+    bIgnoreVertexNormals - [in]
+    bIgnoreTextureCoordinates - [in]
+      See CombineIdenticalVertices(bool,bool).
+    thread_count - [in]
+      maximum number of threads to use. 0 uses
+      std::thread::hardware_concurrency() and 1 does all the work on the
+      calling thread.
+  Returns:
+    True if the mesh is changed.
+  Remarks:
+    The combined vertices are in the same order for every thread_count.
+  */
+  bool CombineIdenticalVertices(
+          bool bIgnoreVertexNormals,
+          bool bIgnoreTextureCoordinates,
+          unsigned int thread_count
+          );
+
   unsigned int RemoveAllCreases();
 
   void Append( const ON_Mesh& ); // appends a copy of mesh to this and updates
@@ -4811,6 +5372,27 @@ Returns:
   /* obsolete - used HasMeshTopology() */ bool TopologyExists() const;
   bool HasMeshTopology() const;
 
+  /*
+  Description:
+    Starts calculating the mesh topology on a background thread
+    and returns without waiting for the calculation to finish.
+  Parameters:
+    thread_count - [in]
+      Number of threads the background calculation uses.
+      0 uses std::thread::hardware_concurrency().
+  Returns:
+    True if the topology exists, a background calculation is
+    in progress, or a background calculation was started.
+    False if the mesh has no vertices.
+  Remarks:
+    While the calculation is in progress, HasMeshTopology() returns
+    false without waiting. Topology(), DestroyTopology() and ~ON_Mesh()
+    wait for the calculation to finish. The mesh must not be modified,
+    or moved by an ON_ObjectArray<ON_Mesh> reallocation, until the
+    calculation is finished.
+  */
+  bool CreateTopologyInBackground(unsigned int thread_count) const;
+
   ///////////////////////////////////////////////////////////////////////
   //
   // mesh partitions
@@ -1,4 +1,5 @@
 #include "opennurbs.h"
+#include <algorithm>
 
 #if !defined(ON_COMPILING_OPENNURBS)
 // This check is included in all opennurbs source .c and .cpp files to insure
@@ -2870,7 +2871,7 @@ void ON_MeshVertexFaceMap::Destroy()
   while ( blk )
   {
     next = blk->m_next;
-    delete blk;
+    delete[] blk;
     blk = next;
   }
 }
@@ -3298,6 +3299,301 @@ const unsigned int *const* ON_MeshVertexFaceMap::VertexFaceMap() const
   return m_vertex_face_map;
 }
 
+bool ON_MeshAdjacency::SetFromMesh(
+  const ON_Mesh* mesh,
+  bool bMapDegenerateFaces,
+  bool bNeighbors
+  )
+{
+  ON_MeshFaceList face_list;
+  if ( face_list.SetFromMesh(mesh) > 0 )
+    return SetFromFaceList(mesh->m_V.UnsignedCount(), face_list, bMapDegenerateFaces, bNeighbors);
+
+  // failure
+  Destroy();
+  return false;
+}
+
+bool ON_MeshAdjacency::SetFromFaceList(
+  unsigned int vertex_count,
+  const ON_MeshFaceList& face_list,
+  bool bMapDegenerateFaces,
+  bool bNeighbors
+  )
+{
+  Destroy();
+
+  const unsigned int face_count = face_list.FaceCount();
+  if ( 0 == face_count )
+    return false;
+
+  // Same convention as ON_MeshVertexFaceMap::SetFromFaceList(): a zero or
+  // huge vertex_count means the vertex count is taken from the face list.
+  const unsigned int max_valid_vertex_count = 0xFFFF0000U;
+  if (0 == vertex_count || vertex_count > max_valid_vertex_count)
+  {
+    if ( face_list.GetVertexIndexInterval(0,max_valid_vertex_count-1,0,&vertex_count) < 1 )
+      return false;
+    vertex_count++;
+  }
+
+  // Gets the corners of a face and returns true if the face is mapped.
+  auto GetMappedFace = [&](unsigned int fi, unsigned int Fvi[4]) -> bool
+  {
+    face_list.QuadFvi(fi, Fvi);
+    if ( Fvi[0] >= vertex_count || Fvi[1] >= vertex_count || Fvi[2] >= vertex_count || Fvi[3] >= vertex_count )
+      return false;
+    const bool bRepeated 
+      = Fvi[0] == Fvi[1] || Fvi[1] == Fvi[2] || Fvi[2] == Fvi[0]
+      || (Fvi[2] != Fvi[3] && (Fvi[0] == Fvi[3] || Fvi[1] == Fvi[3]));
+    return (bMapDegenerateFaces || !bRepeated);
+  };
+
+  // count the mapped faces at each vertex
+  m_vf_offset.Reserve(vertex_count + 1);
+  m_vf_offset.SetCount(vertex_count + 1);
+  unsigned int* vf_offset = m_vf_offset.Array();
+  memset(vf_offset, 0, (vertex_count + 1)*sizeof(vf_offset[0]));
+  unsigned int fi, j, k, Fvi[4];
+  for ( fi = 0; fi < face_count; fi++ )
+  {
+    if ( !GetMappedFace(fi, Fvi) )
+      continue;
+    for ( j = 0; j < 4; j++ )
+    {
+      for ( k = 0; k < j && Fvi[k] != Fvi[j]; k++ )
+      {
+        // empty
+      }
+      if ( k == j )
+        vf_offset[Fvi[j] + 1]++;
+    }
+  }
+  for ( j = 0; j < vertex_count; j++ )
+    vf_offset[j + 1] += vf_offset[j];
+
+  // fill in the vertex-face lists in increasing face index order
+  m_vf_index.Reserve(vf_offset[vertex_count]);
+  m_vf_index.SetCount(vf_offset[vertex_count]);
+  unsigned int* vf_index = m_vf_index.Array();
+  for ( fi = 0; fi < face_count; fi++ )
+  {
+    if ( !GetMappedFace(fi, Fvi) )
+      continue;
+    for ( j = 0; j < 4; j++ )
+    {
+      for ( k = 0; k < j && Fvi[k] != Fvi[j]; k++ )
+      {
+        // empty
+      }
+      if ( k == j )
+        vf_index[vf_offset[Fvi[j]]++] = fi;
+    }
+  }
+  // vf_offset[vi] is now the start of the list for vi+1
+  for ( j = vertex_count; j > 0; j-- )
+    vf_offset[j] = vf_offset[j - 1];
+  vf_offset[0] = 0;
+
+  m_vertex_count = vertex_count;
+  m_face_count = face_count;
+
+  if ( false == bNeighbors )
+    return true;
+
+  // vertex-vertex lists
+  {
+    ON_SimpleArray<unsigned int> marker(vertex_count);
+    marker.SetCount(vertex_count);
+    memset(marker.Array(), 0xFF, vertex_count*sizeof(marker[0]));
+    m_vv_offset.Reserve(vertex_count + 1);
+    m_vv_offset.SetCount(vertex_count + 1);
+    m_vv_index.Reserve(m_vf_index.UnsignedCount());
+    m_vv_offset[0] = 0;
+    for ( unsigned int vi = 0; vi < vertex_count; vi++ )
+    {
+      const unsigned int vv0 = m_vv_index.UnsignedCount();
+      for ( unsigned int vfi = vf_offset[vi]; vfi < vf_offset[vi + 1]; vfi++ )
+      {
+        face_list.QuadFvi(vf_index[vfi], Fvi);
+        for ( j = 0; j < 4; j++ )
+        {
+          if ( Fvi[j] != vi )
+            continue;
+          // vertices before and after this corner
+          const unsigned int nbr[2] = { Fvi[(j + 3) % 4], Fvi[(j + 1) % 4] };
+          for ( k = 0; k < 2; k++ )
+          {
+            if ( nbr[k] != vi && marker[nbr[k]] != vi )
+            {
+              marker[nbr[k]] = vi;
+              m_vv_index.Append(nbr[k]);
+            }
+          }
+        }
+      }
+      const unsigned int vv1 = m_vv_index.UnsignedCount();
+      ON_SortUnsignedIntArray(ON::sort_algorithm::quick_sort, m_vv_index.Array() + vv0, vv1 - vv0);
+      m_vv_offset[vi + 1] = vv1;
+    }
+  }
+
+  // Face side neighbors. The edge between vertices a < b is identified
+  // by the position of b in the vertex-vertex list of a. The first two
+  // face sides on each edge are saved and edge_side_count[] counts them.
+  const unsigned int* vv_offset = m_vv_offset.Array();
+  const unsigned int* vv_index = m_vv_index.Array();
+  const unsigned int vv_count = m_vv_index.UnsignedCount();
+  ON_SimpleArray<unsigned char> edge_side_count(vv_count);
+  edge_side_count.SetCount(vv_count);
+  memset(edge_side_count.Array(), 0, vv_count*sizeof(edge_side_count[0]));
+  ON_SimpleArray<unsigned int> edge_sides(2*vv_count);
+  edge_sides.SetCount(2*vv_count);
+
+  m_opposite_face_side.Reserve(4*face_count);
+  m_opposite_face_side.SetCount(4*face_count);
+  unsigned int* opposite = m_opposite_face_side.Array();
+  memset(opposite, 0xFF, 4*face_count*sizeof(opposite[0]));
+
+  unsigned int* face_side_edge = opposite; // temporarily holds the edge of each face side
+  for ( fi = 0; fi < face_count; fi++ )
+  {
+    if ( !GetMappedFace(fi, Fvi) )
+      continue;
+    for ( j = 0; j < 4; j++ )
+    {
+      unsigned int a = Fvi[j];
+      unsigned int b = Fvi[(j + 1) % 4];
+      if ( a == b )
+        continue;
+      if ( a > b )
+      {
+        k = a; a = b; b = k;
+      }
+      const unsigned int* vv = vv_index + vv_offset[a];
+      const unsigned int* e = std::lower_bound(vv, vv_index + vv_offset[a + 1], b);
+      const unsigned int ei = (unsigned int)(e - vv_index);
+      face_side_edge[4*fi + j] = ei;
+      if ( edge_side_count[ei] < 2 )
+        edge_sides[2*ei + edge_side_count[ei]] = 4*fi + j;
+      if ( edge_side_count[ei] < 3 )
+        edge_side_count[ei]++;
+    }
+  }
+
+  // Sides on edges used by exactly two face sides are neighbors.
+  for ( unsigned int s = 0; s < 4*face_count; s++ )
+  {
+    const unsigned int ei = face_side_edge[s];
+    if ( ON_UNSET_UINT_INDEX == ei )
+      continue;
+    face_side_edge[s] 
+      = ( 2 == edge_side_count[ei] )
+      ? edge_sides[2*ei + ((s == edge_sides[2*ei]) ? 1 : 0)]
+      : ON_UNSET_UINT_INDEX;
+  }
+
+  return true;
+}
+
+void ON_MeshAdjacency::Destroy()
+{
+  m_vertex_count = 0;
+  m_face_count = 0;
+  m_vf_offset.Destroy();
+  m_vf_index.Destroy();
+  m_vv_offset.Destroy();
+  m_vv_index.Destroy();
+  m_opposite_face_side.Destroy();
+}
+
+unsigned int ON_MeshAdjacency::VertexCount() const
+{
+  return m_vertex_count;
+}
+
+unsigned int ON_MeshAdjacency::FaceCount() const
+{
+  return m_face_count;
+}
+
+bool ON_MeshAdjacency::HasNeighbors() const
+{
+  return (m_face_count > 0 && m_opposite_face_side.UnsignedCount() == 4*m_face_count);
+}
+
+unsigned int ON_MeshAdjacency::VertexFaceCount(
+  unsigned int vertex_index
+  ) const
+{
+  return (vertex_index < m_vertex_count) ? (m_vf_offset[vertex_index + 1] - m_vf_offset[vertex_index]) : 0;
+}
+
+const unsigned int* ON_MeshAdjacency::VertexFaceList(
+  unsigned int vertex_index
+  ) const
+{
+  return (VertexFaceCount(vertex_index) > 0) ? (m_vf_index.Array() + m_vf_offset[vertex_index]) : nullptr;
+}
+
+unsigned int ON_MeshAdjacency::VertexVertexCount(
+  unsigned int vertex_index
+  ) const
+{
+  return (vertex_index < m_vertex_count && HasNeighbors()) ? (m_vv_offset[vertex_index + 1] - m_vv_offset[vertex_index]) : 0;
+}
+
+const unsigned int* ON_MeshAdjacency::VertexVertexList(
+  unsigned int vertex_index
+  ) const
+{
+  return (VertexVertexCount(vertex_index) > 0) ? (m_vv_index.Array() + m_vv_offset[vertex_index]) : nullptr;
+}
+
+unsigned int ON_MeshAdjacency::OppositeFaceSide(
+  unsigned int face_index,
+  unsigned int face_side
+  ) const
+{
+  return (face_index < m_face_count && face_side < 4 && HasNeighbors())
+    ? m_opposite_face_side[4*face_index + face_side]
+    : ON_UNSET_UINT_INDEX;
+}
+
+unsigned int ON_MeshAdjacency::FaceNeighbor(
+  unsigned int face_index,
+  unsigned int face_side
+  ) const
+{
+  const unsigned int s = OppositeFaceSide(face_index, face_side);
+  return (ON_UNSET_UINT_INDEX != s) ? (s/4) : ON_UNSET_UINT_INDEX;
+}
+
+const unsigned int* ON_MeshAdjacency::VertexFaceOffsets() const
+{
+  return m_vf_offset.Array();
+}
+
+const unsigned int* ON_MeshAdjacency::VertexFaceIndices() const
+{
+  return m_vf_index.Array();
+}
+
+const unsigned int* ON_MeshAdjacency::VertexVertexOffsets() const
+{
+  return m_vv_offset.Array();
+}
+
+const unsigned int* ON_MeshAdjacency::VertexVertexIndices() const
+{
+  return m_vv_index.Array();
+}
+
+const unsigned int* ON_MeshAdjacency::OppositeFaceSides() const
+{
+  return m_opposite_face_side.Array();
+}
+
 static bool FaceInPlane(
   double planar_tolerance,
   ON_PlaneEquation e,
@@ -3468,37 +3764,72 @@ static unsigned int SetFaceNeighborMap(
   unsigned int fdex, nbr_fdex; // indices into the face_index_list[] array
   const unsigned int* face_listA;
   const unsigned int* face_listB;
+  unsigned int face_countA, face_countB;
 
   unsigned int boundary_count = 0;
 
   if ( face_index_count <= 0 || 0 == face_index_list || 0 == face_nbr_map )
     return 0;
 
-  ON_MeshVertexFaceMap vf_tmp;
-  ON_MeshVertexFaceMap* vf_map = &vf_tmp;
-
   const unsigned int* const* localVertexFaceMap = vertex_face_map;
-  if (nullptr == localVertexFaceMap)
+  if (nullptr == localVertexFaceMap && nullptr != vertex_face_map_obj)
   {
-    if (vertex_face_map_obj != nullptr)
+    localVertexFaceMap = vertex_face_map_obj->VertexFaceMap();
+    if (nullptr == localVertexFaceMap)
     {
+      // The caller's map is set so it can be reused.
+      if ( !vertex_face_map_obj->SetFromFaceList(mesh_vertex_count,mesh_face_list,false) )
+        return 0;
       localVertexFaceMap = vertex_face_map_obj->VertexFaceMap();
+      if ( 0 == localVertexFaceMap)
+        return 0;
     }
-  }
-  if (vertex_face_map_obj != nullptr && vertex_face_map == nullptr)
-  {
-    vf_map = vertex_face_map_obj;
+    mesh_vertex_count = vertex_face_map_obj->VertexCount();
   }
 
+  // When no vertex face map is supplied, a CSR vertex-face map is used.
+  ON_MeshAdjacency vf_csr;
   if (nullptr == localVertexFaceMap)
   {
-    if ( !vf_map->SetFromFaceList(mesh_vertex_count,mesh_face_list,false) )
+    const bool bMapDegenerateFaces = true;
+    const bool bNeighbors = false;
+    if ( !vf_csr.SetFromFaceList(mesh_vertex_count,mesh_face_list,bMapDegenerateFaces,bNeighbors) )
       return 0;
-    localVertexFaceMap = vf_map->VertexFaceMap();
-    if ( 0 == localVertexFaceMap)
-      return 0;
-    mesh_vertex_count = vf_map->VertexCount();
+    mesh_vertex_count = vf_csr.VertexCount();
+  }
+
+  auto GetVertexFaceList = [&](unsigned int vi, unsigned int& vf_count) -> const unsigned int*
+  {
+    if (nullptr == localVertexFaceMap)
+    {
+      vf_count = vf_csr.VertexFaceCount(vi);
+      return vf_csr.VertexFaceList(vi);
+    }
+    const unsigned int* vf = ( vi < mesh_vertex_count ) ? localVertexFaceMap[vi] : 0;
+    vf_count = (0 != vf) ? vf[0] : 0;
+    return (vf_count > 0) ? (vf + 1) : 0;
+  };
+
+  // A caller's vertex face map may leave out faces with a repeated
+  // corner or list them twice at a vertex. The faces in face_index_list[]
+  // with a repeated corner are merged into every candidate list and 
+  // repeated candidates are skipped, so every map gives the same
+  // neighbors as the CSR map.
+  ON_SimpleArray<unsigned int> repeated_corner_fi;
+  for ( fdex = 0; fdex < face_index_count; fdex++ )
+  {
+    face_index = face_index_list[fdex];
+    if ( face_index >= mesh_face_count )
+      continue;
+    mesh_face_list.QuadFvi(face_index,Fvi);
+    if ( Fvi[0] >= mesh_vertex_count || Fvi[1] >= mesh_vertex_count || Fvi[2] >= mesh_vertex_count || Fvi[3] >= mesh_vertex_count )
+      continue;
+    if (    Fvi[0] == Fvi[1] || Fvi[1] == Fvi[2] || Fvi[2] == Fvi[0]
+         || (Fvi[2] != Fvi[3] && (Fvi[0] == Fvi[3] || Fvi[1] == Fvi[3])) )
+      repeated_corner_fi.Append(face_index);
   }
+  std::sort(repeated_corner_fi.Array(), repeated_corner_fi.Array() + repeated_corner_fi.Count());
+  const unsigned int repeated_corner_count = repeated_corner_fi.UnsignedCount();
 
   memset(face_nbr_map,0,face_index_count*sizeof(face_nbr_map[0]));
   for ( fdex = 0; fdex < face_index_count; fdex++ )
@@ -3509,9 +3840,7 @@ static unsigned int SetFaceNeighborMap(
 
     mesh_face_list.QuadFvi(face_index,Fvi);
     viB = Fvi[0];
-    face_listB = ( viB <= mesh_vertex_count ) ? localVertexFaceMap[viB] : 0;
-    if ( 0 != face_listB && face_listB[0] <= 1 )
-      face_listB = 0;
+    face_listB = GetVertexFaceList(viB, face_countB);
 
     for ( face_side = 0; face_side < 4; face_side++ )
     {
@@ -3523,16 +3852,8 @@ static unsigned int SetFaceNeighborMap(
       boundary_count++;
 
       face_listA = face_listB;
-      face_listB = ( viB <= mesh_vertex_count ) ? localVertexFaceMap[viB] : 0;
-      if ( 0 == face_listB )
-        continue;
-      if ( face_listB[0] <= 1 )
-      {
-        face_listB = 0;
-        continue;
-      }
-      if ( 0 == face_listA )
-        continue;
+      face_countA = (0 != face_listA) ? face_countB : 0;
+      face_listB = GetVertexFaceList(viB, face_countB);
 
       if ( 0 != face_nbr_map[fdex].m_NFS[face_side] )
       {
@@ -3540,10 +3861,19 @@ static unsigned int SetFaceNeighborMap(
         continue; // already found a neighbor for this side
       }
 
-      // look for a neighbor from viB to viA
-      for ( Adex = 1; Adex <= face_listA[0]; Adex++ )
+      // look for a neighbor from viB to viA in increasing face index order
+      unsigned int Rdex = 0;
+      unsigned int prev_nbr_face_index = ON_UNSET_UINT_INDEX;
+      for ( Adex = 0; /*empty*/; prev_nbr_face_index = nbr_face_index )
       {
-        nbr_face_index = face_listA[Adex];
+        if ( Adex < face_countA && (Rdex >= repeated_corner_count || face_listA[Adex] <= repeated_corner_fi[Rdex]) )
+          nbr_face_index = face_listA[Adex++];
+        else if ( Rdex < repeated_corner_count )
+          nbr_face_index = repeated_corner_fi[Rdex++];
+        else
+          break;
+        if ( prev_nbr_face_index == nbr_face_index )
+          continue;
         if ( face_index == nbr_face_index)
           continue;
         nbr_fdex = FaceListIndex(face_index_count,face_index_list,nbr_face_index);
@@ -3052,7 +3052,7 @@ bool ON_BinaryArchive::Read3dmReferencedComponentIndex(
     }
   }
 
-  const ON_ManifestMapItem& map_item = m_manifest_map.MapItemFromSourceIndex(component_type,archive_component_index);
+  const ON_ManifestMapItem& map_item = ManifestMap().MapItemFromSourceIndex(component_type,archive_component_index);
   if (map_item.SourceAndDestinationAreSet() && ON_UNSET_INT_INDEX != map_item.DestinationIndex())
   {
     updated_component_index = map_item.DestinationIndex();
@@ -3083,7 +3083,7 @@ bool ON_BinaryArchive::Read3dmReferencedComponentIndex(
     case ON_ModelComponent::Type::DimStyle:
       if (nullptr != m_archive_current_dim_style)
       {
-        const ON_ManifestMapItem& archive_current_dim_style_map_item = m_manifest_map.MapItemFromSourceIndex(ON_ModelComponent::Type::DimStyle,m_archive_current_dim_style->Index());
+        const ON_ManifestMapItem& archive_current_dim_style_map_item = ManifestMap().MapItemFromSourceIndex(ON_ModelComponent::Type::DimStyle,m_archive_current_dim_style->Index());
         if (archive_current_dim_style_map_item.SourceAndDestinationAreSet()
           && ON_UNSET_INT_INDEX != archive_current_dim_style_map_item.DestinationIndex()
           )
@@ -3312,8 +3312,10 @@ bool ON_BinaryArchive::Read3dmReferencedComponentId(
   }
   else if ( ON_nil_uuid != id && bConvertToModelId )
   {
+    // A temporary archive reading a copied record has an empty manifest
+    // and the map is the only information about the source components.
     const ON_ComponentManifestItem& item = this->Manifest().ItemFromId(component_type, id);
-    if (component_type == item.ComponentType() && item.Id() == id )
+    if ( (component_type == item.ComponentType() && item.Id() == id) || nullptr != m_source_manifest_map )
     {
       // expected ...
       const ON_ManifestMapItem& map_item = this->ManifestMap().MapItemFromSourceId(id);
@@ -3414,7 +3416,16 @@ const ON_ComponentManifest& ON_BinaryArchive::Manifest() const
 
 const ON_ManifestMap& ON_BinaryArchive::ManifestMap() const
 {
-  return m_manifest_map;
+  return (nullptr != m_source_manifest_map) ? *m_source_manifest_map : m_manifest_map;
+}
+
+void ON_BinaryArchive::Internal_SetSourceManifestMap(
+  const ON_ManifestMap* source_manifest_map
+)
+{
+  m_source_manifest_map = source_manifest_map;
+  SetReferencedComponentIndexMapping(nullptr != source_manifest_map);
+  SetReferencedComponentIdMapping(nullptr != source_manifest_map);
 }
 
 bool ON_BinaryArchive::UpdateManifestMapItemDestination(
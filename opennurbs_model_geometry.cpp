@@ -23,6 +23,77 @@
 
 ON_OBJECT_IMPLEMENT(ON_ModelGeometryComponent,ON_ModelComponent,"29D1B827-41CE-45C1-B265-0686AA391DAE");
 
+class ON_DeferredModelGeometry
+{
+public:
+  ON_DeferredModelGeometry() = default;
+  ~ON_DeferredModelGeometry()
+  {
+    if (nullptr != m_buffer)
+      onfree(m_buffer);
+    delete m_geometry;
+  }
+
+private:
+  ON_DeferredModelGeometry(const ON_DeferredModelGeometry&) = delete;
+  ON_DeferredModelGeometry& operator=(const ON_DeferredModelGeometry&) = delete;
+
+public:
+  ON_Geometry* Geometry()
+  {
+    if (false == m_bRead.load(std::memory_order_acquire))
+    {
+      std::lock_guard<std::mutex> lock(m_lock);
+      if (false == m_bRead.load(std::memory_order_relaxed))
+      {
+        ON_Object* object = ON_BinaryArchive::Read3dmDeferredObjectForExperts(m_3dm_version, m_opennurbs_version, m_manifest_map.get(), m_sizeof_buffer, m_buffer);
+        m_geometry = ON_Geometry::Cast(object);
+        if (nullptr == m_geometry)
+        {
+          ON_ERROR("Unable to read deferred geometry.");
+          delete object;
+        }
+        onfree(m_buffer);
+        m_buffer = nullptr;
+        m_sizeof_buffer = 0;
+        m_manifest_map.reset();
+        m_bRead.store(true, std::memory_order_release);
+      }
+    }
+    return m_geometry;
+  }
+
+  bool GeometryIsRead() const
+  {
+    return m_bRead.load(std::memory_order_acquire);
+  }
+
+  // m_geometry is not changed after m_bRead is set.
+  bool GeometryReadFailed() const
+  {
+    return m_bRead.load(std::memory_order_acquire) && nullptr == m_geometry;
+  }
+
+public:
+  int m_3dm_version = 0;
+  unsigned int m_opennurbs_version = 0;
+  ON__UINT64 m_archive_offset = 0;
+  ON__UINT64 m_sizeof_chunk = 0;
+
+  // m_buffer is the TCODE_OPENNURBS_CLASS chunk. It is freed when the geometry is read.
+  size_t m_sizeof_buffer = 0;
+  void* m_buffer = nullptr;
+
+  // Maps the archive indices and ids the geometry references. Every component
+  // deferred by the same archive read shares the map.
+  std::shared_ptr<const ON_ManifestMap> m_manifest_map;
+
+private:
+  ON_Geometry* m_geometry = nullptr;
+  std::atomic<bool> m_bRead{ false };
+  std::mutex m_lock;
+};
+
 const ON_ModelGeometryComponent* ON_ModelGeometryComponent::FromModelComponentRef(
   const class ON_ModelComponentReference& model_component_reference,
   const ON_ModelGeometryComponent* none_return_value
@@ -42,8 +113,13 @@ bool ON_ModelGeometryComponent::UpdateReferencedComponents(
   for (;;)
   {
     ON_Object* geometry = m_geometry_sp.get();
+    if (nullptr == geometry && nullptr != m_deferred_geometry_sp && m_deferred_geometry_sp->GeometryIsRead())
+      geometry = m_deferred_geometry_sp->Geometry();
     if (nullptr == geometry)
     {
+      // The geometry has not been read. When it is read, the components it
+      // references are mapped with the manifest map saved by
+      // ON_BinaryArchive::Read3dmModelGeometryTableForExperts().
       bGeometryUpdated = true;
       break;
     }
@@ -136,6 +212,7 @@ ON_ModelGeometryComponent::~ON_ModelGeometryComponent()
 ON_ModelGeometryComponent::ON_ModelGeometryComponent(const ON_ModelGeometryComponent& src) 
   : ON_ModelComponent(Internal_ON_ModelGeometry_TypeFilter(src.ComponentType()), src)
   , m_geometry_sp(src.m_geometry_sp)
+  , m_deferred_geometry_sp(src.m_deferred_geometry_sp)
   , m_attributes_sp(src.m_attributes_sp)
 {}
 
@@ -146,6 +223,8 @@ ON_ModelGeometryComponent& ON_ModelGeometryComponent::operator=(const ON_ModelGe
     ON_ModelComponent::operator=(src);
     m_geometry_sp.reset();
     m_geometry_sp = src.m_geometry_sp;
+    m_deferred_geometry_sp.reset();
+    m_deferred_geometry_sp = src.m_deferred_geometry_sp;
     m_attributes_sp.reset();
     m_attributes_sp = src.m_attributes_sp;
     SetComponentType(Internal_ON_ModelGeometry_TypeFilter(src.ComponentType()));
@@ -199,6 +278,7 @@ ON_ModelGeometryComponent* ON_ModelGeometryComponent::CreateForExperts(
     = bManageGeometry
     ? ON_MANAGED_SHARED_PTR(ON_Geometry,geometry)
     : ON_UNMANAGED_SHARED_PTR(ON_Geometry,geometry);
+  model_geometry_component->m_deferred_geometry_sp.reset();
 
 
   model_geometry_component->m_attributes_sp
@@ -213,6 +293,80 @@ ON_ModelGeometryComponent* ON_ModelGeometryComponent::CreateForExperts(
   return model_geometry_component;
 }
 
+ON_ModelGeometryComponent* ON_ModelGeometryComponent::CreateDeferredForExperts(
+  int archive_3dm_version,
+  unsigned int archive_opennurbs_version,
+  ON__UINT64 archive_offset,
+  std::shared_ptr<const ON_ManifestMap> manifest_map,
+  size_t sizeof_object_buffer,
+  const void* object_buffer,
+  bool bManageAttributes,
+  ON_3dmObjectAttributes* attributes,
+  ON_ModelGeometryComponent* model_geometry_component
+  )
+{
+  if (0 == sizeof_object_buffer || nullptr == object_buffer)
+  {
+    ON_ERROR("Invalid object_buffer parameter.");
+    return nullptr;
+  }
+
+  ON_DeferredModelGeometry* deferred_geometry = new ON_DeferredModelGeometry();
+  deferred_geometry->m_buffer = onmalloc(sizeof_object_buffer);
+  if (nullptr == deferred_geometry->m_buffer)
+  {
+    delete deferred_geometry;
+    return nullptr;
+  }
+  memcpy(deferred_geometry->m_buffer, object_buffer, sizeof_object_buffer);
+  deferred_geometry->m_sizeof_buffer = sizeof_object_buffer;
+  deferred_geometry->m_3dm_version = archive_3dm_version;
+  deferred_geometry->m_opennurbs_version = archive_opennurbs_version;
+  deferred_geometry->m_archive_offset = archive_offset;
+  deferred_geometry->m_sizeof_chunk = sizeof_object_buffer;
+  deferred_geometry->m_manifest_map = manifest_map;
+
+  // Lights are not deferred.
+  model_geometry_component = ON_ModelGeometryComponent::CreateForExperts(
+    true, 
+    nullptr, 
+    bManageAttributes, 
+    attributes, 
+    model_geometry_component
+  );
+  model_geometry_component->SetComponentType(ON_ModelComponent::Type::ModelGeometry);
+  model_geometry_component->m_geometry_sp.reset();
+  model_geometry_component->m_deferred_geometry_sp = std::shared_ptr<ON_DeferredModelGeometry>(deferred_geometry);
+  return model_geometry_component;
+}
+
+bool ON_ModelGeometryComponent::GeometryIsDeferred() const
+{
+  return (nullptr == m_geometry_sp.get() && nullptr != m_deferred_geometry_sp && false == m_deferred_geometry_sp->GeometryIsRead());
+}
+
+bool ON_ModelGeometryComponent::DeferredGeometryReadFailed() const
+{
+  return (nullptr == m_geometry_sp.get() && nullptr != m_deferred_geometry_sp && m_deferred_geometry_sp->GeometryReadFailed());
+}
+
+bool ON_ModelGeometryComponent::GetDeferredGeometryArchiveLocation(
+  ON__UINT64& archive_offset,
+  ON__UINT64& sizeof_chunk
+  ) const
+{
+  const ON_DeferredModelGeometry* deferred_geometry = m_deferred_geometry_sp.get();
+  if (nullptr == deferred_geometry)
+  {
+    archive_offset = 0;
+    sizeof_chunk = 0;
+    return false;
+  }
+  archive_offset = deferred_geometry->m_archive_offset;
+  sizeof_chunk = deferred_geometry->m_sizeof_chunk;
+  return true;
+}
+
 ON_ModelGeometryComponent* ON_ModelGeometryComponent::Create(
   const class ON_Object& geometry_object,
   const class ON_3dmObjectAttributes* attributes,
@@ -241,6 +395,7 @@ ON_ModelGeometryComponent* ON_ModelGeometryComponent::CreateManaged(
 ON_ModelGeometryComponent::ON_ModelGeometryComponent( ON_ModelGeometryComponent&& src) ON_NOEXCEPT
   : ON_ModelComponent(std::move(src))
   , m_geometry_sp(std::move(src.m_geometry_sp))
+  , m_deferred_geometry_sp(std::move(src.m_deferred_geometry_sp))
   , m_attributes_sp(std::move(src.m_attributes_sp))
 {}
 
@@ -249,9 +404,11 @@ ON_ModelGeometryComponent& ON_ModelGeometryComponent::operator=(ON_ModelGeometry
   if ( this != &src )
   {
     m_geometry_sp.reset();
+    m_deferred_geometry_sp.reset();
     m_attributes_sp.reset();
     ON_ModelComponent::operator=(std::move(src));
     m_geometry_sp = std::move(src.m_geometry_sp);
+    m_deferred_geometry_sp = std::move(src.m_deferred_geometry_sp);
     m_attributes_sp = std::move(src.m_attributes_sp);
   }
   return *this;
@@ -260,12 +417,15 @@ ON_ModelGeometryComponent& ON_ModelGeometryComponent::operator=(ON_ModelGeometry
 
 bool ON_ModelGeometryComponent::IsEmpty() const
 {
-  return (nullptr == m_geometry_sp.get());
+  if (nullptr != m_geometry_sp.get())
+    return false;
+  // Deferred geometry that could not be read is empty.
+  return (nullptr == m_deferred_geometry_sp.get() || m_deferred_geometry_sp->GeometryReadFailed());
 }
 
 bool ON_ModelGeometryComponent::IsInstanceDefinitionGeometry() const
 {
-  if (nullptr != m_geometry_sp.get())
+  if (false == IsEmpty())
   {
     const ON_3dmObjectAttributes* attributes = m_attributes_sp.get();
     return (nullptr != attributes && attributes->IsInstanceDefinitionObject() );
@@ -279,6 +439,8 @@ const ON_Geometry* ON_ModelGeometryComponent::Geometry(
   ) const
 {
   const ON_Geometry* ptr = m_geometry_sp.get();
+  if (nullptr == ptr && nullptr != m_deferred_geometry_sp)
+    ptr = m_deferred_geometry_sp->Geometry();
   return (nullptr != ptr) ? ptr : no_geometry_return_value;
 }
 
@@ -292,6 +454,13 @@ const ON_3dmObjectAttributes* ON_ModelGeometryComponent::Attributes(
 
 ON_Geometry* ON_ModelGeometryComponent::ExclusiveGeometry() const
 {
+  if (nullptr == m_geometry_sp.get() && nullptr != m_deferred_geometry_sp)
+  {
+    return
+      (1 == m_deferred_geometry_sp.use_count())
+      ? m_deferred_geometry_sp->Geometry()
+      : nullptr;
+  }
   return
     (1 == m_geometry_sp.use_count())
     ? m_geometry_sp.get()
@@ -36,6 +36,14 @@ public:
     const class ON_ManifestMap& manifest_map
     ) override;
   
+  /*
+  Returns:
+    True if there is no geometry. Deferred geometry that has not
+    been read is not empty. Deferred geometry that could not be
+    read is empty.
+  See Also:
+    ON_ModelGeometryComponent::DeferredGeometryReadFailed()
+  */
   bool IsEmpty() const;
 
   bool IsInstanceDefinitionGeometry() const;
@@ -133,6 +141,77 @@ public:
     ON_ModelGeometryComponent* model_geometry_component
     );
 
+  /*
+  Description:
+    Expert user function used by ON_BinaryArchive to create a model geometry
+    component whose geometry is read the first time Geometry() is called.
+  Parameters:
+    archive_3dm_version - [in]
+    archive_opennurbs_version - [in]
+      Version of the archive the geometry was saved in.
+    archive_offset - [in]
+      Offset of the geometry's TCODE_OPENNURBS_CLASS chunk in the archive.
+    manifest_map - [in]
+      A copy of the archive's ManifestMap() made when the object table was
+      read, or nullptr. It is used to map referenced components when the 
+      geometry is read and may be shared by many components.
+    sizeof_object_buffer - [in]
+    object_buffer - [in]
+      The TCODE_OPENNURBS_CLASS chunk. A copy of the buffer is saved.
+    bManageAttributes - [in]
+    attributes - [in]
+      Same as CreateForExperts().
+    model_geometry_component - [in]
+      If not nullptr, this class is set. Otherwise operator new allocates
+      an ON_ModelGeometryComponent class.
+  See Also:
+    ON_BinaryArchive::SetDeferGeometryReading()
+  */
+  static ON_ModelGeometryComponent* CreateDeferredForExperts(
+    int archive_3dm_version,
+    unsigned int archive_opennurbs_version,
+    ON__UINT64 archive_offset,
+    std::shared_ptr<const class ON_ManifestMap> manifest_map,
+    size_t sizeof_object_buffer,
+    const void* object_buffer,
+    bool bManageAttributes,
+    class ON_3dmObjectAttributes* attributes,
+    ON_ModelGeometryComponent* model_geometry_component
+    );
+
+  /*
+  Returns:
+    True if the geometry was saved by ON_BinaryArchive::SetDeferGeometryReading()
+    and has not been read yet. The first call to Geometry() or ExclusiveGeometry()
+    reads the geometry.
+  */
+  bool GeometryIsDeferred() const;
+
+  /*
+  Returns:
+    True if the geometry was saved by ON_BinaryArchive::SetDeferGeometryReading()
+    and reading it failed. In this case Geometry() returns the
+    no_geometry_return_value and IsEmpty() returns true.
+  */
+  bool DeferredGeometryReadFailed() const;
+
+  /*
+  Description:
+    Get the location of deferred geometry in the archive it was read from.
+  Parameters:
+    archive_offset - [out]
+      Offset of the geometry's TCODE_OPENNURBS_CLASS chunk.
+    sizeof_chunk - [out]
+      Size of the chunk in bytes.
+  Returns:
+    True if the geometry was deferred when it was read. The location is
+    available after the geometry is read.
+  */
+  bool GetDeferredGeometryArchiveLocation(
+    ON__UINT64& archive_offset,
+    ON__UINT64& sizeof_chunk
+    ) const;
+
   /*
   Description:
     Get a pointer to geometry. The returned pointer may be shared
@@ -149,6 +228,10 @@ public:
     If the geometry is set and something besides light, then ComponentType() 
     will return ON_ModelComponent::Type::ModelGeometry.
     Otherwise, ComponentType() will return ON_ModelComponent::Type::ModelGeometry::Unset.
+  Remarks:
+    If the geometry is deferred, it is read before Geometry() returns.
+    Deferred geometry is read at most once, even when Geometry() is
+    called from multiple threads.
   See Also:
     ON_ModelGeometryComponent::Attributes()
     ON_ModelGeometryComponent::Geometry()
@@ -235,6 +318,11 @@ private:
   // m_attributes_sp is private and all code that manages m_sp is explicitly implemented in the DLL.
 private:
   std::shared_ptr<ON_Geometry> m_geometry_sp;
+
+private:
+  // m_deferred_geometry_sp is set when reading geometry was deferred.
+  // Copies share the deferred geometry and it is read at most once.
+  std::shared_ptr<class ON_DeferredModelGeometry> m_deferred_geometry_sp;
 private:
   std::shared_ptr<ON_3dmObjectAttributes> m_attributes_sp;
 #pragma ON_PRAGMA_WARNING_POP
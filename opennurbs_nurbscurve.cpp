@@ -723,6 +723,38 @@ bool ON_NurbsCurve::GetBBox( // returns true if successful
                  );
 }
 
+bool ON_NurbsCurve::GetTightBoundingBox( 
+		ON_BoundingBox& tight_bbox, 
+    bool bGrowBox,
+		const ON_Xform* xform
+    ) const
+{
+  if ( bGrowBox && !tight_bbox.IsValid() )
+    bGrowBox = false;
+  if ( !bGrowBox )
+    tight_bbox.Destroy();
+  if ( nullptr != xform && xform->IsIdentity() )
+    xform = nullptr;
+
+  ON_BezierCurveSpans spans;
+  if ( !spans.Create(*this) )
+    return ON_Curve::GetTightBoundingBox(tight_bbox, bGrowBox, xform);
+
+  ON_BoundingBox bbox;
+  ON_BezierCurve B;
+  for ( int span_index = 0; span_index < spans.SpanCount(); span_index++ )
+  {
+    if ( !spans.GetSpanForExperts(span_index, B) )
+      continue;
+    B.GetTightBoundingBox(bbox, true, xform);
+  }
+  if ( !bbox.IsValid() )
+    return bGrowBox;
+
+  tight_bbox.Union(bbox);
+  return true;
+}
+
 bool ON_NurbsCurve::Transform( const ON_Xform& xform )
 {
   if ( !this->ON_Curve::Transform(xform) )
@@ -1572,6 +1604,33 @@ ON_NurbsCurve::Evaluate( // returns false if unable to evaluate
        int* hint       // optional - evaluation hint (int) used to speed
                        //            repeated evaluations
        ) const
+{
+  return Internal_Evaluate(t, der_count, v_stride, v, side, hint, nullptr);
+}
+
+bool 
+ON_NurbsCurve::Evaluate(
+       double t,
+       int der_count,
+       int v_stride,
+       double* v,
+       int side,
+       ON_EvaluationContext& context
+       ) const
+{
+  return Internal_Evaluate(t, der_count, v_stride, v, side, context.CurveHint(), &context);
+}
+
+bool 
+ON_NurbsCurve::Internal_Evaluate(
+       double t,
+       int der_count,
+       int v_stride,
+       double* v,
+       int side,
+       int* hint,
+       ON_EvaluationContext* context
+       ) const
 {
   bool rc = false;
 
@@ -1596,20 +1655,86 @@ ON_NurbsCurve::Evaluate( // returns false if unable to evaluate
     }
   }
 
-  rc = ON_EvaluateNurbsSpan(
-     m_dim, m_is_rat, m_order, 
-     m_knot + span_index, 
-     m_cv_stride, m_cv + (m_cv_stride*span_index),
-     der_count, 
-     t,
-     v_stride, v 
-     );
+  rc = (nullptr != context)
+     ? ON_EvaluateNurbsSpan(
+         m_dim, m_is_rat, m_order, 
+         m_knot + span_index, 
+         m_cv_stride, m_cv + (m_cv_stride*span_index),
+         der_count, 
+         t,
+         v_stride, v,
+         *context
+         )
+     : ON_EvaluateNurbsSpan(
+         m_dim, m_is_rat, m_order, 
+         m_knot + span_index, 
+         m_cv_stride, m_cv + (m_cv_stride*span_index),
+         der_count, 
+         t,
+         v_stride, v 
+         );
   if ( hint ) 
     *hint = span_index;
   return rc;
 }
 
 
+bool 
+ON_NurbsCurve::BatchEvaluate(
+       size_t t_count,
+       const double* t,
+       int der_count,
+       size_t v_stride,
+       double* v,
+       int side
+       ) const
+{
+  if ( -2 == side || 2 == side )
+  {
+    // Parameters may need to be tuned up to the end of a span.
+    // See the comments in ON_NurbsCurve::Evaluate().
+    return ON_Curve::BatchEvaluate(t_count, t, der_count, v_stride, v, side);
+  }
+
+  if ( m_order < 2 || m_dim < 1 || der_count < 0 || nullptr == t || nullptr == v || v_stride < t_count )
+    return false;
+
+  bool rc = true;
+  int span_index = 0;
+  size_t i0 = 0;
+  while ( i0 < t_count )
+  {
+    // t[i0], ..., t[i1-1] are in the same span
+    span_index = ON_NurbsSpanIndex(m_order,m_cv_count,m_knot,t[i0],side,span_index);
+    const double span_t0 = m_knot[span_index+m_order-2];
+    const double span_t1 = m_knot[span_index+m_order-1];
+    size_t i1 = i0+1;
+    for ( /*empty init*/; i1 < t_count; i1++ )
+    {
+      // Parameters inside the span do not need a search.
+      if ( span_t0 < t[i1] && t[i1] < span_t1 )
+        continue;
+      if ( span_index != ON_NurbsSpanIndex(m_order,m_cv_count,m_knot,t[i1],side,span_index) )
+        break;
+    }
+
+    if ( !ON_EvaluateNurbsSpanBatch(
+            m_dim, m_is_rat, m_order, 
+            m_knot + span_index, 
+            m_cv_stride, m_cv + (m_cv_stride*span_index),
+            der_count, 
+            i1-i0, t+i0,
+            v_stride, v+i0
+            ) )
+    {
+      rc = false;
+    }
+    i0 = i1;
+  }
+
+  return rc;
+}
+
 bool 
 ON_NurbsCurve::IsClosed() const
 {
@@ -220,6 +220,17 @@ public:
   // virtual ON_Geometry GetBBox override		
   bool GetBBox( double* boxmin, double* boxmax, bool bGrowBox = false ) const override;
 
+  /*
+  Description:
+    virtual ON_Geometry GetTightBoundingBox override.
+    The extremes of each bezier span are calculated from the zeros
+    of the derivative, so the box is exact up to round off.
+  Remarks:
+    Nothing is cached. Many threads may call this function on the 
+    same curve at the same time.
+  */
+  bool GetTightBoundingBox( class ON_BoundingBox& tight_bbox, bool bGrowBox = false, const class ON_Xform* xform = nullptr ) const override;
+
   // Description:
   //   virtual ON_Geometry::Transform override.
   //   Transforms the NURBS curve.
@@ -549,6 +560,33 @@ public:
                          //            repeated evaluations
          ) const override;
 
+  // Description:
+  //   Same as Evaluate() except the hint and the scratch memory
+  //   come from context, so evaluation does not allocate memory
+  //   once the context's memory is large enough. 
+  //   See ON_EvaluationContext for details.
+  bool Evaluate(
+         double t,
+         int der_count,
+         int v_stride,
+         double* v,
+         int side,
+         class ON_EvaluationContext& context
+         ) const;
+
+  // Description:
+  //   virtual ON_Curve::BatchEvaluate override.
+  //   Consecutive parameters in the same span are evaluated
+  //   with one call to ON_EvaluateNurbsSpanBatch().
+  bool BatchEvaluate(
+         size_t t_count,
+         const double* t,
+         int der_count,
+         size_t v_stride,
+         double* v,
+         int side = 0
+         ) const override;
+
 
   /*
   Parameters:
@@ -1351,6 +1389,16 @@ private:
   void Internal_InitializeToZero();
 private:
   void Internal_Destroy();
+private:
+  bool Internal_Evaluate(
+    double t,
+    int der_count,
+    int v_stride,
+    double* v,
+    int side,
+    int* hint,
+    class ON_EvaluationContext* context
+    ) const;
 };
 
 /* Adjust the second point to be within the domains, when the first point is 
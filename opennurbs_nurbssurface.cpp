@@ -658,6 +658,62 @@ bool ON_NurbsSurface::GetBBox( // returns true if successful
             boxmin, boxmax, bGrowBox?true:false );
 }
 
+bool ON_NurbsSurface::GetTightBoundingBox( 
+		ON_BoundingBox& tight_bbox, 
+    bool bGrowBox,
+		const ON_Xform* xform
+    ) const
+{
+  if ( bGrowBox && !tight_bbox.IsValid() )
+    bGrowBox = false;
+  if ( !bGrowBox )
+    tight_bbox.Destroy();
+  if ( nullptr != xform && xform->IsIdentity() )
+    xform = nullptr;
+
+  ON_BezierSurfacePatches patches;
+  if ( !patches.Create(*this) )
+    return ON_Surface::GetTightBoundingBox(tight_bbox, bGrowBox, xform);
+
+  const int span_count0 = patches.SpanCount(0);
+  const int span_count1 = patches.SpanCount(1);
+  const int patch_cv_count = patches.Order(0)*patches.Order(1);
+
+  // The corners of the surface are on the surface and put most of
+  // the patches inside the box before any work is done.
+  ON_BoundingBox bbox;
+  for ( int c = 0; c < 4; c++ )
+  {
+    const int i = (c & 1) ? (span_count0-1) : 0;
+    const int j = (c & 2) ? (span_count1-1) : 0;
+    const int a = (c & 1) ? (patches.Order(0)-1) : 0;
+    const int b = (c & 2) ? (patches.Order(1)-1) : 0;
+    const double* cv = patches.CV(i,j) + (a*patches.Order(1) + b)*patches.CVSize();
+    ON_GetPointListBoundingBox(m_dim, patches.IsRational(), 1, patches.CVSize(), cv, bbox, bbox.IsValid(), xform);
+  }
+
+  ON_BezierSurface B;
+  for ( int i = 0; i < span_count0; i++ )
+  {
+    for ( int j = 0; j < span_count1; j++ )
+    {
+      ON_BoundingBox hull;
+      if ( !ON_GetPointListBoundingBox(m_dim, patches.IsRational(), patch_cv_count, patches.CVSize(), patches.CV(i,j), hull, false, xform) )
+        continue;
+      if ( bbox.IsValid() && bbox.Includes(hull) )
+        continue;
+      if ( !patches.GetPatchForExperts(i, j, B) )
+        continue;
+      B.GetTightBoundingBox(bbox, true, xform);
+    }
+  }
+  if ( !bbox.IsValid() )
+    return bGrowBox;
+
+  tight_bbox.Union(bbox);
+  return true;
+}
+
 bool ON_NurbsSurface::Transform( const ON_Xform& xform )
 {
   DestroySurfaceTree();
@@ -896,22 +952,65 @@ ON_NurbsSurface::Evaluate( // returns false if unable to evaluate
        int hint[2]       // optional - evaluation hint (int) used to speed
                        //            repeated evaluations
        ) const
+{
+  return Internal_Evaluate(s, t, der_count, v_stride, v, side, hint, nullptr);
+}
+
+bool
+ON_NurbsSurface::Evaluate(
+       double s, 
+       double t,
+       int der_count,
+       int v_stride,
+       double* v,
+       int quadrant,
+       ON_EvaluationContext& context
+       ) const
+{
+  return Internal_Evaluate(s, t, der_count, v_stride, v, quadrant, context.SurfaceHint(), &context);
+}
+
+bool
+ON_NurbsSurface::Internal_Evaluate(
+       double s, 
+       double t,
+       int der_count,
+       int v_stride,
+       double* v,
+       int side,
+       int hint[2],
+       ON_EvaluationContext* context
+       ) const
 {
   bool rc = false;
   int span_index[2];
   span_index[0] = ON_NurbsSpanIndex(m_order[0],m_cv_count[0],m_knot[0],s,(side==2||side==3)?-1:1,(hint)?hint[0]:0);
   span_index[1] = ON_NurbsSpanIndex(m_order[1],m_cv_count[1],m_knot[1],t,(side==3||side==4)?-1:1,(hint)?hint[1]:0);
-  rc = ON_EvaluateNurbsSurfaceSpan(
-     m_dim, m_is_rat, 
-     m_order[0], m_order[1],
-     m_knot[0] + span_index[0], 
-     m_knot[1] + span_index[1],
-     m_cv_stride[0], m_cv_stride[1],
-     m_cv + (span_index[0]*m_cv_stride[0] + span_index[1]*m_cv_stride[1]),
-     der_count, 
-     s, t,
-     v_stride, v 
-     );
+  const double* span_cv = m_cv + (span_index[0]*m_cv_stride[0] + span_index[1]*m_cv_stride[1]);
+  rc = (nullptr != context)
+     ? ON_EvaluateNurbsSurfaceSpan(
+         m_dim, m_is_rat, 
+         m_order[0], m_order[1],
+         m_knot[0] + span_index[0], 
+         m_knot[1] + span_index[1],
+         m_cv_stride[0], m_cv_stride[1],
+         span_cv,
+         der_count, 
+         s, t,
+         v_stride, v,
+         *context
+         )
+     : ON_EvaluateNurbsSurfaceSpan(
+         m_dim, m_is_rat, 
+         m_order[0], m_order[1],
+         m_knot[0] + span_index[0], 
+         m_knot[1] + span_index[1],
+         m_cv_stride[0], m_cv_stride[1],
+         span_cv,
+         der_count, 
+         s, t,
+         v_stride, v 
+         );
   if ( hint ) {
     hint[0] = span_index[0];
     hint[1] = span_index[1];
@@ -919,6 +1018,228 @@ ON_NurbsSurface::Evaluate( // returns false if unable to evaluate
   return rc;
 }
 
+static bool ON_Internal_NurbsSurfaceGridBasis(
+  int order,
+  int cv_count,
+  const double* knot,
+  int der_count,
+  int count,
+  const double* t,
+  int* span_index,
+  double* basis, // count*(der_count+1)*order values
+  double* N      // order*order scratch
+  )
+{
+  int hint = 0;
+  for ( int i = 0; i < count; i++ )
+  {
+    const int span = ON_NurbsSpanIndex( order, cv_count, knot, t[i], 1, hint );
+    if ( span < 0 )
+      return false;
+    hint = span;
+    span_index[i] = span;
+    ON_EvaluateNurbsBasis( order, knot+span, t[i], N );
+    if ( der_count > 0 )
+      ON_EvaluateNurbsBasisDerivatives( order, knot+span, der_count, N );
+    memcpy( basis + i*(der_count+1)*order, N, (der_count+1)*order*sizeof(N[0]) );
+  }
+  return true;
+}
+
+bool ON_NurbsSurface::EvaluateGrid(
+         int s_count,
+         const double* s,
+         int t_count,
+         const double* t,
+         ON_3dPoint* points,
+         ON_3dVector* ds,
+         ON_3dVector* dt,
+         ON_3dVector* normals
+         ) const
+{
+  if ( s_count < 1 || t_count < 1 || nullptr == s || nullptr == t )
+    return false;
+  if (    m_dim < 1 
+       || m_order[0] < 2 || m_order[1] < 2 
+       || m_cv_count[0] < m_order[0] || m_cv_count[1] < m_order[1] 
+       || nullptr == m_knot[0] || nullptr == m_knot[1] || nullptr == m_cv )
+  {
+    return false;
+  }
+
+  const int der_count = (nullptr != ds || nullptr != dt || nullptr != normals) ? 1 : 0;
+  const int order0 = m_order[0];
+  const int order1 = m_order[1];
+
+  // Only the first 3 coordinates (and the weight) are needed.
+  const int pdim = (m_dim < 3) ? m_dim : 3;
+  const int qdim = (m_is_rat) ? pdim+1 : pdim;
+
+  ON_SimpleArray<int> span_index(s_count + t_count);
+  span_index.SetCount(s_count + t_count);
+  int* s_span = span_index.Array();
+  int* t_span = s_span + s_count;
+
+  const int s_basis_count = s_count*(der_count+1)*order0;
+  const int t_basis_count = t_count*(der_count+1)*order1;
+  const int N_count = (order0 > order1) ? order0*order0 : order1*order1;
+  ON_SimpleArray<double> basis(s_basis_count + t_basis_count + N_count);
+  basis.SetCount(s_basis_count + t_basis_count + N_count);
+  double* s_basis = basis.Array();
+  double* t_basis = s_basis + s_basis_count;
+  double* N = t_basis + t_basis_count;
+
+  if ( !ON_Internal_NurbsSurfaceGridBasis( order0, m_cv_count[0], m_knot[0], der_count, s_count, s, s_span, s_basis, N ) )
+    return false;
+  if ( !ON_Internal_NurbsSurfaceGridBasis( order1, m_cv_count[1], m_knot[1], der_count, t_count, t, t_span, t_basis, N ) )
+    return false;
+
+  // Only the columns of the control net used by the t[] spans are contracted.
+  int col0 = t_span[0];
+  int col1 = t_span[0];
+  for ( int j = 1; j < t_count; j++ )
+  {
+    if ( t_span[j] < col0 )
+      col0 = t_span[j];
+    else if ( t_span[j] > col1 )
+      col1 = t_span[j];
+  }
+  const int col_count = col1 - col0 + order1;
+
+  // For each s[i], Q[] holds the control points of the curve 
+  // srf(s[i],t) and Qs[] the control points of the curve Ds(s[i],t).
+  ON_SimpleArray<double> Qbuffer((der_count+1)*col_count*qdim);
+  Qbuffer.SetCount((der_count+1)*col_count*qdim);
+  double* Q = Qbuffer.Array();
+  double* Qs = Q + col_count*qdim;
+
+  bool rc = true;
+  size_t k = 0;
+  for ( int i = 0; i < s_count; i++ )
+  {
+    const double* N0 = s_basis + i*(der_count+1)*order0;
+    const double* cv0 = m_cv + (s_span[i]*m_cv_stride[0] + col0*m_cv_stride[1]);
+    memset( Q, 0, Qbuffer.Count()*sizeof(Q[0]) );
+    for ( int a = 0; a < order0; a++ )
+    {
+      const double* cv = cv0 + a*m_cv_stride[0];
+      const double c = N0[a];
+      double* q = Q;
+      for ( int col = 0; col < col_count; col++, cv += m_cv_stride[1], q += qdim )
+      {
+        for ( int d = 0; d < pdim; d++ )
+          q[d] += c*cv[d];
+        if ( m_is_rat )
+          q[pdim] += c*cv[m_dim];
+      }
+      if ( der_count > 0 )
+      {
+        const double cs = N0[order0+a];
+        cv = cv0 + a*m_cv_stride[0];
+        q = Qs;
+        for ( int col = 0; col < col_count; col++, cv += m_cv_stride[1], q += qdim )
+        {
+          for ( int d = 0; d < pdim; d++ )
+            q[d] += cs*cv[d];
+          if ( m_is_rat )
+            q[pdim] += cs*cv[m_dim];
+        }
+      }
+    }
+
+    for ( int j = 0; j < t_count; j++, k++ )
+    {
+      const double* N1 = t_basis + j*(der_count+1)*order1;
+      const int q0 = (t_span[j] - col0)*qdim;
+      double P[4] = { 0.0, 0.0, 0.0, 0.0 };
+      double Ps[4] = { 0.0, 0.0, 0.0, 0.0 };
+      double Pt[4] = { 0.0, 0.0, 0.0, 0.0 };
+      for ( int b = 0; b < order1; b++ )
+      {
+        const double* q = Q + q0 + b*qdim;
+        const double c = N1[b];
+        for ( int d = 0; d < qdim; d++ )
+          P[d] += c*q[d];
+      }
+      if ( der_count > 0 )
+      {
+        for ( int b = 0; b < order1; b++ )
+        {
+          const double* q = Q + q0 + b*qdim;
+          const double* qs = Qs + q0 + b*qdim;
+          const double c = N1[b];
+          const double ct = N1[order1+b];
+          for ( int d = 0; d < qdim; d++ )
+          {
+            Ps[d] += c*qs[d];
+            Pt[d] += ct*q[d];
+          }
+        }
+      }
+
+      bool bEvaluated = true;
+      if ( m_is_rat )
+      {
+        const double w = P[pdim];
+        if ( 0.0 == w )
+          bEvaluated = false;
+        else
+        {
+          const double w1 = 1.0/w;
+          for ( int d = 0; d < pdim; d++ )
+          {
+            P[d] *= w1;
+            Ps[d] = (Ps[d] - P[d]*Ps[pdim])*w1;
+            Pt[d] = (Pt[d] - P[d]*Pt[pdim])*w1;
+          }
+          P[pdim] = Ps[pdim] = Pt[pdim] = 0.0;
+        }
+      }
+
+      ON_3dPoint point(P[0],P[1],P[2]);
+      ON_3dVector Ds(Ps[0],Ps[1],Ps[2]);
+      ON_3dVector Dt(Pt[0],Pt[1],Pt[2]);
+      ON_3dVector normal = ON_3dVector::ZeroVector;
+      if ( bEvaluated && nullptr != normals )
+      {
+        // same test as ON_Surface::EvNormal() 
+        const double len_ds = Ds.Length();
+        const double len_dt = Dt.Length();
+        if (    len_ds > ON_SQRT_EPSILON*len_dt && len_dt > ON_SQRT_EPSILON*len_ds 
+             && 0 == Ds.IsParallelTo(Dt, 0.01*ON_DEFAULT_ANGLE_TOLERANCE) )
+        {
+          normal = ON_CrossProduct( Ds/len_ds, Dt/len_dt );
+          bEvaluated = normal.Unitize();
+        }
+        else
+        {
+          // singular point - use the general purpose evaluator
+          bEvaluated = EvNormal( s[i], t[j], point, Ds, Dt, normal );
+        }
+      }
+
+      if ( !bEvaluated )
+      {
+        rc = false;
+        point = ON_3dPoint::UnsetPoint;
+        Ds = ON_3dVector::ZeroVector;
+        Dt = ON_3dVector::ZeroVector;
+        normal = ON_3dVector::ZeroVector;
+      }
+      if ( points )
+        points[k] = point;
+      if ( ds )
+        ds[k] = Ds;
+      if ( dt )
+        dt[k] = Dt;
+      if ( normals )
+        normals[k] = normal;
+    }
+  }
+
+  return rc;
+}
+
 
 ON_Curve* ON_NurbsSurface::IsoCurve(
        int dir,          // 0 first parameter varies and second parameter is constant
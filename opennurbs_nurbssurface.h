@@ -259,6 +259,18 @@ public:
   // virtual ON_Geometry GetBBox override		
   bool GetBBox( double* boxmin, double* boxmax, bool bGrowBox = false ) const override;
 
+  /*
+  Description:
+    virtual ON_Geometry GetTightBoundingBox override.
+    Each bezier patch is bounded with 
+    ON_BezierSurface::GetTightBoundingBox(). Patches whose control
+    points are inside the box are skipped.
+  Remarks:
+    Nothing is cached. Many threads may call this function on the 
+    same surface at the same time.
+  */
+  bool GetTightBoundingBox( class ON_BoundingBox& tight_bbox, bool bGrowBox = false, const class ON_Xform* xform = nullptr ) const override;
+
   bool Transform( 
          const ON_Xform&
          ) override;
@@ -483,6 +495,46 @@ public:
                          //            repeated evaluations
          ) const override;
 
+  /*
+  Description:
+    Same as Evaluate() except the hint and the scratch memory
+    come from context, so evaluation does not allocate memory
+    once the context's memory is large enough. 
+    See ON_EvaluationContext for details.
+  */
+  bool Evaluate(
+         double s, 
+         double t,
+         int der_count,
+         int v_stride,
+         double* v,
+         int quadrant,
+         class ON_EvaluationContext& context
+         ) const;
+
+  /*
+  Description:
+    Evaluate the surface at every point of a parameter grid.
+    Overrides virtual ON_Surface::EvaluateGrid.
+  Remarks:
+    The span indices and basis functions are computed once for each
+    s[] value and once for each t[] value. For each s[] value the
+    control net is contracted to the control points of a curve in
+    the second parameter, which is then evaluated at every t[] value.
+  See Also:
+    ON_Surface::EvaluateGrid
+  */
+  bool EvaluateGrid(
+         int s_count,
+         const double* s,
+         int t_count,
+         const double* t,
+         ON_3dPoint* points,
+         ON_3dVector* ds,
+         ON_3dVector* dt,
+         ON_3dVector* normals
+         ) const override;
+
   /*
   Description:
     Get isoparametric curve.
@@ -1176,6 +1228,18 @@ public:
                             //
                             //         [ CV(i)[0], ..., CV(i)[m_dim] ].
                             // 
+
+private:
+  bool Internal_Evaluate(
+    double s,
+    double t,
+    int der_count,
+    int v_stride,
+    double* v,
+    int side,
+    int hint[2],
+    class ON_EvaluationContext* context
+    ) const;
 };
 
 
@@ -1910,6 +1910,8 @@ void ON_Object::DestroyRuntimeCache( bool bDelete )
 
 void ON_Curve::DestroyRuntimeCache( bool bDelete )
 {
+  // Anything cached by serial number, like ON_CurveArcLength, is now stale.
+  ChangeGeometryContentSerialNumberForExperts();
 }
 
 
@@ -1926,6 +1928,9 @@ void ON_CurveProxy::DestroyRuntimeCache( bool bDelete )
 
 void ON_Surface::DestroyRuntimeCache( bool bDelete )
 {
+  // Anything cached by serial number, like ON_TightBoundingBoxCache
+  // boxes, is now stale.
+  ChangeGeometryContentSerialNumberForExperts();
 }
 
 void ON_SurfaceProxy::DestroyRuntimeCache( bool bDelete )
@@ -452,6 +452,8 @@ bool ON_OffsetSurfaceFunction::EvaluateDistance(
     value[vi] = 0;
   }
 
+  // Initialize() saves the solution the first time. See the remarks
+  // in opennurbs_offsetsurface.h about evaluating on more than one thread.
   bool rc = const_cast<ON_OffsetSurfaceFunction*>(this)->Initialize();
 
   if (rc)
@@ -256,9 +256,20 @@ public:
   */
   void Destroy();
 
+  /*
+  Description:
+    Solve for the offset function. The const evaluators call 
+    Initialize() when the offset points or distances have changed 
+    since the last solution, so they modify this class. Call 
+    Initialize() after the last change and before evaluating on
+    more than one thread.
+  Returns:
+    True if the offset function is valid.
+  */
+  bool Initialize();
+
 private:
   friend class ON_OffsetSurface;
-  bool Initialize();
 
   const ON_Surface* m_srf;
 
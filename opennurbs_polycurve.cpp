@@ -106,6 +106,25 @@ void ON_PolyCurve::DestroyRuntimeCache( bool bDelete )
   }
 }
 
+ON__UINT64 ON_PolyCurve::GeometryContentSerialNumber() const
+{
+  // DestroyRuntimeCache() only goes from the polycurve to the segments,
+  // so a segment that is changed by itself has a larger serial number.
+  ON__UINT64 sn = ON_Curve::GeometryContentSerialNumber();
+  const int count = m_segment.Count();
+  for (int i = 0; i < count; i++)
+  {
+    const ON_Curve* segment_curve = m_segment[i];
+    if (nullptr != segment_curve && this != segment_curve)
+    {
+      const ON__UINT64 segment_sn = segment_curve->GeometryContentSerialNumber();
+      if (segment_sn > sn)
+        sn = segment_sn;
+    }
+  }
+  return sn;
+}
+
 unsigned int ON_PolyCurve::SizeOf() const
 {
   unsigned int sz = ON_Curve::SizeOf();
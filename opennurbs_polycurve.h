@@ -54,6 +54,9 @@ public:
   // virtual ON_Object::DestroyRuntimeCache override
   void DestroyRuntimeCache( bool bDelete = true ) override;
 
+  // virtual ON_Curve::GeometryContentSerialNumber override
+  ON__UINT64 GeometryContentSerialNumber() const override;
+
   ON_PolyCurve( int ); // int = initial capacity - use when a good estimate
                         // of the number of segments is known.
 
@@ -543,5 +543,9 @@ public:
   int                    m_dim;  // 2 or 3 (2 so ON_PolylineCurve can be uses as a trimming curve)
 };
 
+#if defined(ON_DLL_TEMPLATE)
+ON_DLL_TEMPLATE template class ON_CLASS ON_SimpleArray<ON_PolylineCurve*>;
+#endif
+
 
 #endif
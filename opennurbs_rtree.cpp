@@ -13,6 +13,8 @@
 
 #include "opennurbs.h"
 
+#include <algorithm>
+
 #if !defined(ON_COMPILING_OPENNURBS)
 // This check is included in all opennurbs source .c and .cpp files to insure
 // ON_COMPILING_OPENNURBS is defined when opennurbs source is compiled.
@@ -21,6 +23,9 @@
 #error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+// ON_Internal_ParallelFor()
+#include "opennurbs_internal_defines.h"
+
 // Dimension of tree bounding boxes
 #define ON_RTree_NODE_DIM 3
 
@@ -529,6 +534,9 @@ bool ON_RTree::CreateMeshFaceTree( const ON_Mesh* mesh )
 
   meshfV = mesh->m_V.Array();
 
+  // The face boxes are collected and the tree is bulk loaded.
+  ON_SimpleArray<ON_RTreeBranch> leaves(fcount);
+
   meshdV = mesh->HasDoublePrecisionVertices() 
          ? mesh->DoublePrecisionVertices().Array() 
          : 0;
@@ -580,11 +588,10 @@ bool ON_RTree::CreateMeshFaceTree( const ON_Mesh* mesh )
           if ( V.z < fmin[2] ) fmin[2] = V.z; else if ( V.z > fmax[2] ) fmax[2] = V.z;  
         }
 
-        if ( !Insert(fmin,fmax,fi) )
-        {
-          RemoveAll();
-          return false;
-        }
+        ON_RTreeBranch& leaf = leaves.AppendNew();
+        memcpy(leaf.m_rect.m_min,fmin,sizeof(leaf.m_rect.m_min));
+        memcpy(leaf.m_rect.m_max,fmax,sizeof(leaf.m_rect.m_max));
+        leaf.m_id = (ON__INT_PTR)fi;
       }
     }
     else
@@ -616,11 +623,10 @@ bool ON_RTree::CreateMeshFaceTree( const ON_Mesh* mesh )
           if ( V.z < fmin[2] ) fmin[2] = V.z; else if ( V.z > fmax[2] ) fmax[2] = V.z;      
         }
 
-        if ( !Insert(fmin,fmax,fi) )
-        {
-          RemoveAll();
-          return false;
-        }
+        ON_RTreeBranch& leaf = leaves.AppendNew();
+        memcpy(leaf.m_rect.m_min,fmin,sizeof(leaf.m_rect.m_min));
+        memcpy(leaf.m_rect.m_max,fmax,sizeof(leaf.m_rect.m_max));
+        leaf.m_id = (ON__INT_PTR)fi;
       }
     }
   }
@@ -653,11 +659,10 @@ bool ON_RTree::CreateMeshFaceTree( const ON_Mesh* mesh )
         if ( V.z < fmin[2] ) fmin[2] = V.z; else if ( V.z > fmax[2] ) fmax[2] = V.z;      
       }
 
-      if ( !Insert(fmin,fmax,fi) )
-      {
-        RemoveAll();
-        return false;
-      }
+      ON_RTreeBranch& leaf = leaves.AppendNew();
+      memcpy(leaf.m_rect.m_min,fmin,sizeof(leaf.m_rect.m_min));
+      memcpy(leaf.m_rect.m_max,fmax,sizeof(leaf.m_rect.m_max));
+      leaf.m_id = (ON__INT_PTR)fi;
     }
   }
   else
@@ -666,7 +671,169 @@ bool ON_RTree::CreateMeshFaceTree( const ON_Mesh* mesh )
     return false;
   }
 
-  return (0 != m_root);
+  return BulkLoad(leaves.Array(), leaves.UnsignedCount());
+}
+
+bool ON_RTree::CreateFromBoxes(
+  size_t count,
+  const ON_BoundingBox* boxes,
+  const ON__INT_PTR* ids
+  )
+{
+  RemoveAll();
+
+  if ( 0 == count || nullptr == boxes )
+    return false;
+
+  ON_SimpleArray<ON_RTreeBranch> leaves;
+  leaves.SetCapacity(count);
+  for ( size_t i = 0; i < count; i++ )
+  {
+    ON_RTreeBranch& leaf = leaves.AppendNew();
+    memcpy(leaf.m_rect.m_min,&boxes[i].m_min.x,sizeof(leaf.m_rect.m_min));
+    memcpy(leaf.m_rect.m_max,&boxes[i].m_max.x,sizeof(leaf.m_rect.m_max));
+    leaf.m_id = (nullptr != ids) ? ids[i] : (ON__INT_PTR)i;
+  }
+
+  return BulkLoad(leaves.Array(), count);
+}
+
+bool ON_RTree::CreateFromLeaves(
+  size_t count,
+  const ON_RTreeLeaf* leaves
+  )
+{
+  RemoveAll();
+
+  if ( 0 == count || nullptr == leaves )
+    return false;
+
+  ON_SimpleArray<ON_RTreeBranch> branches;
+  branches.SetCapacity(count);
+  for ( size_t i = 0; i < count; i++ )
+  {
+    ON_RTreeBranch& branch = branches.AppendNew();
+    branch.m_rect = leaves[i].m_rect;
+    branch.m_id = leaves[i].m_id;
+  }
+
+  return BulkLoad(branches.Array(), count);
+}
+
+static void STRSortHelper(ON_RTreeBranch* a_branch, size_t a_count, int a_axis)
+{
+  // Sort by the box center. The factor of 1/2 does not change the order.
+  std::sort(a_branch, a_branch + a_count,
+    [a_axis](const ON_RTreeBranch& a, const ON_RTreeBranch& b)
+    {
+      return (a.m_rect.m_min[a_axis] + a.m_rect.m_max[a_axis]) < (b.m_rect.m_min[a_axis] + b.m_rect.m_max[a_axis]);
+    }
+  );
+}
+
+static void STRTileHelper(ON_RTreeBranch* a_branch, size_t a_count, size_t node_capacity)
+{
+  // Sort-tile-recursive ordering. When this returns, consecutive runs of
+  // node_capacity branches are spatially compact.
+  const size_t node_count = (a_count + node_capacity - 1) / node_capacity;
+  if ( node_count <= 1 )
+    return;
+
+  // S = number of slabs along each axis = ceil(cube root(node_count))
+  size_t S = (size_t)ceil(pow((double)node_count, 1.0 / 3.0));
+  if ( S < 1 )
+    S = 1;
+  while ( S > 1 && (S - 1) * (S - 1) * (S - 1) >= node_count )
+    S--;
+  while ( S * S * S < node_count )
+    S++;
+
+  // Slab sizes are multiples of the node capacity so node
+  // boundaries never straddle a slab boundary.
+  const size_t x_slab = S * S * node_capacity;
+  const size_t y_slab = S * node_capacity;
+
+  STRSortHelper(a_branch, a_count, 0);
+  for ( size_t i = 0; i < a_count; i += x_slab )
+  {
+    const size_t x_count = (a_count - i < x_slab) ? (a_count - i) : x_slab;
+    STRSortHelper(a_branch + i, x_count, 1);
+    for ( size_t j = 0; j < x_count; j += y_slab )
+    {
+      const size_t y_count = (x_count - j < y_slab) ? (x_count - j) : y_slab;
+      STRSortHelper(a_branch + i + j, y_count, 2);
+    }
+  }
+}
+
+bool ON_RTree::BulkLoad(ON_RTreeBranch* a_branch, size_t a_count)
+{
+  // a_branch[] contains the leaves on input and is used as scratch
+  // space for the branches of each level as the tree is built
+  // from the bottom up.
+  RemoveAll();
+
+  if ( 0 == a_count || nullptr == a_branch )
+    return false;
+
+  for ( size_t i = 0; i < a_count; i++ )
+  {
+    const ON_RTreeBBox& rect = a_branch[i].m_rect;
+    if ( !(rect.m_min[0] <= rect.m_max[0] && rect.m_min[1] <= rect.m_max[1] && rect.m_min[2] <= rect.m_max[2]) )
+    {
+      // invalid bounding box - don't let this corrupt the tree
+      ON_ERROR("ON_RTree::BulkLoad - invalid bounding box.");
+      return false;
+    }
+  }
+
+  const size_t node_capacity = ON_RTree_MAX_NODE_COUNT;
+  const size_t min_node_count = ON_RTree_MIN_NODE_COUNT;
+  size_t level_count = a_count;
+  for ( int level = 0; /*empty test*/; level++ )
+  {
+    STRTileHelper(a_branch, level_count, node_capacity);
+
+    const size_t node_count = (level_count + node_capacity - 1) / node_capacity;
+    size_t bi = 0;
+    for ( size_t ni = 0; ni < node_count; ni++ )
+    {
+      size_t n = level_count - bi;
+      if ( n > node_capacity )
+      {
+        n = node_capacity;
+        // Insure the last node on this level has at least ON_RTree_MIN_NODE_COUNT branches.
+        const size_t tail_count = level_count - bi - n;
+        if ( ni + 2 == node_count && tail_count < min_node_count )
+          n -= (min_node_count - tail_count);
+      }
+
+      ON_RTreeNode* node = m_mem_pool.AllocNode();
+      if ( nullptr == node )
+      {
+        RemoveAll();
+        return false;
+      }
+      node->m_level = level;
+      node->m_count = (int)n;
+      memcpy(node->m_branch, a_branch + bi, n * sizeof(node->m_branch[0]));
+      bi += n;
+
+      // Every node has at least one branch so ni < bi and
+      // a_branch[ni] has already been copied.
+      a_branch[ni].m_rect = NodeCover(node);
+      a_branch[ni].m_child = node;
+    }
+
+    if ( 1 == node_count )
+    {
+      m_root = a_branch[0].m_child;
+      break;
+    }
+    level_count = node_count;
+  }
+
+  return true;
 }
 
 
@@ -2143,6 +2310,125 @@ bool ON_RTree::Search(
   return true;
 }
 
+struct ON_RTreePairSearchTask
+{
+  const ON_RTreeNode* m_nodeA;
+  const ON_RTreeNode* m_nodeB;
+};
+
+static void PairSearchConcurrentHelper(
+  const ON_RTreeNode* a_rootA,
+  const ON_RTreeNode* a_rootB,
+  bool bSingleTree,
+  double tolerance,
+  unsigned int thread_count,
+  ON_SimpleArray<ON_2dex>& a_result
+  )
+{
+  // Split the upper levels of the descent into tasks. Each task is a pair
+  // of branch nodes that PairSearchHelper() or SingleTreeSearchHelper()
+  // would have visited. Splitting stops when there are enough tasks to
+  // balance the work between the threads or a leaf level is reached.
+  const unsigned int task_target = 8*thread_count;
+  ON_SimpleArray<ON_RTreePairSearchTask> tasks;
+  ON_RTreePairSearchTask& root_task = tasks.AppendNew();
+  root_task.m_nodeA = a_rootA;
+  root_task.m_nodeB = a_rootB;
+  while (tasks.UnsignedCount() < task_target)
+  {
+    bool bSplit = false;
+    ON_SimpleArray<ON_RTreePairSearchTask> split_tasks(4*tasks.Count());
+    for (unsigned int ti = 0; ti < tasks.UnsignedCount(); ti++)
+    {
+      const ON_RTreeNode* nodeA = tasks[ti].m_nodeA;
+      const ON_RTreeNode* nodeB = tasks[ti].m_nodeB;
+      if (nodeA->m_level <= 0 || nodeB->m_level <= 0)
+      {
+        split_tasks.Append(tasks[ti]);
+        continue;
+      }
+      bSplit = true;
+      for (int i = 0; i < nodeA->m_count; i++)
+      {
+        for (int j = 0; j < nodeB->m_count; j++)
+        {
+          if (PairSearchOverlapHelper(&nodeA->m_branch[i].m_rect, &nodeB->m_branch[j].m_rect, tolerance))
+          {
+            ON_RTreePairSearchTask& task = split_tasks.AppendNew();
+            task.m_nodeA = nodeA->m_branch[i].m_child;
+            task.m_nodeB = nodeB->m_branch[j].m_child;
+          }
+        }
+      }
+    }
+    tasks = split_tasks;
+    if (false == bSplit)
+      break;
+  }
+
+  // Each task collects pairs in its own buffer.
+  ON_ClassArray< ON_SimpleArray<ON_2dex> > buffers(tasks.Count());
+  buffers.SetCount(tasks.Count());
+  auto search_task = [&](unsigned int ti)
+  {
+    ON_RTreePairSearchResult r;
+    r.m_tolerance = tolerance;
+    r.m_result = &buffers[ti];
+    if (bSingleTree)
+      SingleTreeSearchHelper(tasks[ti].m_nodeA, tasks[ti].m_nodeB, &r);
+    else
+      PairSearchHelper(tasks[ti].m_nodeA, tasks[ti].m_nodeB, &r);
+  };
+  ON_Internal_ParallelFor(thread_count, tasks.UnsignedCount(), search_task);
+
+  // Merge the buffers in task order so the results do not depend on thread scheduling.
+  unsigned int result_count = 0;
+  for (unsigned int i = 0; i < buffers.UnsignedCount(); i++)
+    result_count += buffers[i].UnsignedCount();
+  a_result.Reserve(a_result.UnsignedCount() + result_count);
+  for (unsigned int ti = 0; ti < buffers.UnsignedCount(); ti++)
+  {
+    if (buffers[ti].Count() > 0)
+      a_result.Append(buffers[ti].Count(), buffers[ti].Array());
+  }
+}
+
+bool ON_RTree::Search(
+  const ON_RTree& a_rtreeA,
+  const ON_RTree& a_rtreeB,
+  double tolerance,
+  unsigned int thread_count,
+  ON_SimpleArray<ON_2dex>& a_result
+  )
+{
+  thread_count = ON_Internal_ParallelThreadCount(thread_count);
+  if (thread_count <= 1)
+    return ON_RTree::Search(a_rtreeA, a_rtreeB, tolerance, a_result);
+  if (0 == a_rtreeA.m_root)
+    return false;
+  if (0 == a_rtreeB.m_root)
+    return false;
+  tolerance = (ON_IsValid(tolerance) && tolerance > 0.0) ? tolerance : 0.0;
+  PairSearchConcurrentHelper(a_rtreeA.m_root, a_rtreeB.m_root, false, tolerance, thread_count, a_result);
+  return true;
+}
+
+bool ON_RTree::Search(
+  double tolerance,
+  unsigned int thread_count,
+  ON_SimpleArray<ON_2dex>& a_result
+  ) const
+{
+  thread_count = ON_Internal_ParallelThreadCount(thread_count);
+  if (thread_count <= 1)
+    return Search(tolerance, a_result);
+  if (0 == this->m_root)
+    return false;
+  tolerance = (ON_IsValid(tolerance) && tolerance > 0.0) ? tolerance : 0.0;
+  PairSearchConcurrentHelper(this->m_root, this->m_root, true, tolerance, thread_count, a_result);
+  return true;
+}
+
 static void SingleTreeSearchHelper(const ON_RTreeBranch* a_branchA, const ON_RTreeNode* a_nodeB, ON_RTreePairSearchCallbackResult* a_result)
 {
   // DO NOT ADD ANYTHING TO THIS FUNCTION
@@ -4378,3 +4664,885 @@ bool SearchHelper(const ON_RTreeNode* a_node, const ON_RTreeBBox* a_rect, ON_RTr
   return true; // Continue searching
 }
 
+
+////////////////////////////////////////////////////////////////
+//
+// ON_RTree distance ordered searches
+//
+
+// An entry in the priority queue used by the best first searches.
+// If m_node is not nullptr, the entry is a node. Otherwise the
+// entry is the element m_id.
+struct ON_RTreeQueueEntry
+{
+  double m_d;
+  const ON_RTreeNode* m_node;
+  ON__INT_PTR m_id;
+  bool m_bExact;
+};
+
+static bool QueueEntryGreater(const ON_RTreeQueueEntry& a, const ON_RTreeQueueEntry& b)
+{
+  return a.m_d > b.m_d;
+}
+
+static void QueuePush(ON_SimpleArray<ON_RTreeQueueEntry>& a_queue, double a_d, const ON_RTreeNode* a_node, ON__INT_PTR a_id, bool bExact)
+{
+  ON_RTreeQueueEntry& e = a_queue.AppendNew();
+  e.m_d = a_d;
+  e.m_node = a_node;
+  e.m_id = a_id;
+  e.m_bExact = bExact;
+  std::push_heap(a_queue.Array(), a_queue.Array() + a_queue.Count(), QueueEntryGreater);
+}
+
+static ON_RTreeQueueEntry QueuePop(ON_SimpleArray<ON_RTreeQueueEntry>& a_queue)
+{
+  std::pop_heap(a_queue.Array(), a_queue.Array() + a_queue.Count(), QueueEntryGreater);
+  const ON_RTreeQueueEntry e = *a_queue.Last();
+  a_queue.Remove();
+  return e;
+}
+
+static double PointBoxDistanceHelper(const double a_point[3], const ON_RTreeBBox* a_rect)
+{
+  double d2 = 0.0;
+  for (int j = 0; j < 3; j++)
+  {
+    double d = a_rect->m_min[j] - a_point[j];
+    if (d <= 0.0)
+      d = a_point[j] - a_rect->m_max[j];
+    if (d > 0.0)
+      d2 += d*d;
+  }
+  return sqrt(d2);
+}
+
+bool ON_RTree::SearchNearest(
+  const double a_point[3],
+  unsigned int a_count,
+  double a_maximum_distance,
+  double ON_CALLBACK_CDECL distanceCallback(void* a_context, ON__INT_PTR a_id),
+  void* a_context,
+  ON_SimpleArray<ON_RTreeDistanceResult>& a_result
+  ) const
+{
+  if (0 == m_root || nullptr == a_point || 0 == a_count)
+    return false;
+  if (!(ON_IsValid(a_maximum_distance) && a_maximum_distance >= 0.0))
+    a_maximum_distance = ON_DBL_MAX;
+
+  // Best first search. The queue contains nodes and elements ordered by a
+  // lower bound of their distance. When an element is at the front of the
+  // queue and its distance is exact, nothing in the queue is closer.
+  ON_SimpleArray<ON_RTreeQueueEntry> queue(64);
+  QueuePush(queue, 0.0, m_root, 0, false);
+  unsigned int found_count = 0;
+  while (queue.Count() > 0 && found_count < a_count)
+  {
+    const ON_RTreeQueueEntry e = QueuePop(queue);
+    if (e.m_d > a_maximum_distance)
+      break;
+    if (nullptr != e.m_node)
+    {
+      const ON_RTreeNode* node = e.m_node;
+      for (int i = 0; i < node->m_count; i++)
+      {
+        const double d = PointBoxDistanceHelper(a_point, &node->m_branch[i].m_rect);
+        if (d > a_maximum_distance)
+          continue;
+        if (node->m_level > 0)
+          QueuePush(queue, d, node->m_branch[i].m_child, 0, false);
+        else
+          QueuePush(queue, d, nullptr, node->m_branch[i].m_id, nullptr == distanceCallback);
+      }
+    }
+    else if (e.m_bExact)
+    {
+      ON_RTreeDistanceResult& r = a_result.AppendNew();
+      r.m_id = e.m_id;
+      r.m_distance = e.m_d;
+      found_count++;
+    }
+    else
+    {
+      // The exact distance is computed only when the element's
+      // bounding box is the closest thing in the queue.
+      double d = distanceCallback(a_context, e.m_id);
+      if (ON_IsValid(d) && d >= 0.0 && d <= a_maximum_distance)
+      {
+        if (d < e.m_d)
+          d = e.m_d; // distanceCallback() returned a value < bounding box distance
+        QueuePush(queue, d, nullptr, e.m_id, true);
+      }
+    }
+  }
+
+  return true;
+}
+
+static bool RayBoxHelper(const double a_from[3], const double a_direction[3], const ON_RTreeBBox* a_rect, double a_maximum_parameter, double* t_enter)
+{
+  double t0 = 0.0;
+  double t1 = a_maximum_parameter;
+  for (int j = 0; j < 3; j++)
+  {
+    if (0.0 == a_direction[j])
+    {
+      if (a_from[j] < a_rect->m_min[j] || a_from[j] > a_rect->m_max[j])
+        return false;
+      continue;
+    }
+    double s0 = (a_rect->m_min[j] - a_from[j]) / a_direction[j];
+    double s1 = (a_rect->m_max[j] - a_from[j]) / a_direction[j];
+    if (s0 > s1)
+    {
+      const double s = s0; s0 = s1; s1 = s;
+    }
+    if (s0 > t0)
+      t0 = s0;
+    if (s1 < t1)
+      t1 = s1;
+    if (t0 > t1)
+      return false;
+  }
+  *t_enter = t0;
+  return true;
+}
+
+bool ON_RTree::SearchRay(
+  const double a_from[3],
+  const double a_direction[3],
+  double a_maximum_parameter,
+  bool ON_CALLBACK_CDECL resultCallback(void* a_context, ON__INT_PTR a_id, double t, double* maximum_parameter),
+  void* a_context
+  ) const
+{
+  if (0 == m_root || nullptr == a_from || nullptr == a_direction || nullptr == resultCallback)
+    return false;
+  if (!(ON_IsValid(a_from[0]) && ON_IsValid(a_from[1]) && ON_IsValid(a_from[2])))
+    return false;
+  if (!(ON_IsValid(a_direction[0]) && ON_IsValid(a_direction[1]) && ON_IsValid(a_direction[2])))
+    return false;
+  if (0.0 == a_direction[0] && 0.0 == a_direction[1] && 0.0 == a_direction[2])
+    return false;
+  if (!(a_maximum_parameter >= 0.0))
+    return false;
+
+  // Best first search ordered by the parameter where the ray enters the boxes.
+  double maximum_parameter = a_maximum_parameter;
+  ON_SimpleArray<ON_RTreeQueueEntry> queue(64);
+  QueuePush(queue, 0.0, m_root, 0, false);
+  while (queue.Count() > 0)
+  {
+    const ON_RTreeQueueEntry e = QueuePop(queue);
+    if (e.m_d > maximum_parameter)
+      break; // everything else in the queue is farther
+    if (nullptr != e.m_node)
+    {
+      const ON_RTreeNode* node = e.m_node;
+      for (int i = 0; i < node->m_count; i++)
+      {
+        double t;
+        if (RayBoxHelper(a_from, a_direction, &node->m_branch[i].m_rect, maximum_parameter, &t))
+        {
+          if (node->m_level > 0)
+            QueuePush(queue, t, node->m_branch[i].m_child, 0, false);
+          else
+            QueuePush(queue, t, nullptr, node->m_branch[i].m_id, true);
+        }
+      }
+    }
+    else if (!resultCallback(a_context, e.m_id, e.m_d, &maximum_parameter))
+    {
+      // callback canceled search
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////
+//
+// ON_FrozenRTree
+//
+
+// The child lanes are tested with portable branch-free loops that the
+// compiler vectorizes for the target. The runtime dispatched SSE2/AVX2 
+// kernels in opennurbs_math.cpp work on long point lists; a node has at
+// most ON_FrozenRTree_LANE_COUNT children, too few to pay for a call 
+// through a dispatch pointer at every node visited.
+
+// Maximum depth of the node stack used by the iterative searches.
+// Each node pushes at most ON_FrozenRTree_LANE_COUNT children, and a
+// frozen tree with 2^32 elements has fewer than 12 levels.
+#define ON_FrozenRTree_STACK_CAPACITY 256
+
+static unsigned int FrozenLaneMask(const ON_FrozenRTreeNode& a_node)
+{
+  return (1U << a_node.m_count) - 1U;
+}
+
+static unsigned int FrozenOverlapMask(const ON_FrozenRTreeNode& a_node, const double a_min[3], const double a_max[3])
+{
+  // The loop has no branches so the compiler can evaluate the lanes with SIMD instructions.
+  unsigned int mask = 0;
+  for ( unsigned int k = 0; k < ON_FrozenRTree_LANE_COUNT; k++ )
+  {
+    const bool bOverlap
+      = (a_node.m_min[0][k] <= a_max[0]) & (a_min[0] <= a_node.m_max[0][k])
+      & (a_node.m_min[1][k] <= a_max[1]) & (a_min[1] <= a_node.m_max[1][k])
+      & (a_node.m_min[2][k] <= a_max[2]) & (a_min[2] <= a_node.m_max[2][k]);
+    mask |= ((unsigned int)bOverlap) << k;
+  }
+  return mask & FrozenLaneMask(a_node);
+}
+
+static unsigned int FrozenToleranceMask(const ON_FrozenRTreeNode& a_node, const double a_min[3], const double a_max[3], double tolerance)
+{
+  // Same test as PairSearchOverlapHelper(): the distance between the boxes is <= tolerance.
+  if ( 0.0 == tolerance )
+    return FrozenOverlapMask(a_node, a_min, a_max);
+
+  // The boxes of branch nodes only need a conservative test.
+  const double e_min[3] = { a_min[0] - tolerance, a_min[1] - tolerance, a_min[2] - tolerance };
+  const double e_max[3] = { a_max[0] + tolerance, a_max[1] + tolerance, a_max[2] + tolerance };
+  unsigned int mask = FrozenOverlapMask(a_node, e_min, e_max);
+  if ( 0 == mask || a_node.m_level > 0 )
+    return mask;
+
+  const double tol2 = tolerance*tolerance;
+  for ( unsigned int k = 0; k < a_node.m_count; k++ )
+  {
+    if ( 0 == (mask & (1U << k)) )
+      continue;
+    double d2 = 0.0;
+    for ( unsigned int j = 0; j < 3; j++ )
+    {
+      const double d0 = a_node.m_min[j][k] - a_max[j];
+      const double d1 = a_min[j] - a_node.m_max[j][k];
+      const double d = (d0 > d1) ? d0 : d1;
+      if ( d > tolerance )
+        d2 = ON_DBL_MAX;
+      else if ( d > 0.0 )
+        d2 += d*d;
+    }
+    if ( !(d2 <= tol2) )
+      mask &= ~(1U << k);
+  }
+  return mask;
+}
+
+static void FrozenDistanceSquared(const ON_FrozenRTreeNode& a_node, const double a_point[3], double d2[ON_FrozenRTree_LANE_COUNT])
+{
+  for ( unsigned int k = 0; k < ON_FrozenRTree_LANE_COUNT; k++ )
+  {
+    double s = 0.0;
+    for ( unsigned int j = 0; j < 3; j++ )
+    {
+      const double d0 = a_node.m_min[j][k] - a_point[j];
+      const double d1 = a_point[j] - a_node.m_max[j][k];
+      const double d = (d0 > d1) ? d0 : d1;
+      s += (d > 0.0) ? d*d : 0.0;
+    }
+    d2[k] = s;
+  }
+}
+
+static void FrozenLaneBox(const ON_FrozenRTreeNode& a_node, unsigned int k, double a_min[3], double a_max[3])
+{
+  a_min[0] = a_node.m_min[0][k];
+  a_min[1] = a_node.m_min[1][k];
+  a_min[2] = a_node.m_min[2][k];
+  a_max[0] = a_node.m_max[0][k];
+  a_max[1] = a_node.m_max[1][k];
+  a_max[2] = a_node.m_max[2][k];
+}
+
+static void FrozenNodeCover(const ON_FrozenRTreeNode& a_node, double a_min[3], double a_max[3])
+{
+  FrozenLaneBox(a_node, 0, a_min, a_max);
+  for ( unsigned int k = 1; k < a_node.m_count; k++ )
+  {
+    for ( int j = 0; j < 3; j++ )
+    {
+      if ( a_node.m_min[j][k] < a_min[j] )
+        a_min[j] = a_node.m_min[j][k];
+      if ( a_node.m_max[j][k] > a_max[j] )
+        a_max[j] = a_node.m_max[j][k];
+    }
+  }
+}
+
+bool ON_FrozenRTree::Create(
+  const ON_RTree& rtree
+  )
+{
+  RemoveAll();
+
+  ON_SimpleArray<ON_RTreeBranch> branches;
+  ON_RTreeIterator rit(rtree);
+  for ( const ON_RTreeBranch* leaf = rit.First() ? rit.Value() : nullptr; nullptr != leaf; leaf = rit.Next() ? rit.Value() : nullptr )
+    branches.Append(*leaf);
+
+  return Internal_Create(branches.Array(), branches.UnsignedCount());
+}
+
+bool ON_FrozenRTree::Create(
+  size_t count,
+  const ON_BoundingBox* boxes,
+  const ON__INT_PTR* ids
+  )
+{
+  RemoveAll();
+
+  if ( 0 == count || nullptr == boxes )
+    return false;
+
+  ON_SimpleArray<ON_RTreeBranch> branches;
+  branches.SetCapacity(count);
+  for ( size_t i = 0; i < count; i++ )
+  {
+    ON_RTreeBranch& branch = branches.AppendNew();
+    memcpy(branch.m_rect.m_min,&boxes[i].m_min.x,sizeof(branch.m_rect.m_min));
+    memcpy(branch.m_rect.m_max,&boxes[i].m_max.x,sizeof(branch.m_rect.m_max));
+    branch.m_id = (nullptr != ids) ? ids[i] : (ON__INT_PTR)i;
+  }
+
+  return Internal_Create(branches.Array(), count);
+}
+
+bool ON_FrozenRTree::Create(
+  size_t count,
+  const ON_RTreeLeaf* leaves
+  )
+{
+  RemoveAll();
+
+  if ( 0 == count || nullptr == leaves )
+    return false;
+
+  ON_SimpleArray<ON_RTreeBranch> branches;
+  branches.SetCapacity(count);
+  for ( size_t i = 0; i < count; i++ )
+  {
+    ON_RTreeBranch& branch = branches.AppendNew();
+    branch.m_rect = leaves[i].m_rect;
+    branch.m_id = leaves[i].m_id;
+  }
+
+  return Internal_Create(branches.Array(), count);
+}
+
+bool ON_FrozenRTree::Internal_Create(ON_RTreeBranch* a_branch, size_t a_count)
+{
+  // a_branch[] contains the leaves on input and is used as scratch space.
+  // The tree is built from the bottom up. level[L] holds the nodes with
+  // m_level = L. At each level the STR tiling determines the final order
+  // of the nodes on the level below, so the children of every node are
+  // consecutive and the levels can be concatenated in breadth first order.
+  RemoveAll();
+
+  if ( 0 == a_count || nullptr == a_branch )
+    return false;
+
+  if ( a_count > 0xFFFFFFFFU )
+  {
+    ON_ERROR("ON_FrozenRTree::Create - too many elements.");
+    return false;
+  }
+
+  for ( size_t i = 0; i < a_count; i++ )
+  {
+    const ON_RTreeBBox& rect = a_branch[i].m_rect;
+    if ( !(rect.m_min[0] <= rect.m_max[0] && rect.m_min[1] <= rect.m_max[1] && rect.m_min[2] <= rect.m_max[2]) )
+    {
+      ON_ERROR("ON_FrozenRTree::Create - invalid bounding box.");
+      return false;
+    }
+  }
+
+  const size_t node_capacity = ON_FrozenRTree_LANE_COUNT;
+  ON_ClassArray< ON_SimpleArray<ON_FrozenRTreeNode> > level;
+  size_t item_count = a_count;
+  for ( int level_index = 0; /*empty test*/; level_index++ )
+  {
+    STRTileHelper(a_branch, item_count, node_capacity);
+
+    if ( level_index > 0 )
+    {
+      // a_branch[i].m_id = index of a node on the level below before it was tiled.
+      const ON_SimpleArray<ON_FrozenRTreeNode>& unsorted = level[level_index-1];
+      ON_SimpleArray<ON_FrozenRTreeNode> sorted(unsorted.Count());
+      for ( size_t i = 0; i < item_count; i++ )
+        sorted.Append(unsorted[(int)a_branch[i].m_id]);
+      level[level_index-1] = sorted;
+    }
+
+    const size_t node_count = (item_count + node_capacity - 1) / node_capacity;
+    ON_SimpleArray<ON_FrozenRTreeNode>& nodes = level.AppendNew();
+    nodes.SetCapacity(node_count);
+    size_t bi = 0;
+    for ( size_t ni = 0; ni < node_count; ni++ )
+    {
+      const size_t n = (item_count - bi < node_capacity) ? (item_count - bi) : node_capacity;
+      ON_FrozenRTreeNode& node = nodes.AppendNew();
+      node.m_first = (unsigned int)bi;
+      node.m_count = (unsigned int)n;
+      node.m_level = level_index;
+
+      ON_RTreeBBox cover = a_branch[bi].m_rect;
+      for ( unsigned int k = 0; k < ON_FrozenRTree_LANE_COUNT; k++ )
+      {
+        if ( k < n )
+        {
+          const ON_RTreeBranch& branch = a_branch[bi+k];
+          for ( int j = 0; j < 3; j++ )
+          {
+            node.m_min[j][k] = branch.m_rect.m_min[j];
+            node.m_max[j][k] = branch.m_rect.m_max[j];
+            if ( branch.m_rect.m_min[j] < cover.m_min[j] )
+              cover.m_min[j] = branch.m_rect.m_min[j];
+            if ( branch.m_rect.m_max[j] > cover.m_max[j] )
+              cover.m_max[j] = branch.m_rect.m_max[j];
+          }
+          node.m_id[k] = (0 == level_index) ? branch.m_id : 0;
+        }
+        else
+        {
+          // unused lane - an empty box
+          for ( int j = 0; j < 3; j++ )
+          {
+            node.m_min[j][k] = ON_DBL_MAX;
+            node.m_max[j][k] = -ON_DBL_MAX;
+          }
+          node.m_id[k] = 0;
+        }
+      }
+      bi += n;
+
+      // ni < bi so a_branch[ni] has already been copied.
+      a_branch[ni].m_rect = cover;
+      a_branch[ni].m_id = (ON__INT_PTR)ni;
+    }
+
+    if ( 1 == node_count )
+      break;
+    item_count = node_count;
+  }
+
+  // concatenate the levels in breadth first order, root first
+  unsigned int node_count = 0;
+  for ( int i = 0; i < level.Count(); i++ )
+    node_count += level[i].UnsignedCount();
+  m_nodes.SetCapacity(node_count);
+  for ( int level_index = level.Count() - 1; level_index >= 0; level_index-- )
+  {
+    // index of the first node on the level below
+    const unsigned int child_offset = m_nodes.UnsignedCount() + level[level_index].UnsignedCount();
+    for ( unsigned int i = 0; i < level[level_index].UnsignedCount(); i++ )
+    {
+      ON_FrozenRTreeNode& node = m_nodes.AppendNew();
+      node = level[level_index][i];
+      if ( node.m_level > 0 )
+        node.m_first += child_offset;
+    }
+  }
+  m_element_count = (unsigned int)a_count;
+
+  return true;
+}
+
+void ON_FrozenRTree::RemoveAll()
+{
+  m_nodes.Destroy();
+  m_element_count = 0;
+}
+
+template <class RESULT> static bool FrozenSearchHelper(
+  const ON_FrozenRTreeNode* a_nodes,
+  const double a_min[3],
+  const double a_max[3],
+  RESULT& a_result
+  )
+{
+  unsigned int stack[ON_FrozenRTree_STACK_CAPACITY];
+  unsigned int stack_count = 0;
+  stack[stack_count++] = 0;
+  while ( stack_count > 0 )
+  {
+    const ON_FrozenRTreeNode& node = a_nodes[stack[--stack_count]];
+    const unsigned int mask = FrozenOverlapMask(node, a_min, a_max);
+    if ( 0 == mask )
+      continue;
+    if ( node.m_level > 0 )
+    {
+      // push in reverse order so the children are visited in order
+      for ( unsigned int k = node.m_count; k-- > 0; /*empty iterator*/ )
+      {
+        if ( 0 != (mask & (1U << k)) )
+          stack[stack_count++] = node.m_first + k;
+      }
+    }
+    else
+    {
+      for ( unsigned int k = 0; k < node.m_count; k++ )
+      {
+        if ( 0 != (mask & (1U << k)) && !a_result(node.m_id[k]) )
+          return false; // callback canceled search
+      }
+    }
+  }
+  return true;
+}
+
+bool ON_FrozenRTree::Search(const double a_min[3], const double a_max[3],
+  bool ON_CALLBACK_CDECL resultCallback(void* a_context, ON__INT_PTR a_id), void* a_context
+  ) const
+{
+  if ( 0 == m_nodes.Count() || nullptr == a_min || nullptr == a_max || nullptr == resultCallback )
+    return false;
+  auto result = [resultCallback, a_context](ON__INT_PTR id) { return resultCallback(a_context, id); };
+  return FrozenSearchHelper(m_nodes.Array(), a_min, a_max, result);
+}
+
+bool ON_FrozenRTree::Search(const double a_min[3], const double a_max[3],
+  ON_SimpleArray<int>& a_result
+  ) const
+{
+  if ( 0 == m_nodes.Count() || nullptr == a_min || nullptr == a_max )
+    return false;
+  auto result = [&a_result](ON__INT_PTR id) { a_result.Append((int)id); return true; };
+  return FrozenSearchHelper(m_nodes.Array(), a_min, a_max, result);
+}
+
+bool ON_FrozenRTree::Search(const double a_min[3], const double a_max[3],
+  ON_SimpleArray<void*>& a_result
+  ) const
+{
+  if ( 0 == m_nodes.Count() || nullptr == a_min || nullptr == a_max )
+    return false;
+  auto result = [&a_result](ON__INT_PTR id) { a_result.Append((void*)id); return true; };
+  return FrozenSearchHelper(m_nodes.Array(), a_min, a_max, result);
+}
+
+static bool FrozenSphereSearchHelper(
+  const ON_FrozenRTreeNode* a_nodes,
+  unsigned int a_node_index,
+  ON_RTreeSphere* a_sphere,
+  ON_RTreeSearchResultCallback& a_result
+  )
+{
+  const ON_FrozenRTreeNode& node = a_nodes[a_node_index];
+  double d2[ON_FrozenRTree_LANE_COUNT];
+  FrozenDistanceSquared(node, a_sphere->m_point, d2);
+
+  // Sort the children that intersect the sphere by distance so closer
+  // children are searched first. In calculations where the calls to
+  // a_result.m_resultCallback() reduce a_sphere->m_radius, this prunes
+  // most of the remaining children.
+  unsigned int order[ON_FrozenRTree_LANE_COUNT];
+  unsigned int order_count = 0;
+  const double r2 = a_sphere->m_radius*a_sphere->m_radius;
+  for ( unsigned int k = 0; k < node.m_count; k++ )
+  {
+    if ( !(d2[k] <= r2) )
+      continue;
+    unsigned int i = order_count++;
+    for ( /*empty init*/; i > 0 && d2[order[i-1]] > d2[k]; i-- )
+      order[i] = order[i-1];
+    order[i] = k;
+  }
+
+  for ( unsigned int i = 0; i < order_count; i++ )
+  {
+    const unsigned int k = order[i];
+    // Note that the calls below can reduce the value of a_sphere->m_radius.
+    if ( d2[k] > a_sphere->m_radius*a_sphere->m_radius )
+      break;
+    if ( node.m_level > 0 )
+    {
+      if ( !FrozenSphereSearchHelper(a_nodes, node.m_first + k, a_sphere, a_result) )
+        return false;
+    }
+    else if ( !a_result.m_resultCallback(a_result.m_context, node.m_id[k]) )
+    {
+      // callback canceled search
+      return false;
+    }
+  }
+
+  return true; // Continue searching
+}
+
+bool ON_FrozenRTree::Search(
+  ON_RTreeSphere* a_sphere,
+  bool ON_CALLBACK_CDECL a_resultCallback(void* a_context, ON__INT_PTR a_id),
+  void* a_context
+  ) const
+{
+  if ( 0 == m_nodes.Count() || nullptr == a_sphere || nullptr == a_resultCallback )
+    return false;
+
+  ON_RTreeSearchResultCallback result;
+  result.m_context = a_context;
+  result.m_resultCallback = a_resultCallback;
+
+  return FrozenSphereSearchHelper(m_nodes.Array(), 0, a_sphere, result);
+}
+
+struct ON_FrozenRTreePairSearchResult
+{
+  double m_tolerance;
+  ON_SimpleArray<ON_2dex>* m_result;
+  ON_RTreePairSearchCallbackBool m_resultCallbackBool;
+  void* m_context;
+
+  bool Report(ON__INT_PTR a_idA, ON__INT_PTR a_idB)
+  {
+    if ( nullptr != m_result )
+    {
+      ON_2dex& r = m_result->AppendNew();
+      r.i = (int)a_idA;
+      r.j = (int)a_idB;
+      return true;
+    }
+    return m_resultCallbackBool(m_context, a_idA, a_idB);
+  }
+};
+
+static bool FrozenPairSearchHelper(
+  const ON_FrozenRTreeNode* a_nodes,
+  unsigned int a_node_index,
+  const double a_min[3],
+  const double a_max[3],
+  ON__INT_PTR a_id,
+  bool bSwap,
+  ON_FrozenRTreePairSearchResult* a_result
+  )
+{
+  // a_node vs a leaf element (a_min,a_max,a_id) from the other tree
+  const ON_FrozenRTreeNode& node = a_nodes[a_node_index];
+  const unsigned int mask = FrozenToleranceMask(node, a_min, a_max, a_result->m_tolerance);
+  for ( unsigned int k = 0; k < node.m_count; k++ )
+  {
+    if ( 0 == (mask & (1U << k)) )
+      continue;
+    if ( node.m_level > 0 )
+    {
+      if ( !FrozenPairSearchHelper(a_nodes, node.m_first + k, a_min, a_max, a_id, bSwap, a_result) )
+        return false;
+    }
+    else if ( !(bSwap ? a_result->Report(a_id, node.m_id[k]) : a_result->Report(node.m_id[k], a_id)) )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool FrozenPairSearchHelper(
+  const ON_FrozenRTreeNode* a_nodesA,
+  unsigned int a_node_indexA,
+  const ON_FrozenRTreeNode* a_nodesB,
+  unsigned int a_node_indexB,
+  const double a_coverB_min[3],
+  const double a_coverB_max[3],
+  ON_FrozenRTreePairSearchResult* a_result
+  )
+{
+  // (a_coverB_min,a_coverB_max) is the bounding box of nodeB. Only the
+  // children of nodeA that are near nodeB need to be tested.
+  const ON_FrozenRTreeNode& nodeA = a_nodesA[a_node_indexA];
+  const ON_FrozenRTreeNode& nodeB = a_nodesB[a_node_indexB];
+  const unsigned int maskA = FrozenToleranceMask(nodeA, a_coverB_min, a_coverB_max, a_result->m_tolerance);
+  double a_min[3], a_max[3], b_min[3], b_max[3];
+  for ( unsigned int i = 0; 0 != (maskA >> i); i++ )
+  {
+    if ( 0 == (maskA & (1U << i)) )
+      continue;
+    FrozenLaneBox(nodeA, i, a_min, a_max);
+    const unsigned int mask = FrozenToleranceMask(nodeB, a_min, a_max, a_result->m_tolerance);
+    if ( 0 == mask )
+      continue;
+    for ( unsigned int j = 0; j < nodeB.m_count; j++ )
+    {
+      if ( 0 == (mask & (1U << j)) )
+        continue;
+      bool rc;
+      if ( nodeA.m_level > 0 )
+      {
+        FrozenLaneBox(nodeB, j, b_min, b_max);
+        if ( nodeB.m_level > 0 )
+          rc = FrozenPairSearchHelper(a_nodesA, nodeA.m_first + i, a_nodesB, nodeB.m_first + j, b_min, b_max, a_result);
+        else
+          rc = FrozenPairSearchHelper(a_nodesA, nodeA.m_first + i, b_min, b_max, nodeB.m_id[j], false, a_result);
+      }
+      else if ( nodeB.m_level > 0 )
+        rc = FrozenPairSearchHelper(a_nodesB, nodeB.m_first + j, a_min, a_max, nodeA.m_id[i], true, a_result);
+      else
+        rc = a_result->Report(nodeA.m_id[i], nodeB.m_id[j]);
+      if ( !rc )
+        return false;
+    }
+  }
+  return true;
+}
+
+static bool FrozenSingleTreeSearchHelper(
+  const ON_FrozenRTreeNode* a_nodes,
+  unsigned int a_node_indexA,
+  unsigned int a_node_indexB,
+  const double a_coverB_min[3],
+  const double a_coverB_max[3],
+  ON_FrozenRTreePairSearchResult* a_result
+  )
+{
+  // All leaves are on level 0, so nodeA and nodeB are on the same level.
+  // a_node_indexA <= a_node_indexB and the children of nodes are
+  // consecutive, so testing lane pairs (i,j) with j >= i when
+  // nodeA = nodeB visits every pair of distinct elements once.
+  const ON_FrozenRTreeNode& nodeA = a_nodes[a_node_indexA];
+  const ON_FrozenRTreeNode& nodeB = a_nodes[a_node_indexB];
+  const bool bSameNode = (a_node_indexA == a_node_indexB);
+  const unsigned int maskA = FrozenToleranceMask(nodeA, a_coverB_min, a_coverB_max, a_result->m_tolerance);
+  double a_min[3], a_max[3], b_min[3], b_max[3];
+  for ( unsigned int i = 0; 0 != (maskA >> i); i++ )
+  {
+    if ( 0 == (maskA & (1U << i)) )
+      continue;
+    FrozenLaneBox(nodeA, i, a_min, a_max);
+    unsigned int mask = FrozenToleranceMask(nodeB, a_min, a_max, a_result->m_tolerance);
+    if ( bSameNode )
+    {
+      // Don't test pairs twice and don't test an element against itself.
+      mask &= (nodeA.m_level > 0) ? ~((1U << i) - 1U) : ~((2U << i) - 1U);
+    }
+    for ( unsigned int j = 0; 0 != mask && j < nodeB.m_count; j++ )
+    {
+      if ( 0 == (mask & (1U << j)) )
+        continue;
+      bool rc;
+      if ( nodeA.m_level > 0 )
+      {
+        FrozenLaneBox(nodeB, j, b_min, b_max);
+        rc = FrozenSingleTreeSearchHelper(a_nodes, nodeA.m_first + i, nodeB.m_first + j, b_min, b_max, a_result);
+      }
+      else
+        rc = a_result->Report(nodeA.m_id[i], nodeB.m_id[j]);
+      if ( !rc )
+        return false;
+    }
+  }
+  return true;
+}
+
+bool ON_FrozenRTree::Search(
+  const ON_FrozenRTree& a_rtreeA,
+  const ON_FrozenRTree& a_rtreeB,
+  double tolerance,
+  ON_SimpleArray<ON_2dex>& a_result
+  )
+{
+  if ( 0 == a_rtreeA.m_nodes.Count() || 0 == a_rtreeB.m_nodes.Count() )
+    return false;
+  ON_FrozenRTreePairSearchResult r;
+  r.m_tolerance = (ON_IsValid(tolerance) && tolerance > 0.0) ? tolerance : 0.0;
+  r.m_result = &a_result;
+  r.m_resultCallbackBool = nullptr;
+  r.m_context = nullptr;
+  double b_min[3], b_max[3];
+  FrozenNodeCover(a_rtreeB.m_nodes[0], b_min, b_max);
+  FrozenPairSearchHelper(a_rtreeA.m_nodes.Array(), 0, a_rtreeB.m_nodes.Array(), 0, b_min, b_max, &r);
+  return true;
+}
+
+bool ON_FrozenRTree::Search(
+  const ON_FrozenRTree& a_rtreeA,
+  const ON_FrozenRTree& a_rtreeB,
+  double tolerance,
+  bool ON_CALLBACK_CDECL resultCallback(void* a_context, ON__INT_PTR a_idA, ON__INT_PTR a_idB),
+  void* a_context
+  )
+{
+  if ( 0 == a_rtreeA.m_nodes.Count() || 0 == a_rtreeB.m_nodes.Count() || nullptr == resultCallback )
+    return false;
+  ON_FrozenRTreePairSearchResult r;
+  r.m_tolerance = (ON_IsValid(tolerance) && tolerance > 0.0) ? tolerance : 0.0;
+  r.m_result = nullptr;
+  r.m_resultCallbackBool = resultCallback;
+  r.m_context = a_context;
+  double b_min[3], b_max[3];
+  FrozenNodeCover(a_rtreeB.m_nodes[0], b_min, b_max);
+  return FrozenPairSearchHelper(a_rtreeA.m_nodes.Array(), 0, a_rtreeB.m_nodes.Array(), 0, b_min, b_max, &r);
+}
+
+bool ON_FrozenRTree::Search(
+  double tolerance,
+  ON_SimpleArray<ON_2dex>& a_result
+  ) const
+{
+  if ( 0 == m_nodes.Count() )
+    return false;
+  ON_FrozenRTreePairSearchResult r;
+  r.m_tolerance = (ON_IsValid(tolerance) && tolerance > 0.0) ? tolerance : 0.0;
+  r.m_result = &a_result;
+  r.m_resultCallbackBool = nullptr;
+  r.m_context = nullptr;
+  double b_min[3], b_max[3];
+  FrozenNodeCover(m_nodes[0], b_min, b_max);
+  FrozenSingleTreeSearchHelper(m_nodes.Array(), 0, 0, b_min, b_max, &r);
+  return true;
+}
+
+bool ON_FrozenRTree::Search(
+  double tolerance,
+  bool ON_CALLBACK_CDECL resultCallback(void* a_context, ON__INT_PTR a_idA, ON__INT_PTR a_idB),
+  void* a_context
+  ) const
+{
+  if ( 0 == m_nodes.Count() || nullptr == resultCallback )
+    return false;
+  ON_FrozenRTreePairSearchResult r;
+  r.m_tolerance = (ON_IsValid(tolerance) && tolerance > 0.0) ? tolerance : 0.0;
+  r.m_result = nullptr;
+  r.m_resultCallbackBool = resultCallback;
+  r.m_context = a_context;
+  double b_min[3], b_max[3];
+  FrozenNodeCover(m_nodes[0], b_min, b_max);
+  return FrozenSingleTreeSearchHelper(m_nodes.Array(), 0, 0, b_min, b_max, &r);
+}
+
+unsigned int ON_FrozenRTree::ElementCount() const
+{
+  return m_element_count;
+}
+
+unsigned int ON_FrozenRTree::NodeCount() const
+{
+  return m_nodes.UnsignedCount();
+}
+
+const ON_FrozenRTreeNode* ON_FrozenRTree::Nodes() const
+{
+  return m_nodes.Array();
+}
+
+ON_BoundingBox ON_FrozenRTree::BoundingBox() const
+{
+  ON_BoundingBox bbox;
+  if ( m_nodes.Count() > 0 )
+  {
+    double a_min[3], a_max[3];
+    FrozenNodeCover(m_nodes[0], a_min, a_max);
+    bbox.m_min = ON_3dPoint(a_min);
+    bbox.m_max = ON_3dPoint(a_max);
+  }
+  return bbox;
+}
+
+size_t ON_FrozenRTree::SizeOf() const
+{
+  return m_nodes.SizeOfArray();
+}
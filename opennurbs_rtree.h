@@ -149,6 +149,17 @@ struct ON_RTreeSearchResult
   ON__INT_PTR* m_id; // m_id[] = array of search results.
 };
 
+// Result of a distance ordered search like ON_RTree::SearchNearest().
+struct ON_RTreeDistanceResult
+{
+  ON__INT_PTR m_id;
+  double m_distance;
+};
+
+#if defined(ON_DLL_TEMPLATE)
+ON_DLL_TEMPLATE template class ON_CLASS ON_SimpleArray<ON_RTreeDistanceResult>;
+#endif
+
 class ON_CLASS ON_RTreeMemPool
 {
 public:
@@ -400,6 +411,51 @@ public:
   */
   bool CreateMeshFaceTree( const class ON_Mesh* mesh );
 
+  /*
+  Description:
+    Create an R-tree from a list of bounding boxes in a single pass.
+    The elements are sorted with the sort-tile-recursive (STR) method
+    and packed into full nodes, so the tree is built much faster than
+    calling Insert() for each element and the resulting nodes overlap
+    less, which makes subsequent searches faster.
+  Parameters:
+    count - [in]
+      number of elements.
+    boxes - [in]
+      array of count bounding boxes. Every box must be valid.
+    ids - [in]
+      If ids is not nullptr, then ids[i] is the id of the element with
+      bounding box boxes[i]. If ids is nullptr, then the element id is
+      set to the index i.
+  Returns:
+    True if successful.
+  Remarks:
+    Any existing elements are removed. The tree may be modified
+    with Insert() and Remove() after it is created.
+  */
+  bool CreateFromBoxes(
+    size_t count,
+    const ON_BoundingBox* boxes,
+    const ON__INT_PTR* ids
+    );
+
+  /*
+  Description:
+    Create an R-tree from a list of leaves in a single pass.
+    See CreateFromBoxes() for details.
+  Parameters:
+    count - [in]
+      number of elements.
+    leaves - [in]
+      array of count leaves. Every leaf m_rect must be valid.
+  Returns:
+    True if successful.
+  */
+  bool CreateFromLeaves(
+    size_t count,
+    const ON_RTreeLeaf* leaves
+    );
+
 
   /*
   Description:
@@ -639,6 +695,38 @@ public:
           ON_SimpleArray<ON_2dex>& a_result
           );
 
+  /*
+  Description:
+    Search two R-trees for all pairs elements whose bounding boxes overlap
+    using multiple threads.
+  Parameters:
+    a_rtreeA - [in]
+    a_rtreeB - [in]
+    tolerance - [in]
+      If the distance between a pair of bounding boxes is <= tolerance, 
+      then the pair is added to a_result[].
+    thread_count - [in]
+      0: use one thread per processor core.
+      1: the search is done on the calling thread.
+      >1: at most thread_count threads are used.
+    a_result - [out]
+      Pairs of ids of elements who bounding boxes overlap.
+  Returns:
+    True if entire tree was searched.  It is possible no results were found.
+  Remarks:
+    The upper levels of the trees are split into independent pairs of
+    nodes that are searched concurrently. The pairs are the same as the
+    ones found by the single threaded Search(), and the order of a_result[]
+    does not depend on thread scheduling.
+  */
+  static bool Search( 
+          const ON_RTree& a_rtreeA,
+          const ON_RTree& a_rtreeB, 
+          double tolerance,
+          unsigned int thread_count,
+          ON_SimpleArray<ON_2dex>& a_result
+          );
+
   /*
   Description:
     Search two R-trees for all pairs elements whose bounding boxes overlap.
@@ -750,6 +838,32 @@ public:
     ON_SimpleArray<ON_2dex>& a_result
     ) const;
 
+  /*
+  Description:
+    Search a single R-tree for all pairs of distinct elements whose bounding
+    boxes overlap using multiple threads.
+  Parameters:
+    tolerance - [in]
+      If the distance between a pair of bounding boxes is <= tolerance,
+      then the pair is added to a_result[].
+    thread_count - [in]
+      0: use one thread per processor core.
+      1: the search is done on the calling thread.
+      >1: at most thread_count threads are used.
+    a_result - [out]
+      Pairs of ids of elements who bounding boxes overlap.
+  Returns:
+    True if entire tree was searched.  It is possible no results were found.
+  Remarks:
+    The pairs are the same as the ones found by the single threaded
+    Search(), and the order of a_result[] does not depend on thread scheduling.
+  */
+  bool Search(
+    double tolerance,
+    unsigned int thread_count,
+    ON_SimpleArray<ON_2dex>& a_result
+    ) const;
+
   /*
   Description:
     Search a single R-tree for all pairs of distinct elements whose bounding boxes overlap.
@@ -814,6 +928,75 @@ public:
     void* a_context
     ) const;
 
+  /*
+  Description:
+    Find the elements closest to a point. The tree is searched best first,
+    so only the nodes that are closer than the k-th closest element found
+    so far are visited.
+  Parameters:
+    a_point - [in]
+    a_count - [in]
+      maximum number of elements to find (k).
+    a_maximum_distance - [in]
+      Elements farther than a_maximum_distance are ignored.
+      If a_maximum_distance is not a valid value >= 0, there is no limit.
+    distanceCallback - [in]
+      If distanceCallback is nullptr, the distance to an element is the
+      distance from a_point to the element's bounding box. Otherwise
+      distanceCallback(a_context, a_id) is called to get the exact distance
+      from a_point to the element. The returned distance must be >= the
+      distance to the element's bounding box. Return a negative value or
+      ON_UNSET_VALUE to ignore the element. The callback is only called for
+      elements whose bounding box is closer than the current k-th closest
+      element.
+    a_context - [in]
+      pointer passed to the distanceCallback() function.
+    a_result - [out]
+      The closest elements are appended to a_result[] in order of
+      increasing distance.
+  Returns:
+    True if the search was performed.  It is possible no results were found.
+  */
+  bool SearchNearest(
+    const double a_point[3],
+    unsigned int a_count,
+    double a_maximum_distance,
+    double ON_CALLBACK_CDECL distanceCallback(void* a_context, ON__INT_PTR a_id),
+    void* a_context,
+    ON_SimpleArray<ON_RTreeDistanceResult>& a_result
+    ) const;
+
+  /*
+  Description:
+    Find the elements whose bounding boxes are hit by a ray or line segment
+    in order of the ray parameter where the ray enters the bounding box.
+  Parameters:
+    a_from - [in]
+    a_direction - [in]
+      The ray is a_from + t*a_direction with 0 <= t <= a_maximum_parameter.
+    a_maximum_parameter - [in]
+      Use ON_DBL_MAX for an infinite ray and 1.0 for the segment from
+      a_from to a_from + a_direction.
+    resultCallback - [in]
+      resultCallback(a_context, a_id, t, &maximum_parameter) is called with
+      the elements in order of increasing t, where t is the parameter where
+      the ray enters the element's bounding box (t = 0 when a_from is inside
+      the box). The callback may reduce *maximum_parameter, for example after
+      an exact intersection is found, to end the search early. Return true
+      to keep searching and false to terminate the search.
+    a_context - [in]
+      pointer passed to the resultCallback() function.
+  Returns:
+    True if entire tree was searched.  It is possible no results were found.
+  */
+  bool SearchRay(
+    const double a_from[3],
+    const double a_direction[3],
+    double a_maximum_parameter,
+    bool ON_CALLBACK_CDECL resultCallback(void* a_context, ON__INT_PTR a_id, double t, double* maximum_parameter),
+    void* a_context
+    ) const;
+
   /*
   Returns:
     Number of elements (leaves).
@@ -852,9 +1035,230 @@ private:
   bool RemoveRectRec(ON_RTreeBBox*, ON__INT_PTR, ON_RTreeNode*, struct ON_RTreeListNode**);
   void ReInsert(ON_RTreeNode*, struct ON_RTreeListNode**);
   void RemoveAllRec(ON_RTreeNode*);
+  bool BulkLoad(ON_RTreeBranch*, size_t);
   ON_RTreeNode* m_root = nullptr;
   size_t m_reserved = 0;
   ON_RTreeMemPool m_mem_pool;
 };
 
+// Number of children in each ON_FrozenRTreeNode. The bounding boxes of
+// the children are stored as ON_FrozenRTree_LANE_COUNT wide lanes so
+// overlap tests against every child of a node are evaluated at once.
+#define ON_FrozenRTree_LANE_COUNT 8
+
+// The ON_FrozenRTreeNode is used at root, branch and leaf nodes.
+// When m_level > 0, the node is a branch and the children are the
+// m_count nodes beginning at ON_FrozenRTree node index m_first.
+// When m_level = 0, the node is a leaf and m_id[] identifies the elements.
+struct ON_FrozenRTreeNode
+{
+  // m_min[j][k] and m_max[j][k] are coordinate j of the bounding box of child k.
+  // Lanes k >= m_count are unused.
+  double m_min[3][ON_FrozenRTree_LANE_COUNT];
+  double m_max[3][ON_FrozenRTree_LANE_COUNT];
+  ON__INT_PTR m_id[ON_FrozenRTree_LANE_COUNT];
+  unsigned int m_first;
+  unsigned int m_count;
+  int m_level;
+  unsigned int m_reserved;
+};
+
+#if defined(ON_DLL_TEMPLATE)
+ON_DLL_TEMPLATE template class ON_CLASS ON_SimpleArray<ON_FrozenRTreeNode>;
+#endif
+
+////////////////////////////////////////////////////////////////
+//
+// ON_FrozenRTree
+//
+//   An ON_FrozenRTree is an immutable R-tree intended for applications
+//   that run large numbers of queries against a set of elements that
+//   does not change. The nodes are stored contiguously in breadth first
+//   order, the root is node 0, and the bounding boxes of the children
+//   of a node are stored as coordinate lanes instead of an array of
+//   ON_RTreeBBox structs.
+//
+class ON_CLASS ON_FrozenRTree
+{
+public:
+  ON_FrozenRTree() = default;
+  ~ON_FrozenRTree() = default;
+  ON_FrozenRTree(const ON_FrozenRTree&) = default;
+  ON_FrozenRTree& operator=(const ON_FrozenRTree&) = default;
+
+  /*
+  Description:
+    Create a frozen R-tree that contains the elements in an ON_RTree.
+  Parameters:
+    rtree - [in]
+  Returns:
+    True if successful.
+  Remarks:
+    The elements are repacked. The frozen tree does not reference rtree
+    and does not change when rtree is modified.
+  */
+  bool Create(
+    const ON_RTree& rtree
+    );
+
+  /*
+  Description:
+    Create a frozen R-tree from a list of bounding boxes.
+  Parameters:
+    count - [in]
+      number of elements.
+    boxes - [in]
+      array of count bounding boxes. Every box must be valid.
+    ids - [in]
+      If ids is not nullptr, then ids[i] is the id of the element with
+      bounding box boxes[i]. If ids is nullptr, then the element id is
+      set to the index i.
+  Returns:
+    True if successful.
+  */
+  bool Create(
+    size_t count,
+    const ON_BoundingBox* boxes,
+    const ON__INT_PTR* ids
+    );
+
+  /*
+  Description:
+    Create a frozen R-tree from a list of leaves.
+  Parameters:
+    count - [in]
+      number of elements.
+    leaves - [in]
+      array of count leaves. Every leaf m_rect must be valid.
+  Returns:
+    True if successful.
+  */
+  bool Create(
+    size_t count,
+    const ON_RTreeLeaf* leaves
+    );
+
+  /*
+  Description:
+    Remove all elements from the frozen R-tree.
+  */
+  void RemoveAll();
+
+  /*
+  Description:
+    Search the frozen R-tree for all elements whose bounding boxes overlap
+    the box (a_min,a_max). See ON_RTree::Search() for details.
+  Returns:
+    True if entire tree was searched.  It is possible no results were found.
+  Remarks:
+    If you are using a Search() that uses a resultCallback() function,
+    then return true to keep searching and false to terminate the search.
+  */
+  bool Search(const double a_min[3], const double a_max[3],
+    bool ON_CALLBACK_CDECL resultCallback(void* a_context, ON__INT_PTR a_id), void* a_context
+    ) const;
+
+  bool Search(const double a_min[3], const double a_max[3],
+    ON_SimpleArray<int>& a_result
+    ) const;
+
+  bool Search(const double a_min[3], const double a_max[3],
+    ON_SimpleArray<void*>& a_result
+    ) const;
+
+  /*
+  Description:
+    Search the frozen R-tree for all elements whose bounding boxes
+    intersect a_sphere. The children of each node are visited in order of
+    increasing distance from a_sphere->m_point and the resultCallback()
+    function may shrink a_sphere->m_radius as the search progresses.
+    This is the query to use for closest point calculations.
+    See ON_RTree::Search(ON_RTreeSphere*,...) for details.
+  Returns:
+    True if entire tree was searched.  It is possible no results were found.
+  */
+  bool Search(
+    ON_RTreeSphere* a_sphere,
+    bool ON_CALLBACK_CDECL resultCallback(void* a_context, ON__INT_PTR a_id),
+    void* a_context
+    ) const;
+
+  /*
+  Description:
+    Search two frozen R-trees for all pairs elements whose bounding boxes
+    overlap. See ON_RTree::Search(const ON_RTree&, const ON_RTree&, ...)
+    for details.
+  Returns:
+    True if entire tree was searched.  It is possible no results were found.
+  */
+  static bool Search(
+    const ON_FrozenRTree& a_rtreeA,
+    const ON_FrozenRTree& a_rtreeB,
+    double tolerance,
+    ON_SimpleArray<ON_2dex>& a_result
+    );
+
+  static bool Search(
+    const ON_FrozenRTree& a_rtreeA,
+    const ON_FrozenRTree& a_rtreeB,
+    double tolerance,
+    bool ON_CALLBACK_CDECL resultCallback(void* a_context, ON__INT_PTR a_idA, ON__INT_PTR a_idB),
+    void* a_context
+    );
+
+  /*
+  Description:
+    Search a single frozen R-tree for all pairs of distinct elements whose
+    bounding boxes overlap. See ON_RTree::Search(double tolerance, ...)
+    for details.
+  Returns:
+    True if entire tree was searched.  It is possible no results were found.
+  */
+  bool Search(
+    double tolerance,
+    ON_SimpleArray<ON_2dex>& a_result
+    ) const;
+
+  bool Search(
+    double tolerance,
+    bool ON_CALLBACK_CDECL resultCallback(void* a_context, ON__INT_PTR a_idA, ON__INT_PTR a_idB),
+    void* a_context
+    ) const;
+
+  /*
+  Returns:
+    Number of elements (leaves).
+  */
+  unsigned int ElementCount() const;
+
+  /*
+  Returns:
+    Number of nodes.
+  */
+  unsigned int NodeCount() const;
+
+  /*
+  Returns:
+    Nodes in breadth first order. The root is Nodes()[0].
+  */
+  const ON_FrozenRTreeNode* Nodes() const;
+
+  /*
+  Returns:
+    Bounding box of the entire R-tree;
+  */
+  ON_BoundingBox BoundingBox() const;
+
+  /*
+  Returns:
+    Number of bytes of heap memory used by this R-tree.
+  */
+  size_t SizeOf() const;
+
+private:
+  bool Internal_Create(ON_RTreeBranch*, size_t);
+  ON_SimpleArray<ON_FrozenRTreeNode> m_nodes;
+  unsigned int m_element_count = 0;
+};
+
 #endif
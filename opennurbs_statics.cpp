@@ -95,10 +95,11 @@ ON__UINT64 ON_TestClass::internal_PopulationCounter = 0;
 
 ON__UINT64 ON_NextContentSerialNumber()
 {
-  static ON__UINT64 serial_number = 0;
-  // If it's ever an issue with multiple threads, 
-  // this value can be made atomic, but that will slow down performance.
-  return (0 != ++serial_number) ? serial_number : ++serial_number;
+  // Atomic because geometry is created and modified on worker threads
+  // when models are read and curves are tessellated.
+  static std::atomic<ON__UINT64> serial_number(0);
+  const ON__UINT64 sn = ++serial_number;
+  return (0 != sn) ? sn : ++serial_number;
 }
 
 // All opennurbs static members are initialized here so that initialization happens in a predictable order.
@@ -12317,6 +12317,14 @@ bool ON_SubDFace::GetSubdivisionPoint(
   return false;
 }
 
+bool ON_SubDFace::GetSubdivisionPoint(
+  double subdivision_point[3],
+  ON_EvaluationContext& context
+) const
+{
+  return ON_SubD_Internal_GetSubdivisionPoint(this, &context, subdivision_point);
+}
+
 bool ON_SubDFace::EvaluateCatmullClarkSubdivisionPoint(double subdivision_point[3]) const
 {
   if (nullptr == subdivision_point)
@@ -13408,6 +13416,14 @@ const ON_3dVector ON_SubDEdge::ControlNetCenterNormal(
   return (nullptr != face) ? face->ControlNetCenterNormal() : ON_3dVector::NanVector;
 }
 
+bool ON_SubDEdge::GetSubdivisionPoint(
+  double subdivision_point[3],
+  ON_EvaluationContext& context
+) const
+{
+  return ON_SubD_Internal_GetSubdivisionPoint(this, &context, subdivision_point);
+}
+
 bool ON_SubDEdge::EvaluateCatmullClarkSubdivisionPoint(double subdivision_point[3]) const
 {
   if (nullptr == subdivision_point)
@@ -14217,6 +14233,14 @@ bool ON_SubDVertex::GetSubdivisionPoint(
   return false;
 }
 
+bool ON_SubDVertex::GetSubdivisionPoint(
+  double subdivision_point[3],
+  ON_EvaluationContext& context
+) const
+{
+  return ON_SubD_Internal_GetSubdivisionPoint(this, &context, subdivision_point);
+}
+
 bool ON_SubDVertex::EvaluateCatmullClarkSubdivisionPoint(double subdivision_point[3]) const
 {
   // This function is used to convert an arbitrary control polygon into the
@@ -19888,6 +19912,18 @@ bool ON_SubDVertexQuadSector::InitializeFromSubdividedSectorComponents(
 }
 
 bool ON_SubDVertexQuadSector::InitializeFromSubdividedSectorComponents(const ON_SubDComponentPtr* sector_ring_components, size_t sector_components_count)
+{
+  return this->InitializeFromSubdividedSectorComponents(sector_ring_components, sector_components_count, nullptr);
+}
+
+template <class T>
+static const ON_3dPoint Internal_SectorRingSubdivisionPoint(const T* component, ON_EvaluationContext* context)
+{
+  ON_3dPoint S;
+  return (ON_SubD_Internal_GetSubdivisionPoint(component, context, &S.x) && S.IsValid()) ? S : ON_3dPoint::NanPoint;
+}
+
+bool ON_SubDVertexQuadSector::InitializeFromSubdividedSectorComponents(const ON_SubDComponentPtr* sector_ring_components, size_t sector_components_count, ON_EvaluationContext* context)
 {
   for (;;)
   {
@@ -19953,7 +19989,7 @@ bool ON_SubDVertexQuadSector::InitializeFromSubdividedSectorComponents(const ON_
         // check that there will not be infinite recursion into this roll clause 
         // and then use local_sector_ring_components[].
         if (local_sector_ring_components[0].IsVertex() && local_sector_ring_components[1].EdgePtr().EdgeIsCrease())
-          return this->InitializeFromSubdividedSectorComponents(local_sector_ring_components);
+          return this->InitializeFromSubdividedSectorComponents(local_sector_ring_components.Array(), local_sector_ring_components.Count(), context);
 
         break;
       }
@@ -19980,7 +20016,7 @@ bool ON_SubDVertexQuadSector::InitializeFromSubdividedSectorComponents(const ON_
     {
       if (0U == i)
       {
-        ring_points.Append(center_vertex->SubdivisionPoint());
+        ring_points.Append(Internal_SectorRingSubdivisionPoint(center_vertex, context));
       }
       else if (1 == (i % 2U))
       {
@@ -20014,7 +20050,7 @@ bool ON_SubDVertexQuadSector::InitializeFromSubdividedSectorComponents(const ON_
             break;
         }
 
-        ring_points.Append(e->SubdivisionPoint());
+        ring_points.Append(Internal_SectorRingSubdivisionPoint(e, context));
         ring_sharpness.Append(eptr.RelativeSharpness(false).Subdivided(0));
       }
       else
@@ -20023,7 +20059,7 @@ bool ON_SubDVertexQuadSector::InitializeFromSubdividedSectorComponents(const ON_
         f = sector_ring_components[i].Face();
         if (nullptr == f || f->EdgeArrayIndex(e) >= (unsigned)f->m_edge_count)
           break;
-        ring_points.Append(f->SubdivisionPoint());
+        ring_points.Append(Internal_SectorRingSubdivisionPoint(f, context));
       }
     }
 
@@ -13424,6 +13424,25 @@ public:
     double subdivision_point[3]
     ) const;
 
+  /*
+  Description:
+    Get the Catmull-Clark subdivision point without saving it on this component.
+    If a subdivision point is saved on this component, it is returned.
+    Otherwise the point is calculated and kept in the context, and
+    the next call with the same context uses it.
+    See ON_EvaluationContext for information about thread safety.
+  Parameters:
+    subdivision_point - [out]
+    context - [in/out]
+      Subdivision points calculated with this context are kept here.
+  Returns:
+    true if successful
+  */
+  bool GetSubdivisionPoint(
+    double subdivision_point[3],
+    class ON_EvaluationContext& context
+    ) const;
+
   ///<summary>
   /// The SubD vertex Catmull-Clark subdivision point.
   ///</summary>
@@ -13479,6 +13498,38 @@ public:
     double surface_point[3]
   ) const;
 
+  /*
+  Description:
+    Get the SubD surface point without saving any points on this vertex or
+    on the neighboring components. Saved subdivision and surface points are
+    used when they exist. When no thread is modifying the SubD or calling
+    evaluators that save points, many threads may call these functions 
+    on the same SubD at the same time. See ON_EvaluationContext.
+  Parameters:
+    sector_face - [in]
+      A face in the sector of interest
+    bUndefinedNormalIsPossible - [in]
+      Pass true if you will accept a zero normal vector.
+    limit_point - [out]
+    surface_point - [out]
+    context - [in/out]
+      The context's scratch memory is used for the sector point ring.
+      Subdivision points of the sector components are kept in the context.
+  Returns:
+    true if successful
+  */
+  bool GetSurfacePoint(
+    const ON_SubDFace* sector_face,
+    bool bUndefinedNormalIsPossible,
+    class ON_SubDSectorSurfacePoint& limit_point,
+    class ON_EvaluationContext& context
+    ) const;
+
+  bool GetSurfacePoint(
+    double surface_point[3],
+    class ON_EvaluationContext& context
+    ) const;
+
   /*
   Returns:
     The SubD surface point.
@@ -13667,6 +13718,14 @@ private:
     double vertex_point[3]
     );
 
+  // When context is nullptr, the surface point is saved on the vertex.
+  bool Internal_GetSurfacePoint(
+    const ON_SubDFace* sector_face,
+    bool bUndefinedNormalIsPossible,
+    class ON_SubDSectorSurfacePoint& limit_point,
+    class ON_EvaluationContext* context
+    ) const;
+
 private:
   void CopyFrom(
     const ON_SubDVertex* src,
@@ -14481,6 +14540,25 @@ public:
     double subdivision_point[3]
     ) const;
 
+  /*
+  Description:
+    Get the Catmull-Clark subdivision point without saving it on this component.
+    If a subdivision point is saved on this component, it is returned.
+    Otherwise the point is calculated and kept in the context, and
+    the next call with the same context uses it.
+    See ON_EvaluationContext for information about thread safety.
+  Parameters:
+    subdivision_point - [out]
+    context - [in/out]
+      Subdivision points calculated with this context are kept here.
+  Returns:
+    true if successful
+  */
+  bool GetSubdivisionPoint(
+    double subdivision_point[3],
+    class ON_EvaluationContext& context
+    ) const;
+
   /// <summary>
   /// Get the SubD edge Catmull-Clark subdivision point.
   /// </summary>
@@ -15560,6 +15638,25 @@ public:
     double subdivision_point[3]
     ) const;
 
+  /*
+  Description:
+    Get the Catmull-Clark subdivision point without saving it on this component.
+    If a subdivision point is saved on this component, it is returned.
+    Otherwise the point is calculated and kept in the context, and
+    the next call with the same context uses it.
+    See ON_EvaluationContext for information about thread safety.
+  Parameters:
+    subdivision_point - [out]
+    context - [in/out]
+      Subdivision points calculated with this context are kept here.
+  Returns:
+    true if successful
+  */
+  bool GetSubdivisionPoint(
+    double subdivision_point[3],
+    class ON_EvaluationContext& context
+    ) const;
+
   ///<summary>
   /// The SubD face Catmull-Clark subdivision point.
   ///</summary>
@@ -52,6 +52,53 @@ bool ON_SubDComponentRegionBreakpoint(
   const class ON_SubDComponentRegion* component_region
 );
 
+/*
+Description:
+  Get a vertex, edge or face subdivision point.
+Parameters:
+  component - [in]
+  context - [in]
+    If nullptr, GetSubdivisionPoint() is called and the point is saved on the component.
+    Otherwise a point saved on the component or kept in the context is used when 
+    it exists, and a calculated point is kept in the context, not on the component.
+    See ON_EvaluationContext::SetSubD().
+  subdivision_point - [out]
+*/
+template <class T>
+bool ON_SubD_Internal_GetSubdivisionPoint(
+  const T* component,
+  ON_EvaluationContext* context,
+  double subdivision_point[3]
+)
+{
+  if (nullptr == context)
+    return component->GetSubdivisionPoint(subdivision_point);
+  if (component->GetSavedSubdivisionPoint(subdivision_point))
+    return true;
+  const ON_SubDComponentPtr cptr = ON_SubDComponentPtr::Create(component);
+  if (context->GetSubDSubdivisionPoint(cptr, subdivision_point))
+    return true;
+  if (false == component->EvaluateCatmullClarkSubdivisionPoint(subdivision_point))
+    return false;
+  context->SetSubDSubdivisionPoint(cptr, subdivision_point);
+  return true;
+}
+
+/*
+Description:
+  Same as ON_SubD::GetSectorPointRing(bSubdivideIfNeeded,sit,...) except
+  subdivision points are saved on the components only when context is nullptr.
+  See ON_SubD_Internal_GetSubdivisionPoint().
+*/
+unsigned int ON_SubD_Internal_GetSectorPointRing(
+  bool bSubdivideIfNeeded,
+  ON_EvaluationContext* context,
+  const class ON_SubDSectorIterator& sit,
+  double* point_ring,
+  size_t point_ring_capacity,
+  size_t point_ring_stride
+);
+
 
 //////////////////////////////////////////////////////////////////////////
 //
@@ -3378,6 +3425,17 @@ public:
     size_t sector_components_count
   );
 
+  /// <summary>
+  /// Same as InitializeFromSubdividedSectorComponents(sector_components,sector_components_count)
+  /// except the subdivision points of sector_components[] are saved on the components 
+  /// only when context is nullptr. See ON_SubD_Internal_GetSubdivisionPoint().
+  /// </summary>
+  bool InitializeFromSubdividedSectorComponents(
+    const ON_SubDComponentPtr* sector_components,
+    size_t sector_components_count,
+    ON_EvaluationContext* context
+  );
+
   bool GetSectorControlNetPoints(
     ON_SimpleArray<ON_3dPoint>& sector_control_net_points
   ) const;
@@ -440,7 +440,8 @@ double ON_SubDMatrix::TestEvaluation() const
 static bool GetSectorLimitPointHelper(
   const ON_SubDSectorIterator& sit,
   bool& bUndefinedNormalIsPossible,
-  ON_SubDSectorSurfacePoint& limit_point
+  ON_SubDSectorSurfacePoint& limit_point,
+  ON_EvaluationContext* context // nullptr = save subdivision points on the components
   )
 {
   limit_point.m_limitP[0] = ON_DBL_QNAN;
@@ -460,17 +461,29 @@ static bool GetSectorLimitPointHelper(
   const unsigned int point_ring_stride = 3;
   unsigned int point_ring_capacity = (unsigned int)(sizeof(stack_point_ring)/(point_ring_stride*sizeof(stack_point_ring[0])));
 
-  if (point_ring_capacity < R )
+  if (point_ring_capacity < R && nullptr != context)
+  {
+    point_ring = context->Workspace(point_ring_stride*R);
+    if ( nullptr == point_ring)
+      return  ON_SUBD_RETURN_ERROR(false);
+    point_ring_capacity = R;
+  }
+  else if (point_ring_capacity < R )
   {
     point_ring = new(std::nothrow) double[point_ring_stride*R];
     if ( nullptr == point_ring)
       return  ON_SUBD_RETURN_ERROR(false);
     point_ring_capacity = R;
   }
+  double* delete_point_ring = (point_ring != stack_point_ring && nullptr == context) ? point_ring : nullptr;
 
-  const unsigned int point_ring_count = ON_SubD::GetSectorPointRing( true, sit, point_ring, point_ring_capacity, point_ring_stride);
+  const unsigned int point_ring_count = ON_SubD_Internal_GetSectorPointRing( true, context, sit, point_ring, point_ring_capacity, point_ring_stride);
   if ( R != point_ring_count )
-     return  ON_SUBD_RETURN_ERROR(false);
+  {
+    if (nullptr != delete_point_ring)
+      delete[] delete_point_ring;
+    return  ON_SUBD_RETURN_ERROR(false);
+  }
 
   bool rc = false;
   for (;;)
@@ -509,8 +522,8 @@ static bool GetSectorLimitPointHelper(
     break;
   }
 
-  if ( point_ring != stack_point_ring)
-    delete[] point_ring;
+  if (nullptr != delete_point_ring)
+    delete[] delete_point_ring;
 
   return rc
     ? true
@@ -558,6 +571,26 @@ bool ON_SubDVertex::GetSurfacePoint(
   bool bUndefinedNormalIsPossible,
   ON_SubDSectorSurfacePoint& limit_point
   ) const
+{
+  return Internal_GetSurfacePoint(sector_face, bUndefinedNormalIsPossible, limit_point, nullptr);
+}
+
+bool ON_SubDVertex::GetSurfacePoint(
+  const ON_SubDFace* sector_face,
+  bool bUndefinedNormalIsPossible,
+  ON_SubDSectorSurfacePoint& limit_point,
+  ON_EvaluationContext& context
+  ) const
+{
+  return Internal_GetSurfacePoint(sector_face, bUndefinedNormalIsPossible, limit_point, &context);
+}
+
+bool ON_SubDVertex::Internal_GetSurfacePoint(
+  const ON_SubDFace* sector_face,
+  bool bUndefinedNormalIsPossible,
+  ON_SubDSectorSurfacePoint& limit_point,
+  ON_EvaluationContext* context
+  ) const
 {
   bool rc = false;
   ON_SubDSectorIterator sit;
@@ -634,7 +667,7 @@ bool ON_SubDVertex::GetSurfacePoint(
 
   limit_point_sector_face = sit.IncrementToCrease(-1);
 
-  rc = GetSectorLimitPointHelper( sit, bUndefinedNormalIsPossible, limit_point);
+  rc = GetSectorLimitPointHelper( sit, bUndefinedNormalIsPossible, limit_point, context);
 
   if (false == rc)
   {
@@ -643,6 +676,13 @@ bool ON_SubDVertex::GetSurfacePoint(
   }
     
   limit_point.m_sector_face = this->IsSingleSectorVertex() ? nullptr : limit_point_sector_face;
+
+  if (nullptr != context)
+  {
+    // context evaluations never modify the SubD
+    limit_point.m_next_sector_limit_point = nullptr;
+    return rc;
+  }
   
   ON_SubDSectorSurfacePoint saved_limit_point = limit_point;
   saved_limit_point.m_next_sector_limit_point = (ON_SubDSectorSurfacePoint*)1; // causes unnecessary test to be skipped
@@ -848,6 +888,22 @@ const ON_3dPoint ON_SubDVertex::Point(ON_SubDComponentLocation point_location) c
 
 
 
+bool ON_SubDVertex::GetSurfacePoint(
+  double limit_point[3],
+  ON_EvaluationContext& context
+) const
+{
+  if (nullptr == limit_point)
+    return false;
+
+  ON_SubDSectorSurfacePoint lp;
+  const bool rc = GetSurfacePoint(Face(0), true, lp, context);
+  limit_point[0] = rc ? lp.m_limitP[0] : ON_DBL_QNAN;
+  limit_point[1] = rc ? lp.m_limitP[1] : ON_DBL_QNAN;
+  limit_point[2] = rc ? lp.m_limitP[2] : ON_DBL_QNAN;
+  return rc;
+}
+
 bool ON_SubDVertex::GetSurfacePoint(
   double limit_point[3]
 ) const
@@ -23,6 +23,15 @@
 
 #include "opennurbs_subd_data.h"
 
+static unsigned int Internal_GetQuadSectorPointRing(
+  bool bPermitNoSubdivisions,
+  ON_EvaluationContext* context,
+  const ON_SubDComponentPtr* component_ring,
+  size_t component_ring_count,
+  double* point_ring,
+  size_t point_ring_stride
+  );
+
 unsigned int ON_SubD::GetQuadSectorPointRing(
   bool bPermitNoSubdivisions,
   bool bObsoleteAndIgnoredParameter,
@@ -32,6 +41,25 @@ unsigned int ON_SubD::GetQuadSectorPointRing(
   double* point_ring,
   size_t point_ring_stride
   )
+{
+  return Internal_GetQuadSectorPointRing(
+    bPermitNoSubdivisions, 
+    nullptr, 
+    component_ring, 
+    component_ring_count, 
+    point_ring, 
+    point_ring_stride
+  );
+}
+
+static unsigned int Internal_GetQuadSectorPointRing(
+  bool bPermitNoSubdivisions,
+  ON_EvaluationContext* context,
+  const ON_SubDComponentPtr* component_ring,
+  size_t component_ring_count,
+  double* point_ring,
+  size_t point_ring_stride
+  )
 {
   // MINIMAL VALIDATION CHECKS TO PREVENT CRASHES
   // CALLER MUST INSURE INPUT IS CORRECT
@@ -119,7 +147,7 @@ unsigned int ON_SubD::GetQuadSectorPointRing(
     // we need to subdivide at least twice to get the point ring
 
     ON_SubDVertexQuadSector vqs;
-    if (false == vqs.InitializeFromSubdividedSectorComponents(component_ring, component_ring_count))
+    if (false == vqs.InitializeFromSubdividedSectorComponents(component_ring, component_ring_count, context))
       return ON_SUBD_RETURN_ERROR(0);
     if (N != vqs.CenterVertexEdgeCount())
       return ON_SUBD_RETURN_ERROR(0);
@@ -165,7 +193,7 @@ unsigned int ON_SubD::GetQuadSectorPointRing(
     Q = vertex0->m_P;
   else
   {
-    if (false == vertex0->GetSubdivisionPoint(subP))
+    if (false == ON_SubD_Internal_GetSubdivisionPoint(vertex0, context, subP))
       return ON_SUBD_RETURN_ERROR(0);
     Q = subP;
   }
@@ -192,7 +220,7 @@ unsigned int ON_SubD::GetQuadSectorPointRing(
     }
     else
     {
-      if (false == e->GetSubdivisionPoint(subP))
+      if (false == ON_SubD_Internal_GetSubdivisionPoint(e, context, subP))
         return ON_SUBD_RETURN_ERROR(0);
       // Q = subP set above when vertex0 was subdivided.
     }
@@ -215,7 +243,7 @@ unsigned int ON_SubD::GetQuadSectorPointRing(
       }
       else
       {
-        if (false == f->GetSubdivisionPoint(subP))
+        if (false == ON_SubD_Internal_GetSubdivisionPoint(f, context, subP))
           return ON_SUBD_RETURN_ERROR(0);
         // Q = subP set above when vertex0 was subdivided.
       }
@@ -454,6 +482,18 @@ unsigned int ON_SubD::GetSectorPointRing(
   size_t point_ring_capacity,
   size_t point_ring_stride
   )
+{
+  return ON_SubD_Internal_GetSectorPointRing(bSubdivideIfNeeded, nullptr, sit, point_ring, point_ring_capacity, point_ring_stride);
+}
+
+unsigned int ON_SubD_Internal_GetSectorPointRing(
+  bool bSubdivideIfNeeded,
+  ON_EvaluationContext* context,
+  const class ON_SubDSectorIterator& sit,
+  double* point_ring,
+  size_t point_ring_capacity,
+  size_t point_ring_stride
+  )
 {
   const ON_SubDVertex* center_vertex = sit.CenterVertex();
   if ( nullptr == center_vertex )
@@ -475,11 +515,9 @@ unsigned int ON_SubD::GetSectorPointRing(
   unsigned int component_ring_count = ON_SubD::GetSectorComponentRing(sit, component_ring,component_ring_capacity);
   if (component_ring_count > 0)
   {
-    const bool bObsoleteAndIgnoredParameter = false;
-    point_ring_count = ON_SubD::GetQuadSectorPointRing(
+    point_ring_count = Internal_GetQuadSectorPointRing(
       bSubdivideIfNeeded ? false : true, 
-      bObsoleteAndIgnoredParameter, 
-      nullptr, 
+      context, 
       component_ring, 
       component_ring_count, 
       point_ring, point_ring_stride
@@ -21,14 +21,19 @@
 #error ON_COMPILING_OPENNURBS must be defined when compiling opennurbs
 #endif
 
+// ON_Internal_ParallelFor()
+#include "opennurbs_internal_defines.h"
+
 ON_VIRTUAL_OBJECT_IMPLEMENT(ON_Surface,ON_Geometry,"4ED7D4E1-E947-11d3-BFE5-0010830122F0");
 
 ON_Surface::ON_Surface()
 : ON_Geometry()
+, m_geometry_content_serial_number(ON_NextContentSerialNumber())
 {}
 
 ON_Surface::ON_Surface(const ON_Surface& src)
 : ON_Geometry(src)
+, m_geometry_content_serial_number(ON_NextContentSerialNumber())
 {}
 
 unsigned int ON_Surface::SizeOf() const
@@ -1259,6 +1264,1046 @@ ON_Surface::EvNormal( // returns false if unable to evaluate
   return rc;
 }
 
+static bool ON_Internal_SurfaceEvDer(
+  const ON_Surface& srf,
+  double s, 
+  double t,
+  int der_count,
+  ON_3dVector* D, // D[(der_count+1)*(der_count+2)/2]
+  int quadrant,
+  ON_EvaluationContext& context
+  )
+{
+  int i, j;
+  const int D_count = ((der_count+1)*(der_count+2))/2;
+  for ( i = 0; i < D_count; i++ )
+    D[i] = ON_3dVector::ZeroVector;
+
+  const int dim = srf.Dimension();
+  double* v = (dim > 0) ? context.Workspace(D_count*dim) : nullptr;
+  if ( nullptr == v )
+    return false;
+
+  // ON_NurbsSurface gets its scratch memory from the context too.
+  const ON_NurbsSurface* nurbs_surface = ON_NurbsSurface::Cast(&srf);
+  const bool rc = (nullptr != nurbs_surface)
+    ? nurbs_surface->Evaluate( s, t, der_count, dim, v, quadrant, context )
+    : srf.Evaluate( s, t, der_count, dim, v, quadrant, context.SurfaceHint() );
+  const int n = (dim < 3) ? dim : 3;
+  for ( i = 0; i < D_count; i++ )
+  {
+    for ( j = 0; j < n; j++ )
+      D[i][j] = v[i*dim + j];
+  }
+  return rc;
+}
+
+bool ON_Surface::EvPoint(
+         double s, double t,
+         ON_3dPoint& point,
+         int quadrant,
+         ON_EvaluationContext& context
+         ) const
+{
+  ON_3dVector D[1];
+  const bool rc = ON_Internal_SurfaceEvDer( *this, s, t, 0, D, quadrant, context );
+  point = D[0];
+  return rc;
+}
+
+bool ON_Surface::Ev1Der(
+         double s, double t,
+         ON_3dPoint& point,
+         ON_3dVector& ds,
+         ON_3dVector& dt,
+         int quadrant,
+         ON_EvaluationContext& context
+         ) const
+{
+  ON_3dVector D[3];
+  const bool rc = ON_Internal_SurfaceEvDer( *this, s, t, 1, D, quadrant, context );
+  point = D[0];
+  ds = D[1];
+  dt = D[2];
+  return rc;
+}
+
+bool ON_Surface::Ev2Der(
+         double s, double t,
+         ON_3dPoint& point,
+         ON_3dVector& ds,
+         ON_3dVector& dt,
+         ON_3dVector& dss,
+         ON_3dVector& dst,
+         ON_3dVector& dtt,
+         int quadrant,
+         ON_EvaluationContext& context
+         ) const
+{
+  ON_3dVector D[6];
+  const bool rc = ON_Internal_SurfaceEvDer( *this, s, t, 2, D, quadrant, context );
+  point = D[0];
+  ds = D[1];
+  dt = D[2];
+  dss = D[3];
+  dst = D[4];
+  dtt = D[5];
+  return rc;
+}
+
+bool ON_Surface::EvNormal(
+         double s, double t,
+         ON_3dPoint& point,
+         ON_3dVector& ds,
+         ON_3dVector& dt,
+         ON_3dVector& normal,
+         int quadrant,
+         ON_EvaluationContext& context
+         ) const
+{
+  // EvNormal() does not modify the surface. The hint is the only state it changes.
+  return EvNormal( s, t, point, ds, dt, normal, quadrant, context.SurfaceHint() );
+}
+
+bool ON_Surface::EvaluateGrid(
+         int s_count,
+         const double* s,
+         int t_count,
+         const double* t,
+         ON_3dPoint* points,
+         ON_3dVector* ds,
+         ON_3dVector* dt,
+         ON_3dVector* normals
+         ) const
+{
+  if ( s_count < 1 || t_count < 1 || nullptr == s || nullptr == t )
+    return false;
+
+  bool rc = true;
+  int hint[2] = { 0, 0 };
+  ON_3dPoint P;
+  ON_3dVector Ds, Dt, N;
+  size_t k = 0;
+  for ( int i = 0; i < s_count; i++ )
+  {
+    for ( int j = 0; j < t_count; j++, k++ )
+    {
+      bool bEvaluated;
+      Ds = ON_3dVector::ZeroVector;
+      Dt = ON_3dVector::ZeroVector;
+      N = ON_3dVector::ZeroVector;
+      if ( nullptr != normals )
+        bEvaluated = EvNormal( s[i], t[j], P, Ds, Dt, N, 0, hint );
+      else if ( nullptr != ds || nullptr != dt )
+        bEvaluated = Ev1Der( s[i], t[j], P, Ds, Dt, 0, hint );
+      else
+        bEvaluated = EvPoint( s[i], t[j], P, 0, hint );
+      if ( !bEvaluated )
+      {
+        rc = false;
+        P = ON_3dPoint::UnsetPoint;
+        Ds = ON_3dVector::ZeroVector;
+        Dt = ON_3dVector::ZeroVector;
+        N = ON_3dVector::ZeroVector;
+      }
+      if ( points )
+        points[k] = P;
+      if ( ds )
+        ds[k] = Ds;
+      if ( dt )
+        dt[k] = Dt;
+      if ( normals )
+        normals[k] = N;
+    }
+  }
+
+  return rc;
+}
+
+// Closest point tools shared by ON_Surface::GetClosestPoint() and
+// ON_Surface::GetClosestPoints(). The NURBS form is split into Bezier
+// patches and the patch bounding boxes are put in an R-tree. The R-tree is
+// searched best first and the exact distance to a patch is computed only
+// when its bounding box is closer than the best point found so far.
+class ON_Internal_SurfaceClosestPoint
+{
+public:
+  ON_Internal_SurfaceClosestPoint() = default;
+  ~ON_Internal_SurfaceClosestPoint() = default;
+  ON_Internal_SurfaceClosestPoint(const ON_Internal_SurfaceClosestPoint&) = delete;
+  ON_Internal_SurfaceClosestPoint& operator=(const ON_Internal_SurfaceClosestPoint&) = delete;
+
+  bool Create(const ON_Surface& surface, const ON_Interval* sdomain, const ON_Interval* tdomain);
+
+  // Thread safe.
+  bool GetClosestPoint(const ON_3dPoint& P, double maximum_distance, double* s, double* t) const;
+
+private:
+  static double ON_CALLBACK_CDECL PatchDistance(void* context, ON__INT_PTR patch_index);
+  static bool ON_CALLBACK_CDECL TrimmedPatchDistance(void* context, ON__INT_PTR patch_index);
+  bool GetPatchClosestPoint(int patch_index, const ON_3dPoint& P, double* u, double* v, double* d) const;
+  bool GetSurfaceParameters(int patch_index, double u, double v, double* s, double* t) const;
+
+  // Trimmed faces
+  bool CreateTrims(const ON_BrepFace& face);
+  bool IsInsideTrims(double s, double t) const;
+  bool GetTrimClosestPoint(const ON_3dPoint& P, double* s, double* t, double* d) const;
+
+  const ON_Surface* m_surface = nullptr;
+  ON_Interval m_domain[2]; // surface parameters
+  bool m_bNurbFormParameters = false;
+  ON_NurbsSurface m_nurbs_form;
+  ON_ClassArray<ON_BezierSurface> m_patch;
+  // m_patch_domain[2*i] and m_patch_domain[2*i+1] are the NURBS form
+  // domains of m_patch[i]. m_patch_limits[2*i] and m_patch_limits[2*i+1]
+  // are the parts of the Bezier domain [0,1]x[0,1] that are searched.
+  ON_SimpleArray<ON_Interval> m_patch_domain;
+  ON_SimpleArray<ON_Interval> m_patch_limits;
+  ON_RTree m_rtree;
+
+  // When the surface is an ON_BrepFace, the trims are sampled at m_trim_t[].
+  // The samples of m_trims[i] are m_trim_t[m_trim_sample_index[i]] to 
+  // m_trim_t[m_trim_sample_index[i+1]-1]. The face parameters of the samples,
+  // without the end of each trim, form a closed polygon for each loop.
+  // The polygon of loop li is m_loop_polygon[m_loop_polygon_index[li]] to
+  // m_loop_polygon[m_loop_polygon_index[li+1]-1]. 
+  // m_trim_bbox[i] contains the edge of m_trims[i].
+  const ON_BrepFace* m_face = nullptr;
+  ON_SimpleArray<const ON_BrepTrim*> m_trims;
+  ON_SimpleArray<ON_BoundingBox> m_trim_bbox;
+  ON_SimpleArray<int> m_trim_sample_index;
+  ON_SimpleArray<double> m_trim_t;
+  ON_SimpleArray<ON_2dPoint> m_loop_polygon;
+  ON_SimpleArray<int> m_loop_polygon_index;
+};
+
+// Evaluates the squared distance from P to a Bezier patch. When der_count = 2,
+// the gradient g[] and Hessian H[] of the squared distance / 2 are returned.
+// The Gauss-Newton approximation of the Hessian is returned in J[].
+static bool ON_Internal_PatchDistance(
+  const ON_BezierSurface& patch,
+  const double P[3],
+  double u,
+  double v,
+  int der_count,
+  double* f,
+  double g[2],
+  double H[3],
+  double J[3]
+  )
+{
+  const int dim = patch.m_dim;
+  double e[6 * 3];
+  if (!patch.Evaluate(u, v, der_count, 3, e))
+    return false;
+  double R[3];
+  for (int i = 0; i < 3; i++)
+    R[i] = ((i < dim) ? e[i] : 0.0) - P[i];
+  *f = R[0] * R[0] + R[1] * R[1] + R[2] * R[2];
+  if (der_count >= 2)
+  {
+    // e[] = S, Su, Sv, Suu, Suv, Svv with stride 3
+    for (int k = 1; k < 6; k++)
+    {
+      for (int i = dim; i < 3; i++)
+        e[3 * k + i] = 0.0;
+    }
+    const double* Su = e + 3;
+    const double* Sv = e + 6;
+    const double* Suu = e + 9;
+    const double* Suv = e + 12;
+    const double* Svv = e + 15;
+    g[0] = ON_ArrayDotProduct(3, R, Su);
+    g[1] = ON_ArrayDotProduct(3, R, Sv);
+    J[0] = ON_ArrayDotProduct(3, Su, Su);
+    J[1] = ON_ArrayDotProduct(3, Su, Sv);
+    J[2] = ON_ArrayDotProduct(3, Sv, Sv);
+    H[0] = J[0] + ON_ArrayDotProduct(3, R, Suu);
+    H[1] = J[1] + ON_ArrayDotProduct(3, R, Suv);
+    H[2] = J[2] + ON_ArrayDotProduct(3, R, Svv);
+  }
+  return true;
+}
+
+static double ON_Internal_ClampParameter(const ON_Interval& I, double x)
+{
+  return (x < I.m_t[0]) ? I.m_t[0] : ((x > I.m_t[1]) ? I.m_t[1] : x);
+}
+
+// Damped Newton iteration for a local minimum of the squared distance on the
+// rectangle U x V. Coordinates that are on the boundary of the rectangle and
+// whose gradient points out of the rectangle are held fixed.
+static bool ON_Internal_PatchLocalClosestPoint(
+  const ON_BezierSurface& patch,
+  const double P[3],
+  const ON_Interval& U,
+  const ON_Interval& V,
+  double* u,
+  double* v,
+  double* f
+  )
+{
+  double x[2] = { *u, *v };
+  double fx = ON_UNSET_VALUE;
+  double g[2], H[3], J[3];
+  for (int iteration = 0; iteration < 32; iteration++)
+  {
+    if (!ON_Internal_PatchDistance(patch, P, x[0], x[1], 2, &fx, g, H, J))
+      return false;
+    if (0.0 == fx)
+      break;
+
+    const bool bFixU = (x[0] <= U.m_t[0] && g[0] > 0.0) || (x[0] >= U.m_t[1] && g[0] < 0.0);
+    const bool bFixV = (x[1] <= V.m_t[0] && g[1] > 0.0) || (x[1] >= V.m_t[1] && g[1] < 0.0);
+    if (bFixU && bFixV)
+      break;
+
+    // Use the Newton step when the Hessian is positive definite and
+    // the Gauss-Newton step otherwise.
+    double d[2] = { 0.0, 0.0 };
+    if (bFixU || bFixV)
+    {
+      const int k = bFixU ? 1 : 0;
+      const double h = (H[2 * k] > 0.0) ? H[2 * k] : J[2 * k];
+      if (!(h > 0.0))
+        break;
+      d[k] = -g[k] / h;
+    }
+    else
+    {
+      const double* M = (H[0] > 0.0 && H[0] * H[2] - H[1] * H[1] > 0.0) ? H : J;
+      double pivot_ratio = 0.0;
+      if (2 != ON_Solve2x2(M[0], M[1], M[1], M[2], -g[0], -g[1], &d[0], &d[1], &pivot_ratio))
+        break;
+    }
+
+    // Step halving line search.
+    double y[2] = { x[0], x[1] };
+    double fy = fx;
+    bool bDecreased = false;
+    for (int k = 0; k < 16 && !bDecreased; k++)
+    {
+      y[0] = ON_Internal_ClampParameter(U, x[0] + d[0]);
+      y[1] = ON_Internal_ClampParameter(V, x[1] + d[1]);
+      if (!ON_Internal_PatchDistance(patch, P, y[0], y[1], 0, &fy, nullptr, nullptr, nullptr))
+        return false;
+      bDecreased = (fy < fx);
+      d[0] *= 0.5;
+      d[1] *= 0.5;
+    }
+    if (!bDecreased)
+      break;
+    const double step = fabs(y[0] - x[0]) + fabs(y[1] - x[1]);
+    x[0] = y[0];
+    x[1] = y[1];
+    fx = fy;
+    if (step <= 4.0 * ON_EPSILON)
+      break;
+  }
+
+  *u = x[0];
+  *v = x[1];
+  *f = fx;
+  return true;
+}
+
+bool ON_Internal_SurfaceClosestPoint::Create(const ON_Surface& surface, const ON_Interval* sdomain, const ON_Interval* tdomain)
+{
+  // The patches cover the whole surface. The trims of a face are
+  // handled in GetClosestPoint().
+  const ON_BrepFace* face = ON_BrepFace::Cast(&surface);
+  if (nullptr != face)
+  {
+    if (nullptr != sdomain || nullptr != tdomain)
+      return false;
+    if (!CreateTrims(*face))
+      return false;
+  }
+
+  m_surface = &surface;
+  for (int dir = 0; dir < 2; dir++)
+  {
+    m_domain[dir] = surface.Domain(dir);
+    const ON_Interval* sub_domain = (0 == dir) ? sdomain : tdomain;
+    if (nullptr != sub_domain)
+    {
+      ON_Interval d = *sub_domain;
+      d.MakeIncreasing();
+      if (!m_domain[dir].Intersection(d))
+        return false;
+    }
+  }
+
+  const ON_NurbsSurface* nurbs_surface = ON_NurbsSurface::Cast(&surface);
+  if (nullptr == nurbs_surface)
+  {
+    const int rc = surface.GetNurbForm(m_nurbs_form);
+    if (rc < 1)
+      return false;
+    m_bNurbFormParameters = (2 == rc);
+    nurbs_surface = &m_nurbs_form;
+  }
+
+  const int dim = nurbs_surface->Dimension();
+  if (dim < 1 || dim > 3)
+    return false;
+  for (int dir = 0; dir < 2; dir++)
+  {
+    if (nurbs_surface->m_order[dir] < 2 || nurbs_surface->m_cv_count[dir] < nurbs_surface->m_order[dir])
+      return false;
+  }
+
+  ON_Interval domain[2] = { nurbs_surface->Domain(0), nurbs_surface->Domain(1) };
+  if (nullptr != sdomain || nullptr != tdomain)
+  {
+    ON_Interval d[2] = { 
+      (nullptr != sdomain) ? *sdomain : surface.Domain(0),
+      (nullptr != tdomain) ? *tdomain : surface.Domain(1)
+    };
+    if (m_bNurbFormParameters)
+    {
+      ON_Interval nurbs_d[2];
+      for (int k = 0; k < 2; k++)
+      {
+        if (!surface.GetNurbFormParameterFromSurfaceParameter(d[0].m_t[k], d[1].m_t[k], &nurbs_d[0].m_t[k], &nurbs_d[1].m_t[k]))
+          return false;
+      }
+      d[0] = nurbs_d[0];
+      d[1] = nurbs_d[1];
+    }
+    for (int dir = 0; dir < 2; dir++)
+    {
+      d[dir].MakeIncreasing();
+      if (!domain[dir].Intersection(d[dir]) || !domain[dir].IsIncreasing())
+        return false;
+    }
+  }
+
+  const int span_count[2] = {
+    nurbs_surface->m_cv_count[0] - nurbs_surface->m_order[0] + 1,
+    nurbs_surface->m_cv_count[1] - nurbs_surface->m_order[1] + 1
+  };
+  m_patch.Reserve(span_count[0] * span_count[1]);
+  m_patch_domain.Reserve(2 * span_count[0] * span_count[1]);
+  m_patch_limits.Reserve(2 * span_count[0] * span_count[1]);
+  ON_SimpleArray<ON_BoundingBox> bbox(span_count[0] * span_count[1]);
+  for (int i = 0; i < span_count[0]; i++)
+  {
+    const double* sknot = nurbs_surface->m_knot[0] + (i + nurbs_surface->m_order[0] - 2);
+    if (!(sknot[0] < sknot[1]) || sknot[1] <= domain[0].m_t[0] || sknot[0] >= domain[0].m_t[1])
+      continue;
+    for (int j = 0; j < span_count[1]; j++)
+    {
+      const double* tknot = nurbs_surface->m_knot[1] + (j + nurbs_surface->m_order[1] - 2);
+      if (!(tknot[0] < tknot[1]) || tknot[1] <= domain[1].m_t[0] || tknot[0] >= domain[1].m_t[1])
+        continue;
+      ON_BezierSurface& patch = m_patch.AppendNew();
+      if (!nurbs_surface->ConvertSpanToBezier(i, j, patch))
+      {
+        m_patch.Remove();
+        continue;
+      }
+      const ON_Interval patch_domain[2] = { ON_Interval(sknot[0], sknot[1]), ON_Interval(tknot[0], tknot[1]) };
+      for (int dir = 0; dir < 2; dir++)
+      {
+        // The bounding box of the whole patch is used when the patch is
+        // trimmed by a sub-domain. It is larger than needed but still
+        // a valid lower bound for the distance.
+        ON_Interval limits(0.0, 1.0);
+        if (patch_domain[dir].m_t[0] < domain[dir].m_t[0])
+          limits.m_t[0] = patch_domain[dir].NormalizedParameterAt(domain[dir].m_t[0]);
+        if (patch_domain[dir].m_t[1] > domain[dir].m_t[1])
+          limits.m_t[1] = patch_domain[dir].NormalizedParameterAt(domain[dir].m_t[1]);
+        m_patch_domain.Append(patch_domain[dir]);
+        m_patch_limits.Append(limits);
+      }
+      bbox.Append(patch.BoundingBox());
+    }
+  }
+
+  if (m_patch.Count() <= 0)
+    return false;
+
+  return m_rtree.CreateFromBoxes(bbox.UnsignedCount(), bbox.Array(), nullptr);
+}
+
+// Evaluates the squared distance from P to an (n+1) x (n+1) grid of points on
+// the rectangle U x V of a Bezier patch. The Bernstein polynomials are
+// tabulated once per grid line, which is much faster than evaluating each
+// grid point with ON_BezierSurface::Evaluate().
+static bool ON_Internal_PatchGridDistance(
+  const ON_BezierSurface& patch,
+  const double P[3],
+  const ON_Interval& U,
+  const ON_Interval& V,
+  int n,
+  double* f
+  )
+{
+  const int dim = patch.m_dim;
+  const int cvdim = patch.CVSize();
+  const int order0 = patch.m_order[0];
+  const int order1 = patch.m_order[1];
+  if (dim < 1 || dim > 3 || order0 < 1 || order1 < 1 || n < 1)
+    return false;
+
+  // Bu[i*order0 + a] = Bernstein polynomial a at u[i]
+  // Bv[j*order1 + b] = Bernstein polynomial b at v[j]
+  // R[(i*order1 + b)*cvdim + k] = sum Bu[i*order0 + a]*CV(a,b)[k]
+  const size_t ws_count = (size_t)(n + 1) * (order0 + order1 + order1 * cvdim);
+  double stack_buffer[1024];
+  double* Bu = (ws_count <= sizeof(stack_buffer) / sizeof(stack_buffer[0]))
+             ? stack_buffer
+             : (double*)onmalloc(ws_count * sizeof(Bu[0]));
+  double* Bv = Bu + (n + 1) * order0;
+  double* R = Bv + (n + 1) * order1;
+
+  for (int i = 0; i <= n; i++)
+  {
+    const double u = U.ParameterAt(((double)i) / ((double)n));
+    for (int a = 0; a < order0; a++)
+      Bu[i * order0 + a] = ON_EvaluateBernsteinBasis(order0 - 1, a, u);
+    const double v = V.ParameterAt(((double)i) / ((double)n));
+    for (int b = 0; b < order1; b++)
+      Bv[i * order1 + b] = ON_EvaluateBernsteinBasis(order1 - 1, b, v);
+  }
+
+  for (int i = 0; i <= n; i++)
+  {
+    for (int b = 0; b < order1; b++)
+    {
+      double* r = R + (i * order1 + b) * cvdim;
+      for (int k = 0; k < cvdim; k++)
+        r[k] = 0.0;
+      for (int a = 0; a < order0; a++)
+      {
+        const double* cv = patch.CV(a, b);
+        const double c = Bu[i * order0 + a];
+        for (int k = 0; k < cvdim; k++)
+          r[k] += c * cv[k];
+      }
+    }
+  }
+
+  bool rc = true;
+  for (int i = 0; i <= n && rc; i++)
+  {
+    for (int j = 0; j <= n; j++)
+    {
+      double X[4] = { 0.0, 0.0, 0.0, 0.0 };
+      for (int b = 0; b < order1; b++)
+      {
+        const double* r = R + (i * order1 + b) * cvdim;
+        const double c = Bv[j * order1 + b];
+        for (int k = 0; k < cvdim; k++)
+          X[k] += c * r[k];
+      }
+      if (patch.m_is_rat)
+      {
+        if (0.0 == X[dim])
+        {
+          rc = false;
+          break;
+        }
+        const double w = 1.0 / X[dim];
+        for (int k = 0; k < dim; k++)
+          X[k] *= w;
+        X[dim] = 0.0;
+      }
+      const double x = X[0] - P[0];
+      const double y = X[1] - P[1];
+      const double z = X[2] - P[2];
+      f[i * (n + 1) + j] = x * x + y * y + z * z;
+    }
+  }
+
+  if (Bu != stack_buffer)
+    onfree(Bu);
+
+  return rc;
+}
+
+// Returns true if the patch edge where parameter dir is 0 (side = 0) or 
+// 1 (side = 1) is a single point, like the pole of a sphere.
+static bool ON_Internal_PatchEdgeIsCollapsed(const ON_BezierSurface& patch, int dir, int side)
+{
+  const int edge_index = (0 == side) ? 0 : patch.m_order[dir] - 1;
+  ON_3dPoint P0, P;
+  if (!patch.GetCV((0 == dir) ? edge_index : 0, (0 == dir) ? 0 : edge_index, P0))
+    return false;
+  const double tolerance = ON_ZERO_TOLERANCE * (1.0 + P0.MaximumCoordinate());
+  for (int k = 1; k < patch.m_order[1 - dir]; k++)
+  {
+    if (!patch.GetCV((0 == dir) ? edge_index : k, (0 == dir) ? k : edge_index, P))
+      return false;
+    if (!(P0.DistanceTo(P) <= tolerance))
+      return false;
+  }
+  return true;
+}
+
+bool ON_Internal_SurfaceClosestPoint::GetPatchClosestPoint(int patch_index, const ON_3dPoint& P, double* u, double* v, double* d) const
+{
+  const ON_BezierSurface& patch = m_patch[patch_index];
+  const ON_Interval& U = m_patch_limits[2 * patch_index];
+  const ON_Interval& V = m_patch_limits[2 * patch_index + 1];
+  const double Q[3] = { P.x, P.y, P.z };
+
+  // Sample the patch on a grid and start Newton iterations from the
+  // best discrete local minima.
+  const int max_order = (patch.m_order[0] > patch.m_order[1]) ? patch.m_order[0] : patch.m_order[1];
+  const int n = (max_order < 16) ? 2 * max_order : 32;
+  double sf[33 * 33];
+  if (!ON_Internal_PatchGridDistance(patch, Q, U, V, n, sf))
+    return false;
+
+  // The derivative along a collapsed edge is zero and Newton iterations
+  // cannot leave it, so a sample on a collapsed edge is replaced by the 
+  // closest sample in the next row of the grid.
+  const bool bCollapsedU[2] = {
+    U.m_t[0] <= 0.0 && ON_Internal_PatchEdgeIsCollapsed(patch, 0, 0),
+    U.m_t[1] >= 1.0 && ON_Internal_PatchEdgeIsCollapsed(patch, 0, 1)
+  };
+  const bool bCollapsedV[2] = {
+    V.m_t[0] <= 0.0 && ON_Internal_PatchEdgeIsCollapsed(patch, 1, 0),
+    V.m_t[1] >= 1.0 && ON_Internal_PatchEdgeIsCollapsed(patch, 1, 1)
+  };
+
+  const int max_seed_count = 2;
+  int seed[max_seed_count];
+  int seed_count = 0;
+  for (int i = 0; i <= n; i++)
+  {
+    for (int j = 0; j <= n; j++)
+    {
+      int k = i * (n + 1) + j;
+      double f = sf[k];
+      const bool bMinU = !((i > 0 && sf[k - n - 1] < f) || (i < n && sf[k + n + 1] < f));
+      const bool bMinV = !((j > 0 && sf[k - 1] < f) || (j < n && sf[k + 1] < f));
+      // Samples on the patch boundary only need to be a minimum along the
+      // boundary because the closest point can be on the boundary.
+      if (!(bMinU && bMinV) && !(bMinV && (0 == i || n == i)) && !(bMinU && (0 == j || n == j)))
+        continue;
+      if ((0 == j && bCollapsedV[0]) || (n == j && bCollapsedV[1]))
+      {
+        const int row = (0 == j) ? 1 : n - 1;
+        for (int ii = 0; ii <= n; ii++)
+        {
+          if (ii == 0 || sf[ii * (n + 1) + row] < sf[k])
+            k = ii * (n + 1) + row;
+        }
+      }
+      else if ((0 == i && bCollapsedU[0]) || (n == i && bCollapsedU[1]))
+      {
+        const int row = (0 == i) ? 1 : n - 1;
+        for (int jj = 0; jj <= n; jj++)
+        {
+          if (jj == 0 || sf[row * (n + 1) + jj] < sf[k])
+            k = row * (n + 1) + jj;
+        }
+      }
+      f = sf[k];
+      bool bDuplicate = false;
+      for (int m = 0; m < seed_count && !bDuplicate; m++)
+        bDuplicate = (seed[m] == k);
+      if (bDuplicate)
+        continue;
+      // insertion sort by distance
+      int m = (seed_count < max_seed_count) ? seed_count++ : max_seed_count;
+      while (m > 0 && sf[seed[m - 1]] > f)
+      {
+        if (m < max_seed_count)
+          seed[m] = seed[m - 1];
+        m--;
+      }
+      if (m < max_seed_count)
+        seed[m] = k;
+    }
+  }
+
+  double best_f = ON_DBL_MAX;
+  for (int si = 0; si < seed_count; si++)
+  {
+    double x = U.ParameterAt(((double)(seed[si] / (n + 1))) / ((double)n));
+    double y = V.ParameterAt(((double)(seed[si] % (n + 1))) / ((double)n));
+    double f = sf[seed[si]];
+    if (!ON_Internal_PatchLocalClosestPoint(patch, Q, U, V, &x, &y, &f) || f > sf[seed[si]])
+    {
+      x = U.ParameterAt(((double)(seed[si] / (n + 1))) / ((double)n));
+      y = V.ParameterAt(((double)(seed[si] % (n + 1))) / ((double)n));
+      f = sf[seed[si]];
+    }
+    if (f < best_f)
+    {
+      best_f = f;
+      *u = x;
+      *v = y;
+    }
+    if (0.0 == best_f)
+      break;
+  }
+
+  if (!(best_f < ON_DBL_MAX))
+    return false;
+  *d = sqrt(best_f);
+  return true;
+}
+
+bool ON_Internal_SurfaceClosestPoint::CreateTrims(const ON_BrepFace& face)
+{
+  if (nullptr == face.Brep() || face.m_li.Count() <= 0)
+    return false;
+  m_trim_sample_index.Append(0);
+  m_loop_polygon_index.Append(0);
+  ON_SimpleArray<double> span_vector;
+  for (int fli = 0; fli < face.m_li.Count(); fli++)
+  {
+    const ON_BrepLoop* loop = face.Loop(fli);
+    if (nullptr == loop || loop->m_ti.Count() <= 0)
+      return false;
+    // Curves and points on the face are not boundaries.
+    if (ON_BrepLoop::crvonsrf == loop->m_type || ON_BrepLoop::ptonsrf == loop->m_type)
+      continue;
+    for (int lti = 0; lti < loop->m_ti.Count(); lti++)
+    {
+      const ON_BrepTrim* trim = loop->Trim(lti);
+      const int span_count = (nullptr != trim) ? trim->SpanCount() : 0;
+      if (span_count < 1)
+        return false;
+      span_vector.SetCount(0);
+      span_vector.Reserve(span_count + 1);
+      span_vector.SetCount(span_count + 1);
+      if (!trim->GetSpanVector(span_vector.Array()))
+        return false;
+
+      // Lines need no interior samples.
+      const int degree = trim->Degree();
+      const int n = (degree <= 1) ? 1 : 8 * degree;
+      for (int i = 0; i < span_count; i++)
+      {
+        const ON_Interval span(span_vector[i], span_vector[i + 1]);
+        for (int k = 0; k < n; k++)
+        {
+          const double tau = span.ParameterAt(((double)k) / ((double)n));
+          const ON_3dPoint p = trim->PointAt(tau);
+          m_trim_t.Append(tau);
+          m_loop_polygon.Append(ON_2dPoint(p.x, p.y));
+        }
+      }
+      m_trim_t.Append(span_vector[span_count]);
+      m_trim_sample_index.Append(m_trim_t.Count());
+
+      // The edge and the trim on the surface agree to within the edge
+      // tolerance. A singular trim is at its vertex.
+      ON_BoundingBox bbox;
+      double tolerance = 0.0;
+      const ON_BrepEdge* edge = trim->Edge();
+      const ON_BrepVertex* vertex = trim->Vertex(0);
+      if (nullptr != edge)
+      {
+        bbox = edge->BoundingBox();
+        tolerance = edge->m_tolerance;
+      }
+      else if (nullptr != vertex)
+      {
+        bbox.Set(vertex->point, false);
+        tolerance = vertex->m_tolerance;
+      }
+      if (!bbox.IsValid())
+        return false;
+      if (!(tolerance >= 0.0) || ON_UNSET_VALUE == tolerance)
+        tolerance = 0.0;
+      tolerance += 1.0e-3 * bbox.Diagonal().Length() + ON_SQRT_EPSILON * bbox.MaximumDistanceTo(ON_3dPoint::Origin);
+      bbox.m_min -= ON_3dVector(tolerance, tolerance, tolerance);
+      bbox.m_max += ON_3dVector(tolerance, tolerance, tolerance);
+      m_trim_bbox.Append(bbox);
+      m_trims.Append(trim);
+    }
+    m_loop_polygon_index.Append(m_loop_polygon.Count());
+  }
+  m_face = &face;
+  return true;
+}
+
+bool ON_Internal_SurfaceClosestPoint::IsInsideTrims(double s, double t) const
+{
+  // Even-odd rule. The outer loop and the inner loops are counted alike.
+  bool bInside = false;
+  for (int li = 0; li + 1 < m_loop_polygon_index.Count(); li++)
+  {
+    const int i0 = m_loop_polygon_index[li];
+    const int i1 = m_loop_polygon_index[li + 1];
+    for (int i = i0, j = i1 - 1; i < i1; j = i++)
+    {
+      const ON_2dPoint& a = m_loop_polygon[j];
+      const ON_2dPoint& b = m_loop_polygon[i];
+      if ((a.y > t) != (b.y > t))
+      {
+        const double x = a.x + (t - a.y) * (b.x - a.x) / (b.y - a.y);
+        if (s < x)
+          bInside = !bInside;
+      }
+    }
+  }
+  return bInside;
+}
+
+bool ON_Internal_SurfaceClosestPoint::GetTrimClosestPoint(const ON_3dPoint& P, double* s, double* t, double* d) const
+{
+  // *d is the distance to beat.
+  bool rc = false;
+  for (int ti = 0; ti < m_trims.Count(); ti++)
+  {
+    if (!(m_trim_bbox[ti].MinimumDistanceTo(P) < *d))
+      continue;
+    const ON_BrepTrim* trim = m_trims[ti];
+    ON_3dPoint best_uv = ON_3dPoint::UnsetPoint;
+    double best_d = ON_DBL_MAX;
+    auto TrimDistance = [&](double tau)
+    {
+      const ON_3dPoint uv = trim->PointAt(tau);
+      const ON_3dPoint Q = m_surface->PointAt(uv.x, uv.y);
+      const double dist = Q.IsValid() ? P.DistanceTo(Q) : ON_DBL_MAX;
+      if (dist < best_d)
+      {
+        best_d = dist;
+        best_uv = uv;
+      }
+      return dist;
+    };
+
+    const int k0 = m_trim_sample_index[ti];
+    const int k1 = m_trim_sample_index[ti + 1];
+    int best_k = k0;
+    double sample_d = ON_DBL_MAX;
+    for (int k = k0; k < k1; k++)
+    {
+      const double dist = TrimDistance(m_trim_t[k]);
+      if (dist < sample_d)
+      {
+        sample_d = dist;
+        best_k = k;
+      }
+    }
+
+    // Golden section search between the samples next to the best sample.
+    double a = m_trim_t[(best_k > k0) ? best_k - 1 : best_k];
+    double b = m_trim_t[(best_k + 1 < k1) ? best_k + 1 : best_k];
+    const double g = 0.5 * (sqrt(5.0) - 1.0);
+    double x1 = b - g * (b - a);
+    double x2 = a + g * (b - a);
+    double f1 = TrimDistance(x1);
+    double f2 = TrimDistance(x2);
+    for (int it = 0; it < 100 && b - a > ON_EPSILON * (fabs(a) + fabs(b)); it++)
+    {
+      if (f1 <= f2)
+      {
+        b = x2;
+        x2 = x1;
+        f2 = f1;
+        x1 = b - g * (b - a);
+        f1 = TrimDistance(x1);
+      }
+      else
+      {
+        a = x1;
+        x1 = x2;
+        f1 = f2;
+        x2 = a + g * (b - a);
+        f2 = TrimDistance(x2);
+      }
+    }
+
+    if (best_d < *d)
+    {
+      *s = best_uv.x;
+      *t = best_uv.y;
+      *d = best_d;
+      rc = true;
+    }
+  }
+  return rc;
+}
+
+class ON_Internal_SurfaceClosestPointSearch
+{
+public:
+  const ON_Internal_SurfaceClosestPoint* m_cp;
+  ON_3dPoint m_P;
+  int m_best_patch;
+  double m_best_u;
+  double m_best_v;
+  double m_best_d;
+  // trimmed faces
+  double m_best_s;
+  double m_best_t;
+  ON_RTreeSphere m_sphere;
+};
+
+double ON_CALLBACK_CDECL ON_Internal_SurfaceClosestPoint::PatchDistance(void* context, ON__INT_PTR patch_index)
+{
+  ON_Internal_SurfaceClosestPointSearch* search = (ON_Internal_SurfaceClosestPointSearch*)context;
+  double u = ON_UNSET_VALUE, v = ON_UNSET_VALUE, d = ON_UNSET_VALUE;
+  if (!search->m_cp->GetPatchClosestPoint((int)patch_index, search->m_P, &u, &v, &d))
+    return ON_UNSET_VALUE;
+  if (d < search->m_best_d)
+  {
+    search->m_best_patch = (int)patch_index;
+    search->m_best_u = u;
+    search->m_best_v = v;
+    search->m_best_d = d;
+  }
+  return d;
+}
+
+bool ON_Internal_SurfaceClosestPoint::GetSurfaceParameters(int patch_index, double u, double v, double* s, double* t) const
+{
+  double a = m_patch_domain[2 * patch_index].ParameterAt(u);
+  double b = m_patch_domain[2 * patch_index + 1].ParameterAt(v);
+  if (m_bNurbFormParameters)
+  {
+    double surface_s = a, surface_t = b;
+    if (!m_surface->GetSurfaceParameterFromNurbFormParameter(a, b, &surface_s, &surface_t))
+      return false;
+    a = surface_s;
+    b = surface_t;
+  }
+  // Parameter conversions can put (a,b) a few bits outside of the domain.
+  *s = ON_Internal_ClampParameter(m_domain[0], a);
+  *t = ON_Internal_ClampParameter(m_domain[1], b);
+  return true;
+}
+
+bool ON_CALLBACK_CDECL ON_Internal_SurfaceClosestPoint::TrimmedPatchDistance(void* context, ON__INT_PTR patch_index)
+{
+  // Patches that may contain a point inside the trims that is closer than
+  // the closest point on the trims. The search sphere shrinks as points are found.
+  ON_Internal_SurfaceClosestPointSearch* search = (ON_Internal_SurfaceClosestPointSearch*)context;
+  double u = ON_UNSET_VALUE, v = ON_UNSET_VALUE, d = ON_UNSET_VALUE, s = ON_UNSET_VALUE, t = ON_UNSET_VALUE;
+  if (
+    search->m_cp->GetPatchClosestPoint((int)patch_index, search->m_P, &u, &v, &d)
+    && d < search->m_best_d
+    && search->m_cp->GetSurfaceParameters((int)patch_index, u, v, &s, &t)
+    && search->m_cp->IsInsideTrims(s, t)
+    )
+  {
+    search->m_best_s = s;
+    search->m_best_t = t;
+    search->m_best_d = d;
+    search->m_sphere.m_radius = d;
+  }
+  return true;
+}
+
+bool ON_Internal_SurfaceClosestPoint::GetClosestPoint(const ON_3dPoint& P, double maximum_distance, double* s, double* t) const
+{
+  if (!P.IsValid() || m_patch.Count() <= 0)
+    return false;
+
+  ON_Internal_SurfaceClosestPointSearch search;
+  search.m_cp = this;
+  search.m_P = P;
+  search.m_best_patch = -1;
+  search.m_best_u = ON_UNSET_VALUE;
+  search.m_best_v = ON_UNSET_VALUE;
+  search.m_best_d = ON_DBL_MAX;
+
+  ON_SimpleArray<ON_RTreeDistanceResult> result(1);
+  const double max_d = (maximum_distance > 0.0) ? maximum_distance : ON_UNSET_VALUE;
+  if (!m_rtree.SearchNearest(&P.x, 1, max_d, PatchDistance, &search, result))
+    return false;
+  if (1 != result.Count() || search.m_best_patch < 0)
+    return false;
+  if (maximum_distance > 0.0 && search.m_best_d > maximum_distance)
+    return false;
+
+  double a = ON_UNSET_VALUE, b = ON_UNSET_VALUE;
+  if (!GetSurfaceParameters(search.m_best_patch, search.m_best_u, search.m_best_v, &a, &b))
+    return false;
+
+  if (nullptr != m_face && !IsInsideTrims(a, b))
+  {
+    // The closest point on the untrimmed surface is trimmed away. The closest
+    // point on the face is on a trim or is a point inside the trims that is
+    // the closest point on its patch.
+    search.m_best_s = ON_UNSET_VALUE;
+    search.m_best_t = ON_UNSET_VALUE;
+    search.m_best_d = (maximum_distance > 0.0) ? maximum_distance : ON_DBL_MAX;
+    if (!GetTrimClosestPoint(P, &search.m_best_s, &search.m_best_t, &search.m_best_d))
+      return false;
+    search.m_sphere.m_point[0] = P.x;
+    search.m_sphere.m_point[1] = P.y;
+    search.m_sphere.m_point[2] = P.z;
+    search.m_sphere.m_radius = search.m_best_d;
+    m_rtree.Search(&search.m_sphere, TrimmedPatchDistance, &search);
+    a = search.m_best_s;
+    b = search.m_best_t;
+  }
+
+  *s = ON_Internal_ClampParameter(m_domain[0], a);
+  *t = ON_Internal_ClampParameter(m_domain[1], b);
+  return true;
+}
+
+bool ON_Surface::GetClosestPoint(
+       const ON_3dPoint& test_point,
+       double* s,
+       double* t,
+       double maximum_distance,
+       const ON_Interval* sdomain,
+       const ON_Interval* tdomain
+       ) const
+{
+  if (nullptr == s || nullptr == t)
+    return false;
+  ON_Internal_SurfaceClosestPoint cp;
+  if (!cp.Create(*this, sdomain, tdomain))
+    return false;
+  return cp.GetClosestPoint(test_point, maximum_distance, s, t);
+}
+
+size_t ON_Surface::GetClosestPoints(
+       size_t point_count,
+       const ON_3dPoint* points,
+       double* s,
+       double* t,
+       double maximum_distance,
+       const ON_Interval* sdomain,
+       const ON_Interval* tdomain,
+       unsigned int thread_count
+       ) const
+{
+  if (0 == point_count || nullptr == points || nullptr == s || nullptr == t)
+    return 0;
+  for (size_t i = 0; i < point_count; i++)
+    s[i] = t[i] = ON_UNSET_VALUE;
+
+  ON_Internal_SurfaceClosestPoint cp;
+  if (!cp.Create(*this, sdomain, tdomain))
+    return 0;
+
+  // Points are handed out in blocks so threads do not share cache lines of s[] and t[].
+  const size_t block_size = (point_count > ((size_t)0xFFFFFFFFU) * 64) ? (point_count / 0xFFFFFFFFU + 1) : 64;
+  const unsigned int block_count = (unsigned int)((point_count + block_size - 1) / block_size);
+  std::atomic<size_t> found_count(0);
+  ON_Internal_ParallelFor(thread_count, block_count, [&](unsigned int block)
+    {
+      size_t count = 0;
+      const size_t i1 = (block + 1 < block_count) ? (block + 1) * block_size : point_count;
+      for (size_t i = block * block_size; i < i1; i++)
+      {
+        if (cp.GetClosestPoint(points[i], maximum_distance, &s[i], &t[i]))
+          count++;
+        else
+          s[i] = t[i] = ON_UNSET_VALUE;
+      }
+      found_count += count;
+    }
+  );
+
+  return found_count;
+}
+
 //virtual
 ON_Curve* ON_Surface::IsoCurve(
        int dir,    // 0 first parameter varies and second parameter is constant
@@ -1517,6 +2562,17 @@ void ON_Surface::DestroySurfaceTree()
   DestroyRuntimeCache(true);
 }
 
+ON__UINT64 ON_Surface::GeometryContentSerialNumber() const
+{
+  return m_geometry_content_serial_number;
+}
+
+ON__UINT64 ON_Surface::ChangeGeometryContentSerialNumberForExperts()
+{
+  m_geometry_content_serial_number = ON_NextContentSerialNumber();
+  return m_geometry_content_serial_number;
+}
+
 
 ON_SurfaceProperties::ON_SurfaceProperties()
 {
@@ -625,6 +625,48 @@ public:
                                //            repeated evaluations
          ) const;
 
+  // Versions of EvPoint(), Ev1Der(), Ev2Der() and EvNormal() that use the 
+  // hint and scratch memory in an evaluation context.  When each thread
+  // uses its own context, these may be called from many threads on the
+  // same surface. See ON_EvaluationContext for details.
+  bool EvPoint( // returns false if unable to evaluate
+         double u, double v,   // evaluation parameters
+         ON_3dPoint& point,    // returns value of surface
+         int quadrant,         // 0 = default, 1 = NE, 2 = NW, 3 = SW, 4 = SE
+         class ON_EvaluationContext& context
+         ) const;
+
+  bool Ev1Der( // returns false if unable to evaluate
+         double u, double v,   // evaluation parameters (s,t)
+         ON_3dPoint& point,    // returns value of surface
+         ON_3dVector& du,      // first partial derivatives (Ds)
+         ON_3dVector& dv,      // (Dt)
+         int quadrant,         // 0 = default, 1 = NE, 2 = NW, 3 = SW, 4 = SE
+         class ON_EvaluationContext& context
+         ) const;
+
+  bool Ev2Der( // returns false if unable to evaluate
+         double u, double v,   // evaluation parameters (s,t)
+         ON_3dPoint& point,    // returns value of surface
+         ON_3dVector& du,      // first partial derivatives (Ds)
+         ON_3dVector& dv,      // (Dt)
+         ON_3dVector& duu,     // second partial derivatives (Dss)
+         ON_3dVector& duv,     // (Dst)
+         ON_3dVector& dvv,     // (Dtt)
+         int quadrant,         // 0 = default, 1 = NE, 2 = NW, 3 = SW, 4 = SE
+         class ON_EvaluationContext& context
+         ) const;
+
+  bool EvNormal( // returns false if unable to evaluate
+         double u, double v,   // evaluation parameters (s,t)
+         ON_3dPoint& point,    // returns value of surface
+         ON_3dVector& du,      // first partial derivatives (Ds)
+         ON_3dVector& dv,      // (Dt)
+         ON_3dVector& normal,  // unit normal
+         int quadrant,         // 0 = default, 1 = NE, 2 = NW, 3 = SW, 4 = SE
+         class ON_EvaluationContext& context
+         ) const;
+
   // work horse evaluator
   virtual 
   bool Evaluate( // returns false if unable to evaluate
@@ -642,6 +684,127 @@ public:
                                //            repeated evaluations
          ) const = 0;
 
+  /*
+  Description:
+    Evaluate the surface at every point of a parameter grid.
+  Parameters:
+    s_count - [in] number of first surface parameters (>=1)
+    s - [in] array of s_count first surface parameters.
+    t_count - [in] number of second surface parameters (>=1)
+    t - [in] array of t_count second surface parameters.
+      Evaluation is fastest when s[] and t[] are sorted.
+    points - [out] nullptr or an array of s_count*t_count points.
+        The point at (s[i],t[j]) is returned in points[i*t_count + j].
+    ds - [out] nullptr or an array of s_count*t_count first partial
+        derivatives with respect to the first parameter.
+    dt - [out] nullptr or an array of s_count*t_count first partial
+        derivatives with respect to the second parameter.
+    normals - [out] nullptr or an array of s_count*t_count unit normals.
+  Returns:
+    false if unable to evaluate one or more grid points.  Points that
+    cannot be evaluated are set to ON_3dPoint::UnsetPoint and the
+    derivatives and normals at those points are set to zero.
+  Remarks:
+    The default implementation calls EvPoint(), Ev1Der() or EvNormal()
+    at each grid point. ON_NurbsSurface evaluates the basis functions
+    once per s[] value and once per t[] value.
+  See Also:
+    ON_Surface::Evaluate
+    ON_Surface::EvNormal
+  */
+  virtual
+  bool EvaluateGrid(
+         int s_count,
+         const double* s,
+         int t_count,
+         const double* t,
+         ON_3dPoint* points,
+         ON_3dVector* ds,
+         ON_3dVector* dt,
+         ON_3dVector* normals
+         ) const;
+
+  /*
+  Description:
+    Find the point on the surface that is closest to test_point.
+  Parameters:
+    test_point - [in]
+    s - [out]
+    t - [out] parameters of the closest point are returned here.
+    maximum_distance - [in]
+      If maximum_distance > 0, then only points whose distance to
+      test_point is <= maximum_distance are considered. Using a positive
+      value of maximum_distance can substantially speed the search.
+    sdomain - [in]
+    tdomain - [in]
+      If sdomain or tdomain is not nullptr, the search is restricted to
+      the part of the surface with parameters in sdomain x tdomain.
+      They must be nullptr when the surface is an ON_BrepFace.
+  Returns:
+    true if a point was found.
+  Remarks:
+    When the surface is an ON_BrepFace, the closest point on the trimmed
+    face is found. If the closest point on the untrimmed surface is 
+    outside of the trims, the closest point on the trims is found and the
+    patches that may contain a closer point inside the trims are searched.
+    Points that are very close to a curved trim are classified using a 
+    polygon that approximates the trim. Use ON_BrepFace::SurfaceOf() to 
+    search the untrimmed surface of a face.
+    The NURBS form of the surface is split into Bezier patches. The
+    patches whose bounding boxes may contain a closer point are searched
+    in order of distance and the closest point on each patch is found
+    with a damped Newton iteration started from a grid of samples.
+    Use GetClosestPoints() to project many points onto the same surface.
+  See Also:
+    ON_Surface::GetClosestPoints
+  */
+  bool GetClosestPoint(
+         const ON_3dPoint& test_point,
+         double* s,
+         double* t,
+         double maximum_distance = 0.0,
+         const ON_Interval* sdomain = nullptr,
+         const ON_Interval* tdomain = nullptr
+         ) const;
+
+  /*
+  Description:
+    Find the points on the surface that are closest to a list of test points.
+  Parameters:
+    point_count - [in] number of test points.
+    points - [in] array of point_count test points.
+    s - [out]
+    t - [out]
+      arrays of point_count parameters. (s[i],t[i]) are the parameters
+      of the point closest to points[i] or ON_UNSET_VALUE if no point
+      was found.
+    maximum_distance - [in]
+    sdomain - [in]
+    tdomain - [in]
+      See GetClosestPoint().
+    thread_count - [in]
+      Maximum number of threads to use. 0 uses one thread per core
+      and 1 does all the work on the calling thread.
+  Returns:
+    Number of test points whose closest point was found.
+  Remarks:
+    ON_BrepFace trims are handled as described in GetClosestPoint().
+    The Bezier patches and their bounding box tree are created once and
+    shared by all the threads.
+  See Also:
+    ON_Surface::GetClosestPoint
+  */
+  size_t GetClosestPoints(
+         size_t point_count,
+         const ON_3dPoint* points,
+         double* s,
+         double* t,
+         double maximum_distance = 0.0,
+         const ON_Interval* sdomain = nullptr,
+         const ON_Interval* tdomain = nullptr,
+         unsigned int thread_count = 0
+         ) const;
+
   /*
   Description:
     Get isoparametric curve.
@@ -860,7 +1023,33 @@ public:
   void DestroySurfaceTree();
 
 
+  /*
+  Returns:
+    A runtime serial number that changes every time the surface's
+    runtime cache is destroyed. The functions that modify the
+    geometry of a surface call DestroySurfaceTree(), so a change in
+    this value means the shape or parameterization may have changed.
+    Every surface gets a new value when it is constructed or assigned.
+    ON_SurfaceProxy returns the larger of its own value and the value
+    of the surface it references.
+  Remarks:
+    Code that changes a surface through its public data members, like
+    ON_NurbsSurface::m_cv[], must call DestroySurfaceTree().
+  See Also:
+    ON_TightBoundingBoxCache
+  */
+  virtual ON__UINT64 GeometryContentSerialNumber() const;
+
+  /*
+  Description:
+    Change the value of GeometryContentSerialNumber().
+  Returns:
+    The new value of GeometryContentSerialNumber().
+  */
+  ON__UINT64 ChangeGeometryContentSerialNumberForExperts();
+
 private:
+  ON__UINT64 m_geometry_content_serial_number = 0;
 
 public:
 
@@ -34,6 +34,20 @@ ON_SurfaceProxy::ON_SurfaceProxy( const ON_SurfaceProxy& src ) : ON_Surface(src)
   *this = src;
 }
 
+ON__UINT64 ON_SurfaceProxy::GeometryContentSerialNumber() const
+{
+  // DestroyRuntimeCache() only goes from the proxy to the real surface,
+  // so a real surface that is changed by itself has a larger serial number.
+  ON__UINT64 sn = ON_Surface::GeometryContentSerialNumber();
+  if (nullptr != m_surface && this != m_surface)
+  {
+    const ON__UINT64 surface_sn = m_surface->GeometryContentSerialNumber();
+    if (surface_sn > sn)
+      sn = surface_sn;
+  }
+  return sn;
+}
+
 unsigned int ON_SurfaceProxy::SizeOf() const
 {
   unsigned int sz = ON_Surface::SizeOf();
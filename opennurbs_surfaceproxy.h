@@ -26,6 +26,9 @@ public:
   // virtual ON_Object::DestroyRuntimeCache override
   void DestroyRuntimeCache( bool bDelete = true ) override;
 
+  // virtual ON_Surface::GeometryContentSerialNumber override
+  ON__UINT64 GeometryContentSerialNumber() const override;
+
 public:
   ON_SurfaceProxy();
   ON_SurfaceProxy(const ON_Surface*);
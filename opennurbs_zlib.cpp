@@ -23,6 +23,9 @@
 
 #include "opennurbs_zlib.h"
 
+// ON_Internal_ParallelFor()
+#include "opennurbs_internal_defines.h"
+
 #if defined(ON_COMPILER_MSC) && !defined(ON_CMAKE_BUILD)
 
 #if !defined(OPENNURBS_ZLIB_LIB_DIR)
@@ -84,6 +87,297 @@ class ON_CompressorImplementation& ON_BinaryArchive::Compressor()
 }
 
 
+// ON_CompressionCodec::LZ4 buffers use the LZ4 block format.
+// A block is a list of sequences. Each sequence is a token byte, literal length 
+// bytes, literals, a 2 byte little endian match offset and match length bytes.
+// The last sequence contains only literals. The uncompressed size is saved
+// outside the block.
+class ON_LZ4Block
+{
+public:
+  static size_t CompressBound(size_t sizeof_in)
+  {
+    return sizeof_in + sizeof_in/255 + 16;
+  }
+
+  // Returns number of bytes written to out or 0 on failure.
+  static size_t Compress(
+    size_t sizeof_in,
+    const void* in,
+    size_t sizeof_out,
+    void* out
+  );
+
+  // Returns true if exactly sizeof_out bytes were decompressed.
+  static bool Decompress(
+    size_t sizeof_in,
+    const void* in,
+    size_t sizeof_out,
+    void* out
+  );
+
+private:
+  enum : unsigned int
+  {
+    min_match = 4,
+    last_literals = 5, // the last 5 bytes are always literals
+    match_find_limit = 12, // the last match starts at least 12 bytes before the end
+    max_offset = 65535,
+    hash_bits = 16
+  };
+
+  static ON__UINT32 Read32(const unsigned char* p)
+  {
+    ON__UINT32 v;
+    memcpy(&v, p, 4);
+    return v;
+  }
+
+  static unsigned int Hash(ON__UINT32 v)
+  {
+    return (unsigned int)((v * 2654435761U) >> (32 - hash_bits));
+  }
+
+  static unsigned char* WriteLength(unsigned char* op, size_t length)
+  {
+    for (/*empty*/; length >= 255; length -= 255)
+      *op++ = 255;
+    *op++ = (unsigned char)length;
+    return op;
+  }
+
+  static unsigned char* WriteSequence(
+    unsigned char* op,
+    const unsigned char* literals,
+    size_t literal_length,
+    size_t offset,
+    size_t match_length // 0 for the last sequence
+  )
+  {
+    unsigned char* token = op++;
+    *token = (unsigned char)(((literal_length >= 15) ? 15 : literal_length) << 4);
+    if (literal_length >= 15)
+      op = WriteLength(op, literal_length - 15);
+    memcpy(op, literals, literal_length);
+    op += literal_length;
+    if (offset > 0)
+    {
+      *op++ = (unsigned char)(offset & 0xFF);
+      *op++ = (unsigned char)(offset >> 8);
+      match_length -= min_match;
+      *token |= (unsigned char)((match_length >= 15) ? 15 : match_length);
+      if (match_length >= 15)
+        op = WriteLength(op, match_length - 15);
+    }
+    return op;
+  }
+
+  static bool ReadLength(const unsigned char*& ip, const unsigned char* iend, size_t& length)
+  {
+    unsigned char b;
+    do
+    {
+      if (ip >= iend)
+        return false;
+      b = *ip++;
+      length += b;
+    } while (255 == b);
+    return true;
+  }
+};
+
+size_t ON_LZ4Block::Compress(
+  size_t sizeof_in,
+  const void* in,
+  size_t sizeof_out,
+  void* out
+)
+{
+  if (sizeof_out < CompressBound(sizeof_in) || (sizeof_in > 0 && nullptr == in) || nullptr == out)
+    return 0;
+
+  const unsigned char* const src = (const unsigned char*)in;
+  const unsigned char* const iend = src + sizeof_in;
+  const unsigned char* anchor = src;
+  unsigned char* op = (unsigned char*)out;
+
+  if (sizeof_in > match_find_limit)
+  {
+    // table[] = offset of the last position with a given 4 byte hash
+    ON__UINT32* table = (ON__UINT32*)oncalloc(((size_t)1) << hash_bits, sizeof(table[0]));
+    if (nullptr == table)
+      return 0;
+
+    const unsigned char* const match_find_end = iend - match_find_limit;
+    const unsigned char* const match_end = iend - last_literals;
+    const unsigned char* ip = src + 1;
+    while (ip < match_find_end)
+    {
+      const ON__UINT32 sequence = Read32(ip);
+      const unsigned int h = Hash(sequence);
+      const unsigned char* ref = src + table[h];
+      table[h] = (ON__UINT32)(ip - src);
+      if ((size_t)(ip - ref) > max_offset || ref == ip || Read32(ref) != sequence)
+      {
+        // skip faster through incompressible data
+        ip += 1 + ((ip - anchor) >> 6);
+        continue;
+      }
+
+      while (ip > anchor && ref > src && ip[-1] == ref[-1])
+      {
+        ip--;
+        ref--;
+      }
+      const unsigned char* mp = ip + min_match;
+      const unsigned char* rp = ref + min_match;
+      while (mp < match_end && *mp == *rp)
+      {
+        mp++;
+        rp++;
+      }
+
+      op = WriteSequence(op, anchor, (size_t)(ip - anchor), (size_t)(ip - ref), (size_t)(mp - ip));
+      ip = mp;
+      anchor = ip;
+      if (ip < match_find_end)
+        table[Hash(Read32(ip - 2))] = (ON__UINT32)(ip - 2 - src);
+    }
+
+    onfree(table);
+  }
+
+  op = WriteSequence(op, anchor, (size_t)(iend - anchor), 0, 0);
+  return (size_t)(op - (unsigned char*)out);
+}
+
+bool ON_LZ4Block::Decompress(
+  size_t sizeof_in,
+  const void* in,
+  size_t sizeof_out,
+  void* out
+)
+{
+  if (nullptr == in || nullptr == out)
+    return false;
+
+  const unsigned char* ip = (const unsigned char*)in;
+  const unsigned char* const iend = ip + sizeof_in;
+  unsigned char* const dst = (unsigned char*)out;
+  unsigned char* op = dst;
+  unsigned char* const oend = dst + sizeof_out;
+
+  while (ip < iend)
+  {
+    const unsigned int token = *ip++;
+
+    size_t literal_length = (token >> 4);
+    if (15 == literal_length && false == ReadLength(ip, iend, literal_length))
+      return false;
+    if (literal_length > (size_t)(iend - ip) || literal_length > (size_t)(oend - op))
+      return false;
+    memcpy(op, ip, literal_length);
+    ip += literal_length;
+    op += literal_length;
+
+    if (ip >= iend)
+      break; // last sequence
+
+    if (iend - ip < 2)
+      return false;
+    const size_t offset = ((size_t)ip[0]) | (((size_t)ip[1]) << 8);
+    ip += 2;
+    if (0 == offset || offset > (size_t)(op - dst))
+      return false;
+
+    size_t match_length = (token & 0x0F);
+    if (15 == match_length && false == ReadLength(ip, iend, match_length))
+      return false;
+    match_length += min_match;
+    if (match_length > (size_t)(oend - op))
+      return false;
+
+    const unsigned char* match = op - offset;
+    if (offset >= match_length)
+    {
+      memcpy(op, match, match_length);
+      op += match_length;
+    }
+    else
+    {
+      // overlapping copy repeats the last offset bytes
+      for (size_t i = 0; i < match_length; i++)
+        *op++ = *match++;
+    }
+  }
+
+  return (op == oend);
+}
+
+// A block of a buffer compressed by ON_BinaryArchive::WriteDeflateConcurrent().
+// Blocks are deflated independently using the 32 KB of input that precedes 
+// the block as a dictionary. Every block except the last one ends with a 
+// Z_SYNC_FLUSH, so the concatenated raw deflate output is a valid deflate 
+// stream and inflate() reads it like a stream made by a single z_deflate().
+class ON_DeflateBlock
+{
+public:
+  enum : size_t
+  {
+    block_size = 131072,        // uncompressed bytes in a block
+    dictionary_size = 32768,    // size of the zlib window
+    min_concurrent_size = 4*block_size
+  };
+
+  bool Deflate();
+
+  const unsigned char* m_in;
+  size_t m_sizeof_in;
+  size_t m_sizeof_dictionary; // dictionary is the m_sizeof_dictionary bytes before m_in
+  bool m_bLast;
+  bool m_rc;
+  unsigned char* m_out; // onmalloc() buffer
+  size_t m_sizeof_out;
+  ON__UINT32 m_adler32;
+};
+
+bool ON_DeflateBlock::Deflate()
+{
+  m_rc = false;
+  m_adler32 = (ON__UINT32)adler32(1L, m_in, (uInt)m_sizeof_in);
+
+  z_stream strm;
+  memset(&strm, 0, sizeof(strm));
+  // raw deflate - WriteDeflateConcurrent() writes the zlib header and adler32
+  if (Z_OK != deflateInit2(&strm, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY))
+    return false;
+
+  bool rc = (0 == m_sizeof_dictionary || Z_OK == deflateSetDictionary(&strm, m_in - m_sizeof_dictionary, (uInt)m_sizeof_dictionary));
+  if (rc)
+  {
+    // deflateBound() does not include the empty stored block written by Z_SYNC_FLUSH.
+    const size_t sizeof_out = (size_t)deflateBound(&strm, (uLong)m_sizeof_in) + 16;
+    m_out = (unsigned char*)onmalloc(sizeof_out);
+    rc = (nullptr != m_out);
+    if (rc)
+    {
+      strm.next_in = (z_Bytef*)m_in;
+      strm.avail_in = (unsigned int)m_sizeof_in;
+      strm.next_out = m_out;
+      strm.avail_out = (unsigned int)sizeof_out;
+      const int zrc = z_deflate(&strm, m_bLast ? Z_FINISH : Z_SYNC_FLUSH);
+      if ((m_bLast ? Z_STREAM_END : Z_OK) != zrc || 0 != strm.avail_in || 0 == strm.avail_out)
+        rc = false;
+      else
+        m_sizeof_out = sizeof_out - strm.avail_out;
+    }
+  }
+
+  deflateEnd(&strm);
+  m_rc = rc;
+  return rc;
+}
+
 bool ON_BinaryArchive::WriteCompressedBuffer(
         size_t sizeof__inbuffer,  // sizeof uncompressed input data
         const void* inbuffer  // uncompressed input data
@@ -115,19 +409,38 @@ bool ON_BinaryArchive::WriteCompressedBuffer(
   if (!WriteInt(buffer_crc))
     return false;
 
+  // method = ON_CompressionCodec value
   unsigned char method
     = (m_bUseBufferCompression && sizeof__inbuffer > 128)
-    ? 1
+    ? static_cast<unsigned char>(m_compression_codec)
     : 0;
 
-  if ( method ) {
+  void* lz4_buffer = nullptr;
+  size_t sizeof_lz4_buffer = 0;
+  if ( 2 == method )
+  {
+    // The LZ4 block is compressed before the method is written
+    // so incompressible buffers can be saved uncompressed.
+    const size_t sizeof_lz4_capacity = ON_LZ4Block::CompressBound(sizeof__inbuffer);
+    lz4_buffer = onmalloc(sizeof_lz4_capacity);
+    if ( nullptr != lz4_buffer )
+      sizeof_lz4_buffer = ON_LZ4Block::Compress(sizeof__inbuffer, inbuffer, sizeof_lz4_capacity, lz4_buffer);
+    if ( 0 == sizeof_lz4_buffer || sizeof_lz4_buffer >= sizeof__inbuffer )
+      method = 0;
+  }
+
+  if ( 1 == method ) {
     if ( !CompressionInit() ) {
       CompressionEnd();
       method = 0;
     }
   }
   if ( !WriteChar(method) )
+  {
+    if ( nullptr != lz4_buffer )
+      onfree(lz4_buffer);
     return false;
+  }
 
   switch ( method )
   {
@@ -140,12 +453,31 @@ bool ON_BinaryArchive::WriteCompressedBuffer(
     break;
 
   case 1: // compressed
-    compressed_size = WriteDeflate( sizeof__inbuffer, inbuffer );
+    compressed_size 
+      = (ThreadCount() > 1 && sizeof__inbuffer >= ON_DeflateBlock::min_concurrent_size)
+      ? WriteDeflateConcurrent( sizeof__inbuffer, inbuffer )
+      : WriteDeflate( sizeof__inbuffer, inbuffer );
     rc = ( compressed_size > 0 ) ? true : false;
     CompressionEnd();
     break;
+
+  case 2: // LZ4 block
+    //  Compressed information is saved in a chunk.
+    rc = BeginWrite3dmChunk(TCODE_ANONYMOUS_CHUNK,0);
+    if ( rc )
+    {
+      rc = WriteByte(sizeof_lz4_buffer, lz4_buffer);
+      if ( !EndWrite3dmChunk() )
+        rc = false;
+    }
+    if ( rc )
+      compressed_size = sizeof_lz4_buffer;
+    break;
   }
 
+  if ( nullptr != lz4_buffer )
+    onfree(lz4_buffer);
+
 
   return rc;
 }
@@ -185,7 +517,7 @@ bool ON_BinaryArchive::ReadCompressedBuffer( // read and uncompress
   if ( !ReadChar(&method) )
     return false;
 
-  if ( method != 0 && method != 1 )
+  if ( method != 0 && method != 1 && method != 2 )
     return false;
 
   switch(method)
@@ -199,6 +531,9 @@ bool ON_BinaryArchive::ReadCompressedBuffer( // read and uncompress
       rc = ReadInflate( sizeof__outbuffer, outbuffer );
     CompressionEnd();
     break;
+  case 2: // LZ4 block
+    rc = ReadLZ4( sizeof__outbuffer, outbuffer );
+    break;
   }
 
   if (rc ) 
@@ -403,6 +738,137 @@ size_t ON_BinaryArchive::WriteDeflate( // returns number of bytes written
 }
 
 
+size_t ON_BinaryArchive::WriteDeflateConcurrent( // returns number of bytes written
+        size_t sizeof___inbuffer,  // sizeof uncompressed input data ( > 0 )
+        const void* in___buffer     // uncompressed input data ( != nullptr )
+        )
+{
+  const size_t block_count = (sizeof___inbuffer + ON_DeflateBlock::block_size - 1) / ON_DeflateBlock::block_size;
+  if (block_count < 2 || block_count > 0x7FFFFFFF)
+    return WriteDeflate(sizeof___inbuffer, in___buffer);
+
+  ON_SimpleArray<ON_DeflateBlock> blocks((int)block_count);
+  blocks.SetCount((int)block_count);
+  blocks.Zero();
+  const unsigned char* in = (const unsigned char*)in___buffer;
+  for (size_t i = 0; i < block_count; i++)
+  {
+    ON_DeflateBlock& block = blocks[(int)i];
+    block.m_in = in + i*ON_DeflateBlock::block_size;
+    block.m_sizeof_in = (i + 1 < block_count) ? ((size_t)ON_DeflateBlock::block_size) : (sizeof___inbuffer - i*ON_DeflateBlock::block_size);
+    block.m_sizeof_dictionary = (i > 0) ? ((size_t)ON_DeflateBlock::dictionary_size) : ((size_t)0);
+    block.m_bLast = (i + 1 == block_count);
+  }
+
+  // Deflate the blocks. The calling thread is one of the workers.
+  ON_Internal_ParallelFor(ThreadCount(), blocks.UnsignedCount(), [&blocks](unsigned int i) { blocks[i].Deflate(); });
+
+  bool bDeflated = true;
+  ON__UINT32 adler = 1;
+  for (unsigned int i = 0; i < blocks.UnsignedCount(); i++)
+  {
+    if (false == blocks[i].m_rc)
+      bDeflated = false;
+    adler = (ON__UINT32)adler32_combine(adler, blocks[i].m_adler32, (z_off_t)blocks[i].m_sizeof_in);
+  }
+
+  size_t out__count = 0;
+  bool rc = bDeflated;
+  if (rc)
+  {
+    //  Compressed information is saved in a chunk.
+    rc = BeginWrite3dmChunk(TCODE_ANONYMOUS_CHUNK,0);
+    if (rc)
+    {
+      // zlib header for a 32 KB window and Z_BEST_COMPRESSION (RFC 1950)
+      const unsigned char zlib_header[2] = { 0x78, 0xDA };
+      rc = WriteChar(2, zlib_header);
+      out__count += 2;
+      for (unsigned int i = 0; rc && i < blocks.UnsignedCount(); i++)
+      {
+        rc = WriteChar(blocks[i].m_sizeof_out, blocks[i].m_out);
+        out__count += blocks[i].m_sizeof_out;
+      }
+      if (rc)
+      {
+        // adler32 of the uncompressed data (big endian)
+        const unsigned char zlib_trailer[4] = {
+          (unsigned char)(adler >> 24), (unsigned char)(adler >> 16), (unsigned char)(adler >> 8), (unsigned char)adler
+        };
+        rc = WriteChar(4, zlib_trailer);
+        out__count += 4;
+      }
+      if (!EndWrite3dmChunk())
+        rc = false;
+    }
+  }
+
+  for (unsigned int i = 0; i < blocks.UnsignedCount(); i++)
+  {
+    if (nullptr != blocks[i].m_out)
+      onfree(blocks[i].m_out);
+  }
+
+  if (false == bDeflated)
+  {
+    // Nothing has been written. Use the single threaded code.
+    return WriteDeflate(sizeof___inbuffer, in___buffer);
+  }
+
+  return (rc ? out__count : 0);
+}
+
+bool ON_BinaryArchive::ReadLZ4(
+        size_t sizeof___outbuffer,  // sizeof uncompressed data
+        void* out___buffer          // buffer for uncompressed data
+        )
+{
+  ON__UINT32 tcode = 0;
+  ON__INT64  big_value = 0;
+  if ( !BeginRead3dmBigChunk(&tcode,&big_value) )
+  {
+    memset(out___buffer,0,sizeof___outbuffer);
+    return false;
+  }
+
+  bool rc = false;
+  const void* in_place_buffer = nullptr;
+  void* in___buffer = nullptr;
+  size_t sizeof__inbuffer = 0;
+  if ( tcode == TCODE_ANONYMOUS_CHUNK && big_value > 4 )
+  {
+    sizeof__inbuffer = (size_t)(big_value-4); // the last 4 bytes in this chunk are a 32 bit crc
+    in_place_buffer = ReadInPlace( sizeof__inbuffer );
+    if ( nullptr != in_place_buffer )
+      rc = true;
+    else
+    {
+      in___buffer = onmalloc(sizeof__inbuffer);
+      rc = ( nullptr != in___buffer && ReadByte( sizeof__inbuffer, in___buffer ) );
+      in_place_buffer = in___buffer;
+    }
+  }
+
+  const unsigned int c0 = BadCRCCount();
+  if ( !EndRead3dmChunk() )
+    rc = false;
+  if ( BadCRCCount() > c0 )
+    rc = false;
+
+  if ( rc )
+    rc = ON_LZ4Block::Decompress(sizeof__inbuffer, in_place_buffer, sizeof___outbuffer, out___buffer);
+  if ( !rc )
+  {
+    ON_ERROR("ON_BinaryArchive::ReadLZ4() - corrupt compressed buffer");
+    memset(out___buffer,0,sizeof___outbuffer);
+  }
+
+  if ( nullptr != in___buffer )
+    onfree(in___buffer);
+
+  return rc;
+}
+
 bool ON_BinaryArchive::ReadInflate(
         size_t sizeof___outbuffer,  // sizeof uncompressed data
         void* out___buffer          // buffer for uncompressed data
@@ -412,6 +878,7 @@ bool ON_BinaryArchive::ReadInflate(
 
   size_t sizeof__inbuffer = 0;
   void* in___buffer = 0;
+  const void* in_place_buffer = nullptr;
   bool rc = false;
 
   // read compressed buffer from 3dm archive
@@ -433,14 +900,24 @@ bool ON_BinaryArchive::ReadInflate(
     {
       // read compressed buffer from the archive
       sizeof__inbuffer = (size_t)(big_value-4); // the last 4 bytes in this chunk are a 32 bit crc
-      in___buffer = onmalloc(sizeof__inbuffer);
-      if ( !in___buffer )
+      // Memory resident archives (ON_BinaryMappedFile, ON_Read3dmBufferArchive)
+      // let zlib inflate directly from the archive's bytes.
+      in_place_buffer = ReadInPlace( sizeof__inbuffer );
+      if ( nullptr != in_place_buffer )
       {
-        rc = false;
+        rc = true;
       }
       else
       {
-        rc = ReadByte( sizeof__inbuffer, in___buffer );
+        in___buffer = onmalloc(sizeof__inbuffer);
+        if ( !in___buffer )
+        {
+          rc = false;
+        }
+        else
+        {
+          rc = ReadByte( sizeof__inbuffer, in___buffer );
+        }
       }
     }
     else
@@ -481,7 +958,10 @@ bool ON_BinaryArchive::ReadInflate(
   int zrc = -1;
 
   // set up zlib in buffer
-  unsigned char* my_next_in = (unsigned char*)in___buffer;
+  unsigned char* my_next_in 
+    = (nullptr != in_place_buffer)
+    ? (unsigned char*)in_place_buffer
+    : (unsigned char*)in___buffer;
   size_t my_avail_in = sizeof__inbuffer;
 
   size_t d = my_avail_in;
@@ -863,6 +1343,16 @@ bool ON_CompressedBuffer::Compress(
         const void* inbuffer,     // uncompressed input data
         int sizeof_element
         )
+{
+  return Compress(sizeof__inbuffer, inbuffer, sizeof_element, ON_CompressionCodec::Zlib);
+}
+
+bool ON_CompressedBuffer::Compress(
+        size_t sizeof__inbuffer,  // sizeof uncompressed input data
+        const void* inbuffer,     // uncompressed input data
+        int sizeof_element,
+        ON_CompressionCodec codec
+        )
 {
   Destroy();
 
@@ -909,8 +1399,33 @@ bool ON_CompressedBuffer::Compress(
       );
   }
 
-  m_method = (sizeof__inbuffer > 128) ? 1 : 0;
-  if ( m_method ) 
+  m_method = (sizeof__inbuffer > 128) ? static_cast<int>(codec) : 0;
+  if ( m_method > 2 )
+    m_method = 1; // unknown codec
+  if ( 2 == m_method )
+  {
+    const size_t sizeof_lz4_capacity = ON_LZ4Block::CompressBound(sizeof__inbuffer);
+    m_buffer_compressed = onmalloc(sizeof_lz4_capacity);
+    const size_t sizeof_compressed 
+      = (nullptr != m_buffer_compressed)
+      ? ON_LZ4Block::Compress(sizeof__inbuffer, inbuffer, sizeof_lz4_capacity, m_buffer_compressed)
+      : 0;
+    if ( sizeof_compressed > 0 && sizeof_compressed < sizeof__inbuffer )
+    {
+      rc = true;
+      m_sizeof_compressed = sizeof_compressed;
+      m_buffer_compressed_capacity = sizeof_compressed;
+      m_buffer_compressed = onrealloc(m_buffer_compressed,m_buffer_compressed_capacity);
+    }
+    else
+    {
+      if ( nullptr != m_buffer_compressed )
+        onfree(m_buffer_compressed);
+      m_buffer_compressed = nullptr;
+      m_method = 0;
+    }
+  }
+  else if ( 1 == m_method ) 
   {
     if ( !CompressionInit(&helper) ) 
     {
@@ -986,7 +1501,7 @@ bool ON_CompressedBuffer::Uncompress(
   if ( 0 == outbuffer )
     return false;
 
-  if ( m_method != 0 && m_method != 1 )
+  if ( m_method != 0 && m_method != 1 && m_method != 2 )
     return false;
 
   ON__UINT32 compressed_crc = ON_CRC32( 0, m_sizeof_compressed, m_buffer_compressed );
@@ -1025,6 +1540,10 @@ bool ON_CompressedBuffer::Uncompress(
       }
     }
     break;
+
+  case 2: // LZ4 block
+    rc = ON_LZ4Block::Decompress(m_sizeof_compressed, m_buffer_compressed, m_sizeof_uncompressed, outbuffer);
+    break;
   }
 
   switch(m_sizeof_element)